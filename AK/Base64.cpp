@@ -6,13 +6,27 @@
 
 #include <AK/Assertions.h>
 #include <AK/Base64.h>
+#include <AK/BitCast.h>
+#include <AK/CharacterTypes.h>
 #include <AK/Error.h>
+#include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
+#include <AK/Stream.h>
 #include <AK/StringBuilder.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 
 namespace AK {
 
+using AK::SIMD::u16x8;
+using AK::SIMD::u32x4;
+using AK::SIMD::u64x2;
+using AK::SIMD::u8x16;
+
+// The vectorized kernels work on 16 characters, which encode 12 bytes.
+static constexpr size_t encoded_block_size = 16;
+static constexpr size_t decoded_block_size = 12;
+
 size_t calculate_base64_decoded_length(StringView input)
 {
     auto length = input.length() * 3 / 4;
@@ -30,17 +44,79 @@ size_t calculate_base64_encoded_length(ReadonlyBytes input)
     return ((4 * input.size() / 3) + 3) & ~3;
 }
 
-static ErrorOr<ByteBuffer> decode_base64_impl(StringView input, ReadonlySpan<i16> alphabet_lookup_table)
+// Decodes the 16 characters at `input` into 12 bytes at `output`, which has to have room for 13 bytes.
+// Returns false without writing anything if any of the characters is not in the alphabet, including padding.
+static bool decode_block(u8 const* input, u8* output, ReadonlySpan<char> alphabet)
 {
-    input = input.trim_whitespace();
+    u8x16 characters;
+    __builtin_memcpy(&characters, input, sizeof(characters));
 
-    if (input.length() % 4 != 0)
-        return Error::from_string_literal("Invalid length of Base64 encoded string");
+    // Both alphabets consist of the ranges A-Z, a-z and 0-9, followed by two characters of their own.
+    auto is_uppercase = bit_cast<u8x16>((characters >= (u8x16 {} + 'A')) & (characters <= (u8x16 {} + 'Z')));
+    auto is_lowercase = bit_cast<u8x16>((characters >= (u8x16 {} + 'a')) & (characters <= (u8x16 {} + 'z')));
+    auto is_digit = bit_cast<u8x16>((characters >= (u8x16 {} + '0')) & (characters <= (u8x16 {} + '9')));
+    auto is_62 = bit_cast<u8x16>(characters == (u8x16 {} + static_cast<u8>(alphabet[62])));
+    auto is_63 = bit_cast<u8x16>(characters == (u8x16 {} + static_cast<u8>(alphabet[63])));
 
-    auto get = [&](size_t offset, bool* is_padding) -> ErrorOr<u8> {
-        if (offset >= input.length())
-            return 0;
+    auto is_valid = bit_cast<u64x2>(is_uppercase | is_lowercase | is_digit | is_62 | is_63);
+    if ((is_valid[0] & is_valid[1]) != NumericLimits<u64>::max())
+        return false;
+
+    auto values = (is_uppercase & (characters - 'A'))
+        | (is_lowercase & (characters - ('a' - 26)))
+        | (is_digit & (characters + (52 - '0')))
+        | (is_62 & 62)
+        | (is_63 & 63);
+
+    // Merge pairs of 6-bit values into 12 bits, and then pairs of those into the 24 bits of each group of 4 characters.
+    auto pairs = bit_cast<u16x8>(values);
+    auto merged_pairs = ((pairs & 0xff) << 6) | (pairs >> 8);
+    auto quads = bit_cast<u32x4>(merged_pairs);
+    auto merged_quads = ((quads & 0xffff) << 12) | (quads >> 16);
+
+    // The bytes of each group are stored most significant byte first. Each store writes one byte too many, which is
+    // overwritten by the next group, or belongs to the group following the block.
+    for (size_t i = 0; i < 4; ++i) {
+        auto group = __builtin_bswap32(merged_quads[i] << 8);
+        __builtin_memcpy(output + i * 3, &group, sizeof(group));
+    }
+    return true;
+}
+
+// Encodes the first 12 of the 13 or more bytes at `input` into 16 characters at `output`.
+static void encode_block(u8 const* input, u8* output, ReadonlySpan<char> alphabet)
+{
+    // Load each group of 3 bytes (b0, b1, b2) into the low bytes of a 32-bit lane.
+    auto load_group = [&](size_t offset) {
+        u32 group;
+        __builtin_memcpy(&group, input + offset, sizeof(group));
+        return group;
+    };
+    auto groups = u32x4 { load_group(0), load_group(3), load_group(6), load_group(9) };
+
+    // Gather the four 6-bit indices of each group into the bytes of its lane, in order.
+    auto index0 = (groups >> 2) & 0x3f;
+    auto index1 = ((groups & 0x03) << 12) | ((groups >> 4) & 0x0f00);
+    auto index2 = ((groups & 0x0f00) << 10) | ((groups >> 6) & 0x030000);
+    auto index3 = (groups & 0x3f0000) << 8;
+    auto indices = bit_cast<u8x16>(index0 | index1 | index2 | index3);
+
+    // Map the indices onto the ranges A-Z, a-z and 0-9, followed by the alphabet's own two characters.
+    auto characters = indices + 'A';
+    characters += bit_cast<u8x16>(indices >= (u8x16 {} + 26)) & static_cast<u8>('a' - 'A' - 26);
+    characters += bit_cast<u8x16>(indices >= (u8x16 {} + 52)) & static_cast<u8>('0' - 'a' - 26);
+    characters += bit_cast<u8x16>(indices >= (u8x16 {} + 62)) & static_cast<u8>(alphabet[62] - '0' - 10);
+    characters += bit_cast<u8x16>(indices == (u8x16 {} + 63)) & static_cast<u8>(alphabet[63] - alphabet[62] - 1);
+    __builtin_memcpy(output, &characters, encoded_block_size);
+}
+
+// Decodes `input`, whose length has to be a multiple of 4, into `output`. Returns the number of bytes written.
+static ErrorOr<size_t> decode_base64_into(StringView input, Bytes output, ReadonlySpan<i16> alphabet_lookup_table, ReadonlySpan<char> alphabet)
+{
+    VERIFY(input.length() % 4 == 0);
+    VERIFY(output.size() >= input.length() / 4 * 3);
 
+    auto get = [&](size_t offset, bool* is_padding) -> ErrorOr<u8> {
         auto ch = static_cast<unsigned char>(input[offset]);
         if (ch == '=') {
             if (!is_padding)
@@ -56,13 +132,20 @@ static ErrorOr<ByteBuffer> decode_base64_impl(StringView input, ReadonlySpan<i16
         return { result };
     };
 
-    ByteBuffer output;
-    TRY(output.try_resize(calculate_base64_decoded_length(input)));
-
+    auto const* characters = reinterpret_cast<u8 const*>(input.characters_without_null_termination());
     size_t input_offset = 0;
     size_t output_offset = 0;
 
     while (input_offset < input.length()) {
+        // The vectorized kernel handles everything but padding and errors, which are left to the scalar path below.
+        // As both work in groups of 4 characters, we can switch between them at any group. The kernel writes one byte
+        // past its output, so it can't be used for the last group of the input.
+        if (input_offset + encoded_block_size < input.length() && decode_block(characters + input_offset, output.offset_pointer(output_offset), alphabet)) {
+            input_offset += encoded_block_size;
+            output_offset += decoded_block_size;
+            continue;
+        }
+
         bool in2_is_padding = false;
         bool in3_is_padding = false;
 
@@ -80,13 +163,21 @@ static ErrorOr<ByteBuffer> decode_base64_impl(StringView input, ReadonlySpan<i16
             output[output_offset++] = ((in2 & 0x3) << 6) | in3;
     }
 
-    return output;
+    return output_offset;
 }
 
-static ErrorOr<String> encode_base64_impl(ReadonlyBytes input, ReadonlySpan<char> alphabet)
+// Encodes `input` into `output`, which has to hold at least calculate_base64_encoded_length(input) characters.
+// Returns the number of characters written.
+static size_t encode_base64_into(ReadonlyBytes input, Bytes output, ReadonlySpan<char> alphabet)
 {
-    Vector<u8> output;
-    TRY(output.try_ensure_capacity(calculate_base64_encoded_length(input)));
+    VERIFY(output.size() >= calculate_base64_encoded_length(input));
+
+    size_t input_offset = 0;
+    size_t output_offset = 0;
+
+    // The kernel reads one byte past the 12 it encodes.
+    for (; input_offset + decoded_block_size < input.size(); input_offset += decoded_block_size, output_offset += encoded_block_size)
+        encode_block(input.offset_pointer(input_offset), output.offset_pointer(output_offset), alphabet);
 
     auto get = [&](size_t const offset, bool* need_padding = nullptr) -> u8 {
         if (offset >= input.size()) {
@@ -97,7 +188,7 @@ static ErrorOr<String> encode_base64_impl(ReadonlyBytes input, ReadonlySpan<char
         return input[offset];
     };
 
-    for (size_t i = 0; i < input.size(); i += 3) {
+    for (size_t i = input_offset; i < input.size(); i += 3) {
         bool is_8bit = false;
         bool is_16bit = false;
 
@@ -110,25 +201,124 @@ static ErrorOr<String> encode_base64_impl(ReadonlyBytes input, ReadonlySpan<char
         u8 const index2 = ((in1 << 2) | (in2 >> 6)) & 0x3f;
         u8 const index3 = in2 & 0x3f;
 
-        output.unchecked_append(alphabet[index0]);
-        output.unchecked_append(alphabet[index1]);
-        output.unchecked_append(is_16bit ? '=' : alphabet[index2]);
-        output.unchecked_append(is_8bit ? '=' : alphabet[index3]);
+        output[output_offset++] = alphabet[index0];
+        output[output_offset++] = alphabet[index1];
+        output[output_offset++] = is_16bit ? '=' : alphabet[index2];
+        output[output_offset++] = is_8bit ? '=' : alphabet[index3];
     }
 
+    return output_offset;
+}
+
+static ErrorOr<ByteBuffer> decode_base64_impl(StringView input, ReadonlySpan<i16> alphabet_lookup_table, ReadonlySpan<char> alphabet)
+{
+    input = input.trim_whitespace();
+
+    if (input.length() % 4 != 0)
+        return Error::from_string_literal("Invalid length of Base64 encoded string");
+
+    auto output = TRY(ByteBuffer::create_uninitialized(input.length() / 4 * 3));
+    auto decoded_length = TRY(decode_base64_into(input, output, alphabet_lookup_table, alphabet));
+    output.trim(decoded_length, false);
+
+    return output;
+}
+
+static ErrorOr<String> encode_base64_impl(ReadonlyBytes input, ReadonlySpan<char> alphabet)
+{
+    Vector<u8> output;
+    TRY(output.try_resize(calculate_base64_encoded_length(input)));
+    encode_base64_into(input, output, alphabet);
+
     return String::from_utf8_without_validation(output);
 }
 
+static ErrorOr<void> decode_base64_stream_impl(Stream& input, Stream& output, ReadonlySpan<i16> alphabet_lookup_table, ReadonlySpan<char> alphabet)
+{
+    Array<u8, 4 * KiB> input_buffer;
+    Array<u8, 3 * KiB> output_buffer;
+    size_t buffered_length = 0;
+
+    for (;;) {
+        auto bytes_read = TRY(input.read_some(input_buffer.span().slice(buffered_length)));
+        bool const reached_end = input.is_eof();
+
+        // Whitespace is dropped wherever it appears, so that line-wrapped input can be decoded as-is. Lines are usually
+        // dozens of characters long, so blocks without any whitespace or control characters are moved as a whole.
+        for (size_t i = 0; i < bytes_read.size();) {
+            if (i + sizeof(u8x16) <= bytes_read.size()) {
+                u8x16 block;
+                __builtin_memcpy(&block, bytes_read.offset_pointer(i), sizeof(block));
+                auto is_space_or_control = bit_cast<u64x2>(block <= (u8x16 {} + ' '));
+                if ((is_space_or_control[0] | is_space_or_control[1]) == 0) {
+                    __builtin_memcpy(input_buffer.data() + buffered_length, &block, sizeof(block));
+                    buffered_length += sizeof(block);
+                    i += sizeof(block);
+                    continue;
+                }
+            }
+            if (auto byte = bytes_read[i++]; !is_ascii_space(byte))
+                input_buffer[buffered_length++] = byte;
+        }
+
+        // Decode all complete groups of 4 characters and keep the rest for the next round.
+        auto decodable_length = buffered_length - buffered_length % 4;
+        if (reached_end && decodable_length != buffered_length)
+            return Error::from_string_literal("Invalid length of Base64 encoded string");
+
+        StringView decodable { input_buffer.data(), decodable_length };
+        auto decoded_length = TRY(decode_base64_into(decodable, output_buffer, alphabet_lookup_table, alphabet));
+        TRY(output.write_until_depleted(output_buffer.span().trim(decoded_length)));
+
+        if (reached_end)
+            return {};
+
+        buffered_length -= decodable_length;
+        __builtin_memmove(input_buffer.data(), input_buffer.data() + decodable_length, buffered_length);
+    }
+}
+
+static ErrorOr<void> encode_base64_stream_impl(Stream& input, Stream& output, ReadonlySpan<char> alphabet)
+{
+    // Only the final chunk can be shorter than a multiple of 3 bytes, so padding only ever ends up at the very end.
+    Array<u8, 3 * KiB> input_buffer;
+    Array<u8, 4 * KiB> output_buffer;
+
+    for (;;) {
+        size_t input_length = 0;
+        while (input_length < input_buffer.size() && !input.is_eof())
+            input_length += TRY(input.read_some(input_buffer.span().slice(input_length))).size();
+
+        auto encoded_length = encode_base64_into(input_buffer.span().trim(input_length), output_buffer, alphabet);
+        TRY(output.write_until_depleted(output_buffer.span().trim(encoded_length)));
+
+        if (input_length < input_buffer.size())
+            return {};
+    }
+}
+
 ErrorOr<ByteBuffer> decode_base64(StringView input)
 {
     static constexpr auto lookup_table = base64_lookup_table();
-    return decode_base64_impl(input, lookup_table);
+    return decode_base64_impl(input, lookup_table, base64_alphabet);
 }
 
 ErrorOr<ByteBuffer> decode_base64url(StringView input)
 {
     static constexpr auto lookup_table = base64url_lookup_table();
-    return decode_base64_impl(input, lookup_table);
+    return decode_base64_impl(input, lookup_table, base64url_alphabet);
+}
+
+ErrorOr<void> decode_base64(Stream& input, Stream& output)
+{
+    static constexpr auto lookup_table = base64_lookup_table();
+    return decode_base64_stream_impl(input, output, lookup_table, base64_alphabet);
+}
+
+ErrorOr<void> decode_base64url(Stream& input, Stream& output)
+{
+    static constexpr auto lookup_table = base64url_lookup_table();
+    return decode_base64_stream_impl(input, output, lookup_table, base64url_alphabet);
 }
 
 ErrorOr<String> encode_base64(ReadonlyBytes input)
@@ -140,4 +330,14 @@ ErrorOr<String> encode_base64url(ReadonlyBytes input)
     return encode_base64_impl(input, base64url_alphabet);
 }
 
+ErrorOr<void> encode_base64(Stream& input, Stream& output)
+{
+    return encode_base64_stream_impl(input, output, base64_alphabet);
+}
+
+ErrorOr<void> encode_base64url(Stream& input, Stream& output)
+{
+    return encode_base64_stream_impl(input, output, base64url_alphabet);
+}
+
 }
@@ -9,6 +9,7 @@
 #include <AK/Array.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Error.h>
+#include <AK/Forward.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
 
@@ -67,6 +68,14 @@ consteval auto base64url_lookup_table()
 
 [[nodiscard]] ErrorOr<String> encode_base64(ReadonlyBytes);
 [[nodiscard]] ErrorOr<String> encode_base64url(ReadonlyBytes);
+
+// These decode or encode everything up to the end of `input` chunk by chunk, without holding all of it in memory.
+// Unlike the variants above, the decoders skip whitespace anywhere in the input, as found in line-wrapped data.
+[[nodiscard]] ErrorOr<void> decode_base64(Stream& input, Stream& output);
+[[nodiscard]] ErrorOr<void> decode_base64url(Stream& input, Stream& output);
+
+[[nodiscard]] ErrorOr<void> encode_base64(Stream& input, Stream& output);
+[[nodiscard]] ErrorOr<void> encode_base64url(Stream& input, Stream& output);
 }
 
 #if USING_AK_GLOBALLY
@@ -222,6 +222,27 @@ public:
         return m_bit_buffer & lsb_mask<T>(min(count, m_bit_count));
     }
 
+    /// Like peek_bits(), but reaching the end of the stream is not an error: The bits past the end are zero instead,
+    /// and the number of bits that are actually available is returned through `available_count`.
+    /// This allows peeking at a fixed number of bits when it is unknown how many of them will end up being used.
+    ErrorOr<u64> peek_bits_until_end(size_t count, size_t& available_count)
+    {
+        VERIFY(count <= bit_buffer_size - bits_per_byte);
+
+        while (count > m_bit_count && !m_stream->is_eof()) {
+            size_t bytes_to_read = (bit_buffer_size - m_bit_count) / bits_per_byte;
+
+            BufferType buffer = 0;
+            auto bytes = TRY(m_stream->read_some({ &buffer, bytes_to_read }));
+
+            m_bit_buffer |= (buffer << m_bit_count);
+            m_bit_count += bytes.size() * bits_per_byte;
+        }
+
+        available_count = min<size_t>(count, m_bit_count);
+        return m_bit_buffer & lsb_mask<u64>(available_count);
+    }
+
     ALWAYS_INLINE void discard_previously_peeked_bits(u8 count)
     {
         // We allow "retrieving" more bits than we can provide, but we need to make sure that we don't underflow the current bit counter.
@@ -354,7 +354,7 @@ Optional<SearchableCircularBuffer::Match> SearchableCircularBuffer::find_copy_in
             Optional<size_t> previous_buffer_offset;
             auto current_buffer_offset = maybe_starting_offset.value();
 
-            while (true) {
+            for (size_t chain_length = 0; chain_length < MAXIMUM_CHAIN_LENGTH; chain_length++) {
                 auto current_search_offset = (capacity() + m_reading_head - current_buffer_offset) % capacity();
 
                 // Validate the hash. In case it is invalid, we can discard the rest of the chain, as the data (and everything older) got updated.
@@ -405,8 +405,8 @@ Optional<SearchableCircularBuffer::Match> SearchableCircularBuffer::find_copy_in
     }
 
     // Try a plain memory search for smaller values.
-    // Note: This overlaps with the hash search for chunks of size HASH_CHUNK_SIZE for the purpose of validation.
-    if (minimum_length <= HASH_CHUNK_SIZE) {
+    // Note: This overlaps with the hash search for chunks of size HASH_CHUNK_SIZE, which also finds matches that the hash search gave up on.
+    if (minimum_length < HASH_CHUNK_SIZE) {
         size_t haystack_offset_from_start = 0;
         Vector<ReadonlyBytes, 2> haystack;
         haystack.append(next_search_span(search_limit()));
@@ -457,9 +457,6 @@ Optional<SearchableCircularBuffer::Match> SearchableCircularBuffer::find_copy_in
             // Try and find the next match.
             memmem_match = AK::memmem(haystack.begin(), haystack.end(), needle);
         }
-
-        // If we found a match of size HASH_CHUNK_SIZE, we should have already found that using the hash search. Investigate.
-        VERIFY(!best_match.has_value() || best_match->length < HASH_CHUNK_SIZE);
     }
 
     return best_match;
@@ -88,6 +88,10 @@ public:
     // equal or greater than this allows us to completely skip a slow memory search.
     static constexpr size_t HASH_CHUNK_SIZE = 3;
 
+    // The number of earlier locations with the same hash that are checked for a longer match.
+    // Without a limit, searching for common byte sequences ends up walking through most of the buffer.
+    static constexpr size_t MAXIMUM_CHAIN_LENGTH = 256;
+
 private:
     // Note: This function has a similar purpose as next_seekback_span, but they differ in their reference point.
     //       Seekback operations start counting their distance at the write head, while search operations start counting their distance at the read head.
@@ -5,21 +5,83 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/Hex.h>
-#include <AK/StringBuilder.h>
+#include <AK/NumericLimits.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 
+#ifndef KERNEL
+#    include <AK/SIMD.h>
+#endif
+
 namespace AK {
 
+#ifndef KERNEL
+using AK::SIMD::u16x8;
+using AK::SIMD::u64x2;
+using AK::SIMD::u8x16;
+using AK::SIMD::u8x8;
+
+// Decodes the 16 hex digits at `input` into 8 bytes at `output`.
+// Returns false without writing anything if any of the characters is not a hex digit.
+static bool decode_hex_block(char const* input, u8* output)
+{
+    u8x16 characters;
+    __builtin_memcpy(&characters, input, sizeof(characters));
+
+    auto lowercase = characters | (u8x16 {} + 0x20);
+    auto is_digit = bit_cast<u8x16>((characters >= (u8x16 {} + '0')) & (characters <= (u8x16 {} + '9')));
+    auto is_letter = bit_cast<u8x16>((lowercase >= (u8x16 {} + 'a')) & (lowercase <= (u8x16 {} + 'f')));
+
+    auto is_valid = bit_cast<u64x2>(is_digit | is_letter);
+    if ((is_valid[0] & is_valid[1]) != NumericLimits<u64>::max())
+        return false;
+
+    auto digits = (is_digit & (characters - '0')) | (is_letter & (lowercase - ('a' - 10)));
+
+    // Each 16-bit lane holds a high nibble in its low byte and the following low nibble in its high byte.
+    auto pairs = bit_cast<u16x8>(digits);
+    auto bytes = __builtin_convertvector(((pairs & 0xf) << 4) | (pairs >> 8), u8x8);
+    __builtin_memcpy(output, &bytes, sizeof(bytes));
+    return true;
+}
+
+// Encodes the 16 bytes at `input` as 32 lowercase hex digits at `output`.
+static void encode_hex_block(u8 const* input, char* output)
+{
+    u8x16 bytes;
+    __builtin_memcpy(&bytes, input, sizeof(bytes));
+
+    auto to_digits = [](u8x16 nibbles) {
+        return nibbles + '0' + (bit_cast<u8x16>(nibbles > (u8x16 {} + 9)) & ('a' - '0' - 10));
+    };
+    auto high = to_digits(bytes >> 4);
+    auto low = to_digits(bytes & 0xf);
+
+    auto first_half = __builtin_shufflevector(high, low, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+    auto second_half = __builtin_shufflevector(high, low, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+    __builtin_memcpy(output, &first_half, sizeof(first_half));
+    __builtin_memcpy(output + sizeof(first_half), &second_half, sizeof(second_half));
+}
+#endif
+
 ErrorOr<ByteBuffer> decode_hex(StringView input)
 {
     if ((input.length() % 2) != 0)
         return Error::from_string_view_or_print_error_and_return_errno("Hex string was not an even length"sv, EINVAL);
 
-    auto output = TRY(ByteBuffer::create_zeroed(input.length() / 2));
+    auto output = TRY(ByteBuffer::create_uninitialized(input.length() / 2));
+
+    size_t i = 0;
+#ifndef KERNEL
+    for (; (i + 8) * 2 <= input.length(); i += 8) {
+        if (!decode_hex_block(input.characters_without_null_termination() + i * 2, output.data() + i))
+            break;
+    }
+#endif
 
-    for (size_t i = 0; i < input.length() / 2; ++i) {
+    for (; i < input.length() / 2; ++i) {
         auto const c1 = decode_hex_digit(input[i * 2]);
         if (c1 >= 16)
             return Error::from_string_view_or_print_error_and_return_errno("Hex string contains invalid digit"sv, EINVAL);
@@ -34,25 +96,39 @@ ErrorOr<ByteBuffer> decode_hex(StringView input)
     return { move(output) };
 }
 
-#ifdef KERNEL
-ErrorOr<NonnullOwnPtr<Kernel::KString>> encode_hex(ReadonlyBytes const input)
+static void encode_hex_into(ReadonlyBytes input, char* output)
 {
-    StringBuilder output(input.size() * 2);
+    static constexpr auto digits = "0123456789abcdef"sv;
 
-    for (auto ch : input)
-        TRY(output.try_appendff("{:02x}", ch));
+    size_t i = 0;
+#ifndef KERNEL
+    for (; i + 16 <= input.size(); i += 16)
+        encode_hex_block(input.data() + i, output + i * 2);
+#endif
 
-    return Kernel::KString::try_create(output.string_view());
+    for (; i < input.size(); ++i) {
+        output[i * 2] = digits[input[i] >> 4];
+        output[i * 2 + 1] = digits[input[i] & 0xf];
+    }
+}
+
+#ifdef KERNEL
+ErrorOr<NonnullOwnPtr<Kernel::KString>> encode_hex(ReadonlyBytes const input)
+{
+    char* buffer;
+    auto output = TRY(Kernel::KString::try_create_uninitialized(input.size() * 2, buffer));
+    encode_hex_into(input, buffer);
+    buffer[input.size() * 2] = '\0';
+    return output;
 }
 #else
 ByteString encode_hex(ReadonlyBytes const input)
 {
-    StringBuilder output(input.size() * 2);
-
-    for (auto ch : input)
-        output.appendff("{:02x}", ch);
-
-    return output.to_byte_string();
+    if (input.is_empty())
+        return {};
+    return ByteString::create_and_overwrite(input.size() * 2, [&](Bytes buffer) {
+        encode_hex_into(input, reinterpret_cast<char*>(buffer.data()));
+    });
 }
 #endif
 
@@ -78,6 +78,18 @@ ALWAYS_INLINE static i32 maskbits(i32x4 mask)
 #endif
 }
 
+ALWAYS_INLINE static i32 maskbits(i8x16 mask)
+{
+#if defined(__SSE2__)
+    return __builtin_ia32_pmovmskb128((c8x16)mask);
+#else
+    i32 bits = 0;
+    for (size_t i = 0; i < 16; ++i)
+        bits |= ((static_cast<u8>(mask[i]) & 0x80) >> 7) << i;
+    return bits;
+#endif
+}
+
 ALWAYS_INLINE static bool all(i32x4 mask)
 {
     return maskbits(mask) == 15;
@@ -192,6 +204,26 @@ ALWAYS_INLINE static T shuffle(T a, T control)
         a[control[15] & 0xf],
     };
 }
+
+// Like shuffle(), but lanes whose index in control is out of range are zeroed instead of wrapping around.
+template<OneOf<i8x16, u8x16> T>
+ALWAYS_INLINE static T shuffle_or_0(T a, T control)
+{
+#if defined(__SSSE3__)
+    // pshufb zeroes the lanes whose index has the top bit set.
+    auto indices = (u8x16)control;
+    auto out_of_range = (u8x16)(indices > 15);
+    return (T)__builtin_ia32_pshufb128((c8x16)a, (c8x16)(indices | out_of_range));
+#else
+    T result;
+    for (size_t i = 0; i < 16; ++i) {
+        auto index = static_cast<u8>(control[i]);
+        result[i] = index < 16 ? a[index] : 0;
+    }
+    return result;
+#endif
+}
+
 }
 
 #pragma GCC diagnostic pop
@@ -5,7 +5,8 @@
  */
 
 #include <AK/CharacterTypes.h>
-#include <AK/Concepts.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/StringBuilder.h>
 #include <AK/StringView.h>
 #include <AK/Utf16View.h>
@@ -21,31 +22,78 @@ static constexpr u16 low_surrogate_max = 0xdfff;
 static constexpr u32 replacement_code_point = 0xfffd;
 static constexpr u32 first_supplementary_plane_code_point = 0x10000;
 
-template<OneOf<Utf8View, Utf32View> UtfViewType>
-static ErrorOr<Utf16Data> to_utf16_impl(UtfViewType const& view)
-{
-    Utf16Data utf16_data;
-    TRY(utf16_data.try_ensure_capacity(view.length()));
-
-    for (auto code_point : view)
-        TRY(code_point_to_utf16(utf16_data, code_point));
-
-    return utf16_data;
-}
-
 ErrorOr<Utf16Data> utf8_to_utf16(StringView utf8_view)
 {
-    return to_utf16_impl(Utf8View { utf8_view });
+    return utf8_to_utf16(Utf8View { utf8_view });
 }
 
 ErrorOr<Utf16Data> utf8_to_utf16(Utf8View const& utf8_view)
 {
-    return to_utf16_impl(utf8_view);
+    // The valid prefix of the string can be decoded without any checks. Anything after it goes through the code point
+    // iterator, which knows how to replace invalid sequences.
+    size_t valid_bytes = 0;
+    auto is_valid = utf8_view.validate(valid_bytes);
+
+    // Every code unit in UTF-16 needs at least one byte in UTF-8, and so does every replacement character.
+    Utf16Data utf16_data;
+    TRY(utf16_data.try_ensure_capacity(utf8_view.byte_length()));
+
+    auto const* bytes = utf8_view.bytes();
+    size_t offset = 0;
+
+    while (offset < valid_bytes) {
+        // OPTIMIZATION: Widen ASCII 16 bytes at a time.
+        if (offset + 16 <= valid_bytes) {
+            AK::SIMD::u8x16 chunk;
+            __builtin_memcpy(&chunk, bytes + offset, sizeof(chunk));
+            if (AK::SIMD::maskbits(bit_cast<AK::SIMD::i8x16>(chunk)) == 0) {
+                auto code_units = bit_cast<Array<u16, 16>>(__builtin_convertvector(chunk, AK::SIMD::u16x16));
+                utf16_data.unchecked_append(code_units.data(), code_units.size());
+                offset += 16;
+                continue;
+            }
+        }
+
+        u32 code_point = bytes[offset];
+        size_t byte_length = 1;
+        if (code_point >= 0xF0) {
+            code_point = ((code_point & 0x07) << 18) | ((bytes[offset + 1] & 0x3F) << 12) | ((bytes[offset + 2] & 0x3F) << 6) | (bytes[offset + 3] & 0x3F);
+            byte_length = 4;
+        } else if (code_point >= 0xE0) {
+            code_point = ((code_point & 0x0F) << 12) | ((bytes[offset + 1] & 0x3F) << 6) | (bytes[offset + 2] & 0x3F);
+            byte_length = 3;
+        } else if (code_point >= 0xC0) {
+            code_point = ((code_point & 0x1F) << 6) | (bytes[offset + 1] & 0x3F);
+            byte_length = 2;
+        }
+        offset += byte_length;
+
+        if (code_point < first_supplementary_plane_code_point) {
+            utf16_data.unchecked_append(static_cast<u16>(code_point));
+        } else {
+            code_point -= first_supplementary_plane_code_point;
+            utf16_data.unchecked_append(static_cast<u16>(high_surrogate_min | (code_point >> 10)));
+            utf16_data.unchecked_append(static_cast<u16>(low_surrogate_min | (code_point & 0x3ff)));
+        }
+    }
+
+    if (!is_valid) {
+        for (auto code_point : utf8_view.substring_view(valid_bytes))
+            TRY(code_point_to_utf16(utf16_data, code_point));
+    }
+
+    return utf16_data;
 }
 
 ErrorOr<Utf16Data> utf32_to_utf16(Utf32View const& utf32_view)
 {
-    return to_utf16_impl(utf32_view);
+    Utf16Data utf16_data;
+    TRY(utf16_data.try_ensure_capacity(utf32_view.length()));
+
+    for (auto code_point : utf32_view)
+        TRY(code_point_to_utf16(utf16_data, code_point));
+
+    return utf16_data;
 }
 
 ErrorOr<void> code_point_to_utf16(Utf16Data& string, u32 code_point)
@@ -88,26 +136,34 @@ ErrorOr<ByteString> Utf16View::to_byte_string(AllowInvalidCodeUnits allow_invali
 
 ErrorOr<String> Utf16View::to_utf8(AllowInvalidCodeUnits allow_invalid_code_units) const
 {
-    StringBuilder builder;
-
-    if (allow_invalid_code_units == AllowInvalidCodeUnits::Yes) {
-        for (auto const* ptr = begin_ptr(); ptr < end_ptr(); ++ptr) {
-            if (is_high_surrogate(*ptr)) {
-                auto const* next = ptr + 1;
-
-                if ((next < end_ptr()) && is_low_surrogate(*next)) {
-                    auto code_point = decode_surrogate_pair(*ptr, *next);
-                    TRY(builder.try_append_code_point(code_point));
-                    ++ptr;
-                    continue;
-                }
+    auto builder = TRY(StringBuilder::create(length_in_code_units()));
+
+    for (auto const* ptr = begin_ptr(); ptr < end_ptr();) {
+        // OPTIMIZATION: Narrow ASCII 8 code units at a time.
+        if (end_ptr() - ptr >= 8) {
+            AK::SIMD::u16x8 chunk;
+            __builtin_memcpy(&chunk, ptr, sizeof(chunk));
+            auto non_ascii_bits = bit_cast<AK::SIMD::u64x2>(chunk) & 0xff80ff80ff80ff80;
+            if ((non_ascii_bits[0] | non_ascii_bits[1]) == 0) {
+                auto characters = bit_cast<Array<char, 8>>(__builtin_convertvector(chunk, AK::SIMD::u8x8));
+                TRY(builder.try_append(characters.data(), characters.size()));
+                ptr += 8;
+                continue;
             }
+        }
 
-            TRY(builder.try_append_code_point(static_cast<u32>(*ptr)));
+        u32 code_point = *ptr;
+        if (is_high_surrogate(*ptr) && (ptr + 1 < end_ptr()) && is_low_surrogate(*(ptr + 1))) {
+            code_point = decode_surrogate_pair(*ptr, *(ptr + 1));
+            ptr += 2;
+        } else {
+            // Unpaired surrogates are kept as they are if invalid code units are allowed, and replaced otherwise.
+            if (allow_invalid_code_units == AllowInvalidCodeUnits::No && (is_high_surrogate(*ptr) || is_low_surrogate(*ptr)))
+                code_point = replacement_code_point;
+            ++ptr;
         }
-    } else {
-        for (auto code_point : *this)
-            TRY(builder.try_append_code_point(code_point));
+
+        TRY(builder.try_append_code_point(code_point));
     }
 
     return builder.to_string();
@@ -6,8 +6,11 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/Debug.h>
 #include <AK/Format.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Utf8View.h>
 
 namespace AK {
@@ -70,20 +73,97 @@ Utf8View Utf8View::unicode_substring_view(size_t code_point_offset, size_t code_
     VERIFY_NOT_REACHED();
 }
 
+// Returns a mask with one bit set for every byte in the 16 bytes at `bytes` that is not ASCII.
+static u32 non_ascii_byte_mask(u8 const* bytes)
+{
+    AK::SIMD::i8x16 chunk;
+    __builtin_memcpy(&chunk, bytes, sizeof(chunk));
+    return static_cast<u32>(AK::SIMD::maskbits(chunk));
+}
+
 size_t Utf8View::calculate_length() const
 {
     size_t length = 0;
 
-    for (size_t i = 0; i < m_string.length(); ++length) {
+    for (size_t i = 0; i < m_string.length();) {
+        // OPTIMIZATION: Every ASCII byte is a code point of its own, so count them 16 at a time.
+        if (i + 16 <= m_string.length() && non_ascii_byte_mask(begin_ptr() + i) == 0) {
+            i += 16;
+            length += 16;
+            continue;
+        }
+
         auto [byte_length, code_point, is_valid] = decode_leading_byte(static_cast<u8>(m_string[i]));
 
         // Similar to Utf8CodePointIterator::operator++, if the byte is invalid, try the next byte.
         i += is_valid ? byte_length : 1;
+        ++length;
     }
 
     return length;
 }
 
+bool Utf8View::validate_with_fast_paths(size_t& valid_bytes) const
+{
+    auto const* bytes = begin_ptr();
+    auto length = m_string.length();
+    size_t offset = 0;
+
+    while (offset < length) {
+        // OPTIMIZATION: Skip over ASCII 16 bytes at a time.
+        if (offset + 16 <= length) {
+            auto non_ascii_bytes = non_ascii_byte_mask(bytes + offset);
+            if (non_ascii_bytes == 0) {
+                offset += 16;
+                continue;
+            }
+            offset += count_trailing_zeroes(non_ascii_bytes);
+        }
+
+        auto leading_byte = bytes[offset];
+        if (leading_byte <= 0x7F) {
+            ++offset;
+            continue;
+        }
+
+        // This accepts exactly the sequences that validate() accepts when constant evaluated: no overlong encodings and
+        // nothing above U+10FFFF. Like there, encoded surrogates are allowed. The valid range of the second byte is
+        // narrower than 0x80-0xBF after some leading bytes, which takes care of the overlong and out of range sequences.
+        size_t byte_length = 0;
+        u8 second_byte_min = 0x80;
+        u8 second_byte_max = 0xBF;
+        if (leading_byte >= 0xC2 && leading_byte <= 0xDF) {
+            byte_length = 2;
+        } else if (leading_byte >= 0xE0 && leading_byte <= 0xEF) {
+            byte_length = 3;
+            if (leading_byte == 0xE0)
+                second_byte_min = 0xA0;
+        } else if (leading_byte >= 0xF0 && leading_byte <= 0xF4) {
+            byte_length = 4;
+            if (leading_byte == 0xF0)
+                second_byte_min = 0x90;
+            else if (leading_byte == 0xF4)
+                second_byte_max = 0x8F;
+        } else {
+            break;
+        }
+
+        if (offset + byte_length > length)
+            break;
+        if (bytes[offset + 1] < second_byte_min || bytes[offset + 1] > second_byte_max)
+            break;
+        if (byte_length >= 3 && (bytes[offset + 2] & 0xC0) != 0x80)
+            break;
+        if (byte_length == 4 && (bytes[offset + 3] & 0xC0) != 0x80)
+            break;
+
+        offset += byte_length;
+    }
+
+    valid_bytes = offset;
+    return offset == length;
+}
+
 bool Utf8View::starts_with(Utf8View const& start) const
 {
     if (start.is_empty())
@@ -129,6 +129,11 @@ public:
 
     constexpr bool validate(size_t& valid_bytes) const
     {
+#ifndef KERNEL
+        if (!is_constant_evaluated())
+            return validate_with_fast_paths(valid_bytes);
+#endif
+
         valid_bytes = 0;
 
         for (auto it = m_string.begin(); it != m_string.end(); ++it) {
@@ -163,6 +168,7 @@ private:
     u8 const* begin_ptr() const { return reinterpret_cast<u8 const*>(m_string.characters_without_null_termination()); }
     u8 const* end_ptr() const { return begin_ptr() + m_string.length(); }
     size_t calculate_length() const;
+    bool validate_with_fast_paths(size_t& valid_bytes) const;
 
     struct Utf8EncodedByteData {
         size_t byte_length { 0 };
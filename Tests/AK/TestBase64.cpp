@@ -8,6 +8,8 @@
 
 #include <AK/Base64.h>
 #include <AK/ByteString.h>
+#include <AK/MemoryStream.h>
+#include <AK/StringBuilder.h>
 #include <string.h>
 
 TEST_CASE(test_decode)
@@ -121,3 +123,140 @@ TEST_CASE(test_urlencode)
 
     encode_equal("hello!!world"sv, "aGVsbG8hIXdvcmxk"sv);
 }
+
+static ByteBuffer make_test_data(size_t size)
+{
+    auto data = MUST(ByteBuffer::create_uninitialized(size));
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<u8>(i * 167 + (i >> 8) * 13);
+    return data;
+}
+
+static ByteString encode_base64_reference(ReadonlyBytes input, ReadonlySpan<char> alphabet)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < input.size(); i += 3) {
+        u32 group = input[i] << 16;
+        if (i + 1 < input.size())
+            group |= input[i + 1] << 8;
+        if (i + 2 < input.size())
+            group |= input[i + 2];
+
+        builder.append(alphabet[(group >> 18) & 0x3f]);
+        builder.append(alphabet[(group >> 12) & 0x3f]);
+        builder.append(i + 1 < input.size() ? alphabet[(group >> 6) & 0x3f] : '=');
+        builder.append(i + 2 < input.size() ? alphabet[group & 0x3f] : '=');
+    }
+    return builder.to_byte_string();
+}
+
+TEST_CASE(test_long_inputs)
+{
+    for (size_t size = 0; size <= 100; ++size) {
+        auto data = make_test_data(size);
+
+        auto encoded = MUST(encode_base64(data));
+        EXPECT_EQ(encoded.bytes_as_string_view(), encode_base64_reference(data, AK::base64_alphabet));
+        EXPECT_EQ(TRY_OR_FAIL(decode_base64(encoded)), data);
+
+        auto url_encoded = MUST(encode_base64url(data));
+        EXPECT_EQ(url_encoded.bytes_as_string_view(), encode_base64_reference(data, AK::base64url_alphabet));
+        EXPECT_EQ(TRY_OR_FAIL(decode_base64url(url_encoded)), data);
+    }
+}
+
+TEST_CASE(test_decode_invalid_long_inputs)
+{
+    auto encoded = MUST(encode_base64(make_test_data(48))).to_byte_string();
+    EXPECT_EQ(encoded.length(), 64u);
+
+    for (size_t i = 0; i < encoded.length(); ++i) {
+        for (char invalid_character : { '!', '-', '_', '\0', '\x80' }) {
+            auto invalid = ByteString::formatted("{}{}{}", encoded.substring_view(0, i), invalid_character, encoded.substring_view(i + 1));
+            EXPECT(decode_base64(invalid).is_error());
+        }
+    }
+}
+
+TEST_CASE(test_stream_round_trip)
+{
+    auto data = make_test_data(10000);
+    auto expected = MUST(encode_base64(data));
+
+    FixedMemoryStream input { data.bytes() };
+    AllocatingMemoryStream encoded_stream;
+    TRY_OR_FAIL(encode_base64(input, encoded_stream));
+    auto encoded = TRY_OR_FAIL(encoded_stream.read_until_eof());
+    EXPECT_EQ(StringView { encoded }, expected);
+
+    // Wrap lines at 76 characters, as MIME does.
+    StringBuilder wrapped;
+    for (size_t i = 0; i < encoded.size(); i += 76)
+        wrapped.appendff("{}\r\n", StringView { encoded }.substring_view(i, min<size_t>(76, encoded.size() - i)));
+
+    FixedMemoryStream wrapped_input { wrapped.string_view().bytes() };
+    AllocatingMemoryStream decoded_stream;
+    TRY_OR_FAIL(decode_base64(wrapped_input, decoded_stream));
+    EXPECT_EQ(TRY_OR_FAIL(decoded_stream.read_until_eof()), data);
+
+    FixedMemoryStream url_input { data.bytes() };
+    AllocatingMemoryStream url_encoded_stream;
+    TRY_OR_FAIL(encode_base64url(url_input, url_encoded_stream));
+    AllocatingMemoryStream url_decoded_stream;
+    TRY_OR_FAIL(decode_base64url(url_encoded_stream, url_decoded_stream));
+    EXPECT_EQ(TRY_OR_FAIL(url_decoded_stream.read_until_eof()), data);
+}
+
+TEST_CASE(test_stream_decode_invalid)
+{
+    auto decode = [](StringView input) {
+        FixedMemoryStream input_stream { input.bytes() };
+        AllocatingMemoryStream output_stream;
+        return decode_base64(input_stream, output_stream);
+    };
+
+    EXPECT(!decode("Zm9v\nYmFy\n"sv).is_error());
+    EXPECT(decode("Zm9vYmF"sv).is_error());
+    EXPECT(decode("Zm9v:mFy"sv).is_error());
+    EXPECT(decode("Zm9v_mFy"sv).is_error());
+}
+
+static auto const benchmark_data = make_test_data(1 * MiB);
+
+BENCHMARK_CASE(benchmark_encode)
+{
+    for (size_t i = 0; i < 100; ++i) {
+        auto encoded = MUST(encode_base64(benchmark_data));
+        AK::taint_for_optimizer(encoded);
+    }
+}
+
+BENCHMARK_CASE(benchmark_decode)
+{
+    auto encoded = MUST(encode_base64(benchmark_data));
+    for (size_t i = 0; i < 100; ++i) {
+        auto decoded = MUST(decode_base64(encoded));
+        AK::taint_for_optimizer(decoded);
+    }
+}
+
+BENCHMARK_CASE(benchmark_stream_encode)
+{
+    for (size_t i = 0; i < 100; ++i) {
+        FixedMemoryStream input { benchmark_data.bytes() };
+        AllocatingMemoryStream output;
+        MUST(encode_base64(input, output));
+        AK::taint_for_optimizer(output);
+    }
+}
+
+BENCHMARK_CASE(benchmark_stream_decode)
+{
+    auto encoded = MUST(encode_base64(benchmark_data));
+    for (size_t i = 0; i < 100; ++i) {
+        FixedMemoryStream input { encoded.bytes() };
+        AllocatingMemoryStream output;
+        MUST(decode_base64(input, output));
+        AK::taint_for_optimizer(output);
+    }
+}
@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/Hex.h>
+#include <AK/StringBuilder.h>
 
 TEST_CASE(should_decode_hex_digit)
 {
@@ -59,3 +60,70 @@ TEST_CASE(should_constexpr_decode_hex_digit)
     static_assert(14u == decode_hex_digit('E'));
     static_assert(15u == decode_hex_digit('F'));
 }
+
+static ByteBuffer make_test_data(size_t size)
+{
+    auto data = MUST(ByteBuffer::create_uninitialized(size));
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<u8>(i * 167 + (i >> 8) * 13);
+    return data;
+}
+
+TEST_CASE(should_encode_hex)
+{
+    EXPECT_EQ(encode_hex({}), ""sv);
+    EXPECT_EQ(encode_hex("\x00\x0f\xf0\xff\x9a"sv.bytes()), "000ff0ff9a"sv);
+
+    for (size_t size = 0; size <= 70; ++size) {
+        auto data = make_test_data(size);
+        StringBuilder expected;
+        for (auto byte : data.bytes())
+            expected.appendff("{:02x}", byte);
+        EXPECT_EQ(encode_hex(data), expected.string_view());
+    }
+}
+
+TEST_CASE(should_decode_hex)
+{
+    EXPECT_EQ(TRY_OR_FAIL(decode_hex("000ff0ff9A"sv)), "\x00\x0f\xf0\xff\x9a"sv.bytes());
+    EXPECT_EQ(TRY_OR_FAIL(decode_hex("0123456789abcdefABCDEF0123456789"sv)), "\x01\x23\x45\x67\x89\xab\xcd\xef\xab\xcd\xef\x01\x23\x45\x67\x89"sv.bytes());
+
+    for (size_t size = 0; size <= 70; ++size) {
+        auto data = make_test_data(size);
+        EXPECT_EQ(TRY_OR_FAIL(decode_hex(encode_hex(data))), data);
+        EXPECT_EQ(TRY_OR_FAIL(decode_hex(encode_hex(data).to_uppercase())), data);
+    }
+}
+
+TEST_CASE(should_not_decode_invalid_hex)
+{
+    EXPECT(decode_hex("0"sv).is_error());
+    EXPECT(decode_hex("0g"sv).is_error());
+
+    auto encoded = encode_hex(make_test_data(24));
+    for (size_t i = 0; i < encoded.length(); ++i) {
+        for (char invalid_character : { 'g', 'G', '/', ':', '@', '`', ' ', '\0', '\x80' }) {
+            auto invalid = ByteString::formatted("{}{}{}", encoded.substring_view(0, i), invalid_character, encoded.substring_view(i + 1));
+            EXPECT(decode_hex(invalid).is_error());
+        }
+    }
+}
+
+static auto const benchmark_data = make_test_data(1 * MiB);
+
+BENCHMARK_CASE(benchmark_encode_hex)
+{
+    for (size_t i = 0; i < 100; ++i) {
+        auto encoded = encode_hex(benchmark_data);
+        AK::taint_for_optimizer(encoded);
+    }
+}
+
+BENCHMARK_CASE(benchmark_decode_hex)
+{
+    auto encoded = encode_hex(benchmark_data);
+    for (size_t i = 0; i < 100; ++i) {
+        auto decoded = MUST(decode_hex(encoded));
+        AK::taint_for_optimizer(decoded);
+    }
+}
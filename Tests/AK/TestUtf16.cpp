@@ -8,6 +8,7 @@
 
 #include <AK/Array.h>
 #include <AK/String.h>
+#include <AK/StringBuilder.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 #include <AK/Utf16View.h>
@@ -336,3 +337,38 @@ TEST_CASE(starts_with)
     EXPECT(!emoji.starts_with(u"a"));
     EXPECT(!emoji.starts_with(u"🙃"));
 }
+
+TEST_CASE(transcode_long_strings)
+{
+    // Long enough for the ASCII runs to be converted in chunks, with non-ASCII code points at every position within a chunk.
+    StringBuilder builder;
+    for (size_t i = 0; i <= 36; ++i) {
+        builder.append("0123456789abcdefghijklmnopqrstuvwxyz"sv.substring_view(0, i));
+        builder.append(i % 3 == 0 ? "é"sv : (i % 3 == 1 ? "世"sv : "😀"sv));
+    }
+    auto utf8_string = MUST(builder.to_string());
+
+    auto utf16_string = MUST(AK::utf8_to_utf16(utf8_string));
+    Utf16View view { utf16_string };
+    EXPECT_EQ(view.length_in_code_points(), utf8_string.code_points().length());
+
+    size_t i = 0;
+    for (auto code_point : utf8_string.code_points())
+        EXPECT_EQ(view.code_point_at(view.code_unit_offset_of(i++)), code_point);
+
+    EXPECT_EQ(MUST(view.to_utf8(Utf16View::AllowInvalidCodeUnits::Yes)), utf8_string);
+    EXPECT_EQ(MUST(view.to_utf8(Utf16View::AllowInvalidCodeUnits::No)), utf8_string);
+}
+
+TEST_CASE(transcode_invalid_sequences_in_long_strings)
+{
+    // Invalid UTF-8 after a valid prefix is replaced just like the code point iterator does it.
+    auto utf16_string = MUST(AK::utf8_to_utf16("0123456789abcdefghij\xc0\x80\xff\xf4\x90\x80\x80k\xe4"sv));
+    EXPECT_EQ(Utf16View { utf16_string }, Utf16View { u"0123456789abcdefghij\0\ufffd\ufffdk\ufffd" });
+
+    // Unpaired surrogates are kept or replaced, depending on AllowInvalidCodeUnits.
+    Array<u16, 20> code_units { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 0xd800, 'i', 0xdc00, 0xd83d, 0xde00, 'j', 'k', 'l', 'm', 'n', 'o', 0xd800 };
+    Utf16View view { code_units };
+    EXPECT_EQ(MUST(view.to_utf8(Utf16View::AllowInvalidCodeUnits::Yes)), "abcdefgh\xed\xa0\x80i\xed\xb0\x80😀jklmno\xed\xa0\x80"sv);
+    EXPECT_EQ(MUST(view.to_utf8(Utf16View::AllowInvalidCodeUnits::No)), "abcdefgh\ufffdi\ufffd😀jklmno\ufffd"sv);
+}
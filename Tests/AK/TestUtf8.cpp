@@ -7,6 +7,9 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/ByteBuffer.h>
+#include <AK/StringBuilder.h>
+#include <AK/UnicodeUtils.h>
+#include <AK/Utf16View.h>
 #include <AK/Utf8View.h>
 
 TEST_CASE(decode_ascii)
@@ -295,3 +298,147 @@ TEST_CASE(trim)
         EXPECT_EQ(view.trim(whitespace, TrimMode::Right).as_string(), "\u180E");
     }
 }
+
+// A string is valid UTF-8 if every code point that the iterator decodes from it is encoded with the same bytes again.
+static size_t valid_bytes_according_to_iterator(Utf8View view)
+{
+    for (auto it = view.begin(); it != view.end(); ++it) {
+        auto bytes = it.underlying_code_point_bytes();
+        auto code_point = *it;
+        if (code_point == 0xFFFD && StringView { bytes } != "\uFFFD"sv)
+            return view.byte_offset_of(it);
+        if (static_cast<size_t>(AK::UnicodeUtils::bytes_to_store_code_point_in_utf8(code_point)) != bytes.size())
+            return view.byte_offset_of(it);
+    }
+    return view.byte_length();
+}
+
+TEST_CASE(validate_matches_iterator)
+{
+    // Interesting values for the bytes after a leading byte, around the boundaries of the valid ranges.
+    constexpr Array<u8, 11> following_bytes { 0x00, 0x41, 0x7f, 0x80, 0x8f, 0x90, 0x9f, 0xa0, 0xbf, 0xc0, 0xff };
+
+    // Place the sequences so that they are in the scalar tail, at the start, in the middle and across the end of a 16 byte chunk.
+    constexpr Array<size_t, 5> offsets { 0, 7, 14, 16, 40 };
+
+    Array<u8, 48> buffer;
+    for (u32 leading_byte = 0x80; leading_byte <= 0xff; ++leading_byte) {
+        for (auto second_byte : following_bytes) {
+            for (auto third_byte : following_bytes) {
+                for (auto fourth_byte : following_bytes) {
+                    for (auto offset : offsets) {
+                        buffer.fill('a');
+                        buffer[offset] = leading_byte;
+                        buffer[offset + 1] = second_byte;
+                        buffer[offset + 2] = third_byte;
+                        buffer[offset + 3] = fourth_byte;
+
+                        for (auto length : Array<size_t, 3> { offset + 2, offset + 4, buffer.size() }) {
+                            Utf8View view { StringView { buffer.span().trim(length) } };
+                            auto expected_valid_bytes = valid_bytes_according_to_iterator(view);
+
+                            size_t valid_bytes = 0;
+                            EXPECT_EQ(view.validate(valid_bytes), expected_valid_bytes == length);
+                            EXPECT_EQ(valid_bytes, expected_valid_bytes);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(length_of_long_strings)
+{
+    EXPECT_EQ(Utf8View { "This is a somewhat long string, consisting of ASCII only."sv }.length(), 57u);
+    EXPECT_EQ(Utf8View { "This is a somewhat long string, but 😀 is not ASCII, and neither is é."sv }.length(), 69u);
+
+    // Invalid bytes are counted as one code point each.
+    EXPECT_EQ(Utf8View { "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"sv }.length(), 17u);
+}
+
+// The benchmarks below run over about 1 MiB of text, built from these samples.
+static constexpr auto ascii_heavy_sample = "The quick brown fox jumps over the lazy dog, and the café's naïve owner didn't notice. "sv;
+static constexpr auto cjk_sample = "敏捷的棕色狐狸跳过了懒狗。素早い茶色の狐がのろまな犬を飛び越える。다람쥐 헌 쳇바퀴에 타고파. "sv;
+static constexpr auto emoji_mixed_sample = "Release day 🚀🎉! Tests pass ✅, the build is green 🟢 and coffee is ready ☕😀👍🏽. "sv;
+
+static ByteString make_corpus(StringView sample)
+{
+    StringBuilder builder;
+    while (builder.length() < 1 * MiB)
+        builder.append(sample);
+    return builder.to_byte_string();
+}
+
+static void benchmark_validate(StringView sample)
+{
+    auto corpus = make_corpus(sample);
+    for (size_t i = 0; i < 100; ++i) {
+        Utf8View view { corpus.view() };
+        AK::taint_for_optimizer(view);
+        EXPECT(view.validate());
+    }
+}
+
+static void benchmark_utf8_to_utf16(StringView sample)
+{
+    auto corpus = make_corpus(sample);
+    for (size_t i = 0; i < 20; ++i) {
+        auto utf16 = MUST(AK::utf8_to_utf16(corpus));
+        EXPECT(!utf16.is_empty());
+    }
+}
+
+static void benchmark_utf16_to_utf8(StringView sample)
+{
+    auto corpus = MUST(AK::utf8_to_utf16(make_corpus(sample)));
+    for (size_t i = 0; i < 20; ++i) {
+        auto utf8 = MUST(Utf16View { corpus }.to_utf8());
+        EXPECT(!utf8.is_empty());
+    }
+}
+
+BENCHMARK_CASE(validate_ascii_heavy)
+{
+    benchmark_validate(ascii_heavy_sample);
+}
+
+BENCHMARK_CASE(validate_cjk)
+{
+    benchmark_validate(cjk_sample);
+}
+
+BENCHMARK_CASE(validate_emoji_mixed)
+{
+    benchmark_validate(emoji_mixed_sample);
+}
+
+BENCHMARK_CASE(utf8_to_utf16_ascii_heavy)
+{
+    benchmark_utf8_to_utf16(ascii_heavy_sample);
+}
+
+BENCHMARK_CASE(utf8_to_utf16_cjk)
+{
+    benchmark_utf8_to_utf16(cjk_sample);
+}
+
+BENCHMARK_CASE(utf8_to_utf16_emoji_mixed)
+{
+    benchmark_utf8_to_utf16(emoji_mixed_sample);
+}
+
+BENCHMARK_CASE(utf16_to_utf8_ascii_heavy)
+{
+    benchmark_utf16_to_utf8(ascii_heavy_sample);
+}
+
+BENCHMARK_CASE(utf16_to_utf8_cjk)
+{
+    benchmark_utf16_to_utf8(cjk_sample);
+}
+
+BENCHMARK_CASE(utf16_to_utf8_emoji_mixed)
+{
+    benchmark_utf16_to_utf8(emoji_mixed_sample);
+}
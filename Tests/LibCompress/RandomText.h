@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/ByteBuffer.h>
+#include <AK/Random.h>
+#include <AK/StringBuilder.h>
+
+// Returns at least `size` bytes of text made of a few words in random order. Unlike random bytes, this compresses well,
+// while still being different enough from one part to the next to exercise the matchers.
+inline ByteBuffer generate_random_text(size_t size)
+{
+    Array words { "compressors"sv, "split"sv, "the"sv, "data"sv, "into"sv, "blocks"sv, "on"sv, "many"sv, "threads"sv, "with"sv, "a"sv, "shared"sv, "dictionary"sv, "\n"sv };
+    StringBuilder builder;
+    while (builder.length() < size) {
+        builder.append(words[get_random_uniform(words.size())]);
+        builder.append(' ');
+    }
+    return MUST(builder.to_byte_buffer());
+}
@@ -9,7 +9,9 @@
 #include <AK/BitStream.h>
 #include <AK/MaybeOwned.h>
 #include <AK/MemoryStream.h>
+#include <AK/Random.h>
 #include <LibCompress/Brotli.h>
+#include <LibCompress/Deflate.h>
 #include <LibCore/File.h>
 
 TEST_CASE(dictionary_use_after_uncompressed_block)
@@ -177,3 +179,144 @@ TEST_CASE(brotli_decompress_zero_one_bin)
     EXPECT(bytes_read == 32 * MiB);
     EXPECT(brotli_stream.is_eof());
 }
+
+using CompressionLevel = Compress::BrotliCompressionStream::CompressionLevel;
+static constexpr CompressionLevel all_compression_levels[] = { CompressionLevel::STORE, CompressionLevel::FAST, CompressionLevel::GOOD, CompressionLevel::GREAT, CompressionLevel::BEST };
+
+static ByteBuffer read_test_file(StringView file_name)
+{
+#ifdef AK_OS_SERENITY
+    ByteString path = ByteString::formatted("/usr/Tests/LibCompress/brotli-test-files/{}", file_name);
+#else
+    ByteString path = ByteString::formatted("brotli-test-files/{}", file_name);
+#endif
+
+    auto file = MUST(Core::File::open(path, Core::File::OpenMode::Read));
+    return MUST(file->read_until_eof());
+}
+
+static void expect_round_trip(ReadonlyBytes original, CompressionLevel compression_level)
+{
+    auto compressed = TRY_OR_FAIL(Compress::BrotliCompressionStream::compress_all(original, compression_level));
+
+    FixedMemoryStream compressed_stream { compressed.bytes() };
+    auto decompressor = Compress::BrotliDecompressionStream { MaybeOwned<Stream>(compressed_stream) };
+    auto decompressed = TRY_OR_FAIL(decompressor.read_until_eof());
+    EXPECT_EQ(decompressed.bytes(), original);
+}
+
+TEST_CASE(brotli_round_trip_empty)
+{
+    for (auto compression_level : all_compression_levels)
+        expect_round_trip({}, compression_level);
+}
+
+TEST_CASE(brotli_round_trip_small)
+{
+    for (auto compression_level : all_compression_levels) {
+        expect_round_trip("x"sv.bytes(), compression_level);
+        expect_round_trip("hello, hello, hello"sv.bytes(), compression_level);
+        expect_round_trip("The quick brown fox jumps over the lazy dog. The Quick Brown Fox, THE LAZY DOG."sv.bytes(), compression_level);
+    }
+}
+
+TEST_CASE(brotli_round_trip_files)
+{
+    for (auto file_name : { "lorem.txt"sv, "transform.txt"sv, "serenityos.html"sv, "happy3rd.html"sv, "KaticaRegular10.font"sv }) {
+        auto original = read_test_file(file_name);
+        for (auto compression_level : all_compression_levels)
+            expect_round_trip(original, compression_level);
+    }
+}
+
+TEST_CASE(brotli_round_trip_random)
+{
+    auto original = MUST(ByteBuffer::create_uninitialized(64 * KiB));
+    fill_with_random(original);
+    for (auto compression_level : all_compression_levels)
+        expect_round_trip(original, compression_level);
+}
+
+TEST_CASE(brotli_round_trip_repetitive)
+{
+    // Long runs and repeats exercise long copies and the repeated distances.
+    auto original = MUST(ByteBuffer::create_zeroed(100 * KiB));
+    for (size_t i = 0; i < original.size(); i += 1000) {
+        for (size_t j = 0; j < 10 && i + j < original.size(); ++j)
+            original[i + j] = "0123456789"[(i / 1000 + j) % 10];
+    }
+    for (auto compression_level : all_compression_levels)
+        expect_round_trip(original, compression_level);
+}
+
+TEST_CASE(brotli_round_trip_multiple_blocks)
+{
+    // Spans several meta-blocks with matches that reach back into previous ones.
+    auto text = read_test_file("serenityos.html"sv);
+    auto original = MUST(ByteBuffer::create_uninitialized(Compress::BrotliCompressionStream::block_size * 2 + 12345));
+    for (size_t i = 0; i < original.size(); ++i)
+        original[i] = text[i % text.size()] ^ (i % 4099 == 0 ? 0x20 : 0);
+    expect_round_trip(original, CompressionLevel::FAST);
+    expect_round_trip(original, CompressionLevel::GREAT);
+}
+
+TEST_CASE(brotli_compress_streaming_writes)
+{
+    auto original = read_test_file("happy3rd.html"sv);
+
+    auto compressed_stream = make<AllocatingMemoryStream>();
+    auto compressor = TRY_OR_FAIL(Compress::BrotliCompressionStream::construct(MaybeOwned<Stream>(*compressed_stream)));
+    for (size_t offset = 0; offset < original.size(); offset += 777)
+        TRY_OR_FAIL(compressor->write_until_depleted(original.bytes().slice(offset, min<size_t>(777, original.size() - offset))));
+    TRY_OR_FAIL(compressor->final_flush());
+
+    auto decompressor = Compress::BrotliDecompressionStream { MaybeOwned<Stream>(*compressed_stream) };
+    auto decompressed = TRY_OR_FAIL(decompressor.read_until_eof());
+    EXPECT_EQ(decompressed.bytes(), original.bytes());
+}
+
+TEST_CASE(brotli_compress_beats_deflate)
+{
+    auto original = read_test_file("serenityos.html"sv);
+    auto brotli = TRY_OR_FAIL(Compress::BrotliCompressionStream::compress_all(original));
+    auto deflate = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original));
+    EXPECT(brotli.size() < deflate.size());
+}
+
+static ByteBuffer benchmark_input()
+{
+    // A mix of web content and binary data.
+    ByteBuffer input;
+    for (auto file_name : { "serenityos.html"sv, "happy3rd.html"sv, "lorem.txt"sv, "transform.txt"sv, "KaticaRegular10.font"sv })
+        input.append(read_test_file(file_name));
+    return input;
+}
+
+BENCHMARK_CASE(brotli_compress_ratio)
+{
+    auto input = benchmark_input();
+    auto deflate = MUST(Compress::DeflateCompressor::compress_all(input));
+    outln("input: {} bytes, deflate: {} bytes", input.size(), deflate.size());
+    for (auto compression_level : all_compression_levels) {
+        auto compressed = MUST(Compress::BrotliCompressionStream::compress_all(input, compression_level));
+        outln("brotli level {}: {} bytes ({}% of deflate)", to_underlying(compression_level), compressed.size(), compressed.size() * 100 / deflate.size());
+    }
+}
+
+BENCHMARK_CASE(brotli_compress_throughput)
+{
+    auto input = benchmark_input();
+    for (size_t i = 0; i < 10; ++i) {
+        auto compressed = MUST(Compress::BrotliCompressionStream::compress_all(input));
+        AK::taint_for_optimizer(compressed);
+    }
+}
+
+BENCHMARK_CASE(deflate_compress_throughput)
+{
+    auto input = benchmark_input();
+    for (size_t i = 0; i < 10; ++i) {
+        auto compressed = MUST(Compress::DeflateCompressor::compress_all(input));
+        AK::taint_for_optimizer(compressed);
+    }
+}
@@ -156,6 +156,45 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(deflate_round_trip_compress_across_blocks)
+{
+    auto chunk = ByteBuffer::create_uninitialized(20000).release_value();
+    fill_with_random(chunk);
+    ByteBuffer original;
+    while (original.size() < Compress::DeflateCompressor::block_size * 3)
+        original.append(chunk);
+    // Most of the repetitions can only be found in the history of the previous block
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original));
+    EXPECT(compressed.size() < original.size() / 3);
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
+TEST_CASE(deflate_concatenate_synced_streams)
+{
+    auto original = ByteBuffer::create_zeroed(50000).release_value();
+    fill_with_random(original.bytes().trim(10000));
+    original.overwrite(20000, original.data(), 10000);
+    auto split = 25000;
+
+    AllocatingMemoryStream output_stream;
+    auto first_compressor = TRY_OR_FAIL(Compress::DeflateCompressor::construct(MaybeOwned<Stream>(output_stream)));
+    TRY_OR_FAIL(first_compressor->write_until_depleted(original.bytes().trim(split)));
+    TRY_OR_FAIL(first_compressor->sync_flush());
+    auto first_size = output_stream.used_buffer_size();
+
+    auto second_compressor = TRY_OR_FAIL(Compress::DeflateCompressor::construct(MaybeOwned<Stream>(output_stream)));
+    second_compressor->set_dictionary(original.bytes().trim(split));
+    TRY_OR_FAIL(second_compressor->write_until_depleted(original.bytes().slice(split)));
+    TRY_OR_FAIL(second_compressor->final_flush());
+    // The second part mostly repeats the first one, so it can refer back into the dictionary
+    EXPECT(output_stream.used_buffer_size() - first_size < 1000);
+
+    auto compressed = TRY_OR_FAIL(output_stream.read_until_eof());
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
@@ -180,3 +219,29 @@ TEST_CASE(ossfuzz_58046)
     auto test_data = TRY_OR_FAIL(test_file->read_until_eof());
     EXPECT(Compress::DeflateDecompressor::decompress_all(test_data).is_error());
 }
+
+static ByteBuffer compressed_benchmark_input()
+{
+    // Similar to a tarball, this mixes text, markup and binary data.
+    ByteBuffer input;
+    for (auto path : { TEST_INPUT("../brotli-test-files/happy3rd.html"sv), TEST_INPUT("../brotli-test-files/KaticaRegular10.font"sv), TEST_INPUT("../brotli-test-files/transform.txt"sv), TEST_INPUT("../brotli-test-files/serenityos.html"sv) }) {
+        auto file = MUST(Core::File::open(path, Core::File::OpenMode::Read));
+        input.append(MUST(file->read_until_eof()));
+    }
+    return MUST(Compress::DeflateCompressor::compress_all(input));
+}
+
+BENCHMARK_CASE(deflate_decompress_mixed_files)
+{
+    auto compressed = compressed_benchmark_input();
+    for (size_t i = 0; i < 20; ++i)
+        (void)MUST(Compress::DeflateDecompressor::decompress_all(compressed));
+}
+
+BENCHMARK_CASE(deflate_decompress_fixed_huffman)
+{
+    // Short messages compress into fixed Huffman blocks.
+    auto compressed = MUST(Compress::DeflateCompressor::compress_all("Hello, friends! Hello, friends! Goodbye."sv.bytes()));
+    for (size_t i = 0; i < 100'000; ++i)
+        (void)MUST(Compress::DeflateDecompressor::decompress_all(compressed));
+}
@@ -6,6 +6,7 @@
 
 #include <LibTest/TestCase.h>
 
+#include "RandomText.h"
 #include <AK/Array.h>
 #include <AK/Random.h>
 #include <LibCompress/Gzip.h>
@@ -94,6 +95,20 @@ TEST_CASE(gzip_round_trip)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(gzip_round_trip_multiple_threads)
+{
+    for (auto size : { 0uz, 1000uz, Compress::GzipCompressor::parallel_part_size, Compress::GzipCompressor::parallel_part_size * 5 + 12345 }) {
+        auto original = generate_random_text(size);
+        auto compressed = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(original, Compress::GzipCompressor::Threads::Multiple));
+        auto uncompressed = TRY_OR_FAIL(Compress::GzipDecompressor::decompress_all(compressed));
+        EXPECT(uncompressed == original);
+
+        // The parts are compressed with the previous part as their dictionary, so they are barely worse than a single stream
+        auto single_threaded = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(original));
+        EXPECT(compressed.size() <= single_threaded.size() + single_threaded.size() / 50 + 20);
+    }
+}
+
 TEST_CASE(gzip_truncated_uncompressed_block)
 {
     Array<u8, 38> const compressed {
@@ -105,3 +120,15 @@ TEST_CASE(gzip_truncated_uncompressed_block)
     auto const decompressed_or_error = Compress::GzipDecompressor::decompress_all(compressed);
     EXPECT(decompressed_or_error.is_error());
 }
+
+BENCHMARK_CASE(gzip_compress_single_thread)
+{
+    auto input = generate_random_text(4 * MiB);
+    (void)MUST(Compress::GzipCompressor::compress_all(input));
+}
+
+BENCHMARK_CASE(gzip_compress_multiple_threads)
+{
+    auto input = generate_random_text(4 * MiB);
+    (void)MUST(Compress::GzipCompressor::compress_all(input, Compress::GzipCompressor::Threads::Multiple));
+}
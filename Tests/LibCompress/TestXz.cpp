@@ -6,8 +6,11 @@
 
 #include <LibTest/TestCase.h>
 
+#include "RandomText.h"
 #include <AK/MemoryStream.h>
+#include <AK/Random.h>
 #include <LibCompress/Xz.h>
+#include <LibCrypto/Checksum/CRC32.h>
 
 TEST_CASE(lzma2_compressed_without_settings_after_uncompressed)
 {
@@ -2057,3 +2060,133 @@ TEST_CASE(xz_utils_unsupported_filter_flags_3)
     auto buffer_or_error = decompressor->read_until_eof(PAGE_SIZE);
     EXPECT(buffer_or_error.is_error());
 }
+
+static ByteBuffer decompress_as_stream(ReadonlyBytes compressed)
+{
+    auto stream = MUST(try_make<FixedMemoryStream>(compressed));
+    auto decompressor = MUST(Compress::XzDecompressor::create(move(stream)));
+    return MUST(decompressor->read_until_eof(PAGE_SIZE));
+}
+
+TEST_CASE(xz_round_trip)
+{
+    auto random_data = MUST(ByteBuffer::create_uninitialized(100'000));
+    fill_with_random(random_data);
+
+    for (auto original : { ByteBuffer {}, MUST(ByteBuffer::copy("Hello, friends!"sv.bytes())), generate_random_text(200'000), random_data }) {
+        auto compressed = TRY_OR_FAIL(Compress::XzCompressor::compress_all(original));
+        EXPECT_EQ(decompress_as_stream(compressed), original);
+        EXPECT_EQ(TRY_OR_FAIL(Compress::XzDecompressor::decompress_all(compressed)), original);
+    }
+}
+
+TEST_CASE(xz_round_trip_multiple_blocks)
+{
+    constexpr size_t block_size = 64 * KiB;
+    auto original = generate_random_text(block_size * 5 + 1234);
+
+    auto compressed = TRY_OR_FAIL(Compress::XzCompressor::compress_all(original, Compress::XzCompressor::Threads::Multiple, block_size));
+    EXPECT_EQ(decompress_as_stream(compressed), original);
+    EXPECT_EQ(TRY_OR_FAIL(Compress::XzDecompressor::decompress_all(compressed)), original);
+
+    // The blocks do not depend on how many of them are compressed at the same time.
+    auto single_threaded = TRY_OR_FAIL(Compress::XzCompressor::compress_all(original, Compress::XzCompressor::Threads::Single, block_size));
+    EXPECT_EQ(compressed, single_threaded);
+}
+
+TEST_CASE(xz_decompress_all_multiple_streams)
+{
+    auto first = generate_random_text(100'000);
+    auto second = generate_random_text(50'000);
+
+    auto compressed = TRY_OR_FAIL(Compress::XzCompressor::compress_all(first, Compress::XzCompressor::Threads::Multiple, 32 * KiB));
+    // Stream Padding
+    compressed.append(Array<u8, 8> {});
+    compressed.append(TRY_OR_FAIL(Compress::XzCompressor::compress_all(second, Compress::XzCompressor::Threads::Multiple, 32 * KiB)));
+
+    auto expected = first;
+    expected.append(second);
+    EXPECT_EQ(TRY_OR_FAIL(Compress::XzDecompressor::decompress_all(compressed)), expected);
+}
+
+TEST_CASE(xz_decompress_all_corrupted_block)
+{
+    auto compressed = TRY_OR_FAIL(Compress::XzCompressor::compress_all(generate_random_text(100'000), Compress::XzCompressor::Threads::Multiple, 32 * KiB));
+
+    // The index is intact, so the corruption is only noticed while decompressing the second block.
+    compressed[compressed.size() / 2] ^= 0x55;
+    EXPECT(Compress::XzDecompressor::decompress_all(compressed).is_error());
+
+    // A broken index falls back to decompressing the blocks one after another, which fails as well.
+    compressed[compressed.size() - 20] ^= 0x55;
+    EXPECT(Compress::XzDecompressor::decompress_all(compressed).is_error());
+}
+
+// Replaces the index of a stream with a single block by one that claims a different uncompressed size for the block.
+static ByteBuffer with_claimed_uncompressed_size(ReadonlyBytes compressed, u64 uncompressed_size)
+{
+    Compress::XzStreamFooter footer;
+    compressed.slice(compressed.size() - sizeof(footer)).copy_to({ &footer, sizeof(footer) });
+    auto const index_start = compressed.size() - sizeof(footer) - footer.backward_size();
+
+    FixedMemoryStream old_index { compressed.slice(index_start, footer.backward_size()) };
+    VERIFY(MUST(old_index.read_value<u8>()) == 0x00);
+    VERIFY(MUST(old_index.read_value<Compress::XzMultibyteInteger>()) == 1);
+    auto const unpadded_size = MUST(old_index.read_value<Compress::XzMultibyteInteger>());
+
+    AllocatingMemoryStream index_stream;
+    MUST(index_stream.write_value<u8>(0x00));
+    MUST(index_stream.write_value(Compress::XzMultibyteInteger { 1 }));
+    MUST(index_stream.write_value(unpadded_size));
+    MUST(index_stream.write_value(Compress::XzMultibyteInteger { uncompressed_size }));
+    while (index_stream.used_buffer_size() % 4 != 0)
+        MUST(index_stream.write_value<u8>(0x00));
+    auto index = MUST(index_stream.read_until_eof());
+    LittleEndian<u32> const index_crc32 = Crypto::Checksum::CRC32 { index }.digest();
+    index.append(ReadonlyBytes { &index_crc32, sizeof(index_crc32) });
+
+    footer.encoded_backward_size = index.size() / 4 - 1;
+    footer.size_and_flags_crc32 = Crypto::Checksum::CRC32 { ReadonlyBytes { &footer.encoded_backward_size, sizeof(footer.encoded_backward_size) + sizeof(footer.flags) } }.digest();
+
+    auto result = MUST(ByteBuffer::copy(compressed.trim(index_start)));
+    result.append(index);
+    result.append(ReadonlyBytes { &footer, sizeof(footer) });
+    return result;
+}
+
+TEST_CASE(xz_decompress_all_untrusted_index)
+{
+    auto original = generate_random_text(10'000);
+    auto compressed = TRY_OR_FAIL(Compress::XzCompressor::compress_all(original));
+    EXPECT_EQ(TRY_OR_FAIL(Compress::XzDecompressor::decompress_all(with_claimed_uncompressed_size(compressed, original.size()))), original);
+
+    // An index that claims far more data than the block holds must not make the output that large up front.
+    EXPECT(Compress::XzDecompressor::decompress_all(with_claimed_uncompressed_size(compressed, 1ull << 60)).is_error());
+    EXPECT(Compress::XzDecompressor::decompress_all(with_claimed_uncompressed_size(compressed, original.size() + 1)).is_error());
+    EXPECT(Compress::XzDecompressor::decompress_all(with_claimed_uncompressed_size(compressed, original.size() - 1)).is_error());
+}
+
+TEST_CASE(xz_decompress_all_without_stream)
+{
+    EXPECT(Compress::XzDecompressor::decompress_all({}).is_error());
+    EXPECT(Compress::XzDecompressor::decompress_all(Array<u8, 8> {}).is_error());
+}
+
+BENCHMARK_CASE(xz_compress_single_thread)
+{
+    auto input = generate_random_text(1 * MiB);
+    (void)MUST(Compress::XzCompressor::compress_all(input, Compress::XzCompressor::Threads::Single, 256 * KiB));
+}
+
+BENCHMARK_CASE(xz_compress_multiple_threads)
+{
+    auto input = generate_random_text(1 * MiB);
+    (void)MUST(Compress::XzCompressor::compress_all(input, Compress::XzCompressor::Threads::Multiple, 256 * KiB));
+}
+
+BENCHMARK_CASE(xz_decompress_blocks)
+{
+    auto compressed = MUST(Compress::XzCompressor::compress_all(generate_random_text(1 * MiB), Compress::XzCompressor::Threads::Multiple, 256 * KiB));
+    for (size_t i = 0; i < 10; ++i)
+        (void)MUST(Compress::XzDecompressor::decompress_all(compressed));
+}
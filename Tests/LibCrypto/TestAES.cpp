@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCrypto/Authentication/GHash.h>
 #include <LibCrypto/BigInt/UnsignedBigInteger.h>
 #include <LibCrypto/Checksum/Adler32.h>
 #include <LibCrypto/Cipher/AES.h>
@@ -454,3 +455,185 @@ TEST_CASE(test_AES_GCM_128bit_decrypt_multiple_blocks_with_aad)
     EXPECT(memcmp(result_pt, out.data(), out.size()) == 0);
     EXPECT_EQ(consistency, Crypto::VerificationConsistency::Consistent);
 }
+
+static ByteBuffer generate_bytes(size_t size)
+{
+    auto buffer = ByteBuffer::create_uninitialized(size).release_value();
+    u32 state = 0x12345678;
+    for (auto& byte : buffer.bytes()) {
+        state = state * 1103515245 + 12345;
+        byte = state >> 24;
+    }
+    return buffer;
+}
+
+TEST_CASE(test_AES_CTR_bulk_matches_single_blocks)
+{
+    auto key = "\x2b\x7e\x15\x16\x28\xae\xd2\xa6\xab\xf7\x15\x88\x09\xcf\x4f\x3c"_b;
+    // The counter carries out of its low 64 bits after the second block.
+    u8 iv[] { 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe };
+    auto in = generate_bytes(1000);
+
+    Crypto::Cipher::AESCipher::CTRMode cipher(key, 128, Crypto::Cipher::Intent::Encryption);
+    auto out = ByteBuffer::create_uninitialized(in.size()).release_value();
+    auto out_bytes = out.bytes();
+    cipher.encrypt(in, out_bytes, { iv, sizeof(iv) });
+
+    Crypto::Cipher::AESCipher aes(key, 128);
+    Bytes counter { iv, sizeof(iv) };
+    for (size_t offset = 0; offset < in.size(); offset += 16) {
+        Crypto::Cipher::AESCipherBlock block(counter.data(), counter.size());
+        aes.encrypt_block(block, block);
+        for (size_t i = offset; i < min(offset + 16, in.size()); ++i)
+            EXPECT_EQ(out[i], in[i] ^ block.bytes()[i - offset]);
+        Crypto::Cipher::IncrementInplace {}(counter);
+    }
+}
+
+TEST_CASE(test_AES_CBC_bulk_matches_single_blocks)
+{
+    auto key = "\x60\x3d\xeb\x10\x15\xca\x71\xbe\x2b\x73\xae\xf0\x85\x7d\x77\x81\x1f\x35\x2c\x07\x3b\x61\x08\xd7\x2d\x98\x10\xa3\x09\x14\xdf\xf4"_b;
+    auto iv = "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f"_b;
+    auto in = generate_bytes(4096);
+    in[in.size() - 1] = 0xaa;
+
+    Crypto::Cipher::AESCipher::CBCMode encryptor(key, 256, Crypto::Cipher::Intent::Encryption, Crypto::Cipher::PaddingMode::Null);
+    auto encrypted = ByteBuffer::create_uninitialized(in.size()).release_value();
+    auto encrypted_bytes = encrypted.bytes();
+    encryptor.encrypt(in, encrypted_bytes, iv);
+
+    Crypto::Cipher::AESCipher aes(key, 256);
+    ReadonlyBytes previous = iv;
+    for (size_t offset = 0; offset < in.size(); offset += 16) {
+        Crypto::Cipher::AESCipherBlock block(in.offset_pointer(offset), 16);
+        block.apply_initialization_vector(previous);
+        aes.encrypt_block(block, block);
+        EXPECT(block.bytes() == encrypted.bytes().slice(offset, 16));
+        previous = encrypted.bytes().slice(offset, 16);
+    }
+
+    Crypto::Cipher::AESCipher::CBCMode decryptor(key, 256, Crypto::Cipher::Intent::Decryption, Crypto::Cipher::PaddingMode::Null);
+    auto decrypted = ByteBuffer::create_uninitialized(in.size()).release_value();
+    auto decrypted_bytes = decrypted.bytes();
+    decryptor.decrypt(encrypted, decrypted_bytes, iv);
+    EXPECT(decrypted_bytes == in.bytes());
+}
+
+static Crypto::Authentication::GHashDigest bitwise_ghash(ReadonlyBytes key, ReadonlyBytes aad, ReadonlyBytes cipher)
+{
+    auto load_block = [](ReadonlyBytes bytes, u32 (&block)[4]) {
+        u8 padded[16] {};
+        __builtin_memcpy(padded, bytes.data(), min(bytes.size(), sizeof(padded)));
+        for (size_t i = 0; i < 4; ++i)
+            block[i] = (padded[4 * i] << 24) | (padded[4 * i + 1] << 16) | (padded[4 * i + 2] << 8) | padded[4 * i + 3];
+    };
+
+    u32 h[4];
+    load_block(key, h);
+    u32 tag[4] {};
+    for (auto data : { aad, cipher }) {
+        for (size_t offset = 0; offset < data.size(); offset += 16) {
+            u32 block[4];
+            load_block(data.slice(offset), block);
+            for (size_t i = 0; i < 4; ++i)
+                tag[i] ^= block[i];
+            Crypto::Authentication::galois_multiply(tag, h, tag);
+        }
+    }
+    u64 aad_bits = aad.size() * 8;
+    u64 cipher_bits = cipher.size() * 8;
+    tag[0] ^= aad_bits >> 32;
+    tag[1] ^= aad_bits & 0xffffffff;
+    tag[2] ^= cipher_bits >> 32;
+    tag[3] ^= cipher_bits & 0xffffffff;
+    Crypto::Authentication::galois_multiply(tag, h, tag);
+
+    Crypto::Authentication::GHashDigest digest;
+    for (size_t i = 0; i < 16; ++i)
+        digest.data[i] = tag[i / 4] >> (24 - 8 * (i % 4));
+    return digest;
+}
+
+TEST_CASE(test_GHash_matches_bitwise_multiplication)
+{
+    auto key = "\x66\xe9\x4b\xd4\xef\x8a\x2c\x3b\x88\x4c\xfa\x59\xca\x34\x2b\x2e"_b;
+    auto data = generate_bytes(1000);
+
+    // Cover every number of trailing bytes, and enough blocks for any batching of the multiplications.
+    for (size_t aad_size : { 0, 7, 16, 20 }) {
+        for (size_t cipher_size = 0; cipher_size <= 150; ++cipher_size) {
+            auto aad = data.bytes().slice(900, aad_size);
+            auto cipher = data.bytes().slice(0, cipher_size);
+            auto expected = bitwise_ghash(key, aad, cipher);
+            auto actual = Crypto::Authentication::GHash(key).process(aad, cipher);
+            EXPECT(ReadonlyBytes(actual.data, 16) == ReadonlyBytes(expected.data, 16));
+        }
+    }
+}
+
+TEST_CASE(test_AES_GCM_round_trip_large_input)
+{
+    auto key = "\xfe\xff\xe9\x92\x86\x65\x73\x1c\x6d\x6a\x8f\x94\x67\x30\x83\x08"_b;
+    auto iv = "\xca\xfe\xba\xbe\xfa\xce\xdb\xad\xde\xca\xf8\x88\x00\x00\x00\x00"_b;
+    auto aad = "\xde\xad\xbe\xef\xfa\xaf\x11\xcc"_b;
+    auto in = generate_bytes(10000 + 3);
+
+    Crypto::Cipher::AESCipher::GCMMode cipher(key, 128, Crypto::Cipher::Intent::Encryption);
+    auto encrypted = ByteBuffer::create_uninitialized(in.size()).release_value();
+    u8 tag[16];
+    cipher.encrypt(in, encrypted.bytes(), iv, aad, { tag, sizeof(tag) });
+
+    auto decrypted = ByteBuffer::create_uninitialized(in.size()).release_value();
+    auto consistency = cipher.decrypt(encrypted, decrypted.bytes(), iv, aad, { tag, sizeof(tag) });
+    EXPECT_EQ(consistency, Crypto::VerificationConsistency::Consistent);
+    EXPECT(decrypted.bytes() == in.bytes());
+
+    encrypted[1234] ^= 1;
+    consistency = cipher.decrypt(encrypted, decrypted.bytes(), iv, aad, { tag, sizeof(tag) });
+    EXPECT_EQ(consistency, Crypto::VerificationConsistency::Inconsistent);
+}
+
+static constexpr size_t benchmark_size = 1 * MiB;
+static constexpr size_t benchmark_iterations = 32;
+
+BENCHMARK_CASE(aes_128_ctr_encrypt)
+{
+    auto in = generate_bytes(benchmark_size);
+    auto out = ByteBuffer::create_uninitialized(benchmark_size).release_value();
+    auto out_bytes = out.bytes();
+    Crypto::Cipher::AESCipher::CTRMode cipher("\x2b\x7e\x15\x16\x28\xae\xd2\xa6\xab\xf7\x15\x88\x09\xcf\x4f\x3c"_b, 128, Crypto::Cipher::Intent::Encryption);
+    for (size_t i = 0; i < benchmark_iterations; ++i)
+        cipher.encrypt(in, out_bytes, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f"_b);
+}
+
+BENCHMARK_CASE(aes_128_cbc_encrypt)
+{
+    auto in = generate_bytes(benchmark_size);
+    auto out = ByteBuffer::create_uninitialized(benchmark_size).release_value();
+    auto out_bytes = out.bytes();
+    Crypto::Cipher::AESCipher::CBCMode cipher("\x2b\x7e\x15\x16\x28\xae\xd2\xa6\xab\xf7\x15\x88\x09\xcf\x4f\x3c"_b, 128, Crypto::Cipher::Intent::Encryption, Crypto::Cipher::PaddingMode::Null);
+    for (size_t i = 0; i < benchmark_iterations; ++i)
+        cipher.encrypt(in, out_bytes, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f"_b);
+}
+
+BENCHMARK_CASE(aes_128_cbc_decrypt)
+{
+    auto in = generate_bytes(benchmark_size);
+    auto out = ByteBuffer::create_uninitialized(benchmark_size).release_value();
+    Crypto::Cipher::AESCipher::CBCMode cipher("\x2b\x7e\x15\x16\x28\xae\xd2\xa6\xab\xf7\x15\x88\x09\xcf\x4f\x3c"_b, 128, Crypto::Cipher::Intent::Decryption, Crypto::Cipher::PaddingMode::Null);
+    for (size_t i = 0; i < benchmark_iterations; ++i) {
+        // NOTE: Decryption shrinks the output span to drop the padding.
+        auto out_bytes = out.bytes();
+        cipher.decrypt(in, out_bytes, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f"_b);
+    }
+}
+
+BENCHMARK_CASE(aes_128_gcm_encrypt)
+{
+    auto in = generate_bytes(benchmark_size);
+    auto out = ByteBuffer::create_uninitialized(benchmark_size).release_value();
+    u8 tag[16];
+    Crypto::Cipher::AESCipher::GCMMode cipher("\x2b\x7e\x15\x16\x28\xae\xd2\xa6\xab\xf7\x15\x88\x09\xcf\x4f\x3c"_b, 128, Crypto::Cipher::Intent::Encryption);
+    for (size_t i = 0; i < benchmark_iterations; ++i)
+        cipher.encrypt(in, out.bytes(), "\xca\xfe\xba\xbe\xfa\xce\xdb\xad\xde\xca\xf8\x88\x00\x00\x00\x00"_b, {}, { tag, sizeof(tag) });
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/ImageFormats/PNGLoader.h>
+#include <LibGfx/ImageFormats/PNGWriter.h>
+#include <LibTest/TestCase.h>
+
+// Decoding PNGs is mostly spent inflating their image data, so this measures it on a large image with smooth
+// gradients, flat areas and some noise.
+static ByteBuffer encode_big_image()
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 2048, 2048 }));
+    u32 noise = 1;
+    for (int y = 0; y < bitmap->height(); ++y) {
+        for (int x = 0; x < bitmap->width(); ++x) {
+            noise = noise * 1103515245 + 12345;
+            if (x < 1024)
+                bitmap->set_pixel(x, y, Color(x / 4, y / 8, (x + y) / 16));
+            else if (y < 1024)
+                bitmap->set_pixel(x, y, Color::NamedColor::MidGray);
+            else
+                bitmap->set_pixel(x, y, Color(x / 8 + (noise >> 28), y / 8, 128 + (noise >> 29)));
+        }
+    }
+    return MUST(Gfx::PNGWriter::encode(*bitmap));
+}
+
+auto big_image = encode_big_image();
+
+BENCHMARK_CASE(big_image)
+{
+    auto plugin_decoder = MUST(Gfx::PNGImageDecoderPlugin::create(big_image));
+    MUST(plugin_decoder->frame(0));
+}
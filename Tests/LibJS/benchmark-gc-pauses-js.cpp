@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/ElapsedTimer.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+static void run_script(JS::Realm& realm, StringView source_text)
+{
+    auto script_or_error = JS::Script::parse(source_text, realm);
+    VERIFY(!script_or_error.is_error());
+
+    auto result = realm.vm().bytecode_interpreter().run(*script_or_error.value());
+    VERIFY(!result.is_error());
+}
+
+static AK::Duration measure_collection(JS::Heap& heap)
+{
+    Core::ElapsedTimer timer;
+    timer.start();
+    heap.collect_garbage();
+    return timer.elapsed_time();
+}
+
+// Compares the pause of a full collection with the final pause of an incremental one, on a heap of about a million
+// cells that the script keeps changing between the marking slices.
+BENCHMARK_CASE(full_and_incremental_collection_pauses)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+    auto& heap = vm->heap();
+
+    run_script(realm, R"~~~(
+        var objects = [];
+        for (let i = 0; i < 300000; ++i)
+            objects.push({ index: i, name: "object " + i, children: [] });
+        function mutate(round) {
+            for (let i = 0; i < 1000; ++i)
+                objects[(round * 1000 + i) % objects.length].children.push({ round });
+        }
+    )~~~"sv);
+
+    // Promote everything, so that both collections start from the same old heap.
+    heap.collect_garbage();
+    auto full_pause = measure_collection(heap);
+
+    heap.start_incremental_marking();
+    EXPECT(heap.is_incremental_marking_in_progress());
+
+    size_t slice_count = 0;
+    while (!heap.perform_incremental_marking_slice(AK::Duration::from_milliseconds(5)))
+        run_script(realm, MUST(String::formatted("mutate({})", ++slice_count)));
+    EXPECT(heap.is_incremental_marking_in_progress());
+    auto final_pause = measure_collection(heap);
+
+    outln("Full collection pause: {} ms", full_pause.to_milliseconds());
+    outln("Incremental collection: {} slices, final pause: {} ms", slice_count, final_pause.to_milliseconds());
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+static void run_script(StringView source_text)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+
+    auto script_or_error = JS::Script::parse(source_text, realm);
+    VERIFY(!script_or_error.is_error());
+
+    auto result = vm->bytecode_interpreter().run(*script_or_error.value());
+    VERIFY(!result.is_error());
+}
+
+TEST_CASE(scripts_run)
+{
+    run_script("let s = 'a'; for (let i = 0; i < 10; ++i) s += s.length; if (s.charCodeAt(1) !== 49) throw 1;"sv);
+}
+
+BENCHMARK_CASE(append_in_a_loop_and_check_length)
+{
+    run_script(R"~~~(
+        let string = "";
+        for (let i = 0; i < 200000; ++i) {
+            string += "line " + i + "\n";
+            if (string.length > 1e9)
+                throw new Error();
+        }
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(build_markup_with_template_literals)
+{
+    run_script(R"~~~(
+        let html = "";
+        for (let i = 0; i < 100000; ++i) {
+            html += `<li class="item-${i}">${i * 2}</li>`;
+            if (!html.endsWith("</li>"))
+                throw new Error();
+        }
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(read_characters_while_appending)
+{
+    run_script(R"~~~(
+        let string = "";
+        let sum = 0;
+        for (let i = 0; i < 100000; ++i) {
+            string += "x" + i;
+            sum += string.charCodeAt(string.length - 1) + string[string.length - 2].length;
+        }
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(slice_while_appending)
+{
+    run_script(R"~~~(
+        let string = "";
+        let tails = 0;
+        for (let i = 0; i < 100000; ++i) {
+            string += `${i},`;
+            if (string.slice(-2) === "0,")
+                ++tails;
+        }
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(scan_built_string)
+{
+    run_script(R"~~~(
+        let string = "";
+        for (let i = 0; i < 100000; ++i)
+            string += "abc" + i;
+        let sum = 0;
+        for (let i = 0; i < string.length; ++i)
+            sum += string.charCodeAt(i);
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(split_and_replace_built_string)
+{
+    run_script(R"~~~(
+        let string = "";
+        for (let i = 0; i < 5000; ++i)
+            string += `key${i}=value${i};`;
+        for (let i = 0; i < 10; ++i) {
+            if (string.split(";").length !== 5001)
+                throw new Error();
+            if (string.replace(/value/g, "v").indexOf("v4999") === -1)
+                throw new Error();
+        }
+    )~~~"sv);
+}
@@ -5,8 +5,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonObject.h>
 #include <LibCore/Environment.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
+#include <LibJS/Runtime/JSONObject.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibTest/JavaScriptTestRunner.h>
 #include <stdlib.h>
 #include <time.h>
@@ -52,6 +55,12 @@ TESTJS_GLOBAL_FUNCTION(get_weak_map_size, getWeakMapSize)
     return JS::Value(weak_map.values().size());
 }
 
+TESTJS_GLOBAL_FUNCTION(get_shape_statistics, getShapeStatistics, 0)
+{
+    auto statistics = JS::Shape::gather_statistics(*vm.current_realm());
+    return JS::JSONObject::parse_json_value(vm, statistics.to_json());
+}
+
 TESTJS_GLOBAL_FUNCTION(mark_as_garbage, markAsGarbage)
 {
     auto argument = vm.argument(0);
@@ -80,6 +89,18 @@ TESTJS_GLOBAL_FUNCTION(mark_as_garbage, markAsGarbage)
     return JS::js_undefined();
 }
 
+TESTJS_GLOBAL_FUNCTION(start_incremental_marking, startIncrementalMarking, 0)
+{
+    vm.heap().start_incremental_marking();
+    return JS::js_undefined();
+}
+
+TESTJS_GLOBAL_FUNCTION(perform_incremental_marking_slice, performIncrementalMarkingSlice, 0)
+{
+    // NOTE: A zero time budget makes each slice as small as possible, which is what we want for testing.
+    return JS::Value(vm.heap().perform_incremental_marking_slice(AK::Duration::zero()));
+}
+
 TESTJS_GLOBAL_FUNCTION(detach_array_buffer, detachArrayBuffer)
 {
     auto array_buffer = vm.argument(0);
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/AST.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/ScriptCache.h>
+#include <LibTest/TestCase.h>
+
+static NonnullRefPtr<JS::Program> parse(StringView source_text)
+{
+    auto parser = JS::Parser(JS::Lexer(source_text));
+    auto program = parser.parse_program();
+    VERIFY(!parser.has_errors());
+    return program;
+}
+
+TEST_CASE(key_depends_on_source_filename_and_line_number_offset)
+{
+    auto key = JS::ScriptCache::key_for("var a = 1;"sv, "a.js"sv, 1);
+    EXPECT_EQ(key, JS::ScriptCache::key_for("var a = 1;"sv, "a.js"sv, 1));
+    EXPECT_NE(key, JS::ScriptCache::key_for("var a = 2;"sv, "a.js"sv, 1));
+    EXPECT_NE(key, JS::ScriptCache::key_for("var a = 1;"sv, "b.js"sv, 1));
+    EXPECT_NE(key, JS::ScriptCache::key_for("var a = 1;"sv, "a.js"sv, 2));
+
+    // The filename and the source text must not be able to bleed into each other.
+    EXPECT_NE(JS::ScriptCache::key_for("b;"sv, "a"sv, 1), JS::ScriptCache::key_for("ab;"sv, ""sv, 1));
+}
+
+TEST_CASE(finds_added_scripts)
+{
+    JS::ScriptCache cache;
+    auto key = JS::ScriptCache::key_for("var a = 1;"sv, "a.js"sv, 1);
+    EXPECT(!cache.find(key));
+
+    auto program = parse("var a = 1;"sv);
+    cache.add(key, program, 10);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.find(key).ptr(), program.ptr());
+    EXPECT(!cache.find(JS::ScriptCache::key_for("var a = 1;"sv, "b.js"sv, 1)));
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT(!cache.find(key));
+}
+
+TEST_CASE(evicts_least_recently_used_scripts)
+{
+    JS::ScriptCache cache;
+    Vector<JS::ScriptCache::Key> keys;
+    for (size_t i = 0; i < 64; ++i) {
+        auto source_text = ByteString::formatted("var a = {};", i);
+        keys.append(JS::ScriptCache::key_for(source_text, "a.js"sv, 1));
+        cache.add(keys.last(), parse(source_text), source_text.length());
+
+        // Keep the first script alive by using it.
+        EXPECT(cache.find(keys.first()));
+    }
+
+    EXPECT(cache.size() < keys.size());
+    EXPECT(cache.find(keys.first()));
+    EXPECT(cache.find(keys.last()));
+    EXPECT(!cache.find(keys[1]));
+}
@@ -1197,3 +1197,260 @@ TEST_CASE(mismatching_brackets)
         EXPECT_EQ(re.parser_result.error, regex::Error::MismatchingBracket);
     }
 }
+
+TEST_CASE(matching_engine_selection)
+{
+    Array tests {
+        Tuple { "abc"sv, regex::MatchingEngine::Backtracking },
+        Tuple { "a+b"sv, regex::MatchingEngine::Backtracking },
+        Tuple { "(\\d+)-(\\d+)"sv, regex::MatchingEngine::Backtracking },
+        Tuple { "(a+)+b"sv, regex::MatchingEngine::PikeVM },
+        Tuple { "(?:a+)+b"sv, regex::MatchingEngine::LazyDFA },
+        Tuple { "^(?:\\w+\\s?)*$"sv, regex::MatchingEngine::LazyDFA },
+        Tuple { "(?:ab|cd)+e"sv, regex::MatchingEngine::LazyDFA },
+        Tuple { "(?:(ab)|cd)+e"sv, regex::MatchingEngine::PikeVM },
+        // Backreferences and lookaround need the backtracking VM.
+        Tuple { "(a+)+\\1"sv, regex::MatchingEngine::Backtracking },
+        Tuple { "(?:a+)+(?=b)"sv, regex::MatchingEngine::Backtracking },
+        Tuple { "(?<=x)(?:a+)+"sv, regex::MatchingEngine::Backtracking },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.get<0>());
+        EXPECT_EQ(re.parser_result.error, regex::Error::NoError);
+        EXPECT_EQ(regex::matching_engine_name(re.parser_result.optimization_data.engine), regex::matching_engine_name(test.get<1>()));
+    }
+}
+
+TEST_CASE(nfa_simulation_avoids_catastrophic_backtracking)
+{
+    auto subject = ByteString::repeated('a', 10000);
+
+    Array patterns {
+        "(a+)+b"sv,
+        "(?:a+)+b"sv,
+        "(?:a|a)*b"sv,
+        "(?:a*)*b"sv,
+        "^(?:\\w+\\s?)*$"sv,
+    };
+
+    for (auto pattern : patterns) {
+        Regex<ECMA262> re(pattern, ECMAScriptFlags::Global);
+        EXPECT_NE(re.parser_result.optimization_data.engine, regex::MatchingEngine::Backtracking);
+
+        auto result = re.match(ByteString::formatted("{}!", subject));
+        EXPECT_EQ(result.success, false);
+        // Every thread is stepped at most once per character.
+        EXPECT(result.n_operations < 100 * subject.length());
+    }
+}
+
+TEST_CASE(nfa_simulation_matches)
+{
+    struct _test {
+        StringView pattern;
+        StringView subject;
+        Vector<StringView> matches;
+        ECMAScriptFlags options {};
+    };
+
+    _test const tests[] {
+        { "(?:a+)+b"sv, "xaaab aab b ab"sv, { "aaab"sv, "aab"sv, "ab"sv } },
+        { "(?:a|ab)+c"sv, "ababc abac"sv, { "ababc"sv, "abac"sv } },
+        { "(?:x*)*y"sv, "y xy xxy"sv, { "y"sv, "xy"sv, "xxy"sv } },
+        { "(?:a*?)+?b"sv, "aab"sv, { "aab"sv } },
+        { "(?:[a-c]+d?)*e"sv, "zabdce abe"sv, { "abdce"sv, "abe"sv } },
+        { "\\b(?:\\w+\\s?)+\\b"sv, "foo bar, baz"sv, { "foo bar"sv, "baz"sv } },
+        { "^(?:\\d+,?)+$"sv, "1,2\n3,4,\nx"sv, { "1,2"sv, "3,4,"sv }, ECMAScriptFlags::Multiline },
+        { "(?:a+)+$"sv, "aa\naaa"sv, { "aaa"sv } },
+        { "(?:ab|cd)+"sv, "abcdab cd"sv, { "abcdab"sv, "cd"sv } },
+        { "(?:a+)+"sv, "AaA"sv, { "AaA"sv }, ECMAScriptFlags::Insensitive },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.pattern, ECMAScriptFlags::Global | test.options);
+        EXPECT_NE(re.parser_result.optimization_data.engine, regex::MatchingEngine::Backtracking);
+
+        auto result = re.match(test.subject);
+        EXPECT_EQ(result.matches.size(), test.matches.size());
+        for (size_t i = 0; i < min(result.matches.size(), test.matches.size()); ++i)
+            EXPECT_EQ(result.matches[i].view.to_byte_string(), test.matches[i]);
+    }
+}
+
+TEST_CASE(nfa_simulation_capture_groups)
+{
+    Regex<ECMA262> re("((?:a|b)+)(c+)"sv, ECMAScriptFlags::Global);
+    EXPECT_EQ(re.parser_result.optimization_data.engine, regex::MatchingEngine::PikeVM);
+
+    auto result = re.match("xabbacc ab bc"sv);
+    EXPECT_EQ(result.success, true);
+    EXPECT_EQ(result.matches.size(), 2u);
+    EXPECT_EQ(result.matches[0].view.to_byte_string(), "abbacc"sv);
+    EXPECT_EQ(result.capture_group_matches[0][0].view.to_byte_string(), "abba"sv);
+    EXPECT_EQ(result.capture_group_matches[0][1].view.to_byte_string(), "cc"sv);
+    EXPECT_EQ(result.matches[1].view.to_byte_string(), "bc"sv);
+    EXPECT_EQ(result.capture_group_matches[1][0].view.to_byte_string(), "b"sv);
+    EXPECT_EQ(result.capture_group_matches[1][1].view.to_byte_string(), "c"sv);
+
+    // Groups inside a loop only keep what they captured in its last iteration.
+    Regex<ECMA262> last_iteration("(?:(a)|(b))+"sv, ECMAScriptFlags::Global | (ECMAScriptFlags)regex::AllFlags::SkipTrimEmptyMatches);
+    result = last_iteration.match("ab"sv);
+    EXPECT_EQ(result.success, true);
+    EXPECT(result.capture_group_matches[0][1].view.is_null());
+    EXPECT_EQ(result.capture_group_matches[0][2].view.to_byte_string(), "b"sv);
+
+    // Sticky matches only try the start position.
+    Regex<ECMA262> sticky("(a+)+b"sv, combine_flags(ECMAScriptFlags::Global, ECMAScriptFlags::Sticky));
+    EXPECT_EQ(sticky.match("aab"sv).success, true);
+    EXPECT_EQ(sticky.match("xaab"sv).success, false);
+}
+
+BENCHMARK_CASE(nfa_simulation_performance)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 20000; ++i)
+        builder.appendff("2024-01-01 12:00:{:02} INFO request {} handled in {}ms\n", i % 60, i, i % 100);
+    auto log = builder.to_byte_string();
+
+    Regex<ECMA262> re("(?:\\w+\\s?)+ERROR"sv, ECMAScriptFlags::Global);
+    auto result = re.match(log);
+    EXPECT_EQ(result.success, false);
+}
+
+TEST_CASE(optimizer_required_literals)
+{
+    struct _test {
+        StringView pattern;
+        Optional<StringView> prefix;
+        StringView starting_characters;
+        Optional<StringView> infix;
+    };
+
+    _test const tests[] {
+        { "hello \\w+"sv, "hello "sv, {}, "hello "sv },
+        { "(?:ab)+c"sv, "ab"sv, {}, "ab"sv },
+        { "[xyz]\\d+"sv, {}, "xyz"sv, {} },
+        { "[a-c]x"sv, {}, "abc"sv, "x"sv },
+        { "\\w+@example\\.com"sv, {}, {}, "@example.com"sv },
+        { "(?:foo|bar)baz"sv, {}, {}, "baz"sv },
+        { "a?bc"sv, {}, {}, "bc"sv },
+        { "[^x]y"sv, {}, {}, "y"sv },
+        { "[a-z]+"sv, {}, {}, {} },
+        { "a|b"sv, {}, {}, {} },
+        // Text in lookarounds isn't part of the match.
+        { "(?=ab)c"sv, {}, {}, {} },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.pattern);
+        auto& optimization_data = re.parser_result.optimization_data;
+        EXPECT_EQ(optimization_data.required_prefix, test.prefix);
+        EXPECT_EQ(StringView { optimization_data.starting_characters.span() }, test.starting_characters);
+        EXPECT_EQ(optimization_data.required_infix, test.infix);
+    }
+
+    // Case-insensitive patterns can't be scanned for.
+    Regex<ECMA262> insensitive("abc"sv, ECMAScriptFlags::Insensitive);
+    EXPECT(!insensitive.parser_result.optimization_data.required_prefix.has_value());
+}
+
+TEST_CASE(required_literal_search)
+{
+    // Put the literals at every offset around the width of a vector register.
+    StringBuilder builder;
+    Vector<size_t> offsets;
+    for (size_t i = 0; i < 40; ++i) {
+        builder.append(ByteString::repeated('.', i));
+        offsets.append(builder.length());
+        builder.append("key=x"sv);
+    }
+    auto subject = builder.to_byte_string();
+    auto subject_utf16 = MUST(AK::utf8_to_utf16(subject));
+
+    Array patterns {
+        "key=(\\w)"sv,
+        "[kz]ey="sv,
+        "\\w+=x"sv,
+    };
+
+    for (auto pattern : patterns) {
+        Regex<ECMA262> re(pattern, ECMAScriptFlags::Global);
+
+        auto result = re.match(subject);
+        EXPECT_EQ(result.matches.size(), offsets.size());
+        for (size_t i = 0; i < min(result.matches.size(), offsets.size()); ++i)
+            EXPECT_EQ(result.matches[i].global_offset, offsets[i]);
+
+        // Global patterns continue where the last match left off, so start over for the other view.
+        Regex<ECMA262> re_utf16(pattern, ECMAScriptFlags::Global);
+        auto result_utf16 = re_utf16.match(Utf16View { subject_utf16 });
+        EXPECT_EQ(result_utf16.matches.size(), offsets.size());
+        for (size_t i = 0; i < min(result_utf16.matches.size(), offsets.size()); ++i)
+            EXPECT_EQ(result_utf16.matches[i].global_offset, offsets[i]);
+    }
+
+    Regex<ECMA262> missing("key=y"sv);
+    EXPECT_EQ(missing.search(subject).success, false);
+    EXPECT_EQ(missing.search(Utf16View { subject_utf16 }).success, false);
+
+    // The case-insensitive flag given at match time turns off the scan.
+    Regex<ECMA262> upper_case("KEY=X"sv, ECMAScriptFlags::Global);
+    EXPECT_EQ(upper_case.match(subject, ECMAScriptFlags::Insensitive).matches.size(), offsets.size());
+}
+
+static ByteString const& log_corpus()
+{
+    static ByteString corpus = [] {
+        StringBuilder builder;
+        for (size_t i = 0; i < 40000; ++i) {
+            auto level = i % 500 == 0 ? "ERROR"sv : "INFO"sv;
+            builder.appendff("2024-01-01 12:{:02}:{:02} {} request {} from user{}@example.com handled in {}ms\n", i / 60 % 60, i % 60, level, i, i % 97, i % 1000);
+        }
+        return builder.to_byte_string();
+    }();
+    return corpus;
+}
+
+static void search_log_corpus(StringView pattern, size_t expected_matches, bool use_required_literals)
+{
+    Regex<ECMA262> re(pattern, ECMAScriptFlags::Global);
+    if (!use_required_literals) {
+        re.parser_result.optimization_data.required_prefix = {};
+        re.parser_result.optimization_data.starting_characters = {};
+        re.parser_result.optimization_data.required_infix = {};
+    }
+
+    auto result = re.match(log_corpus());
+    EXPECT_EQ(result.matches.size(), expected_matches);
+}
+
+BENCHMARK_CASE(required_prefix_search)
+{
+    search_log_corpus("ERROR request (\\d+)"sv, 80, true);
+}
+
+BENCHMARK_CASE(required_prefix_search_without_prefilter)
+{
+    search_log_corpus("ERROR request (\\d+)"sv, 80, false);
+}
+
+BENCHMARK_CASE(starting_characters_search)
+{
+    search_log_corpus("[QXZ]\\w+"sv, 0, true);
+}
+
+BENCHMARK_CASE(starting_characters_search_without_prefilter)
+{
+    search_log_corpus("[QXZ]\\w+"sv, 0, false);
+}
+
+BENCHMARK_CASE(required_infix_search)
+{
+    search_log_corpus("\\w+@example\\.org"sv, 0, true);
+}
+
+BENCHMARK_CASE(required_infix_search_without_prefilter)
+{
+    search_log_corpus("\\w+@example\\.org"sv, 0, false);
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ParallelFor.h>
+
+TEST_CASE(every_index_once)
+{
+    // The workers are reused from one call to the next.
+    for (size_t count : { 0uz, 1uz, 7uz, 1000uz, 1000uz }) {
+        // Each index and each thread index is only written to by one thread.
+        Vector<u32> calls;
+        calls.resize(count);
+        Vector<size_t> calls_per_thread;
+        calls_per_thread.resize(Threading::parallel_for_thread_count());
+
+        Threading::parallel_for(count, [&](size_t index, size_t thread_index) {
+            ++calls[index];
+            ++calls_per_thread[thread_index];
+        });
+
+        for (auto call_count : calls)
+            EXPECT_EQ(call_count, 1u);
+        size_t total = 0;
+        for (auto call_count : calls_per_thread)
+            total += call_count;
+        EXPECT_EQ(total, count);
+    }
+}
+
+TEST_CASE(nested_calls)
+{
+    constexpr size_t outer_count = 16;
+    constexpr size_t inner_count = 100;
+    Atomic<size_t> total { 0 };
+
+    Threading::parallel_for(outer_count, [&](size_t, size_t) {
+        Threading::parallel_for(inner_count, [&](size_t, size_t thread_index) {
+            EXPECT(thread_index < Threading::parallel_for_thread_count());
+            total.fetch_add(1);
+        });
+    });
+
+    EXPECT_EQ(total.load(), outer_count * inner_count);
+}
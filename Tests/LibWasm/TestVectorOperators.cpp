@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/Math.h>
+#include <AK/NumericLimits.h>
+#include <AK/Random.h>
+#include <AK/Vector.h>
+#include <LibWasm/AbstractMachine/Operators.h>
+
+using namespace Wasm;
+using AK::SIMD::u8x16;
+
+template<typename T>
+static u128 vector_of(Array<T, 16 / sizeof(T)> const& lanes)
+{
+    return bit_cast<u128>(lanes);
+}
+
+template<typename T>
+static Array<T, 16 / sizeof(T)> lanes_of(u128 vector)
+{
+    return bit_cast<Array<T, 16 / sizeof(T)>>(vector);
+}
+
+// Runs `op` on every pair of 8-bit lanes, and compares the results to `expected`.
+template<typename T, typename Op, typename Expected>
+static void check_all_8_bit_pairs(Op op, Expected expected)
+{
+    for (int lhs = 0; lhs < 256; ++lhs) {
+        for (int rhs_base = 0; rhs_base < 256; rhs_base += 16) {
+            Array<T, 16> lhs_lanes;
+            Array<T, 16> rhs_lanes;
+            for (size_t i = 0; i < 16; ++i) {
+                lhs_lanes[i] = static_cast<T>(lhs);
+                rhs_lanes[i] = static_cast<T>(rhs_base + i);
+            }
+            auto result = lanes_of<T>(op(vector_of(lhs_lanes), vector_of(rhs_lanes)));
+            for (size_t i = 0; i < 16; ++i)
+                EXPECT_EQ(result[i], static_cast<T>(expected(lhs_lanes[i], rhs_lanes[i])));
+        }
+    }
+}
+
+template<typename T>
+static int saturate(int value)
+{
+    return clamp(value, static_cast<int>(NumericLimits<T>::min()), static_cast<int>(NumericLimits<T>::max()));
+}
+
+TEST_CASE(saturating_arithmetic)
+{
+    check_all_8_bit_pairs<i8>(Operators::VectorIntegerBinaryOp<16, Operators::SaturatingAdd, MakeSigned> {}, [](int a, int b) { return saturate<i8>(a + b); });
+    check_all_8_bit_pairs<u8>(Operators::VectorIntegerBinaryOp<16, Operators::SaturatingAdd, MakeUnsigned> {}, [](int a, int b) { return saturate<u8>(a + b); });
+    check_all_8_bit_pairs<i8>(Operators::VectorIntegerBinaryOp<16, Operators::SaturatingSubtract, MakeSigned> {}, [](int a, int b) { return saturate<i8>(a - b); });
+    check_all_8_bit_pairs<u8>(Operators::VectorIntegerBinaryOp<16, Operators::SaturatingSubtract, MakeUnsigned> {}, [](int a, int b) { return saturate<u8>(a - b); });
+
+    Array<i16, 8> a { -32768, 32767, -1, 0, 1000, -1000, 20000, -20000 };
+    Array<i16, 8> b { -1, 1, 32767, -32768, 30000, -30000, 20000, -20000 };
+    auto sum = lanes_of<i16>(Operators::VectorIntegerBinaryOp<8, Operators::SaturatingAdd, MakeSigned> {}(vector_of(a), vector_of(b)));
+    auto unsigned_difference = lanes_of<u16>(Operators::VectorIntegerBinaryOp<8, Operators::SaturatingSubtract, MakeUnsigned> {}(vector_of(a), vector_of(b)));
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(sum[i], saturate<i16>(a[i] + b[i]));
+        EXPECT_EQ(unsigned_difference[i], saturate<u16>(static_cast<u16>(a[i]) - static_cast<u16>(b[i])));
+    }
+}
+
+TEST_CASE(rounding_average_and_min_max)
+{
+    check_all_8_bit_pairs<u8>(Operators::VectorIntegerBinaryOp<16, Operators::RoundingAverage> {}, [](int a, int b) { return (a + b + 1) / 2; });
+    check_all_8_bit_pairs<i8>(Operators::VectorIntegerBinaryOp<16, Operators::VectorMinimum, MakeSigned> {}, [](int a, int b) { return min(a, b); });
+    check_all_8_bit_pairs<u8>(Operators::VectorIntegerBinaryOp<16, Operators::VectorMaximum, MakeUnsigned> {}, [](int a, int b) { return max(a, b); });
+}
+
+TEST_CASE(narrow)
+{
+    for (int base = -32768; base < 32768; base += 16) {
+        Array<i16, 8> low;
+        Array<i16, 8> high;
+        for (int i = 0; i < 8; ++i) {
+            low[i] = static_cast<i16>(base + i);
+            high[i] = static_cast<i16>(base + 8 + i);
+        }
+        auto signed_result = lanes_of<i8>(Operators::VectorNarrow<16, MakeSigned> {}(vector_of(low), vector_of(high)));
+        auto unsigned_result = lanes_of<u8>(Operators::VectorNarrow<16, MakeUnsigned> {}(vector_of(low), vector_of(high)));
+        for (int i = 0; i < 16; ++i) {
+            EXPECT_EQ(signed_result[i], saturate<i8>(base + i));
+            EXPECT_EQ(unsigned_result[i], saturate<u8>(base + i));
+        }
+    }
+}
+
+TEST_CASE(shuffles)
+{
+    Array<u8, 16> a;
+    Array<u8, 16> b;
+    for (u8 i = 0; i < 16; ++i) {
+        a[i] = 10 * i;
+        b[i] = 200 + i;
+    }
+
+    Array<u8, 16> indices { 0, 15, 16, 255, 3, 3, 128, 1, 2, 4, 17, 31, 14, 13, 12, 11 };
+    auto swizzled = lanes_of<u8>(Operators::VectorSwizzle {}(vector_of(a), vector_of(indices)));
+    for (size_t i = 0; i < 16; ++i)
+        EXPECT_EQ(swizzled[i], indices[i] < 16 ? a[indices[i]] : 0);
+
+    u8x16 lanes { 0, 31, 16, 1, 17, 2, 18, 3, 30, 15, 29, 14, 7, 7, 23, 23 };
+    auto shuffled = lanes_of<u8>(Operators::VectorShuffle { lanes }(vector_of(a), vector_of(b)));
+    for (size_t i = 0; i < 16; ++i)
+        EXPECT_EQ(shuffled[i], lanes[i] < 16 ? a[lanes[i]] : b[lanes[i] - 16]);
+}
+
+TEST_CASE(reductions)
+{
+    Array<i16, 8> lanes { -1, 2, -3, 4, -5, 6, 0, -32768 };
+    EXPECT_EQ(Operators::VectorBitmask<8> {}(vector_of(lanes)), 0b10010101);
+    EXPECT_EQ(Operators::VectorAllTrue<8> {}(vector_of(lanes)), 0);
+    lanes[6] = 256;
+    EXPECT_EQ(Operators::VectorAllTrue<8> {}(vector_of(lanes)), 1);
+    EXPECT_EQ(Operators::VectorBitmask<16> {}(vector_of(lanes)), 0b1000001100110011);
+}
+
+TEST_CASE(float_conversions)
+{
+    auto nan = AK::NaN<float>;
+    Array<float, 4> values { nan, -3e9f, 3e9f, -1.9f };
+    EXPECT_EQ((lanes_of<i32>(Operators::VectorSaturatingTruncate<i32, 4> {}(vector_of(values)))), (Array<i32, 4> { 0, NumericLimits<i32>::min(), NumericLimits<i32>::max(), -1 }));
+    EXPECT_EQ((lanes_of<u32>(Operators::VectorSaturatingTruncate<u32, 4> {}(vector_of(values)))), (Array<u32, 4> { 0, 0, 3'000'000'000u, 0 }));
+
+    Array<double, 2> doubles { 1e10, -2.5 };
+    EXPECT_EQ((lanes_of<i32>(Operators::VectorSaturatingTruncate<i32, 2> {}(vector_of(doubles)))), (Array<i32, 4> { NumericLimits<i32>::max(), -2, 0, 0 }));
+
+    Array<float, 4> signed_zeroes { -0.0f, 0.0f, nan, 1.0f };
+    Array<float, 4> other_zeroes { 0.0f, -0.0f, 1.0f, nan };
+    auto minimum = lanes_of<u32>(Operators::VectorFloatBinaryOp<4, Operators::VectorMinimum> {}(vector_of(signed_zeroes), vector_of(other_zeroes)));
+    auto maximum = lanes_of<float>(Operators::VectorFloatBinaryOp<4, Operators::VectorMaximum> {}(vector_of(signed_zeroes), vector_of(other_zeroes)));
+    EXPECT_EQ(minimum[0], 0x80000000u);
+    EXPECT_EQ(minimum[1], 0x80000000u);
+    EXPECT_EQ(bit_cast<u32>(maximum[0]), 0u);
+    EXPECT(isnan(maximum[2]));
+    EXPECT(isnan(maximum[3]));
+}
+
+// Every benchmark runs an operator over this many vectors, and repeats that a few hundred times.
+static constexpr size_t benchmark_vector_count = 4096;
+static constexpr size_t benchmark_iterations = 256;
+
+static Vector<u128> const& random_vectors()
+{
+    static Vector<u128> vectors = [] {
+        Vector<u128> vectors;
+        vectors.resize(benchmark_vector_count + 1);
+        fill_with_random({ vectors.data(), vectors.size() * sizeof(u128) });
+        return vectors;
+    }();
+    return vectors;
+}
+
+template<typename Op>
+static void run_binary_benchmark(Op op)
+{
+    auto const& inputs = random_vectors();
+    u128 accumulator = 0;
+    for (size_t iteration = 0; iteration < benchmark_iterations; ++iteration) {
+        for (size_t i = 0; i < benchmark_vector_count; ++i) {
+            auto result = op(inputs[i], inputs[i + 1]);
+            accumulator += result;
+            AK::taint_for_optimizer(accumulator);
+        }
+    }
+    EXPECT_NE(accumulator, u128 { 0 });
+}
+
+template<typename Op>
+static void run_unary_benchmark(Op op)
+{
+    run_binary_benchmark([&](u128 value, u128) { return op(value); });
+}
+
+BENCHMARK_CASE(i8x16_add_sat_u)
+{
+    run_binary_benchmark(Operators::VectorIntegerBinaryOp<16, Operators::SaturatingAdd, MakeUnsigned> {});
+}
+
+BENCHMARK_CASE(i8x16_avgr_u)
+{
+    run_binary_benchmark(Operators::VectorIntegerBinaryOp<16, Operators::RoundingAverage> {});
+}
+
+BENCHMARK_CASE(i8x16_min_s)
+{
+    run_binary_benchmark(Operators::VectorIntegerBinaryOp<16, Operators::VectorMinimum, MakeSigned> {});
+}
+
+BENCHMARK_CASE(i8x16_swizzle)
+{
+    run_binary_benchmark(Operators::VectorSwizzle {});
+}
+
+BENCHMARK_CASE(i8x16_shuffle)
+{
+    run_binary_benchmark(Operators::VectorShuffle { u8x16 { 0, 31, 16, 1, 17, 2, 18, 3, 30, 15, 29, 14, 7, 7, 23, 23 } });
+}
+
+BENCHMARK_CASE(i8x16_narrow_i16x8_u)
+{
+    run_binary_benchmark(Operators::VectorNarrow<16, MakeUnsigned> {});
+}
+
+BENCHMARK_CASE(i16x8_mul)
+{
+    run_binary_benchmark(Operators::VectorIntegerBinaryOp<8, Operators::Multiply> {});
+}
+
+BENCHMARK_CASE(i16x8_extmul_low_i8x16_s)
+{
+    run_binary_benchmark(Operators::VectorExtendMultiply<8, Operators::VectorHalf::Low, MakeSigned> {});
+}
+
+BENCHMARK_CASE(i16x8_q15mulr_sat_s)
+{
+    run_binary_benchmark(Operators::VectorQ15MultiplyRoundSaturate {});
+}
+
+BENCHMARK_CASE(i32x4_dot_i16x8_s)
+{
+    run_binary_benchmark(Operators::VectorDot {});
+}
+
+BENCHMARK_CASE(i16x8_extadd_pairwise_i8x16_u)
+{
+    run_unary_benchmark(Operators::VectorExtendAddPairwise<8, MakeUnsigned> {});
+}
+
+BENCHMARK_CASE(i8x16_bitmask)
+{
+    run_unary_benchmark([](u128 value) { return u128 { static_cast<u32>(Operators::VectorBitmask<16> {}(value)) }; });
+}
+
+BENCHMARK_CASE(f32x4_add)
+{
+    run_binary_benchmark(Operators::VectorFloatBinaryOp<4, Operators::Add> {});
+}
+
+BENCHMARK_CASE(f32x4_mul)
+{
+    run_binary_benchmark(Operators::VectorFloatBinaryOp<4, Operators::Multiply> {});
+}
+
+BENCHMARK_CASE(f32x4_min)
+{
+    run_binary_benchmark(Operators::VectorFloatBinaryOp<4, Operators::VectorMinimum> {});
+}
+
+BENCHMARK_CASE(f32x4_nearest)
+{
+    run_unary_benchmark(Operators::VectorFloatUnaryOp<4, Operators::VectorNearbyIntegral> {});
+}
+
+BENCHMARK_CASE(i32x4_trunc_sat_f32x4_s)
+{
+    run_unary_benchmark(Operators::VectorSaturatingTruncate<i32, 4> {});
+}
@@ -7,6 +7,7 @@
 #include <AK/MemoryStream.h>
 #include <LibTest/JavaScriptTestRunner.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/Parser/StreamingParser.h>
 #include <LibWasm/Types.h>
 #include <string.h>
 
@@ -47,6 +48,7 @@ public:
         : JS::Object(ConstructWithPrototypeTag::Tag, prototype)
     {
         m_machine.enable_instruction_count_limit();
+        m_machine.enable_guard_pages_for_memories();
     }
 
     static Wasm::AbstractMachine& machine() { return m_machine; }
@@ -104,20 +106,9 @@ private:
 Wasm::AbstractMachine WebAssemblyModule::m_machine;
 HashMap<Wasm::Linker::Name, Wasm::ExternValue> WebAssemblyModule::s_spec_test_namespace;
 
-TESTJS_GLOBAL_FUNCTION(parse_webassembly_module, parseWebAssemblyModule)
+static HashMap<Wasm::Linker::Name, Wasm::ExternValue> imports_from(JS::Value import_value)
 {
-    auto& realm = *vm.current_realm();
-    auto object = TRY(vm.argument(0).to_object(vm));
-    if (!is<JS::Uint8Array>(*object))
-        return vm.throw_completion<JS::TypeError>("Expected a Uint8Array argument to parse_webassembly_module"sv);
-    auto& array = static_cast<JS::Uint8Array&>(*object);
-    FixedMemoryStream stream { array.data() };
-    auto result = Wasm::Module::parse(stream);
-    if (result.is_error())
-        return vm.throw_completion<JS::SyntaxError>(Wasm::parse_error_to_byte_string(result.error()));
-
     HashMap<Wasm::Linker::Name, Wasm::ExternValue> imports;
-    auto import_value = vm.argument(1);
     if (import_value.is_object()) {
         auto& import_object = import_value.as_object();
         for (auto& property : import_object.shape().property_table()) {
@@ -131,8 +122,47 @@ TESTJS_GLOBAL_FUNCTION(parse_webassembly_module, parseWebAssemblyModule)
             }
         }
     }
+    return imports;
+}
+
+TESTJS_GLOBAL_FUNCTION(parse_webassembly_module, parseWebAssemblyModule)
+{
+    auto& realm = *vm.current_realm();
+    auto object = TRY(vm.argument(0).to_object(vm));
+    if (!is<JS::Uint8Array>(*object))
+        return vm.throw_completion<JS::TypeError>("Expected a Uint8Array argument to parse_webassembly_module"sv);
+    auto& array = static_cast<JS::Uint8Array&>(*object);
+    FixedMemoryStream stream { array.data() };
+    auto result = Wasm::Module::parse(stream);
+    if (result.is_error())
+        return vm.throw_completion<JS::SyntaxError>(Wasm::parse_error_to_byte_string(result.error()));
+
+    return JS::Value(TRY(WebAssemblyModule::create(realm, result.release_value(), imports_from(vm.argument(1)))));
+}
+
+// Like parseWebAssemblyModule(), but hands the bytes to a StreamingParser chunkSize bytes at a time.
+TESTJS_GLOBAL_FUNCTION(parse_webassembly_module_in_chunks, parseWebAssemblyModuleInChunks)
+{
+    auto& realm = *vm.current_realm();
+    auto object = TRY(vm.argument(0).to_object(vm));
+    if (!is<JS::Uint8Array>(*object))
+        return vm.throw_completion<JS::TypeError>("Expected a Uint8Array argument to parse_webassembly_module_in_chunks"sv);
+    auto bytes = static_cast<JS::Uint8Array&>(*object).data();
+    auto chunk_size = TRY(vm.argument(1).to_index(vm));
+    if (chunk_size == 0)
+        return vm.throw_completion<JS::RangeError>("Expected a non-zero chunk size"sv);
+
+    Wasm::StreamingParser parser;
+    for (size_t offset = 0; offset < bytes.size(); offset += chunk_size) {
+        auto result = parser.append(bytes.slice(offset, min(chunk_size, bytes.size() - offset)));
+        if (result.is_error())
+            return vm.throw_completion<JS::SyntaxError>(Wasm::parse_error_to_byte_string(result.error()));
+    }
+    auto result = parser.finish();
+    if (result.is_error())
+        return vm.throw_completion<JS::SyntaxError>(Wasm::parse_error_to_byte_string(result.error()));
 
-    return JS::Value(TRY(WebAssemblyModule::create(realm, result.release_value(), imports)));
+    return JS::Value(TRY(WebAssemblyModule::create(realm, result.release_value(), imports_from(vm.argument(2)))));
 }
 
 TESTJS_GLOBAL_FUNCTION(compare_typed_arrays, compareTypedArrays)
@@ -4,13 +4,99 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/BinarySearch.h>
+#include <AK/CharacterTypes.h>
+#include <AK/Endian.h>
+#include <AK/IntegralMath.h>
+#include <AK/Math.h>
+#include <AK/MemoryStream.h>
 #include <AK/QuickSort.h>
 #include <LibCompress/Brotli.h>
 #include <LibCompress/BrotliDictionary.h>
 
 namespace Compress {
 
+// RFC 7932 section 7.1
+static constexpr u8 context_id_lut0[256] {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 4, 0, 0, 4, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    8, 12, 16, 12, 12, 20, 12, 16, 24, 28, 12, 12, 32, 12, 36, 12,
+    44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 32, 32, 24, 40, 28, 12,
+    12, 48, 52, 52, 52, 48, 52, 52, 52, 48, 52, 52, 52, 52, 52, 48,
+    52, 52, 52, 52, 52, 48, 52, 52, 52, 52, 52, 24, 12, 28, 12, 12,
+    12, 56, 60, 60, 60, 56, 60, 60, 60, 56, 60, 60, 60, 60, 60, 56,
+    60, 60, 60, 60, 60, 56, 60, 60, 60, 60, 60, 24, 12, 28, 12, 0,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
+    2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
+    2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
+    2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3
+};
+static constexpr u8 context_id_lut1[256] {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1,
+    1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1,
+    1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 1, 1, 1, 1, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2
+};
+static constexpr u8 context_id_lut2[256] {
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 7
+};
+
+static size_t literal_context_id(size_t context_mode, u8 p1, u8 p2)
+{
+    switch (context_mode) {
+    case 0:
+        return p1 & 0x3f;
+    case 1:
+        return p1 >> 2;
+    case 2:
+        return context_id_lut0[p1] | context_id_lut1[p2];
+    case 3:
+        return (context_id_lut2[p1] << 3) | context_id_lut2[p2];
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+// RFC 7932 section 5
+static constexpr size_t insert_length_code_base[11] { 0, 0, 0, 0, 8, 8, 0, 16, 8, 16, 16 };
+static constexpr size_t copy_length_code_base[11] { 0, 8, 0, 8, 0, 8, 16, 0, 16, 8, 16 };
+static constexpr size_t insert_length_base[24] { 0, 1, 2, 3, 4, 5, 6, 8, 10, 14, 18, 26, 34, 50, 66, 98, 130, 194, 322, 578, 1090, 2114, 6210, 22594 };
+static constexpr size_t insert_length_extra[24] { 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 7, 8, 9, 10, 12, 14, 24 };
+static constexpr size_t copy_length_base[24] { 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, 14, 18, 22, 30, 38, 54, 70, 102, 134, 198, 326, 582, 1094, 2118 };
+static constexpr size_t copy_length_extra[24] { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 7, 8, 9, 10, 24 };
+
 ErrorOr<size_t> Brotli::CanonicalCode::read_symbol(LittleEndianInputBitStream& input_stream) const
 {
     size_t code_bits = 1;
@@ -491,79 +577,8 @@ ErrorOr<void> BrotliDecompressionStream::block_read_new_state(Block& block)
 
 size_t BrotliDecompressionStream::literal_code_index_from_context()
 {
-    size_t const context_id_lut0[256] {
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 4, 0, 0, 4, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        8, 12, 16, 12, 12, 20, 12, 16, 24, 28, 12, 12, 32, 12, 36, 12,
-        44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 32, 32, 24, 40, 28, 12,
-        12, 48, 52, 52, 52, 48, 52, 52, 52, 48, 52, 52, 52, 52, 52, 48,
-        52, 52, 52, 52, 52, 48, 52, 52, 52, 52, 52, 24, 12, 28, 12, 12,
-        12, 56, 60, 60, 60, 56, 60, 60, 60, 56, 60, 60, 60, 60, 60, 56,
-        60, 60, 60, 60, 60, 56, 60, 60, 60, 60, 60, 24, 12, 28, 12, 0,
-        0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
-        0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
-        0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
-        0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
-        2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
-        2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
-        2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
-        2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3
-    };
-    size_t const context_id_lut1[256] {
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1,
-        1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1,
-        1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 1, 1, 1, 1, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2
-    };
-    size_t const context_id_lut2[256] {
-        0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
-        5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
-        5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
-        5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
-        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 7
-    };
-
     size_t context_mode = m_literal_context_modes[m_literal_block.type];
-    size_t context_id;
-    switch (context_mode) {
-    case 0:
-        context_id = m_lookback_buffer.value().lookback(1, 0) & 0x3f;
-        break;
-    case 1:
-        context_id = m_lookback_buffer.value().lookback(1, 0) >> 2;
-        break;
-    case 2:
-        context_id = context_id_lut0[m_lookback_buffer.value().lookback(1, 0)] | context_id_lut1[m_lookback_buffer.value().lookback(2, 0)];
-        break;
-    case 3:
-        context_id = (context_id_lut2[m_lookback_buffer.value().lookback(1, 0)] << 3) | context_id_lut2[m_lookback_buffer.value().lookback(2, 0)];
-        break;
-    default:
-        VERIFY_NOT_REACHED();
-    }
+    size_t context_id = literal_context_id(context_mode, m_lookback_buffer.value().lookback(1, 0), m_lookback_buffer.value().lookback(2, 0));
 
     size_t literal_code_index = m_context_mapping_literal[64 * m_literal_block.type + context_id];
     return literal_code_index;
@@ -753,10 +768,7 @@ ErrorOr<Bytes> BrotliDecompressionStream::read_some(Bytes output_buffer)
 
             size_t insert_and_copy_symbol = TRY(m_insert_and_copy_codes[m_insert_and_copy_block.type].read_symbol(m_input_stream));
 
-            size_t const insert_length_code_base[11] { 0, 0, 0, 0, 8, 8, 0, 16, 8, 16, 16 };
-            size_t const copy_length_code_base[11] { 0, 8, 0, 8, 0, 8, 16, 0, 16, 8, 16 };
             bool const implicit_zero_distance[11] { true, true, false, false, false, false, false, false, false, false, false };
-
             size_t insert_and_copy_index = insert_and_copy_symbol >> 6;
             size_t insert_length_code_offset = (insert_and_copy_symbol >> 3) & 0b111;
             size_t copy_length_code_offset = insert_and_copy_symbol & 0b111;
@@ -766,10 +778,6 @@ ErrorOr<Bytes> BrotliDecompressionStream::read_some(Bytes output_buffer)
 
             m_implicit_zero_distance = implicit_zero_distance[insert_and_copy_index];
 
-            size_t const insert_length_base[24] { 0, 1, 2, 3, 4, 5, 6, 8, 10, 14, 18, 26, 34, 50, 66, 98, 130, 194, 322, 578, 1090, 2114, 6210, 22594 };
-            size_t const insert_length_extra[24] { 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 7, 8, 9, 10, 12, 14, 24 };
-            size_t const copy_length_base[24] { 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, 14, 18, 22, 30, 38, 54, 70, 102, 134, 198, 326, 582, 1094, 2118 };
-            size_t const copy_length_extra[24] { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 7, 8, 9, 10, 24 };
 
             m_insert_length = insert_length_base[insert_length_code] + TRY(m_input_stream.read_bits(insert_length_extra[insert_length_code]));
             m_copy_length = copy_length_base[copy_length_code] + TRY(m_input_stream.read_bits(copy_length_extra[copy_length_code]));
@@ -943,4 +951,1311 @@ bool BrotliDecompressionStream::is_eof() const
     return m_read_final_block && m_current_state == State::Idle;
 }
 
+// Brotli's scores estimate the number of bits a match saves, in units of 1/30th of a bit.
+static constexpr size_t literal_byte_score = 135;
+static constexpr size_t distance_bit_penalty = 30;
+static constexpr size_t score_base = distance_bit_penalty * 8 * sizeof(u64);
+static constexpr size_t min_score = score_base + 100;
+static constexpr size_t lazy_match_score_difference = 175;
+
+static size_t backward_reference_score(size_t length, size_t distance)
+{
+    return score_base + literal_byte_score * length - distance_bit_penalty * AK::log2(distance);
+}
+
+static size_t last_distance_score(size_t length, size_t distance_index)
+{
+    auto score = score_base + literal_byte_score * length + 15;
+    if (distance_index != 0)
+        score -= 39 + ((0x1CA10 >> (distance_index & 0xE)) & 0xE);
+    return score;
+}
+
+static size_t match_length(u8 const* data, u8 const* match, size_t max_length)
+{
+    size_t length = 0;
+    for (; length + sizeof(u64) <= max_length; length += sizeof(u64)) {
+        u64 data_word;
+        u64 match_word;
+        __builtin_memcpy(&data_word, data + length, sizeof(u64));
+        __builtin_memcpy(&match_word, match + length, sizeof(u64));
+        if (auto difference = data_word ^ match_word; difference != 0) {
+            if constexpr (AK::HostIsLittleEndian)
+                return length + count_trailing_zeroes(difference) / 8;
+            break;
+        }
+    }
+    while (length < max_length && data[length] == match[length])
+        ++length;
+    return length;
+}
+
+static u32 read_u32(u8 const* bytes)
+{
+    u32 value;
+    __builtin_memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+// The static dictionary is searched through a hash of the (lowercased) first four bytes of each word, so that
+// matches of the transformations that uppercase words can be found as well.
+struct DictionaryIndex {
+    static constexpr size_t hash_bits = 15;
+
+    static size_t hash(u8 const* bytes)
+    {
+        u32 value = 0;
+        for (size_t i = 0; i < 4; ++i)
+            value |= static_cast<u32>(to_ascii_lowercase(bytes[i])) << (i * 8);
+        return (value * 0x1E35A7BD) >> (32 - hash_bits);
+    }
+
+    struct Entry {
+        u8 length;
+        u16 word_id;
+    };
+
+    ReadonlySpan<Entry> bucket(size_t hash) const
+    {
+        return entries.span().slice(bucket_offsets[hash], bucket_offsets[hash + 1] - bucket_offsets[hash]);
+    }
+
+    Vector<u32> bucket_offsets;
+    Vector<Entry> entries;
+
+    // The transformations without a prefix, grouped by their operation. Others are never used by the compressor.
+    Array<Vector<u8>, 3> transformations;
+};
+
+static DictionaryIndex const& dictionary_index()
+{
+    static DictionaryIndex const index = [] {
+        DictionaryIndex index;
+        Vector<u32> bucket_sizes;
+        bucket_sizes.resize(1 << DictionaryIndex::hash_bits);
+        for (size_t length = BrotliDictionary::min_word_length; length <= BrotliDictionary::max_word_length; ++length) {
+            for (size_t word_id = 0; word_id < (1u << BrotliDictionary::word_id_bits(length)); ++word_id)
+                ++bucket_sizes[DictionaryIndex::hash(BrotliDictionary::word(length, word_id).data())];
+        }
+
+        index.bucket_offsets.resize(bucket_sizes.size() + 1);
+        for (size_t i = 0; i < bucket_sizes.size(); ++i)
+            index.bucket_offsets[i + 1] = index.bucket_offsets[i] + bucket_sizes[i];
+
+        index.entries.resize(index.bucket_offsets.last());
+        for (size_t length = BrotliDictionary::min_word_length; length <= BrotliDictionary::max_word_length; ++length) {
+            for (size_t word_id = 0; word_id < (1u << BrotliDictionary::word_id_bits(length)); ++word_id) {
+                auto hash = DictionaryIndex::hash(BrotliDictionary::word(length, word_id).data());
+                index.entries[index.bucket_offsets[hash + 1] - bucket_sizes[hash]--] = { static_cast<u8>(length), static_cast<u16>(word_id) };
+            }
+        }
+
+        for (size_t id = 0; id < BrotliDictionary::transformation_count; ++id) {
+            auto const& transformation = BrotliDictionary::transformation(id);
+            if (!transformation.prefix.is_empty())
+                continue;
+            switch (transformation.operation) {
+            case BrotliDictionary::Identity:
+            case BrotliDictionary::FermentFirst:
+            case BrotliDictionary::FermentAll:
+                index.transformations[transformation.operation].append(id);
+                break;
+            default:
+                break;
+            }
+        }
+        return index;
+    }();
+    return index;
+}
+
+// RFC 7932 section 5
+static size_t insert_length_code(size_t length)
+{
+    if (length < 6)
+        return length;
+    if (length < 130) {
+        auto extra_bits = AK::log2(length - 2) - 1;
+        return (extra_bits << 1) + ((length - 2) >> extra_bits) + 2;
+    }
+    if (length < 2114)
+        return AK::log2(length - 66) + 10;
+    if (length < 6210)
+        return 21;
+    if (length < 22594)
+        return 22;
+    return 23;
+}
+
+static size_t copy_length_code(size_t length)
+{
+    if (length < 10)
+        return length - 2;
+    if (length < 134) {
+        auto extra_bits = AK::log2(length - 6) - 1;
+        return (extra_bits << 1) + ((length - 6) >> extra_bits) + 4;
+    }
+    if (length < 2118)
+        return AK::log2(length - 70) + 12;
+    return 23;
+}
+
+static u16 command_symbol(size_t insert_code, size_t copy_code, bool use_implicit_zero_distance)
+{
+    if (use_implicit_zero_distance && insert_code < 8 && copy_code < 16)
+        return ((copy_code >> 3) << 6) | (insert_code << 3) | (copy_code & 7);
+
+    static constexpr u8 cells[3][3] { { 2, 3, 6 }, { 4, 5, 8 }, { 7, 9, 10 } };
+    auto cell = cells[insert_code >> 3][copy_code >> 3];
+    return (cell << 6) | ((insert_code & 7) << 3) | (copy_code & 7);
+}
+
+// RFC 7932 section 4
+static Optional<u16> short_distance_code(Array<size_t, 4> const& distances, size_t distance)
+{
+    for (size_t i = 0; i < distances.size(); ++i) {
+        if (distances[i] == distance)
+            return i;
+    }
+
+    static constexpr i64 offsets[6] { -1, 1, -2, 2, -3, 3 };
+    for (size_t i = 0; i < 2; ++i) {
+        for (size_t j = 0; j < 6; ++j) {
+            if (static_cast<i64>(distances[i]) + offsets[j] == static_cast<i64>(distance))
+                return 4 + 6 * i + j;
+        }
+    }
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<BrotliCompressionStream>> BrotliCompressionStream::construct(MaybeOwned<Stream> stream, CompressionLevel compression_level)
+{
+    auto bit_stream = TRY(try_make<LittleEndianOutputBitStream>(move(stream)));
+    auto brotli_stream = TRY(adopt_nonnull_own_or_enomem(new (nothrow) BrotliCompressionStream(move(bit_stream), compression_level)));
+    return brotli_stream;
+}
+
+BrotliCompressionStream::BrotliCompressionStream(NonnullOwnPtr<LittleEndianOutputBitStream> stream, CompressionLevel compression_level)
+    : m_compression_level(compression_level)
+    , m_compression_constants(compression_constants[static_cast<int>(m_compression_level)])
+    , m_output_stream(move(stream))
+{
+}
+
+BrotliCompressionStream::~BrotliCompressionStream()
+{
+    VERIFY(m_finished);
+}
+
+ErrorOr<Bytes> BrotliCompressionStream::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> BrotliCompressionStream::write_some(ReadonlyBytes bytes)
+{
+    VERIFY(!m_finished);
+
+    size_t total_written = 0;
+    while (!bytes.is_empty()) {
+        auto chunk = bytes.trim(block_size - (m_buffer.size() - m_pending_offset));
+        TRY(m_buffer.try_append(chunk));
+        total_written += chunk.size();
+        bytes = bytes.slice(chunk.size());
+
+        if (m_buffer.size() - m_pending_offset == block_size)
+            TRY(flush());
+    }
+    return total_written;
+}
+
+bool BrotliCompressionStream::is_eof() const
+{
+    return true;
+}
+
+bool BrotliCompressionStream::is_open() const
+{
+    return m_output_stream->is_open();
+}
+
+void BrotliCompressionStream::close()
+{
+}
+
+size_t BrotliCompressionStream::max_distance(size_t position) const
+{
+    return min<u64>(m_window_size, m_buffer_position + position);
+}
+
+u32 BrotliCompressionStream::table_position(size_t position) const
+{
+    return m_buffer_position + position - m_table_base + 1;
+}
+
+size_t BrotliCompressionStream::hash_sequence(u8 const* bytes) const
+{
+    // Knuth's multiplicative hash, applied to the next four bytes
+    return (read_u32(bytes) * 0x1E35A7BD) >> (32 - m_hash_bits);
+}
+
+void BrotliCompressionStream::insert_position(size_t position, size_t end)
+{
+    if (m_compression_constants.use_binary_tree) {
+        find_binary_tree_matches(position, end, max_distance(position), nullptr);
+        return;
+    }
+
+    auto current = table_position(position);
+    auto hash = hash_sequence(m_buffer.data() + position);
+    m_hash_chain[current & m_chain_mask] = m_hash_head[hash];
+    m_hash_head[hash] = current;
+}
+
+void BrotliCompressionStream::find_hash_chain_matches(size_t position, size_t end, size_t max_distance, Match& best)
+{
+    auto const* data = m_buffer.data() + position;
+    auto current = table_position(position);
+    auto hash = hash_sequence(data);
+    auto candidate = m_hash_head[hash];
+    m_hash_chain[current & m_chain_mask] = candidate;
+    m_hash_head[hash] = current;
+
+    auto max_length = end - position;
+    auto nice_length = min(m_compression_constants.nice_match_length, max_length);
+    for (size_t depth = m_compression_constants.max_search_depth; candidate != 0 && depth > 0; --depth) {
+        auto distance = current - candidate;
+        if (distance > max_distance)
+            break;
+
+        // A candidate can only beat the best match if it also matches the byte right after it
+        auto const* match = data - distance;
+        if (best.length < max_length && match[best.length] == data[best.length]) {
+            auto length = match_length(data, match, max_length);
+            if (length >= min_match_length) {
+                auto score = backward_reference_score(length, distance);
+                if (score > best.score) {
+                    best = { length, distance, length, score };
+                    if (length >= nice_length)
+                        break;
+                }
+            }
+        }
+
+        // Older positions may have overwritten the link since, which makes the chain go forward
+        auto next_candidate = m_hash_chain[candidate & m_chain_mask];
+        if (next_candidate >= candidate)
+            break;
+        candidate = next_candidate;
+    }
+}
+
+// Every hash bucket holds a binary search tree of the positions that hash to it, ordered by the bytes that
+// follow them. Searching the tree for the current position also re-roots it at the current position, which keeps
+// the most recent positions near the top (like LZMA's "bt4" match finder).
+void BrotliCompressionStream::find_binary_tree_matches(size_t position, size_t end, size_t max_distance, Match* best)
+{
+    auto const* data = m_buffer.data() + position;
+    auto current = table_position(position);
+    auto hash = hash_sequence(data);
+    auto candidate = m_hash_head[hash];
+    m_hash_head[hash] = current;
+
+    auto max_length = min(m_compression_constants.nice_match_length, end - position);
+    auto* smaller = &m_hash_chain[2 * (current & m_chain_mask)];
+    auto* larger = smaller + 1;
+    size_t smaller_length = 0;
+    size_t larger_length = 0;
+    size_t best_length = min_match_length - 1;
+
+    for (size_t depth = m_compression_constants.max_search_depth;; --depth) {
+        auto distance = current - candidate;
+        if (candidate == 0 || distance > max_distance || depth == 0) {
+            *smaller = 0;
+            *larger = 0;
+            return;
+        }
+
+        auto const* match = data - distance;
+        auto* children = &m_hash_chain[2 * (candidate & m_chain_mask)];
+        auto length = min(smaller_length, larger_length);
+        length += match_length(data + length, match + length, max_length - length);
+
+        if (best && length > best_length) {
+            best_length = length;
+            auto score = backward_reference_score(length, distance);
+            if (score > best->score)
+                *best = { length, distance, length, score };
+        }
+
+        if (length == max_length) {
+            // The candidate is identical as far as we can tell, so the current position takes over its subtrees
+            *smaller = children[0];
+            *larger = children[1];
+            return;
+        }
+
+        if (match[length] < data[length]) {
+            *smaller = candidate;
+            smaller = children + 1;
+            candidate = *smaller;
+            smaller_length = length;
+        } else {
+            *larger = candidate;
+            larger = children;
+            candidate = *larger;
+            larger_length = length;
+        }
+    }
+}
+
+void BrotliCompressionStream::find_dictionary_matches(size_t position, size_t end, size_t max_distance, Match& best)
+{
+    auto const& index = dictionary_index();
+    auto const* data = m_buffer.data() + position;
+    auto max_length = end - position;
+
+    for (auto entry : index.bucket(DictionaryIndex::hash(data))) {
+        size_t length = entry.length;
+        if (length > max_length)
+            continue;
+
+        auto word = BrotliDictionary::word(length, entry.word_id);
+        for (auto operation : { BrotliDictionary::Identity, BrotliDictionary::FermentFirst, BrotliDictionary::FermentAll }) {
+            u8 transformed_word[BrotliDictionary::max_word_length];
+            Bytes transformed_bytes { transformed_word, length };
+            word.copy_to(transformed_bytes);
+            if (operation == BrotliDictionary::FermentFirst)
+                BrotliDictionary::ferment_first(transformed_bytes);
+            else if (operation == BrotliDictionary::FermentAll)
+                BrotliDictionary::ferment_all(transformed_bytes);
+            if (__builtin_memcmp(transformed_word, data, length) != 0)
+                continue;
+
+            for (size_t transformation_id : index.transformations[operation]) {
+                auto suffix = BrotliDictionary::transformation(transformation_id).suffix;
+                if (length + suffix.length() > max_length || __builtin_memcmp(data + length, suffix.characters_without_null_termination(), suffix.length()) != 0)
+                    continue;
+
+                auto distance = max_distance + 1 + (entry.word_id | (transformation_id << BrotliDictionary::word_id_bits(length)));
+                auto score = backward_reference_score(length + suffix.length(), distance);
+                if (score > best.score)
+                    best = { length + suffix.length(), distance, length, score };
+            }
+        }
+    }
+}
+
+BrotliCompressionStream::Match BrotliCompressionStream::find_longest_match(size_t position, size_t end)
+{
+    VERIFY(position == m_next_position_to_insert);
+    ++m_next_position_to_insert;
+
+    auto const* data = m_buffer.data() + position;
+    auto max_distance = this->max_distance(position);
+    auto max_length = end - position;
+    Match best { .score = min_score };
+
+    // Repeating one of the last distances is cheap, which makes even short matches worth it
+    auto distances_to_check = m_compression_level == CompressionLevel::FAST ? 2 : m_distances.size();
+    for (size_t i = 0; i < distances_to_check; ++i) {
+        auto distance = m_distances[i];
+        if (distance > max_distance)
+            continue;
+        auto length = match_length(data, data - distance, max_length);
+        if (length < 2 || (length == 2 && i >= 2))
+            continue;
+        auto score = last_distance_score(length, i);
+        if (score > best.score)
+            best = { length, distance, length, score };
+    }
+
+    if (m_compression_constants.use_binary_tree) {
+        find_binary_tree_matches(position, end, max_distance, &best);
+
+        // The binary tree only compares up to the nice match length
+        if (best.length == m_compression_constants.nice_match_length && best.distance <= max_distance) {
+            best.length += match_length(data + best.length, data + best.length - best.distance, max_length - best.length);
+            best.copy_length = best.length;
+        }
+    } else {
+        find_hash_chain_matches(position, end, max_distance, best);
+    }
+
+    if (m_compression_constants.use_dictionary && best.length < m_compression_constants.nice_match_length)
+        find_dictionary_matches(position, end, max_distance, best);
+
+    return best;
+}
+
+void BrotliCompressionStream::add_command(size_t position, size_t insert_length, Match const& match)
+{
+    auto insert_code = insert_length_code(insert_length);
+    Command command {
+        .insert_length = static_cast<u32>(insert_length),
+        .copy_length = static_cast<u32>(match.copy_length),
+        .output_copy_length = static_cast<u32>(match.length),
+        .command_symbol = 0,
+        .distance_symbol = 0,
+        .distance_extra = 0,
+        .distance_extra_bit_count = 0,
+    };
+
+    // The insert-only command that ends a meta-block never reads a distance
+    if (match.length == 0) {
+        command.copy_length = copy_length_base[0];
+        command.command_symbol = command_symbol(insert_code, 0, true);
+        m_commands.append(command);
+        return;
+    }
+
+    auto copy_code = copy_length_code(match.copy_length);
+    bool is_dictionary_reference = match.distance > max_distance(position);
+
+    Optional<u16> short_code;
+    if (!is_dictionary_reference)
+        short_code = short_distance_code(m_distances, match.distance);
+
+    if (short_code.has_value()) {
+        command.distance_symbol = short_code.value();
+    } else {
+        // RFC 7932 section 4, with NPOSTFIX and NDIRECT both being zero
+        auto value = match.distance + 3;
+        auto extra_bit_count = AK::log2(value) - 1;
+        auto high_bit = (value >> extra_bit_count) & 1;
+        command.distance_symbol = 16 + 2 * (extra_bit_count - 1) + high_bit;
+        command.distance_extra = value - ((2 + high_bit) << extra_bit_count);
+        command.distance_extra_bit_count = extra_bit_count;
+    }
+    command.command_symbol = command_symbol(insert_code, copy_code, command.distance_symbol == 0);
+
+    if (!is_dictionary_reference && command.distance_symbol != 0) {
+        m_distances[3] = m_distances[2];
+        m_distances[2] = m_distances[1];
+        m_distances[1] = m_distances[0];
+        m_distances[0] = match.distance;
+    }
+
+    m_commands.append(command);
+}
+
+void BrotliCompressionStream::parse_block(size_t start, size_t end)
+{
+    m_commands.clear_with_capacity();
+
+    size_t position = start;
+    size_t literal_start = start;
+    while (position + min_match_length <= end) {
+        // Catch up on the positions that were skipped over by a match, or that were too close to the end of the previous block
+        while (m_next_position_to_insert < position)
+            insert_position(m_next_position_to_insert++, end);
+
+        auto match = find_longest_match(position, end);
+        if (match.length == 0) {
+            ++position;
+            continue;
+        }
+
+        // If the next position has a considerably better match, emit a literal instead and take that one
+        if (m_compression_constants.lazy_matching) {
+            for (size_t delay = 0; delay < 4 && match.length < m_compression_constants.nice_match_length && position + 1 + min_match_length <= end; ++delay) {
+                auto next_match = find_longest_match(position + 1, end);
+                if (next_match.score < match.score + lazy_match_score_difference)
+                    break;
+                ++position;
+                match = next_match;
+            }
+        }
+
+        add_command(position, position - literal_start, match);
+
+        position += match.length;
+        literal_start = position;
+    }
+
+    // Positions that can not be hashed yet are inserted with the next block
+    while (m_next_position_to_insert < position && m_next_position_to_insert + min_match_length <= end)
+        insert_position(m_next_position_to_insert++, end);
+
+    if (literal_start < end)
+        add_command(end, end - literal_start, {});
+}
+
+// Generates length limited huffman code lengths. Symbols without any occurrences get a length of zero, and so does
+// the only symbol of a code with just one, as RFC 7932 codes it without any bits.
+static void generate_huffman_lengths(Span<u8> lengths, ReadonlySpan<u32> frequencies, size_t max_bit_length)
+{
+    lengths.fill(0);
+
+    struct Leaf {
+        u32 frequency;
+        u16 symbol;
+    };
+    Vector<Leaf, 704> leaves;
+    for (size_t symbol = 0; symbol < frequencies.size(); ++symbol) {
+        if (frequencies[symbol] != 0)
+            leaves.append({ frequencies[symbol], static_cast<u16>(symbol) });
+    }
+    if (leaves.size() <= 1)
+        return;
+
+    quick_sort(leaves, [](auto const& a, auto const& b) {
+        return a.frequency < b.frequency || (a.frequency == b.frequency && a.symbol < b.symbol);
+    });
+
+    auto leaf_count = leaves.size();
+    auto node_count = 2 * leaf_count - 1;
+    Vector<u64, 2 * 704> weights;
+    Vector<u16, 2 * 704> parents;
+    Vector<u8, 2 * 704> depths;
+    weights.resize(node_count);
+    parents.resize(node_count);
+    depths.resize(node_count);
+
+    // If the tree is too deep, raising the frequencies of the rarest symbols flattens it
+    for (u64 minimum_frequency = 1;; minimum_frequency *= 2) {
+        for (size_t i = 0; i < leaf_count; ++i)
+            weights[i] = max<u64>(leaves[i].frequency, minimum_frequency);
+
+        // The leaves are sorted and the internal nodes are created in ascending order, so merging the two queues
+        // always yields the two lightest nodes.
+        size_t next_leaf = 0;
+        size_t next_node = leaf_count;
+        for (size_t node = leaf_count; node < node_count; ++node) {
+            auto take_lightest = [&] {
+                if (next_leaf < leaf_count && (next_node == node || weights[next_leaf] <= weights[next_node]))
+                    return next_leaf++;
+                return next_node++;
+            };
+            auto first = take_lightest();
+            auto second = take_lightest();
+            weights[node] = weights[first] + weights[second];
+            parents[first] = node;
+            parents[second] = node;
+        }
+
+        depths[node_count - 1] = 0;
+        size_t max_depth = 0;
+        for (size_t node = node_count - 1; node-- > 0;) {
+            depths[node] = depths[parents[node]] + 1;
+            max_depth = max<size_t>(max_depth, depths[node]);
+        }
+
+        if (max_depth <= max_bit_length) {
+            for (size_t i = 0; i < leaf_count; ++i)
+                lengths[leaves[i].symbol] = depths[i];
+            return;
+        }
+    }
+}
+
+// RFC 7932 section 3.2, the codes are bit-reversed as they are written starting from the most significant bit.
+static void generate_huffman_codes(Span<u16> codes, ReadonlySpan<u8> lengths)
+{
+    Array<u16, 16> length_counts {};
+    for (auto length : lengths)
+        ++length_counts[length];
+    length_counts[0] = 0;
+
+    Array<u16, 16> next_codes {};
+    u16 code = 0;
+    for (size_t bits = 1; bits < next_codes.size(); ++bits) {
+        code = (code + length_counts[bits - 1]) << 1;
+        next_codes[bits] = code;
+    }
+
+    for (size_t symbol = 0; symbol < lengths.size(); ++symbol) {
+        auto length = lengths[symbol];
+        if (length == 0) {
+            codes[symbol] = 0;
+            continue;
+        }
+        u16 value = next_codes[length]++;
+        u16 reversed = 0;
+        for (size_t i = 0; i < length; ++i)
+            reversed |= ((value >> i) & 1) << (length - 1 - i);
+        codes[symbol] = reversed;
+    }
+}
+
+struct PrefixCode {
+    static PrefixCode create(ReadonlySpan<u32> histogram, size_t max_bit_length = 15)
+    {
+        PrefixCode code;
+        code.lengths.resize(histogram.size());
+        code.codes.resize(histogram.size());
+        generate_huffman_lengths(code.lengths, histogram, max_bit_length);
+        generate_huffman_codes(code.codes, code.lengths);
+        return code;
+    }
+
+    ErrorOr<void> write_symbol(LittleEndianOutputBitStream& stream, size_t symbol) const
+    {
+        return stream.write_bits(codes[symbol], lengths[symbol]);
+    }
+
+    Vector<u8> lengths;
+    Vector<u16> codes;
+};
+
+// RFC 7932 section 3.5
+static constexpr u8 code_length_code_order[18] { 1, 2, 3, 4, 0, 5, 17, 6, 16, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+struct CodeLengthSymbol {
+    u8 symbol;
+    u8 extra; // The repeat count bits of symbols 16 and 17
+};
+
+static void append_repeated_zeros(Vector<CodeLengthSymbol, 704>& symbols, size_t count)
+{
+    if (count == 11) {
+        symbols.append({ 0, 0 });
+        --count;
+    }
+    if (count < 3) {
+        for (size_t i = 0; i < count; ++i)
+            symbols.append({ 0, 0 });
+        return;
+    }
+
+    // Consecutive repeat codes multiply their repeat counts, so the count is split into base 8 digits
+    auto first = symbols.size();
+    count -= 3;
+    for (;;) {
+        symbols.append({ 17, static_cast<u8>(count & 7) });
+        count >>= 3;
+        if (count == 0)
+            break;
+        --count;
+    }
+    symbols.span().slice(first).reverse();
+}
+
+static void append_repeated_lengths(Vector<CodeLengthSymbol, 704>& symbols, u8 previous_length, u8 length, size_t count)
+{
+    if (previous_length != length) {
+        symbols.append({ length, 0 });
+        --count;
+    }
+    if (count == 7) {
+        symbols.append({ length, 0 });
+        --count;
+    }
+    if (count < 3) {
+        for (size_t i = 0; i < count; ++i)
+            symbols.append({ length, 0 });
+        return;
+    }
+
+    auto first = symbols.size();
+    count -= 3;
+    for (;;) {
+        symbols.append({ 16, static_cast<u8>(count & 3) });
+        count >>= 2;
+        if (count == 0)
+            break;
+        --count;
+    }
+    symbols.span().slice(first).reverse();
+}
+
+static size_t bits_for_alphabet(size_t alphabet_size)
+{
+    size_t bits = 0;
+    while ((1u << bits) < alphabet_size)
+        ++bits;
+    return bits;
+}
+
+// RFC 7932 section 3.4
+static ErrorOr<void> write_simple_prefix_code(LittleEndianOutputBitStream& stream, PrefixCode const& code, ReadonlySpan<u16> used_symbols)
+{
+    Array<u16, 4> symbols {};
+    used_symbols.copy_to(symbols);
+    auto sorted_symbols = symbols.span().trim(max<size_t>(used_symbols.size(), 1));
+    quick_sort(sorted_symbols, [&](auto a, auto b) {
+        return code.lengths[a] < code.lengths[b] || (code.lengths[a] == code.lengths[b] && a < b);
+    });
+
+    TRY(stream.write_bits(1u, 2));
+    TRY(stream.write_bits(sorted_symbols.size() - 1, 2));
+    auto symbol_bits = bits_for_alphabet(code.lengths.size());
+    for (auto symbol : sorted_symbols)
+        TRY(stream.write_bits(symbol, symbol_bits));
+    if (sorted_symbols.size() == 4)
+        TRY(stream.write_bits(code.lengths[sorted_symbols[0]] == 1 ? 1u : 0u, 1));
+    return {};
+}
+
+// RFC 7932 section 3.5
+static ErrorOr<void> write_complex_prefix_code(LittleEndianOutputBitStream& stream, PrefixCode const& code)
+{
+    auto lengths_count = code.lengths.size();
+    while (lengths_count > 0 && code.lengths[lengths_count - 1] == 0)
+        --lengths_count;
+
+    Vector<CodeLengthSymbol, 704> symbols;
+    u8 previous_length = 8;
+    for (size_t i = 0; i < lengths_count;) {
+        auto length = code.lengths[i];
+        size_t count = 1;
+        while (i + count < lengths_count && code.lengths[i + count] == length)
+            ++count;
+        if (length == 0) {
+            append_repeated_zeros(symbols, count);
+        } else {
+            append_repeated_lengths(symbols, previous_length, length, count);
+            previous_length = length;
+        }
+        i += count;
+    }
+
+    Array<u32, 18> histogram {};
+    for (auto symbol : symbols)
+        ++histogram[symbol.symbol];
+    Array<u8, 18> lengths {};
+    Array<u16, 18> codes {};
+    generate_huffman_lengths(lengths, histogram, 5);
+    generate_huffman_codes(codes, lengths);
+
+    size_t used_symbol_count = 0;
+    for (auto count : histogram)
+        used_symbol_count += count != 0;
+
+    // A code with just one symbol has no bits. It is described by giving only that symbol a length, and since
+    // the code never becomes complete, by storing the lengths of all symbols.
+    size_t lengths_to_store = 18;
+    if (used_symbol_count == 1) {
+        for (size_t i = 0; i < histogram.size(); ++i) {
+            if (histogram[i] != 0)
+                lengths[i] = 1;
+        }
+    } else {
+        while (lengths[code_length_code_order[lengths_to_store - 1]] == 0)
+            --lengths_to_store;
+    }
+
+    size_t skipped_lengths = 0;
+    if (lengths[code_length_code_order[0]] == 0 && lengths[code_length_code_order[1]] == 0)
+        skipped_lengths = lengths[code_length_code_order[2]] == 0 ? 3 : 2;
+    TRY(stream.write_bits(skipped_lengths, 2));
+
+    static constexpr u8 length_codes[6] { 0, 7, 3, 2, 1, 15 };
+    static constexpr u8 length_code_bits[6] { 2, 4, 3, 2, 2, 4 };
+    for (size_t i = skipped_lengths; i < lengths_to_store; ++i) {
+        auto length = lengths[code_length_code_order[i]];
+        TRY(stream.write_bits(length_codes[length], length_code_bits[length]));
+    }
+
+    for (auto symbol : symbols) {
+        if (used_symbol_count > 1)
+            TRY(stream.write_bits(codes[symbol.symbol], lengths[symbol.symbol]));
+        if (symbol.symbol == 16)
+            TRY(stream.write_bits(symbol.extra, 2));
+        else if (symbol.symbol == 17)
+            TRY(stream.write_bits(symbol.extra, 3));
+    }
+    return {};
+}
+
+static ErrorOr<void> write_prefix_code(LittleEndianOutputBitStream& stream, PrefixCode const& code, ReadonlySpan<u32> histogram)
+{
+    Vector<u16, 4> used_symbols;
+    for (size_t symbol = 0; symbol < histogram.size() && used_symbols.size() <= 4; ++symbol) {
+        if (histogram[symbol] != 0)
+            used_symbols.append(symbol);
+    }
+
+    if (used_symbols.size() <= 4)
+        return write_simple_prefix_code(stream, code, used_symbols);
+    return write_complex_prefix_code(stream, code);
+}
+
+// RFC 7932 section 9.2
+static ErrorOr<void> write_variable_length(LittleEndianOutputBitStream& stream, size_t value)
+{
+    if (value == 1)
+        return stream.write_bits(0u, 1);
+
+    auto bits = AK::log2(value - 1);
+    TRY(stream.write_bits(1u, 1));
+    TRY(stream.write_bits(bits, 3));
+    TRY(stream.write_bits(value - 1 - (1u << bits), bits));
+    return {};
+}
+
+// RFC 7932 section 7.3
+static ErrorOr<void> write_context_map(LittleEndianOutputBitStream& stream, ReadonlySpan<u8> context_map, size_t tree_count)
+{
+    TRY(write_variable_length(stream, tree_count));
+
+    // The move-to-front transform turns runs of the same tree into runs of zeros
+    Array<u8, 256> recent_values;
+    for (size_t i = 0; i < recent_values.size(); ++i)
+        recent_values[i] = i;
+    Vector<u8, 64> values;
+    for (auto value : context_map) {
+        size_t index = 0;
+        while (recent_values[index] != value)
+            ++index;
+        values.append(index);
+        for (; index > 0; --index)
+            recent_values[index] = recent_values[index - 1];
+        recent_values[0] = value;
+    }
+
+    size_t longest_zero_run = 0;
+    for (size_t i = 0; i < values.size();) {
+        size_t run = 0;
+        while (i + run < values.size() && values[i + run] == 0)
+            ++run;
+        longest_zero_run = max(longest_zero_run, run);
+        i += max<size_t>(run, 1);
+    }
+    size_t max_run_length_prefix = longest_zero_run > 0 ? min<size_t>(AK::log2(longest_zero_run), 16) : 0;
+
+    struct Symbol {
+        u16 symbol;
+        u16 extra;
+    };
+    Vector<Symbol, 64> symbols;
+    for (size_t i = 0; i < values.size();) {
+        if (values[i] != 0) {
+            symbols.append({ static_cast<u16>(values[i] + max_run_length_prefix), 0 });
+            ++i;
+            continue;
+        }
+        size_t run = 0;
+        while (i + run < values.size() && values[i + run] == 0)
+            ++run;
+        i += run;
+        while (run > 0) {
+            if (run < (2u << max_run_length_prefix)) {
+                auto prefix = AK::log2(run);
+                symbols.append({ static_cast<u16>(prefix), static_cast<u16>(run - (1u << prefix)) });
+                break;
+            }
+            symbols.append({ static_cast<u16>(max_run_length_prefix), static_cast<u16>((1u << max_run_length_prefix) - 1) });
+            run -= (2u << max_run_length_prefix) - 1;
+        }
+    }
+
+    TRY(stream.write_bits(max_run_length_prefix > 0 ? 1u : 0u, 1));
+    if (max_run_length_prefix > 0)
+        TRY(stream.write_bits(max_run_length_prefix - 1, 4));
+
+    Vector<u32, 256> histogram;
+    histogram.resize(tree_count + max_run_length_prefix);
+    for (auto symbol : symbols)
+        ++histogram[symbol.symbol];
+    auto code = PrefixCode::create(histogram);
+    TRY(write_prefix_code(stream, code, histogram));
+
+    for (auto symbol : symbols) {
+        TRY(code.write_symbol(stream, symbol.symbol));
+        if (symbol.symbol > 0 && symbol.symbol <= max_run_length_prefix)
+            TRY(stream.write_bits(symbol.extra, symbol.symbol));
+    }
+
+    // IMTF, the inverse move-to-front transform has to be applied
+    TRY(stream.write_bits(1u, 1));
+    return {};
+}
+
+using LiteralHistogram = Array<u32, 256>;
+
+static float bits_for_count(u32 count)
+{
+    // count * log2(count) for the counts that are common in a single meta-block
+    static Array<float, 4096> const table = [] {
+        Array<float, 4096> table {};
+        for (size_t i = 1; i < table.size(); ++i)
+            table[i] = static_cast<float>(i) * AK::log2(static_cast<float>(i));
+        return table;
+    }();
+    if (count < table.size())
+        return table[count];
+    return static_cast<float>(count) * AK::log2(static_cast<float>(count));
+}
+
+// Estimates the number of bits needed to encode the literals of a histogram, including their prefix code.
+static float literal_histogram_cost(LiteralHistogram const& histogram)
+{
+    u32 total = 0;
+    size_t used_symbols = 0;
+    float bits = 0;
+    for (auto count : histogram) {
+        if (count == 0)
+            continue;
+        total += count;
+        ++used_symbols;
+        bits -= bits_for_count(count);
+    }
+    if (used_symbols <= 1)
+        return 12;
+    bits += bits_for_count(total);
+    return bits + (used_symbols <= 4 ? 4 + 8 * used_symbols : 16 + 4 * used_symbols);
+}
+
+// Greedily merges the literal histograms of the contexts, as long as that makes the estimated output smaller or
+// there are too many of them. Returns the estimated cost of the resulting trees.
+static float cluster_literal_histograms(Span<LiteralHistogram const> context_histograms, size_t max_trees, Array<u8, 64>& context_map, Vector<LiteralHistogram>& trees)
+{
+    struct Cluster {
+        LiteralHistogram histogram;
+        float cost;
+        bool is_merged;
+    };
+    Vector<Cluster, 64> clusters;
+    Array<u8, 64> cluster_of_context;
+    for (size_t context = 0; context < 64; ++context) {
+        auto const& histogram = context_histograms[context];
+        if (all_of(histogram, [](auto count) { return count == 0; })) {
+            cluster_of_context[context] = NumericLimits<u8>::max();
+            continue;
+        }
+        cluster_of_context[context] = clusters.size();
+        clusters.append({ histogram, literal_histogram_cost(histogram), false });
+    }
+
+    auto merged_histogram = [&](size_t a, size_t b) {
+        LiteralHistogram histogram;
+        for (size_t i = 0; i < histogram.size(); ++i)
+            histogram[i] = clusters[a].histogram[i] + clusters[b].histogram[i];
+        return histogram;
+    };
+
+    Array<Array<float, 64>, 64> merge_cost_differences;
+    auto update_merge_cost_difference = [&](size_t a, size_t b) {
+        auto difference = literal_histogram_cost(merged_histogram(a, b)) - clusters[a].cost - clusters[b].cost;
+        merge_cost_differences[min(a, b)][max(a, b)] = difference;
+    };
+    for (size_t a = 0; a < clusters.size(); ++a) {
+        for (size_t b = a + 1; b < clusters.size(); ++b)
+            update_merge_cost_difference(a, b);
+    }
+
+    for (auto cluster_count = clusters.size(); cluster_count > 1; --cluster_count) {
+        size_t best_a = 0;
+        size_t best_b = 0;
+        auto best_difference = NumericLimits<float>::max();
+        for (size_t a = 0; a < clusters.size(); ++a) {
+            if (clusters[a].is_merged)
+                continue;
+            for (size_t b = a + 1; b < clusters.size(); ++b) {
+                if (!clusters[b].is_merged && merge_cost_differences[a][b] < best_difference) {
+                    best_difference = merge_cost_differences[a][b];
+                    best_a = a;
+                    best_b = b;
+                }
+            }
+        }
+        if (best_difference >= 0 && cluster_count <= max_trees)
+            break;
+
+        clusters[best_a].histogram = merged_histogram(best_a, best_b);
+        clusters[best_a].cost = literal_histogram_cost(clusters[best_a].histogram);
+        clusters[best_b].is_merged = true;
+        for (auto& cluster : cluster_of_context) {
+            if (cluster == best_b)
+                cluster = best_a;
+        }
+        for (size_t other = 0; other < clusters.size(); ++other) {
+            if (other != best_a && !clusters[other].is_merged)
+                update_merge_cost_difference(best_a, other);
+        }
+    }
+
+    // Number the trees in order of their first use, and let contexts without literals share the previous tree,
+    // both of which keep the context map small.
+    trees.clear_with_capacity();
+    Array<u8, 64> tree_of_cluster;
+    tree_of_cluster.fill(NumericLimits<u8>::max());
+    float cost = 0;
+    u8 previous_tree = 0;
+    for (size_t context = 0; context < 64; ++context) {
+        auto cluster = cluster_of_context[context];
+        if (cluster == NumericLimits<u8>::max()) {
+            context_map[context] = previous_tree;
+            continue;
+        }
+        if (tree_of_cluster[cluster] == NumericLimits<u8>::max()) {
+            tree_of_cluster[cluster] = trees.size();
+            trees.append(clusters[cluster].histogram);
+            cost += clusters[cluster].cost;
+        }
+        context_map[context] = previous_tree = tree_of_cluster[cluster];
+    }
+    if (trees.is_empty())
+        trees.append({});
+    return cost + 2 * trees.size();
+}
+
+ErrorOr<void> BrotliCompressionStream::write_stream_header()
+{
+    // If all of the input is known already, a smaller window is enough. This also spares the decompressor from
+    // allocating a large window for small inputs.
+    auto window_bits = m_compression_constants.window_bits;
+    if (m_finished) {
+        while (window_bits > min_window_bits && (1u << (window_bits - 1)) - 16 >= m_buffer.size())
+            --window_bits;
+    }
+    m_window_size = (1u << window_bits) - 16;
+
+    // RFC 7932 section 9.1
+    if (window_bits == 16)
+        TRY(m_output_stream->write_bits(0u, 1));
+    else if (window_bits <= 17)
+        TRY(m_output_stream->write_bits(1u | ((window_bits == 17 ? 0 : window_bits - 8) << 4), 7));
+    else
+        TRY(m_output_stream->write_bits(1u | ((window_bits - 17) << 1), 4));
+
+    if (m_compression_level != CompressionLevel::STORE) {
+        m_hash_bits = min(m_compression_constants.hash_bits, window_bits);
+        m_hash_head = TRY(FixedArray<u32>::create(1u << m_hash_bits));
+        m_hash_chain = TRY(FixedArray<u32>::create((m_compression_constants.use_binary_tree ? 2u : 1u) << window_bits));
+        m_chain_mask = (1u << window_bits) - 1;
+    }
+
+    m_wrote_stream_header = true;
+    return {};
+}
+
+void BrotliCompressionStream::rebase_match_finder()
+{
+    // Table positions are 32-bit, so they are moved closer to zero before they can overflow. Anything that
+    // falls out of the window while doing so is dropped.
+    auto end = m_buffer_position + m_buffer.size();
+    if (end - m_table_base < (1u << 31))
+        return;
+
+    auto new_base = m_buffer_position + m_pending_offset - (m_chain_mask + 1);
+    auto shift = new_base - m_table_base;
+    auto rebase = [&](u32& position) {
+        position = position > shift ? position - shift : 0;
+    };
+    for (auto& position : m_hash_head)
+        rebase(position);
+    for (auto& position : m_hash_chain)
+        rebase(position);
+    m_table_base = new_base;
+}
+
+ErrorOr<void> BrotliCompressionStream::write_meta_block_header(LittleEndianOutputBitStream& stream, size_t length, bool is_uncompressed)
+{
+    // RFC 7932 section 9.2
+    TRY(stream.write_bits(0u, 1)); // ISLAST
+
+    size_t nibbles = 4;
+    while (((length - 1) >> (nibbles * 4)) != 0)
+        ++nibbles;
+    TRY(stream.write_bits(nibbles - 4, 2));
+    TRY(stream.write_bits(length - 1, nibbles * 4));
+
+    TRY(stream.write_bits(is_uncompressed ? 1u : 0u, 1));
+    return {};
+}
+
+ErrorOr<void> BrotliCompressionStream::write_uncompressed_meta_block(size_t start, size_t end)
+{
+    TRY(write_meta_block_header(*m_output_stream, end - start, true));
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_until_depleted(m_buffer.bytes().slice(start, end - start)));
+    return {};
+}
+
+ErrorOr<void> BrotliCompressionStream::write_compressed_meta_block(LittleEndianOutputBitStream& stream, size_t start, size_t end)
+{
+    auto const* data = m_buffer.data();
+    auto context_id = [&](size_t context_mode, size_t position) {
+        return literal_context_id(context_mode, position >= 1 ? data[position - 1] : 0, position >= 2 ? data[position - 2] : 0);
+    };
+    auto for_each_literal = [&](auto callback) {
+        auto position = start;
+        for (auto const& command : m_commands) {
+            for (size_t i = 0; i < command.insert_length; ++i)
+                callback(position++);
+            position += command.output_copy_length;
+        }
+    };
+
+    Array<u32, 704> command_histogram {};
+    Array<u32, 64> distance_histogram {};
+    for (auto const& command : m_commands) {
+        ++command_histogram[command.command_symbol];
+        if (command.output_copy_length != 0 && command.command_symbol >= 128)
+            ++distance_histogram[command.distance_symbol];
+    }
+
+    // Literals are coded with one of several trees, selected by the context of the two preceding bytes. Contexts
+    // with similar statistics are clustered to share a tree.
+    size_t context_mode = 0;
+    Array<u8, 64> context_map {};
+    Vector<LiteralHistogram> literal_histograms;
+    if (m_compression_constants.max_literal_trees == 1) {
+        literal_histograms.resize(1);
+        for_each_literal([&](size_t position) { ++literal_histograms[0][data[position]]; });
+    } else {
+        // The UTF8 mode distinguishes letters, digits and punctuation in text, while the signed mode works better
+        // for binary data.
+        Vector<size_t, 2> context_modes { 2 };
+        if (m_compression_level >= CompressionLevel::GREAT)
+            context_modes.append(3);
+
+        Vector<LiteralHistogram> context_histograms;
+        auto best_cost = NumericLimits<float>::max();
+        for (auto mode : context_modes) {
+            context_histograms.clear_with_capacity();
+            context_histograms.resize(64);
+            for_each_literal([&](size_t position) { ++context_histograms[context_id(mode, position)][data[position]]; });
+
+            Array<u8, 64> mode_context_map {};
+            Vector<LiteralHistogram> trees;
+            auto cost = cluster_literal_histograms(context_histograms, m_compression_constants.max_literal_trees, mode_context_map, trees);
+            if (cost < best_cost) {
+                best_cost = cost;
+                context_mode = mode;
+                context_map = mode_context_map;
+                literal_histograms = move(trees);
+            }
+        }
+    }
+
+    Vector<PrefixCode> literal_codes;
+    for (auto const& histogram : literal_histograms)
+        literal_codes.append(PrefixCode::create(histogram));
+    auto command_code = PrefixCode::create(command_histogram);
+    auto distance_code = PrefixCode::create(distance_histogram);
+
+    TRY(write_meta_block_header(stream, end - start, false));
+    TRY(stream.write_bits(0u, 3)); // NBLTYPESL, NBLTYPESI and NBLTYPESD, there is only a single block of each category
+    TRY(stream.write_bits(0u, 6)); // NPOSTFIX and NDIRECT
+    TRY(stream.write_bits(context_mode, 2));
+    if (literal_histograms.size() == 1)
+        TRY(write_variable_length(stream, 1));
+    else
+        TRY(write_context_map(stream, context_map, literal_histograms.size()));
+    TRY(write_variable_length(stream, 1)); // NTREESD
+
+    for (size_t i = 0; i < literal_codes.size(); ++i)
+        TRY(write_prefix_code(stream, literal_codes[i], literal_histograms[i]));
+    TRY(write_prefix_code(stream, command_code, command_histogram));
+    TRY(write_prefix_code(stream, distance_code, distance_histogram));
+
+    auto position = start;
+    for (auto const& command : m_commands) {
+        auto cell = command.command_symbol >> 6;
+        auto insert_code = insert_length_code_base[cell] + ((command.command_symbol >> 3) & 7);
+        auto copy_code = copy_length_code_base[cell] + (command.command_symbol & 7);
+        TRY(command_code.write_symbol(stream, command.command_symbol));
+        TRY(stream.write_bits(command.insert_length - insert_length_base[insert_code], insert_length_extra[insert_code]));
+        TRY(stream.write_bits(command.copy_length - copy_length_base[copy_code], copy_length_extra[copy_code]));
+
+        for (size_t i = 0; i < command.insert_length; ++i, ++position) {
+            auto tree = context_map[context_id(context_mode, position)];
+            TRY(literal_codes[tree].write_symbol(stream, data[position]));
+        }
+
+        if (command.output_copy_length == 0)
+            break;
+        if (cell >= 2) {
+            TRY(distance_code.write_symbol(stream, command.distance_symbol));
+            TRY(stream.write_bits(command.distance_extra, command.distance_extra_bit_count));
+        }
+        position += command.output_copy_length;
+    }
+    VERIFY(position == end);
+
+    return {};
+}
+
+ErrorOr<void> BrotliCompressionStream::flush()
+{
+    if (!m_wrote_stream_header)
+        TRY(write_stream_header());
+
+    auto start = m_pending_offset;
+    auto end = m_buffer.size();
+    if (start == end)
+        return {};
+
+    if (m_compression_level == CompressionLevel::STORE) {
+        TRY(write_uncompressed_meta_block(start, end));
+    } else {
+        rebase_match_finder();
+        auto distances = m_distances;
+        parse_block(start, end);
+
+        // The meta-block is written to a separate stream first, so that we can fall back to storing it if
+        // compression turns out not to be worth it.
+        AllocatingMemoryStream compressed_stream;
+        LittleEndianOutputBitStream compressed_bit_stream { MaybeOwned<Stream>(compressed_stream) };
+        TRY(write_compressed_meta_block(compressed_bit_stream, start, end));
+        TRY(compressed_bit_stream.flush_buffer_to_stream());
+        auto trailing_bit_count = compressed_bit_stream.bit_offset();
+        TRY(compressed_bit_stream.align_to_byte_boundary());
+        TRY(compressed_bit_stream.flush_buffer_to_stream());
+
+        auto compressed = TRY(ByteBuffer::create_uninitialized(compressed_stream.used_buffer_size()));
+        TRY(compressed_stream.read_until_filled(compressed));
+        auto full_byte_count = compressed.size() - (trailing_bit_count != 0 ? 1 : 0);
+
+        // An uncompressed meta-block has a header of at most 28 bits, which is followed by padding and the data
+        if (full_byte_count * 8 + trailing_bit_count >= (end - start) * 8 + 36) {
+            m_distances = distances;
+            TRY(write_uncompressed_meta_block(start, end));
+        } else {
+            size_t i = 0;
+            for (; i + 4 <= full_byte_count; i += 4) {
+                u32 word = compressed[i] | (compressed[i + 1] << 8) | (compressed[i + 2] << 16) | (static_cast<u32>(compressed[i + 3]) << 24);
+                TRY(m_output_stream->write_bits(word, 32));
+            }
+            for (; i < full_byte_count; ++i)
+                TRY(m_output_stream->write_bits(compressed[i], 8));
+            if (trailing_bit_count != 0)
+                TRY(m_output_stream->write_bits(compressed[i], trailing_bit_count));
+        }
+    }
+    m_pending_offset = end;
+
+    // Only a window's worth of history is needed to find matches, so the rest is dropped from time to time
+    if (m_buffer.size() >= m_window_size + max(m_window_size, block_size)) {
+        auto discarded = m_buffer.size() - m_window_size;
+        __builtin_memmove(m_buffer.data(), m_buffer.data() + discarded, m_window_size);
+        m_buffer.resize(m_window_size);
+        m_buffer_position += discarded;
+        m_pending_offset -= discarded;
+        m_next_position_to_insert -= discarded;
+    }
+
+    return {};
+}
+
+ErrorOr<void> BrotliCompressionStream::final_flush()
+{
+    VERIFY(!m_finished);
+    m_finished = true;
+    TRY(flush());
+
+    // RFC 7932 section 9.2: an empty meta-block with ISLAST and ISLASTEMPTY set ends the stream
+    TRY(m_output_stream->write_bits(0b11u, 2));
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->flush_buffer_to_stream());
+    return {};
+}
+
+ErrorOr<ByteBuffer> BrotliCompressionStream::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
+{
+    auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+    auto brotli_stream = TRY(BrotliCompressionStream::construct(MaybeOwned<Stream>(*output_stream), compression_level));
+
+    TRY(brotli_stream->write_until_depleted(bytes));
+    TRY(brotli_stream->final_flush());
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream->used_buffer_size()));
+    TRY(output_stream->read_until_filled(buffer));
+
+    return buffer;
+}
+
 }
@@ -6,9 +6,13 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/BitStream.h>
+#include <AK/ByteBuffer.h>
 #include <AK/CircularQueue.h>
 #include <AK/FixedArray.h>
+#include <AK/MaybeOwned.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/Vector.h>
 
 namespace Compress {
@@ -162,4 +166,113 @@ private:
     Vector<CanonicalCode> m_distance_codes;
 };
 
+class BrotliCompressionStream final : public Stream {
+public:
+    static constexpr size_t block_size = 256 * KiB; // The amount of input that is compressed into a single meta-block
+    static constexpr size_t min_window_bits = 10;
+    static constexpr size_t min_match_length = 4; // Only repeated distances are used for shorter matches
+
+    struct CompressionConstants {
+        size_t window_bits;       // Log2 of the window size, smaller inputs get a smaller window
+        size_t hash_bits;         // Log2 of the number of hash buckets used by the match finder
+        bool use_binary_tree;     // Whether matches are found using binary trees instead of hash chains
+        size_t max_search_depth;  // The number of candidates that are looked at for each position
+        size_t nice_match_length; // Once we find a match of at least this length we stop searching for longer ones
+        bool lazy_matching;       // Whether matches are deferred if the next position has a better one
+        bool use_dictionary;      // Whether the static dictionary is searched for matches
+        size_t max_literal_trees; // The number of prefix codes the literal contexts are clustered into
+    };
+
+    static constexpr CompressionConstants compression_constants[] = {
+        { 16, 0, false, 0, 0, false, false, 1 },
+        { 18, 15, false, 8, 32, false, false, 1 },
+        { 20, 16, false, 32, 64, true, true, 8 },
+        { 22, 17, true, 32, 128, true, true, 16 },
+        { 22, 17, true, 128, 273, true, true, 32 },
+    };
+
+    enum class CompressionLevel : int {
+        STORE = 0,
+        FAST,
+        GOOD,
+        GREAT,
+        BEST
+    };
+
+    static ErrorOr<NonnullOwnPtr<BrotliCompressionStream>> construct(MaybeOwned<Stream>, CompressionLevel = CompressionLevel::GOOD);
+    ~BrotliCompressionStream();
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+    ErrorOr<void> final_flush();
+
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
+
+private:
+    BrotliCompressionStream(NonnullOwnPtr<LittleEndianOutputBitStream>, CompressionLevel);
+
+    struct Match {
+        size_t length { 0 };      // The number of bytes the match produces
+        size_t distance { 0 };    // Distances beyond the window refer to the static dictionary
+        size_t copy_length { 0 }; // The copy length of the command, which is the word length for dictionary references
+        size_t score { 0 };
+    };
+
+    struct Command {
+        u32 insert_length;
+        u32 copy_length;
+        u32 output_copy_length; // Zero for the insert-only command that ends a meta-block
+        u16 command_symbol;
+        u16 distance_symbol;
+        u32 distance_extra;
+        u8 distance_extra_bit_count;
+    };
+
+    // LZ77 Compression
+    size_t max_distance(size_t position) const;
+    u32 table_position(size_t position) const;
+    size_t hash_sequence(u8 const* bytes) const;
+    Match find_longest_match(size_t position, size_t end);
+    void find_hash_chain_matches(size_t position, size_t end, size_t max_distance, Match&);
+    void find_binary_tree_matches(size_t position, size_t end, size_t max_distance, Match*);
+    void find_dictionary_matches(size_t position, size_t end, size_t max_distance, Match&);
+    void insert_position(size_t position, size_t end);
+    void rebase_match_finder();
+    void add_command(size_t position, size_t insert_length, Match const&);
+    void parse_block(size_t start, size_t end);
+
+    // Entropy Coding
+    ErrorOr<void> write_stream_header();
+    ErrorOr<void> write_meta_block_header(LittleEndianOutputBitStream&, size_t length, bool is_uncompressed);
+    ErrorOr<void> write_uncompressed_meta_block(size_t start, size_t end);
+    ErrorOr<void> write_compressed_meta_block(LittleEndianOutputBitStream&, size_t start, size_t end);
+    ErrorOr<void> flush();
+
+    bool m_finished { false };
+    bool m_wrote_stream_header { false };
+    CompressionLevel m_compression_level;
+    CompressionConstants m_compression_constants;
+    NonnullOwnPtr<LittleEndianOutputBitStream> m_output_stream;
+
+    // The buffer holds up to a window of already compressed history, followed by the pending input.
+    ByteBuffer m_buffer;
+    size_t m_pending_offset { 0 };
+    u64 m_buffer_position { 0 }; // The stream position of the first byte in the buffer
+    size_t m_window_size { 0 };
+
+    // Positions in the match finder tables are stored relative to m_table_base, with zero marking an empty slot.
+    u64 m_table_base { 0 };
+    size_t m_next_position_to_insert { 0 };
+    size_t m_hash_bits { 0 };
+    FixedArray<u32> m_hash_head;
+    FixedArray<u32> m_hash_chain; // Hash chain links, or pairs of binary tree children
+    size_t m_chain_mask { 0 };
+
+    Array<size_t, 4> m_distances { 4, 11, 15, 16 };
+    Vector<Command> m_commands;
+};
+
 }
@@ -60,14 +60,14 @@ static int ferment(Bytes word, size_t pos)
     }
 }
 
-static void ferment_first(Bytes word)
+void BrotliDictionary::ferment_first(Bytes word)
 {
     if (word.size() > 0) {
         ferment(word, 0);
     }
 }
 
-[[maybe_unused]] static void ferment_all(Bytes word)
+void BrotliDictionary::ferment_all(Bytes word)
 {
     size_t i = 0;
     while (i < word.size()) {
@@ -80,7 +80,7 @@ using BrotliDictionary::TransformationOperation::FermentFirst;
 using BrotliDictionary::TransformationOperation::Identity;
 using BrotliDictionary::TransformationOperation::OmitFirst;
 using BrotliDictionary::TransformationOperation::OmitLast;
-constexpr static BrotliDictionary::Transformation transformations[121] {
+constexpr static BrotliDictionary::Transformation transformations[BrotliDictionary::transformation_count] {
     //                                            ID       Prefix     Transform            Suffix
     //                                            --       ------     ---------            ------
     { ""sv, Identity, 0, ""sv },              //   0           ""     Identity                 ""
@@ -206,16 +206,33 @@ constexpr static BrotliDictionary::Transformation transformations[121] {
     { " "sv, FermentFirst, 0, "='"sv },       // 120          " "     FermentFirst           "='"
 };
 
+size_t BrotliDictionary::word_id_bits(size_t length)
+{
+    VERIFY(length >= min_word_length && length <= max_word_length);
+    return bits_by_length[length];
+}
+
+ReadonlyBytes BrotliDictionary::word(size_t length, size_t word_id)
+{
+    VERIFY(word_id < (1u << word_id_bits(length)));
+    return { brotli_dictionary_data + offset_by_length[length] + (word_id * length), length };
+}
+
+BrotliDictionary::Transformation const& BrotliDictionary::transformation(size_t transformation_id)
+{
+    return transformations[transformation_id];
+}
+
 ErrorOr<ByteBuffer> BrotliDictionary::lookup_word(size_t index, size_t length)
 {
-    if (length < 4 || length > 24)
+    if (length < min_word_length || length > max_word_length)
         return Error::from_string_literal("invalid dictionary lookup length");
 
     size_t word_index = index % (1 << bits_by_length[length]);
     ReadonlyBytes base_word { brotli_dictionary_data + offset_by_length[length] + (word_index * length), length };
     size_t transform_id = index >> bits_by_length[length];
 
-    if (transform_id >= 121)
+    if (transform_id >= transformation_count)
         return Error::from_string_literal("invalid dictionary transformation");
 
     auto transformation = transformations[transform_id];
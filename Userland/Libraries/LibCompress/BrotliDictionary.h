@@ -26,7 +26,20 @@ public:
         StringView suffix;
     };
 
+    static constexpr size_t min_word_length = 4;
+    static constexpr size_t max_word_length = 24;
+    static constexpr size_t transformation_count = 121;
+
     static ErrorOr<ByteBuffer> lookup_word(size_t index, size_t length);
+
+    // These expose the raw dictionary to the compressor, which has to search it for matches.
+    // A dictionary reference encodes `word_id | (transformation_id << word_id_bits(length))` as its index.
+    static size_t word_id_bits(size_t length);
+    static ReadonlyBytes word(size_t length, size_t word_id);
+    static Transformation const& transformation(size_t transformation_id);
+
+    static void ferment_first(Bytes word);
+    static void ferment_all(Bytes word);
 };
 
 }
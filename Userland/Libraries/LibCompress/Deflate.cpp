@@ -23,29 +23,14 @@ static constexpr u8 deflate_special_code_length_long_zeros = 18;
 
 CanonicalCode const& CanonicalCode::fixed_literal_codes()
 {
-    static CanonicalCode code;
-    static bool initialized = false;
-
-    if (initialized)
-        return code;
-
-    code = MUST(CanonicalCode::from_bytes(fixed_literal_bit_lengths));
-    initialized = true;
-
+    // NOTE: Compressors on different threads can get here at the same time, which is fine for a static initializer.
+    static CanonicalCode const code = MUST(CanonicalCode::from_bytes(fixed_literal_bit_lengths));
     return code;
 }
 
 CanonicalCode const& CanonicalCode::fixed_distance_codes()
 {
-    static CanonicalCode code;
-    static bool initialized = false;
-
-    if (initialized)
-        return code;
-
-    code = MUST(CanonicalCode::from_bytes(fixed_distance_bit_lengths));
-    initialized = true;
-
+    static CanonicalCode const code = MUST(CanonicalCode::from_bytes(fixed_distance_bit_lengths));
     return code;
 }
 
@@ -174,49 +159,258 @@ ErrorOr<void> CanonicalCode::write_symbol(LittleEndianOutputBitStream& stream, u
     return {};
 }
 
-DeflateDecompressor::CompressedBlock::CompressedBlock(DeflateDecompressor& decompressor, CanonicalCode literal_codes, Optional<CanonicalCode> distance_codes)
-    : m_decompressor(decompressor)
-    , m_literal_codes(literal_codes)
-    , m_distance_codes(distance_codes)
+ErrorOr<DeflateDecodingTable> DeflateDecodingTable::create(ReadonlyBytes code_lengths, size_t first_level_bits, Entry (*entry_for_symbol)(size_t symbol))
 {
+    Array<u16, max_code_length + 1> code_length_counts {};
+    size_t symbol_count = 0;
+    for (auto code_length : code_lengths) {
+        if (code_length > max_code_length)
+            return Error::from_string_literal("Failed to decode code lengths");
+        if (code_length != 0) {
+            ++code_length_counts[code_length];
+            ++symbol_count;
+        }
+    }
+
+    DeflateDecodingTable table;
+    table.m_first_level_bits = first_level_bits;
+    TRY(table.m_entries.try_resize(1u << first_level_bits));
+
+    // Like CanonicalCode, we accept a single used symbol regardless of its code length, and decode it from any bit.
+    if (symbol_count == 1) {
+        for (size_t symbol = 0; symbol < code_lengths.size(); ++symbol) {
+            if (code_lengths[symbol] == 0)
+                continue;
+            auto entry = entry_for_symbol(symbol);
+            entry.bit_count = 1;
+            table.m_entries.span().fill(entry);
+        }
+        return table;
+    }
+
+    // The code has to be complete, i.e. every sequence of bits has to start with one of the codes.
+    Array<u16, max_code_length + 1> next_code {};
+    size_t unused_codes = 1;
+    for (size_t code_length = 1; code_length <= max_code_length; ++code_length) {
+        unused_codes <<= 1;
+        if (code_length_counts[code_length] > unused_codes)
+            return Error::from_string_literal("Failed to decode code lengths");
+        unused_codes -= code_length_counts[code_length];
+        if (code_length < max_code_length)
+            next_code[code_length + 1] = (next_code[code_length] + code_length_counts[code_length]) << 1;
+    }
+    if (unused_codes != 0)
+        return Error::from_string_literal("Failed to decode code lengths");
+
+    // DEFLATE stores Huffman codes starting from their most significant bit, so the tables are indexed by reversed codes.
+    Vector<u16, 288> reversed_codes;
+    TRY(reversed_codes.try_resize(code_lengths.size()));
+    for (size_t symbol = 0; symbol < code_lengths.size(); ++symbol) {
+        if (auto code_length = code_lengths[symbol]; code_length != 0)
+            reversed_codes[symbol] = fast_reverse16(next_code[code_length]++, code_length);
+    }
+
+    // Codes that are longer than the first level share a subtable with the other codes that start the same way,
+    // which is big enough for the longest of them.
+    auto first_level_mask = (1u << first_level_bits) - 1;
+    for (size_t symbol = 0; symbol < code_lengths.size(); ++symbol) {
+        if (code_lengths[symbol] <= first_level_bits)
+            continue;
+        auto& first_level_entry = table.m_entries[reversed_codes[symbol] & first_level_mask];
+        first_level_entry.kind = Kind::Subtable;
+        first_level_entry.bit_count = max<u8>(first_level_entry.bit_count, code_lengths[symbol] - first_level_bits);
+    }
+    for (size_t index = 0; index <= first_level_mask; ++index) {
+        auto& first_level_entry = table.m_entries[index];
+        if (first_level_entry.kind != Kind::Subtable)
+            continue;
+        first_level_entry.value = table.m_entries.size();
+        TRY(table.m_entries.try_resize(table.m_entries.size() + (1u << first_level_entry.bit_count)));
+    }
+
+    // Every code fills all the entries whose index starts with it.
+    for (size_t symbol = 0; symbol < code_lengths.size(); ++symbol) {
+        auto code_length = code_lengths[symbol];
+        if (code_length == 0)
+            continue;
+        auto entry = entry_for_symbol(symbol);
+        entry.bit_count = code_length;
+
+        if (code_length <= first_level_bits) {
+            for (size_t index = reversed_codes[symbol]; index <= first_level_mask; index += 1u << code_length)
+                table.m_entries[index] = entry;
+            continue;
+        }
+
+        auto subtable = table.m_entries[reversed_codes[symbol] & first_level_mask];
+        auto subtable_code_length = code_length - first_level_bits;
+        for (size_t index = reversed_codes[symbol] >> first_level_bits; index < (1u << subtable.bit_count); index += 1u << subtable_code_length)
+            table.m_entries[subtable.value + index] = entry;
+    }
+
+    return table;
 }
 
-ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
+ErrorOr<DeflateDecodingTable> DeflateDecodingTable::create_for_literals_and_lengths(ReadonlyBytes code_lengths)
 {
-    if (m_eof == true)
-        return false;
+    // Most literal and length codes fit into the first level.
+    auto table = TRY(create(code_lengths, 11, [](size_t symbol) -> Entry {
+        if (symbol < 256)
+            return { static_cast<u16>(symbol), 0, Kind::Literal };
+        if (symbol == 256)
+            return { 0, 0, Kind::EndOfBlock };
+        if (symbol < 286)
+            return { static_cast<u16>(symbol - 257), 0, Kind::Length };
+        return { 0, 0, Kind::Invalid };
+    }));
+
+    // If the bits after a literal's code start with another literal's code, they can be decoded in one lookup.
+    auto first_level_size = 1u << table.m_first_level_bits;
+    Vector<Entry> single_entries;
+    TRY(single_entries.try_append(table.m_entries.data(), first_level_size));
+    for (size_t index = 0; index < first_level_size; ++index) {
+        auto first = single_entries[index];
+        if (first.kind != Kind::Literal)
+            continue;
+        auto second = single_entries[index >> first.bit_count];
+        if (second.kind != Kind::Literal || first.bit_count + second.bit_count > table.m_first_level_bits)
+            continue;
+        table.m_entries[index] = { static_cast<u16>(first.value | second.value << 8), static_cast<u8>(first.bit_count + second.bit_count), Kind::TwoLiterals };
+    }
 
-    auto const symbol = TRY(m_literal_codes.read_symbol(*m_decompressor.m_input_stream));
+    return table;
+}
 
-    if (symbol >= 286)
-        return Error::from_string_literal("Invalid deflate literal/length symbol");
+ErrorOr<DeflateDecodingTable> DeflateDecodingTable::create_for_distances(ReadonlyBytes code_lengths)
+{
+    return create(code_lengths, 8, [](size_t symbol) -> Entry {
+        if (symbol < 30)
+            return { static_cast<u16>(symbol), 0, Kind::Distance };
+        return { 0, 0, Kind::Invalid };
+    });
+}
 
-    if (symbol < 256) {
-        u8 byte_symbol = symbol;
-        m_decompressor.m_output_buffer.write({ &byte_symbol, sizeof(byte_symbol) });
-        return true;
+DeflateDecodingTable const& DeflateDecodingTable::fixed_literals_and_lengths()
+{
+    static DeflateDecodingTable const table = MUST(create_for_literals_and_lengths(fixed_literal_bit_lengths));
+    return table;
+}
+
+DeflateDecodingTable const& DeflateDecodingTable::fixed_distances()
+{
+    static DeflateDecodingTable const table = MUST(create_for_distances(fixed_distance_bit_lengths));
+    return table;
+}
+
+DeflateDecompressor::CompressedBlock::CompressedBlock(DeflateDecompressor& decompressor, DeflateDecodingTable const& literal_table, DeflateDecodingTable const* distance_table)
+    : m_decompressor(decompressor)
+    , m_literal_table(literal_table)
+    , m_distance_table(distance_table)
+{
+}
+
+// A back reference may overlap its own output, but if it is at least a word away, the bytes of each word have all been
+// written by the time it is copied. This can write up to a word past the end of the back reference.
+static ALWAYS_INLINE void copy_back_reference(u8* destination, size_t distance, size_t length)
+{
+    if (distance == 1) {
+        __builtin_memset(destination, destination[-1], length);
+        return;
     }
 
-    if (symbol == 256) {
-        m_eof = true;
-        return false;
+    // Shorter distances repeat a pattern, so once a whole word of it has been written, the pattern can just as well be
+    // copied from a multiple of the distance that is at least a word away.
+    size_t offset = 0;
+    if (distance < sizeof(u64)) {
+        for (; offset < min(length, sizeof(u64)); ++offset)
+            destination[offset] = destination[offset - distance];
+        distance *= ceil_div(sizeof(u64), distance);
     }
 
-    if (!m_distance_codes.has_value())
-        return Error::from_string_literal("Distance codes have not been initialized");
+    for (; offset < length; offset += sizeof(u64)) {
+        u64 word;
+        __builtin_memcpy(&word, destination + offset - distance, sizeof(word));
+        __builtin_memcpy(destination + offset, &word, sizeof(word));
+    }
+}
 
-    auto const length = TRY(m_decompressor.decode_length(symbol));
-    auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(*m_decompressor.m_input_stream));
-    if (distance_symbol >= 30)
-        return Error::from_string_literal("Invalid deflate distance symbol");
+ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
+{
+    using Kind = DeflateDecodingTable::Kind;
 
-    auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
+    if (m_eof == true)
+        return false;
 
-    auto copied_length = TRY(m_decompressor.m_output_buffer.copy_from_seekback(distance, length));
+    m_decompressor.make_room_for_output();
+    auto& input_stream = *m_decompressor.m_input_stream;
+    auto* output = m_decompressor.m_output_buffer.data();
+    auto output_offset = m_decompressor.m_output_write_offset;
+
+    // Each refill of the bit buffer holds at least one complete length/distance pair, or a few literals.
+    static constexpr size_t bits_per_refill = 56;
+    static constexpr size_t max_back_reference_bits = 2 * DeflateDecodingTable::max_code_length + 5 + 13;
+    static_assert(max_back_reference_bits <= bits_per_refill);
+
+    while (output_offset <= output_buffer_size - max_back_reference_length && !m_eof) {
+        size_t available_bits;
+        auto bits = TRY(input_stream.peek_bits_until_end(bits_per_refill, available_bits));
+        size_t used_bits = 0;
+        auto consume_bits = [&](size_t count) {
+            bits >>= count;
+            used_bits += count;
+        };
+
+        for (;;) {
+            auto entry = m_literal_table.entry_for(bits);
+
+            if (entry.kind == Kind::Literal || entry.kind == Kind::TwoLiterals) {
+                output[output_offset] = entry.value;
+                output[output_offset + 1] = entry.value >> 8;
+                output_offset += entry.kind == Kind::TwoLiterals ? 2 : 1;
+                consume_bits(entry.bit_count);
+            } else if (entry.kind == Kind::Length) {
+                if (used_bits + max_back_reference_bits > bits_per_refill)
+                    break;
+                if (!m_distance_table)
+                    return Error::from_string_literal("Distance codes have not been initialized");
+
+                auto const& length_symbol = packed_length_symbols[entry.value];
+                consume_bits(entry.bit_count);
+                size_t length = length_symbol.base_length + (bits & ((1u << length_symbol.extra_bits) - 1));
+                consume_bits(length_symbol.extra_bits);
+
+                auto distance_entry = m_distance_table->entry_for(bits);
+                if (distance_entry.kind != Kind::Distance)
+                    return Error::from_string_literal("Invalid deflate distance symbol");
+                auto const& distance_symbol = packed_distances[distance_entry.value];
+                consume_bits(distance_entry.bit_count);
+                size_t distance = distance_symbol.base_distance + (bits & ((1u << distance_symbol.extra_bits) - 1));
+                consume_bits(distance_symbol.extra_bits);
+
+                if (distance > output_offset)
+                    return Error::from_string_literal("Tried a seekback copy beyond the seekback limit");
+                copy_back_reference(output + output_offset, distance, length);
+                output_offset += length;
+            } else if (entry.kind == Kind::EndOfBlock) {
+                consume_bits(entry.bit_count);
+                m_eof = true;
+                break;
+            } else {
+                return Error::from_string_literal("Invalid deflate literal/length symbol");
+            }
+
+            if (used_bits + DeflateDecodingTable::max_code_length > bits_per_refill || output_offset > output_buffer_size - max_back_reference_length)
+                break;
+        }
+
+        if (used_bits > available_bits)
+            return Error::from_string_literal("Input data ends in the middle of a compressed DEFLATE block");
+        input_stream.discard_previously_peeked_bits(used_bits);
+    }
 
-    // TODO: What should we do if the output buffer is full?
-    VERIFY(copied_length == length);
+    m_decompressor.m_output_write_offset = output_offset;
 
+    // The output up to the end of the block still has to be read before the block can be left.
     return true;
 }
 
@@ -234,23 +428,22 @@ ErrorOr<bool> DeflateDecompressor::UncompressedBlock::try_read_more()
     if (m_decompressor.m_input_stream->is_eof())
         return Error::from_string_literal("Input data ends in the middle of an uncompressed DEFLATE block");
 
-    Array<u8, 4096> temporary_buffer;
-    auto readable_bytes = temporary_buffer.span().trim(min(m_bytes_remaining, m_decompressor.m_output_buffer.empty_space()));
-    auto read_bytes = TRY(m_decompressor.m_input_stream->read_some(readable_bytes));
-    auto written_bytes = m_decompressor.m_output_buffer.write(read_bytes);
-    VERIFY(read_bytes.size() == written_bytes);
+    m_decompressor.make_room_for_output();
+    auto writable_bytes = m_decompressor.m_output_buffer.bytes().slice(m_decompressor.m_output_write_offset, min(m_bytes_remaining, output_buffer_size - m_decompressor.m_output_write_offset));
+    auto read_bytes = TRY(m_decompressor.m_input_stream->read_some(writable_bytes));
 
-    m_bytes_remaining -= written_bytes;
+    m_decompressor.m_output_write_offset += read_bytes.size();
+    m_bytes_remaining -= read_bytes.size();
     return true;
 }
 
 ErrorOr<NonnullOwnPtr<DeflateDecompressor>> DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream> stream)
 {
-    auto output_buffer = TRY(CircularBuffer::create_empty(32 * KiB));
+    auto output_buffer = TRY(ByteBuffer::create_uninitialized(output_buffer_size + output_buffer_slack));
     return TRY(adopt_nonnull_own_or_enomem(new (nothrow) DeflateDecompressor(move(stream), move(output_buffer))));
 }
 
-DeflateDecompressor::DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, CircularBuffer output_buffer)
+DeflateDecompressor::DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, ByteBuffer output_buffer)
     : m_input_stream(move(stream))
     , m_output_buffer(move(output_buffer))
 {
@@ -294,18 +487,16 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
 
             if (block_type == 0b01) {
                 m_state = State::ReadingCompressedBlock;
-                new (&m_compressed_block) CompressedBlock(*this, CanonicalCode::fixed_literal_codes(), CanonicalCode::fixed_distance_codes());
+                new (&m_compressed_block) CompressedBlock(*this, DeflateDecodingTable::fixed_literals_and_lengths(), &DeflateDecodingTable::fixed_distances());
 
                 continue;
             }
 
             if (block_type == 0b10) {
-                CanonicalCode literal_codes;
-                Optional<CanonicalCode> distance_codes;
-                TRY(decode_codes(literal_codes, distance_codes));
+                TRY(decode_codes());
 
                 m_state = State::ReadingCompressedBlock;
-                new (&m_compressed_block) CompressedBlock(*this, literal_codes, distance_codes);
+                new (&m_compressed_block) CompressedBlock(*this, m_literal_table, m_distance_table.has_value() ? &m_distance_table.value() : nullptr);
 
                 continue;
             }
@@ -314,10 +505,10 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
         }
 
         if (m_state == State::ReadingCompressedBlock) {
-            auto nread = m_output_buffer.read(slice).size();
+            auto nread = read_output(slice);
 
             while (nread < slice.size() && TRY(m_compressed_block.try_read_more())) {
-                nread += m_output_buffer.read(slice.slice(nread)).size();
+                nread += read_output(slice.slice(nread));
             }
 
             total_read += nread;
@@ -331,10 +522,10 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
         }
 
         if (m_state == State::ReadingUncompressedBlock) {
-            auto nread = m_output_buffer.read(slice).size();
+            auto nread = read_output(slice);
 
             while (nread < slice.size() && TRY(m_uncompressed_block.try_read_more())) {
-                nread += m_output_buffer.read(slice.slice(nread)).size();
+                nread += read_output(slice.slice(nread));
             }
 
             total_read += nread;
@@ -377,36 +568,27 @@ ErrorOr<ByteBuffer> DeflateDecompressor::decompress_all(ReadonlyBytes bytes)
     return deflate_stream->read_until_eof(4096);
 }
 
-ErrorOr<u32> DeflateDecompressor::decode_length(u32 symbol)
+size_t DeflateDecompressor::read_output(Bytes bytes)
 {
-    if (symbol <= 264)
-        return symbol - 254;
-
-    if (symbol <= 284) {
-        auto extra_bits = (symbol - 261) / 4;
-        return (((symbol - 265) % 4 + 4) << extra_bits) + 3 + TRY(m_input_stream->read_bits(extra_bits));
-    }
-
-    if (symbol == 285)
-        return DeflateDecompressor::max_back_reference_length;
-
-    VERIFY_NOT_REACHED();
+    auto unread_output = m_output_buffer.bytes().slice(m_output_read_offset, m_output_write_offset - m_output_read_offset);
+    auto read_size = unread_output.copy_trimmed_to(bytes);
+    m_output_read_offset += read_size;
+    return read_size;
 }
 
-ErrorOr<u32> DeflateDecompressor::decode_distance(u32 symbol)
+void DeflateDecompressor::make_room_for_output()
 {
-    if (symbol <= 3)
-        return symbol + 1;
-
-    if (symbol <= 29) {
-        auto extra_bits = (symbol / 2) - 1;
-        return ((symbol % 2 + 2) << extra_bits) + 1 + TRY(m_input_stream->read_bits(extra_bits));
-    }
+    // Blocks only produce more output once everything before it has been read.
+    VERIFY(m_output_read_offset == m_output_write_offset);
+    if (m_output_write_offset <= output_buffer_size - max_back_reference_length)
+        return;
 
-    VERIFY_NOT_REACHED();
+    auto kept_size = min(m_output_write_offset, history_size);
+    __builtin_memmove(m_output_buffer.data(), m_output_buffer.data() + m_output_write_offset - kept_size, kept_size);
+    m_output_read_offset = m_output_write_offset = kept_size;
 }
 
-ErrorOr<void> DeflateDecompressor::decode_codes(CanonicalCode& literal_code, Optional<CanonicalCode>& distance_code)
+ErrorOr<void> DeflateDecompressor::decode_codes()
 {
     auto literal_code_count = TRY(m_input_stream->read_bits(5)) + 257;
     auto distance_code_count = TRY(m_input_stream->read_bits(5)) + 1;
@@ -453,9 +635,10 @@ ErrorOr<void> DeflateDecompressor::decode_codes(CanonicalCode& literal_code, Opt
         return Error::from_string_literal("Number of code lengths does not match the sum of codes");
 
     // Now we extract the code that was used to encode literals and lengths in the block.
-    literal_code = TRY(CanonicalCode::from_bytes(code_lengths.span().trim(literal_code_count)));
+    m_literal_table = TRY(DeflateDecodingTable::create_for_literals_and_lengths(code_lengths.span().trim(literal_code_count)));
 
     // Now we extract the code that was used to encode distances in the block.
+    m_distance_table.clear();
 
     if (distance_code_count == 1) {
         auto length = code_lengths[literal_code_count];
@@ -466,7 +649,7 @@ ErrorOr<void> DeflateDecompressor::decode_codes(CanonicalCode& literal_code, Opt
             return Error::from_string_literal("Length for a single distance code is longer than 1");
     }
 
-    distance_code = TRY(CanonicalCode::from_bytes(code_lengths.span().slice(literal_code_count)));
+    m_distance_table = TRY(DeflateDecodingTable::create_for_distances(code_lengths.span().slice(literal_code_count)));
 
     return {};
 }
@@ -489,7 +672,8 @@ DeflateCompressor::DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>
 
 DeflateCompressor::~DeflateCompressor()
 {
-    VERIFY(m_finished);
+    // A stream that was only synced, but not finished, can still be completed by a compressor that continues it.
+    VERIFY(m_finished || m_pending_block_size == 0);
 }
 
 ErrorOr<Bytes> DeflateCompressor::read_some(Bytes)
@@ -576,7 +760,7 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             break; // no remaining candidates
 
         VERIFY(candidate < start);
-        if (start - candidate > window_size)
+        if (start - candidate > max_distance)
             break; // outside the window
 
         auto match_length = compare_match_candidate(start, candidate, previous_match_length, maximum_match_length);
@@ -710,6 +894,11 @@ void DeflateCompressor::lz77_compress_block()
 
     // our block starts at block_size and is m_pending_block_size in length
     auto block_end = block_size + m_pending_block_size;
+
+    // the history before our block can be referenced, so it has to be in the hash table as well
+    for (size_t position = block_size - m_history_size; position < min(block_size, block_end - min_match_length + 1); position++)
+        insert_hash(position, hash_sequence(&m_rolling_window[position]));
+
     size_t current_position;
     for (current_position = block_size; current_position < block_end - min_match_length + 1; current_position++) {
         auto hash = hash_sequence(&m_rolling_window[current_position]);
@@ -958,7 +1147,7 @@ ErrorOr<void> DeflateCompressor::flush()
 
     if (m_compression_level == CompressionLevel::STORE) { // disabled compression fast path
         TRY(write_uncompressed());
-        m_pending_block_size = 0;
+        keep_history();
         return {};
     }
 
@@ -1022,16 +1211,46 @@ ErrorOr<void> DeflateCompressor::flush()
         TRY(m_output_stream->align_to_byte_boundary());
 
     // reset all block specific members
-    m_pending_block_size = 0;
     m_pending_symbol_size = 0;
     m_symbol_frequencies.fill(0);
     m_distance_frequencies.fill(0);
-    // On the final block this copy will potentially produce an invalid search window, but since its the final block we dont care
-    pending_block().copy_trimmed_to({ m_rolling_window, block_size });
+    keep_history();
 
     return {};
 }
 
+void DeflateCompressor::keep_history()
+{
+    // The most recent bytes (up to a full block) are moved right before the next pending block
+    auto history_size = min(m_history_size + m_pending_block_size, block_size);
+    __builtin_memmove(m_rolling_window + block_size - history_size, m_rolling_window + block_size + m_pending_block_size - history_size, history_size);
+    m_history_size = history_size;
+    m_pending_block_size = 0;
+}
+
+void DeflateCompressor::set_dictionary(ReadonlyBytes dictionary)
+{
+    VERIFY(!m_finished && m_history_size == 0 && m_pending_block_size == 0);
+    dictionary = dictionary.slice_from_end(min(dictionary.size(), block_size));
+    dictionary.copy_to({ m_rolling_window + block_size - dictionary.size(), dictionary.size() });
+    m_history_size = dictionary.size();
+}
+
+ErrorOr<void> DeflateCompressor::sync_flush()
+{
+    VERIFY(!m_finished);
+    if (m_pending_block_size != 0)
+        TRY(flush());
+
+    // an empty uncompressed block aligns the output to a byte boundary
+    TRY(m_output_stream->write_bits(0b000u, 3));
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xFFFF));
+    TRY(m_output_stream->flush_buffer_to_stream());
+    return {};
+}
+
 ErrorOr<void> DeflateCompressor::final_flush()
 {
     VERIFY(!m_finished);
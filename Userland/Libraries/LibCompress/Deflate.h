@@ -51,11 +51,59 @@ private:
     Vector<u16, 288> m_bit_code_lengths {};
 };
 
+// Decodes the literal/length or distance symbols of a compressed DEFLATE block with a two-level lookup table.
+// The first level is indexed by the next few bits of the input, and codes that are longer than that continue in a
+// second level table for their prefix. Literal entries hold two literals at once if both of their codes fit into the
+// first level.
+class DeflateDecodingTable {
+public:
+    enum class Kind : u8 {
+        Invalid,
+        Literal,
+        TwoLiterals,
+        EndOfBlock,
+        Length,
+        Distance,
+        Subtable,
+    };
+
+    struct Entry {
+        u16 value { 0 };    // The literal(s), the index into packed_length_symbols or packed_distances, or the start of the subtable
+        u8 bit_count { 0 }; // The length of the code(s), or the number of bits that index the subtable
+        Kind kind { Kind::Invalid };
+    };
+
+    static constexpr size_t max_code_length = 15;
+
+    DeflateDecodingTable() = default;
+
+    static ErrorOr<DeflateDecodingTable> create_for_literals_and_lengths(ReadonlyBytes code_lengths);
+    static ErrorOr<DeflateDecodingTable> create_for_distances(ReadonlyBytes code_lengths);
+
+    static DeflateDecodingTable const& fixed_literals_and_lengths();
+    static DeflateDecodingTable const& fixed_distances();
+
+    // The code has to start at the lowest bit of `bits`, which must hold at least max_code_length bits.
+    ALWAYS_INLINE Entry entry_for(u64 bits) const
+    {
+        auto entry = m_entries[bits & ((1u << m_first_level_bits) - 1)];
+        if (entry.kind != Kind::Subtable) [[likely]]
+            return entry;
+        return m_entries[entry.value + ((bits >> m_first_level_bits) & ((1u << entry.bit_count) - 1))];
+    }
+
+private:
+    static ErrorOr<DeflateDecodingTable> create(ReadonlyBytes code_lengths, size_t first_level_bits, Entry (*entry_for_symbol)(size_t symbol));
+
+    Vector<Entry> m_entries;
+    size_t m_first_level_bits { 0 };
+};
+
 class DeflateDecompressor final : public Stream {
 private:
     class CompressedBlock {
     public:
-        CompressedBlock(DeflateDecompressor&, CanonicalCode literal_codes, Optional<CanonicalCode> distance_codes);
+        CompressedBlock(DeflateDecompressor&, DeflateDecodingTable const& literal_table, DeflateDecodingTable const* distance_table);
 
         ErrorOr<bool> try_read_more();
 
@@ -63,8 +111,8 @@ private:
         bool m_eof { false };
 
         DeflateDecompressor& m_decompressor;
-        CanonicalCode m_literal_codes;
-        Optional<CanonicalCode> m_distance_codes;
+        DeflateDecodingTable const& m_literal_table;
+        DeflateDecodingTable const* m_distance_table { nullptr };
     };
 
     class UncompressedBlock {
@@ -100,14 +148,21 @@ public:
     static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
 
 private:
-    DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, CircularBuffer buffer);
+    DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, ByteBuffer output_buffer);
+
+    ErrorOr<void> decode_codes();
 
-    ErrorOr<u32> decode_length(u32);
-    ErrorOr<u32> decode_distance(u32);
-    ErrorOr<void> decode_codes(CanonicalCode& literal_code, Optional<CanonicalCode>& distance_code);
+    size_t read_output(Bytes);
+    void make_room_for_output();
 
     static constexpr u16 max_back_reference_length = 258;
 
+    // Decompressed data is written to a flat buffer, behind the history that back references can reach into. Once all
+    // of it has been read and there is no room left, the history is moved back to the start of the buffer.
+    static constexpr size_t history_size = 32 * KiB;
+    static constexpr size_t output_buffer_size = 128 * KiB;
+    static constexpr size_t output_buffer_slack = 16; // Literals and back references are written in whole words, which can overshoot a bit
+
     bool m_read_final_block { false };
 
     State m_state { State::Idle };
@@ -116,14 +171,21 @@ private:
         UncompressedBlock m_uncompressed_block;
     };
 
+    // The tables of the current block, if it uses dynamic Huffman codes
+    DeflateDecodingTable m_literal_table;
+    Optional<DeflateDecodingTable> m_distance_table;
+
     MaybeOwned<LittleEndianInputBitStream> m_input_stream;
-    CircularBuffer m_output_buffer;
+    ByteBuffer m_output_buffer;
+    size_t m_output_read_offset { 0 };
+    size_t m_output_write_offset { 0 };
 };
 
 class DeflateCompressor final : public Stream {
 public:
     static constexpr size_t block_size = 32 * KiB - 1; // TODO: this can theoretically be increased to 64 KiB - 2
     static constexpr size_t window_size = block_size * 2;
+    static constexpr size_t max_distance = 32 * KiB; // back references cannot reach further than this
     static constexpr size_t hash_bits = 15;
     static constexpr size_t max_huffman_literals = 288;
     static constexpr size_t max_huffman_distances = 32;
@@ -165,12 +227,21 @@ public:
     virtual void close() override;
     ErrorOr<void> final_flush();
 
+    // Makes the end of the given data available to back references, as if it had been compressed right before the
+    // following input. This must be called before anything is written.
+    void set_dictionary(ReadonlyBytes);
+
+    // Compresses all pending input and ends the output on a byte boundary without finishing the stream (like zlib's
+    // Z_SYNC_FLUSH), so that the output of separate compressors can be concatenated into a single stream.
+    ErrorOr<void> sync_flush();
+
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
 
 private:
     DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>, CompressionLevel = CompressionLevel::GOOD);
 
     Bytes pending_block() { return { m_rolling_window + block_size, block_size }; }
+    void keep_history();
 
     // LZ77 Compression
     static u16 hash_sequence(u8 const* bytes);
@@ -203,6 +274,7 @@ private:
     NonnullOwnPtr<LittleEndianOutputBitStream> m_output_stream;
 
     u8 m_rolling_window[window_size];
+    size_t m_history_size { 0 }; // the number of bytes right before the pending block that back references can point to
     size_t m_pending_block_size { 0 };
 
     struct [[gnu::packed]] {
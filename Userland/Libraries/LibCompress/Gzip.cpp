@@ -14,6 +14,7 @@
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
+#include <LibThreading/ParallelFor.h>
 
 namespace Compress {
 
@@ -205,8 +206,9 @@ ErrorOr<size_t> GzipDecompressor::write_some(ReadonlyBytes)
     return Error::from_errno(EBADF);
 }
 
-GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream)
+GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream, Threads threads)
     : m_output_stream(move(stream))
+    , m_threads(threads)
 {
 }
 
@@ -226,16 +228,84 @@ ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
     header.extra_flags = 3;      // DEFLATE sets 2 for maximum compression and 4 for minimum compression
     header.operating_system = 3; // unix
     TRY(m_output_stream->write_until_depleted({ &header, sizeof(header) }));
-    auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
-    TRY(compressed_stream->write_until_depleted(bytes));
-    TRY(compressed_stream->final_flush());
-    Crypto::Checksum::CRC32 crc32;
-    crc32.update(bytes);
-    TRY(m_output_stream->write_value<LittleEndian<u32>>(crc32.digest()));
+
+    u32 checksum;
+    if (m_threads == Threads::Multiple && bytes.size() > parallel_part_size) {
+        checksum = TRY(write_compressed_parts(bytes));
+    } else {
+        auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
+        TRY(compressed_stream->write_until_depleted(bytes));
+        TRY(compressed_stream->final_flush());
+        checksum = Crypto::Checksum::CRC32(bytes).digest();
+    }
+    TRY(m_output_stream->write_value<LittleEndian<u32>>(checksum));
     TRY(m_output_stream->write_value<LittleEndian<u32>>(bytes.size()));
     return bytes.size();
 }
 
+static ErrorOr<ByteBuffer> compress_part(ReadonlyBytes preceding_input, ReadonlyBytes part, bool is_last_part)
+{
+    AllocatingMemoryStream output_stream;
+    auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(output_stream)));
+    deflate_stream->set_dictionary(preceding_input);
+    TRY(deflate_stream->write_until_depleted(part));
+    if (is_last_part)
+        TRY(deflate_stream->final_flush());
+    else
+        TRY(deflate_stream->sync_flush());
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
+    TRY(output_stream.read_until_filled(buffer));
+    return buffer;
+}
+
+// Writes a single deflate stream that is made up of separately compressed parts, and returns the checksum of the input.
+ErrorOr<u32> GzipCompressor::write_compressed_parts(ReadonlyBytes bytes)
+{
+    struct CompressedPart {
+        ByteBuffer data;
+        u32 checksum { 0 };
+        Optional<Error> error;
+    };
+
+    auto part_count = ceil_div(bytes.size(), parallel_part_size);
+
+    // The parts are compressed in batches, so that only a limited amount of compressed data is held in memory.
+    auto batch_size = Threading::parallel_for_thread_count() * 4;
+    Vector<CompressedPart> compressed_parts;
+    TRY(compressed_parts.try_resize(min(batch_size, part_count)));
+
+    u32 checksum = 0;
+    for (size_t batch_start = 0; batch_start < part_count; batch_start += batch_size) {
+        auto batch_part_count = min(batch_size, part_count - batch_start);
+
+        Threading::parallel_for(batch_part_count, [&](size_t index, size_t) {
+            auto part_index = batch_start + index;
+            auto offset = part_index * parallel_part_size;
+            auto part = bytes.slice(offset, min(parallel_part_size, bytes.size() - offset));
+
+            auto& compressed_part = compressed_parts[index];
+            compressed_part.checksum = Crypto::Checksum::CRC32(part).digest();
+            auto data_or_error = compress_part(bytes.trim(offset), part, part_index == part_count - 1);
+            if (data_or_error.is_error())
+                compressed_part.error = data_or_error.release_error();
+            else
+                compressed_part.data = data_or_error.release_value();
+        });
+
+        for (size_t index = 0; index < batch_part_count; ++index) {
+            auto& compressed_part = compressed_parts[index];
+            if (compressed_part.error.has_value())
+                return compressed_part.error.release_value();
+            TRY(m_output_stream->write_until_depleted(compressed_part.data));
+
+            auto offset = (batch_start + index) * parallel_part_size;
+            checksum = Crypto::Checksum::CRC32::combine(checksum, compressed_part.checksum, min(parallel_part_size, bytes.size() - offset));
+        }
+    }
+    return checksum;
+}
+
 bool GzipCompressor::is_eof() const
 {
     return true;
@@ -250,10 +320,10 @@ void GzipCompressor::close()
 {
 }
 
-ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes)
+ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes, Threads threads)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
-    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream) };
+    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream), threads };
 
     TRY(gzip_stream.write_until_depleted(bytes));
 
@@ -262,7 +332,7 @@ ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes)
     return buffer;
 }
 
-ErrorOr<void> GzipCompressor::compress_file(StringView input_filename, NonnullOwnPtr<Stream> output_stream)
+ErrorOr<void> GzipCompressor::compress_file(StringView input_filename, NonnullOwnPtr<Stream> output_stream, Threads threads)
 {
     // We map the whole file instead of streaming to reduce size overhead (gzip header) and increase the deflate block size (better compression)
     // TODO: automatically fallback to buffered streaming for very large files
@@ -274,7 +344,7 @@ ErrorOr<void> GzipCompressor::compress_file(StringView input_filename, NonnullOw
         input_bytes = file->bytes();
     }
 
-    auto output_bytes = TRY(Compress::GzipCompressor::compress_all(input_bytes));
+    auto output_bytes = TRY(Compress::GzipCompressor::compress_all(input_bytes, threads));
     TRY(output_stream->write_until_depleted(output_bytes));
 
     return {};
@@ -84,7 +84,17 @@ private:
 
 class GzipCompressor final : public Stream {
 public:
-    GzipCompressor(MaybeOwned<Stream>);
+    // Large inputs can be split into parts that are compressed on multiple threads, like pigz does. Every part uses
+    // the end of the previous one as its dictionary, so this only costs a few bytes per part. The output does not
+    // depend on the number of threads that are actually available.
+    enum class Threads {
+        Single,
+        Multiple,
+    };
+
+    static constexpr size_t parallel_part_size = 128 * KiB;
+
+    GzipCompressor(MaybeOwned<Stream>, Threads = Threads::Single);
 
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
@@ -92,11 +102,14 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
 
-    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes);
-    static ErrorOr<void> compress_file(StringView input_file, NonnullOwnPtr<Stream> output_stream);
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, Threads = Threads::Single);
+    static ErrorOr<void> compress_file(StringView input_file, NonnullOwnPtr<Stream> output_stream, Threads = Threads::Single);
 
 private:
+    ErrorOr<u32> write_compressed_parts(ReadonlyBytes);
+
     MaybeOwned<Stream> m_output_stream;
+    Threads m_threads { Threads::Single };
 };
 
 }
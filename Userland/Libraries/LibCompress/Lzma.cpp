@@ -1007,7 +1007,9 @@ ErrorOr<void> LzmaCompressor::encode_once()
     }
 
     // If we weren't able to find any viable existing offsets, we now have to search the rest of the dictionary for possible new offsets.
-    auto new_distance_result = m_dictionary->find_copy_in_seekback(m_dictionary->used_space(), normalized_to_real_match_length_offset);
+    // Note: A new match of only two bytes is rarely shorter than two literals, and finding one requires a plain memory search
+    //       through the whole dictionary. Only searching the hashed chunks keeps incompressible data from taking quadratic time.
+    auto new_distance_result = m_dictionary->find_copy_in_seekback(m_dictionary->used_space(), SearchableCircularBuffer::HASH_CHUNK_SIZE);
 
     if (new_distance_result.has_value()) {
         auto selected_match = new_distance_result.release_value();
@@ -1214,15 +1216,25 @@ void LzmaDecompressor::close()
 
 ErrorOr<NonnullOwnPtr<LzmaCompressor>> LzmaCompressor::create_container(MaybeOwned<Stream> stream, LzmaCompressorOptions const& options)
 {
-    auto dictionary = TRY(try_make<SearchableCircularBuffer>(TRY(SearchableCircularBuffer::create_empty(options.dictionary_size + largest_real_match_length))));
+    auto header = TRY(LzmaHeader::from_compressor_options(options));
+    TRY(stream->write_value(header));
+
+    return create_raw_stream(move(stream), options);
+}
+
+ErrorOr<NonnullOwnPtr<LzmaCompressor>> LzmaCompressor::create_raw_stream(MaybeOwned<Stream> stream, LzmaCompressorOptions const& options, Optional<MaybeOwned<SearchableCircularBuffer>> dictionary)
+{
+    if (!dictionary.has_value()) {
+        auto new_dictionary = TRY(SearchableCircularBuffer::create_empty(options.dictionary_size + largest_real_match_length));
+        dictionary = TRY(try_make<SearchableCircularBuffer>(move(new_dictionary)));
+    }
+
+    VERIFY((*dictionary)->capacity() >= options.dictionary_size + largest_real_match_length);
 
     // "The LZMA Decoder uses (1 << (lc + lp)) tables with CProb values, where each table contains 0x300 CProb values."
     auto literal_probabilities = TRY(FixedArray<Probability>::create(literal_probability_table_size * (1 << (options.literal_context_bits + options.literal_position_bits))));
 
-    auto header = TRY(LzmaHeader::from_compressor_options(options));
-    TRY(stream->write_value(header));
-
-    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) LzmaCompressor(move(stream), options, move(dictionary), move(literal_probabilities))));
+    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) LzmaCompressor(move(stream), options, dictionary.release_value(), move(literal_probabilities))));
 
     return compressor;
 }
@@ -1235,6 +1247,28 @@ LzmaCompressor::LzmaCompressor(MaybeOwned<AK::Stream> stream, Compress::LzmaComp
 {
 }
 
+ErrorOr<void> LzmaCompressor::append_output_stream(MaybeOwned<Stream> stream, Optional<u64> uncompressed_size)
+{
+    if (!m_has_flushed_data)
+        return Error::from_string_literal("Appending an LZMA stream before flushing the previous one");
+
+    if (m_options.uncompressed_size.has_value() != uncompressed_size.has_value())
+        return Error::from_string_literal("Appending LZMA streams with mismatching uncompressed size status");
+
+    if (uncompressed_size.has_value())
+        *m_options.uncompressed_size += *uncompressed_size;
+
+    m_stream = move(stream);
+
+    m_range_encoder_range = 0xFFFFFFFF;
+    m_range_encoder_code = 0;
+    m_range_encoder_cached_byte = 0x00;
+    m_range_encoder_ff_chain_length = 0;
+    m_has_flushed_data = false;
+
+    return {};
+}
+
 ErrorOr<Bytes> LzmaCompressor::read_some(Bytes)
 {
     return Error::from_errno(EBADF);
@@ -217,6 +217,16 @@ public:
     /// Creates a compressor for a standalone LZMA container (.lzma file extension, occasionally known as an LZMA 'archive').
     static ErrorOr<NonnullOwnPtr<LzmaCompressor>> create_container(MaybeOwned<Stream>, LzmaCompressorOptions const&);
 
+    /// Creates a compressor for a raw stream of LZMA-compressed data (found inside an LZMA container or embedded in other file formats).
+    static ErrorOr<NonnullOwnPtr<LzmaCompressor>> create_raw_stream(MaybeOwned<Stream>, LzmaCompressorOptions const&, Optional<MaybeOwned<SearchableCircularBuffer>> dictionary = {});
+
+    /// Continues in a new raw stream after the current one has been flushed, keeping the dictionary and the state of the model.
+    /// This is the counterpart to LzmaDecompressor::append_input_stream.
+    ErrorOr<void> append_output_stream(MaybeOwned<Stream>, Optional<u64> uncompressed_size);
+
+    // A dictionary that is passed in also holds the data that is waiting to be compressed, so it has to be this much larger than the dictionary size.
+    using LzmaState::largest_real_match_length;
+
     /// Finishes the archive by writing out the remaining data from the range coder.
     ErrorOr<void> flush();
 
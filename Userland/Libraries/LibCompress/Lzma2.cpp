@@ -186,4 +186,153 @@ void Lzma2Decompressor::close()
 {
 }
 
+ErrorOr<NonnullOwnPtr<Lzma2Compressor>> Lzma2Compressor::create_from_raw_stream(MaybeOwned<Stream> stream, u32 dictionary_size)
+{
+    auto dictionary = TRY(SearchableCircularBuffer::create_empty(dictionary_size + LzmaCompressor::largest_real_match_length));
+    auto chunk = TRY(ByteBuffer::create_uninitialized(uncompressed_chunk_size));
+    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Lzma2Compressor(move(stream), dictionary_size, move(dictionary), move(chunk))));
+    return compressor;
+}
+
+Lzma2Compressor::Lzma2Compressor(MaybeOwned<Stream> stream, u32 dictionary_size, SearchableCircularBuffer dictionary, ByteBuffer chunk)
+    : m_stream(move(stream))
+    , m_dictionary_size(dictionary_size)
+    , m_dictionary(move(dictionary))
+    , m_chunk(move(chunk))
+{
+}
+
+Lzma2Compressor::~Lzma2Compressor()
+{
+    if (!m_finished) {
+        // Note: We need a better API for specifying things like this.
+        finish().release_value_but_fixme_should_propagate_errors();
+    }
+}
+
+ErrorOr<void> Lzma2Compressor::write_chunk(ReadonlyBytes data)
+{
+    VERIFY(!data.is_empty() && data.size() <= uncompressed_chunk_size);
+
+    // The data always goes through the LZMA compressor, even if it ends up being stored uncompressed, so that the
+    // dictionary stays in sync with the one of the decompressor.
+    LzmaCompressorOptions const options {
+        .dictionary_size = m_dictionary_size,
+        .uncompressed_size = data.size(),
+    };
+
+    bool const reset_state = m_state_reset_pending;
+    if (reset_state) {
+        m_lzma_stream = TRY(LzmaCompressor::create_raw_stream(MaybeOwned<Stream> { m_compressed_chunk }, options, MaybeOwned<SearchableCircularBuffer> { m_dictionary }));
+    } else {
+        TRY((*m_lzma_stream)->append_output_stream(MaybeOwned<Stream> { m_compressed_chunk }, data.size()));
+    }
+
+    TRY((*m_lzma_stream)->write_until_depleted(data));
+    if ((*m_lzma_stream)->is_open())
+        TRY((*m_lzma_stream)->flush());
+
+    auto compressed_size = m_compressed_chunk.used_buffer_size();
+    if (compressed_size > maximum_compressed_chunk_size || compressed_size >= data.size()) {
+        TRY(m_compressed_chunk.discard(compressed_size));
+
+        // " - 1 denotes a dictionary reset followed by an uncompressed chunk"
+        // " - 2 denotes an uncompressed chunk without a dictionary reset"
+        TRY(m_stream->write_value<u8>(m_dictionary_reset_pending ? 1 : 2));
+        TRY(m_stream->write_value<BigEndian<u16>>(data.size() - 1));
+        TRY(m_stream->write_until_depleted(data));
+
+        m_dictionary_reset_pending = false;
+        m_state_reset_pending = true;
+        return {};
+    }
+
+    // " - 0x80-0xff denotes an LZMA chunk, where the lowest 5 bits are used as bit 16-20
+    //     of the uncompressed size minus one, and bit 5-6 indicates what should be reset."
+    u8 reset_indicator = 0;
+    if (m_dictionary_reset_pending)
+        reset_indicator = 3;
+    else if (reset_state)
+        reset_indicator = 2;
+
+    u32 const encoded_uncompressed_size = data.size() - 1;
+    TRY(m_stream->write_value<u8>(0x80 | (reset_indicator << 5) | (encoded_uncompressed_size >> 16)));
+    TRY(m_stream->write_value<BigEndian<u16>>(encoded_uncompressed_size & 0xFFFF));
+    TRY(m_stream->write_value<BigEndian<u16>>(compressed_size - 1));
+
+    // "A properties/lclppb byte if bit 6 in the control byte is set"
+    if (reset_state) {
+        TRY(m_stream->write_value<u8>(TRY(LzmaHeader::encode_model_properties({
+            .literal_context_bits = options.literal_context_bits,
+            .literal_position_bits = options.literal_position_bits,
+            .position_bits = options.position_bits,
+        }))));
+    }
+
+    while (m_compressed_chunk.used_buffer_size() > 0) {
+        Array<u8, 4096> buffer;
+        auto bytes = TRY(m_compressed_chunk.read_some(buffer));
+        TRY(m_stream->write_until_depleted(bytes));
+    }
+
+    m_dictionary_reset_pending = false;
+    m_state_reset_pending = false;
+    return {};
+}
+
+ErrorOr<Bytes> Lzma2Compressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> Lzma2Compressor::write_some(ReadonlyBytes bytes)
+{
+    if (m_finished)
+        return Error::from_string_literal("Writing to an LZMA2 stream after it has been finished");
+
+    auto written_bytes = bytes.copy_trimmed_to(m_chunk.span().slice(m_chunk_size));
+    m_chunk_size += written_bytes;
+
+    if (m_chunk_size == uncompressed_chunk_size) {
+        TRY(write_chunk(m_chunk.span()));
+        m_chunk_size = 0;
+    }
+
+    return written_bytes;
+}
+
+ErrorOr<void> Lzma2Compressor::finish()
+{
+    if (m_finished)
+        return Error::from_string_literal("Finished an LZMA2 stream twice");
+    m_finished = true;
+
+    if (m_chunk_size > 0) {
+        TRY(write_chunk(m_chunk.span().trim(m_chunk_size)));
+        m_chunk_size = 0;
+    }
+
+    // " - 0 denotes the end of the file"
+    TRY(m_stream->write_value<u8>(0));
+    return {};
+}
+
+bool Lzma2Compressor::is_eof() const
+{
+    return true;
+}
+
+bool Lzma2Compressor::is_open() const
+{
+    return !m_finished;
+}
+
+void Lzma2Compressor::close()
+{
+    if (!m_finished) {
+        // Note: We need a better API for specifying things like this.
+        finish().release_value_but_fixme_should_propagate_errors();
+    }
+}
+
 }
@@ -8,6 +8,7 @@
 
 #include <AK/CircularBuffer.h>
 #include <AK/MaybeOwned.h>
+#include <AK/MemoryStream.h>
 #include <AK/Stream.h>
 #include <LibCompress/Lzma.h>
 
@@ -43,4 +44,46 @@ private:
     Optional<LzmaDecompressorOptions> m_last_lzma_options;
 };
 
+class Lzma2Compressor : public Stream {
+public:
+    /// Creates a compressor that does not emit the leading byte indicating the dictionary size.
+    static ErrorOr<NonnullOwnPtr<Lzma2Compressor>> create_from_raw_stream(MaybeOwned<Stream>, u32 dictionary_size);
+
+    /// Compresses the remaining data and writes the end of the stream.
+    ErrorOr<void> finish();
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+    virtual ~Lzma2Compressor();
+
+private:
+    // The compressed size of a chunk is limited to 64 KiB, so compressing more than that at once might not fit.
+    // Since this is a multiple of 16, the positions that the LZMA model sees are also the same whether or not its
+    // state is reset between chunks.
+    static constexpr size_t uncompressed_chunk_size = 64 * KiB;
+    static constexpr size_t maximum_compressed_chunk_size = 64 * KiB;
+
+    Lzma2Compressor(MaybeOwned<Stream>, u32 dictionary_size, SearchableCircularBuffer dictionary, ByteBuffer chunk);
+
+    ErrorOr<void> write_chunk(ReadonlyBytes);
+
+    MaybeOwned<Stream> m_stream;
+    u32 m_dictionary_size { 0 };
+    SearchableCircularBuffer m_dictionary;
+
+    ByteBuffer m_chunk;
+    size_t m_chunk_size { 0 };
+    AllocatingMemoryStream m_compressed_chunk;
+
+    Optional<NonnullOwnPtr<LzmaCompressor>> m_lzma_stream;
+    // LZMA2 requires that the first chunk resets the dictionary, and that the state is reset after uncompressed chunks.
+    bool m_dictionary_reset_pending { true };
+    bool m_state_reset_pending { true };
+    bool m_finished { false };
+};
+
 }
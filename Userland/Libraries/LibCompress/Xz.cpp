@@ -5,10 +5,12 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/ByteReader.h>
 #include <AK/MemoryStream.h>
 #include <LibCompress/Lzma2.h>
 #include <LibCompress/Xz.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibThreading/ParallelFor.h>
 
 namespace Compress {
 
@@ -44,6 +46,17 @@ ErrorOr<XzMultibyteInteger> XzMultibyteInteger::read_from_stream(Stream& stream)
     return XzMultibyteInteger { result };
 }
 
+ErrorOr<void> XzMultibyteInteger::write_to_stream(Stream& stream) const
+{
+    u64 value = m_value;
+    while (value >= 0x80) {
+        TRY(stream.write_value<u8>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    TRY(stream.write_value<u8>(value));
+    return {};
+}
+
 ErrorOr<void> XzStreamHeader::validate() const
 {
     // 2.1.1.1. Header Magic Bytes:
@@ -161,6 +174,14 @@ u32 XzFilterLzma2Properties::dictionary_size() const
     return dictionary_size;
 }
 
+XzFilterLzma2Properties XzFilterLzma2Properties::for_dictionary_size(u32 minimum_dictionary_size)
+{
+    XzFilterLzma2Properties properties {};
+    while (properties.encoded_dictionary_size < 40 && properties.dictionary_size() < minimum_dictionary_size)
+        properties.encoded_dictionary_size++;
+    return properties;
+}
+
 u32 XzFilterDeltaProperties::distance() const
 {
     // "The Properties byte indicates the delta distance, which can be
@@ -812,4 +833,391 @@ void XzDecompressor::close()
 {
 }
 
+struct XzBlockLocation {
+    ReadonlyBytes block;
+    XzStreamFlags stream_flags;
+    u64 unpadded_size;
+    u64 uncompressed_size;
+};
+
+// Finds the blocks of all streams by walking backwards from the end of the input, using the index of every stream.
+static ErrorOr<Vector<XzBlockLocation>> locate_xz_blocks(ReadonlyBytes input)
+{
+    Vector<XzBlockLocation> blocks;
+    auto end = input.size();
+
+    // An input without any stream in it is not valid XZ data either, so there is always at least one stream to find.
+    do {
+        // 2.2. Stream Padding
+        if (end % 4 != 0)
+            return Error::from_string_literal("XZ Stream Padding is not aligned to 4 bytes");
+        while (end >= 4 && input.slice(end - 4, 4) == Array<u8, 4> {}.span())
+            end -= 4;
+
+        if (end < sizeof(XzStreamHeader) + sizeof(XzStreamFooter))
+            return Error::from_string_literal("XZ stream is too small");
+
+        XzStreamFooter stream_footer;
+        input.slice(end - sizeof(stream_footer), sizeof(stream_footer)).copy_to({ &stream_footer, sizeof(stream_footer) });
+        TRY(stream_footer.validate());
+
+        auto const index_end = end - sizeof(stream_footer);
+        if (stream_footer.backward_size() > index_end - sizeof(XzStreamHeader))
+            return Error::from_string_literal("XZ index size is larger than the stream");
+        auto const index_start = index_end - stream_footer.backward_size();
+        auto const index = input.slice(index_start, stream_footer.backward_size());
+
+        // 4.5. CRC32
+        auto const index_crc32 = ByteReader::load32(index.offset(index.size() - sizeof(u32)));
+        if (Crypto::Checksum::CRC32 { index.trim(index.size() - sizeof(u32)) }.digest() != AK::convert_between_host_and_little_endian(index_crc32))
+            return Error::from_string_literal("XZ index has an invalid CRC32 checksum");
+
+        FixedMemoryStream index_stream { index };
+        if (TRY(index_stream.read_value<u8>()) != 0x00)
+            return Error::from_string_literal("XZ index does not start with an Index Indicator");
+
+        u64 const number_of_records = TRY(index_stream.read_value<XzMultibyteInteger>());
+        Vector<XzBlockLocation> stream_blocks;
+        u64 blocks_size = 0;
+        for (u64 i = 0; i < number_of_records; i++) {
+            u64 const unpadded_size = TRY(index_stream.read_value<XzMultibyteInteger>());
+            u64 const uncompressed_size = TRY(index_stream.read_value<XzMultibyteInteger>());
+            if (unpadded_size < 5 || unpadded_size > index_start)
+                return Error::from_string_literal("XZ index contains a record with an invalid unpadded size");
+
+            TRY(stream_blocks.try_append({ {}, {}, unpadded_size, uncompressed_size }));
+            blocks_size += align_up_to(unpadded_size, 4);
+            if (blocks_size > index_start)
+                return Error::from_string_literal("XZ blocks are larger than the stream");
+        }
+
+        if (index_start - blocks_size < sizeof(XzStreamHeader))
+            return Error::from_string_literal("XZ blocks are larger than the stream");
+        auto const stream_start = index_start - blocks_size - sizeof(XzStreamHeader);
+
+        XzStreamHeader stream_header;
+        input.slice(stream_start, sizeof(stream_header)).copy_to({ &stream_header, sizeof(stream_header) });
+        TRY(stream_header.validate());
+
+        if (ReadonlyBytes { &stream_header.flags, sizeof(XzStreamFlags) } != ReadonlyBytes { &stream_footer.flags, sizeof(XzStreamFlags) })
+            return Error::from_string_literal("XZ stream header flags don't match the stream footer");
+
+        auto block_offset = stream_start + sizeof(XzStreamHeader);
+        for (auto& block : stream_blocks) {
+            auto const padded_size = align_up_to(block.unpadded_size, 4);
+            block.block = input.slice(block_offset, padded_size);
+            block.stream_flags = stream_header.flags;
+            block_offset += padded_size;
+        }
+
+        TRY(blocks.try_prepend(move(stream_blocks)));
+        end = stream_start;
+    } while (end > 0);
+
+    return blocks;
+}
+
+ErrorOr<ByteBuffer> XzDecompressor::decompress_all(ReadonlyBytes input)
+{
+    auto blocks_or_error = locate_xz_blocks(input);
+
+    // If the blocks can't be found, the input is malformed in some way. The regular decompressor takes care of
+    // reporting exactly how.
+    if (blocks_or_error.is_error()) {
+        auto decompressor = TRY(XzDecompressor::create(MaybeOwned<Stream> { TRY(try_make<FixedMemoryStream>(input)) }));
+        return decompressor->read_until_eof();
+    }
+
+    auto blocks = blocks_or_error.release_value();
+
+    // The sizes in the indices are not trusted with allocating the output up front. Instead, only as many blocks as
+    // there are threads are decompressed at once, and each of them only grows its buffer as it actually produces data.
+    ByteBuffer output;
+    auto const batch_size = Threading::parallel_for_thread_count();
+
+    Vector<ByteBuffer> batch_outputs;
+    Vector<Optional<Error>> batch_errors;
+    TRY(batch_outputs.try_resize(batch_size));
+    TRY(batch_errors.try_resize(batch_size));
+
+    for (size_t batch_start = 0; batch_start < blocks.size(); batch_start += batch_size) {
+        auto const batch_block_count = min(batch_size, blocks.size() - batch_start);
+
+        Threading::parallel_for(batch_block_count, [&](size_t index, size_t) {
+            auto const& block = blocks[batch_start + index];
+            auto& block_output = batch_outputs[index];
+            block_output.clear();
+            auto result = decompress_block(block.block, block.stream_flags, block.unpadded_size, block.uncompressed_size, block_output);
+            if (result.is_error())
+                batch_errors[index] = result.release_error();
+        });
+
+        for (size_t i = 0; i < batch_block_count; i++) {
+            if (batch_errors[i].has_value())
+                return batch_errors[i].release_value();
+            TRY(output.try_append(batch_outputs[i]));
+        }
+    }
+
+    return output;
+}
+
+ErrorOr<void> XzDecompressor::decompress_block(ReadonlyBytes block, XzStreamFlags stream_flags, u64 unpadded_size, u64 uncompressed_size, ByteBuffer& output)
+{
+    auto counting_stream = TRY(try_make<CountingStream>(MaybeOwned<Stream> { TRY(try_make<FixedMemoryStream>(block)) }));
+    XzDecompressor decompressor { move(counting_stream) };
+    decompressor.m_stream_flags = stream_flags;
+
+    auto const encoded_block_header_size = TRY(decompressor.m_stream->read_value<u8>());
+    if (encoded_block_header_size == 0x00)
+        return Error::from_string_literal("XZ index contains more records than there are blocks");
+
+    TRY(decompressor.load_next_block(encoded_block_header_size));
+
+    // A block that is shorter than the index claims fails to fill a chunk before the next one is allocated.
+    static constexpr size_t max_chunk_size = 16 * MiB;
+
+    auto& block_stream = *decompressor.m_current_block_stream;
+    for (u64 remaining = uncompressed_size; remaining > 0;) {
+        auto chunk = TRY(output.get_bytes_for_writing(min(remaining, max_chunk_size)));
+        TRY(block_stream->read_until_filled(chunk));
+        remaining -= chunk.size();
+    }
+    decompressor.m_current_block_uncompressed_size = uncompressed_size;
+
+    while (!block_stream->is_eof()) {
+        Array<u8, 1> excess_data;
+        if (!TRY(block_stream->read_some(excess_data)).is_empty())
+            return Error::from_string_literal("Uncompressed size of XZ Block does not match the Index");
+    }
+
+    TRY(decompressor.finish_current_block());
+
+    if (decompressor.m_processed_blocks.last().unpadded_size != unpadded_size)
+        return Error::from_string_literal("Unpadded size of XZ Block does not match the Index");
+
+    if (!decompressor.m_stream->is_eof())
+        return Error::from_string_literal("Unpadded size of XZ Block does not match the Index");
+
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<XzCompressor>> XzCompressor::create(MaybeOwned<Stream> stream, Threads threads, size_t block_size)
+{
+    VERIFY(block_size > 0);
+
+    // When compressing on multiple threads, enough blocks are buffered to keep all threads busy.
+    auto buffered_block_count = threads == Threads::Multiple ? Threading::parallel_for_thread_count() * 2 : 1;
+    auto pending_input = TRY(ByteBuffer::create_uninitialized(block_size * buffered_block_count));
+
+    // 2.1.1. Stream Header
+    XzStreamHeader stream_header {
+        .magic = { 0xFD, '7', 'z', 'X', 'Z', 0x00 },
+        .flags = { .reserved = 0, .check_type = XzStreamCheckType::CRC32, .reserved_bits = 0 },
+        .flags_crc32 = 0,
+    };
+    stream_header.flags_crc32 = Crypto::Checksum::CRC32 { { &stream_header.flags, sizeof(stream_header.flags) } }.digest();
+    TRY(stream->write_value(stream_header));
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) XzCompressor(move(stream), block_size, move(pending_input)));
+}
+
+XzCompressor::XzCompressor(MaybeOwned<Stream> stream, size_t block_size, ByteBuffer pending_input)
+    : m_stream(move(stream))
+    , m_block_size(block_size)
+    , m_pending_input(move(pending_input))
+{
+}
+
+XzCompressor::~XzCompressor()
+{
+    if (!m_finished) {
+        // Note: We need a better API for specifying things like this.
+        finish().release_value_but_fixme_should_propagate_errors();
+    }
+}
+
+ErrorOr<XzCompressor::CompressedBlock> XzCompressor::compress_block(ReadonlyBytes input)
+{
+    // The dictionary never has to be larger than the block.
+    auto const filter_properties = XzFilterLzma2Properties::for_dictionary_size(input.size());
+
+    AllocatingMemoryStream compressed_stream;
+    {
+        auto lzma2_stream = TRY(Lzma2Compressor::create_from_raw_stream(MaybeOwned<Stream> { compressed_stream }, filter_properties.dictionary_size()));
+        TRY(lzma2_stream->write_until_depleted(input));
+        TRY(lzma2_stream->finish());
+    }
+    auto const compressed_size = compressed_stream.used_buffer_size();
+
+    // 3.1. Block Header
+    AllocatingMemoryStream header_stream;
+    TRY(header_stream.write_value<u8>(0)); // Placeholder for the Block Header Size.
+    TRY(header_stream.write_value<XzBlockFlags>({
+        .encoded_number_of_filters = 0,
+        .reserved = 0,
+        .compressed_size_present = true,
+        .uncompressed_size_present = true,
+    }));
+    TRY(header_stream.write_value<XzMultibyteInteger>(compressed_size));
+    TRY(header_stream.write_value<XzMultibyteInteger>(input.size()));
+
+    // 3.1.5. List of Filter Flags, with the LZMA2 filter (5.3.1. LZMA2).
+    TRY(header_stream.write_value<XzMultibyteInteger>(0x21));
+    TRY(header_stream.write_value<XzMultibyteInteger>(sizeof(filter_properties)));
+    TRY(header_stream.write_until_depleted({ &filter_properties, sizeof(filter_properties) }));
+
+    // 3.1.6. Header Padding
+    constexpr size_t size_of_crc32 = 4;
+    while ((header_stream.used_buffer_size() + size_of_crc32) % 4 != 0)
+        TRY(header_stream.write_value<u8>(0));
+
+    auto const header_size = header_stream.used_buffer_size() + size_of_crc32;
+    auto const padded_compressed_size = align_up_to(compressed_size, 4);
+    auto data = TRY(ByteBuffer::create_zeroed(header_size + padded_compressed_size + size_of_crc32));
+
+    TRY(header_stream.read_until_filled(data.bytes().trim(header_size - size_of_crc32)));
+    data[0] = header_size / 4 - 1;
+
+    // 3.1.7. CRC32
+    u32 const header_crc32 = Crypto::Checksum::CRC32 { data.bytes().trim(header_size - size_of_crc32) }.digest();
+    ByteReader::store(data.offset_pointer(header_size - size_of_crc32), AK::convert_between_host_and_little_endian(header_crc32));
+
+    // 3.2. Compressed Data, followed by 3.3. Block Padding (which was zeroed already).
+    TRY(compressed_stream.read_until_filled(data.bytes().slice(header_size, compressed_size)));
+
+    // 3.4. Check
+    u32 const check = Crypto::Checksum::CRC32 { input }.digest();
+    ByteReader::store(data.offset_pointer(header_size + padded_compressed_size), AK::convert_between_host_and_little_endian(check));
+
+    return CompressedBlock {
+        .data = move(data),
+        .unpadded_size = header_size + compressed_size + size_of_crc32,
+    };
+}
+
+ErrorOr<void> XzCompressor::write_blocks(ReadonlyBytes input)
+{
+    auto const block_count = ceil_div(input.size(), m_block_size);
+
+    Vector<ErrorOr<CompressedBlock>> compressed_blocks;
+    TRY(compressed_blocks.try_ensure_capacity(block_count));
+    for (size_t i = 0; i < block_count; i++)
+        compressed_blocks.unchecked_append(CompressedBlock {});
+
+    Threading::parallel_for(block_count, [&](size_t index, size_t) {
+        auto offset = index * m_block_size;
+        compressed_blocks[index] = compress_block(input.slice(offset, min(m_block_size, input.size() - offset)));
+    });
+
+    for (size_t index = 0; index < block_count; index++) {
+        auto compressed_block = TRY(move(compressed_blocks[index]));
+        TRY(m_stream->write_until_depleted(compressed_block.data));
+
+        auto offset = index * m_block_size;
+        TRY(m_index_records.try_append({
+            .unpadded_size = compressed_block.unpadded_size,
+            .uncompressed_size = min(m_block_size, input.size() - offset),
+        }));
+    }
+
+    return {};
+}
+
+ErrorOr<Bytes> XzCompressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> XzCompressor::write_some(ReadonlyBytes bytes)
+{
+    if (m_finished)
+        return Error::from_string_literal("Writing to an XZ stream after it has been finished");
+
+    auto written_bytes = bytes.copy_trimmed_to(m_pending_input.span().slice(m_pending_input_size));
+    m_pending_input_size += written_bytes;
+
+    if (m_pending_input_size == m_pending_input.size()) {
+        TRY(write_blocks(m_pending_input));
+        m_pending_input_size = 0;
+    }
+
+    return written_bytes;
+}
+
+ErrorOr<void> XzCompressor::finish()
+{
+    if (m_finished)
+        return Error::from_string_literal("Finished an XZ stream twice");
+    m_finished = true;
+
+    if (m_pending_input_size > 0) {
+        TRY(write_blocks(m_pending_input.span().trim(m_pending_input_size)));
+        m_pending_input_size = 0;
+    }
+
+    // 4. Index
+    AllocatingMemoryStream index_stream;
+    TRY(index_stream.write_value<u8>(0x00));
+    TRY(index_stream.write_value<XzMultibyteInteger>(m_index_records.size()));
+    for (auto const& record : m_index_records) {
+        TRY(index_stream.write_value<XzMultibyteInteger>(record.unpadded_size));
+        TRY(index_stream.write_value<XzMultibyteInteger>(record.uncompressed_size));
+    }
+    while (index_stream.used_buffer_size() % 4 != 0)
+        TRY(index_stream.write_value<u8>(0));
+
+    auto index = TRY(ByteBuffer::create_uninitialized(index_stream.used_buffer_size()));
+    TRY(index_stream.read_until_filled(index));
+    TRY(m_stream->write_until_depleted(index));
+    TRY(m_stream->write_value<LittleEndian<u32>>(Crypto::Checksum::CRC32 { index }.digest()));
+
+    // 2.1.2. Stream Footer
+    XzStreamFooter stream_footer {
+        .size_and_flags_crc32 = 0,
+        .encoded_backward_size = static_cast<u32>((index.size() + sizeof(u32)) / 4 - 1),
+        .flags = { .reserved = 0, .check_type = XzStreamCheckType::CRC32, .reserved_bits = 0 },
+        .magic = { 'Y', 'Z' },
+    };
+    Crypto::Checksum::CRC32 footer_crc32;
+    footer_crc32.update({ &stream_footer.encoded_backward_size, sizeof(stream_footer.encoded_backward_size) });
+    footer_crc32.update({ &stream_footer.flags, sizeof(stream_footer.flags) });
+    stream_footer.size_and_flags_crc32 = footer_crc32.digest();
+    TRY(m_stream->write_value(stream_footer));
+
+    return {};
+}
+
+bool XzCompressor::is_eof() const
+{
+    return true;
+}
+
+bool XzCompressor::is_open() const
+{
+    return !m_finished;
+}
+
+void XzCompressor::close()
+{
+    if (!m_finished) {
+        // Note: We need a better API for specifying things like this.
+        finish().release_value_but_fixme_should_propagate_errors();
+    }
+}
+
+ErrorOr<ByteBuffer> XzCompressor::compress_all(ReadonlyBytes bytes, Threads threads, size_t block_size)
+{
+    AllocatingMemoryStream output_stream;
+    {
+        auto xz_stream = TRY(XzCompressor::create(MaybeOwned<Stream> { output_stream }, threads, block_size));
+        TRY(xz_stream->write_until_depleted(bytes));
+        TRY(xz_stream->finish());
+    }
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
+    TRY(output_stream.read_until_filled(buffer));
+    return buffer;
+}
+
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/CircularBuffer.h>
 #include <AK/ConstrainedStream.h>
 #include <AK/CountingStream.h>
@@ -35,6 +36,7 @@ public:
     constexpr operator u64() const { return m_value; }
 
     static ErrorOr<XzMultibyteInteger> read_from_stream(Stream& stream);
+    ErrorOr<void> write_to_stream(Stream& stream) const;
 
 private:
     u64 m_value { 0 };
@@ -96,6 +98,8 @@ struct [[gnu::packed]] XzFilterLzma2Properties {
 
     ErrorOr<void> validate() const;
     u32 dictionary_size() const;
+
+    static XzFilterLzma2Properties for_dictionary_size(u32 minimum_dictionary_size);
 };
 static_assert(sizeof(XzFilterLzma2Properties) == 1);
 
@@ -156,6 +160,10 @@ class XzDecompressor : public Stream {
 public:
     static ErrorOr<NonnullOwnPtr<XzDecompressor>> create(MaybeOwned<Stream>);
 
+    /// Decompresses all streams in the input. If the indices describe where the blocks are, they are decompressed on
+    /// multiple threads.
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
+
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
     virtual bool is_eof() const override;
@@ -170,6 +178,8 @@ private:
     ErrorOr<void> finish_current_block();
     ErrorOr<void> finish_current_stream();
 
+    static ErrorOr<void> decompress_block(ReadonlyBytes block, XzStreamFlags, u64 unpadded_size, u64 uncompressed_size, ByteBuffer& output);
+
     NonnullOwnPtr<CountingStream> m_stream;
     Optional<XzStreamFlags> m_stream_flags;
     bool m_found_first_stream_header { false };
@@ -187,6 +197,59 @@ private:
     Vector<BlockMetadata> m_processed_blocks;
 };
 
+class XzCompressor final : public Stream {
+public:
+    // The input is split into blocks that are compressed independently, so that they can be compressed (and later
+    // decompressed) on multiple threads, like `xz --threads` does. The output does not depend on the number of threads
+    // that are actually available.
+    enum class Threads {
+        Single,
+        Multiple,
+    };
+
+    static constexpr size_t default_block_size = 1 * MiB;
+
+    static ErrorOr<NonnullOwnPtr<XzCompressor>> create(MaybeOwned<Stream>, Threads = Threads::Single, size_t block_size = default_block_size);
+
+    /// Compresses the remaining data and writes the index and the footer of the stream.
+    ErrorOr<void> finish();
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+    virtual ~XzCompressor();
+
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes, Threads = Threads::Single, size_t block_size = default_block_size);
+
+private:
+    struct CompressedBlock {
+        ByteBuffer data;
+        u64 unpadded_size { 0 };
+    };
+
+    XzCompressor(MaybeOwned<Stream>, size_t block_size, ByteBuffer pending_input);
+
+    static ErrorOr<CompressedBlock> compress_block(ReadonlyBytes);
+    ErrorOr<void> write_blocks(ReadonlyBytes);
+
+    MaybeOwned<Stream> m_stream;
+    size_t m_block_size { 0 };
+
+    // Multiple blocks are buffered when compressing on multiple threads.
+    ByteBuffer m_pending_input;
+    size_t m_pending_input_size { 0 };
+
+    struct IndexRecord {
+        u64 unpadded_size {};
+        u64 uncompressed_size {};
+    };
+    Vector<IndexRecord> m_index_records;
+    bool m_finished { false };
+};
+
 }
 
 template<>
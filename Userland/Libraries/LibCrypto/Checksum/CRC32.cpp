@@ -12,6 +12,8 @@
 
 namespace Crypto::Checksum {
 
+static constexpr u32 ethernet_polynomial = 0xEDB88320;
+
 #if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
 
 void CRC32::update(ReadonlyBytes span)
@@ -47,8 +49,6 @@ void CRC32::update(ReadonlyBytes span)
 
 #else
 
-static constexpr size_t ethernet_polynomial = 0xEDB88320;
-
 #    if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
 
 // This implements Intel's slicing-by-8 algorithm. Their original paper is no longer on their website,
@@ -171,4 +171,39 @@ u32 CRC32::digest()
     return ~m_state;
 }
 
+// The checksum is a polynomial over GF(2) modulo the CRC polynomial, stored with the x^0 coefficient in the top bit.
+// Appending n bytes to some data multiplies its checksum by x^(8n), so combining two checksums only requires
+// multiplying the first one by that power of x. This is the approach zlib's crc32_combine() uses.
+
+static constexpr u32 multiply_modulo_polynomial(u32 a, u32 b)
+{
+    u32 product = 0;
+    for (u32 bit = 1u << 31; bit != 0; bit >>= 1) {
+        if (a & bit)
+            product ^= b;
+        b = (b & 1) ? (b >> 1) ^ ethernet_polynomial : b >> 1;
+    }
+    return product;
+}
+
+// Holds x^(2^n) modulo the CRC polynomial.
+static constexpr auto powers_of_x = [] {
+    Array<u32, 64> powers {};
+    powers[0] = 1u << 30; // x^1
+    for (size_t n = 1; n < powers.size(); ++n)
+        powers[n] = multiply_modulo_polynomial(powers[n - 1], powers[n - 1]);
+    return powers;
+}();
+
+u32 CRC32::combine(u32 first_digest, u32 second_digest, u64 second_size)
+{
+    // x^(8 * second_size) is the product of x^(2^(n + 3)) for each bit n that is set in second_size.
+    u32 shift = 1u << 31; // x^0
+    for (size_t n = 3; second_size != 0 && n < powers_of_x.size(); ++n, second_size >>= 1) {
+        if (second_size & 1)
+            shift = multiply_modulo_polynomial(powers_of_x[n], shift);
+    }
+    return multiply_modulo_polynomial(shift, first_digest) ^ second_digest;
+}
+
 }
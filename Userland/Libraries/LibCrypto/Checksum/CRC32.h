@@ -29,6 +29,9 @@ public:
     virtual void update(ReadonlyBytes data) override;
     virtual u32 digest() override;
 
+    // Returns the digest of two concatenated pieces of data, given the digests of the pieces.
+    static u32 combine(u32 first_digest, u32 second_digest, u64 second_size);
+
 private:
     u32 m_state { ~0u };
 };
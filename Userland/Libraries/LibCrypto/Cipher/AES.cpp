@@ -4,10 +4,17 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteReader.h>
+#include <AK/Endian.h>
 #include <AK/StringBuilder.h>
 #include <LibCrypto/Cipher/AES.h>
 #include <LibCrypto/Cipher/AESTables.h>
 
+#if ARCH(X86_64) && !defined(KERNEL)
+#    include <cpuid.h>
+#    include <immintrin.h>
+#endif
+
 namespace Crypto::Cipher {
 
 template<typename T>
@@ -23,6 +30,194 @@ constexpr void swap_keys(u32* keys, size_t i, size_t j)
     keys[j] = temp;
 }
 
+#if ARCH(X86_64) && !defined(KERNEL)
+namespace AESNI {
+
+static bool is_supported()
+{
+    static bool const supported = [] {
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return false;
+        return (ecx & bit_AES) && (ecx & bit_SSSE3);
+    }();
+    return supported;
+}
+
+static constexpr size_t max_round_key_count = 15;
+static constexpr size_t interleaved_block_count = 8;
+
+using RoundKeys = __m128i[max_round_key_count];
+
+[[gnu::target("ssse3")]] static void load_round_keys(AESCipherKey const& key, RoundKeys& round_keys)
+{
+    // The round keys are stored as big-endian words, but the AES instructions expect the bytes in order.
+    auto const byte_swap_words = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    auto const* words = key.round_keys();
+    for (size_t i = 0; i <= key.rounds(); ++i)
+        round_keys[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(words + 4 * i)), byte_swap_words);
+}
+
+static __m128i load_block(u8 const* data)
+{
+    return _mm_loadu_si128(reinterpret_cast<__m128i const*>(data));
+}
+
+static void store_block(u8* data, __m128i block)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), block);
+}
+
+// Running the rounds for several blocks side by side hides the latency of the AES instructions.
+template<size_t N>
+[[gnu::target("aes")]] static void encrypt_blocks(RoundKeys const& round_keys, size_t rounds, __m128i (&blocks)[N])
+{
+    for (auto& block : blocks)
+        block = _mm_xor_si128(block, round_keys[0]);
+    for (size_t round = 1; round < rounds; ++round) {
+        for (auto& block : blocks)
+            block = _mm_aesenc_si128(block, round_keys[round]);
+    }
+    for (auto& block : blocks)
+        block = _mm_aesenclast_si128(block, round_keys[rounds]);
+}
+
+// NOTE: The decryption key schedule is already in the form AESDEC expects: reversed, with InvMixColumns applied
+//       to the middle round keys.
+template<size_t N>
+[[gnu::target("aes")]] static void decrypt_blocks(RoundKeys const& round_keys, size_t rounds, __m128i (&blocks)[N])
+{
+    for (auto& block : blocks)
+        block = _mm_xor_si128(block, round_keys[0]);
+    for (size_t round = 1; round < rounds; ++round) {
+        for (auto& block : blocks)
+            block = _mm_aesdec_si128(block, round_keys[round]);
+    }
+    for (auto& block : blocks)
+        block = _mm_aesdeclast_si128(block, round_keys[rounds]);
+}
+
+[[gnu::target("aes,ssse3")]] static void encrypt_block(AESCipherKey const& key, u8 const* in, u8* out)
+{
+    RoundKeys round_keys;
+    load_round_keys(key, round_keys);
+    __m128i blocks[1] { load_block(in) };
+    encrypt_blocks(round_keys, key.rounds(), blocks);
+    store_block(out, blocks[0]);
+}
+
+[[gnu::target("aes,ssse3")]] static void decrypt_block(AESCipherKey const& key, u8 const* in, u8* out)
+{
+    RoundKeys round_keys;
+    load_round_keys(key, round_keys);
+    __m128i blocks[1] { load_block(in) };
+    decrypt_blocks(round_keys, key.rounds(), blocks);
+    store_block(out, blocks[0]);
+}
+
+// The counter is a 128-bit big-endian integer, see IncrementInplace.
+struct Counter {
+    explicit Counter(u8 const* data)
+        : high(AK::convert_between_host_and_big_endian(ByteReader::load64(data)))
+        , low(AK::convert_between_host_and_big_endian(ByteReader::load64(data + 8)))
+    {
+    }
+
+    __m128i next_block()
+    {
+        auto block = _mm_set_epi64x(AK::convert_between_host_and_big_endian(low), AK::convert_between_host_and_big_endian(high));
+        if (++low == 0)
+            ++high;
+        return block;
+    }
+
+    void store(u8* data) const
+    {
+        ByteReader::store(data, AK::convert_between_host_and_big_endian(high));
+        ByteReader::store(data + 8, AK::convert_between_host_and_big_endian(low));
+    }
+
+    u64 high;
+    u64 low;
+};
+
+template<size_t N>
+[[gnu::target("aes,ssse3")]] static void encrypt_ctr_blocks(RoundKeys const& round_keys, size_t rounds, Counter& counter, u8 const* in, u8* out)
+{
+    __m128i blocks[N];
+    for (auto& block : blocks)
+        block = counter.next_block();
+    encrypt_blocks(round_keys, rounds, blocks);
+    for (size_t i = 0; i < N; ++i) {
+        if (in)
+            blocks[i] = _mm_xor_si128(blocks[i], load_block(in + i * 16));
+        store_block(out + i * 16, blocks[i]);
+    }
+}
+
+[[gnu::target("aes,ssse3")]] static void encrypt_ctr(AESCipherKey const& key, u8 const* in, u8* out, size_t block_count, u8* counter_data)
+{
+    RoundKeys round_keys;
+    load_round_keys(key, round_keys);
+    auto rounds = key.rounds();
+    Counter counter { counter_data };
+
+    size_t i = 0;
+    for (; i + interleaved_block_count <= block_count; i += interleaved_block_count)
+        encrypt_ctr_blocks<interleaved_block_count>(round_keys, rounds, counter, in ? in + i * 16 : nullptr, out + i * 16);
+    for (; i < block_count; ++i)
+        encrypt_ctr_blocks<1>(round_keys, rounds, counter, in ? in + i * 16 : nullptr, out + i * 16);
+
+    counter.store(counter_data);
+}
+
+[[gnu::target("aes,ssse3")]] static void encrypt_cbc(AESCipherKey const& key, u8 const* in, u8* out, size_t block_count, u8 const* iv)
+{
+    RoundKeys round_keys;
+    load_round_keys(key, round_keys);
+    auto rounds = key.rounds();
+
+    // Each block depends on the previous one, so there is nothing to interleave here.
+    __m128i blocks[1] { load_block(iv) };
+    for (size_t i = 0; i < block_count; ++i) {
+        blocks[0] = _mm_xor_si128(blocks[0], load_block(in + i * 16));
+        encrypt_blocks(round_keys, rounds, blocks);
+        store_block(out + i * 16, blocks[0]);
+    }
+}
+
+template<size_t N>
+[[gnu::target("aes,ssse3")]] static void decrypt_cbc_blocks(RoundKeys const& round_keys, size_t rounds, __m128i& previous, u8 const* in, u8* out)
+{
+    // All ciphertext blocks are loaded before anything is stored, so that `in` and `out` may be the same buffer.
+    __m128i ciphertexts[N];
+    __m128i blocks[N];
+    for (size_t i = 0; i < N; ++i)
+        blocks[i] = ciphertexts[i] = load_block(in + i * 16);
+    decrypt_blocks(round_keys, rounds, blocks);
+    for (size_t i = 0; i < N; ++i) {
+        store_block(out + i * 16, _mm_xor_si128(blocks[i], previous));
+        previous = ciphertexts[i];
+    }
+}
+
+[[gnu::target("aes,ssse3")]] static void decrypt_cbc(AESCipherKey const& key, u8 const* in, u8* out, size_t block_count, u8 const* iv)
+{
+    RoundKeys round_keys;
+    load_round_keys(key, round_keys);
+    auto rounds = key.rounds();
+    auto previous = load_block(iv);
+
+    size_t i = 0;
+    for (; i + interleaved_block_count <= block_count; i += interleaved_block_count)
+        decrypt_cbc_blocks<interleaved_block_count>(round_keys, rounds, previous, in + i * 16, out + i * 16);
+    for (; i < block_count; ++i)
+        decrypt_cbc_blocks<1>(round_keys, rounds, previous, in + i * 16, out + i * 16);
+}
+
+}
+#endif
+
 #ifndef KERNEL
 ByteString AESCipherBlock::to_byte_string() const
 {
@@ -198,6 +393,13 @@ void AESCipherKey::expand_decrypt_key(ReadonlyBytes user_key, size_t bits)
 
 void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+#if ARCH(X86_64) && !defined(KERNEL)
+    if (AESNI::is_supported()) {
+        AESNI::encrypt_block(m_key, in.bytes().data(), out.bytes().data());
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -287,6 +489,13 @@ void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 
 void AESCipher::decrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+#if ARCH(X86_64) && !defined(KERNEL)
+    if (AESNI::is_supported()) {
+        AESNI::decrypt_block(m_key, in.bytes().data(), out.bytes().data());
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -374,6 +583,48 @@ void AESCipher::decrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
     // clang-format on
 }
 
+bool AESCipher::encrypt_ctr_blocks([[maybe_unused]] ReadonlyBytes const* in, [[maybe_unused]] Bytes out, [[maybe_unused]] Bytes counter)
+{
+#if ARCH(X86_64) && !defined(KERNEL)
+    if (AESNI::is_supported()) {
+        VERIFY(out.size() % block_size() == 0);
+        VERIFY(!in || in->size() >= out.size());
+        VERIFY(counter.size() == block_size());
+        AESNI::encrypt_ctr(m_key, in ? in->data() : nullptr, out.data(), out.size() / block_size(), counter.data());
+        return true;
+    }
+#endif
+    return false;
+}
+
+bool AESCipher::encrypt_cbc_blocks([[maybe_unused]] ReadonlyBytes in, [[maybe_unused]] Bytes out, [[maybe_unused]] ReadonlyBytes iv)
+{
+#if ARCH(X86_64) && !defined(KERNEL)
+    if (AESNI::is_supported()) {
+        VERIFY(in.size() % block_size() == 0);
+        VERIFY(out.size() >= in.size());
+        VERIFY(iv.size() >= block_size());
+        AESNI::encrypt_cbc(m_key, in.data(), out.data(), in.size() / block_size(), iv.data());
+        return true;
+    }
+#endif
+    return false;
+}
+
+bool AESCipher::decrypt_cbc_blocks([[maybe_unused]] ReadonlyBytes in, [[maybe_unused]] Bytes out, [[maybe_unused]] ReadonlyBytes iv)
+{
+#if ARCH(X86_64) && !defined(KERNEL)
+    if (AESNI::is_supported()) {
+        VERIFY(in.size() % block_size() == 0);
+        VERIFY(out.size() >= in.size());
+        VERIFY(iv.size() >= block_size());
+        AESNI::decrypt_cbc(m_key, in.data(), out.data(), in.size() / block_size(), iv.data());
+        return true;
+    }
+#endif
+    return false;
+}
+
 void AESCipherBlock::overwrite(ReadonlyBytes bytes)
 {
     auto data = bytes.data();
@@ -119,6 +119,12 @@ public:
     virtual void encrypt_block(BlockType const& in, BlockType& out) override;
     virtual void decrypt_block(BlockType const& in, BlockType& out) override;
 
+    // These process runs of whole blocks at once when the CPU has AES instructions, which lets independent blocks
+    // overlap in the pipeline. If it doesn't, they return false and the modes fall back to one block at a time.
+    bool encrypt_ctr_blocks(ReadonlyBytes const* in, Bytes out, Bytes counter);
+    bool encrypt_cbc_blocks(ReadonlyBytes in, Bytes out, ReadonlyBytes iv);
+    bool decrypt_cbc_blocks(ReadonlyBytes in, Bytes out, ReadonlyBytes iv);
+
 #ifndef KERNEL
     virtual ByteString class_name() const override
     {
@@ -60,6 +60,15 @@ public:
         size_t offset { 0 };
         auto block_size = cipher.block_size();
 
+        if constexpr (requires { cipher.encrypt_cbc_blocks(in, out, iv); }) {
+            auto bulk_length = length - length % block_size;
+            if (bulk_length > 0 && cipher.encrypt_cbc_blocks(in.slice(0, bulk_length), out, iv)) {
+                offset += bulk_length;
+                length -= bulk_length;
+                iv = out.slice(offset - block_size, block_size);
+            }
+        }
+
         while (length >= block_size) {
             m_cipher_block.overwrite(in.slice(offset, block_size));
             m_cipher_block.apply_initialization_vector(iv);
@@ -104,6 +113,13 @@ public:
         m_cipher_block.set_padding_mode(cipher.padding_mode());
         size_t offset { 0 };
 
+        if constexpr (requires { cipher.decrypt_cbc_blocks(in, out, iv); }) {
+            if (cipher.decrypt_cbc_blocks(in, out, iv)) {
+                offset += length;
+                length = 0;
+            }
+        }
+
         while (length > 0) {
             auto slice = in.slice(offset);
             m_cipher_block.overwrite(slice.data(), block_size);
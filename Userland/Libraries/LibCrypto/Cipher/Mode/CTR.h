@@ -170,6 +170,14 @@ protected:
         size_t offset { 0 };
         auto block_size = cipher.block_size();
 
+        if constexpr (IsSame<IncrementFunctionType, IncrementInplace> && requires { cipher.encrypt_ctr_blocks(in, out, iv); }) {
+            auto bulk_length = length - length % block_size;
+            if (bulk_length > 0 && cipher.encrypt_ctr_blocks(in, out.slice(0, bulk_length), iv)) {
+                offset += bulk_length;
+                length -= bulk_length;
+            }
+        }
+
         while (length > 0) {
             m_cipher_block.overwrite(iv.slice(0, block_size));
 
@@ -223,7 +223,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> LogicalExpression::gene
     auto dst = choose_dst(generator, preferred_dst);
     auto lhs = TRY(m_lhs->generate_bytecode(generator, preferred_dst)).value();
     // FIXME: Only mov lhs into dst in case lhs is the value taken.
-    generator.emit<Bytecode::Op::Mov>(dst, lhs);
+    generator.emit_mov(dst, lhs);
 
     // lhs
     // jump op (true) end (false) rhs
@@ -258,9 +258,9 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> LogicalExpression::gene
     }
 
     generator.switch_to_basic_block(rhs_block);
-    auto rhs = TRY(m_rhs->generate_bytecode(generator)).value();
+    auto rhs = TRY(m_rhs->generate_bytecode(generator, dst)).value();
 
-    generator.emit<Bytecode::Op::Mov>(dst, rhs);
+    generator.emit_mov(dst, rhs);
     generator.emit<Bytecode::Op::Jump>(Bytecode::Label { end_block });
     generator.switch_to_basic_block(end_block);
     return dst;
@@ -418,8 +418,8 @@ static Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> arguments_to_arr
     for (auto it = arguments.begin(); it != first_spread; ++it) {
         VERIFY(!it->is_spread);
         auto reg = generator.allocate_register();
-        auto value = TRY(it->value->generate_bytecode(generator)).value();
-        generator.emit<Bytecode::Op::Mov>(reg, value);
+        auto value = TRY(it->value->generate_bytecode(generator, reg)).value();
+        generator.emit_mov(reg, value);
         args.append(move(reg));
     }
 
@@ -497,7 +497,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> AssignmentExpression::g
                     if (expression.is_computed()) {
                         auto property = TRY(expression.property().generate_bytecode(generator)).value();
                         computed_property = generator.allocate_register();
-                        generator.emit<Bytecode::Op::Mov>(*computed_property, property);
+                        generator.emit_mov(*computed_property, property);
 
                         // To be continued later with PutByValue.
                     } else if (expression.property().is_identifier()) {
@@ -687,7 +687,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> AssignmentExpression::g
     case AssignmentOp::AndAssignment:
     case AssignmentOp::OrAssignment:
     case AssignmentOp::NullishAssignment:
-        generator.emit<Bytecode::Op::Mov>(dst, rhs);
+        generator.emit_mov(dst, rhs);
         break;
     default:
         return Bytecode::CodeGenerationError {
@@ -707,7 +707,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> AssignmentExpression::g
 
     if (lhs_block_ptr) {
         generator.switch_to_basic_block(*lhs_block_ptr);
-        generator.emit<Bytecode::Op::Mov>(dst, lhs);
+        generator.emit_mov(dst, lhs);
         generator.emit<Bytecode::Op::Jump>(Bytecode::Label { *end_block_ptr });
     }
 
@@ -803,8 +803,11 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> WhileStatement::generat
     auto& body_block = generator.make_block();
     auto& end_block = generator.make_block();
 
-    auto result = generator.allocate_register();
-    generator.emit<Bytecode::Op::Mov>(result, generator.add_constant(js_undefined()));
+    Optional<ScopedOperand> result;
+    if (generator.must_propagate_completion()) {
+        result = generator.allocate_register();
+        generator.emit_mov(*result, generator.add_constant(js_undefined()));
+    }
 
     generator.emit<Bytecode::Op::Jump>(Bytecode::Label { test_block });
 
@@ -823,8 +826,8 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> WhileStatement::generat
     generator.end_continuable_scope();
 
     if (!generator.is_current_block_terminated()) {
-        if (body.has_value())
-            generator.emit<Bytecode::Op::Mov>(result, body.value());
+        if (result.has_value() && body.has_value())
+            generator.emit_mov(*result, body.value());
         generator.emit<Bytecode::Op::Jump>(Bytecode::Label { test_block });
     }
 
@@ -852,8 +855,11 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> DoWhileStatement::gener
     auto& load_result_and_jump_to_end_block = generator.make_block();
     auto& end_block = generator.make_block();
 
-    auto completion_value = generator.allocate_register();
-    generator.emit<Bytecode::Op::Mov>(completion_value, generator.add_constant(js_undefined()));
+    Optional<ScopedOperand> completion_value;
+    if (generator.must_propagate_completion()) {
+        completion_value = generator.allocate_register();
+        generator.emit_mov(*completion_value, generator.add_constant(js_undefined()));
+    }
 
     // jump to the body block
     generator.emit<Bytecode::Op::Jump>(Bytecode::Label { body_block });
@@ -873,8 +879,8 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> DoWhileStatement::gener
     generator.end_continuable_scope();
 
     if (!generator.is_current_block_terminated()) {
-        if (body_result.has_value())
-            generator.emit<Bytecode::Op::Mov>(completion_value, body_result.value());
+        if (completion_value.has_value() && body_result.has_value())
+            generator.emit_mov(*completion_value, body_result.value());
         generator.emit<Bytecode::Op::Jump>(Bytecode::Label { test_block });
     }
 
@@ -1231,7 +1237,7 @@ static Bytecode::CodeGenerationErrorOr<void> generate_object_binding_pattern_byt
             if (has_rest) {
                 auto excluded_name = generator.allocate_register();
                 excluded_property_names.append(excluded_name);
-                generator.emit<Bytecode::Op::Mov>(excluded_name, property_name);
+                generator.emit_mov(excluded_name, property_name);
             }
 
             generator.emit<Bytecode::Op::GetByValue>(value, object, property_name);
@@ -1255,7 +1261,7 @@ static Bytecode::CodeGenerationErrorOr<void> generate_object_binding_pattern_byt
             } else {
                 default_value = TRY(initializer->generate_bytecode(generator)).value();
             }
-            generator.emit<Bytecode::Op::Mov>(value, *default_value);
+            generator.emit_mov(value, *default_value);
             generator.emit<Bytecode::Op::Jump>(Bytecode::Label { if_not_undefined_block });
 
             generator.switch_to_basic_block(if_not_undefined_block);
@@ -1264,7 +1270,7 @@ static Bytecode::CodeGenerationErrorOr<void> generate_object_binding_pattern_byt
         if (alias.has<NonnullRefPtr<BindingPattern const>>()) {
             auto& binding_pattern = *alias.get<NonnullRefPtr<BindingPattern const>>();
             auto nested_value = generator.allocate_register();
-            generator.emit<Bytecode::Op::Mov>(nested_value, value);
+            generator.emit_mov(nested_value, value);
             TRY(generate_binding_pattern_bytecode(generator, binding_pattern, initialization_mode, nested_value, create_variables));
         } else if (alias.has<Empty>()) {
             if (name.has<NonnullRefPtr<Expression const>>()) {
@@ -1316,7 +1322,7 @@ static Bytecode::CodeGenerationErrorOr<void> generate_array_binding_pattern_byte
      */
 
     auto is_iterator_exhausted = generator.allocate_register();
-    generator.emit<Bytecode::Op::Mov>(is_iterator_exhausted, generator.add_constant(Value(false)));
+    generator.emit_mov(is_iterator_exhausted, generator.add_constant(Value(false)));
 
     auto iterator = generator.allocate_register();
     generator.emit<Bytecode::Op::GetIterator>(iterator, input_array);
@@ -1418,7 +1424,7 @@ static Bytecode::CodeGenerationErrorOr<void> generate_array_binding_pattern_byte
 
         // The iterator is exhausted, so we just load undefined and continue binding
         generator.switch_to_basic_block(iterator_is_exhausted_block);
-        generator.emit<Bytecode::Op::Mov>(value, generator.add_constant(js_undefined()));
+        generator.emit_mov(value, generator.add_constant(js_undefined()));
         generator.emit<Bytecode::Op::Jump>(Bytecode::Label { create_binding_block });
 
         generator.switch_to_basic_block(create_binding_block);
@@ -1442,7 +1448,7 @@ static Bytecode::CodeGenerationErrorOr<void> generate_array_binding_pattern_byte
             } else {
                 default_value = TRY(initializer->generate_bytecode(generator)).value();
             }
-            generator.emit<Bytecode::Op::Mov>(value, *default_value);
+            generator.emit_mov(value, *default_value);
             generator.emit<Bytecode::Op::Jump>(Bytecode::Label { value_is_not_undefined_block });
 
             generator.switch_to_basic_block(value_is_not_undefined_block);
@@ -1657,7 +1663,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> CallExpression::generat
     auto callee = [&]() -> ScopedOperand {
         if (!original_callee->operand().is_register()) {
             auto callee = generator.allocate_register();
-            generator.emit<Bytecode::Op::Mov>(callee, *original_callee);
+            generator.emit_mov(callee, *original_callee);
             return callee;
         }
         return *original_callee;
@@ -1692,7 +1698,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> CallExpression::generat
                 argument_operands.append(argument_value);
             } else {
                 auto temporary = generator.allocate_register();
-                generator.emit<Bytecode::Op::Mov>(temporary, argument_value);
+                generator.emit_mov(temporary, argument_value);
                 argument_operands.append(temporary);
             }
         }
@@ -1805,7 +1811,7 @@ static void generate_yield(Bytecode::Generator& generator,
     generator.emit<Bytecode::Op::Yield>(Bytecode::Label { unwrap_yield_resumption_block }, argument);
     generator.switch_to_basic_block(unwrap_yield_resumption_block);
 
-    generator.emit<Bytecode::Op::Mov>(received_completion, generator.accumulator());
+    generator.emit_mov(received_completion, generator.accumulator());
     get_received_completion_type_and_value(generator, received_completion, received_completion_type, received_completion_value, type_identifier, value_identifier);
 
     // 27.6.3.7 AsyncGeneratorUnwrapYieldResumption ( resumptionValue ), https://tc39.es/ecma262/#sec-asyncgeneratorunwrapyieldresumption
@@ -1894,9 +1900,9 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> YieldExpression::genera
 
         // 6. Let received be NormalCompletion(undefined).
         // See get_received_completion_type_and_value above.
-        generator.emit<Bytecode::Op::Mov>(received_completion_type, generator.add_constant(Value(to_underlying(Completion::Type::Normal))));
+        generator.emit_mov(received_completion_type, generator.add_constant(Value(to_underlying(Completion::Type::Normal))));
 
-        generator.emit<Bytecode::Op::Mov>(received_completion_value, generator.add_constant(js_undefined()));
+        generator.emit_mov(received_completion_value, generator.add_constant(js_undefined()));
 
         // 7. Repeat,
         auto& loop_block = generator.make_block();
@@ -1931,7 +1937,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> YieldExpression::genera
         // ii. If generatorKind is async, set innerResult to ? Await(innerResult).
         if (generator.is_in_async_generator_function()) {
             auto new_inner_result = generate_await(generator, inner_result, received_completion, received_completion_type, received_completion_value, type_identifier, value_identifier);
-            generator.emit<Bytecode::Op::Mov>(inner_result, new_inner_result);
+            generator.emit_mov(inner_result, new_inner_result);
         }
 
         // iii. If innerResult is not an Object, throw a TypeError exception.
@@ -2022,7 +2028,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> YieldExpression::genera
         // 2. If generatorKind is async, set innerResult to ? Await(innerResult).
         if (generator.is_in_async_generator_function()) {
             auto new_result = generate_await(generator, inner_result, received_completion, received_completion_type, received_completion_value, type_identifier, value_identifier);
-            generator.emit<Bytecode::Op::Mov>(inner_result, new_result);
+            generator.emit_mov(inner_result, new_result);
         }
 
         // 3. NOTE: Exceptions from the inner iterator throw method are propagated. Normal completions from an inner throw method are processed similarly to an inner next.
@@ -2120,7 +2126,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> YieldExpression::genera
         // v. If generatorKind is async, set innerReturnResult to ? Await(innerReturnResult).
         if (generator.is_in_async_generator_function()) {
             auto new_value = generate_await(generator, inner_return_result, received_completion, received_completion_type, received_completion_value, type_identifier, value_identifier);
-            generator.emit<Bytecode::Op::Mov>(inner_return_result, new_value);
+            generator.emit_mov(inner_return_result, new_value);
         }
 
         // vi. If innerReturnResult is not an Object, throw a TypeError exception.
@@ -2163,7 +2169,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> YieldExpression::genera
         if (is_in_finalizer)
             generator.emit<Bytecode::Op::Mov>(Bytecode::Operand(Bytecode::Register::exception()), Bytecode::Operand(*saved_exception));
 
-        generator.emit<Bytecode::Op::Mov>(received_completion, generator.accumulator());
+        generator.emit_mov(received_completion, generator.accumulator());
         get_received_completion_type_and_value(generator, received_completion, received_completion_type, received_completion_value, type_identifier, value_identifier);
         generator.emit<Bytecode::Op::Jump>(Bytecode::Label { loop_block });
 
@@ -2190,7 +2196,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> YieldExpression::genera
     if (is_in_finalizer)
         generator.emit<Bytecode::Op::Mov>(Bytecode::Operand(Bytecode::Register::exception()), Bytecode::Operand(*saved_exception));
 
-    generator.emit<Bytecode::Op::Mov>(received_completion, generator.accumulator());
+    generator.emit_mov(received_completion, generator.accumulator());
 
     get_received_completion_type_and_value(generator, received_completion, received_completion_type, received_completion_value, type_identifier, value_identifier);
 
@@ -2250,8 +2256,11 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> IfStatement::generate_b
     auto& false_block = generator.make_block();
     auto& end_block = generator.make_block();
 
-    auto dst = choose_dst(generator, preferred_dst);
-    generator.emit<Bytecode::Op::Mov>(dst, generator.add_constant(js_undefined()));
+    Optional<ScopedOperand> dst;
+    if (generator.must_propagate_completion()) {
+        dst = choose_dst(generator, preferred_dst);
+        generator.emit_mov(*dst, generator.add_constant(js_undefined()));
+    }
 
     auto predicate = TRY(m_predicate->generate_bytecode(generator)).value();
     generator.emit_jump_if(
@@ -2262,8 +2271,8 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> IfStatement::generate_b
     generator.switch_to_basic_block(true_block);
     auto consequent = TRY(m_consequent->generate_bytecode(generator, dst));
     if (!generator.is_current_block_terminated()) {
-        if (consequent.has_value())
-            generator.emit<Bytecode::Op::Mov>(dst, *consequent);
+        if (dst.has_value() && consequent.has_value())
+            generator.emit_mov(*dst, *consequent);
         generator.emit<Bytecode::Op::Jump>(Bytecode::Label { end_block });
     }
 
@@ -2274,8 +2283,8 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> IfStatement::generate_b
         alternate = TRY(m_alternate->generate_bytecode(generator, dst));
     }
     if (!generator.is_current_block_terminated()) {
-        if (alternate.has_value())
-            generator.emit<Bytecode::Op::Mov>(dst, *alternate);
+        if (dst.has_value() && alternate.has_value())
+            generator.emit_mov(*dst, *alternate);
         generator.emit<Bytecode::Op::Jump>(Bytecode::Label { end_block });
     }
 
@@ -2325,14 +2334,14 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> ConditionalExpression::
     auto dst = choose_dst(generator, preferred_dst);
 
     generator.switch_to_basic_block(true_block);
-    auto consequent = TRY(m_consequent->generate_bytecode(generator)).value();
-    generator.emit<Bytecode::Op::Mov>(dst, consequent);
+    auto consequent = TRY(m_consequent->generate_bytecode(generator, dst)).value();
+    generator.emit_mov(dst, consequent);
 
     generator.emit<Bytecode::Op::Jump>(Bytecode::Label { end_block });
 
     generator.switch_to_basic_block(false_block);
-    auto alternate = TRY(m_alternate->generate_bytecode(generator)).value();
-    generator.emit<Bytecode::Op::Mov>(dst, alternate);
+    auto alternate = TRY(m_alternate->generate_bytecode(generator, dst)).value();
+    generator.emit_mov(dst, alternate);
     generator.emit<Bytecode::Op::Jump>(Bytecode::Label { end_block });
 
     generator.switch_to_basic_block(end_block);
@@ -2359,7 +2368,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> TemplateLiteral::genera
     for (size_t i = 0; i < m_expressions.size(); i++) {
         auto value = TRY(m_expressions[i]->generate_bytecode(generator)).value();
         if (i == 0) {
-            generator.emit<Bytecode::Op::Mov>(dst, value);
+            generator.emit_mov(dst, value);
         } else {
             generator.emit<Bytecode::Op::ConcatString>(dst, value);
         }
@@ -2390,10 +2399,10 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> TaggedTemplateLiteral::
         //       12.9.6.1 Static Semantics: TV, https://tc39.es/ecma262/#sec-static-semantics-tv
         auto string_reg = generator.allocate_register();
         if (is<NullLiteral>(expressions[i])) {
-            generator.emit<Bytecode::Op::Mov>(string_reg, generator.add_constant(js_undefined()));
+            generator.emit_mov(string_reg, generator.add_constant(js_undefined()));
         } else {
             auto value = TRY(expressions[i]->generate_bytecode(generator)).value();
-            generator.emit<Bytecode::Op::Mov>(string_reg, value);
+            generator.emit_mov(string_reg, value);
         }
         string_regs.append(move(string_reg));
     }
@@ -2410,8 +2419,8 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> TaggedTemplateLiteral::
 
     for (size_t i = 1; i < expressions.size(); i += 2) {
         auto string_reg = generator.allocate_register();
-        auto string = TRY(expressions[i]->generate_bytecode(generator)).value();
-        generator.emit<Bytecode::Op::Mov>(string_reg, string);
+        auto string = TRY(expressions[i]->generate_bytecode(generator, string_reg)).value();
+        generator.emit_mov(string_reg, string);
         argument_regs.append(move(string_reg));
     }
 
@@ -2420,7 +2429,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> TaggedTemplateLiteral::
     for (auto& raw_string : m_template_literal->raw_strings()) {
         auto value = TRY(raw_string->generate_bytecode(generator)).value();
         auto raw_string_reg = generator.allocate_register();
-        generator.emit<Bytecode::Op::Mov>(raw_string_reg, value);
+        generator.emit_mov(raw_string_reg, value);
         raw_string_regs.append(move(raw_string_reg));
     }
 
@@ -2568,9 +2577,9 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> TryStatement::generate_
             }));
 
         auto handler_result = TRY(m_handler->body().generate_bytecode(generator));
-        if (handler_result.has_value() && !generator.is_current_block_terminated()) {
+        if (generator.must_propagate_completion() && handler_result.has_value() && !generator.is_current_block_terminated()) {
             dst = generator.allocate_register();
-            generator.emit<Bytecode::Op::Mov>(*dst, *handler_result);
+            generator.emit_mov(*dst, *handler_result);
         }
         handler_target = Bytecode::Label { handler_block };
 
@@ -2612,9 +2621,9 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> TryStatement::generate_
     generator.switch_to_basic_block(target_block);
     auto block_result = TRY(m_block->generate_bytecode(generator));
     if (!generator.is_current_block_terminated()) {
-        if (block_result.has_value()) {
+        if (generator.must_propagate_completion() && block_result.has_value()) {
             dst = generator.allocate_register();
-            generator.emit<Bytecode::Op::Mov>(*dst, *block_result);
+            generator.emit_mov(*dst, *block_result);
         }
 
         if (m_finalizer) {
@@ -2649,8 +2658,11 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> SwitchStatement::genera
 {
     Bytecode::Generator::SourceLocationScope scope(generator, *this);
 
-    auto dst = generator.allocate_register();
-    generator.emit<Bytecode::Op::Mov>(dst, generator.add_constant(js_undefined()));
+    Optional<ScopedOperand> dst;
+    if (generator.must_propagate_completion()) {
+        dst = generator.allocate_register();
+        generator.emit_mov(*dst, generator.add_constant(js_undefined()));
+    }
 
     auto discriminant = TRY(m_discriminant->generate_bytecode(generator)).value();
     Vector<Bytecode::BasicBlock&> case_blocks;
@@ -2703,10 +2715,12 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> SwitchStatement::genera
             auto result = TRY(statement->generate_bytecode(generator));
             if (generator.is_current_block_terminated())
                 break;
+            if (!dst.has_value())
+                continue;
             if (result.has_value())
-                generator.emit<Bytecode::Op::Mov>(dst, *result);
+                generator.emit_mov(*dst, *result);
             else
-                generator.emit<Bytecode::Op::Mov>(dst, generator.add_constant(js_undefined()));
+                generator.emit_mov(*dst, generator.add_constant(js_undefined()));
         }
         if (!generator.is_current_block_terminated()) {
             auto next_block = current_block;
@@ -2803,7 +2817,7 @@ static ScopedOperand generate_await(
     // FIXME: It's really magical that we can just assume that the completion value is in register 0.
     //        It ends up there because we "return" from the Await instruction above via the synthetic
     //        generator function that actually drives async execution.
-    generator.emit<Bytecode::Op::Mov>(received_completion, generator.accumulator());
+    generator.emit_mov(received_completion, generator.accumulator());
     get_received_completion_type_and_value(generator, received_completion, received_completion_type, received_completion_value, type_identifier, value_identifier);
 
     auto& normal_completion_continuation_block = generator.make_block();
@@ -2838,7 +2852,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> AwaitExpression::genera
     auto received_completion_type = generator.allocate_register();
     auto received_completion_value = generator.allocate_register();
 
-    generator.emit<Bytecode::Op::Mov>(received_completion, generator.accumulator());
+    generator.emit_mov(received_completion, generator.accumulator());
 
     auto type_identifier = generator.intern_identifier("type");
     auto value_identifier = generator.intern_identifier("value");
@@ -3003,8 +3017,11 @@ static Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> for_in_of_body_e
     bool has_lexical_binding = false;
 
     // 3. Let V be undefined.
-    auto completion_value = generator.allocate_register();
-    generator.emit<Bytecode::Op::Mov>(completion_value, generator.add_constant(js_undefined()));
+    Optional<ScopedOperand> completion_value;
+    if (generator.must_propagate_completion()) {
+        completion_value = generator.allocate_register();
+        generator.emit_mov(*completion_value, generator.add_constant(js_undefined()));
+    }
 
     // 4. Let destructuring be IsDestructuring of lhs.
     auto destructuring = head_result.is_destructuring;
@@ -3037,9 +3054,9 @@ static Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> for_in_of_body_e
         auto type_identifier = generator.intern_identifier("type");
         auto value_identifier = generator.intern_identifier("value");
 
-        generator.emit<Bytecode::Op::Mov>(received_completion, generator.accumulator());
+        generator.emit_mov(received_completion, generator.accumulator());
         auto new_result = generate_await(generator, next_result, received_completion, received_completion_type, received_completion_value, type_identifier, value_identifier);
-        generator.emit<Bytecode::Op::Mov>(next_result, new_result);
+        generator.emit_mov(next_result, new_result);
     }
 
     // c. If Type(nextResult) is not Object, throw a TypeError exception.
@@ -3207,8 +3224,8 @@ static Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> for_in_of_body_e
 
     // The body can contain an unconditional block terminator (e.g. return, throw), so we have to check for that before generating the Jump.
     if (!generator.is_current_block_terminated()) {
-        if (result.has_value())
-            generator.emit<Bytecode::Op::Mov>(completion_value, *result);
+        if (completion_value.has_value() && result.has_value())
+            generator.emit_mov(*completion_value, *result);
 
         generator.emit<Bytecode::Op::Jump>(Bytecode::Label { loop_update });
     }
@@ -3304,7 +3321,7 @@ static Bytecode::CodeGenerationErrorOr<void> generate_optional_chain(Bytecode::G
         auto& member_expression = static_cast<MemberExpression const&>(optional_chain.base());
         auto base_and_value = TRY(get_base_and_value_from_member_expression(generator, member_expression));
         new_current_value = base_and_value.value;
-        generator.emit<Bytecode::Op::Mov>(current_base, base_and_value.base);
+        generator.emit_mov(current_base, base_and_value.base);
     } else if (is<OptionalChain>(optional_chain.base())) {
         auto& sub_optional_chain = static_cast<OptionalChain const&>(optional_chain.base());
         TRY(generate_optional_chain(generator, sub_optional_chain, current_value, current_base));
@@ -3313,7 +3330,7 @@ static Bytecode::CodeGenerationErrorOr<void> generate_optional_chain(Bytecode::G
         new_current_value = TRY(optional_chain.base().generate_bytecode(generator)).value();
     }
 
-    generator.emit<Bytecode::Op::Mov>(current_value, *new_current_value);
+    generator.emit_mov(current_value, *new_current_value);
 
     auto& load_undefined_and_jump_to_end_block = generator.make_block();
     auto& end_block = generator.make_block();
@@ -3333,22 +3350,22 @@ static Bytecode::CodeGenerationErrorOr<void> generate_optional_chain(Bytecode::G
             [&](OptionalChain::Call const& call) -> Bytecode::CodeGenerationErrorOr<void> {
                 auto arguments = TRY(arguments_to_array_for_call(generator, call.arguments)).value();
                 generator.emit<Bytecode::Op::CallWithArgumentArray>(Bytecode::Op::CallType::Call, current_value, current_value, current_base, arguments);
-                generator.emit<Bytecode::Op::Mov>(current_base, generator.add_constant(js_undefined()));
+                generator.emit_mov(current_base, generator.add_constant(js_undefined()));
                 return {};
             },
             [&](OptionalChain::ComputedReference const& ref) -> Bytecode::CodeGenerationErrorOr<void> {
-                generator.emit<Bytecode::Op::Mov>(current_base, current_value);
+                generator.emit_mov(current_base, current_value);
                 auto property = TRY(ref.expression->generate_bytecode(generator)).value();
                 generator.emit<Bytecode::Op::GetByValue>(current_value, current_value, property);
                 return {};
             },
             [&](OptionalChain::MemberReference const& ref) -> Bytecode::CodeGenerationErrorOr<void> {
-                generator.emit<Bytecode::Op::Mov>(current_base, current_value);
+                generator.emit_mov(current_base, current_value);
                 generator.emit_get_by_id(current_value, current_value, generator.intern_identifier(ref.identifier->string()));
                 return {};
             },
             [&](OptionalChain::PrivateMemberReference const& ref) -> Bytecode::CodeGenerationErrorOr<void> {
-                generator.emit<Bytecode::Op::Mov>(current_base, current_value);
+                generator.emit_mov(current_base, current_value);
                 generator.emit<Bytecode::Op::GetPrivateById>(current_value, current_value, generator.intern_identifier(ref.private_identifier->string()));
 
                 return {};
@@ -3358,7 +3375,7 @@ static Bytecode::CodeGenerationErrorOr<void> generate_optional_chain(Bytecode::G
     generator.emit<Bytecode::Op::Jump>(Bytecode::Label { end_block });
 
     generator.switch_to_basic_block(load_undefined_and_jump_to_end_block);
-    generator.emit<Bytecode::Op::Mov>(current_value, generator.add_constant(js_undefined()));
+    generator.emit_mov(current_value, generator.add_constant(js_undefined()));
     generator.emit<Bytecode::Op::Jump>(Bytecode::Label { end_block });
 
     generator.switch_to_basic_block(end_block);
@@ -3370,7 +3387,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> OptionalChain::generate
     Bytecode::Generator::SourceLocationScope scope(generator, *this);
     auto current_base = generator.allocate_register();
     auto current_value = choose_dst(generator, preferred_dst);
-    generator.emit<Bytecode::Op::Mov>(current_base, generator.add_constant(js_undefined()));
+    generator.emit_mov(current_base, generator.add_constant(js_undefined()));
     TRY(generate_optional_chain(generator, *this, current_value, current_base));
     return current_value;
 }
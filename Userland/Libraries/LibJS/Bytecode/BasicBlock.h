@@ -58,6 +58,13 @@ public:
     auto const& source_map() const { return m_source_map; }
     void add_source_map_entry(size_t bytecode_offset, SourceRecord const& source_record) { m_source_map.set(bytecode_offset, source_record); }
 
+    // Replaces the contents of a block once it has been generated, for optimizations that rewrite its instructions.
+    void set_instructions(Badge<Generator>, Vector<u8> buffer, HashMap<size_t, SourceRecord> source_map)
+    {
+        m_buffer = move(buffer);
+        m_source_map = move(source_map);
+    }
+
     auto const& this_() const { return m_this; }
     void set_this(ScopedOperand operand) { m_this = operand; }
 
@@ -16,12 +16,49 @@
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/ObjectEnvironment.h>
+#include <LibJS/Runtime/Realm.h>
 #include <LibJS/Runtime/RegExpObject.h>
 #include <LibJS/Runtime/TypedArray.h>
 #include <LibJS/Runtime/ValueInlines.h>
 
 namespace JS::Bytecode {
 
+ALWAYS_INLINE ThrowCompletionOr<Value> loosely_inequals(VM& vm, Value src1, Value src2)
+{
+    if (src1.tag() == src2.tag()) {
+        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
+            return Value(src1.encoded() != src2.encoded());
+    }
+    return Value(!TRY(is_loosely_equal(vm, src1, src2)));
+}
+
+ALWAYS_INLINE ThrowCompletionOr<Value> loosely_equals(VM& vm, Value src1, Value src2)
+{
+    if (src1.tag() == src2.tag()) {
+        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
+            return Value(src1.encoded() == src2.encoded());
+    }
+    return Value(TRY(is_loosely_equal(vm, src1, src2)));
+}
+
+ALWAYS_INLINE ThrowCompletionOr<Value> strict_inequals(VM&, Value src1, Value src2)
+{
+    if (src1.tag() == src2.tag()) {
+        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
+            return Value(src1.encoded() != src2.encoded());
+    }
+    return Value(!is_strictly_equal(src1, src2));
+}
+
+ALWAYS_INLINE ThrowCompletionOr<Value> strict_equals(VM&, Value src1, Value src2)
+{
+    if (src1.tag() == src2.tag()) {
+        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
+            return Value(src1.encoded() == src2.encoded());
+    }
+    return Value(is_strictly_equal(src1, src2));
+}
+
 // NOTE: This function assumes that the index is valid within the TypedArray,
 //       and that the TypedArray is not detached.
 template<typename T>
@@ -103,6 +140,43 @@ ALWAYS_INLINE ThrowCompletionOr<NonnullGCPtr<Object>> base_object_for_get(VM& vm
     return throw_null_or_undefined_property_access(vm, base_value, base_identifier, property_identifier);
 }
 
+// Returns the cached value if `entry` was filled in for `shape` and is still valid.
+ALWAYS_INLINE Optional<Value> try_get_from_property_lookup_cache(PropertyLookupCache::Entry const& entry, Object const& object, Shape const& shape)
+{
+    if (&shape != entry.shape)
+        return {};
+    if (!entry.prototype) {
+        // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
+        return object.get_direct(entry.property_offset.value());
+    }
+    // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
+    if (!entry.prototype_chain_validity || !entry.prototype_chain_validity->is_valid())
+        return {};
+    return entry.prototype->get_direct(entry.property_offset.value());
+}
+
+// Picks the entry a lookup for `shape` should be cached in: an entry that already belongs to `shape`,
+// otherwise the first one whose shape is gone. Once all entries are taken by other shapes, the
+// call site becomes megamorphic and further shapes go into the interpreter-wide cache instead.
+inline PropertyLookupCache::Entry& property_lookup_cache_entry_for_update(MegamorphicPropertyLookupCache& megamorphic_cache, PropertyLookupCache& cache, Shape const& shape, DeprecatedFlyString const& property_name)
+{
+    if (!cache.is_megamorphic) {
+        for (auto& entry : cache.entries) {
+            if (&shape == entry.shape)
+                return entry;
+        }
+        for (auto& entry : cache.entries) {
+            if (!entry.shape)
+                return entry;
+        }
+        cache.is_megamorphic = true;
+    }
+
+    auto& entry = megamorphic_cache.entry_for(shape, property_name);
+    entry.property_name = property_name;
+    return entry;
+}
+
 inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<DeprecatedFlyString const&> const& base_identifier, DeprecatedFlyString const& property, Value base_value, Value this_value, PropertyLookupCache& cache)
 {
     if (base_value.is_string()) {
@@ -115,42 +189,42 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<DeprecatedFlyString c
 
     // OPTIMIZATION: Fast path for the magical "length" property on Array objects.
     if (base_obj->has_magical_length_property() && property == vm.names.length.as_string()) {
-        return Value { base_obj->indexed_properties().array_like_size() };
+        return Value { static_cast<Object const&>(*base_obj).indexed_properties().array_like_size() };
     }
 
     auto& shape = base_obj->shape();
 
-    if (cache.prototype) {
-        // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
-        bool can_use_cache = [&]() -> bool {
-            if (&shape != cache.shape)
-                return false;
-            if (!cache.prototype_chain_validity)
-                return false;
-            if (!cache.prototype_chain_validity->is_valid())
-                return false;
-            return true;
-        }();
-        if (can_use_cache)
-            return cache.prototype->get_direct(cache.property_offset.value());
-    } else if (&shape == cache.shape) {
-        // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
-        return base_obj->get_direct(cache.property_offset.value());
+    for (auto& entry : cache.entries) {
+        if (auto value = try_get_from_property_lookup_cache(entry, *base_obj, shape); value.has_value()) {
+            cache.record_hit();
+            return *value;
+        }
     }
 
+    if (cache.is_megamorphic) {
+        auto& entry = vm.bytecode_interpreter().megamorphic_get_cache().entry_for(shape, property);
+        if (entry.property_name == property) {
+            if (auto value = try_get_from_property_lookup_cache(entry, *base_obj, shape); value.has_value()) {
+                cache.record_hit();
+                return *value;
+            }
+        }
+    }
+
+    cache.record_miss();
+
     CacheablePropertyMetadata cacheable_metadata;
     auto value = TRY(base_obj->internal_get(property, this_value, &cacheable_metadata));
 
-    if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache = {};
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
-    } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-        cache = {};
-        cache.shape = &base_obj->shape();
-        cache.property_offset = cacheable_metadata.property_offset.value();
-        cache.prototype = *cacheable_metadata.prototype;
-        cache.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+    if (cacheable_metadata.type != CacheablePropertyMetadata::Type::NotCacheable) {
+        auto& entry = property_lookup_cache_entry_for_update(vm.bytecode_interpreter().megamorphic_get_cache(), cache, shape, property);
+        entry = {};
+        entry.shape = shape;
+        entry.property_offset = cacheable_metadata.property_offset.value();
+        if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
+            entry.prototype = *cacheable_metadata.prototype;
+            entry.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+        }
     }
 
     return value;
@@ -163,7 +237,7 @@ inline ThrowCompletionOr<Value> get_by_value(VM& vm, Optional<DeprecatedFlyStrin
         auto& object = base_value.as_object();
         auto index = static_cast<u32>(property_key_value.as_i32());
 
-        auto const* object_storage = object.indexed_properties().storage();
+        auto const* object_storage = static_cast<Object const&>(object).indexed_properties().storage();
 
         // For "non-typed arrays":
         if (!object.may_interfere_with_indexed_property_access()
@@ -306,17 +380,36 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         break;
     }
     case Op::PropertyKind::KeyValue: {
-        if (cache && cache->shape == &object->shape()) {
-            object->put_direct(*cache->property_offset, value);
-            return {};
+        if (cache) {
+            // OPTIMIZATION: If the object has a shape we've seen before, we can store directly into the cached property offset.
+            auto& shape = object->shape();
+            for (auto& entry : cache->entries) {
+                if (&shape == entry.shape && !entry.prototype) {
+                    cache->record_hit();
+                    object->put_direct(*entry.property_offset, value);
+                    return {};
+                }
+            }
+            if (cache->is_megamorphic && name.is_string()) {
+                auto& entry = vm.bytecode_interpreter().megamorphic_put_cache().entry_for(shape, name.as_string());
+                if (&shape == entry.shape && !entry.prototype && entry.property_name == name.as_string()) {
+                    cache->record_hit();
+                    object->put_direct(*entry.property_offset, value);
+                    return {};
+                }
+            }
+            cache->record_miss();
         }
 
         CacheablePropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
-        if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache->shape = object->shape();
-            cache->property_offset = cacheable_metadata.property_offset.value();
+        if (succeeded && cache && name.is_string() && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
+            auto& shape = object->shape();
+            auto& entry = property_lookup_cache_entry_for_update(vm.bytecode_interpreter().megamorphic_put_cache(), *cache, shape, name.as_string());
+            entry = {};
+            entry.shape = shape;
+            entry.property_offset = cacheable_metadata.property_offset.value();
         }
 
         if (!succeeded && vm.in_strict_mode()) {
@@ -441,6 +534,22 @@ inline Value new_function(VM& vm, FunctionExpression const& function_node, Optio
     return value;
 }
 
+// OPTIMIZATION: Storing to the element right past the end of an array only has to grow it, as long as the array
+//               can grow and there is nothing on its prototype chain that could intercept the store.
+inline bool can_append_to_array_without_side_effects(Object& object)
+{
+    if (!is<Array>(object) || !static_cast<Array&>(object).length_is_writable() || !MUST(object.is_extensible()))
+        return false;
+
+    auto& intrinsics = object.shape().realm().intrinsics();
+    auto* array_prototype = object.shape().prototype();
+    if (array_prototype != intrinsics.array_prototype() || !static_cast<Object const*>(array_prototype)->indexed_properties().is_empty())
+        return false;
+
+    auto* object_prototype = array_prototype->shape().prototype();
+    return object_prototype == intrinsics.object_prototype() && static_cast<Object const*>(object_prototype)->indexed_properties().is_empty();
+}
+
 inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<DeprecatedFlyString const&> const& base_identifier, Value property_key_value, Value value, Op::PropertyKind kind)
 {
     // OPTIMIZATION: Fast path for simple Int32 indexes in array-like objects.
@@ -454,14 +563,19 @@ inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<Depreca
         if (storage
             && storage->is_simple_storage()
             && !object.may_interfere_with_indexed_property_access()) {
-            auto maybe_value = storage->get(index);
+            auto& simple_storage = static_cast<SimpleIndexedPropertyStorage&>(*storage);
+            auto maybe_value = simple_storage.inline_get(index);
             if (maybe_value.has_value()) {
                 auto existing_value = maybe_value->value;
                 if (!existing_value.is_accessor()) {
-                    storage->put(index, value);
+                    simple_storage.put(index, value);
                     return {};
                 }
             }
+            if (index == simple_storage.array_like_size() && can_append_to_array_without_side_effects(object)) {
+                simple_storage.put(index, value);
+                return {};
+            }
         }
 
         // For typed arrays:
@@ -625,7 +739,7 @@ inline MarkedVector<Value> argument_list_evaluation(VM& vm, Value arguments)
     //       visible to the user
     MarkedVector<Value> argument_values { vm.heap() };
 
-    auto& argument_array = arguments.as_array();
+    auto const& argument_array = arguments.as_array();
     auto array_length = argument_array.indexed_properties().array_like_size();
 
     argument_values.ensure_capacity(array_length);
@@ -7,7 +7,11 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/SourceCode.h>
 
 namespace JS::Bytecode {
@@ -40,7 +44,11 @@ Executable::Executable(
     environment_variable_caches.resize(number_of_environment_variable_caches);
 }
 
-Executable::~Executable() = default;
+Executable::~Executable()
+{
+    if (g_dump_property_lookup_cache_statistics)
+        dump_property_lookup_cache_statistics();
+}
 
 void Executable::dump() const
 {
@@ -85,6 +93,64 @@ void Executable::dump() const
     warnln("");
 }
 
+void Executable::dump_property_lookup_cache_statistics() const
+{
+    auto dump_cache = [&](size_t offset, StringView op_name, IdentifierTableIndex property, u32 cache_index) {
+        auto const& cache = property_lookup_caches[cache_index];
+
+        size_t entries_in_use = 0;
+        for (auto const& entry : cache.entries) {
+            if (entry.property_offset.has_value())
+                ++entries_in_use;
+        }
+        if (entries_in_use == 0 && cache.hit_count == 0 && cache.miss_count == 0)
+            return;
+
+        if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG) {
+            warnln("[{:4x}] {} {}: {} hits, {} misses, {}/{} entries in use{}",
+                offset,
+                op_name,
+                get_identifier(property),
+                cache.hit_count,
+                cache.miss_count,
+                entries_in_use,
+                cache.entries.size(),
+                cache.is_megamorphic ? ", megamorphic"sv : ""sv);
+        } else {
+            warnln("[{:4x}] {} {}: {}/{} entries in use{}",
+                offset,
+                op_name,
+                get_identifier(property),
+                entries_in_use,
+                cache.entries.size(),
+                cache.is_megamorphic ? ", megamorphic"sv : ""sv);
+        }
+    };
+
+    warnln("\033[37;1mProperty lookup caches\033[0m for \"{}\"", name);
+
+    for (InstructionStreamIterator it(bytecode, this); !it.at_end(); ++it) {
+        auto const& instruction = *it;
+        switch (instruction.type()) {
+#define __JS_DUMP_PROPERTY_LOOKUP_CACHE(op_TitleCase)                                \
+    case Instruction::Type::op_TitleCase: {                                          \
+        auto const& op = static_cast<Op::op_TitleCase const&>(instruction);          \
+        dump_cache(it.offset(), #op_TitleCase##sv, op.property(), op.cache_index()); \
+        break;                                                                       \
+    }
+            __JS_DUMP_PROPERTY_LOOKUP_CACHE(GetById)
+            __JS_DUMP_PROPERTY_LOOKUP_CACHE(GetByIdWithThis)
+            __JS_DUMP_PROPERTY_LOOKUP_CACHE(PutById)
+            __JS_DUMP_PROPERTY_LOOKUP_CACHE(PutByIdWithThis)
+#undef __JS_DUMP_PROPERTY_LOOKUP_CACHE
+        default:
+            break;
+        }
+    }
+
+    warnln("");
+}
+
 void Executable::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
@@ -116,4 +182,21 @@ UnrealizedSourceRange Executable::source_range_at(size_t offset) const
     };
 }
 
+JIT::NativeExecutable const* Executable::get_or_create_native_executable()
+{
+    if (m_native_executable)
+        return m_native_executable;
+
+    if (m_did_try_jitting || !JIT::Compiler::is_enabled())
+        return nullptr;
+
+    // OPTIMIZATION: Only spend time on native code generation for executables that have proven to be hot.
+    if (++m_execution_count < JIT::Compiler::hot_executable_threshold)
+        return nullptr;
+
+    m_did_try_jitting = true;
+    m_native_executable = JIT::Compiler::compile(*this);
+    return m_native_executable;
+}
+
 }
@@ -6,7 +6,10 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Debug.h>
 #include <AK/DeprecatedFlyString.h>
+#include <AK/HashFunctions.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
@@ -23,16 +26,62 @@
 namespace JS::Bytecode {
 
 struct PropertyLookupCache {
-    WeakPtr<Shape> shape;
-    Optional<u32> property_offset;
-    WeakPtr<Object> prototype;
-    WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    // Each call site remembers up to this many shapes before it gives up and goes megamorphic.
+    static constexpr size_t max_number_of_shapes_to_remember = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        WeakPtr<Object> prototype;
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    };
+    AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+
+    // Set once a call site has seen more shapes than fit in `entries`.
+    // From then on, misses are looked up in (and fill) the interpreter's MegamorphicPropertyLookupCache.
+    bool is_megamorphic { false };
+
+    // Only counted with JS_PROPERTY_LOOKUP_CACHE_DEBUG, to keep the hot paths free of the extra stores.
+    u32 hit_count { 0 };
+    u32 miss_count { 0 };
+
+    void record_hit()
+    {
+        if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+            ++hit_count;
+    }
+
+    void record_miss()
+    {
+        if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+            ++miss_count;
+    }
 };
 
-struct GlobalVariableCache : public PropertyLookupCache {
+// Global variables always live on the same global object, so a single shape is all there is to remember.
+struct GlobalVariableCache : public PropertyLookupCache::Entry {
     u64 environment_serial_number { 0 };
 };
 
+// A direct-mapped cache keyed on (shape, property name), shared by all megamorphic call sites.
+// Colliding insertions simply evict whatever was there before.
+class MegamorphicPropertyLookupCache {
+public:
+    struct Entry : public PropertyLookupCache::Entry {
+        DeprecatedFlyString property_name;
+    };
+
+    Entry& entry_for(Shape const& shape, DeprecatedFlyString const& property_name)
+    {
+        auto hash = pair_int_hash(ptr_hash(&shape), property_name.hash());
+        return m_entries[hash % number_of_entries];
+    }
+
+private:
+    static constexpr size_t number_of_entries = 1024;
+    AK::Array<Entry, number_of_entries> m_entries;
+};
+
 using EnvironmentVariableCache = Optional<EnvironmentCoordinate>;
 
 struct SourceRecord {
@@ -43,6 +92,7 @@ struct SourceRecord {
 class Executable final : public Cell {
     JS_CELL(Executable, Cell);
     JS_DECLARE_ALLOCATOR(Executable);
+    JS_CELL_HAS_WRITE_BARRIERS(Executable);
 
 public:
     Executable(
@@ -101,9 +151,17 @@ public:
     [[nodiscard]] UnrealizedSourceRange source_range_at(size_t offset) const;
 
     void dump() const;
+    void dump_property_lookup_cache_statistics() const;
+
+    JIT::NativeExecutable const* get_or_create_native_executable();
+    JIT::NativeExecutable const* native_executable() const { return m_native_executable; }
 
 private:
     virtual void visit_edges(Visitor&) override;
+
+    OwnPtr<JIT::NativeExecutable> m_native_executable;
+    u32 m_execution_count { 0 };
+    bool m_did_try_jitting { false };
 };
 
 }
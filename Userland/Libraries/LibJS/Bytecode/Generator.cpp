@@ -40,6 +40,8 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::generate(VM& vm, ASTN
     generator.switch_to_basic_block(generator.make_block());
     SourceLocationScope scope(generator, node);
     generator.m_enclosing_function_kind = enclosing_function_kind;
+    // NOTE: The completion value of a function body is never observable, so there's no need to keep track of it.
+    generator.m_must_propagate_completion = !is<FunctionBody>(node);
     if (generator.is_in_generator_or_async_function()) {
         // Immediately yield with no value.
         auto& start_block = generator.make_block();
@@ -75,6 +77,42 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::generate(VM& vm, ASTN
     else if (is<FunctionExpression>(node))
         is_strict_mode = static_cast<FunctionExpression const&>(node).is_strict_mode();
 
+    generator.propagate_copies_and_eliminate_dead_stores();
+    generator.fuse_superinstructions();
+
+    // OPTIMIZATION: Blocks that contain nothing but a jump are only there for the convenience of the code generator.
+    //               Point every label directly at the end of such jump chains, so we don't pay for the extra dispatch.
+    auto final_jump_target = [&](size_t block_index) {
+        // NOTE: The step limit guards against cycles of empty blocks, like the one generated for `for (;;) {}`.
+        for (size_t step = 0; step < 8; ++step) {
+            auto const& block = *generator.m_root_basic_blocks[block_index];
+            if (block.size() != sizeof(Op::Jump))
+                break;
+            auto const& instruction = *reinterpret_cast<Instruction const*>(block.data());
+            if (instruction.type() != Instruction::Type::Jump)
+                break;
+            block_index = static_cast<Op::Jump const&>(instruction).target().basic_block_index();
+        }
+        return block_index;
+    };
+    for (auto& block : generator.m_root_basic_blocks) {
+        Bytecode::InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) {
+                label = Label { static_cast<u32>(final_jump_target(label.basic_block_index())) };
+            });
+            ++it;
+        }
+    }
+
+    // NOTE: Falling through into a block that only contains a jump ends up at the target of that jump.
+    auto falls_through_to = [&](BasicBlock const& block, Label const& target) {
+        if (block.index() + 1 >= generator.m_root_basic_blocks.size())
+            return false;
+        return final_jump_target(block.index() + 1) == target.basic_block_index();
+    };
+
     size_t size_needed = 0;
     for (auto& block : generator.m_root_basic_blocks) {
         size_needed += block->size();
@@ -123,7 +161,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::generate(VM& vm, ASTN
             // OPTIMIZATION: Don't emit jumps that just jump to the next block.
             if (instruction.type() == Instruction::Type::Jump) {
                 auto& jump = static_cast<Bytecode::Op::Jump&>(instruction);
-                if (jump.target().basic_block_index() == block->index() + 1) {
+                if (falls_through_to(*block, jump.target())) {
                     if (basic_block_start_offsets.last() == bytecode.size()) {
                         // This block is empty, just skip it.
                         basic_block_start_offsets.take_last();
@@ -137,7 +175,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::generate(VM& vm, ASTN
             //               we can emit a `JumpTrue` or `JumpFalse` (to the other block) instead.
             if (instruction.type() == Instruction::Type::JumpIf) {
                 auto& jump = static_cast<Bytecode::Op::JumpIf&>(instruction);
-                if (jump.true_target().basic_block_index() == block->index() + 1) {
+                if (falls_through_to(*block, jump.true_target())) {
                     Op::JumpFalse jump_false(jump.condition(), Label { jump.false_target() });
                     auto& label = jump_false.target();
                     size_t label_offset = bytecode.size() + (bit_cast<FlatPtr>(&label) - bit_cast<FlatPtr>(&jump_false));
@@ -146,7 +184,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::generate(VM& vm, ASTN
                     ++it;
                     continue;
                 }
-                if (jump.false_target().basic_block_index() == block->index() + 1) {
+                if (falls_through_to(*block, jump.false_target())) {
                     Op::JumpTrue jump_true(jump.condition(), Label { jump.true_target() });
                     auto& label = jump_true.target();
                     size_t label_offset = bytecode.size() + (bit_cast<FlatPtr>(&label) - bit_cast<FlatPtr>(&jump_true));
@@ -398,7 +436,7 @@ CodeGenerationErrorOr<Generator::ReferenceOperands> Generator::emit_load_from_re
     if (expression.is_computed()) {
         auto property = TRY(expression.property().generate_bytecode(*this)).value();
         auto saved_property = allocate_register();
-        emit<Bytecode::Op::Mov>(saved_property, property);
+        emit_mov(saved_property, property);
         auto dst = preferred_dst.has_value() ? preferred_dst.value() : allocate_register();
         emit<Bytecode::Op::GetByValue>(dst, base, property, move(base_identifier));
         return ReferenceOperands {
@@ -837,6 +875,45 @@ bool Generator::fuse_compare_and_jump(ScopedOperand const& condition, Label true
 {
     auto& last_instruction = *reinterpret_cast<Instruction const*>(m_current_basic_block->data() + m_current_basic_block->last_instruction_start_offset());
 
+    // OPTIMIZATION: Jumping on `!value` is the same as jumping on `value` with the targets swapped.
+    if (last_instruction.type() == Instruction::Type::Not) {
+        auto& not_ = static_cast<Op::Not const&>(last_instruction);
+        if (not_.dst() != condition)
+            return false;
+        auto src = not_.src();
+        m_current_basic_block->rewind();
+        emit<Op::JumpIf>(src, false_target, true_target);
+        return true;
+    }
+
+    // OPTIMIZATION: Strict (in)equality with undefined is exactly what JumpUndefined checks for.
+    auto fuse_undefined_check = [&](Operand dst, Operand lhs, Operand rhs, Label undefined_target, Label not_undefined_target) {
+        VERIFY(dst == condition);
+        auto is_undefined_constant = [&](Operand operand) {
+            return operand.is_constant() && m_constants[operand.index()].is_undefined();
+        };
+        Optional<Operand> value;
+        if (is_undefined_constant(rhs))
+            value = lhs;
+        else if (is_undefined_constant(lhs))
+            value = rhs;
+        else
+            return false;
+        m_current_basic_block->rewind();
+        emit<Op::JumpUndefined>(*value, undefined_target, not_undefined_target);
+        return true;
+    };
+    if (last_instruction.type() == Instruction::Type::StrictlyEquals) {
+        auto& comparison = static_cast<Op::StrictlyEquals const&>(last_instruction);
+        if (fuse_undefined_check(comparison.dst(), comparison.lhs(), comparison.rhs(), true_target, false_target))
+            return true;
+    }
+    if (last_instruction.type() == Instruction::Type::StrictlyInequals) {
+        auto& comparison = static_cast<Op::StrictlyInequals const&>(last_instruction);
+        if (fuse_undefined_check(comparison.dst(), comparison.lhs(), comparison.rhs(), false_target, true_target))
+            return true;
+    }
+
 #define HANDLE_COMPARISON_OP(op_TitleCase, op_snake_case)                          \
     if (last_instruction.type() == Instruction::Type::op_TitleCase) {              \
         auto& comparison = static_cast<Op::op_TitleCase const&>(last_instruction); \
@@ -879,4 +956,363 @@ void Generator::emit_jump_if(ScopedOperand const& condition, Label true_target,
     emit<Op::JumpIf>(condition, true_target, false_target);
 }
 
+namespace {
+
+// The instructions of a block that is being rewritten, along with their source records.
+struct RewrittenBlock {
+    void append(Instruction const& instruction, SourceRecord source_record)
+    {
+        source_map.set(buffer.size(), source_record);
+        buffer.append(reinterpret_cast<u8 const*>(&instruction), instruction.length());
+    }
+
+    Vector<u8> buffer;
+    HashMap<size_t, SourceRecord> source_map;
+};
+
+}
+
+static Vector<Instruction*> instructions_in_block(BasicBlock& block)
+{
+    Vector<Instruction*> instructions;
+    InstructionStreamIterator it(block.instruction_stream());
+    while (!it.at_end()) {
+        instructions.append(const_cast<Instruction*>(&*it));
+        ++it;
+    }
+    return instructions;
+}
+
+static SourceRecord source_record_for(BasicBlock const& block, Instruction const& instruction)
+{
+    return block.source_map().get(reinterpret_cast<u8 const*>(&instruction) - block.data()).value();
+}
+
+// Registers below Register::reserved_register_count are also used by the interpreter itself, so only the ones handed
+// out by allocate_register() are tracked.
+static bool is_temporary_register(Operand operand)
+{
+    return operand.is_register() && operand.index() >= Register::reserved_register_count;
+}
+
+// If an instruction reads all of its inputs before it writes its result, and only writes it when it completes normally,
+// returns the operand it writes the result to. Such an instruction can write its result to any other operand instead.
+static Optional<Operand> redirectable_result(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+#define __BYTECODE_OP(op, ...)  \
+    case Instruction::Type::op: \
+        return static_cast<Op::op const&>(instruction).dst();
+
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__BYTECODE_OP)
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(__BYTECODE_OP)
+        JS_ENUMERATE_COMMON_UNARY_OPS(__BYTECODE_OP)
+        __BYTECODE_OP(Call)
+        __BYTECODE_OP(GetById)
+        __BYTECODE_OP(GetByIdWithThis)
+        __BYTECODE_OP(GetByValue)
+        __BYTECODE_OP(GetByValueWithThis)
+        __BYTECODE_OP(GetGlobal)
+        __BYTECODE_OP(GetVariable)
+        __BYTECODE_OP(Mov)
+        __BYTECODE_OP(NewArray)
+        __BYTECODE_OP(NewFunction)
+        __BYTECODE_OP(NewObject)
+        __BYTECODE_OP(NewPrimitiveArray)
+        __BYTECODE_OP(NewRegExp)
+
+#undef __BYTECODE_OP
+    default:
+        return {};
+    }
+}
+
+// Returns the temporary register that an instruction overwrites without reading it, if any.
+static Optional<u32> overwritten_register(Instruction& instruction)
+{
+    auto result = redirectable_result(instruction);
+    if (!result.has_value() || !is_temporary_register(*result))
+        return {};
+    size_t occurrences = 0;
+    instruction.visit_operands([&](Operand& operand) {
+        if (operand == *result)
+            ++occurrences;
+    });
+    if (occurrences != 1)
+        return {};
+    return result->index();
+}
+
+// Calls `callback` with each temporary register that an instruction may read.
+// NOTE: Registers that an instruction both reads and writes, or that it writes in a way we don't model, count as read.
+template<typename Callback>
+static void for_each_read_register(Instruction& instruction, Callback callback)
+{
+    auto overwritten = overwritten_register(instruction);
+    instruction.visit_operands([&](Operand& operand) {
+        if (is_temporary_register(operand) && operand.index() != overwritten)
+            callback(operand.index());
+    });
+}
+
+// OPTIMIZATION: The code generator evaluates most expressions into a fresh register and then copies the result to where
+//               it's needed, and it evaluates some values that turn out to be unused. This pass uses the liveness of
+//               temporary registers to:
+//               - drop Movs into registers that are never read afterwards,
+//               - let the instruction that produces a value write it straight to the destination of the Mov or
+//                 SetLocal that copies it, if the copied register is not read afterwards,
+//               - turn a PostfixIncrement or PostfixDecrement whose result is never read into an Increment or Decrement.
+void Generator::propagate_copies_and_eliminate_dead_stores()
+{
+    using RegisterSet = Vector<bool>;
+    auto const register_count = m_next_register;
+    auto const block_count = m_root_basic_blocks.size();
+
+    auto make_register_set = [&] {
+        RegisterSet set;
+        set.resize(register_count);
+        return set;
+    };
+    auto add_all = [&](RegisterSet& set, RegisterSet const& other) {
+        for (size_t i = 0; i < register_count; ++i)
+            set[i] |= other[i];
+    };
+
+    Vector<Vector<Instruction*>> instructions;
+    Vector<Vector<size_t>> successors;
+    Vector<RegisterSet> upward_exposed_reads;
+    Vector<RegisterSet> overwritten;
+    instructions.ensure_capacity(block_count);
+    successors.resize(block_count);
+    upward_exposed_reads.ensure_capacity(block_count);
+    overwritten.ensure_capacity(block_count);
+
+    Vector<size_t> scheduled_jump_targets;
+    Vector<size_t> blocks_continuing_pending_unwinds;
+
+    for (auto& block : m_root_basic_blocks) {
+        instructions.append(instructions_in_block(*block));
+        auto& block_successors = successors[block->index()];
+        auto reads = make_register_set();
+        auto writes = make_register_set();
+        for (auto* instruction : instructions.last().in_reverse()) {
+            instruction->visit_labels([&](Label& label) {
+                block_successors.append(label.basic_block_index());
+            });
+            if (instruction->type() == Instruction::Type::ScheduleJump)
+                scheduled_jump_targets.append(static_cast<Op::ScheduleJump const&>(*instruction).target().basic_block_index());
+            if (instruction->type() == Instruction::Type::ContinuePendingUnwind)
+                blocks_continuing_pending_unwinds.append(block->index());
+
+            if (auto reg = overwritten_register(*instruction); reg.has_value()) {
+                reads[*reg] = false;
+                writes[*reg] = true;
+            }
+            for_each_read_register(*instruction, [&](u32 reg) { reads[reg] = true; });
+        }
+        upward_exposed_reads.append(move(reads));
+        overwritten.append(move(writes));
+    }
+
+    // NOTE: A ContinuePendingUnwind at the end of a finalizer may continue with any jump that was scheduled before.
+    for (auto block_index : blocks_continuing_pending_unwinds)
+        successors[block_index].extend(scheduled_jump_targets);
+
+    Vector<RegisterSet> live_in;
+    Vector<RegisterSet> live_out;
+    Vector<RegisterSet> live_in_handlers;
+    for (size_t i = 0; i < block_count; ++i) {
+        live_in.append(make_register_set());
+        live_out.append(make_register_set());
+        live_in_handlers.append(make_register_set());
+    }
+
+    // A register is live in a block if it may be read before it's overwritten, either by the block itself, by one of
+    // the blocks it continues with, or by the handler or finalizer that any of its instructions may throw to.
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t block_index = block_count; block_index > 0; --block_index) {
+            auto const& block = *m_root_basic_blocks[block_index - 1];
+            auto out = make_register_set();
+            auto handlers = make_register_set();
+            if (block.handler())
+                add_all(handlers, live_in[block.handler()->index()]);
+            if (block.finalizer())
+                add_all(handlers, live_in[block.finalizer()->index()]);
+            add_all(out, handlers);
+            for (auto successor : successors[block.index()])
+                add_all(out, live_in[successor]);
+
+            auto in = upward_exposed_reads[block.index()];
+            for (size_t reg = 0; reg < register_count; ++reg)
+                in[reg] |= (out[reg] && !overwritten[block.index()][reg]) || handlers[reg];
+
+            if (in != live_in[block.index()]) {
+                live_in[block.index()] = move(in);
+                changed = true;
+            }
+            live_out[block.index()] = move(out);
+            live_in_handlers[block.index()] = move(handlers);
+        }
+    }
+
+    enum class Rewrite {
+        Keep,
+        Remove,
+        ReplaceWithIncrement,
+        ReplaceWithDecrement,
+    };
+
+    for (auto& block : m_root_basic_blocks) {
+        auto const& block_instructions = instructions[block->index()];
+        auto const& handlers = live_in_handlers[block->index()];
+        auto live = live_out[block->index()];
+        auto is_dead = [&](Operand operand) {
+            return is_temporary_register(operand) && !live[operand.index()];
+        };
+
+        Vector<Rewrite> rewrites;
+        rewrites.resize(block_instructions.size());
+        bool block_changed = false;
+
+        // NOTE: `live` holds the registers that are live right after the instruction being looked at.
+        for (size_t i = block_instructions.size(); i > 0; --i) {
+            auto& instruction = *block_instructions[i - 1];
+
+            if (instruction.type() == Instruction::Type::Mov && is_dead(static_cast<Op::Mov const&>(instruction).dst())) {
+                rewrites[i - 1] = Rewrite::Remove;
+                block_changed = true;
+                continue;
+            }
+
+            if (instruction.type() == Instruction::Type::Mov || instruction.type() == Instruction::Type::SetLocal) {
+                auto dst = instruction.type() == Instruction::Type::Mov ? static_cast<Op::Mov const&>(instruction).dst() : static_cast<Op::SetLocal const&>(instruction).dst();
+                auto src = instruction.type() == Instruction::Type::Mov ? static_cast<Op::Mov const&>(instruction).src() : static_cast<Op::SetLocal const&>(instruction).src();
+                if (i >= 2 && dst != src && is_dead(src) && overwritten_register(*block_instructions[i - 2]) == src.index()) {
+                    block_instructions[i - 2]->visit_operands([&](Operand& operand) {
+                        if (operand == src)
+                            operand = dst;
+                    });
+                    rewrites[i - 1] = Rewrite::Remove;
+                    block_changed = true;
+                    continue;
+                }
+            }
+
+            if (instruction.type() == Instruction::Type::PostfixIncrement || instruction.type() == Instruction::Type::PostfixDecrement) {
+                auto is_increment = instruction.type() == Instruction::Type::PostfixIncrement;
+                auto dst = is_increment ? static_cast<Op::PostfixIncrement const&>(instruction).dst() : static_cast<Op::PostfixDecrement const&>(instruction).dst();
+                auto src = is_increment ? static_cast<Op::PostfixIncrement const&>(instruction).src() : static_cast<Op::PostfixDecrement const&>(instruction).src();
+                if (dst != src && is_dead(dst)) {
+                    rewrites[i - 1] = is_increment ? Rewrite::ReplaceWithIncrement : Rewrite::ReplaceWithDecrement;
+                    block_changed = true;
+                    if (is_temporary_register(src))
+                        live[src.index()] = true;
+                    continue;
+                }
+            }
+
+            // NOTE: A register that a handler or finalizer may read stays live, since any instruction in the block may throw.
+            if (auto reg = overwritten_register(instruction); reg.has_value() && !handlers[*reg])
+                live[*reg] = false;
+            for_each_read_register(instruction, [&](u32 reg) { live[reg] = true; });
+        }
+
+        if (!block_changed)
+            continue;
+
+        RewrittenBlock rewritten;
+        for (size_t i = 0; i < block_instructions.size(); ++i) {
+            auto const& instruction = *block_instructions[i];
+            auto source_record = source_record_for(*block, instruction);
+            switch (rewrites[i]) {
+            case Rewrite::Keep:
+                rewritten.append(instruction, source_record);
+                break;
+            case Rewrite::Remove:
+                break;
+            case Rewrite::ReplaceWithIncrement:
+                rewritten.append(Op::Increment(static_cast<Op::PostfixIncrement const&>(instruction).src()), source_record);
+                break;
+            case Rewrite::ReplaceWithDecrement:
+                rewritten.append(Op::Decrement(static_cast<Op::PostfixDecrement const&>(instruction).src()), source_record);
+                break;
+            }
+        }
+        block->set_instructions({}, move(rewritten.buffer), move(rewritten.source_map));
+    }
+}
+
+// OPTIMIZATION: Fuse common sequences of instructions into a single instruction, to save on dispatch:
+//               - GetById followed by a Call of the loaded function becomes CallById.
+//               - GetById, Increment and PutById of the same property becomes IncrementById.
+void Generator::fuse_superinstructions()
+{
+    for (auto& block : m_root_basic_blocks) {
+        auto block_instructions = instructions_in_block(*block);
+        RewrittenBlock rewritten;
+        bool block_changed = false;
+
+        for (size_t i = 0; i < block_instructions.size(); ++i) {
+            auto const& instruction = *block_instructions[i];
+            auto const* next = i + 1 < block_instructions.size() ? block_instructions[i + 1] : nullptr;
+            auto const* next_but_one = i + 2 < block_instructions.size() ? block_instructions[i + 2] : nullptr;
+
+            if (instruction.type() == Instruction::Type::GetById && next) {
+                auto const& get_by_id = static_cast<Op::GetById const&>(instruction);
+
+                if (next->type() == Instruction::Type::Call && static_cast<Op::Call const&>(*next).callee() == get_by_id.dst()) {
+                    auto const& call = static_cast<Op::Call const&>(*next);
+                    Vector<u8> storage;
+                    storage.resize(round_up_to_power_of_two(sizeof(Op::CallById) + call.argument_count() * sizeof(Operand), alignof(void*)));
+                    auto* call_by_id = new (storage.data()) Op::CallById(
+                        call.call_type(),
+                        call.dst(),
+                        call.callee(),
+                        get_by_id.base(),
+                        get_by_id.property(),
+                        get_by_id.base_identifier(),
+                        get_by_id.cache_index(),
+                        call.this_value(),
+                        call.arguments(),
+                        call.expression_string(),
+                        call.builtin());
+                    rewritten.append(*call_by_id, source_record_for(*block, call));
+                    block_changed = true;
+                    i += 1;
+                    continue;
+                }
+
+                if (next->type() == Instruction::Type::Increment && next_but_one && next_but_one->type() == Instruction::Type::PutById) {
+                    auto const& increment = static_cast<Op::Increment const&>(*next);
+                    auto const& put_by_id = static_cast<Op::PutById const&>(*next_but_one);
+                    if (increment.dst() == get_by_id.dst()
+                        && get_by_id.dst() != get_by_id.base()
+                        && put_by_id.base() == get_by_id.base()
+                        && put_by_id.property().value == get_by_id.property().value
+                        && put_by_id.src() == get_by_id.dst()
+                        && put_by_id.kind() == Op::PropertyKind::KeyValue) {
+                        rewritten.append(Op::IncrementById(
+                                             get_by_id.dst(),
+                                             get_by_id.base(),
+                                             get_by_id.property(),
+                                             get_by_id.base_identifier(),
+                                             get_by_id.cache_index(),
+                                             put_by_id.cache_index()),
+                            source_record_for(*block, instruction));
+                        block_changed = true;
+                        i += 2;
+                        continue;
+                    }
+                }
+            }
+
+            rewritten.append(instruction, source_record_for(*block, instruction));
+        }
+
+        if (block_changed)
+            block->set_instructions({}, move(rewritten.buffer), move(rewritten.source_map));
+    }
+}
+
 }
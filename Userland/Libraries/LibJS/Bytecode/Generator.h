@@ -43,6 +43,9 @@ public:
     void set_local_initialized(u32 local_index);
     [[nodiscard]] bool is_local_initialized(u32 local_index) const;
 
+    // Whether statements need to produce their completion value, see Generator::generate().
+    [[nodiscard]] bool must_propagate_completion() const { return m_must_propagate_completion; }
+
     class SourceLocationScope {
     public:
         SourceLocationScope(Generator&, ASTNode const& node);
@@ -117,6 +120,14 @@ public:
         emit_with_extra_slots<OpType, Value>(extra_operand_slots, forward<Args>(args)...);
     }
 
+    void emit_mov(ScopedOperand const& dst, ScopedOperand const& src)
+    {
+        // OPTIMIZATION: Don't emit moves of an operand to itself.
+        if (dst == src)
+            return;
+        emit<Op::Mov>(dst, src);
+    }
+
     void emit_jump_if(ScopedOperand const& condition, Label true_target, Label false_target);
 
     struct ReferenceOperands {
@@ -316,6 +327,9 @@ private:
     // Returns true if a fused instruction was emitted.
     [[nodiscard]] bool fuse_compare_and_jump(ScopedOperand const& condition, Label true_target, Label false_target);
 
+    void propagate_copies_and_eliminate_dead_stores();
+    void fuse_superinstructions();
+
     struct LabelableScope {
         Label bytecode_target;
         Vector<DeprecatedFlyString> language_label_set;
@@ -348,6 +362,7 @@ private:
     HashTable<u32> m_initialized_locals;
 
     bool m_finished { false };
+    bool m_must_propagate_completion { true };
 };
 
 }
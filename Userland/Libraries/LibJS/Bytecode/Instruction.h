@@ -24,6 +24,7 @@
     O(BitwiseXor)                      \
     O(BlockDeclarationInstantiation)   \
     O(Call)                            \
+    O(CallById)                        \
     O(CallWithArgumentArray)           \
     O(Catch)                           \
     O(ConcatString)                    \
@@ -64,6 +65,7 @@
     O(ImportCall)                      \
     O(In)                              \
     O(Increment)                       \
+    O(IncrementById)                   \
     O(InstanceOf)                      \
     O(IteratorClose)                   \
     O(IteratorNext)                    \
@@ -149,6 +151,7 @@ public:
     size_t length() const;
     ByteString to_byte_string(Bytecode::Executable const&) const;
     void visit_labels(Function<void(Label&)> visitor);
+    void visit_operands(Function<void(Operand&)> visitor);
     static void destroy(Instruction&);
 
 protected:
@@ -158,6 +161,7 @@ protected:
     }
 
     void visit_labels_impl(Function<void(Label&)>) { }
+    void visit_operands_impl(Function<void(Operand&)>) { }
 
 private:
     Type m_type {};
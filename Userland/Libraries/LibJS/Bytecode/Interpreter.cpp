@@ -15,6 +15,7 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -38,6 +39,7 @@
 namespace JS::Bytecode {
 
 bool g_dump_bytecode = false;
+bool g_dump_property_lookup_cache_statistics = false;
 
 static ByteString format_operand(StringView name, Operand operand, Bytecode::Executable const& executable)
 {
@@ -106,42 +108,6 @@ static ByteString format_value_list(StringView name, ReadonlySpan<Value> values)
     return builder.to_byte_string();
 }
 
-ALWAYS_INLINE static ThrowCompletionOr<Value> loosely_inequals(VM& vm, Value src1, Value src2)
-{
-    if (src1.tag() == src2.tag()) {
-        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
-            return Value(src1.encoded() != src2.encoded());
-    }
-    return Value(!TRY(is_loosely_equal(vm, src1, src2)));
-}
-
-ALWAYS_INLINE static ThrowCompletionOr<Value> loosely_equals(VM& vm, Value src1, Value src2)
-{
-    if (src1.tag() == src2.tag()) {
-        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
-            return Value(src1.encoded() == src2.encoded());
-    }
-    return Value(TRY(is_loosely_equal(vm, src1, src2)));
-}
-
-ALWAYS_INLINE static ThrowCompletionOr<Value> strict_inequals(VM&, Value src1, Value src2)
-{
-    if (src1.tag() == src2.tag()) {
-        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
-            return Value(src1.encoded() != src2.encoded());
-    }
-    return Value(!is_strictly_equal(src1, src2));
-}
-
-ALWAYS_INLINE static ThrowCompletionOr<Value> strict_equals(VM&, Value src1, Value src2)
-{
-    if (src1.tag() == src2.tag()) {
-        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
-            return Value(src1.encoded() == src2.encoded());
-    }
-    return Value(is_strictly_equal(src1, src2));
-}
-
 Interpreter::Interpreter(VM& vm)
     : m_vm(vm)
 {
@@ -151,34 +117,6 @@ Interpreter::~Interpreter()
 {
 }
 
-ALWAYS_INLINE Value Interpreter::get(Operand op) const
-{
-    switch (op.type()) {
-    case Operand::Type::Register:
-        return m_registers.data()[op.index()];
-    case Operand::Type::Local:
-        return m_locals.data()[op.index()];
-    case Operand::Type::Constant:
-        return m_constants.data()[op.index()];
-    }
-    __builtin_unreachable();
-}
-
-ALWAYS_INLINE void Interpreter::set(Operand op, Value value)
-{
-    switch (op.type()) {
-    case Operand::Type::Register:
-        m_registers.data()[op.index()] = value;
-        return;
-    case Operand::Type::Local:
-        m_locals.data()[op.index()] = value;
-        return;
-    case Operand::Type::Constant:
-        break;
-    }
-    __builtin_unreachable();
-}
-
 // 16.1.6 ScriptEvaluation ( scriptRecord ), https://tc39.es/ecma262/#sec-runtime-semantics-scriptevaluation
 ThrowCompletionOr<Value> Interpreter::run(Script& script_record, JS::GCPtr<Environment> lexical_environment_override)
 {
@@ -228,7 +166,15 @@ ThrowCompletionOr<Value> Interpreter::run(Script& script_record, JS::GCPtr<Envir
 
     // 13. If result.[[Type]] is normal, then
     if (result.type() == Completion::Type::Normal) {
-        auto executable_result = JS::Bytecode::Generator::generate(vm, script, {});
+        // NOTE: The parse tree may be shared with other scripts made from the same source text (see ScriptCache),
+        //       so keep the generated bytecode on it for the next one.
+        auto executable_result = [&]() -> CodeGenerationErrorOr<NonnullGCPtr<Executable>> {
+            if (auto* executable = script.bytecode_executable())
+                return NonnullGCPtr { *executable };
+            auto executable = TRY(JS::Bytecode::Generator::generate(vm, script, {}));
+            const_cast<Program&>(script).set_bytecode_executable(executable);
+            return executable;
+        }();
 
         if (executable_result.is_error()) {
             if (auto error_string = executable_result.error().to_string(); error_string.is_error())
@@ -542,6 +488,7 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             HANDLE_INSTRUCTION(BitwiseXor);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(BlockDeclarationInstantiation);
             HANDLE_INSTRUCTION(Call);
+            HANDLE_INSTRUCTION(CallById);
             HANDLE_INSTRUCTION(CallWithArgumentArray);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(Catch);
             HANDLE_INSTRUCTION(ConcatString);
@@ -579,6 +526,7 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             HANDLE_INSTRUCTION(ImportCall);
             HANDLE_INSTRUCTION(In);
             HANDLE_INSTRUCTION(Increment);
+            HANDLE_INSTRUCTION(IncrementById);
             HANDLE_INSTRUCTION(InstanceOf);
             HANDLE_INSTRUCTION(IteratorClose);
             HANDLE_INSTRUCTION(IteratorNext);
@@ -696,7 +644,10 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
 
     running_execution_context.executable = &executable;
 
-    run_bytecode(entry_point.value_or(0));
+    if (auto const* native_executable = executable.get_or_create_native_executable())
+        native_executable->run(*this, entry_point.value_or(0));
+    else
+        run_bytecode(entry_point.value_or(0));
 
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
 
@@ -1482,25 +1433,45 @@ static ThrowCompletionOr<Value> dispatch_builtin_call(Bytecode::Interpreter& int
     VERIFY_NOT_REACHED();
 }
 
-ThrowCompletionOr<void> Call::execute_impl(Bytecode::Interpreter& interpreter) const
+template<typename OpType>
+static ThrowCompletionOr<Value> call_with_operands(Bytecode::Interpreter& interpreter, OpType const& instruction, Value callee)
 {
-    auto callee = interpreter.get(m_callee);
-
-    TRY(throw_if_needed_for_call(interpreter, callee, call_type(), expression_string()));
+    TRY(throw_if_needed_for_call(interpreter, callee, instruction.call_type(), instruction.expression_string()));
 
-    if (m_builtin.has_value()
-        && m_argument_count == Bytecode::builtin_argument_count(m_builtin.value())
+    auto const& builtin = instruction.builtin();
+    auto arguments = instruction.arguments();
+    if (builtin.has_value()
+        && arguments.size() == Bytecode::builtin_argument_count(builtin.value())
         && callee.is_object()
-        && interpreter.realm().get_builtin_value(m_builtin.value()) == &callee.as_object()) {
-        interpreter.set(dst(), TRY(dispatch_builtin_call(interpreter, m_builtin.value(), { m_arguments, m_argument_count })));
-        return {};
+        && interpreter.realm().get_builtin_value(builtin.value()) == &callee.as_object()) {
+        return dispatch_builtin_call(interpreter, builtin.value(), arguments);
     }
 
     Vector<Value> argument_values;
-    argument_values.ensure_capacity(m_argument_count);
-    for (size_t i = 0; i < m_argument_count; ++i)
-        argument_values.unchecked_append(interpreter.get(m_arguments[i]));
-    interpreter.set(dst(), TRY(perform_call(interpreter, interpreter.get(m_this_value), call_type(), callee, argument_values)));
+    argument_values.ensure_capacity(arguments.size());
+    for (auto argument : arguments)
+        argument_values.unchecked_append(interpreter.get(argument));
+    return perform_call(interpreter, interpreter.get(instruction.this_value()), instruction.call_type(), callee, argument_values);
+}
+
+ThrowCompletionOr<void> Call::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto callee = interpreter.get(m_callee);
+    interpreter.set(dst(), TRY(call_with_operands(interpreter, *this, callee)));
+    return {};
+}
+
+ThrowCompletionOr<void> CallById::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto base_identifier = interpreter.current_executable().get_identifier(m_base_identifier);
+    auto const& property_identifier = interpreter.current_executable().get_identifier(m_property);
+
+    auto base_value = interpreter.get(m_base);
+    auto& cache = interpreter.current_executable().property_lookup_caches[m_cache_index];
+
+    auto callee = TRY(get_by_id(interpreter.vm(), base_identifier, property_identifier, base_value, base_value, cache));
+    interpreter.set(m_callee, callee);
+    interpreter.set(dst(), TRY(call_with_operands(interpreter, *this, callee)));
     return {};
 }
 
@@ -1534,26 +1505,43 @@ void Return::execute_impl(Bytecode::Interpreter& interpreter) const
         interpreter.do_return(js_undefined());
 }
 
-ThrowCompletionOr<void> Increment::execute_impl(Bytecode::Interpreter& interpreter) const
+static ThrowCompletionOr<Value> increment(VM& vm, Value old_value)
 {
-    auto& vm = interpreter.vm();
-    auto old_value = interpreter.get(dst());
-
     // OPTIMIZATION: Fast path for Int32 values.
     if (old_value.is_int32()) {
         auto integer_value = old_value.as_i32();
-        if (integer_value != NumericLimits<i32>::max()) [[likely]] {
-            interpreter.set(dst(), Value { integer_value + 1 });
-            return {};
-        }
+        if (integer_value != NumericLimits<i32>::max()) [[likely]]
+            return Value { integer_value + 1 };
     }
 
     old_value = TRY(old_value.to_numeric(vm));
 
     if (old_value.is_number())
-        interpreter.set(dst(), Value(old_value.as_double() + 1));
-    else
-        interpreter.set(dst(), BigInt::create(vm, old_value.as_bigint().big_integer().plus(Crypto::SignedBigInteger { 1 })));
+        return Value(old_value.as_double() + 1);
+    return BigInt::create(vm, old_value.as_bigint().big_integer().plus(Crypto::SignedBigInteger { 1 }));
+}
+
+ThrowCompletionOr<void> Increment::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.set(dst(), TRY(increment(interpreter.vm(), interpreter.get(dst()))));
+    return {};
+}
+
+ThrowCompletionOr<void> IncrementById::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto& vm = interpreter.vm();
+    auto base_identifier = interpreter.current_executable().get_identifier(m_base_identifier);
+    auto const& property_identifier = interpreter.current_executable().get_identifier(m_property);
+    auto& caches = interpreter.current_executable().property_lookup_caches;
+
+    auto base_value = interpreter.get(m_base);
+
+    // NOTE: dst is updated after each step, like the separate instructions would have done, in case one of them throws.
+    auto value = TRY(get_by_id(vm, base_identifier, property_identifier, base_value, base_value, caches[m_get_cache_index]));
+    interpreter.set(m_dst, value);
+    value = TRY(increment(vm, value));
+    interpreter.set(m_dst, value);
+    TRY(put_by_property_key(vm, base_value, base_value, value, base_identifier, property_identifier, PropertyKind::KeyValue, &caches[m_put_cache_index]));
     return {};
 }
 
@@ -2181,6 +2169,32 @@ ByteString Call::to_byte_string_impl(Bytecode::Executable const& executable) con
     return builder.to_byte_string();
 }
 
+ByteString CallById::to_byte_string_impl(Bytecode::Executable const& executable) const
+{
+    auto type = call_type_to_string(m_type);
+
+    StringBuilder builder;
+    builder.appendff("CallById{} {}, {}, {}, {}, {}, "sv,
+        type,
+        format_operand("dst"sv, m_dst, executable),
+        format_operand("callee"sv, m_callee, executable),
+        format_operand("base"sv, m_base, executable),
+        executable.identifier_table->get(m_property),
+        format_operand("this"sv, m_this_value, executable));
+
+    builder.append(format_operand_list("args"sv, { m_arguments, m_argument_count }, executable));
+
+    if (m_builtin.has_value()) {
+        builder.appendff(", (builtin:{})", m_builtin.value());
+    }
+
+    if (m_expression_string.has_value()) {
+        builder.appendff(", `{}`", executable.get_string(m_expression_string.value()));
+    }
+
+    return builder.to_byte_string();
+}
+
 ByteString CallWithArgumentArray::to_byte_string_impl(Bytecode::Executable const& executable) const
 {
     auto type = call_type_to_string(m_type);
@@ -2245,6 +2259,14 @@ ByteString Increment::to_byte_string_impl(Bytecode::Executable const& executable
     return ByteString::formatted("Increment {}", format_operand("dst"sv, m_dst, executable));
 }
 
+ByteString IncrementById::to_byte_string_impl(Bytecode::Executable const& executable) const
+{
+    return ByteString::formatted("IncrementById {}, {}, {}",
+        format_operand("dst"sv, m_dst, executable),
+        format_operand("base"sv, m_base, executable),
+        executable.identifier_table->get(m_property));
+}
+
 ByteString PostfixIncrement::to_byte_string_impl(Bytecode::Executable const& executable) const
 {
     return ByteString::formatted("PostfixIncrement {}, {}",
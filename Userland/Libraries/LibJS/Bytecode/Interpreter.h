@@ -8,6 +8,7 @@
 
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Operand.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Cell.h>
@@ -56,8 +57,33 @@ public:
         return m_registers.data()[r.index()];
     }
 
-    [[nodiscard]] Value get(Operand) const;
-    void set(Operand, Value);
+    [[nodiscard]] ALWAYS_INLINE Value get(Operand op) const
+    {
+        switch (op.type()) {
+        case Operand::Type::Register:
+            return m_registers.data()[op.index()];
+        case Operand::Type::Local:
+            return m_locals.data()[op.index()];
+        case Operand::Type::Constant:
+            return m_constants.data()[op.index()];
+        }
+        __builtin_unreachable();
+    }
+
+    ALWAYS_INLINE void set(Operand op, Value value)
+    {
+        switch (op.type()) {
+        case Operand::Type::Register:
+            m_registers.data()[op.index()] = value;
+            return;
+        case Operand::Type::Local:
+            m_locals.data()[op.index()] = value;
+            return;
+        case Operand::Type::Constant:
+            break;
+        }
+        __builtin_unreachable();
+    }
 
     void do_return(Value value)
     {
@@ -80,7 +106,14 @@ public:
     Vector<Value>& registers() { return vm().running_execution_context().registers; }
     Vector<Value> const& registers() const { return vm().running_execution_context().registers; }
 
+    // NOTE: Gets and puts use separate caches, since an own property that can be read isn't necessarily writable.
+    MegamorphicPropertyLookupCache& megamorphic_get_cache() { return m_megamorphic_get_cache; }
+    MegamorphicPropertyLookupCache& megamorphic_put_cache() { return m_megamorphic_put_cache; }
+
 private:
+    friend class JIT::Compiler;
+    friend class JIT::NativeExecutable;
+
     void run_bytecode(size_t entry_point);
 
     enum class HandleExceptionResponse {
@@ -99,9 +132,12 @@ private:
     Span<Value> m_registers;
     Span<Value> m_locals;
     Span<Value> m_constants;
+    MegamorphicPropertyLookupCache m_megamorphic_get_cache;
+    MegamorphicPropertyLookupCache m_megamorphic_put_cache;
 };
 
 extern bool g_dump_bytecode;
+extern bool g_dump_property_lookup_cache_statistics;
 
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM&, ASTNode const&, ReadonlySpan<FunctionParameter>, JS::FunctionKind kind, DeprecatedFlyString const& name);
 
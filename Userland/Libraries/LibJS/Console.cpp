@@ -35,6 +35,12 @@ void Console::visit_edges(Visitor& visitor)
     visitor.visit(m_client);
 }
 
+void Console::set_client(ConsoleClient& client)
+{
+    m_client = &client;
+    write_barrier(&client);
+}
+
 // 1.1.1. assert(condition, ...data), https://console.spec.whatwg.org/#assert
 ThrowCompletionOr<Value> Console::assert_()
 {
@@ -26,6 +26,7 @@ class ConsoleClient;
 class Console : public Cell {
     JS_CELL(Console, Cell);
     JS_DECLARE_ALLOCATOR(Console);
+    JS_CELL_HAS_WRITE_BARRIERS(Console);
 
 public:
     virtual ~Console() override;
@@ -58,7 +59,7 @@ public:
         Vector<String> stack;
     };
 
-    void set_client(ConsoleClient& client) { m_client = &client; }
+    void set_client(ConsoleClient&);
 
     Realm& realm() const { return m_realm; }
 
@@ -107,6 +108,7 @@ private:
 class ConsoleClient : public Cell {
     JS_CELL(ConsoleClient, Cell);
     JS_DECLARE_ALLOCATOR(ConsoleClient);
+    JS_CELL_HAS_WRITE_BARRIERS(ConsoleClient);
 
 public:
     using PrinterArguments = Variant<Console::Group, Console::Trace, MarkedVector<Value>>;
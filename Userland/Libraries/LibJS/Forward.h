@@ -207,6 +207,7 @@ class Realm;
 class Reference;
 class ScopeNode;
 class Script;
+class ScriptCache;
 class Shape;
 class Statement;
 class StringOrSymbol;
@@ -325,4 +326,9 @@ class RegexTable;
 class Register;
 }
 
+namespace JIT {
+class Compiler;
+class NativeExecutable;
+}
+
 }
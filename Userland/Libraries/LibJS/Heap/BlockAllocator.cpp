@@ -4,11 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/NeverDestroyed.h>
 #include <AK/Platform.h>
 #include <AK/Random.h>
 #include <AK/Vector.h>
 #include <LibJS/Heap/BlockAllocator.h>
 #include <LibJS/Heap/HeapBlock.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
 #include <sys/mman.h>
 
 #ifdef HAS_ADDRESS_SANITIZER
@@ -26,9 +30,128 @@ namespace JS {
 // NOTE: If this changes, we need to update the mmap() code to ensure correct alignment.
 static_assert(HeapBlock::block_size == 4096);
 
+static void decommit_block(void* block)
+{
+#if defined(USE_FALLBACK_BLOCK_DEALLOCATION)
+    // If we can't use any of the nicer techniques, unmap and remap the block to return the physical pages while keeping the VM.
+    if (munmap(block, HeapBlock::block_size) < 0) {
+        perror("munmap");
+        VERIFY_NOT_REACHED();
+    }
+    if (mmap(block, HeapBlock::block_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED, 0, 0) != block) {
+        perror("mmap");
+        VERIFY_NOT_REACHED();
+    }
+#elif defined(MADV_FREE)
+    if (madvise(block, HeapBlock::block_size, MADV_FREE) < 0) {
+        perror("madvise(MADV_FREE)");
+        VERIFY_NOT_REACHED();
+    }
+#elif defined(MADV_DONTNEED)
+    if (madvise(block, HeapBlock::block_size, MADV_DONTNEED) < 0) {
+        perror("madvise(MADV_DONTNEED)");
+        VERIFY_NOT_REACHED();
+    }
+#endif
+}
+
+// Returning a block's physical pages to the system takes a system call per block, which adds up when a
+// garbage collection frees many megabytes worth of blocks. So instead of doing that while the mutator is
+// waiting for the collection to finish, we hand the blocks to a background thread.
+class BlockDecommitter {
+public:
+    static BlockDecommitter& the()
+    {
+        static NeverDestroyed<BlockDecommitter> s_the;
+        return *s_the;
+    }
+
+    void enqueue(BlockAllocator& allocator, void* block)
+    {
+        Threading::MutexLocker locker(m_mutex);
+        // NOTE: The thread is started lazily, so that short-lived programs that never free a block don't pay for it.
+        if (!m_thread) {
+            m_thread = Threading::Thread::construct([this] {
+                run();
+                return static_cast<intptr_t>(0);
+            },
+                "JS block decommitter"sv);
+            m_thread->start();
+            m_thread->detach();
+        }
+        if (allocator.m_blocks_to_decommit.is_empty())
+            m_queue.append(allocator);
+        allocator.m_blocks_to_decommit.append(block);
+        // NOTE: Waking the thread up takes a system call too, so we only do it when it's waiting for work.
+        if (m_thread_is_waiting)
+            m_work_available.signal();
+    }
+
+    void* take_block(BlockAllocator& allocator)
+    {
+        Threading::MutexLocker locker(m_mutex);
+        if (!allocator.m_blocks.is_empty()) {
+            // To reduce predictability, take a random block from the cache.
+            size_t random_index = get_random_uniform(allocator.m_blocks.size());
+            return allocator.m_blocks.unstable_take(random_index);
+        }
+        // We're about to reuse the memory anyway, so there's no point in decommitting a block that's still queued.
+        if (!allocator.m_blocks_to_decommit.is_empty()) {
+            auto* block = allocator.m_blocks_to_decommit.take_last();
+            if (allocator.m_blocks_to_decommit.is_empty())
+                allocator.m_decommit_queue_node.remove();
+            return block;
+        }
+        return nullptr;
+    }
+
+    Vector<void*> take_all_blocks(BlockAllocator& allocator)
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_work_done.wait_while([&] { return allocator.m_blocks_being_decommitted > 0; });
+        if (allocator.m_decommit_queue_node.is_in_list())
+            allocator.m_decommit_queue_node.remove();
+        auto blocks = move(allocator.m_blocks);
+        blocks.extend(move(allocator.m_blocks_to_decommit));
+        return blocks;
+    }
+
+private:
+    void run()
+    {
+        Threading::MutexLocker locker(m_mutex);
+        while (true) {
+            m_thread_is_waiting = true;
+            m_work_available.wait_while([&] { return m_queue.is_empty(); });
+            m_thread_is_waiting = false;
+
+            auto& allocator = *m_queue.take_first();
+            auto blocks = move(allocator.m_blocks_to_decommit);
+            auto block_count = blocks.size();
+            allocator.m_blocks_being_decommitted += block_count;
+
+            locker.unlock();
+            for (auto* block : blocks)
+                decommit_block(block);
+            locker.lock();
+
+            allocator.m_blocks.extend(move(blocks));
+            allocator.m_blocks_being_decommitted -= block_count;
+            m_work_done.broadcast();
+        }
+    }
+
+    RefPtr<Threading::Thread> m_thread;
+    Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_work_available { m_mutex };
+    Threading::ConditionVariable m_work_done { m_mutex };
+    IntrusiveList<&BlockAllocator::m_decommit_queue_node> m_queue;
+    bool m_thread_is_waiting { false };
+};
+
 BlockAllocator::~BlockAllocator()
 {
-    for (auto* block : m_blocks) {
+    for (auto* block : BlockDecommitter::the().take_all_blocks(*this)) {
         ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
         if (munmap(block, HeapBlock::block_size) < 0) {
             perror("munmap");
@@ -39,10 +162,7 @@ BlockAllocator::~BlockAllocator()
 
 void* BlockAllocator::allocate_block([[maybe_unused]] char const* name)
 {
-    if (!m_blocks.is_empty()) {
-        // To reduce predictability, take a random block from the cache.
-        size_t random_index = get_random_uniform(m_blocks.size());
-        auto* block = m_blocks.unstable_take(random_index);
+    if (auto* block = BlockDecommitter::the().take_block(*this)) {
         ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
         LSAN_REGISTER_ROOT_REGION(block, HeapBlock::block_size);
 #ifdef AK_OS_SERENITY
@@ -68,31 +188,9 @@ void BlockAllocator::deallocate_block(void* block)
 {
     VERIFY(block);
 
-#if defined(USE_FALLBACK_BLOCK_DEALLOCATION)
-    // If we can't use any of the nicer techniques, unmap and remap the block to return the physical pages while keeping the VM.
-    if (munmap(block, HeapBlock::block_size) < 0) {
-        perror("munmap");
-        VERIFY_NOT_REACHED();
-    }
-    if (mmap(block, HeapBlock::block_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED, 0, 0) != block) {
-        perror("mmap");
-        VERIFY_NOT_REACHED();
-    }
-#elif defined(MADV_FREE)
-    if (madvise(block, HeapBlock::block_size, MADV_FREE) < 0) {
-        perror("madvise(MADV_FREE)");
-        VERIFY_NOT_REACHED();
-    }
-#elif defined(MADV_DONTNEED)
-    if (madvise(block, HeapBlock::block_size, MADV_DONTNEED) < 0) {
-        perror("madvise(MADV_DONTNEED)");
-        VERIFY_NOT_REACHED();
-    }
-#endif
-
     ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
     LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::block_size);
-    m_blocks.append(block);
+    BlockDecommitter::the().enqueue(*this, block);
 }
 
 }
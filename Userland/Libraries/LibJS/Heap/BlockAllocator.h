@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/IntrusiveList.h>
 #include <AK/Vector.h>
 #include <LibJS/Forward.h>
 
@@ -17,10 +18,19 @@ public:
     ~BlockAllocator();
 
     void* allocate_block(char const* name);
+
+    // NOTE: The block's physical pages are returned to the system on a background thread.
+    //       It only becomes available to allocate_block() again once that has happened.
     void deallocate_block(void*);
 
 private:
+    friend class BlockDecommitter;
+
+    // NOTE: These are shared with the background thread, and protected by BlockDecommitter's mutex.
     Vector<void*> m_blocks;
+    Vector<void*> m_blocks_to_decommit;
+    size_t m_blocks_being_decommitted { 0 };
+    IntrusiveListNode<BlockAllocator> m_decommit_queue_node;
 };
 
 }
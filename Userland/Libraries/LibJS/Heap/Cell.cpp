@@ -15,6 +15,20 @@ void JS::Cell::initialize(JS::Realm&)
 {
 }
 
+void JS::Cell::remember()
+{
+    m_remembered = true;
+    heap().did_remember_cell({}, *this);
+}
+
+void JS::Cell::remember_if_necessary(Cell const& new_edge)
+{
+    if (m_generation == Generation::Old && new_edge.m_generation == Generation::Young)
+        remember();
+    else if (m_mark && !new_edge.m_mark)
+        remember();
+}
+
 void JS::Cell::Visitor::visit(JS::Value value)
 {
     if (value.is_cell())
@@ -16,6 +16,7 @@
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/GCPtr.h>
 #include <LibJS/Heap/Internals.h>
+#include <LibJS/Runtime/Value.h>
 
 namespace JS {
 
@@ -28,6 +29,12 @@ public:                                            \
     }                                              \
     friend class JS::Heap;
 
+// Declares that every reference to another cell that this class stores after construction goes through
+// Cell::write_barrier(). Young generation collections can then skip old instances that haven't been written to.
+// NOTE: Subclasses that visit edges of their own have to opt in separately.
+#define JS_CELL_HAS_WRITE_BARRIERS(class_) \
+    using WriteBarrieredCellType = class_
+
 class Cell : public Weakable<Cell> {
     AK_MAKE_NONCOPYABLE(Cell);
     AK_MAKE_NONMOVABLE(Cell);
@@ -39,14 +46,57 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
-    enum class State : bool {
+    enum class State : u8 {
         Live,
+        // Found unreachable by a full collection and finalized, but not destroyed until its block gets swept.
+        Unswept,
         Dead,
     };
 
     State state() const { return m_state; }
     void set_state(State state) { m_state = state; }
 
+    // Unswept cells can't be reached through WeakPtrs, even though their destructor hasn't run yet.
+    void revoke_weak_ptrs(Badge<Heap>) { Weakable::revoke_weak_ptrs(); }
+
+    // Every cell starts out young, and is promoted to the old generation when it survives a collection.
+    enum class Generation : bool {
+        Young,
+        Old,
+    };
+    Generation generation() const { return m_generation; }
+    void set_generation(Badge<Heap>, Generation generation) { m_generation = generation; }
+
+    bool has_write_barriers() const { return m_has_write_barriers; }
+    void set_has_write_barriers(Badge<Heap>) { m_has_write_barriers = true; }
+
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(Badge<Heap>, bool remembered) { m_remembered = remembered; }
+
+    // Must be called after storing a reference to `new_edge` in an already constructed cell.
+    // If an old cell gains an edge to a young cell, the next young generation collection has to visit it.
+    // If a cell that incremental marking has already reached gains an edge to an unmarked cell, marking has
+    // to visit it again before it finishes.
+    ALWAYS_INLINE void write_barrier(Cell const* new_edge)
+    {
+        if ((m_generation == Generation::Old || m_mark) && !m_remembered && new_edge)
+            remember_if_necessary(*new_edge);
+    }
+
+    ALWAYS_INLINE void write_barrier(Value new_edge)
+    {
+        if (new_edge.is_cell())
+            write_barrier(&new_edge.as_cell());
+    }
+
+    // Like write_barrier(), for when we can't tell which edges are about to be stored,
+    // e.g. when handing out mutable access to a container of values.
+    ALWAYS_INLINE void write_barrier_for_unknown_edges()
+    {
+        if ((m_generation == Generation::Old || m_mark) && !m_remembered)
+            remember();
+    }
+
     virtual StringView class_name() const = 0;
 
     class Visitor {
@@ -151,6 +201,8 @@ public:
     virtual void visit_edges(Visitor&) { }
 
     // This will be called on unmarked objects by the garbage collector in a separate pass before destruction.
+    // NOTE: Blocks are swept lazily, so the destructor may run long after this. Anything that could hand out
+    //       the cell to someone else, like a global registry, has to forget it here rather than in the destructor.
     virtual void finalize() { }
 
     // This allows cells to survive GC by choice, even if nothing points to them.
@@ -169,9 +221,15 @@ protected:
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
 private:
+    void remember();
+    void remember_if_necessary(Cell const& new_edge);
+
     bool m_mark : 1 { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
-    State m_state : 1 { State::Live };
+    State m_state : 2 { State::Live };
+    Generation m_generation : 1 { Generation::Young };
+    bool m_remembered : 1 { false };
+    bool m_has_write_barriers : 1 { false };
 };
 
 }
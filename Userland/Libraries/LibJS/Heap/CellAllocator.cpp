@@ -23,6 +23,16 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     if (!m_list_node.is_in_list())
         heap.register_cell_allocator({}, *this);
 
+    while (m_usable_blocks.is_empty() && !m_unswept_blocks.is_empty()) {
+        auto& block = *m_unswept_blocks.first();
+        block.sweep();
+        // NOTE: Even a block without live cells is worth keeping here, since we're about to allocate from it.
+        if (block.is_full())
+            m_full_blocks.append(block);
+        else
+            m_usable_blocks.append(block);
+    }
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, *this, m_cell_size, m_class_name);
         auto block_ptr = reinterpret_cast<FlatPtr>(block.ptr());
@@ -42,6 +52,11 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
 }
 
 void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
+{
+    deallocate_block(block);
+}
+
+void CellAllocator::deallocate_block(HeapBlock& block)
 {
     block.m_list_node.remove();
     // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
@@ -55,4 +70,24 @@ void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
     m_usable_blocks.append(block);
 }
 
+void CellAllocator::block_needs_sweeping(Badge<Heap>, HeapBlock& block)
+{
+    m_unswept_blocks.append(block);
+}
+
+bool CellAllocator::sweep_next_unswept_block(Badge<Heap>)
+{
+    if (m_unswept_blocks.is_empty())
+        return false;
+
+    auto& block = *m_unswept_blocks.first();
+    if (!block.sweep())
+        deallocate_block(block);
+    else if (block.is_full())
+        m_full_blocks.append(block);
+    else
+        m_usable_blocks.append(block);
+    return true;
+}
+
 }
@@ -41,11 +41,20 @@ public:
             if (callback(block) == IterationDecision::Break)
                 return IterationDecision::Break;
         }
+        for (auto& block : m_unswept_blocks) {
+            if (callback(block) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
         return IterationDecision::Continue;
     }
 
     void block_did_become_empty(Badge<Heap>, HeapBlock&);
     void block_did_become_usable(Badge<Heap>, HeapBlock&);
+    void block_needs_sweeping(Badge<Heap>, HeapBlock&);
+
+    // Sweeps one of the blocks that the last full collection left unswept, and returns it to the system if it
+    // has no live cells left. Returns false if there were none.
+    bool sweep_next_unswept_block(Badge<Heap>);
 
     IntrusiveListNode<CellAllocator> m_list_node;
     using List = IntrusiveList<&CellAllocator::m_list_node>;
@@ -55,6 +64,8 @@ public:
     FlatPtr max_block_address() const { return m_max_block_address; }
 
 private:
+    void deallocate_block(HeapBlock&);
+
     char const* const m_class_name { nullptr };
     size_t const m_cell_size;
 
@@ -63,6 +74,9 @@ private:
     using BlockList = IntrusiveList<&HeapBlock::m_list_node>;
     BlockList m_full_blocks;
     BlockList m_usable_blocks;
+    // Blocks with cells that a full collection found unreachable. They're swept once allocation needs the room,
+    // during idle time, or at the start of the next full collection, whichever comes first.
+    BlockList m_unswept_blocks;
     FlatPtr m_min_block_address { explode_byte(0xff) };
     FlatPtr m_max_block_address { 0 };
 };
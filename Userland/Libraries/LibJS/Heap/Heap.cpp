@@ -71,15 +71,33 @@ void Heap::will_allocate(size_t size)
 {
     if (should_collect_on_every_allocation()) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
-    } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
+        // NOTE: Alternate between collection types, so that both the write barriers and the full collector get exercised.
+        if (m_forced_collection_count++ % 2)
+            collect_garbage(CollectionType::CollectYoungGeneration);
+        else
+            collect_garbage();
+    } else if (m_allocated_bytes_since_last_gc + size > GC_YOUNG_GENERATION_BYTES_THRESHOLD) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(collection_type_for_allocation());
     }
 
     m_allocated_bytes_since_last_gc += size;
 }
 
+Heap::CollectionType Heap::collection_type_for_allocation() const
+{
+    // Young generation collections can't run while incremental marking is in progress, so finish it instead.
+    if (is_incremental_marking_in_progress())
+        return CollectionType::CollectGarbage;
+
+    // Young generation collections assume that everything old is still alive, so we still need a full
+    // collection every now and then. Do one whenever the old generation has grown past the live heap size
+    // we saw after the last full collection.
+    if (m_promoted_bytes_since_last_full_gc + m_allocated_bytes_since_last_gc > m_gc_bytes_threshold)
+        return CollectionType::CollectGarbage;
+    return CollectionType::CollectYoungGeneration;
+}
+
 static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
 {
     if constexpr (sizeof(FlatPtr*) == sizeof(Value)) {
@@ -270,20 +288,50 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
 #endif
 
     Core::ElapsedTimer collection_measurement_timer;
-    if (print_report)
-        collection_measurement_timer.start();
+    collection_measurement_timer.start();
 
-    if (collection_type == CollectionType::CollectGarbage) {
+    if (is_incremental_marking_in_progress()) {
+        if (collection_type == CollectionType::CollectEverything)
+            cancel_incremental_marking();
+        else
+            collection_type = CollectionType::CollectGarbage;
+    }
+    if (collection_type == CollectionType::CollectYoungGeneration && !can_rely_on_write_barriers())
+        collection_type = CollectionType::CollectGarbage;
+    bool finishes_incremental_marking = is_incremental_marking_in_progress();
+
+    if (collection_type != CollectionType::CollectEverything) {
         if (m_gc_deferrals) {
             m_should_gc_when_deferral_ends = true;
             return;
         }
         HashMap<Cell*, HeapRoot> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        if (collection_type == CollectionType::CollectYoungGeneration)
+            mark_live_young_cells(roots);
+        else if (is_incremental_marking_in_progress())
+            finish_incremental_marking(roots);
+        else
+            mark_live_cells(roots);
     }
-    finalize_unmarked_cells();
-    sweep_dead_cells(print_report, collection_measurement_timer);
+    forget_remembered_cells();
+
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        finalize_unmarked_young_cells();
+        sweep_dead_young_cells(print_report, collection_measurement_timer);
+    } else {
+        finalize_unmarked_cells();
+        sweep_dead_cells(collection_type, print_report, collection_measurement_timer);
+    }
+
+    if (collection_type == CollectionType::CollectYoungGeneration)
+        update_collection_statistics(m_young_generation_collection_statistics, collection_measurement_timer);
+    else if (finishes_incremental_marking)
+        update_collection_statistics(m_incremental_collection_final_pause_statistics, collection_measurement_timer);
+    else
+        update_collection_statistics(m_full_collection_statistics, collection_measurement_timer);
+    if (print_report)
+        dump_collection_statistics();
 }
 
 void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
@@ -389,8 +437,15 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    enum class Mode {
+        AllCells,
+        // Old cells are assumed to be live, so we don't mark them or follow their edges.
+        YoungCellsOnly,
+    };
+
+    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, Mode mode = Mode::AllCells)
         : m_heap(heap)
+        , m_mode(mode)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
         m_heap.for_each_block([&](auto& block) {
@@ -407,6 +462,10 @@ public:
     {
         if (cell.is_marked())
             return;
+        // NOTE: A live cell pointing to an unswept one means that something handed out a dead cell, see Cell::finalize().
+        VERIFY(cell.state() == Cell::State::Live);
+        if (m_mode == Mode::YoungCellsOnly && cell.generation() == Cell::Generation::Old)
+            return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
         cell.set_marked(true);
@@ -426,6 +485,8 @@ public:
                 return;
             if (cell->state() != Cell::State::Live)
                 return;
+            if (m_mode == Mode::YoungCellsOnly && cell->generation() == Cell::Generation::Old)
+                return;
             cell->set_marked(true);
             m_work_queue.append(*cell);
         });
@@ -438,8 +499,24 @@ public:
         }
     }
 
+    // Returns true if there's nothing left to mark.
+    bool mark_live_cells_until(Core::ElapsedTimer const& timer, AK::Duration time_budget)
+    {
+        // NOTE: Reading the clock costs about as much as visiting a few cells, so we only check it every now and then.
+        static constexpr size_t cells_to_visit_between_deadline_checks = 256;
+
+        size_t visited_cells = 0;
+        while (!m_work_queue.is_empty()) {
+            m_work_queue.take_last()->visit_edges(*this);
+            if (++visited_cells % cells_to_visit_between_deadline_checks == 0 && timer.elapsed_time() >= time_budget)
+                return m_work_queue.is_empty();
+        }
+        return true;
+    }
+
 private:
     Heap& m_heap;
+    Mode m_mode { Mode::AllCells };
     Vector<NonnullGCPtr<Cell>> m_work_queue;
     HashTable<HeapBlock*> m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
@@ -460,6 +537,141 @@ void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
     m_uprooted_cells.clear();
 }
 
+void Heap::mark_live_young_cells(HashMap<Cell*, HeapRoot> const& roots)
+{
+    dbgln_if(HEAP_DEBUG, "mark_live_young_cells:");
+
+    VERIFY(can_rely_on_write_barriers());
+    MarkingVisitor visitor(*this, roots, MarkingVisitor::Mode::YoungCellsOnly);
+
+    // Old cells may point to young ones. Their write barriers have told us which ones gained such an edge.
+    for (auto* cell : m_remembered_cells)
+        cell->visit_edges(visitor);
+
+    visitor.mark_all_live_cells();
+
+    m_uprooted_cells.remove_all_matching([](auto& cell) {
+        if (cell->generation() == Cell::Generation::Old)
+            return false;
+        cell->set_marked(false);
+        return true;
+    });
+}
+
+void Heap::start_incremental_marking()
+{
+    if (is_incremental_marking_in_progress() || !can_rely_on_write_barriers())
+        return;
+
+    VERIFY(!m_collecting_garbage);
+    TemporaryChange change(m_collecting_garbage, true);
+
+    dbgln_if(HEAP_DEBUG, "start_incremental_marking:");
+
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+
+    m_young_cell_count_at_start_of_incremental_marking = m_young_cells.size();
+    m_incremental_marking_visitor = make<MarkingVisitor>(*this, roots);
+}
+
+bool Heap::perform_incremental_marking_slice(AK::Duration time_budget)
+{
+    if (!is_incremental_marking_in_progress())
+        return true;
+
+    VERIFY(!m_collecting_garbage);
+    TemporaryChange change(m_collecting_garbage, true);
+
+    Core::ElapsedTimer slice_measurement_timer;
+    slice_measurement_timer.start();
+    bool is_done = m_incremental_marking_visitor->mark_live_cells_until(slice_measurement_timer, time_budget);
+    update_collection_statistics(m_incremental_marking_slice_statistics, slice_measurement_timer);
+    return is_done;
+}
+
+void Heap::perform_incremental_garbage_collection_work(AK::Duration time_budget)
+{
+    if (m_gc_deferrals || m_collecting_garbage)
+        return;
+
+    Core::ElapsedTimer timer;
+    timer.start();
+
+    // Sweeping what the last full collection left behind comes first, since it may return blocks to the system.
+    if (!sweep_until(timer, time_budget))
+        return;
+
+    if (!is_incremental_marking_in_progress()) {
+        // Get a head start once we're halfway to the next full collection.
+        if (m_promoted_bytes_since_last_full_gc + m_allocated_bytes_since_last_gc < m_gc_bytes_threshold / 2)
+            return;
+        start_incremental_marking();
+        if (!is_incremental_marking_in_progress())
+            return;
+    }
+
+    if (!perform_incremental_marking_slice(time_budget - timer.elapsed_time()))
+        return;
+
+    // Everything reachable has been marked, so we might as well finish the collection while we're idle.
+    m_allocated_bytes_since_last_gc = 0;
+    collect_garbage();
+}
+
+void Heap::finish_incremental_marking(HashMap<Cell*, HeapRoot> const& roots)
+{
+    dbgln_if(HEAP_DEBUG, "finish_incremental_marking:");
+
+    // NOTE: Nothing has been promoted since marking started, since every collection finishes it first.
+    VERIFY(can_rely_on_write_barriers());
+    auto visitor = m_incremental_marking_visitor.release_nonnull();
+
+    // The roots may have changed since marking started, and they don't have write barriers.
+    for (auto* root : roots.keys())
+        visitor->visit(root);
+
+    // Marked cells that were written to since they were reached may point to cells that we haven't marked yet.
+    for (auto* cell : m_remembered_cells) {
+        if (cell->is_marked())
+            cell->visit_edges(*visitor);
+    }
+    for (size_t i = 0; i < m_young_cell_count_at_start_of_incremental_marking; ++i) {
+        auto* cell = m_young_cells[i];
+        if (cell->is_marked() && !cell->has_write_barriers())
+            cell->visit_edges(*visitor);
+    }
+
+    // Cells allocated while marking was in progress are kept alive until the next collection.
+    for (size_t i = m_young_cell_count_at_start_of_incremental_marking; i < m_young_cells.size(); ++i)
+        visitor->visit(m_young_cells[i]);
+
+    visitor->mark_all_live_cells();
+
+    for (auto& inverse_root : m_uprooted_cells)
+        inverse_root->set_marked(false);
+
+    m_uprooted_cells.clear();
+}
+
+void Heap::cancel_incremental_marking()
+{
+    m_incremental_marking_visitor = nullptr;
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
+}
+
+void Heap::forget_remembered_cells()
+{
+    for (auto* cell : m_remembered_cells)
+        cell->set_remembered({}, false);
+    m_remembered_cells.clear_with_capacity();
+}
+
 bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
 {
     if (!cell.overrides_must_survive_garbage_collection({}))
@@ -478,52 +690,140 @@ void Heap::finalize_unmarked_cells()
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::finalize_unmarked_young_cells()
+{
+    for (auto* cell : m_young_cells) {
+        if (cell->state() == Cell::State::Live && !cell->is_marked() && !cell_must_survive_garbage_collection(*cell))
+            cell->finalize();
+    }
+}
+
+void Heap::promote_to_old_generation(Cell& cell)
+{
+    cell.set_generation({}, Cell::Generation::Old);
+    if (!cell.has_write_barriers())
+        ++m_old_cell_without_write_barriers_count;
+}
+
+void Heap::sweep_dead_young_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+{
+    dbgln_if(HEAP_DEBUG, "sweep_dead_young_cells:");
+
+    // The blocks we freed cells in, and whether they were full before that.
+    HashMap<HeapBlock*, bool> affected_blocks;
+
+    size_t collected_cells = 0;
+    size_t live_cells = 0;
+    size_t collected_cell_bytes = 0;
+    size_t live_cell_bytes = 0;
+
+    for (auto* cell : m_young_cells) {
+        if (cell->state() != Cell::State::Live)
+            continue;
+        auto* block = HeapBlock::from_cell(cell);
+        if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
+            dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+            affected_blocks.ensure(block, [&] { return block->is_full(); });
+            block->deallocate(cell);
+            ++collected_cells;
+            collected_cell_bytes += block->cell_size();
+        } else {
+            cell->set_marked(false);
+            promote_to_old_generation(*cell);
+            ++live_cells;
+            live_cell_bytes += block->cell_size();
+        }
+    }
+    m_young_cells.clear_with_capacity();
+    m_promoted_bytes_since_last_full_gc += live_cell_bytes;
+
+    for (auto& weak_container : m_weak_containers)
+        weak_container.remove_dead_cells({});
+
+    size_t freed_blocks = 0;
+    for (auto [block, block_was_full] : affected_blocks) {
+        bool block_has_live_cells = false;
+        block->for_each_cell_in_state<Cell::State::Live>([&](Cell*) {
+            block_has_live_cells = true;
+        });
+        if (!block_has_live_cells) {
+            dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
+            block->cell_allocator().block_did_become_empty({}, *block);
+            ++freed_blocks;
+        } else if (block_was_full) {
+            dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
+            block->cell_allocator().block_did_become_usable({}, *block);
+        }
+    }
+
+    if (print_report) {
+        Duration const time_spent = measurement_timer.elapsed_time();
+
+        dbgln("Garbage collection report (young generation)");
+        dbgln("=============================================");
+        dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
+        dbgln("Surviving cells: {} ({} bytes)", live_cells, live_cell_bytes);
+        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        dbgln("   Freed blocks: {} ({} bytes)", freed_blocks, freed_blocks * HeapBlock::block_size);
+        dbgln("=============================================");
+    }
+}
+
+void Heap::sweep_dead_cells(CollectionType collection_type, bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
-    Vector<HeapBlock*, 32> empty_blocks;
-    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
+
+    // This collection decides anew which blocks need sweeping, so finish with whatever the last one left behind.
+    finish_sweeping();
+
+    // NOTE: We only find out which cells are dead here, and leave destroying them to whoever needs the room in
+    //       their block next (see CellAllocator). Finalizers have already run on this thread, and dead cells can
+    //       no longer be reached through weak containers and WeakPtrs once we're done.
+    Vector<HeapBlock*, 32> blocks_that_need_sweeping;
 
     size_t collected_cells = 0;
     size_t live_cells = 0;
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
 
+    m_old_cell_without_write_barriers_count = 0;
+
     for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
-        bool block_was_full = block.is_full();
+        bool block_has_dead_cells = false;
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
             if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
+                cell->set_state(Cell::State::Unswept);
+                cell->revoke_weak_ptrs({});
+                block_has_dead_cells = true;
                 ++collected_cells;
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
-                block_has_live_cells = true;
+                promote_to_old_generation(*cell);
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
             }
         });
-        if (!block_has_live_cells)
-            empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
+        if (block_has_dead_cells)
+            blocks_that_need_sweeping.append(&block);
         return IterationDecision::Continue;
     });
 
+    m_young_cells.clear_with_capacity();
+    m_promoted_bytes_since_last_full_gc = 0;
+
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
 
-    for (auto* block : empty_blocks) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
-        block->cell_allocator().block_did_become_empty({}, *block);
+    for (auto* block : blocks_that_need_sweeping) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock needs sweeping @ {}: cell_size={}", block, block->cell_size());
+        block->cell_allocator().block_needs_sweeping({}, *block);
     }
 
-    for (auto* block : full_blocks_that_became_usable) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
-        block->cell_allocator().block_did_become_usable({}, *block);
-    }
+    // Nothing will ever allocate from this heap again, so don't leave anything for later.
+    if (collection_type == CollectionType::CollectEverything)
+        finish_sweeping();
 
     if constexpr (HEAP_DEBUG) {
         for_each_block([&](auto& block) {
@@ -542,17 +842,62 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
             return IterationDecision::Continue;
         });
 
-        dbgln("Garbage collection report");
+        dbgln("Garbage collection report (full)");
         dbgln("=============================================");
         dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
         dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
-        dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        dbgln("Blocks to sweep: {} ({} bytes)", blocks_that_need_sweeping.size(), blocks_that_need_sweeping.size() * HeapBlock::block_size);
         dbgln("=============================================");
     }
 }
 
+void Heap::finish_sweeping()
+{
+    for (auto& allocator : m_all_cell_allocators) {
+        while (allocator.sweep_next_unswept_block({}))
+            ;
+    }
+}
+
+bool Heap::sweep_until(Core::ElapsedTimer const& timer, AK::Duration time_budget)
+{
+    for (auto& allocator : m_all_cell_allocators) {
+        while (allocator.sweep_next_unswept_block({})) {
+            if (timer.elapsed_time() >= time_budget)
+                return false;
+        }
+    }
+    return true;
+}
+
+void Heap::update_collection_statistics(CollectionStatistics& statistics, Core::ElapsedTimer const& measurement_timer)
+{
+    auto time_spent = measurement_timer.elapsed_time().to_microseconds();
+    ++statistics.count;
+    statistics.total_time_in_microseconds += time_spent;
+    statistics.max_time_in_microseconds = max(statistics.max_time_in_microseconds, time_spent);
+}
+
+void Heap::dump_collection_statistics() const
+{
+    auto dump = [](StringView name, CollectionStatistics const& statistics) {
+        auto average = statistics.count ? statistics.total_time_in_microseconds / static_cast<i64>(statistics.count) : 0;
+        dbgln("{}: {} collections, {} ms total, {} us average, {} us max",
+            name,
+            statistics.count,
+            statistics.total_time_in_microseconds / 1000,
+            average,
+            statistics.max_time_in_microseconds);
+    };
+    dump("   Young generation pauses"sv, m_young_generation_collection_statistics);
+    dump("               Full pauses"sv, m_full_collection_statistics);
+    dump("  Incremental final pauses"sv, m_incremental_collection_final_pause_statistics);
+    dump("Incremental marking slices"sv, m_incremental_marking_slice_statistics);
+    dbgln("=============================================");
+}
+
 void Heap::defer_gc()
 {
     ++m_gc_deferrals;
@@ -565,7 +910,7 @@ void Heap::undefer_gc()
 
     if (!m_gc_deferrals) {
         if (m_should_gc_when_deferral_ends)
-            collect_garbage();
+            collect_garbage(collection_type_for_allocation());
         m_should_gc_when_deferral_ends = false;
     }
 }
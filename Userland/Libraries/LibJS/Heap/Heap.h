@@ -11,6 +11,8 @@
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -28,6 +30,8 @@
 
 namespace JS {
 
+class MarkingVisitor;
+
 class Heap : public HeapBase {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -42,6 +46,7 @@ public:
         auto* memory = allocate_cell<T>();
         defer_gc();
         new (memory) T(forward<Args>(args)...);
+        did_construct_cell<T>(*memory);
         undefer_gc();
         return *static_cast<T*>(memory);
     }
@@ -52,6 +57,7 @@ public:
         auto* memory = allocate_cell<T>();
         defer_gc();
         new (memory) T(forward<Args>(args)...);
+        did_construct_cell<T>(*memory);
         undefer_gc();
         auto* cell = static_cast<T*>(memory);
         memory->initialize(realm);
@@ -61,11 +67,25 @@ public:
     enum class CollectionType {
         CollectGarbage,
         CollectEverything,
+        // Only collects cells allocated since the last collection. Old cells are assumed to be live.
+        CollectYoungGeneration,
     };
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
     AK::JsonObject dump_graph();
 
+    // Spends up to `time_budget` on garbage collection work, e.g. while the event loop is idle.
+    // That is sweeping the blocks that the last full collection left unswept, and then the next full collection.
+    // Its marking phase is spread out over as many of these slices as it takes, so that the collection
+    // itself only has to catch up with what changed in between.
+    void perform_incremental_garbage_collection_work(AK::Duration time_budget);
+
+    // Does nothing while there are old cells without write barriers, see can_rely_on_write_barriers().
+    void start_incremental_marking();
+    // Returns true once there is nothing left to mark, at which point the next collection can finish the job.
+    bool perform_incremental_marking_slice(AK::Duration time_budget);
+    bool is_incremental_marking_in_progress() const { return m_incremental_marking_visitor; }
+
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
@@ -88,6 +108,18 @@ public:
 
     void uproot_cell(Cell* cell);
 
+    void did_remember_cell(Badge<Cell>, Cell&);
+
+    // NOTE: This includes cells that are no longer reachable but haven't been collected yet.
+    template<typename Callback>
+    void for_each_live_cell(Callback callback)
+    {
+        for_each_block([&](auto& block) {
+            block.template for_each_cell_in_state<Cell::State::Live>(callback);
+            return IterationDecision::Continue;
+        });
+    }
+
 private:
     friend class MarkingVisitor;
     friend class GraphConstructorVisitor;
@@ -102,23 +134,75 @@ private:
     Cell* allocate_cell()
     {
         will_allocate(sizeof(T));
-        if constexpr (requires { T::cell_allocator.allocator.get().allocate_cell(*this); }) {
-            if constexpr (IsSame<T, typename decltype(T::cell_allocator)::CellType>) {
-                return T::cell_allocator.allocator.get().allocate_cell(*this);
+        Cell* cell = [&] {
+            if constexpr (requires { T::cell_allocator.allocator.get().allocate_cell(*this); }) {
+                if constexpr (IsSame<T, typename decltype(T::cell_allocator)::CellType>) {
+                    return T::cell_allocator.allocator.get().allocate_cell(*this);
+                }
+            }
+            return allocator_for_size(sizeof(T)).allocate_cell(*this);
+        }();
+        m_young_cells.append(cell);
+        return cell;
+    }
+
+    template<typename T>
+    void did_construct_cell(Cell& cell)
+    {
+        if constexpr (cell_type_has_write_barriers<T>())
+            cell.set_has_write_barriers({});
+    }
+
+    template<typename T>
+    static consteval bool cell_type_has_write_barriers()
+    {
+        if constexpr (IsSame<T, Cell>) {
+            return true;
+        } else {
+            if constexpr (requires { typename T::WriteBarrieredCellType; }) {
+                if constexpr (IsSame<T, typename T::WriteBarrieredCellType>)
+                    return true;
             }
+            // A class that doesn't visit any edges of its own has none to store either, so it has write barriers
+            // if its base class does.
+            if constexpr (IsSame<decltype(&T::visit_edges), decltype(&T::Base::visit_edges)>)
+                return cell_type_has_write_barriers<typename T::Base>();
+            return false;
         }
-        return allocator_for_size(sizeof(T)).allocate_cell(*this);
     }
 
     void will_allocate(size_t);
+    CollectionType collection_type_for_allocation() const;
+
+    // Young generation collections and incremental marking find the edges that old cells gained through write
+    // barriers, so they can only run while every old cell has them.
+    bool can_rely_on_write_barriers() const { return m_old_cell_without_write_barriers_count == 0; }
 
     void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
     void gather_roots(HashMap<Cell*, HeapRoot>&);
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
     void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_live_young_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void finish_incremental_marking(HashMap<Cell*, HeapRoot> const& live_cells);
+    void cancel_incremental_marking();
+    void forget_remembered_cells();
     void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void finalize_unmarked_young_cells();
+    void sweep_dead_cells(CollectionType, bool print_report, Core::ElapsedTimer const&);
+    void sweep_dead_young_cells(bool print_report, Core::ElapsedTimer const&);
+    void promote_to_old_generation(Cell&);
+    void finish_sweeping();
+    // Returns true once every block has been swept.
+    bool sweep_until(Core::ElapsedTimer const&, AK::Duration time_budget);
+
+    struct CollectionStatistics {
+        size_t count { 0 };
+        i64 total_time_in_microseconds { 0 };
+        i64 max_time_in_microseconds { 0 };
+    };
+    static void update_collection_statistics(CollectionStatistics&, Core::ElapsedTimer const&);
+    void dump_collection_statistics() const;
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -141,10 +225,36 @@ private:
     }
 
     static constexpr size_t GC_MIN_BYTES_THRESHOLD { 4 * 1024 * 1024 };
+    static constexpr size_t GC_YOUNG_GENERATION_BYTES_THRESHOLD { 4 * 1024 * 1024 };
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
 
+    // Bytes promoted to the old generation since the last full collection.
+    // Once this outgrows the live heap, the next collection is a full one.
+    size_t m_promoted_bytes_since_last_full_gc { 0 };
+
     bool m_should_collect_on_every_allocation { false };
+    size_t m_forced_collection_count { 0 };
+
+    // Every cell allocated since the last collection, in allocation order.
+    Vector<Cell*> m_young_cells;
+
+    // Old cells that have gained an edge to a young cell since the last collection.
+    Vector<Cell*> m_remembered_cells;
+
+    // Old cells whose edges can change without a write barrier. Only full collections run while there are any.
+    size_t m_old_cell_without_write_barriers_count { 0 };
+
+    CollectionStatistics m_young_generation_collection_statistics;
+    CollectionStatistics m_full_collection_statistics;
+    CollectionStatistics m_incremental_collection_final_pause_statistics;
+    CollectionStatistics m_incremental_marking_slice_statistics;
+
+    // Holds the marking work list between slices while incremental marking is in progress.
+    OwnPtr<MarkingVisitor> m_incremental_marking_visitor;
+
+    // Cells allocated after this index in m_young_cells were allocated while incremental marking was in progress.
+    size_t m_young_cell_count_at_start_of_incremental_marking { 0 };
 
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
     CellAllocator::List m_all_cell_allocators;
@@ -215,4 +325,16 @@ inline void Heap::register_cell_allocator(Badge<CellAllocator>, CellAllocator& a
     m_all_cell_allocators.append(allocator);
 }
 
+inline void Heap::did_remember_cell(Badge<Cell>, Cell& cell)
+{
+    // NOTE: Edges stored while we're collecting garbage (e.g. by finalizers) can only point to cells that are
+    //       either about to die or about to be promoted, so there's nothing to remember. The cell itself
+    //       might also be about to die, so we can't keep a pointer to it.
+    if (m_collecting_garbage) {
+        cell.set_remembered({}, false);
+        return;
+    }
+    m_remembered_cells.append(&cell);
+}
+
 }
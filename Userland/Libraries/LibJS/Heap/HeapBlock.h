@@ -50,6 +50,9 @@ public:
 
     void deallocate(Cell*);
 
+    // Destroys the cells that the last full collection left unswept. Returns whether any live cells remain.
+    bool sweep();
+
     template<typename Callback>
     void for_each_cell(Callback callback)
     {
@@ -15,6 +15,9 @@ namespace JS {
 template<typename T>
 class HeapFunction final : public JS::Cell {
     JS_CELL(HeapFunction, Cell);
+    // NOTE: The captures are only stored on construction. A mutable callable may move them out, but must not store
+    //       other cells in them.
+    JS_CELL_HAS_WRITE_BARRIERS(HeapFunction);
 
 public:
     static NonnullGCPtr<HeapFunction> create(Heap& heap, Function<T> function)
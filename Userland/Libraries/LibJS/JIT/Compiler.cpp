@@ -0,0 +1,789 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibJS/Bytecode/CommonImplementations.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/ValueInlines.h>
+#include <stdlib.h>
+
+namespace JS::JIT {
+
+bool Compiler::is_enabled()
+{
+    static bool const enabled = getenv("LIBJS_JIT") != nullptr;
+    return enabled;
+}
+
+#ifdef JIT_ARCH_SUPPORTED
+
+// Instructions without an inline fast path, which are compiled into a call to their execute_impl().
+#    define JS_ENUMERATE_JIT_GENERIC_OPS(O) \
+        O(ArrayAppend)                      \
+        O(AsyncIteratorClose)               \
+        O(BitwiseAnd)                       \
+        O(BitwiseNot)                       \
+        O(BitwiseOr)                        \
+        O(BitwiseXor)                       \
+        O(BlockDeclarationInstantiation)    \
+        O(Call)                             \
+        O(CallById)                         \
+        O(CallWithArgumentArray)            \
+        O(Catch)                            \
+        O(ConcatString)                     \
+        O(CopyObjectExcludingProperties)    \
+        O(CreateLexicalEnvironment)         \
+        O(CreateVariable)                   \
+        O(DeleteById)                       \
+        O(DeleteByIdWithThis)               \
+        O(DeleteByValue)                    \
+        O(DeleteByValueWithThis)            \
+        O(DeleteVariable)                   \
+        O(Div)                              \
+        O(Dump)                             \
+        O(EnterObjectEnvironment)           \
+        O(Exp)                              \
+        O(GetById)                          \
+        O(GetByIdWithThis)                  \
+        O(GetByValue)                       \
+        O(GetByValueWithThis)               \
+        O(GetCalleeAndThisFromEnvironment)  \
+        O(GetGlobal)                        \
+        O(GetImportMeta)                    \
+        O(GetIterator)                      \
+        O(GetMethod)                        \
+        O(GetNewTarget)                     \
+        O(GetNextMethodFromIteratorRecord)  \
+        O(GetObjectFromIteratorRecord)      \
+        O(GetObjectPropertyIterator)        \
+        O(GetPrivateById)                   \
+        O(GetVariable)                      \
+        O(HasPrivateId)                     \
+        O(ImportCall)                       \
+        O(In)                               \
+        O(IncrementById)                    \
+        O(InstanceOf)                       \
+        O(IteratorClose)                    \
+        O(IteratorNext)                     \
+        O(IteratorToArray)                  \
+        O(LeaveFinally)                     \
+        O(LeaveLexicalEnvironment)          \
+        O(LeaveUnwindContext)               \
+        O(LeftShift)                        \
+        O(LooselyEquals)                    \
+        O(LooselyInequals)                  \
+        O(Mod)                              \
+        O(Mul)                              \
+        O(NewArray)                         \
+        O(NewClass)                         \
+        O(NewFunction)                      \
+        O(NewObject)                        \
+        O(NewPrimitiveArray)                \
+        O(NewRegExp)                        \
+        O(NewTypeError)                     \
+        O(Not)                              \
+        O(PostfixDecrement)                 \
+        O(PostfixIncrement)                 \
+        O(PutById)                          \
+        O(PutByIdWithThis)                  \
+        O(PutByValue)                       \
+        O(PutByValueWithThis)               \
+        O(PutPrivateById)                   \
+        O(ResolveSuperBase)                 \
+        O(ResolveThisBinding)               \
+        O(RestoreScheduledJump)             \
+        O(RightShift)                       \
+        O(SetVariable)                      \
+        O(StrictlyEquals)                   \
+        O(StrictlyInequals)                 \
+        O(SuperCallWithArgumentArray)       \
+        O(Throw)                            \
+        O(ThrowIfNotObject)                 \
+        O(ThrowIfNullish)                   \
+        O(ThrowIfTDZ)                       \
+        O(Typeof)                           \
+        O(TypeofVariable)                   \
+        O(UnaryMinus)                       \
+        O(UnaryPlus)                        \
+        O(UnsignedRightShift)
+
+using Bytecode::loosely_equals;
+using Bytecode::loosely_inequals;
+using Bytecode::strict_equals;
+using Bytecode::strict_inequals;
+
+void Compiler::load_operand(Assembler::Reg dst, Bytecode::Operand operand)
+{
+    switch (operand.type()) {
+    case Bytecode::Operand::Type::Register:
+        m_assembler.mov(
+            Assembler::Operand::Register(dst),
+            Assembler::Operand::Mem64BaseAndOffset(REGISTER_ARRAY_BASE, operand.index() * sizeof(Value)));
+        return;
+    case Bytecode::Operand::Type::Local:
+        m_assembler.mov(
+            Assembler::Operand::Register(dst),
+            Assembler::Operand::Mem64BaseAndOffset(LOCALS_ARRAY_BASE, operand.index() * sizeof(Value)));
+        return;
+    case Bytecode::Operand::Type::Constant:
+        // NOTE: Constants are kept alive by the executable, so we can bake them into the code.
+        m_assembler.mov(
+            Assembler::Operand::Register(dst),
+            Assembler::Operand::Imm(m_bytecode_executable.constants[operand.index()].encoded()));
+        return;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void Compiler::store_operand(Bytecode::Operand operand, Assembler::Reg src)
+{
+    switch (operand.type()) {
+    case Bytecode::Operand::Type::Register:
+        m_assembler.mov(
+            Assembler::Operand::Mem64BaseAndOffset(REGISTER_ARRAY_BASE, operand.index() * sizeof(Value)),
+            Assembler::Operand::Register(src));
+        return;
+    case Bytecode::Operand::Type::Local:
+        m_assembler.mov(
+            Assembler::Operand::Mem64BaseAndOffset(LOCALS_ARRAY_BASE, operand.index() * sizeof(Value)),
+            Assembler::Operand::Register(src));
+        return;
+    case Bytecode::Operand::Type::Constant:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void Compiler::store_program_counter()
+{
+    m_assembler.mov(
+        Assembler::Operand::Register(GPR0),
+        Assembler::Operand::Imm(m_current_offset));
+    m_assembler.mov(
+        Assembler::Operand::Mem64BaseAndOffset(PROGRAM_COUNTER, 0),
+        Assembler::Operand::Register(GPR0));
+}
+
+void Compiler::branch_if_not_int32(Assembler::Reg value, Assembler::Label& not_int32)
+{
+    // GPR2 = value >> 48
+    m_assembler.mov(Assembler::Operand::Register(GPR2), Assembler::Operand::Register(value));
+    m_assembler.shift_right(Assembler::Operand::Register(GPR2), Assembler::Operand::Imm(TAG_SHIFT));
+
+    // if (GPR2 != INT32_TAG) goto not_int32;
+    m_assembler.jump_if(
+        Assembler::Operand::Register(GPR2),
+        Assembler::Condition::NotEqualTo,
+        Assembler::Operand::Imm(INT32_TAG),
+        not_int32);
+}
+
+void Compiler::box_int32(Assembler::Reg value)
+{
+    // NOTE: This assumes that the upper 32 bits of `value` are zero, which is the case after any 32-bit operation.
+    m_assembler.mov(Assembler::Operand::Register(GPR2), Assembler::Operand::Imm(SHIFTED_INT32_TAG));
+    m_assembler.bitwise_or(Assembler::Operand::Register(value), Assembler::Operand::Register(GPR2));
+}
+
+void Compiler::test_to_boolean(Assembler::Reg value)
+{
+    Assembler::Label slow_case {};
+    Assembler::Label done {};
+
+    // OPTIMIZATION: Booleans are by far the most common condition, so test them inline.
+    m_assembler.mov(Assembler::Operand::Register(GPR1), Assembler::Operand::Register(value));
+    m_assembler.shift_right(Assembler::Operand::Register(GPR1), Assembler::Operand::Imm(TAG_SHIFT));
+    m_assembler.jump_if(
+        Assembler::Operand::Register(GPR1),
+        Assembler::Condition::NotEqualTo,
+        Assembler::Operand::Imm(BOOLEAN_TAG),
+        slow_case);
+    m_assembler.mov(Assembler::Operand::Register(RET), Assembler::Operand::Register(value));
+    m_assembler.bitwise_and(Assembler::Operand::Register(RET), Assembler::Operand::Imm(1));
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    m_assembler.mov(Assembler::Operand::Register(ARG0), Assembler::Operand::Register(value));
+    m_assembler.native_call(bit_cast<u64>(&to_boolean));
+
+    done.link(m_assembler);
+    m_assembler.test(Assembler::Operand::Register(RET), Assembler::Operand::Register(RET));
+}
+
+template<typename Helper>
+void Compiler::compile_helper_call(Bytecode::Instruction const& instruction, Helper helper)
+{
+    store_program_counter();
+    m_assembler.mov(Assembler::Operand::Register(ARG0), Assembler::Operand::Register(INTERPRETER));
+    m_assembler.mov(Assembler::Operand::Register(ARG1), Assembler::Operand::Imm(bit_cast<FlatPtr>(&instruction)));
+    m_assembler.native_call(bit_cast<u64>(helper));
+
+    // if (RET != nullptr) goto *RET;
+    m_assembler.test(Assembler::Operand::Register(RET), Assembler::Operand::Register(RET));
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, m_jump_to_continuation_label);
+}
+
+template<typename Helper>
+void Compiler::compile_helper_call_and_jump(Bytecode::Instruction const& instruction, Helper helper)
+{
+    store_program_counter();
+    m_assembler.mov(Assembler::Operand::Register(ARG0), Assembler::Operand::Register(INTERPRETER));
+    m_assembler.mov(Assembler::Operand::Register(ARG1), Assembler::Operand::Imm(bit_cast<FlatPtr>(&instruction)));
+    m_assembler.native_call(bit_cast<u64>(helper));
+    m_assembler.jump(Assembler::Operand::Register(RET));
+}
+
+Compiler::Assembler::Label* Compiler::label_for_offset(size_t bytecode_offset)
+{
+    auto it = m_block_labels.find(bytecode_offset);
+    if (it == m_block_labels.end())
+        return nullptr;
+    return &it->value;
+}
+
+void Compiler::compile_mov(Bytecode::Operand dst, Bytecode::Operand src)
+{
+    load_operand(GPR0, src);
+    store_operand(dst, GPR0);
+}
+
+void Compiler::compile_jump_if(Bytecode::Operand condition, Assembler::Label* true_target, Assembler::Label* false_target)
+{
+    load_operand(GPR0, condition);
+    test_to_boolean(GPR0);
+
+    if (true_target) {
+        m_assembler.jump_if(Assembler::Condition::NotEqualTo, *true_target);
+        if (false_target)
+            m_assembler.jump(*false_target);
+        return;
+    }
+    VERIFY(false_target);
+    m_assembler.jump_if(Assembler::Condition::EqualTo, *false_target);
+}
+
+void Compiler::compile_jump_nullish(Bytecode::Operand condition, Assembler::Label& true_target, Assembler::Label& false_target)
+{
+    load_operand(GPR0, condition);
+    m_assembler.shift_right(Assembler::Operand::Register(GPR0), Assembler::Operand::Imm(TAG_SHIFT));
+    m_assembler.bitwise_and(Assembler::Operand::Register(GPR0), Assembler::Operand::Imm(IS_NULLISH_EXTRACT_PATTERN));
+    m_assembler.jump_if(
+        Assembler::Operand::Register(GPR0),
+        Assembler::Condition::EqualTo,
+        Assembler::Operand::Imm(IS_NULLISH_PATTERN),
+        true_target);
+    m_assembler.jump(false_target);
+}
+
+void Compiler::compile_jump_undefined(Bytecode::Operand condition, Assembler::Label& true_target, Assembler::Label& false_target)
+{
+    load_operand(GPR0, condition);
+    m_assembler.mov(Assembler::Operand::Register(GPR1), Assembler::Operand::Imm(js_undefined().encoded()));
+    m_assembler.jump_if(
+        Assembler::Operand::Register(GPR0),
+        Assembler::Condition::EqualTo,
+        Assembler::Operand::Register(GPR1),
+        true_target);
+    m_assembler.jump(false_target);
+}
+
+void Compiler::compile_increment_or_decrement(Bytecode::Instruction const& instruction, Bytecode::Operand dst, bool is_increment)
+{
+    Assembler::Label slow_case {};
+    Assembler::Label done {};
+
+    load_operand(GPR0, dst);
+    branch_if_not_int32(GPR0, slow_case);
+    if (is_increment)
+        m_assembler.inc32(Assembler::Operand::Register(GPR0), slow_case);
+    else
+        m_assembler.dec32(Assembler::Operand::Register(GPR0), slow_case);
+    box_int32(GPR0);
+    store_operand(dst, GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    if (is_increment)
+        compile_helper_call(instruction, &execute_instruction<Bytecode::Op::Increment>);
+    else
+        compile_helper_call(instruction, &execute_instruction<Bytecode::Op::Decrement>);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_add_or_sub(Bytecode::Instruction const& instruction, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, bool is_add)
+{
+    Assembler::Label slow_case {};
+    Assembler::Label done {};
+
+    load_operand(GPR0, lhs);
+    load_operand(GPR1, rhs);
+    branch_if_not_int32(GPR0, slow_case);
+    branch_if_not_int32(GPR1, slow_case);
+    if (is_add)
+        m_assembler.add32(Assembler::Operand::Register(GPR0), Assembler::Operand::Register(GPR1), slow_case);
+    else
+        m_assembler.sub32(Assembler::Operand::Register(GPR0), Assembler::Operand::Register(GPR1), slow_case);
+    box_int32(GPR0);
+    store_operand(dst, GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    if (is_add)
+        compile_helper_call(instruction, &execute_instruction<Bytecode::Op::Add>);
+    else
+        compile_helper_call(instruction, &execute_instruction<Bytecode::Op::Sub>);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_relational_op(Bytecode::Instruction const& instruction, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, Assembler::Condition condition)
+{
+    Assembler::Label slow_case {};
+    Assembler::Label done {};
+
+    load_operand(GPR0, lhs);
+    load_operand(GPR1, rhs);
+    branch_if_not_int32(GPR0, slow_case);
+    branch_if_not_int32(GPR1, slow_case);
+    m_assembler.sign_extend_32_to_64_bits(GPR0);
+    m_assembler.sign_extend_32_to_64_bits(GPR1);
+    m_assembler.cmp(Assembler::Operand::Register(GPR0), Assembler::Operand::Register(GPR1));
+
+    // NOTE: mov doesn't touch the flags, and the low byte of the boolean tag is zero, so setcc completes the value.
+    m_assembler.mov(Assembler::Operand::Register(GPR0), Assembler::Operand::Imm(SHIFTED_BOOLEAN_TAG));
+    m_assembler.set_if(condition, Assembler::Operand::Register(GPR0));
+    store_operand(dst, GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    switch (instruction.type()) {
+    case Bytecode::Instruction::Type::LessThan:
+        compile_helper_call(instruction, &execute_instruction<Bytecode::Op::LessThan>);
+        break;
+    case Bytecode::Instruction::Type::LessThanEquals:
+        compile_helper_call(instruction, &execute_instruction<Bytecode::Op::LessThanEquals>);
+        break;
+    case Bytecode::Instruction::Type::GreaterThan:
+        compile_helper_call(instruction, &execute_instruction<Bytecode::Op::GreaterThan>);
+        break;
+    case Bytecode::Instruction::Type::GreaterThanEquals:
+        compile_helper_call(instruction, &execute_instruction<Bytecode::Op::GreaterThanEquals>);
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_relational_jump(Bytecode::Instruction const& instruction, Bytecode::Operand lhs, Bytecode::Operand rhs, Assembler::Condition condition, Assembler::Label& true_target, Assembler::Label& false_target)
+{
+    Assembler::Label slow_case {};
+
+    load_operand(GPR0, lhs);
+    load_operand(GPR1, rhs);
+    branch_if_not_int32(GPR0, slow_case);
+    branch_if_not_int32(GPR1, slow_case);
+    m_assembler.sign_extend_32_to_64_bits(GPR0);
+    m_assembler.sign_extend_32_to_64_bits(GPR1);
+    m_assembler.jump_if(
+        Assembler::Operand::Register(GPR0),
+        condition,
+        Assembler::Operand::Register(GPR1),
+        true_target);
+    m_assembler.jump(false_target);
+
+    slow_case.link(m_assembler);
+    switch (instruction.type()) {
+    case Bytecode::Instruction::Type::JumpLessThan:
+        compile_helper_call_and_jump(instruction, &compare_and_jump<Bytecode::Op::JumpLessThan, less_than>);
+        break;
+    case Bytecode::Instruction::Type::JumpLessThanEquals:
+        compile_helper_call_and_jump(instruction, &compare_and_jump<Bytecode::Op::JumpLessThanEquals, less_than_equals>);
+        break;
+    case Bytecode::Instruction::Type::JumpGreaterThan:
+        compile_helper_call_and_jump(instruction, &compare_and_jump<Bytecode::Op::JumpGreaterThan, greater_than>);
+        break;
+    case Bytecode::Instruction::Type::JumpGreaterThanEquals:
+        compile_helper_call_and_jump(instruction, &compare_and_jump<Bytecode::Op::JumpGreaterThanEquals, greater_than_equals>);
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+bool Compiler::compile_instruction(Bytecode::Instruction const& instruction)
+{
+    switch (instruction.type()) {
+    case Bytecode::Instruction::Type::Mov: {
+        auto const& op = static_cast<Bytecode::Op::Mov const&>(instruction);
+        compile_mov(op.dst(), op.src());
+        return true;
+    }
+    case Bytecode::Instruction::Type::SetLocal: {
+        auto const& op = static_cast<Bytecode::Op::SetLocal const&>(instruction);
+        compile_mov(op.dst(), op.src());
+        return true;
+    }
+    case Bytecode::Instruction::Type::End: {
+        auto const& op = static_cast<Bytecode::Op::End const&>(instruction);
+        load_operand(GPR0, op.value());
+        store_operand(Bytecode::Operand(Bytecode::Register::accumulator()), GPR0);
+        m_assembler.jump(m_exit_label);
+        return true;
+    }
+    case Bytecode::Instruction::Type::Jump: {
+        auto const& op = static_cast<Bytecode::Op::Jump const&>(instruction);
+        auto* target = label_for_offset(op.target().address());
+        if (!target)
+            return false;
+        m_assembler.jump(*target);
+        return true;
+    }
+    case Bytecode::Instruction::Type::JumpIf: {
+        auto const& op = static_cast<Bytecode::Op::JumpIf const&>(instruction);
+        auto* true_target = label_for_offset(op.true_target().address());
+        auto* false_target = label_for_offset(op.false_target().address());
+        if (!true_target || !false_target)
+            return false;
+        compile_jump_if(op.condition(), true_target, false_target);
+        return true;
+    }
+    case Bytecode::Instruction::Type::JumpTrue: {
+        auto const& op = static_cast<Bytecode::Op::JumpTrue const&>(instruction);
+        auto* target = label_for_offset(op.target().address());
+        if (!target)
+            return false;
+        compile_jump_if(op.condition(), target, nullptr);
+        return true;
+    }
+    case Bytecode::Instruction::Type::JumpFalse: {
+        auto const& op = static_cast<Bytecode::Op::JumpFalse const&>(instruction);
+        auto* target = label_for_offset(op.target().address());
+        if (!target)
+            return false;
+        compile_jump_if(op.condition(), nullptr, target);
+        return true;
+    }
+    case Bytecode::Instruction::Type::JumpNullish: {
+        auto const& op = static_cast<Bytecode::Op::JumpNullish const&>(instruction);
+        auto* true_target = label_for_offset(op.true_target().address());
+        auto* false_target = label_for_offset(op.false_target().address());
+        if (!true_target || !false_target)
+            return false;
+        compile_jump_nullish(op.condition(), *true_target, *false_target);
+        return true;
+    }
+    case Bytecode::Instruction::Type::JumpUndefined: {
+        auto const& op = static_cast<Bytecode::Op::JumpUndefined const&>(instruction);
+        auto* true_target = label_for_offset(op.true_target().address());
+        auto* false_target = label_for_offset(op.false_target().address());
+        if (!true_target || !false_target)
+            return false;
+        compile_jump_undefined(op.condition(), *true_target, *false_target);
+        return true;
+    }
+
+#    define DO_COMPILE_RELATIONAL_JUMP(op_TitleCase, condition)                                           \
+    case Bytecode::Instruction::Type::Jump##op_TitleCase: {                                               \
+        auto const& op = static_cast<Bytecode::Op::Jump##op_TitleCase const&>(instruction);               \
+        auto* true_target = label_for_offset(op.true_target().address());                                 \
+        auto* false_target = label_for_offset(op.false_target().address());                               \
+        if (!true_target || !false_target)                                                                \
+            return false;                                                                                 \
+        compile_relational_jump(instruction, op.lhs(), op.rhs(), condition, *true_target, *false_target); \
+        return true;                                                                                      \
+    }
+
+        DO_COMPILE_RELATIONAL_JUMP(LessThan, Assembler::Condition::SignedLessThan)
+        DO_COMPILE_RELATIONAL_JUMP(LessThanEquals, Assembler::Condition::SignedLessThanOrEqualTo)
+        DO_COMPILE_RELATIONAL_JUMP(GreaterThan, Assembler::Condition::SignedGreaterThan)
+        DO_COMPILE_RELATIONAL_JUMP(GreaterThanEquals, Assembler::Condition::SignedGreaterThanOrEqualTo)
+#    undef DO_COMPILE_RELATIONAL_JUMP
+
+#    define DO_COMPILE_EQUALITY_JUMP(op_TitleCase, op_snake_case)                                                      \
+    case Bytecode::Instruction::Type::Jump##op_TitleCase: {                                                            \
+        auto const& op = static_cast<Bytecode::Op::Jump##op_TitleCase const&>(instruction);                            \
+        if (!label_for_offset(op.true_target().address()) || !label_for_offset(op.false_target().address()))           \
+            return false;                                                                                              \
+        compile_helper_call_and_jump(instruction, &compare_and_jump<Bytecode::Op::Jump##op_TitleCase, op_snake_case>); \
+        return true;                                                                                                   \
+    }
+
+        DO_COMPILE_EQUALITY_JUMP(LooselyEquals, loosely_equals)
+        DO_COMPILE_EQUALITY_JUMP(LooselyInequals, loosely_inequals)
+        DO_COMPILE_EQUALITY_JUMP(StrictlyEquals, strict_equals)
+        DO_COMPILE_EQUALITY_JUMP(StrictlyInequals, strict_inequals)
+#    undef DO_COMPILE_EQUALITY_JUMP
+
+    case Bytecode::Instruction::Type::Increment:
+        compile_increment_or_decrement(instruction, static_cast<Bytecode::Op::Increment const&>(instruction).dst(), true);
+        return true;
+    case Bytecode::Instruction::Type::Decrement:
+        compile_increment_or_decrement(instruction, static_cast<Bytecode::Op::Decrement const&>(instruction).dst(), false);
+        return true;
+    case Bytecode::Instruction::Type::Add: {
+        auto const& op = static_cast<Bytecode::Op::Add const&>(instruction);
+        compile_add_or_sub(instruction, op.dst(), op.lhs(), op.rhs(), true);
+        return true;
+    }
+    case Bytecode::Instruction::Type::Sub: {
+        auto const& op = static_cast<Bytecode::Op::Sub const&>(instruction);
+        compile_add_or_sub(instruction, op.dst(), op.lhs(), op.rhs(), false);
+        return true;
+    }
+
+#    define DO_COMPILE_RELATIONAL_OP(op_TitleCase, condition)                         \
+    case Bytecode::Instruction::Type::op_TitleCase: {                                 \
+        auto const& op = static_cast<Bytecode::Op::op_TitleCase const&>(instruction); \
+        compile_relational_op(instruction, op.dst(), op.lhs(), op.rhs(), condition);  \
+        return true;                                                                  \
+    }
+
+        DO_COMPILE_RELATIONAL_OP(LessThan, Assembler::Condition::SignedLessThan)
+        DO_COMPILE_RELATIONAL_OP(LessThanEquals, Assembler::Condition::SignedLessThanOrEqualTo)
+        DO_COMPILE_RELATIONAL_OP(GreaterThan, Assembler::Condition::SignedGreaterThan)
+        DO_COMPILE_RELATIONAL_OP(GreaterThanEquals, Assembler::Condition::SignedGreaterThanOrEqualTo)
+#    undef DO_COMPILE_RELATIONAL_OP
+
+    case Bytecode::Instruction::Type::EnterUnwindContext: {
+        auto const& op = static_cast<Bytecode::Op::EnterUnwindContext const&>(instruction);
+        auto* entry_point = label_for_offset(op.entry_point().address());
+        if (!entry_point)
+            return false;
+        compile_helper_call(instruction, &enter_unwind_context);
+        m_assembler.jump(*entry_point);
+        return true;
+    }
+    case Bytecode::Instruction::Type::ContinuePendingUnwind: {
+        auto const& op = static_cast<Bytecode::Op::ContinuePendingUnwind const&>(instruction);
+        if (!label_for_offset(op.resume_target().address()))
+            return false;
+        compile_helper_call_and_jump(instruction, &continue_pending_unwind);
+        return true;
+    }
+    case Bytecode::Instruction::Type::ScheduleJump: {
+        auto const& op = static_cast<Bytecode::Op::ScheduleJump const&>(instruction);
+        if (!label_for_offset(op.target().address()))
+            return false;
+        compile_helper_call_and_jump(instruction, &schedule_jump);
+        return true;
+    }
+    case Bytecode::Instruction::Type::Return:
+        compile_helper_call_and_jump(instruction, &return_);
+        return true;
+    case Bytecode::Instruction::Type::Yield:
+        compile_helper_call_and_jump(instruction, &yield);
+        return true;
+    case Bytecode::Instruction::Type::Await:
+        compile_helper_call_and_jump(instruction, &await);
+        return true;
+
+#    define DO_COMPILE_GENERIC(name)                                                \
+    case Bytecode::Instruction::Type::name:                                         \
+        compile_helper_call(instruction, &execute_instruction<Bytecode::Op::name>); \
+        return true;
+
+        JS_ENUMERATE_JIT_GENERIC_OPS(DO_COMPILE_GENERIC)
+#    undef DO_COMPILE_GENERIC
+
+    default:
+        return false;
+    }
+}
+
+template<typename OpType>
+void* Compiler::execute_instruction(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    if constexpr (IsSame<decltype(instruction.execute_impl(interpreter)), void>) {
+        instruction.execute_impl(interpreter);
+    } else {
+        auto result = instruction.execute_impl(interpreter);
+        if (result.is_error()) [[unlikely]]
+            return continue_after_exception(interpreter, result.error_value());
+    }
+    return nullptr;
+}
+
+template<typename OpType, ThrowCompletionOr<Value> (*compare)(VM&, Value, Value)>
+void* Compiler::compare_and_jump(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    auto result = compare(interpreter.vm(), interpreter.get(instruction.lhs()), interpreter.get(instruction.rhs()));
+    if (result.is_error()) [[unlikely]]
+        return continue_after_exception(interpreter, result.error_value());
+
+    auto const& target = result.value().to_boolean() ? instruction.true_target() : instruction.false_target();
+    return bit_cast<void*>(interpreter.current_executable().native_executable()->address_for_offset(target.address()));
+}
+
+u64 Compiler::to_boolean(u64 encoded_value)
+{
+    return bit_cast<Value>(encoded_value).to_boolean();
+}
+
+void* Compiler::enter_unwind_context(Bytecode::Interpreter& interpreter, Bytecode::Op::EnterUnwindContext const&)
+{
+    interpreter.enter_unwind_context();
+    return nullptr;
+}
+
+void* Compiler::continue_pending_unwind(Bytecode::Interpreter& interpreter, Bytecode::Op::ContinuePendingUnwind const& instruction)
+{
+    auto const& native_executable = *interpreter.current_executable().native_executable();
+
+    if (auto exception = interpreter.reg(Bytecode::Register::exception()); !exception.is_empty())
+        return continue_after_exception(interpreter, exception);
+
+    if (!interpreter.saved_return_value().is_empty()) {
+        interpreter.do_return(interpreter.saved_return_value());
+        return run_finalizer_or_exit(interpreter, false);
+    }
+
+    auto const old_scheduled_jump = interpreter.vm().running_execution_context().previously_scheduled_jumps.take_last();
+    if (interpreter.m_scheduled_jump.has_value()) {
+        auto target = interpreter.m_scheduled_jump.release_value();
+        return bit_cast<void*>(native_executable.address_for_offset(target));
+    }
+
+    // Set the scheduled jump to the old value if we continue where we left it.
+    interpreter.m_scheduled_jump = old_scheduled_jump;
+    return bit_cast<void*>(native_executable.address_for_offset(instruction.resume_target().address()));
+}
+
+void* Compiler::schedule_jump(Bytecode::Interpreter& interpreter, Bytecode::Op::ScheduleJump const& instruction)
+{
+    auto& executable = interpreter.current_executable();
+    interpreter.m_scheduled_jump = instruction.target().address();
+    auto finalizer = executable.exception_handlers_for_offset(interpreter.m_program_counter.value()).value().finalizer_offset;
+    VERIFY(finalizer.has_value());
+    return bit_cast<void*>(executable.native_executable()->address_for_offset(finalizer.value()));
+}
+
+void* Compiler::return_(Bytecode::Interpreter& interpreter, Bytecode::Op::Return const& instruction)
+{
+    instruction.execute_impl(interpreter);
+    return run_finalizer_or_exit(interpreter, false);
+}
+
+void* Compiler::yield(Bytecode::Interpreter& interpreter, Bytecode::Op::Yield const& instruction)
+{
+    (void)instruction.execute_impl(interpreter);
+    // NOTE: A `yield` doesn't go through a finally block, but a Yield without a continuation is a `return` in disguise.
+    return run_finalizer_or_exit(interpreter, instruction.continuation().has_value());
+}
+
+void* Compiler::await(Bytecode::Interpreter& interpreter, Bytecode::Op::Await const& instruction)
+{
+    (void)instruction.execute_impl(interpreter);
+    return run_finalizer_or_exit(interpreter, true);
+}
+
+void* Compiler::continue_after_exception(Bytecode::Interpreter& interpreter, Value exception)
+{
+    auto const& native_executable = *interpreter.current_executable().native_executable();
+    auto& program_counter = interpreter.m_program_counter.value();
+    if (interpreter.handle_exception(program_counter, exception) == Bytecode::Interpreter::HandleExceptionResponse::ExitFromExecutable)
+        return bit_cast<void*>(native_executable.exit_address());
+    return bit_cast<void*>(native_executable.address_for_offset(program_counter));
+}
+
+void* Compiler::run_finalizer_or_exit(Bytecode::Interpreter& interpreter, bool will_yield)
+{
+    auto& executable = interpreter.current_executable();
+    auto const& native_executable = *executable.native_executable();
+
+    if (!will_yield) {
+        if (auto handlers = executable.exception_handlers_for_offset(interpreter.m_program_counter.value()); handlers.has_value()) {
+            if (auto finalizer = handlers.value().finalizer_offset; finalizer.has_value()) {
+                auto& running_execution_context = interpreter.vm().running_execution_context();
+                VERIFY(!running_execution_context.unwind_contexts.is_empty());
+                VERIFY(running_execution_context.unwind_contexts.last().executable == &executable);
+                interpreter.reg(Bytecode::Register::saved_return_value()) = interpreter.reg(Bytecode::Register::return_value());
+                interpreter.reg(Bytecode::Register::return_value()) = {};
+                // The unwind context will be popped when entering the finally block.
+                return bit_cast<void*>(native_executable.address_for_offset(finalizer.value()));
+            }
+        }
+    }
+    return bit_cast<void*>(native_executable.exit_address());
+}
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable& bytecode_executable)
+{
+    Compiler compiler { bytecode_executable };
+    auto& assembler = compiler.m_assembler;
+
+    // NOTE: Every label and exception handler points at the start of a basic block, and we need to be
+    //       able to resume at all of them, so each one gets a label up front.
+    for (auto offset : bytecode_executable.basic_block_start_offsets)
+        compiler.m_block_labels.set(offset, {});
+    for (auto const& handlers : bytecode_executable.exception_handlers) {
+        if (handlers.handler_offset.has_value() && !compiler.m_block_labels.contains(*handlers.handler_offset))
+            return nullptr;
+        if (handlers.finalizer_offset.has_value() && !compiler.m_block_labels.contains(*handlers.finalizer_offset))
+            return nullptr;
+    }
+
+    // void code(Interpreter&, FlatPtr entry_point_address, Value* registers, Value* locals, size_t* program_counter)
+    assembler.enter();
+    assembler.mov(Assembler::Operand::Register(INTERPRETER), Assembler::Operand::Register(ARG0));
+    assembler.mov(Assembler::Operand::Register(REGISTER_ARRAY_BASE), Assembler::Operand::Register(ARG2));
+    assembler.mov(Assembler::Operand::Register(LOCALS_ARRAY_BASE), Assembler::Operand::Register(ARG3));
+    assembler.mov(Assembler::Operand::Register(PROGRAM_COUNTER), Assembler::Operand::Register(ARG4));
+    assembler.jump(Assembler::Operand::Register(ARG1));
+
+    Bytecode::InstructionStreamIterator it(bytecode_executable.bytecode);
+    while (!it.at_end()) {
+        compiler.m_current_offset = it.offset();
+        if (auto* label = compiler.label_for_offset(it.offset()))
+            label->link(assembler);
+
+        if (!compiler.compile_instruction(*it)) {
+            dbgln_if(JS_BYTECODE_DEBUG, "JIT: Can't compile {} at offset {}, falling back to the interpreter", (*it).to_byte_string(bytecode_executable), it.offset());
+            return nullptr;
+        }
+        ++it;
+    }
+
+    // The last block always ends in a terminator, so we should never fall off the end.
+    assembler.verify_not_reached();
+
+    compiler.m_exit_label.link(assembler);
+    assembler.exit();
+
+    compiler.m_jump_to_continuation_label.link(assembler);
+    assembler.jump(Assembler::Operand::Register(RET));
+
+    HashMap<size_t, size_t> block_entry_points;
+    for (auto& [bytecode_offset, label] : compiler.m_block_labels) {
+        if (!label.offset_of_label_in_instruction_stream.has_value()) {
+            // A block start past the last instruction, nothing may jump there.
+            if (!label.jump_slot_offsets_in_instruction_stream.is_empty())
+                return nullptr;
+            continue;
+        }
+        block_entry_points.set(bytecode_offset, label.offset_of_label_in_instruction_stream.value());
+    }
+
+    auto native_executable = NativeExecutable::create(compiler.m_output.span(), move(block_entry_points), compiler.m_exit_label.offset_of_label_in_instruction_stream.value(), bytecode_executable.name.view());
+    dbgln_if(JS_BYTECODE_DEBUG, "JIT: Compiled {} bytes of bytecode into {} bytes of machine code for {}", bytecode_executable.bytecode.size(), compiler.m_output.size(), bytecode_executable.name);
+    return native_executable;
+}
+
+#else
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable&)
+{
+    return nullptr;
+}
+
+#endif
+
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJIT/Assembler.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Operand.h>
+#include <LibJS/Forward.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+namespace JS::JIT {
+
+// A baseline compiler that turns a Bytecode::Executable into native code.
+// Every instruction becomes a call into the same C++ code the interpreter uses, except for moves,
+// jumps and a handful of Int32 fast paths which are emitted inline. This removes dispatch overhead
+// and lets the CPU predict the control flow of hot loops.
+// Enabled by setting the LIBJS_JIT environment variable.
+class Compiler {
+public:
+    static bool is_enabled();
+
+    // The number of times an executable has to run in the interpreter before we compile it.
+    static constexpr u32 hot_executable_threshold = 4;
+
+    // Returns nullptr if the executable can't be compiled, in which case it keeps running in the interpreter.
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+#ifdef JIT_ARCH_SUPPORTED
+private:
+    using Assembler = ::JIT::Assembler;
+
+    static constexpr auto GPR0 = Assembler::Reg::RAX;
+    static constexpr auto GPR1 = Assembler::Reg::RCX;
+    static constexpr auto GPR2 = Assembler::Reg::RDX;
+    static constexpr auto ARG0 = Assembler::Reg::RDI;
+    static constexpr auto ARG1 = Assembler::Reg::RSI;
+    static constexpr auto ARG2 = Assembler::Reg::RDX;
+    static constexpr auto ARG3 = Assembler::Reg::RCX;
+    static constexpr auto ARG4 = Assembler::Reg::R8;
+    static constexpr auto RET = Assembler::Reg::RAX;
+
+    // These are callee-saved, so they survive calls into C++.
+    // NOTE: R12 and R13 are never used as memory bases, since they need special ModRM encodings.
+    static constexpr auto INTERPRETER = Assembler::Reg::R12;
+    static constexpr auto REGISTER_ARRAY_BASE = Assembler::Reg::RBX;
+    static constexpr auto LOCALS_ARRAY_BASE = Assembler::Reg::R14;
+    static constexpr auto PROGRAM_COUNTER = Assembler::Reg::R15;
+
+    explicit Compiler(Bytecode::Executable& bytecode_executable)
+        : m_bytecode_executable(bytecode_executable)
+    {
+    }
+
+    bool compile_instruction(Bytecode::Instruction const&);
+
+    void compile_mov(Bytecode::Operand dst, Bytecode::Operand src);
+    void compile_jump_if(Bytecode::Operand condition, Assembler::Label* true_target, Assembler::Label* false_target);
+    void compile_jump_nullish(Bytecode::Operand condition, Assembler::Label& true_target, Assembler::Label& false_target);
+    void compile_jump_undefined(Bytecode::Operand condition, Assembler::Label& true_target, Assembler::Label& false_target);
+    void compile_increment_or_decrement(Bytecode::Instruction const&, Bytecode::Operand dst, bool is_increment);
+    void compile_add_or_sub(Bytecode::Instruction const&, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, bool is_add);
+    void compile_relational_op(Bytecode::Instruction const&, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, Assembler::Condition);
+    void compile_relational_jump(Bytecode::Instruction const&, Bytecode::Operand lhs, Bytecode::Operand rhs, Assembler::Condition, Assembler::Label& true_target, Assembler::Label& false_target);
+
+    // Emits a call to `helper(interpreter, instruction)`. The helper returns the native address to
+    // continue at, or null to fall through to the next instruction.
+    template<typename Helper>
+    void compile_helper_call(Bytecode::Instruction const&, Helper);
+    template<typename Helper>
+    void compile_helper_call_and_jump(Bytecode::Instruction const&, Helper);
+
+    void load_operand(Assembler::Reg dst, Bytecode::Operand);
+    void store_operand(Bytecode::Operand, Assembler::Reg src);
+    void store_program_counter();
+    void branch_if_not_int32(Assembler::Reg value, Assembler::Label& not_int32);
+    void box_int32(Assembler::Reg value);
+    void test_to_boolean(Assembler::Reg value);
+
+    Assembler::Label* label_for_offset(size_t bytecode_offset);
+
+    // Runtime glue called from generated code.
+    template<typename OpType>
+    static void* execute_instruction(Bytecode::Interpreter&, OpType const&);
+    template<typename OpType, ThrowCompletionOr<Value> (*compare)(VM&, Value, Value)>
+    static void* compare_and_jump(Bytecode::Interpreter&, OpType const&);
+    static u64 to_boolean(u64 encoded_value);
+    static void* enter_unwind_context(Bytecode::Interpreter&, Bytecode::Op::EnterUnwindContext const&);
+    static void* continue_pending_unwind(Bytecode::Interpreter&, Bytecode::Op::ContinuePendingUnwind const&);
+    static void* schedule_jump(Bytecode::Interpreter&, Bytecode::Op::ScheduleJump const&);
+    static void* return_(Bytecode::Interpreter&, Bytecode::Op::Return const&);
+    static void* yield(Bytecode::Interpreter&, Bytecode::Op::Yield const&);
+    static void* await(Bytecode::Interpreter&, Bytecode::Op::Await const&);
+    static void* continue_after_exception(Bytecode::Interpreter&, Value exception);
+    static void* run_finalizer_or_exit(Bytecode::Interpreter&, bool will_yield);
+
+    Vector<u8> m_output;
+    Assembler m_assembler { m_output };
+    Assembler::Label m_exit_label;
+    Assembler::Label m_jump_to_continuation_label;
+    HashMap<size_t, Assembler::Label> m_block_labels;
+    size_t m_current_offset { 0 };
+    Bytecode::Executable& m_bytecode_executable;
+#endif
+};
+
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/TemporaryChange.h>
+#include <LibJIT/GDB.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <LibJS/Runtime/VM.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+OwnPtr<NativeExecutable> NativeExecutable::create(ReadonlyBytes machine_code, HashMap<size_t, size_t> block_entry_points, size_t exit_offset, StringView name)
+{
+    auto* code = mmap(nullptr, machine_code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED) {
+        dbgln("JIT: mmap: {}", strerror(errno));
+        return nullptr;
+    }
+    memcpy(code, machine_code.data(), machine_code.size());
+    if (mprotect(code, machine_code.size(), PROT_READ | PROT_EXEC) < 0) {
+        dbgln("JIT: mprotect: {}", strerror(errno));
+        munmap(code, machine_code.size());
+        return nullptr;
+    }
+
+    auto executable = adopt_own(*new NativeExecutable(code, machine_code.size(), move(block_entry_points), exit_offset));
+
+    executable->m_gdb_object = ::JIT::GDB::build_gdb_image(executable->code_bytes(), "LibJS JIT"sv, name.is_empty() ? "(anonymous)"sv : name);
+    if (executable->m_gdb_object.has_value())
+        ::JIT::GDB::register_into_gdb(executable->m_gdb_object->span());
+
+    return executable;
+}
+
+NativeExecutable::NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> block_entry_points, size_t exit_offset)
+    : m_code(code)
+    , m_size(size)
+    , m_block_entry_points(move(block_entry_points))
+    , m_exit_offset(exit_offset)
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    if (m_gdb_object.has_value())
+        ::JIT::GDB::unregister_from_gdb(m_gdb_object->span());
+    munmap(m_code, m_size);
+}
+
+FlatPtr NativeExecutable::address_for_offset(size_t bytecode_offset) const
+{
+    auto native_offset = m_block_entry_points.get(bytecode_offset);
+    VERIFY(native_offset.has_value());
+    return bit_cast<FlatPtr>(m_code) + native_offset.value();
+}
+
+void NativeExecutable::run(Bytecode::Interpreter& interpreter, size_t entry_point) const
+{
+    auto& vm = interpreter.vm();
+    if (vm.did_reach_stack_space_limit()) {
+        interpreter.reg(Bytecode::Register::exception()) = vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded).release_value().value();
+        return;
+    }
+
+    // NOTE: Generated code keeps this up to date before calling into C++, so that stack traces
+    //       and exception handler lookups see the same program counter as in the interpreter.
+    size_t program_counter = entry_point;
+    TemporaryChange change(interpreter.m_program_counter, Optional<size_t&>(program_counter));
+
+    using JITCode = void (*)(Bytecode::Interpreter&, FlatPtr entry_point_address, Value* registers, Value* locals, size_t* program_counter);
+    bit_cast<JITCode>(m_code)(
+        interpreter,
+        address_for_offset(entry_point),
+        interpreter.m_registers.data(),
+        interpreter.m_locals.data(),
+        &program_counter);
+}
+
+}
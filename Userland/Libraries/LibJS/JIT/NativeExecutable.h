@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FixedArray.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Types.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    // Copies `machine_code` into executable memory. `block_entry_points` maps the bytecode offset of each
+    // basic block to the offset of its first native instruction, and `exit_offset` is the native offset
+    // of the epilogue that returns control to the interpreter.
+    static OwnPtr<NativeExecutable> create(ReadonlyBytes machine_code, HashMap<size_t, size_t> block_entry_points, size_t exit_offset, StringView name);
+
+    ~NativeExecutable();
+
+    void run(Bytecode::Interpreter&, size_t entry_point) const;
+
+    // These are used by generated code to resume at a bytecode offset that isn't known at compile time,
+    // e.g. an exception handler or a finalizer.
+    [[nodiscard]] FlatPtr address_for_offset(size_t bytecode_offset) const;
+    [[nodiscard]] FlatPtr exit_address() const { return bit_cast<FlatPtr>(m_code) + m_exit_offset; }
+
+    ReadonlyBytes code_bytes() const { return { m_code, m_size }; }
+
+private:
+    NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> block_entry_points, size_t exit_offset);
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    HashMap<size_t, size_t> m_block_entry_points;
+    size_t m_exit_offset { 0 };
+    Optional<FixedArray<u8>> m_gdb_object;
+};
+
+}
@@ -2741,6 +2741,8 @@ void Parser::parse_statement_list(ScopeNode& output_node, AllowLabelledFunction
 }
 
 // FunctionBody, https://tc39.es/ecma262/#prod-FunctionBody
+// FIXME: Function bodies are parsed in full even if the function never runs. Pre-parsing them lazily needs the scope
+//        analysis (captured variables, uses of `this` and direct eval) to work without building their AST first.
 NonnullRefPtr<FunctionBody const> Parser::parse_function_body(Vector<FunctionParameter> const& parameters, FunctionKind function_kind, bool& contains_direct_call_to_eval, bool& uses_this)
 {
     auto rule_start = push_start();
@@ -57,6 +57,7 @@ struct DataBlock {
 class ArrayBuffer : public Object {
     JS_OBJECT(ArrayBuffer, Object);
     JS_DECLARE_ALLOCATOR(ArrayBuffer);
+    JS_CELL_HAS_WRITE_BARRIERS(ArrayBuffer);
 
 public:
     static ThrowCompletionOr<NonnullGCPtr<ArrayBuffer>> create(Realm&, size_t);
@@ -79,7 +80,11 @@ public:
     void set_data_block(DataBlock block) { m_data_block = move(block); }
 
     Value detach_key() const { return m_detach_key; }
-    void set_detach_key(Value detach_key) { m_detach_key = detach_key; }
+    void set_detach_key(Value detach_key)
+    {
+        m_detach_key = detach_key;
+        write_barrier(detach_key);
+    }
 
     void detach_buffer() { m_data_block.byte_buffer = Empty {}; }
 
@@ -13,6 +13,7 @@ namespace JS {
 class ArrayIterator final : public Object {
     JS_OBJECT(ArrayIterator, Object);
     JS_DECLARE_ALLOCATOR(ArrayIterator);
+    JS_CELL_HAS_WRITE_BARRIERS(ArrayIterator);
 
 public:
     static NonnullGCPtr<ArrayIterator> create(Realm&, Value array, Object::PropertyKind iteration_kind);
@@ -31,6 +31,21 @@ JS_DEFINE_ALLOCATOR(ArrayPrototype);
 
 static HashTable<NonnullGCPtr<Object>> s_array_join_seen_objects;
 
+// OPTIMIZATION: Every index below the size of packed elements is an own data property of the object, so searching
+//               through them doesn't need to go through HasProperty() and Get() for each element.
+static SimpleIndexedPropertyStorage const* packed_elements_of(Object const& object)
+{
+    if (object.may_interfere_with_indexed_property_access())
+        return nullptr;
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*storage);
+    if (!simple_storage.is_packed())
+        return nullptr;
+    return &simple_storage;
+}
+
 ArrayPrototype::ArrayPrototype(Realm& realm)
     : Array(realm.intrinsics().object_prototype())
 {
@@ -742,6 +757,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+    if (auto const* storage = packed_elements_of(*this_object)) {
+        u64 packed_length = min(length, storage->array_like_size());
+        if (storage->may_contain(value_to_find)) {
+            for (; from_index < packed_length; ++from_index) {
+                if (same_value_zero(storage->elements()[from_index], value_to_find))
+                    return Value(true);
+            }
+        }
+        from_index = max(from_index, packed_length);
+    }
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -795,6 +820,17 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    if (auto const* storage = packed_elements_of(*object)) {
+        size_t packed_length = min(length, storage->array_like_size());
+        if (storage->may_contain(search_element)) {
+            for (; k < packed_length; ++k) {
+                if (is_strictly_equal(search_element, storage->elements()[k]))
+                    return Value(k);
+            }
+        }
+        k = max(k, packed_length);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -906,6 +942,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::last_index_of)
         k = (double)length + n;
     }
 
+    if (auto const* storage = packed_elements_of(*object); storage && k >= 0 && static_cast<size_t>(k) < storage->array_like_size()) {
+        if (!storage->may_contain(search_element))
+            return Value(-1);
+        for (; k >= 0; --k) {
+            if (is_strictly_equal(search_element, storage->elements()[k]))
+                return Value((size_t)k);
+        }
+        return Value(-1);
+    }
+
     // 8. Repeat, while k ≥ 0,
     for (; k >= 0; --k) {
         auto property_key = PropertyKey { k };
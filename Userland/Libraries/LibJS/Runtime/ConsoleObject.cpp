@@ -32,6 +32,7 @@ void ConsoleObject::initialize(Realm& realm)
     auto& vm = this->vm();
     Base::initialize(realm);
     m_console = vm.heap().allocate<Console>(realm, realm);
+    write_barrier(m_console.ptr());
     u8 attr = Attribute::Writable | Attribute::Enumerable | Attribute::Configurable;
     define_native_function(realm, vm.names.assert, assert_, 0, attr);
     define_native_function(realm, vm.names.clear, clear, 0, attr);
@@ -13,6 +13,7 @@ namespace JS {
 class ConsoleObject final : public Object {
     JS_OBJECT(ConsoleObject, Object);
     JS_DECLARE_ALLOCATOR(ConsoleObject);
+    JS_CELL_HAS_WRITE_BARRIERS(ConsoleObject);
 
 public:
     virtual void initialize(Realm&) override;
@@ -118,11 +118,14 @@ ThrowCompletionOr<void> DeclarativeEnvironment::initialize_binding(VM& vm, Depre
     VERIFY(binding.initialized == false);
 
     // 2. If hint is not normal, perform ? AddDisposableResource(envRec, V, hint).
-    if (hint != Environment::InitializeBindingHint::Normal)
+    if (hint != Environment::InitializeBindingHint::Normal) {
         TRY(add_disposable_resource(vm, m_disposable_resource_stack, value, hint));
+        write_barrier_for_unknown_edges();
+    }
 
     // 3. Set the bound value for N in envRec to V.
     binding.value = value;
+    write_barrier(value);
 
     // 4. Record that the binding for N in envRec has been initialized.
     binding.initialized = true;
@@ -173,6 +176,7 @@ ThrowCompletionOr<void> DeclarativeEnvironment::set_mutable_binding_direct(VM& v
 
     if (binding.mutable_) {
         binding.value = value;
+        write_barrier(value);
     } else {
         if (strict)
             return vm.throw_completion<TypeError>(ErrorType::InvalidAssignToConst);
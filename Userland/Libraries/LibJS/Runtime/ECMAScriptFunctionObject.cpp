@@ -342,6 +342,7 @@ void ECMAScriptFunctionObject::initialize(Realm& realm)
     //       are defined in the spec.
 
     m_name_string = PrimitiveString::create(vm, m_name);
+    write_barrier(m_name_string.ptr());
 
     MUST(define_property_or_throw(vm.names.length, { .value = Value(m_function_length), .writable = false, .enumerable = false, .configurable = true }));
     MUST(define_property_or_throw(vm.names.name, { .value = m_name_string, .writable = false, .enumerable = false, .configurable = true }));
@@ -563,6 +564,7 @@ void ECMAScriptFunctionObject::make_method(Object& home_object)
 {
     // 1. Set F.[[HomeObject]] to homeObject.
     m_home_object = &home_object;
+    write_barrier(&home_object);
 
     // 2. Return unused.
 }
@@ -1223,6 +1225,7 @@ Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
             } else {
                 m_default_parameter_bytecode_executables.append(*parameter.bytecode_executable);
             }
+            write_barrier(m_default_parameter_bytecode_executables.last().ptr());
         }
     }
 
@@ -1241,6 +1244,7 @@ Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
         if (!m_ecmascript_code->bytecode_executable())
             const_cast<Statement&>(*m_ecmascript_code).set_bytecode_executable(TRY(Bytecode::compile(vm, *m_ecmascript_code, m_formal_parameters, m_kind, m_name)));
         m_bytecode_executable = m_ecmascript_code->bytecode_executable();
+        write_barrier(m_bytecode_executable.ptr());
     }
 
     if (m_kind == FunctionKind::Async) {
@@ -1284,6 +1288,7 @@ void ECMAScriptFunctionObject::set_name(DeprecatedFlyString const& name)
     auto& vm = this->vm();
     m_name = name;
     m_name_string = PrimitiveString::create(vm, m_name);
+    write_barrier(m_name_string.ptr());
     MUST(define_property_or_throw(vm.names.name, { .value = m_name_string, .writable = false, .enumerable = false, .configurable = true }));
 }
 }
@@ -21,6 +21,7 @@ struct Variable {
 
 class Environment : public Cell {
     JS_CELL(Environment, Cell);
+    JS_CELL_HAS_WRITE_BARRIERS(Environment);
 
 public:
     enum class InitializeBindingHint {
@@ -47,6 +47,12 @@ bool FinalizationRegistry::remove_by_token(Cell& unregister_token)
     return removed;
 }
 
+void FinalizationRegistry::finalize()
+{
+    Base::finalize();
+    WeakContainer::deregister();
+}
+
 void FinalizationRegistry::remove_dead_cells(Badge<Heap>)
 {
     auto any_cells_were_removed = false;
@@ -31,6 +31,7 @@ public:
     ThrowCompletionOr<void> cleanup(GCPtr<JobCallback> = {});
 
     virtual void remove_dead_cells(Badge<Heap>) override;
+    virtual void finalize() override;
 
     Realm& realm() { return *m_realm; }
     Realm const& realm() const { return *m_realm; }
@@ -18,6 +18,11 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto value : m_packed_elements) {
+        update_elements_kind(value);
+        if (m_elements_kind == ElementsKind::Holey)
+            break;
+    }
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -43,32 +48,61 @@ void SimpleIndexedPropertyStorage::grow_storage_if_needed()
     }
 }
 
+void SimpleIndexedPropertyStorage::update_elements_kind(Value value)
+{
+    if (value.is_empty()) {
+        m_elements_kind = ElementsKind::Holey;
+        return;
+    }
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        if (!value.is_int32())
+            m_elements_kind = value.is_number() ? ElementsKind::PackedNumber : ElementsKind::Packed;
+        break;
+    case ElementsKind::PackedNumber:
+        if (!value.is_number())
+            m_elements_kind = ElementsKind::Packed;
+        break;
+    case ElementsKind::Packed:
+    case ElementsKind::Holey:
+        break;
+    }
+}
+
 void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttributes attributes)
 {
     VERIFY(attributes == default_attributes);
 
     if (index >= m_array_size) {
+        if (index > m_array_size)
+            m_elements_kind = ElementsKind::Holey;
         m_array_size = index + 1;
         grow_storage_if_needed();
     }
     m_packed_elements[index] = value;
+    update_elements_kind(value);
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
     m_packed_elements[index] = {};
+    m_elements_kind = ElementsKind::Holey;
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
 {
     m_array_size--;
+    if (m_array_size == 0)
+        m_elements_kind = ElementsKind::PackedInt32;
     return { m_packed_elements.take_first(), default_attributes };
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 {
     m_array_size--;
+    if (m_array_size == 0)
+        m_elements_kind = ElementsKind::PackedInt32;
     auto last_element = m_packed_elements[m_array_size];
     m_packed_elements[m_array_size] = {};
     return { last_element, default_attributes };
@@ -76,6 +110,10 @@ ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    if (new_size == 0)
+        m_elements_kind = ElementsKind::PackedInt32;
+    else if (new_size > m_array_size)
+        m_elements_kind = ElementsKind::Holey;
     m_array_size = new_size;
     m_packed_elements.resize_and_keep_capacity(new_size);
     return true;
@@ -56,6 +56,18 @@ private:
 
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
+    // What is known about all the elements, from most to least specific. Storage only moves down this list
+    // (until it is emptied), so fast paths can rely on it without looking at the elements themselves.
+    enum class ElementsKind : u8 {
+        // No holes, and every element is an Int32.
+        PackedInt32,
+        // No holes, and every element is a Number.
+        PackedNumber,
+        // No holes.
+        Packed,
+        Holey,
+    };
+
     SimpleIndexedPropertyStorage()
         : IndexedPropertyStorage(IsSimpleStorage::Yes) {};
     explicit SimpleIndexedPropertyStorage(Vector<Value>&& initial_values);
@@ -74,9 +86,20 @@ public:
 
     Vector<Value> const& elements() const { return m_packed_elements; }
 
+    [[nodiscard]] ElementsKind elements_kind() const { return m_elements_kind; }
+    [[nodiscard]] bool is_packed() const { return m_elements_kind != ElementsKind::Holey; }
+
+    // Returns false if the elements kind rules out that any element is strictly equal to `value`.
+    [[nodiscard]] bool may_contain(Value value) const
+    {
+        if (m_elements_kind == ElementsKind::PackedInt32 || m_elements_kind == ElementsKind::PackedNumber)
+            return value.is_number();
+        return true;
+    }
+
     [[nodiscard]] bool inline_has_index(u32 index) const
     {
-        return index < m_array_size && !m_packed_elements.data()[index].is_empty();
+        return index < m_array_size && (is_packed() || !m_packed_elements.data()[index].is_empty());
     }
 
     [[nodiscard]] Optional<ValueAndAttributes> inline_get(u32 index) const
@@ -90,9 +113,11 @@ private:
     friend GenericIndexedPropertyStorage;
 
     void grow_storage_if_needed();
+    void update_elements_kind(Value);
 
     size_t m_array_size { 0 };
     Vector<Value> m_packed_elements;
+    ElementsKind m_elements_kind { ElementsKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
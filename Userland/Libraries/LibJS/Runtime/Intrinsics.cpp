@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibJS/Heap/DeferGC.h>
 #include <LibJS/Runtime/AggregateErrorConstructor.h>
 #include <LibJS/Runtime/AggregateErrorPrototype.h>
 #include <LibJS/Runtime/ArrayBufferConstructor.h>
@@ -178,6 +179,9 @@ ThrowCompletionOr<void> Intrinsics::initialize_intrinsics(Realm& realm)
 {
     auto& vm = this->vm();
 
+    // NOTE: Nothing is collected until every field below has been set, so one write barrier at the end covers them all.
+    DeferGC defer_gc(heap());
+
     // These are done first since other prototypes depend on their presence.
     m_empty_object_shape = heap().allocate_without_realm<Shape>(realm);
     m_object_prototype = heap().allocate_without_realm<ObjectPrototype>(realm);
@@ -272,6 +276,7 @@ ThrowCompletionOr<void> Intrinsics::initialize_intrinsics(Realm& realm)
     m_json_stringify_function = &json_object()->get_without_side_effects(vm.names.stringify).as_function();
     m_object_prototype_to_string_function = &object_prototype()->get_without_side_effects(vm.names.toString).as_function();
 
+    write_barrier_for_unknown_edges();
     return {};
 }
 
@@ -288,6 +293,7 @@ JS_ENUMERATE_TYPED_ARRAYS
     void Intrinsics::initialize_##snake_namespace##snake_name()                                                                                          \
     {                                                                                                                                                    \
         auto& vm = this->vm();                                                                                                                           \
+        DeferGC defer_gc(heap());                                                                                                                        \
                                                                                                                                                          \
         VERIFY(!m_##snake_namespace##snake_name##_prototype);                                                                                            \
         VERIFY(!m_##snake_namespace##snake_name##_constructor);                                                                                          \
@@ -316,6 +322,7 @@ JS_ENUMERATE_TYPED_ARRAYS
             initialize_constructor(vm, vm.names.Symbol, *m_##snake_namespace##snake_name##_constructor, m_##snake_namespace##snake_name##_prototype);    \
         else                                                                                                                                             \
             initialize_constructor(vm, vm.names.ClassName, *m_##snake_namespace##snake_name##_constructor, m_##snake_namespace##snake_name##_prototype); \
+        write_barrier_for_unknown_edges();                                                                                                               \
     }                                                                                                                                                    \
                                                                                                                                                          \
     NonnullGCPtr<Namespace::ConstructorName> Intrinsics::snake_namespace##snake_name##_constructor()                                                     \
@@ -352,8 +359,10 @@ JS_ENUMERATE_TEMPORAL_OBJECTS
 #define __JS_ENUMERATE(ClassName, snake_name)                                       \
     NonnullGCPtr<ClassName> Intrinsics::snake_name##_object()                       \
     {                                                                               \
-        if (!m_##snake_name##_object)                                               \
+        if (!m_##snake_name##_object) {                                             \
             m_##snake_name##_object = heap().allocate<ClassName>(m_realm, m_realm); \
+            write_barrier(m_##snake_name##_object.ptr());                           \
+        }                                                                           \
         return *m_##snake_name##_object;                                            \
     }
 JS_ENUMERATE_BUILTIN_NAMESPACE_OBJECTS
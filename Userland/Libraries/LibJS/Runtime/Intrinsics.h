@@ -14,6 +14,7 @@ namespace JS {
 class Intrinsics final : public Cell {
     JS_CELL(Intrinsics, Cell);
     JS_DECLARE_ALLOCATOR(Intrinsics);
+    JS_CELL_HAS_WRITE_BARRIERS(Intrinsics);
 
 public:
     static ThrowCompletionOr<NonnullGCPtr<Intrinsics>> create(Realm&);
@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/CharacterTypes.h>
+#include <AK/FloatingPointStringConversions.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/Utf16View.h>
+#include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/Error.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/JSONParser.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/Shape.h>
+#include <LibJS/Runtime/ValueInlines.h>
+
+namespace JS {
+
+// Returns the offset of the first '"', '\' or control character at or after `offset`, or the length of `text` if there is none.
+// These are the only characters that end a run of literal characters in a string.
+static size_t find_end_of_literal_run(StringView text, size_t offset)
+{
+    using AK::SIMD::u8x16;
+
+    auto const* characters = reinterpret_cast<u8 const*>(text.characters_without_null_termination());
+    auto length = text.length();
+
+    for (; offset + sizeof(u8x16) <= length; offset += sizeof(u8x16)) {
+        u8x16 chunk;
+        __builtin_memcpy(&chunk, characters + offset, sizeof(chunk));
+        auto special_characters = (chunk == (u8x16 {} + '"')) | (chunk == (u8x16 {} + '\\')) | (chunk < (u8x16 {} + 0x20));
+        if (auto mask = AK::SIMD::maskbits(special_characters); mask != 0)
+            return offset + count_trailing_zeroes(static_cast<u32>(mask));
+    }
+
+    for (; offset < length; ++offset) {
+        auto ch = characters[offset];
+        if (ch == '"' || ch == '\\' || ch < 0x20)
+            break;
+    }
+    return offset;
+}
+
+ThrowCompletionOr<Value> JSONParser::parse(VM& vm, StringView text)
+{
+    JSONParser parser { vm, text };
+    Site root;
+
+    parser.skip_whitespace();
+    auto value = TRY(parser.parse_value(root, 0));
+    parser.skip_whitespace();
+    if (parser.m_offset != text.length())
+        return parser.syntax_error();
+    return value;
+}
+
+JSONParser::JSONParser(VM& vm, StringView text)
+    : m_vm(vm)
+    , m_text(text)
+{
+}
+
+JSONParser::Site& JSONParser::Site::child(size_t index)
+{
+    if (index >= children.size())
+        children.resize(index + 1);
+    if (!children[index])
+        children[index] = make<Site>();
+    return *children[index];
+}
+
+Completion JSONParser::syntax_error()
+{
+    return m_vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+}
+
+void JSONParser::skip_whitespace()
+{
+    while (m_offset < m_text.length()) {
+        auto ch = m_text[m_offset];
+        if (ch != ' ' && ch != '\n' && ch != '\r' && ch != '\t')
+            break;
+        ++m_offset;
+    }
+}
+
+ThrowCompletionOr<void> JSONParser::consume_specific(char expected)
+{
+    if (peek() != expected)
+        return syntax_error();
+    ++m_offset;
+    return {};
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_value(Site& parent, size_t index_in_parent)
+{
+    switch (peek()) {
+    case '{':
+    case '[':
+        if (m_vm.did_reach_stack_space_limit())
+            return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+        if (peek() == '{')
+            return parse_object(parent.child(index_in_parent));
+        return parse_array(parent.child(index_in_parent));
+    case '"':
+        return PrimitiveString::create(m_vm, ByteString { TRY(parse_string()) });
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        return parse_number();
+    case 't':
+        return parse_literal("true"sv, Value(true));
+    case 'f':
+        return parse_literal("false"sv, Value(false));
+    case 'n':
+        return parse_literal("null"sv, js_null());
+    default:
+        return syntax_error();
+    }
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_object(Site& site)
+{
+    auto& realm = *m_vm.current_realm();
+    auto object_prototype = realm.intrinsics().object_prototype();
+
+    TRY(consume_specific('{'));
+    skip_whitespace();
+    if (peek() == '}') {
+        ++m_offset;
+        return Object::create(realm, object_prototype);
+    }
+
+    // While the keys match the ones of the site's last object, the values are stored straight into an object that
+    // already has its final shape. On the first mismatch, we switch to defining the properties one by one.
+    bool using_site_shape = site.shape != nullptr;
+    auto object = using_site_shape ? Object::create_with_premade_shape(*site.shape) : Object::create(realm, object_prototype);
+    size_t member_count = 0;
+    Vector<DeprecatedFlyString> keys;
+
+    auto stop_using_site_shape = [&] {
+        auto fallback_object = Object::create(realm, object_prototype);
+        for (size_t i = 0; i < member_count; ++i)
+            fallback_object->define_direct_property(site.keys[i], object->get_direct(i), default_attributes);
+        keys.append(site.keys.data(), member_count);
+        object = fallback_object;
+        using_site_shape = false;
+    };
+
+    for (;;) {
+        skip_whitespace();
+        if (peek() != '"')
+            return syntax_error();
+        auto key = TRY(parse_string());
+        skip_whitespace();
+        TRY(consume_specific(':'));
+        skip_whitespace();
+
+        if (using_site_shape && (member_count >= site.keys.size() || site.keys[member_count] != key))
+            stop_using_site_shape();
+
+        if (using_site_shape) {
+            object->put_direct(member_count, TRY(parse_value(site, member_count)));
+        } else {
+            // NOTE: The key has to be copied before parsing the value, which may overwrite m_unescaped_string.
+            DeprecatedFlyString key_string { key };
+            auto value = TRY(parse_value(site, member_count));
+            object->define_direct_property(key_string, value, default_attributes);
+            keys.append(move(key_string));
+        }
+        ++member_count;
+
+        skip_whitespace();
+        if (peek() == '}')
+            break;
+        TRY(consume_specific(','));
+    }
+    ++m_offset;
+
+    if (using_site_shape) {
+        if (member_count == site.keys.size())
+            return object;
+        stop_using_site_shape();
+    }
+
+    // Only remember shapes that hold exactly the parsed members, i.e. there were no duplicate or array index keys.
+    auto& shape = object->shape();
+    if (!shape.is_dictionary() && shape.property_count() == member_count) {
+        site.shape = &shape;
+        site.keys = move(keys);
+    }
+    return object;
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_array(Site& site)
+{
+    auto& realm = *m_vm.current_realm();
+
+    TRY(consume_specific('['));
+    auto array = MUST(Array::create(realm, 0));
+    skip_whitespace();
+    if (peek() == ']') {
+        ++m_offset;
+        return array;
+    }
+
+    for (u32 index = 0;; ++index) {
+        skip_whitespace();
+        auto value = TRY(parse_value(site, 0));
+        array->define_direct_property(index, value, default_attributes);
+
+        skip_whitespace();
+        if (peek() == ']')
+            break;
+        TRY(consume_specific(','));
+    }
+    ++m_offset;
+    return array;
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_number()
+{
+    auto start = m_offset;
+    auto is_digit = [&] { return is_ascii_digit(peek()); };
+
+    bool negative = peek() == '-';
+    if (negative)
+        ++m_offset;
+
+    // Integers with up to 15 digits are exactly representable as doubles, so they don't need the full
+    // floating point parser.
+    u64 integer = 0;
+    size_t digit_count = 0;
+    if (peek() == '0') {
+        ++m_offset;
+        digit_count = 1;
+    } else if (is_digit()) {
+        for (; is_digit(); ++m_offset, ++digit_count)
+            integer = integer * 10 + (m_text[m_offset] - '0');
+    } else {
+        return syntax_error();
+    }
+
+    bool is_integer = true;
+    if (peek() == '.') {
+        ++m_offset;
+        if (!is_digit())
+            return syntax_error();
+        while (is_digit())
+            ++m_offset;
+        is_integer = false;
+    }
+    if (peek() == 'e' || peek() == 'E') {
+        ++m_offset;
+        if (peek() == '+' || peek() == '-')
+            ++m_offset;
+        if (!is_digit())
+            return syntax_error();
+        while (is_digit())
+            ++m_offset;
+        is_integer = false;
+    }
+
+    if (is_integer && digit_count <= 15) {
+        auto value = static_cast<double>(integer);
+        return Value(negative ? -value : value);
+    }
+
+    auto const* characters = m_text.characters_without_null_termination();
+    auto result = parse_first_floating_point<double>(characters + start, characters + m_offset);
+    if (result.end_ptr != characters + m_offset)
+        return syntax_error();
+    return Value(result.value);
+}
+
+ThrowCompletionOr<StringView> JSONParser::parse_string()
+{
+    TRY(consume_specific('"'));
+
+    // Most strings don't contain any escape sequences, so they can be returned as a view into the text.
+    auto start = m_offset;
+    m_offset = find_end_of_literal_run(m_text, m_offset);
+    if (peek() == '"') {
+        ++m_offset;
+        return m_text.substring_view(start, m_offset - start - 1);
+    }
+
+    m_unescaped_string.clear();
+    m_unescaped_string.append(m_text.substring_view(start, m_offset - start));
+
+    auto parse_code_unit = [&]() -> ThrowCompletionOr<u16> {
+        if (m_offset + 4 > m_text.length())
+            return syntax_error();
+        u16 code_unit = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            auto ch = m_text[m_offset++];
+            if (!is_ascii_hex_digit(ch))
+                return syntax_error();
+            code_unit = (code_unit << 4) | parse_ascii_hex_digit(ch);
+        }
+        return code_unit;
+    };
+
+    for (;;) {
+        if (m_offset >= m_text.length())
+            return syntax_error();
+
+        auto ch = m_text[m_offset++];
+        if (ch == '"')
+            return m_unescaped_string.string_view();
+        // Control characters have to be escaped.
+        if (ch != '\\')
+            return syntax_error();
+
+        switch (peek()) {
+        case '"':
+        case '\\':
+        case '/':
+            m_unescaped_string.append(m_text[m_offset++]);
+            break;
+        case 'b':
+            ++m_offset;
+            m_unescaped_string.append('\b');
+            break;
+        case 'f':
+            ++m_offset;
+            m_unescaped_string.append('\f');
+            break;
+        case 'n':
+            ++m_offset;
+            m_unescaped_string.append('\n');
+            break;
+        case 'r':
+            ++m_offset;
+            m_unescaped_string.append('\r');
+            break;
+        case 't':
+            ++m_offset;
+            m_unescaped_string.append('\t');
+            break;
+        case 'u': {
+            ++m_offset;
+            u32 code_point = TRY(parse_code_unit());
+            if (Utf16View::is_high_surrogate(code_point) && m_text.substring_view(m_offset).starts_with("\\u"sv)) {
+                auto offset_after_high_surrogate = m_offset;
+                m_offset += 2;
+                auto low_surrogate = TRY(parse_code_unit());
+                if (Utf16View::is_low_surrogate(low_surrogate))
+                    code_point = Utf16View::decode_surrogate_pair(code_point, low_surrogate);
+                else
+                    m_offset = offset_after_high_surrogate;
+            }
+            m_unescaped_string.append_code_point(code_point);
+            break;
+        }
+        default:
+            return syntax_error();
+        }
+
+        auto run_start = m_offset;
+        m_offset = find_end_of_literal_run(m_text, m_offset);
+        m_unescaped_string.append(m_text.substring_view(run_start, m_offset - run_start));
+    }
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_literal(StringView literal, Value value)
+{
+    if (!m_text.substring_view(m_offset).starts_with(literal))
+        return syntax_error();
+    m_offset += literal.length();
+    return value;
+}
+
+}
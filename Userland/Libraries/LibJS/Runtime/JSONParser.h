@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/DeprecatedFlyString.h>
+#include <AK/OwnPtr.h>
+#include <AK/StringBuilder.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Heap/GCPtr.h>
+#include <LibJS/Runtime/Completion.h>
+
+namespace JS {
+
+// Parses JSON text straight into JS values, without building an intermediate AK::JsonValue tree.
+class JSONParser {
+public:
+    static ThrowCompletionOr<Value> parse(VM&, StringView text);
+
+private:
+    // A site is a position in the document's structure, e.g. "the elements of this array" or "the value of the
+    // third member of these objects". Objects parsed at the same site usually have the same keys in the same order,
+    // so each site remembers the shape of the last object parsed there. If the next object's keys match, it is
+    // created with that shape directly instead of going through a property lookup and transition per key.
+    struct Site {
+        Site& child(size_t index);
+
+        // NOTE: The shape is kept alive by the object it was taken from, which is part of the value being parsed.
+        GCPtr<Shape> shape;
+        Vector<DeprecatedFlyString> keys;
+        Vector<OwnPtr<Site>> children;
+    };
+
+    JSONParser(VM&, StringView text);
+
+    ThrowCompletionOr<Value> parse_value(Site& parent, size_t index_in_parent);
+    ThrowCompletionOr<Value> parse_object(Site&);
+    ThrowCompletionOr<Value> parse_array(Site&);
+    ThrowCompletionOr<Value> parse_number();
+    ThrowCompletionOr<StringView> parse_string();
+    ThrowCompletionOr<Value> parse_literal(StringView literal, Value);
+
+    ThrowCompletionOr<void> consume_specific(char);
+    [[nodiscard]] Completion syntax_error();
+
+    char peek() const { return m_offset < m_text.length() ? m_text[m_offset] : '\0'; }
+    void skip_whitespace();
+
+    VM& m_vm;
+    StringView m_text;
+    size_t m_offset { 0 };
+
+    // Holds the contents of the last string that contained escape sequences.
+    StringBuilder m_unescaped_string;
+};
+
+}
@@ -19,6 +19,7 @@ namespace JS {
 class NativeFunction : public FunctionObject {
     JS_OBJECT(NativeFunction, FunctionObject);
     JS_DECLARE_ALLOCATOR(NativeFunction);
+    JS_CELL_HAS_WRITE_BARRIERS(NativeFunction);
 
 public:
     static NonnullGCPtr<NativeFunction> create(Realm&, Function<ThrowCompletionOr<Value>(VM&)> behaviour, i32 length, PropertyKey const& name, Optional<Realm*> = {}, Optional<Object*> prototype = {}, Optional<StringView> const& prefix = {});
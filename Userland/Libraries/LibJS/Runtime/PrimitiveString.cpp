@@ -21,10 +21,36 @@ namespace JS {
 
 JS_DEFINE_ALLOCATOR(PrimitiveString);
 
+// NOTE: Walking down a rope to find a substring is bounded by this, since ropes built by appending to a string in a loop
+//       are as deep as they are long. Resolving such a rope once is cheaper than walking it over and over.
+static constexpr size_t max_rope_depth_to_walk = 32;
+
+// NOTE: This has to agree with the UTF-16 conversion done by Utf16String, i.e. invalid UTF-8 becomes one replacement
+//       character per invalid sequence.
+static size_t utf16_length_of(StringView utf8_string)
+{
+    // OPTIMIZATION: Leading ASCII characters are one code unit per byte, no need to decode them.
+    size_t ascii_length = 0;
+    while (ascii_length < utf8_string.length() && is_ascii(static_cast<u8>(utf8_string[ascii_length])))
+        ++ascii_length;
+
+    size_t length = ascii_length;
+    for (auto code_point : Utf8View { utf8_string.substring_view(ascii_length) })
+        length += code_point < 0x10000 ? 1 : 2;
+    return length;
+}
+
+static void append_utf16_code_units(Utf16Data& code_units, StringView utf8_string)
+{
+    for (auto code_point : Utf8View { utf8_string })
+        MUST(code_point_to_utf16(code_units, code_point));
+}
+
 PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
     : m_is_rope(true)
     , m_lhs(&lhs)
     , m_rhs(&rhs)
+    , m_length_in_code_units(lhs.length_in_code_units() + rhs.length_in_code_units())
 {
 }
 
@@ -43,8 +69,11 @@ PrimitiveString::PrimitiveString(Utf16String string)
 {
 }
 
-PrimitiveString::~PrimitiveString()
+PrimitiveString::~PrimitiveString() = default;
+
+void PrimitiveString::finalize()
 {
+    Base::finalize();
     if (has_utf8_string())
         vm().string_cache().remove(*m_utf8_string);
     if (has_byte_string())
@@ -76,6 +105,49 @@ bool PrimitiveString::is_empty() const
     VERIFY_NOT_REACHED();
 }
 
+size_t PrimitiveString::length_in_code_units() const
+{
+    if (!m_length_in_code_units.has_value()) {
+        VERIFY(!m_is_rope);
+        if (has_utf16_string())
+            m_length_in_code_units = m_utf16_string->length_in_code_units();
+        else if (has_utf8_string())
+            m_length_in_code_units = utf16_length_of(m_utf8_string->bytes_as_string_view());
+        else if (has_byte_string())
+            m_length_in_code_units = utf16_length_of(m_byte_string->view());
+        else
+            VERIFY_NOT_REACHED();
+    }
+
+    return *m_length_in_code_units;
+}
+
+Utf16View PrimitiveString::utf16_substring_view(size_t code_unit_offset, size_t code_unit_length) const
+{
+    VERIFY(code_unit_offset + code_unit_length <= length_in_code_units());
+
+    // If the substring lies entirely within one piece of a rope, we only need that piece in UTF-16 form.
+    auto const* piece = this;
+    auto piece_offset = code_unit_offset;
+    for (size_t depth = 0; piece->m_is_rope; ++depth) {
+        // The piece is too far down, resolve the whole rope so that the next lookup is cheap.
+        if (depth == max_rope_depth_to_walk)
+            return utf16_string_view().substring_view(code_unit_offset, code_unit_length);
+
+        auto lhs_length = piece->m_lhs->length_in_code_units();
+        if (piece_offset + code_unit_length <= lhs_length) {
+            piece = piece->m_lhs.ptr();
+        } else if (piece_offset >= lhs_length) {
+            piece_offset -= lhs_length;
+            piece = piece->m_rhs.ptr();
+        } else {
+            break;
+        }
+    }
+
+    return piece->utf16_string_view().substring_view(piece_offset, code_unit_length);
+}
+
 String PrimitiveString::utf8_string() const
 {
     resolve_rope_if_needed(EncodingPreference::UTF8);
@@ -142,18 +214,17 @@ ThrowCompletionOr<Optional<Value>> PrimitiveString::get(VM& vm, PropertyKey cons
         return Optional<Value> {};
     if (property_key.is_string()) {
         if (property_key.as_string() == vm.names.length.as_string()) {
-            auto length = utf16_string().length_in_code_units();
+            auto length = length_in_code_units();
             return Value(static_cast<double>(length));
         }
     }
     auto index = canonical_numeric_index_string(property_key, CanonicalIndexMode::IgnoreNumericRoundtrip);
     if (!index.is_index())
         return Optional<Value> {};
-    auto str = utf16_string_view();
-    auto length = str.length_in_code_units();
+    auto length = length_in_code_units();
     if (length <= index.as_index())
         return Optional<Value> {};
-    return create(vm, Utf16String::create(str.substring_view(index.as_index(), 1)));
+    return create(vm, Utf16String::create(utf16_substring_view(index.as_index(), 1)));
 }
 
 NonnullGCPtr<PrimitiveString> PrimitiveString::create(VM& vm, Utf16String string)
@@ -275,8 +346,18 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
         // into a UTF-16 code unit buffer and create a Utf16String from it.
 
         Utf16Data code_units;
-        for (auto const* current : pieces)
-            code_units.extend(current->utf16_string().string());
+        code_units.ensure_capacity(*m_length_in_code_units);
+
+        // NOTE: Pieces that only exist as UTF-8 are converted straight into the result, rather than keeping a UTF-16 copy
+        //       of every piece around as well.
+        for (auto const* current : pieces) {
+            if (current->has_utf16_string())
+                code_units.extend(current->m_utf16_string->string());
+            else if (current->has_utf8_string())
+                append_utf16_code_units(code_units, current->m_utf8_string->bytes_as_string_view());
+            else
+                append_utf16_code_units(code_units, current->m_byte_string->view());
+        }
 
         m_utf16_string = Utf16String::create(move(code_units));
         m_is_rope = false;
@@ -286,7 +367,10 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
     }
 
     // Now that we have all the pieces, we can concatenate them using a StringBuilder.
-    StringBuilder builder;
+    size_t length_in_bytes = 0;
+    for (auto const* current : pieces)
+        length_in_bytes += current->utf8_string_view().length();
+    StringBuilder builder(length_in_bytes);
 
     // We keep track of the previous piece in order to handle surrogate pairs spread across two pieces.
     PrimitiveString const* previous = nullptr;
@@ -23,6 +23,7 @@ namespace JS {
 class PrimitiveString final : public Cell {
     JS_CELL(PrimitiveString, Cell);
     JS_DECLARE_ALLOCATOR(PrimitiveString);
+    JS_CELL_HAS_WRITE_BARRIERS(PrimitiveString);
 
 public:
     [[nodiscard]] static NonnullGCPtr<PrimitiveString> create(VM&, Utf16String);
@@ -40,6 +41,10 @@ public:
 
     bool is_empty() const;
 
+    // NOTE: These don't resolve ropes, so they're cheap to use on strings that are still being built up.
+    [[nodiscard]] size_t length_in_code_units() const;
+    [[nodiscard]] Utf16View utf16_substring_view(size_t code_unit_offset, size_t code_unit_length) const;
+
     [[nodiscard]] String utf8_string() const;
     [[nodiscard]] StringView utf8_string_view() const;
     bool has_utf8_string() const { return m_utf8_string.has_value(); }
@@ -60,6 +65,7 @@ private:
     explicit PrimitiveString(Utf16String);
 
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
 
     enum class EncodingPreference {
         UTF8,
@@ -72,6 +78,9 @@ private:
     mutable GCPtr<PrimitiveString> m_lhs;
     mutable GCPtr<PrimitiveString> m_rhs;
 
+    // NOTE: Ropes always know their length, other strings compute it on first use.
+    mutable Optional<size_t> m_length_in_code_units;
+
     mutable Optional<String> m_utf8_string;
     mutable Optional<ByteString> m_byte_string;
     mutable Optional<Utf16String> m_utf16_string;
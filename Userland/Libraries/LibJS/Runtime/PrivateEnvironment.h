@@ -31,6 +31,7 @@ struct PrivateName {
 class PrivateEnvironment : public Cell {
     JS_CELL(PrivateEnvironment, Cell);
     JS_DECLARE_ALLOCATOR(PrivateEnvironment);
+    JS_CELL_HAS_WRITE_BARRIERS(PrivateEnvironment);
 
 public:
     PrivateName resolve_private_identifier(DeprecatedFlyString const& identifier) const;
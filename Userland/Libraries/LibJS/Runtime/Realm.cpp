@@ -107,10 +107,12 @@ void Realm::set_global_object(Object* global_object, Object* this_value)
 
     // 4. Set realmRec.[[GlobalObject]] to globalObj.
     m_global_object = global_object;
+    write_barrier(global_object);
 
     // 5. Let newGlobalEnv be NewGlobalEnvironment(globalObj, thisValue).
     // 6. Set realmRec.[[GlobalEnv]] to newGlobalEnv.
     m_global_environment = m_global_object->heap().allocate_without_realm<GlobalEnvironment>(*global_object, *this_value);
+    write_barrier(m_global_environment.ptr());
 
     // 7. Return unused.
 }
@@ -23,6 +23,7 @@ namespace JS {
 class Realm final : public Cell {
     JS_CELL(Realm, Cell);
     JS_DECLARE_ALLOCATOR(Realm);
+    JS_CELL_HAS_WRITE_BARRIERS(Realm);
 
 public:
     struct HostDefined {
@@ -45,10 +46,16 @@ public:
     {
         VERIFY(!m_intrinsics);
         m_intrinsics = &intrinsics;
+        write_barrier(&intrinsics);
     }
 
     HostDefined* host_defined() { return m_host_defined; }
-    void set_host_defined(OwnPtr<HostDefined> host_defined) { m_host_defined = move(host_defined); }
+    // NOTE: The host defined data may not store other cells after it has been set.
+    void set_host_defined(OwnPtr<HostDefined> host_defined)
+    {
+        m_host_defined = move(host_defined);
+        write_barrier_for_unknown_edges();
+    }
 
     void define_builtin(Bytecode::Builtin builtin, NonnullGCPtr<NativeFunction> value)
     {
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonObject.h>
 #include <LibJS/Heap/DeferGC.h>
 #include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/VM.h>
@@ -15,8 +16,21 @@ JS_DEFINE_ALLOCATOR(PrototypeChainValidity);
 
 static HashTable<JS::GCPtr<Shape>> s_all_prototype_shapes;
 
-Shape::~Shape()
+static u32 s_dictionary_transition_threshold = 64;
+
+u32 Shape::dictionary_transition_threshold()
+{
+    return s_dictionary_transition_threshold;
+}
+
+void Shape::set_dictionary_transition_threshold(u32 threshold)
+{
+    s_dictionary_transition_threshold = threshold;
+}
+
+void Shape::finalize()
 {
+    Base::finalize();
     if (m_is_prototype_shape)
         s_all_prototype_shapes.remove(this);
 }
@@ -27,11 +41,10 @@ NonnullGCPtr<Shape> Shape::create_cacheable_dictionary_transition()
     new_shape->m_dictionary = true;
     new_shape->m_cacheable = true;
     new_shape->m_prototype = m_prototype;
+    new_shape->write_barrier(m_prototype.ptr());
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
-    ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = copy_property_table();
+    new_shape->m_property_count = m_property_count;
     return new_shape;
 }
 
@@ -39,13 +52,12 @@ NonnullGCPtr<Shape> Shape::create_uncacheable_dictionary_transition()
 {
     auto new_shape = heap().allocate_without_realm<Shape>(m_realm);
     new_shape->m_dictionary = true;
-    new_shape->m_cacheable = true;
+    new_shape->m_cacheable = false;
     new_shape->m_prototype = m_prototype;
+    new_shape->write_barrier(m_prototype.ptr());
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
-    ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = copy_property_table();
+    new_shape->m_property_count = m_property_count;
     return new_shape;
 }
 
@@ -111,6 +123,7 @@ NonnullGCPtr<Shape> Shape::create_put_transition(StringOrSymbol const& property_
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
         m_forward_transitions->set(key, new_shape.ptr());
+        write_barrier_for_property_key(property_key);
     }
     return new_shape;
 }
@@ -126,6 +139,7 @@ NonnullGCPtr<Shape> Shape::create_configure_transition(StringOrSymbol const& pro
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
         m_forward_transitions->set(key, new_shape.ptr());
+        write_barrier_for_property_key(property_key);
     }
     return new_shape;
 }
@@ -191,7 +205,8 @@ void Shape::visit_edges(Cell::Visitor& visitor)
     m_property_key.visit_edges(visitor);
 
     // NOTE: We don't need to mark the keys in the property table, since they are guaranteed
-    //       to also be marked by the chain of shapes leading up to this one.
+    //       to also be marked by the chain of shapes leading up to this one. A shared table may also
+    //       contain keys of shapes further down the chain, but those are never looked at from here.
 
     visitor.ignore(m_prototype_transitions);
 
@@ -214,8 +229,9 @@ Optional<PropertyMetadata> Shape::lookup(StringOrSymbol const& property_key) con
 {
     if (m_property_count == 0)
         return {};
-    auto property = property_table().get(property_key);
-    if (!property.has_value())
+    ensure_property_table();
+    auto property = m_property_table->entries.get(property_key);
+    if (!property.has_value() || property->offset >= m_property_count)
         return {};
     return property;
 }
@@ -223,51 +239,96 @@ Optional<PropertyMetadata> Shape::lookup(StringOrSymbol const& property_key) con
 FLATTEN OrderedHashMap<StringOrSymbol, PropertyMetadata> const& Shape::property_table() const
 {
     ensure_property_table();
-    return *m_property_table;
+    // NOTE: Callers look at every entry, so don't hand out a shared table that has grown past this shape.
+    if (m_property_table->entries.size() != m_property_count)
+        m_property_table = copy_property_table();
+    return m_property_table->entries;
+}
+
+NonnullRefPtr<PropertyTable> Shape::copy_property_table() const
+{
+    ensure_property_table();
+    auto copy = make_ref_counted<PropertyTable>();
+    copy->entries.ensure_capacity(m_property_count);
+    for (auto const& it : m_property_table->entries) {
+        if (copy->entries.size() == m_property_count)
+            break;
+        copy->entries.set(it.key, it.value);
+    }
+    return copy;
+}
+
+void Shape::ensure_exclusive_property_table() const
+{
+    ensure_property_table();
+    if (m_property_table->ref_count() == 1 && m_property_table->entries.size() == m_property_count)
+        return;
+    m_property_table = copy_property_table();
 }
 
 void Shape::ensure_property_table() const
 {
     if (m_property_table)
         return;
-    m_property_table = make<OrderedHashMap<StringOrSymbol, PropertyMetadata>>();
-
-    u32 next_offset = 0;
 
+    Shape const* shape_with_table = nullptr;
     Vector<Shape const&, 64> transition_chain;
     transition_chain.append(*this);
     for (auto shape = m_previous; shape; shape = shape->m_previous) {
         if (shape->m_property_table) {
-            *m_property_table = *shape->m_property_table;
-            next_offset = shape->m_property_count;
+            shape_with_table = shape;
             break;
         }
         transition_chain.append(*shape);
     }
 
+    // OPTIMIZATION: If only properties were added since the last shape with a property table, and no other shape
+    //               has added its own properties to that table yet, extend the table and share it with every
+    //               shape in between instead of giving each of them a copy.
+    bool only_puts = all_of(transition_chain, [](Shape const& shape) {
+        return shape.m_transition_type != TransitionType::Configure && shape.m_transition_type != TransitionType::Delete;
+    });
+    if (only_puts && (!shape_with_table || shape_with_table->m_property_table->entries.size() == shape_with_table->m_property_count)) {
+        auto table = shape_with_table ? NonnullRefPtr { *shape_with_table->m_property_table } : make_ref_counted<PropertyTable>();
+        u32 next_offset = shape_with_table ? shape_with_table->m_property_count : 0;
+        for (auto const& shape : transition_chain.in_reverse()) {
+            if (shape.m_transition_type == TransitionType::Put)
+                table->entries.set(shape.m_property_key, { next_offset++, shape.m_attributes });
+            shape.m_property_table = table;
+        }
+        VERIFY(next_offset == m_property_count);
+        return;
+    }
+
+    auto table = shape_with_table ? shape_with_table->copy_property_table() : make_ref_counted<PropertyTable>();
+    auto& entries = table->entries;
+    u32 next_offset = shape_with_table ? shape_with_table->m_property_count : 0;
+
     for (auto const& shape : transition_chain.in_reverse()) {
         if (!shape.m_property_key.is_valid()) {
             // Ignore prototype transitions as they don't affect the key map.
             continue;
         }
         if (shape.m_transition_type == TransitionType::Put) {
-            m_property_table->set(shape.m_property_key, { next_offset++, shape.m_attributes });
+            entries.set(shape.m_property_key, { next_offset++, shape.m_attributes });
         } else if (shape.m_transition_type == TransitionType::Configure) {
-            auto it = m_property_table->find(shape.m_property_key);
-            VERIFY(it != m_property_table->end());
+            auto it = entries.find(shape.m_property_key);
+            VERIFY(it != entries.end());
             it->value.attributes = shape.m_attributes;
         } else if (shape.m_transition_type == TransitionType::Delete) {
-            auto remove_it = m_property_table->find(shape.m_property_key);
-            VERIFY(remove_it != m_property_table->end());
+            auto remove_it = entries.find(shape.m_property_key);
+            VERIFY(remove_it != entries.end());
             auto removed_offset = remove_it->value.offset;
-            m_property_table->remove(remove_it);
-            for (auto& it : *m_property_table) {
+            entries.remove(remove_it);
+            for (auto& it : entries) {
                 if (it.value.offset > removed_offset)
                     --it.value.offset;
             }
             --next_offset;
         }
     }
+
+    m_property_table = move(table);
 }
 
 NonnullGCPtr<Shape> Shape::create_delete_transition(StringOrSymbol const& property_key)
@@ -279,14 +340,15 @@ NonnullGCPtr<Shape> Shape::create_delete_transition(StringOrSymbol const& proper
     if (!m_delete_transitions)
         m_delete_transitions = make<HashMap<StringOrSymbol, WeakPtr<Shape>>>();
     m_delete_transitions->set(property_key, new_shape.ptr());
+    write_barrier_for_property_key(property_key);
     return new_shape;
 }
 
 void Shape::add_property_without_transition(StringOrSymbol const& property_key, PropertyAttributes attributes)
 {
     VERIFY(property_key.is_valid());
-    ensure_property_table();
-    if (m_property_table->set(property_key, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry) {
+    ensure_exclusive_property_table();
+    if (m_property_table->entries.set(property_key, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry) {
         VERIFY(m_property_count < NumericLimits<u32>::max());
         ++m_property_count;
     }
@@ -302,19 +364,21 @@ void Shape::set_property_attributes_without_transition(StringOrSymbol const& pro
 {
     VERIFY(is_dictionary());
     VERIFY(m_property_table);
-    auto it = m_property_table->find(property_key);
-    VERIFY(it != m_property_table->end());
+    ensure_exclusive_property_table();
+    auto it = m_property_table->entries.find(property_key);
+    VERIFY(it != m_property_table->entries.end());
     it->value.attributes = attributes;
-    m_property_table->set(property_key, it->value);
 }
 
 void Shape::remove_property_without_transition(StringOrSymbol const& property_key, u32 offset)
 {
     VERIFY(is_uncacheable_dictionary());
     VERIFY(m_property_table);
-    if (m_property_table->remove(property_key))
+    ensure_exclusive_property_table();
+    auto& entries = m_property_table->entries;
+    if (entries.remove(property_key))
         --m_property_count;
-    for (auto& it : *m_property_table) {
+    for (auto& it : entries) {
         VERIFY(it.value.offset != offset);
         if (it.value.offset > offset)
             --it.value.offset;
@@ -327,7 +391,9 @@ NonnullGCPtr<Shape> Shape::create_for_prototype(NonnullGCPtr<Realm> realm, GCPtr
     s_all_prototype_shapes.set(new_shape);
     new_shape->m_is_prototype_shape = true;
     new_shape->m_prototype = prototype;
+    new_shape->write_barrier(prototype.ptr());
     new_shape->m_prototype_chain_validity = realm->heap().allocate_without_realm<PrototypeChainValidity>();
+    new_shape->write_barrier(new_shape->m_prototype_chain_validity.ptr());
     return new_shape;
 }
 
@@ -339,11 +405,11 @@ NonnullGCPtr<Shape> Shape::clone_for_prototype()
     s_all_prototype_shapes.set(new_shape);
     new_shape->m_is_prototype_shape = true;
     new_shape->m_prototype = m_prototype;
-    ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->write_barrier(m_prototype.ptr());
+    new_shape->m_property_table = copy_property_table();
+    new_shape->m_property_count = m_property_count;
     new_shape->m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
+    new_shape->write_barrier(new_shape->m_prototype_chain_validity.ptr());
     return new_shape;
 }
 
@@ -352,6 +418,7 @@ void Shape::set_prototype_without_transition(Object* new_prototype)
     VERIFY(new_prototype);
     new_prototype->convert_to_prototype_if_needed();
     m_prototype = new_prototype;
+    write_barrier(new_prototype);
 }
 
 void Shape::set_prototype_shape()
@@ -360,6 +427,14 @@ void Shape::set_prototype_shape()
     s_all_prototype_shapes.set(this);
     m_is_prototype_shape = true;
     m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
+    write_barrier(m_prototype_chain_validity.ptr());
+}
+
+// The keys of forward and delete transitions are strong edges of this shape, see visit_edges().
+void Shape::write_barrier_for_property_key(StringOrSymbol const& property_key)
+{
+    if (property_key.is_symbol())
+        write_barrier(property_key.as_symbol());
 }
 
 void Shape::invalidate_prototype_if_needed_for_new_prototype(NonnullGCPtr<Shape> new_prototype_shape)
@@ -391,7 +466,73 @@ void Shape::invalidate_all_prototype_chains_leading_to_this()
     for (auto* shape : shapes_to_invalidate) {
         shape->m_prototype_chain_validity->set_valid(false);
         shape->m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
+        shape->write_barrier(shape->m_prototype_chain_validity.ptr());
     }
 }
 
+template<typename Map>
+static size_t hash_map_size_in_bytes(Map const& map, bool is_ordered)
+{
+    // NOTE: This mirrors the bucket layout of AK::HashTable, which isn't exposed.
+    size_t bucket_size = sizeof(typename Map::KeyType) + sizeof(typename Map::ValueType) + sizeof(void*);
+    if (is_ordered)
+        bucket_size += 2 * sizeof(void*);
+    return map.capacity() * bucket_size;
+}
+
+ShapeStatistics Shape::gather_statistics(Realm& realm)
+{
+    ShapeStatistics statistics;
+    HashTable<PropertyTable const*> seen_property_tables;
+
+    realm.heap().for_each_live_cell([&](Cell* cell) {
+        if (!is<Shape>(*cell))
+            return;
+        auto& shape = static_cast<Shape&>(*cell);
+        if (shape.m_realm != &realm)
+            return;
+
+        ++statistics.shape_count;
+        if (shape.m_dictionary)
+            ++statistics.dictionary_shape_count;
+        if (shape.m_is_prototype_shape)
+            ++statistics.prototype_shape_count;
+
+        if (auto const* table = shape.m_property_table.ptr(); table && seen_property_tables.set(table) == AK::HashSetResult::InsertedNewEntry) {
+            ++statistics.property_table_count;
+            if (table->ref_count() > 1)
+                ++statistics.shared_property_table_count;
+            statistics.property_table_bytes += sizeof(PropertyTable) + hash_map_size_in_bytes(table->entries, true);
+        }
+
+        if (shape.m_forward_transitions)
+            statistics.transition_table_bytes += hash_map_size_in_bytes(*shape.m_forward_transitions, false);
+        if (shape.m_prototype_transitions)
+            statistics.transition_table_bytes += hash_map_size_in_bytes(*shape.m_prototype_transitions, false);
+        if (shape.m_delete_transitions)
+            statistics.transition_table_bytes += hash_map_size_in_bytes(*shape.m_delete_transitions, false);
+
+        size_t chain_length = 0;
+        for (Shape const* it = &shape; it; it = it->m_previous)
+            ++chain_length;
+        statistics.longest_transition_chain = max(statistics.longest_transition_chain, chain_length);
+    });
+
+    return statistics;
+}
+
+JsonObject ShapeStatistics::to_json() const
+{
+    JsonObject object;
+    object.set("shapeCount", shape_count);
+    object.set("dictionaryShapeCount", dictionary_shape_count);
+    object.set("prototypeShapeCount", prototype_shape_count);
+    object.set("propertyTableCount", property_table_count);
+    object.set("sharedPropertyTableCount", shared_property_table_count);
+    object.set("propertyTableBytes", property_table_bytes);
+    object.set("transitionTableBytes", transition_table_bytes);
+    object.set("longestTransitionChain", longest_transition_chain);
+    return object;
+}
+
 }
@@ -8,6 +8,8 @@
 
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/StringView.h>
 #include <AK/WeakPtr.h>
 #include <AK/Weakable.h>
@@ -24,6 +26,26 @@ struct PropertyMetadata {
     PropertyAttributes attributes { 0 };
 };
 
+// A property table is shared by all the shapes along a chain of put transitions that has not branched.
+// Since offsets are assigned in insertion order there, each shape sees exactly the first
+// `property_count()` entries of the table, i.e. the ones whose offset is below its property count.
+struct PropertyTable : public RefCounted<PropertyTable> {
+    OrderedHashMap<StringOrSymbol, PropertyMetadata> entries;
+};
+
+struct ShapeStatistics {
+    size_t shape_count { 0 };
+    size_t dictionary_shape_count { 0 };
+    size_t prototype_shape_count { 0 };
+    size_t property_table_count { 0 };
+    size_t shared_property_table_count { 0 };
+    size_t property_table_bytes { 0 };
+    size_t transition_table_bytes { 0 };
+    size_t longest_transition_chain { 0 };
+
+    JsonObject to_json() const;
+};
+
 struct TransitionKey {
     StringOrSymbol property_key;
     PropertyAttributes attributes { 0 };
@@ -50,9 +72,10 @@ private:
 class Shape final : public Cell {
     JS_CELL(Shape, Cell);
     JS_DECLARE_ALLOCATOR(Shape);
+    JS_CELL_HAS_WRITE_BARRIERS(Shape);
 
 public:
-    virtual ~Shape() override;
+    virtual ~Shape() override = default;
 
     enum class TransitionType : u8 {
         Invalid,
@@ -87,6 +110,13 @@ public:
     [[nodiscard]] bool is_prototype_shape() const { return m_is_prototype_shape; }
     void set_prototype_shape();
 
+    // Objects with at least this many named properties stop transitioning and get a dictionary shape of their own.
+    static u32 dictionary_transition_threshold();
+    static void set_dictionary_transition_threshold(u32);
+
+    // Collects statistics about the live shapes of `realm`. Property tables shared by several shapes are only counted once.
+    static ShapeStatistics gather_statistics(Realm&);
+
     GCPtr<PrototypeChainValidity> prototype_chain_validity() const { return m_prototype_chain_validity; }
 
     Realm& realm() const { return m_realm; }
@@ -112,19 +142,23 @@ private:
     Shape(Shape& previous_shape, Object* new_prototype);
 
     void invalidate_prototype_if_needed_for_new_prototype(NonnullGCPtr<Shape> new_prototype_shape);
+    void write_barrier_for_property_key(StringOrSymbol const&);
     void invalidate_all_prototype_chains_leading_to_this();
 
     virtual void visit_edges(Visitor&) override;
+    virtual void finalize() override;
 
     [[nodiscard]] GCPtr<Shape> get_or_prune_cached_forward_transition(TransitionKey const&);
     [[nodiscard]] GCPtr<Shape> get_or_prune_cached_prototype_transition(Object* prototype);
     [[nodiscard]] GCPtr<Shape> get_or_prune_cached_delete_transition(StringOrSymbol const&);
 
     void ensure_property_table() const;
+    void ensure_exclusive_property_table() const;
+    [[nodiscard]] NonnullRefPtr<PropertyTable> copy_property_table() const;
 
     NonnullGCPtr<Realm> m_realm;
 
-    mutable OwnPtr<OrderedHashMap<StringOrSymbol, PropertyMetadata>> m_property_table;
+    mutable RefPtr<PropertyTable> m_property_table;
 
     OwnPtr<HashMap<TransitionKey, WeakPtr<Shape>>> m_forward_transitions;
     OwnPtr<HashMap<GCPtr<Object>, WeakPtr<Shape>>> m_prototype_transitions;
@@ -13,6 +13,7 @@ namespace JS {
 class StringObject : public Object {
     JS_OBJECT(StringObject, Object);
     JS_DECLARE_ALLOCATOR(StringObject);
+    JS_CELL_HAS_WRITE_BARRIERS(StringObject);
 
 public:
     [[nodiscard]] static NonnullGCPtr<StringObject> create(Realm&, PrimitiveString&, Object& prototype);
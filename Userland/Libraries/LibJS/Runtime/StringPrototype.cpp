@@ -48,6 +48,14 @@ static ThrowCompletionOr<Utf16String> utf16_string_from(VM& vm)
     return TRY(this_value.to_utf16_string(vm));
 }
 
+// NOTE: Builtins that only look at part of the string use this instead of utf16_string_from(), so that they don't
+//       resolve rope strings that are still being built up.
+static ThrowCompletionOr<NonnullGCPtr<PrimitiveString>> primitive_string_from(VM& vm)
+{
+    auto this_value = TRY(require_object_coercible(vm, vm.this_value()));
+    return TRY(this_value.to_primitive_string(vm));
+}
+
 // 22.1.3.21.1 SplitMatch ( S, q, R ), https://tc39.es/ecma262/#sec-splitmatch
 // FIXME: This no longer exists in the spec!
 static Optional<size_t> split_match(Utf16View const& haystack, size_t start, Utf16View const& needle)
@@ -251,9 +259,9 @@ static ThrowCompletionOr<NonnullGCPtr<PrimitiveString>> this_string_value(VM& vm
 JS_DEFINE_NATIVE_FUNCTION(StringPrototype::at)
 {
     // 1. Let O be ? ToObject(this value).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
     // 2. Let len be ? LengthOfArrayLike(O).
-    auto length = string.length_in_code_units();
+    auto length = string->length_in_code_units();
 
     // 3. Let relativeIndex be ? ToIntegerOrInfinity(index).
     auto relative_index = TRY(vm.argument(0).to_integer_or_infinity(vm));
@@ -277,7 +285,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::at)
         return js_undefined();
 
     // 7. Return ? Get(O, ! ToString(𝔽(k))).
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(index.value(), 1)));
+    return PrimitiveString::create(vm, Utf16String::create(string->utf16_substring_view(index.value(), 1)));
 }
 
 // 22.1.3.2 String.prototype.charAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.charat
@@ -285,18 +293,18 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_at)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let position be ? ToIntegerOrInfinity(pos).
     auto position = TRY(vm.argument(0).to_integer_or_infinity(vm));
 
     // 4. Let size be the length of S.
     // 5. If position < 0 or position ≥ size, return the empty String.
-    if (position < 0 || position >= string.length_in_code_units())
+    if (position < 0 || position >= string->length_in_code_units())
         return PrimitiveString::create(vm, String {});
 
     // 6. Return the substring of S from position to position + 1.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(position, 1)));
+    return PrimitiveString::create(vm, Utf16String::create(string->utf16_substring_view(position, 1)));
 }
 
 // 22.1.3.3 String.prototype.charCodeAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.charcodeat
@@ -304,18 +312,18 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_code_at)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let position be ? ToIntegerOrInfinity(pos).
     auto position = TRY(vm.argument(0).to_integer_or_infinity(vm));
 
     // 4. Let size be the length of S.
     // 5. If position < 0 or position ≥ size, return NaN.
-    if (position < 0 || position >= string.length_in_code_units())
+    if (position < 0 || position >= string->length_in_code_units())
         return js_nan();
 
     // 6. Return the Number value for the numeric value of the code unit at index position within the String S.
-    return Value(string.code_unit_at(position));
+    return Value(string->utf16_substring_view(position, 1).code_unit_at(0));
 }
 
 // 22.1.3.4 String.prototype.codePointAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.codepointat
@@ -323,18 +331,21 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::code_point_at)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let position be ? ToIntegerOrInfinity(pos).
     auto position = TRY(vm.argument(0).to_integer_or_infinity(vm));
 
     // 4. Let size be the length of S.
+    auto size = string->length_in_code_units();
+
     // 5. If position < 0 or position ≥ size, return undefined.
-    if (position < 0 || position >= string.length_in_code_units())
+    if (position < 0 || position >= size)
         return js_undefined();
 
     // 6. Let cp be CodePointAt(S, position).
-    auto code_point = JS::code_point_at(string.view(), position);
+    // NOTE: A code point is at most two code units long, so that's all we need to look at.
+    auto code_point = JS::code_point_at(string->utf16_substring_view(position, min<size_t>(2, size - position)), 0);
 
     // 7. Return 𝔽(cp.[[CodePoint]]).
     return Value(code_point.code_point);
@@ -373,7 +384,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::ends_with)
 
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // Let isRegExp be ? IsRegExp(searchString).
     bool is_regexp = TRY(search_string_value.is_regexp(vm));
@@ -386,7 +397,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::ends_with)
     auto search_string = TRY(search_string_value.to_utf16_string(vm));
 
     // 6. Let len be the length of S.
-    auto string_length = string.length_in_code_units();
+    auto string_length = string->length_in_code_units();
 
     // 7. If endPosition is undefined, let pos be len; else let pos be ? ToIntegerOrInfinity(endPosition).
     size_t end = string_length;
@@ -412,7 +423,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::ends_with)
     size_t start = end - search_length;
 
     // 13. Let substring be the substring of S from start to end.
-    auto substring_view = string.substring_view(start, end - start);
+    auto substring_view = string->utf16_substring_view(start, end - start);
 
     // 14. If substring is searchStr, return true.
     // 15. Return false.
@@ -1018,10 +1029,10 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::slice)
 
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let len be the length of S.
-    auto string_length = static_cast<double>(string.length_in_code_units());
+    auto string_length = static_cast<double>(string->length_in_code_units());
 
     // 4. Let intStart be ? ToIntegerOrInfinity(start).
     auto int_start = TRY(start.to_integer_or_infinity(vm));
@@ -1056,7 +1067,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::slice)
         return PrimitiveString::create(vm, String {});
 
     // 13. Return the substring of S from from to to.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(int_start, int_end - int_start)));
+    return PrimitiveString::create(vm, Utf16String::create(string->utf16_substring_view(int_start, int_end - int_start)));
 }
 
 // 22.1.3.23 String.prototype.split ( separator, limit ), https://tc39.es/ecma262/#sec-string.prototype.split
@@ -1169,7 +1180,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::starts_with)
 
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let isRegExp be ? IsRegExp(searchString).
     bool is_regexp = TRY(search_string_value.is_regexp(vm));
@@ -1182,7 +1193,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::starts_with)
     auto search_string = TRY(search_string_value.to_utf16_string(vm));
 
     // 6. Let len be the length of S.
-    auto string_length = string.length_in_code_units();
+    auto string_length = string->length_in_code_units();
 
     size_t start = 0;
 
@@ -1209,7 +1220,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::starts_with)
         return Value(false);
 
     // 13. Let substring be the substring of S from start to end.
-    auto substring_view = string.substring_view(start, end - start);
+    auto substring_view = string->utf16_substring_view(start, end - start);
 
     // 14. If substring is searchStr, return true.
     // 15. Return false.
@@ -1221,10 +1232,10 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substring)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let len be the length of S.
-    auto string_length = static_cast<double>(string.length_in_code_units());
+    auto string_length = static_cast<double>(string->length_in_code_units());
 
     // 4. Let intStart be ? ToIntegerOrInfinity(start).
     auto start = TRY(vm.argument(0).to_integer_or_infinity(vm));
@@ -1247,7 +1258,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substring)
     size_t to = max(final_start, final_end);
 
     // 10. Return the substring of S from from to to.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(from, to - from)));
+    return PrimitiveString::create(vm, Utf16String::create(string->utf16_substring_view(from, to - from)));
 }
 
 enum class TargetCase {
@@ -1484,10 +1495,10 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substr)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let size be the length of S.
-    auto size = string.length_in_code_units();
+    auto size = string->length_in_code_units();
 
     // 4. Let intStart be ? ToIntegerOrInfinity(start).
     auto int_start = TRY(vm.argument(0).to_integer_or_infinity(vm));
@@ -1516,7 +1527,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substr)
         return PrimitiveString::create(vm, String {});
 
     // 11. Return the substring of S from intStart to intEnd.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(int_start, int_end - int_start)));
+    return PrimitiveString::create(vm, Utf16String::create(string->utf16_substring_view(int_start, int_end - int_start)));
 }
 
 // B.2.2.2.1 CreateHTML ( string, tag, attribute, value ), https://tc39.es/ecma262/#sec-createhtml
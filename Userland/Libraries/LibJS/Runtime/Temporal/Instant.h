@@ -19,6 +19,7 @@ namespace JS::Temporal {
 class Instant final : public Object {
     JS_OBJECT(Instant, Object);
     JS_DECLARE_ALLOCATOR(Instant);
+    JS_CELL_HAS_WRITE_BARRIERS(Instant);
 
 public:
     virtual ~Instant() override = default;
@@ -30,6 +30,7 @@
 #include <LibJS/Runtime/Reference.h>
 #include <LibJS/Runtime/Symbol.h>
 #include <LibJS/Runtime/VM.h>
+#include <LibJS/ScriptCache.h>
 #include <LibJS/SourceTextModule.h>
 #include <LibJS/SyntheticModule.h>
 
@@ -67,6 +68,7 @@ VM::VM(OwnPtr<CustomData> custom_data, ErrorMessages error_messages)
     , m_custom_data(move(custom_data))
 {
     m_bytecode_interpreter = make<Bytecode::Interpreter>(*this);
+    m_script_cache = make<ScriptCache>();
 
     m_empty_string = m_heap.allocate_without_realm<PrimitiveString>(String {});
 
@@ -53,6 +53,8 @@ public:
 
     Bytecode::Interpreter& bytecode_interpreter();
 
+    ScriptCache& script_cache() { return *m_script_cache; }
+
     void dump_backtrace() const;
 
     void gather_roots(HashMap<Cell*, HeapRoot>&);
@@ -331,6 +333,8 @@ private:
 
     OwnPtr<Bytecode::Interpreter> m_bytecode_interpreter;
 
+    OwnPtr<ScriptCache> m_script_cache;
+
     bool m_dynamic_imports_allowed { false };
 };
 
@@ -19,6 +19,8 @@ public:
     virtual void remove_dead_cells(Badge<Heap>) = 0;
 
 protected:
+    // NOTE: Owners have to call this from Cell::finalize(), since the heap must not ask a dead container to remove
+    //       dead cells while it waits to be swept.
     void deregister();
 
 private:
@@ -21,6 +21,12 @@ WeakMap::WeakMap(Object& prototype)
 {
 }
 
+void WeakMap::finalize()
+{
+    Base::finalize();
+    WeakContainer::deregister();
+}
+
 void WeakMap::remove_dead_cells(Badge<Heap>)
 {
     m_values.remove_all_matching([](Cell* key, Value) {
@@ -28,6 +28,7 @@ public:
     HashMap<GCPtr<Cell>, Value>& values() { return m_values; }
 
     virtual void remove_dead_cells(Badge<Heap>) override;
+    virtual void finalize() override;
 
 private:
     explicit WeakMap(Object& prototype);
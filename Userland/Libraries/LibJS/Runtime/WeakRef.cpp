@@ -36,6 +36,12 @@ WeakRef::WeakRef(Symbol& value, Object& prototype)
 {
 }
 
+void WeakRef::finalize()
+{
+    Base::finalize();
+    WeakContainer::deregister();
+}
+
 void WeakRef::remove_dead_cells(Badge<Heap>)
 {
     if (m_value.visit([](Cell* cell) -> bool { return cell->state() == Cell::State::Live; }, [](Empty) -> bool { VERIFY_NOT_REACHED(); }))
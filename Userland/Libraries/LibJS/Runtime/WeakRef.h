@@ -17,6 +17,7 @@ class WeakRef final
     , public WeakContainer {
     JS_OBJECT(WeakRef, Object);
     JS_DECLARE_ALLOCATOR(WeakRef);
+    JS_CELL_HAS_WRITE_BARRIERS(WeakRef);
 
 public:
     static NonnullGCPtr<WeakRef> create(Realm&, Object&);
@@ -26,9 +27,15 @@ public:
 
     auto const& value() const { return m_value; }
 
-    void update_execution_generation() { m_last_execution_generation = vm().execution_generation(); }
+    void update_execution_generation()
+    {
+        m_last_execution_generation = vm().execution_generation();
+        // NOTE: This makes visit_edges() visit the value again.
+        write_barrier_for_unknown_edges();
+    }
 
     virtual void remove_dead_cells(Badge<Heap>) override;
+    virtual void finalize() override;
 
 private:
     explicit WeakRef(Object&, Object& prototype);
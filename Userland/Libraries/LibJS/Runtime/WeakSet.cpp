@@ -21,6 +21,12 @@ WeakSet::WeakSet(Object& prototype)
 {
 }
 
+void WeakSet::finalize()
+{
+    Base::finalize();
+    WeakContainer::deregister();
+}
+
 void WeakSet::remove_dead_cells(Badge<Heap>)
 {
     m_values.remove_all_matching([](Cell* cell) {
@@ -28,6 +28,7 @@ public:
     HashTable<GCPtr<Cell>>& values() { return m_values; }
 
     virtual void remove_dead_cells(Badge<Heap>) override;
+    virtual void finalize() override;
 
 private:
     explicit WeakSet(Object& prototype);
@@ -9,6 +9,7 @@
 #include <LibJS/Parser.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Script.h>
+#include <LibJS/ScriptCache.h>
 
 namespace JS {
 
@@ -17,6 +18,13 @@ JS_DEFINE_ALLOCATOR(Script);
 // 16.1.5 ParseScript ( sourceText, realm, hostDefined ), https://tc39.es/ecma262/#sec-parse-script
 Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView source_text, Realm& realm, StringView filename, HostDefined* host_defined, size_t line_number_offset)
 {
+    // OPTIMIZATION: Parsing the same source text again gives the same parse tree, so reuse one we made earlier if we can.
+    //               Only successfully parsed scripts are cached, so this can never skip step 2 below.
+    auto& script_cache = realm.vm().script_cache();
+    auto cache_key = ScriptCache::key_for(source_text, filename, line_number_offset);
+    if (auto cached_script = script_cache.find(cache_key))
+        return realm.heap().allocate_without_realm<Script>(realm, filename, cached_script.release_nonnull(), host_defined);
+
     // 1. Let script be ParseText(sourceText, Script).
     auto parser = Parser(Lexer(source_text, filename, line_number_offset));
     auto script = parser.parse_program();
@@ -25,6 +33,8 @@ Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView sourc
     if (parser.has_errors())
         return parser.errors();
 
+    script_cache.add(cache_key, script, source_text.length());
+
     // 3. Return Script Record { [[Realm]]: realm, [[ECMAScriptCode]]: script, [[HostDefined]]: hostDefined }.
     return realm.heap().allocate_without_realm<Script>(realm, filename, move(script), host_defined);
 }
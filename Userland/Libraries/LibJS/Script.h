@@ -18,6 +18,7 @@ namespace JS {
 class Script final : public Cell {
     JS_CELL(Script, Cell);
     JS_DECLARE_ALLOCATOR(Script);
+    JS_CELL_HAS_WRITE_BARRIERS(Script);
 
 public:
     struct HostDefined {
@@ -31,7 +32,11 @@ public:
 
     Realm& realm() { return *m_realm; }
     Program const& parse_node() const { return *m_parse_node; }
-    Vector<ModuleWithSpecifier>& loaded_modules() { return m_loaded_modules; }
+    Vector<ModuleWithSpecifier>& loaded_modules()
+    {
+        write_barrier_for_unknown_edges();
+        return m_loaded_modules;
+    }
     Vector<ModuleWithSpecifier> const& loaded_modules() const { return m_loaded_modules; }
 
     HostDefined* host_defined() const { return m_host_defined; }
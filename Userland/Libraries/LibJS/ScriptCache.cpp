@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/AST.h>
+#include <LibJS/ScriptCache.h>
+
+namespace JS {
+
+// NOTE: These keep whole parse trees (and the bytecode hanging off of them) alive, so don't let them grow unbounded.
+static constexpr size_t max_number_of_cached_scripts = 32;
+static constexpr size_t max_total_cached_source_length = 64 * MiB;
+
+ScriptCache::ScriptCache() = default;
+ScriptCache::~ScriptCache() = default;
+
+ScriptCache::Key ScriptCache::key_for(StringView source_text, StringView filename, size_t line_number_offset)
+{
+    // NOTE: The filename and line number offset end up in the source positions of the parse tree, so they are part of the key.
+    Crypto::Hash::SHA256 hash;
+    auto filename_length = filename.length();
+    hash.update(reinterpret_cast<u8 const*>(&filename_length), sizeof(filename_length));
+    hash.update(filename);
+    hash.update(reinterpret_cast<u8 const*>(&line_number_offset), sizeof(line_number_offset));
+    hash.update(source_text);
+    return hash.digest();
+}
+
+RefPtr<Program> ScriptCache::find(Key const& key)
+{
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].key != key)
+            continue;
+        auto entry = m_entries.take(i);
+        auto program = entry.program;
+        m_entries.append(move(entry));
+        return program;
+    }
+    return nullptr;
+}
+
+void ScriptCache::add(Key const& key, NonnullRefPtr<Program> program, size_t source_length)
+{
+    if (source_length > max_total_cached_source_length)
+        return;
+
+    while (!m_entries.is_empty()
+        && (m_entries.size() >= max_number_of_cached_scripts || m_total_source_length + source_length > max_total_cached_source_length)) {
+        m_total_source_length -= m_entries.first().source_length;
+        m_entries.take_first();
+    }
+
+    m_entries.append({ key, move(program), source_length });
+    m_total_source_length += source_length;
+}
+
+void ScriptCache::clear()
+{
+    m_entries.clear();
+    m_total_source_length = 0;
+}
+
+}
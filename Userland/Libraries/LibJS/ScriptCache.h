@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibJS/Forward.h>
+
+namespace JS {
+
+// Remembers the parse trees of recently parsed scripts, keyed by a hash of their source text, so that loading the same
+// script again (e.g. when a page is reloaded) doesn't have to parse it again. Functions keep their bytecode on the parse
+// tree once they have been called, so this also skips generating bytecode for everything that already ran.
+// FIXME: The cache only lives as long as the VM. Keeping it on disk needs bytecode that doesn't point back into the AST
+//        (e.g. for NewFunction and NewClass), so that it can be serialized.
+class ScriptCache {
+    AK_MAKE_NONCOPYABLE(ScriptCache);
+    AK_MAKE_NONMOVABLE(ScriptCache);
+
+public:
+    using Key = Crypto::Hash::SHA256::DigestType;
+
+    ScriptCache();
+    ~ScriptCache();
+
+    static Key key_for(StringView source_text, StringView filename, size_t line_number_offset);
+
+    RefPtr<Program> find(Key const&);
+    void add(Key const&, NonnullRefPtr<Program>, size_t source_length);
+    void clear();
+
+    size_t size() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        Key key;
+        NonnullRefPtr<Program> program;
+        size_t source_length { 0 };
+    };
+
+    // Ordered from least to most recently used.
+    Vector<Entry> m_entries;
+    size_t m_total_source_length { 0 };
+};
+
+}
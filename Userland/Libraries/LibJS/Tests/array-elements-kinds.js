@@ -0,0 +1,122 @@
+test("arrays filled by appending elements", () => {
+    const integers = [];
+    for (let i = 0; i < 1000; ++i) integers[i] = i;
+    expect(integers).toHaveLength(1000);
+    expect(integers[999]).toBe(999);
+
+    const mixed = [];
+    for (let i = 0; i < 1000; ++i) mixed[i] = i % 3 === 0 ? i : i % 3 === 1 ? i + 0.5 : `${i}`;
+    expect(mixed).toHaveLength(1000);
+    expect(mixed[3]).toBe(3);
+    expect(mixed[4]).toBe(4.5);
+    expect(mixed[5]).toBe("5");
+});
+
+test("appending respects the prototype chain", () => {
+    let setterCalls = 0;
+    Object.defineProperty(Array.prototype, 2, {
+        set(value) {
+            ++setterCalls;
+        },
+        configurable: true,
+    });
+    try {
+        const array = [];
+        for (let i = 0; i < 4; ++i) array[i] = i;
+        expect(setterCalls).toBe(1);
+        expect(array).toHaveLength(4);
+        expect(Object.hasOwn(array, 2)).toBeFalse();
+    } finally {
+        delete Array.prototype[2];
+    }
+
+    const withCustomPrototype = [];
+    Object.setPrototypeOf(withCustomPrototype, {
+        set 0(value) {
+            ++setterCalls;
+        },
+    });
+    withCustomPrototype[0] = 1;
+    expect(setterCalls).toBe(2);
+    expect(withCustomPrototype).toHaveLength(0);
+});
+
+test("appending respects non-extensible arrays and non-writable length", () => {
+    "use strict";
+
+    const sealed = Object.preventExtensions([1, 2]);
+    expect(() => {
+        sealed[2] = 3;
+    }).toThrow(TypeError);
+    expect(sealed).toHaveLength(2);
+
+    const fixedLength = [1, 2];
+    Object.defineProperty(fixedLength, "length", { writable: false });
+    expect(() => {
+        fixedLength[2] = 3;
+    }).toThrow(TypeError);
+    expect(fixedLength).toHaveLength(2);
+});
+
+test("holes are looked up on the prototype chain", () => {
+    const array = [1, 2, 3];
+    delete array[1];
+    Array.prototype[1] = "from prototype";
+    try {
+        expect(array[1]).toBe("from prototype");
+        expect(array.indexOf("from prototype")).toBe(1);
+        expect(array.lastIndexOf("from prototype")).toBe(1);
+        expect(array.includes("from prototype")).toBeTrue();
+    } finally {
+        delete Array.prototype[1];
+    }
+
+    const grown = [1, 2];
+    grown.length = 4;
+    expect(grown.includes(undefined)).toBeTrue();
+    expect(grown.indexOf(undefined)).toBe(-1);
+    grown[3] = 4;
+    expect(grown.indexOf(4)).toBe(3);
+});
+
+test("searching numeric arrays", () => {
+    const integers = [1, 2, 3, 2, 1];
+    expect(integers.indexOf(2)).toBe(1);
+    expect(integers.lastIndexOf(2)).toBe(3);
+    expect(integers.indexOf(2.0)).toBe(1);
+    expect(integers.includes("2")).toBeFalse();
+    expect(integers.indexOf("2")).toBe(-1);
+    expect(integers.lastIndexOf("2")).toBe(-1);
+    expect(integers.indexOf(1, -1)).toBe(4);
+    expect(integers.lastIndexOf(1, -2)).toBe(0);
+
+    const doubles = [0.5, -0, NaN, 1.5];
+    expect(doubles.indexOf(0)).toBe(1);
+    expect(doubles.includes(0)).toBeTrue();
+    expect(doubles.indexOf(NaN)).toBe(-1);
+    expect(doubles.includes(NaN)).toBeTrue();
+
+    doubles.push("string");
+    expect(doubles.indexOf("string")).toBe(4);
+    expect(doubles.includes(1.5)).toBeTrue();
+
+    integers.length = 0;
+    integers.push("a");
+    expect(integers.indexOf("a")).toBe(0);
+});
+
+test("arrays that shrink while searching", () => {
+    const array = [1, 2, 3, 4];
+    const fromIndex = {
+        valueOf() {
+            array.length = 1;
+            return 0;
+        },
+    };
+    Array.prototype[2] = 3;
+    try {
+        expect(array.indexOf(3, fromIndex)).toBe(2);
+    } finally {
+        delete Array.prototype[2];
+    }
+});
@@ -0,0 +1,70 @@
+const values = [undefined, null, 0, -0, 1, NaN, "", "0", false, true, {}, [], Symbol(), 0n, 1n];
+
+test("jumping on a negated condition", () => {
+    for (const value of values) {
+        let taken = false;
+        if (!value) taken = true;
+        expect(taken).toBe(!value);
+
+        let iterations = 0;
+        while (!value && iterations < 3) ++iterations;
+        expect(iterations).toBe(value ? 0 : 3);
+
+        expect(!value ? "yes" : "no").toBe(value ? "no" : "yes");
+    }
+});
+
+test("jumping on strict (in)equality with undefined", () => {
+    for (const value of values) {
+        const isUndefined = typeof value === "undefined";
+
+        let taken = false;
+        if (value === undefined) taken = true;
+        expect(taken).toBe(isUndefined);
+
+        taken = false;
+        if (undefined === value) taken = true;
+        expect(taken).toBe(isUndefined);
+
+        taken = false;
+        if (value !== undefined) taken = true;
+        expect(taken).toBe(!isUndefined);
+
+        taken = false;
+        if (undefined !== value) taken = true;
+        expect(taken).toBe(!isUndefined);
+
+        expect(value === undefined ? 1 : 2).toBe(isUndefined ? 1 : 2);
+        expect(value !== undefined ? 1 : 2).toBe(isUndefined ? 2 : 1);
+    }
+});
+
+test("values of conditional and logical expressions used as arguments", () => {
+    const collect = (...args) => args;
+    for (const value of values) {
+        const result = collect(value ? 1 : 2, value || "or", value && "and", value ?? "nullish", `${typeof value}`);
+        expect(result[0]).toBe(value ? 1 : 2);
+        expect(result[1]).toBe(value ? value : "or");
+        expect(result[2]).toBe(value ? "and" : value);
+        expect(result[3]).toBe(value === undefined || value === null ? "nullish" : value);
+        expect(result[4]).toBe(typeof value);
+    }
+});
+
+test("loops that only jump between empty blocks", () => {
+    let count = 0;
+    outer: for (let i = 0; i < 10; ++i) {
+        for (;;) {
+            if (i % 2) continue outer;
+            break;
+        }
+        ++count;
+    }
+    expect(count).toBe(5);
+
+    let i = 0;
+    do {
+        if (i++ < 5) continue;
+    } while (i < 10);
+    expect(i).toBe(10);
+});
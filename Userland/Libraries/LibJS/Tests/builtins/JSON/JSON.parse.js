@@ -74,3 +74,94 @@ test("does not truncate large integers", () => {
     expect(JSON.parse("18446744073709551616")).toEqual(18446744073709551616);
     expect(JSON.parse("18446744073709551617")).toEqual(18446744073709551617);
 });
+
+test("arrays of objects with the same keys", () => {
+    const text =
+        '[{"id":1,"name":"a","tags":["x"]},{"id":2,"name":"b","tags":[]},{"id":3,"name":"c","tags":["y","z"]}]';
+    const result = JSON.parse(text);
+    expect(result).toEqual([
+        { id: 1, name: "a", tags: ["x"] },
+        { id: 2, name: "b", tags: [] },
+        { id: 3, name: "c", tags: ["y", "z"] },
+    ]);
+    expect(Object.keys(result[2])).toEqual(["id", "name", "tags"]);
+
+    result[1].extra = true;
+    expect(result[0].extra).toBeUndefined();
+    expect(Object.keys(result[1])).toEqual(["id", "name", "tags", "extra"]);
+});
+
+test("arrays of objects with differing keys", () => {
+    const result = JSON.parse(
+        '[{"a":1,"b":2},{"b":3,"a":4},{"a":5},{"a":6,"b":7,"c":8},{"a":9,"a":10},{"a":11,"0":12},{"a":13,"b":14},{}]'
+    );
+    expect(result).toEqual([
+        { a: 1, b: 2 },
+        { b: 3, a: 4 },
+        { a: 5 },
+        { a: 6, b: 7, c: 8 },
+        { a: 10 },
+        { a: 11, 0: 12 },
+        { a: 13, b: 14 },
+        {},
+    ]);
+    expect(Object.keys(result[1])).toEqual(["b", "a"]);
+    expect(Object.keys(result[5])).toEqual(["0", "a"]);
+});
+
+test("nested objects with the same keys", () => {
+    const result = JSON.parse(
+        '[{"user":{"first":"a","last":"b"},"n":1},{"user":{"first":"c","last":"d"},"n":2},{"user":{"last":"e"},"n":3}]'
+    );
+    expect(result[1].user).toEqual({ first: "c", last: "d" });
+    expect(result[2].user).toEqual({ last: "e" });
+    expect(result.map(entry => entry.n)).toEqual([1, 2, 3]);
+});
+
+test("__proto__ is an own data property", () => {
+    const result = JSON.parse('[{"__proto__":1},{"__proto__":{"a":2}}]');
+    expect(Object.getPrototypeOf(result[1])).toBe(Object.prototype);
+    expect(Object.getOwnPropertyNames(result[1])).toEqual(["__proto__"]);
+    expect(result[1].__proto__).toEqual({ a: 2 });
+});
+
+test("strings", () => {
+    const longPrefix = "0123456789abcdefghijklmnopqrstuvwxyz";
+    for (let i = 0; i < longPrefix.length; ++i) {
+        const prefix = longPrefix.substring(0, i);
+        expect(JSON.parse(`"${prefix}\\n${prefix}"`)).toBe(`${prefix}\n${prefix}`);
+        expect(JSON.parse(`"${prefix}\\"\\\\\\/\\b\\f\\r\\t"`)).toBe(`${prefix}"\\/\b\f\r\t`);
+        expect(JSON.parse(`{"${prefix}\\u0041":"${prefix}"}`)).toEqual({ [`${prefix}A`]: prefix });
+        expect(() => JSON.parse(`"${prefix}\n${prefix}"`)).toThrow(SyntaxError);
+        expect(() => JSON.parse(`"${prefix}`)).toThrow(SyntaxError);
+    }
+
+    expect(JSON.parse('"\\uD834\\uDD1E"')).toBe("𝄞");
+    expect(JSON.parse('"\\u00e9\\u4e2d"')).toBe("é中");
+    expect(JSON.parse('"ünïcödé"')).toBe("ünïcödé");
+    expect(JSON.parse('{"\\u0061":1,"b":"\\u0062"}')).toEqual({ a: 1, b: "b" });
+
+    ['"\\x"', '"\\u12"', '"\\u12G4"', '"\\'].forEach(text => {
+        expect(() => JSON.parse(text)).toThrow(SyntaxError);
+    });
+});
+
+test("numbers", () => {
+    expect(JSON.parse("[0,-1,1.5,-2.5e3,1E2,1e-2,123456789012345,1234567890123456789]")).toEqual([
+        0, -1, 1.5, -2500, 100, 0.01, 123456789012345, 1234567890123456789,
+    ]);
+
+    ["01", "1.", ".5", "1e", "1e+", "-", "+1", "--1", "0x10", "1.e5"].forEach(text => {
+        expect(() => JSON.parse(text)).toThrow(SyntaxError);
+    });
+});
+
+test("literals and structure errors", () => {
+    expect(JSON.parse(" [ true , false , null ] ")).toEqual([true, false, null]);
+
+    ["tru", "nul", "[", "[1", "{", '{"a"', '{"a":', '{"a":1', "[1]]", "{} {}", "[,1]", '{,"a":1}'].forEach(
+        text => {
+            expect(() => JSON.parse(text)).toThrow(SyntaxError);
+        }
+    );
+});
@@ -0,0 +1,86 @@
+// NOTE: Objects that are collected by mistake would often still look fine when accessed afterwards,
+//       so these tests also put them in a WeakSet and check that none of them disappear from it.
+
+test("objects stored into already marked objects survive", () => {
+    const holder = { object: {}, array: [] };
+    const weakSet = new WeakSet();
+    const filler = [];
+    for (let i = 0; i < 10_000; ++i) filler.push({ value: i });
+
+    startIncrementalMarking();
+    while (!performIncrementalMarkingSlice()) {}
+
+    (() => {
+        holder.object.young = { value: 1 };
+        holder.array.push({ value: 2 });
+        holder.property = { value: 3 };
+        weakSet.add(holder.object.young);
+        weakSet.add(holder.array[0]);
+        weakSet.add(holder.property);
+    })();
+
+    gc();
+
+    expect(getWeakSetSize(weakSet)).toBe(3);
+    expect(holder.object.young.value).toBe(1);
+    expect(holder.array[0].value).toBe(2);
+    expect(holder.property.value).toBe(3);
+    expect(filler[9_999].value).toBe(9_999);
+});
+
+test("objects moved while marking is in progress survive", () => {
+    const containers = [];
+    for (let i = 0; i < 10_000; ++i) containers.push({ payload: { value: i } });
+    const array = [];
+    const object = {};
+    const weakSet = new WeakSet();
+    for (const container of containers) weakSet.add(container.payload);
+
+    startIncrementalMarking();
+    performIncrementalMarkingSlice();
+
+    // Move every payload into objects that may have been marked already, and drop the original reference.
+    (() => {
+        for (let i = containers.length - 1; i >= 0; --i) {
+            if (i % 2) array.push(containers[i].payload);
+            else object["p" + i] = containers[i].payload;
+            delete containers[i].payload;
+            if (i % 1_000 === 0) performIncrementalMarkingSlice();
+        }
+    })();
+
+    while (!performIncrementalMarkingSlice()) {}
+    gc();
+
+    expect(getWeakSetSize(weakSet)).toBe(10_000);
+    expect(array).toHaveLength(5_000);
+    for (let i = 0; i < 5_000; ++i) expect(array[i].value).toBe(9_999 - 2 * i);
+    for (let i = 0; i < 10_000; i += 2) expect(object["p" + i].value).toBe(i);
+});
+
+test("objects allocated while marking is in progress survive", () => {
+    const holder = {};
+    const weakSet = new WeakSet();
+
+    startIncrementalMarking();
+    performIncrementalMarkingSlice();
+
+    (() => {
+        let list = null;
+        for (let i = 0; i < 1_000; ++i) {
+            list = { value: i, next: list };
+            weakSet.add(list);
+        }
+        holder.list = list;
+    })();
+
+    gc();
+
+    expect(getWeakSetSize(weakSet)).toBe(1_000);
+    let count = 0;
+    for (let node = holder.list; node; node = node.next) {
+        expect(node.value).toBe(999 - count);
+        ++count;
+    }
+    expect(count).toBe(1_000);
+});
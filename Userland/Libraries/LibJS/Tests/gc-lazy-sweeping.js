@@ -0,0 +1,87 @@
+function fillWithGarbageKeys(weakMap, weakSet) {
+    for (let i = 0; i < 1000; ++i) {
+        weakMap.set({ i }, i);
+        weakSet.add({ i });
+    }
+}
+
+test("weak containers forget dead cells before they are swept", () => {
+    const weakMap = new WeakMap();
+    const weakSet = new WeakSet();
+    fillWithGarbageKeys(weakMap, weakSet);
+    expect(getWeakMapSize(weakMap)).toBe(1000);
+    expect(getWeakSetSize(weakSet)).toBe(1000);
+
+    gc();
+
+    // Conservative scanning may keep a few of them alive.
+    expect(getWeakMapSize(weakMap)).toBeLessThan(100);
+    expect(getWeakSetSize(weakSet)).toBeLessThan(100);
+});
+
+test("dead weak containers are not asked to remove dead cells", () => {
+    (() => {
+        for (let i = 0; i < 1000; ++i) {
+            const weakMap = new WeakMap();
+            weakMap.set({ i }, i);
+            new WeakRef({ i });
+            new FinalizationRegistry(() => {}).register({ i }, i);
+        }
+    })();
+    gc();
+
+    // Young generation collections ask every registered weak container to remove dead cells.
+    for (let i = 0; i < 100_000; ++i) ({ value: i });
+    gc();
+});
+
+test("strings are not handed out again after they died", () => {
+    const makeStrings = round => {
+        const strings = [];
+        for (let i = 0; i < 1000; ++i) strings.push(`string ${i}`.slice(round));
+        return strings.length;
+    };
+    expect(makeStrings(0)).toBe(1000);
+    gc();
+
+    // These look up the same strings as above, which may not have been swept yet.
+    const strings = [];
+    for (let i = 0; i < 1000; ++i) strings.push(`string ${i}`.slice(0));
+    for (let i = 0; i < 100_000; ++i) ({ value: i });
+    gc();
+    for (let i = 0; i < 1000; ++i) expect(strings[i]).toBe("string " + i);
+});
+
+test("dead prototypes are not invalidated again", () => {
+    (() => {
+        for (let i = 0; i < 1000; ++i) {
+            const prototype = { i };
+            Object.create(prototype);
+            Object.setPrototypeOf(prototype, { i });
+        }
+    })();
+    gc();
+
+    // Changing a prototype looks at every prototype shape.
+    const base = { base: true };
+    const derived = Object.create(base);
+    expect(derived.base).toBeTrue();
+    Object.setPrototypeOf(base, { changed: true });
+    expect(derived.changed).toBeTrue();
+});
+
+test("allocation reuses swept blocks", () => {
+    const survivors = [];
+    for (let round = 0; round < 5; ++round) {
+        for (let i = 0; i < 100_000; ++i) {
+            const object = { round, i };
+            if (i % 100 === 0) survivors.push(object);
+        }
+        gc();
+    }
+    expect(survivors).toHaveLength(5000);
+    for (let i = 0; i < survivors.length; ++i) {
+        expect(survivors[i].round).toBe(Math.floor(i / 1000));
+        expect(survivors[i].i).toBe((i % 1000) * 100);
+    }
+});
@@ -0,0 +1,112 @@
+test("old objects keep young objects alive", () => {
+    const old = { properties: {}, elements: [], accessors: {} };
+    const oldArray = [];
+    class WithPrivateField {
+        #field;
+        set(value) {
+            this.#field = value;
+        }
+        get() {
+            return this.#field;
+        }
+    }
+    const oldPrivate = new WithPrivateField();
+
+    // Make sure everything above has survived a collection.
+    gc();
+
+    // Allocate enough for several young generation collections to happen in between.
+    for (let i = 0; i < 100_000; ++i) {
+        const key = i % 100;
+        const value = i;
+        old.properties["p" + key] = { value: i };
+        old.elements[key] = { value: i };
+        oldArray[key] = { value: i };
+        oldPrivate.set({ value: i });
+        Object.defineProperty(old.accessors, "a" + key, {
+            get: () => value,
+            configurable: true,
+        });
+    }
+
+    for (let key = 0; key < 100; ++key) {
+        const expected = 99_900 + key;
+        expect(old.properties["p" + key].value).toBe(expected);
+        expect(old.elements[key].value).toBe(expected);
+        expect(oldArray[key].value).toBe(expected);
+        expect(old.accessors["a" + key]).toBe(expected);
+    }
+    expect(oldPrivate.get().value).toBe(99_999);
+});
+
+test("old environments keep young values alive", () => {
+    let captured = null;
+    const setCaptured = value => {
+        captured = value;
+    };
+    const makeBox = () => {
+        let contents = null;
+        return {
+            set(value) {
+                contents = value;
+            },
+            get() {
+                return contents;
+            },
+        };
+    };
+    const box = makeBox();
+
+    gc();
+
+    for (let i = 0; i < 100_000; ++i) {
+        setCaptured({ value: i });
+        box.set({ value: i });
+    }
+
+    expect(captured.value).toBe(99_999);
+    expect(box.get().value).toBe(99_999);
+});
+
+test("young objects reachable only through unaudited old cells survive", () => {
+    const map = new Map();
+    const closureTarget = { captured: null };
+    const capture = value => {
+        closureTarget.captured = value;
+    };
+
+    gc();
+
+    for (let i = 0; i < 100_000; ++i) {
+        map.set(i % 100, { value: i });
+        capture({ value: i });
+    }
+
+    for (let key = 0; key < 100; ++key) expect(map.get(key).value).toBe(99_900 + key);
+    expect(closureTarget.captured.value).toBe(99_999);
+});
+
+test("old shapes and intrinsics keep young values alive", () => {
+    const dictionary = {};
+    for (let i = 0; i < 100; ++i) dictionary["p" + i] = i;
+    delete dictionary.p0;
+    const transitioned = {};
+
+    gc();
+
+    for (let i = 0; i < 100_000; ++i) {
+        Object.setPrototypeOf(dictionary, { value: i });
+        const symbol = Symbol("key" + i);
+        transitioned[symbol] = i;
+        delete transitioned[symbol];
+    }
+    expect(Object.getPrototypeOf(dictionary).value).toBe(99_999);
+
+    // These constructors are created on first use, long after the intrinsics themselves.
+    for (let i = 0; i < 10_000; ++i) ({ value: i });
+    expect(new WeakRef(dictionary).deref()).toBe(dictionary);
+    for (let i = 0; i < 100_000; ++i) ({ value: i });
+    expect(WeakRef.prototype.constructor).toBe(WeakRef);
+    expect(new FinalizationRegistry(() => {})).toBeInstanceOf(FinalizationRegistry);
+    expect(FinalizationRegistry.prototype.constructor).toBe(FinalizationRegistry);
+});
@@ -16,3 +16,91 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Polymorphic get and put see the right property for each shape", () => {
+    const objects = [{ x: 1 }, { a: 0, x: 2 }, { a: 0, b: 0, x: 3 }, { a: 0, b: 0, c: 0, x: 4 }];
+
+    function get(o) {
+        return o.x;
+    }
+    function put(o, value) {
+        o.x = value;
+    }
+
+    for (let i = 0; i < 3; ++i) {
+        objects.forEach((o, index) => expect(get(o)).toBe(index + 1));
+    }
+
+    objects.forEach((o, index) => put(o, index + 10));
+    objects.forEach((o, index) => put(o, index + 20));
+    objects.forEach((o, index) => expect(o.x).toBe(index + 20));
+    objects.forEach(o => expect(Object.keys(o).length).toBe(Object.keys(o).indexOf("x") + 1));
+});
+
+test("Megamorphic get and put see the right property for each shape", () => {
+    const objects = [];
+    for (let i = 0; i < 20; ++i) {
+        const o = {};
+        o["padding" + i] = i;
+        o.x = i;
+        objects.push(o);
+    }
+
+    function get(o) {
+        return o.x;
+    }
+    function put(o, value) {
+        o.x = value;
+    }
+
+    for (let i = 0; i < 3; ++i) {
+        objects.forEach((o, index) => expect(get(o)).toBe(index + i));
+        objects.forEach((o, index) => put(o, index + i + 1));
+    }
+    objects.forEach((o, index) => expect(o.x).toBe(index + 3));
+});
+
+test("Megamorphic put does not write to a non-writable property read by a get", () => {
+    const objects = [];
+    for (let i = 0; i < 10; ++i) {
+        const o = {};
+        o["padding" + i] = i;
+        Object.defineProperty(o, "x", { value: i, writable: false });
+        objects.push(o);
+    }
+
+    function get(o) {
+        return o.x;
+    }
+    function put(o, value) {
+        o.x = value;
+    }
+
+    objects.forEach(o => get(o));
+    objects.forEach(o => put(o, 42));
+    objects.forEach((o, index) => expect(get(o)).toBe(index));
+});
+
+test("Polymorphic prototype chain cache is invalidated by prototype mutation", () => {
+    class A {}
+    A.prototype.x = "A";
+    class B {}
+    B.prototype.x = "B";
+
+    function get(o) {
+        return o.x;
+    }
+
+    const a = new A();
+    const b = new B();
+    expect(get(a)).toBe("A");
+    expect(get(b)).toBe("B");
+
+    B.prototype.x = "changed";
+    expect(get(a)).toBe("A");
+    expect(get(b)).toBe("changed");
+
+    Object.setPrototypeOf(B.prototype, { y: 1 });
+    delete B.prototype.x;
+    expect(get(b)).toBeUndefined();
+});
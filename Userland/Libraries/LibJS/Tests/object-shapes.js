@@ -0,0 +1,92 @@
+test("shapes along a chain of added properties share one property table", () => {
+    gc();
+    const before = getShapeStatistics();
+
+    const object = {};
+    for (let i = 0; i < 32; ++i) object[`shapeSharingTest${i}`] = i;
+
+    gc();
+    const after = getShapeStatistics();
+
+    expect(after.shapeCount - before.shapeCount).toBeGreaterThanOrEqual(32);
+    expect(after.propertyTableCount - before.propertyTableCount).toBeLessThan(4);
+    expect(after.longestTransitionChain).toBeGreaterThanOrEqual(32);
+    for (let i = 0; i < 32; ++i) expect(object[`shapeSharingTest${i}`]).toBe(i);
+    expect(Object.keys(object)).toHaveLength(32);
+});
+
+test("shapes sharing a property table don't see each other's properties", () => {
+    const short = { a: 1, b: 2 };
+    const long = { a: 1, b: 2, c: 3 };
+    const sibling = { a: 1, b: 2, d: 4 };
+    const reordered = { b: 2, a: 1 };
+
+    expect(short.c).toBeUndefined();
+    expect("c" in short).toBeFalse();
+    expect(Object.keys(short)).toEqual(["a", "b"]);
+
+    expect(long.c).toBe(3);
+    expect(long.d).toBeUndefined();
+    expect(Object.keys(long)).toEqual(["a", "b", "c"]);
+
+    expect(sibling.c).toBeUndefined();
+    expect(sibling.d).toBe(4);
+    expect(Object.keys(sibling)).toEqual(["a", "b", "d"]);
+
+    expect(Object.keys(reordered)).toEqual(["b", "a"]);
+    expect(reordered.a).toBe(1);
+
+    const symbol = Symbol();
+    const withSymbol = { a: 1, b: 2, [symbol]: 5 };
+    expect(withSymbol[symbol]).toBe(5);
+    expect(long[symbol]).toBeUndefined();
+    expect(Object.getOwnPropertySymbols(short)).toEqual([]);
+});
+
+test("configuring and deleting properties of objects with shared shapes", () => {
+    const first = { x: 1, y: 2, z: 3 };
+    const second = { x: 1, y: 2, z: 3 };
+
+    Object.defineProperty(first, "y", { enumerable: false });
+    expect(Object.keys(first)).toEqual(["x", "z"]);
+    expect(Object.keys(second)).toEqual(["x", "y", "z"]);
+
+    delete second.x;
+    expect(Object.keys(second)).toEqual(["y", "z"]);
+    expect(second.y).toBe(2);
+    expect(second.z).toBe(3);
+    expect(first.x).toBe(1);
+
+    second.w = 4;
+    expect(Object.keys(second)).toEqual(["y", "z", "w"]);
+    expect(second.w).toBe(4);
+});
+
+test("objects with many properties get a dictionary shape", () => {
+    gc();
+    const before = getShapeStatistics();
+
+    const object = {};
+    for (let i = 0; i < 100; ++i) object[`dictionaryTest${i}`] = i;
+
+    const after = getShapeStatistics();
+    expect(after.dictionaryShapeCount).toBeGreaterThan(before.dictionaryShapeCount);
+
+    const read = o => o.dictionaryTest99;
+    for (let i = 0; i < 3; ++i) expect(read(object)).toBe(99);
+
+    // Deleting from a dictionary shape moves the following properties, so lookups must not be served from a cache.
+    delete object.dictionaryTest0;
+    for (let i = 0; i < 3; ++i) expect(read(object)).toBe(99);
+    expect(object.dictionaryTest1).toBe(1);
+    expect(Object.keys(object)).toHaveLength(99);
+});
+
+test("statistics are reported", () => {
+    const statistics = getShapeStatistics();
+    expect(statistics.shapeCount).toBeGreaterThan(0);
+    expect(statistics.prototypeShapeCount).toBeGreaterThan(0);
+    expect(statistics.propertyTableBytes).toBeGreaterThan(0);
+    expect(statistics.transitionTableBytes).toBeGreaterThan(0);
+    expect(statistics.sharedPropertyTableCount).toBeLessThanOrEqual(statistics.propertyTableCount);
+});
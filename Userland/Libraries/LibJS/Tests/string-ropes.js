@@ -0,0 +1,69 @@
+const buildRope = (pieces, count) => {
+    let string = "";
+    for (let i = 0; i < count; ++i) string += pieces[i % pieces.length];
+    return string;
+};
+
+test("length of strings built by concatenation", () => {
+    let string = "";
+    for (let i = 0; i < 1000; ++i) {
+        string += "ab";
+        expect(string).toHaveLength((i + 1) * 2);
+    }
+    expect(new String(string)).toHaveLength(2000);
+
+    expect(("😀" + "a" + "😀").length).toBe(5);
+    expect(("\ud83d" + "\ude00").length).toBe(2);
+    expect(("\xff" + "ab").length).toBe(3);
+});
+
+test("reading characters from ropes", () => {
+    const string = buildRope(["abc", "😀", "def"], 300);
+    const flat = ["abc", "😀", "def"].join("").repeat(100);
+
+    for (let i = 0; i < flat.length; i += 7) {
+        expect(string[i]).toBe(flat[i]);
+        expect(string.charAt(i)).toBe(flat.charAt(i));
+        expect(string.charCodeAt(i)).toBe(flat.charCodeAt(i));
+        expect(string.codePointAt(i)).toBe(flat.codePointAt(i));
+        expect(string.at(-i - 1)).toBe(flat.at(-i - 1));
+    }
+
+    expect(string.charAt(string.length)).toBe("");
+    expect(string.charCodeAt(string.length)).toBeNaN();
+    expect(string.codePointAt(string.length)).toBeUndefined();
+    expect(string[string.length]).toBeUndefined();
+});
+
+test("code points split across rope pieces", () => {
+    const string = "a\ud83d" + "\ude00b";
+    expect(string.codePointAt(1)).toBe(0x1f600);
+    expect(string.codePointAt(2)).toBe(0xde00);
+    expect(string.charCodeAt(1)).toBe(0xd83d);
+    expect(string.slice(1, 3)).toBe("😀");
+    expect(string.endsWith("😀b")).toBeTrue();
+});
+
+test("substrings of ropes", () => {
+    const string = buildRope(["hello ", "world ", "😀 "], 500);
+    const flat = ["hello ", "world ", "😀 "].join("").repeat(167).slice(0, string.length);
+
+    for (const [start, end] of [
+        [0, 5],
+        [3, 20],
+        [-10, -2],
+        [100, 120],
+        [string.length - 3, string.length],
+    ]) {
+        expect(string.slice(start, end)).toBe(flat.slice(start, end));
+        expect(string.substring(start, end)).toBe(flat.substring(start, end));
+        expect(string.substr(start, 7)).toBe(flat.substr(start, 7));
+    }
+
+    expect(string.startsWith("hello world")).toBeTrue();
+    expect(string.startsWith("world", 6)).toBeTrue();
+    expect(string.endsWith("😀 ")).toBeFalse();
+    expect(string.endsWith(flat.slice(-12))).toBeTrue();
+    expect(string.endsWith("hello", 5)).toBeTrue();
+    expect(string).toBe(flat);
+});
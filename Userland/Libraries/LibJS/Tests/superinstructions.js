@@ -0,0 +1,170 @@
+test("calling a method", () => {
+    const o = {
+        value: 1,
+        get() {
+            return this.value;
+        },
+        add(a, b, c) {
+            return this.value + a + b + c;
+        },
+    };
+    let sum = 0;
+    for (let i = 0; i < 10; ++i) sum += o.get();
+    expect(sum).toBe(10);
+    expect(o.add(1, 2, 3)).toBe(7);
+    expect("abc".slice(1)).toBe("bc");
+    expect(Math.max(1, 3, 2)).toBe(3);
+});
+
+test("calling a method that is not a function", () => {
+    const o = { notAFunction: 1 };
+    expect(() => o.notAFunction()).toThrowWithMessage(
+        TypeError,
+        "1 is not a function (evaluated from 'o.notAFunction')"
+    );
+    expect(() => o.missing()).toThrowWithMessage(
+        TypeError,
+        "undefined is not a function (evaluated from 'o.missing')"
+    );
+});
+
+test("calling a method on a nullish base", () => {
+    const o = null;
+    expect(() => o.method()).toThrowWithMessage(
+        TypeError,
+        'Cannot access property "method" on null object "o"'
+    );
+    expect(() => undefined.method()).toThrowWithMessage(TypeError, "Cannot access property");
+});
+
+test("calling a method found through a getter", () => {
+    const calls = [];
+    const o = {
+        get method() {
+            calls.push("get");
+            return (...args) => {
+                calls.push("call");
+                return args.length;
+            };
+        },
+    };
+    expect(o.method(1, 2)).toBe(2);
+    expect(calls).toEqual(["get", "call"]);
+});
+
+test("exceptions thrown by the method and its getter", () => {
+    const o = {
+        get throwingGetter() {
+            throw new Error("getter");
+        },
+        throwingMethod() {
+            throw new Error("method");
+        },
+    };
+    expect(() => o.throwingGetter()).toThrowWithMessage(Error, "getter");
+    expect(() => o.throwingMethod()).toThrowWithMessage(Error, "method");
+
+    let caught;
+    try {
+        o.throwingMethod();
+    } catch (e) {
+        caught = e.message;
+    }
+    expect(caught).toBe("method");
+});
+
+test("incrementing a property", () => {
+    const o = { count: 0 };
+    for (let i = 0; i < 10; ++i) o.count++;
+    expect(o.count).toBe(10);
+    for (let i = 0; i < 10; ++i) ++o.count;
+    expect(o.count).toBe(20);
+
+    expect(o.count++).toBe(20);
+    expect(++o.count).toBe(22);
+    expect(o.count).toBe(22);
+});
+
+test("incrementing a property that is not a number", () => {
+    const o = { string: "1", missing: undefined, big: 1n, object: { valueOf: () => 41 } };
+    o.string++;
+    expect(o.string).toBe(2);
+    o.missing++;
+    expect(o.missing).toBeNaN();
+    o.big++;
+    expect(o.big).toBe(2n);
+    ++o.object;
+    expect(o.object).toBe(42);
+    o.symbol = Symbol();
+    expect(() => o.symbol++).toThrow(TypeError);
+});
+
+test("incrementing a property with a getter and setter", () => {
+    const calls = [];
+    const o = {
+        backing: 1,
+        get value() {
+            calls.push("get");
+            return this.backing;
+        },
+        set value(v) {
+            calls.push("set");
+            this.backing = v;
+        },
+    };
+    ++o.value;
+    expect(o.backing).toBe(2);
+    expect(calls).toEqual(["get", "set"]);
+});
+
+test("incrementing a property that can't be written", () => {
+    "use strict";
+    const o = Object.freeze({ count: 1 });
+    expect(() => o.count++).toThrow(TypeError);
+    expect(o.count).toBe(1);
+
+    const p = {
+        get count() {
+            return 1;
+        },
+    };
+    expect(() => ++p.count).toThrow(TypeError);
+});
+
+test("incrementing a property of a nullish base", () => {
+    const o = undefined;
+    expect(() => o.count++).toThrowWithMessage(
+        TypeError,
+        'Cannot access property "count" on undefined object "o"'
+    );
+});
+
+test("values that are copied from one variable to another", () => {
+    function chain(x) {
+        let a = x + 1;
+        let b = a;
+        let c = b;
+        return c;
+    }
+    expect(chain(1)).toBe(2);
+
+    function unused(x) {
+        let i = 0;
+        i++;
+        x++;
+        return i + x;
+    }
+    expect(unused(1)).toBe(3);
+
+    function copiedInTry(x) {
+        let result = 0;
+        try {
+            result = x.y.z;
+        } catch {
+            return result;
+        }
+        return result;
+    }
+    expect(copiedInTry({ y: { z: 3 } })).toBe(3);
+    expect(copiedInTry({})).toBe(0);
+});
@@ -37,6 +37,13 @@ public:
         print_bytecode(regex.parser_result.bytecode);
     }
 
+    template<typename T>
+    void print_engine(Regex<T> const& regex) const
+    {
+        outln(m_file, "Matching engine: {}", matching_engine_name(regex.parser_result.optimization_data.engine));
+        fflush(m_file);
+    }
+
     void print_bytecode(ByteCode const& bytecode) const
     {
         MatchState state;
@@ -10,6 +10,8 @@
 #include <AK/StringBuilder.h>
 #include <LibRegex/RegexMatcher.h>
 #include <LibRegex/RegexParser.h>
+#include <LibRegex/RegexPikeVM.h>
+#include <LibRegex/RegexPrefilter.h>
 
 #if REGEX_DEBUG
 #    include <LibRegex/RegexDebug.h>
@@ -77,6 +79,18 @@ Regex<Parser>& Regex<Parser>::operator=(Regex&& regex)
     return *this;
 }
 
+template<class Parser>
+Matcher<Parser>::Matcher(Regex<Parser> const* pattern, Optional<typename ParserTraits<Parser>::OptionsType> regex_options)
+    : m_pattern(pattern)
+    , m_regex_options(regex_options.value_or({}))
+{
+    if (m_pattern->parser_result.optimization_data.engine == MatchingEngine::LazyDFA)
+        m_lazy_dfa = make<LazyDFA>(m_pattern->parser_result.bytecode);
+}
+
+template<class Parser>
+Matcher<Parser>::~Matcher() = default;
+
 template<class Parser>
 typename ParserTraits<Parser>::OptionsType Regex<Parser>::options() const
 {
@@ -176,6 +190,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     };
 
 #if REGEX_DEBUG
+    s_regex_dbg.print_engine(*m_pattern);
     s_regex_dbg.print_header();
 #endif
 
@@ -185,6 +200,21 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
 
+    // The NFA simulation can look for the next match in a single pass over the input instead of being restarted at
+    // every position, as long as no match has to be rejected after the fact.
+    auto search_with_pike_vm = continue_search
+        && m_pattern->parser_result.optimization_data.engine != MatchingEngine::Backtracking
+        && !input.regex_options.has_flag_set(AllFlags::MatchNotEndOfLine)
+        && !input.regex_options.has_flag_set(AllFlags::MatchNotBeginOfLine);
+
+    // The literals that the optimizer found let us skip the positions at which no match can start, and the views that
+    // can't contain a match at all.
+    auto const& optimization_data = m_pattern->parser_result.optimization_data;
+    auto use_required_literals = !input.regex_options.has_flag_set(AllFlags::Insensitive);
+    auto has_required_start = optimization_data.required_prefix.has_value() || !optimization_data.starting_characters.is_empty();
+
+    PikeVMScratch pike_vm_scratch;
+
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -200,6 +230,10 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         state.string_position_in_code_units = view_index;
         bool succeeded = false;
 
+        auto scan_for_literals = use_required_literals && can_scan_for_literals(view);
+        if (scan_for_literals && optimization_data.required_infix.has_value() && !find_literal(view, view_index, *optimization_data.required_infix).has_value())
+            view_index = view_length + 1;
+
         if (view_index == view_length && m_pattern->parser_result.match_length_minimum == 0) {
             // Run the code until it tries to consume something.
             // This allows non-consuming code to run on empty strings, for instance
@@ -214,7 +248,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.instruction_position = 0;
             state.repetition_marks.clear();
 
-            auto success = execute(input, state, temp_operations);
+            auto success = execute(input, state, temp_operations, pike_vm_scratch);
             // This success is acceptable only if it doesn't read anything from the input (input length is 0).
             if (success && (state.string_position <= view_index)) {
                 operations = temp_operations;
@@ -245,6 +279,15 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
+            if (continue_search && scan_for_literals && has_required_start) {
+                auto match_start = optimization_data.required_prefix.has_value()
+                    ? find_literal(view, view_index, *optimization_data.required_prefix)
+                    : find_any_of(view, view_index, optimization_data.starting_characters);
+                if (!match_start.has_value())
+                    break;
+                view_index = *match_start;
+            }
+
             input.column = match_count;
             input.match_index = match_count;
 
@@ -253,7 +296,19 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.instruction_position = 0;
             state.repetition_marks.clear();
 
-            auto success = execute(input, state, operations);
+            bool success;
+            if (search_with_pike_vm) {
+                auto match_start = execute_pike_vm(input, state, operations, true, pike_vm_scratch);
+                if (!match_start.has_value())
+                    break;
+                if (*match_start == view_length && input.regex_options.has_flag_set(AllFlags::Multiline))
+                    break;
+                view_index = *match_start;
+                success = true;
+            } else {
+                success = execute(input, state, operations, pike_vm_scratch);
+            }
+
             if (success) {
                 succeeded = true;
 
@@ -417,7 +472,7 @@ private:
 };
 
 template<class Parser>
-bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t& operations) const
+bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t& operations, PikeVMScratch& pike_vm_scratch) const
 {
     if (m_pattern->parser_result.optimization_data.pure_substring_search.has_value() && input.view.is_string_view()) {
         // Yay, we can do a simple substring search!
@@ -439,6 +494,9 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
         return true;
     }
 
+    if (m_pattern->parser_result.optimization_data.engine != MatchingEngine::Backtracking)
+        return execute_pike_vm(input, state, operations, false, pike_vm_scratch).has_value();
+
     BumpAllocatedLinkedList<MatchState> states_to_try_next;
 #if REGEX_DEBUG
     size_t recursion_level = 0;
@@ -539,6 +597,28 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
     VERIFY_NOT_REACHED();
 }
 
+template<class Parser>
+Optional<size_t> Matcher<Parser>::execute_pike_vm(MatchInput const& input, MatchState& state, size_t& operations, bool search, PikeVMScratch& scratch) const
+{
+    auto const& bytecode = m_pattern->parser_result.bytecode;
+    PikeVM vm(bytecode, input, operations, scratch);
+
+    // The DFA doesn't keep track of code unit positions, so it can't be used when they differ from the string positions.
+    if (m_pattern->parser_result.optimization_data.engine != MatchingEngine::LazyDFA || input.view.unicode())
+        return vm.run(state, search);
+
+    // The transitions depend on the options that the Compares were run with, so they only hold for the options the
+    // pattern was compiled with.
+    if (!m_lazy_dfa || input.regex_options.value() != AllOptions { m_regex_options }.value())
+        return vm.run(state, search);
+
+    if (m_lazy_dfa_in_use.exchange(true, AK::MemoryOrder::memory_order_acquire))
+        return vm.run(state, search);
+    auto result = vm.run(*m_lazy_dfa, state, search);
+    m_lazy_dfa_in_use.store(false, AK::MemoryOrder::memory_order_release);
+    return result;
+}
+
 template class Matcher<PosixBasicParser>;
 template class Regex<PosixBasicParser>;
 
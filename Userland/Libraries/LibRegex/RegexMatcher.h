@@ -11,6 +11,7 @@
 #include "RegexOptions.h"
 #include "RegexParser.h"
 
+#include <AK/Atomic.h>
 #include <AK/Forward.h>
 #include <AK/GenericLexer.h>
 #include <AK/HashMap.h>
@@ -48,16 +49,15 @@ struct RegexResult final {
 template<class Parser>
 class Regex;
 
+class LazyDFA;
+struct PikeVMScratch;
+
 template<class Parser>
 class Matcher final {
 
 public:
-    Matcher(Regex<Parser> const* pattern, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {})
-        : m_pattern(pattern)
-        , m_regex_options(regex_options.value_or({}))
-    {
-    }
-    ~Matcher() = default;
+    Matcher(Regex<Parser> const* pattern, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {});
+    ~Matcher();
 
     RegexResult match(RegexStringView, Optional<typename ParserTraits<Parser>::OptionsType> = {}) const;
     RegexResult match(Vector<RegexStringView> const&, Optional<typename ParserTraits<Parser>::OptionsType> = {}) const;
@@ -73,10 +73,17 @@ public:
     }
 
 private:
-    bool execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    bool execute(MatchInput const& input, MatchState& state, size_t& operations, PikeVMScratch&) const;
+    Optional<size_t> execute_pike_vm(MatchInput const& input, MatchState& state, size_t& operations, bool search, PikeVMScratch&) const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+
+    // Only exists for patterns that use MatchingEngine::LazyDFA, and only applies to matches with m_regex_options.
+    // The DFA grows its states while matching, so only one match at a time may use it; concurrent matches on the
+    // same Regex run the plain Pike VM instead.
+    OwnPtr<LazyDFA> m_lazy_dfa;
+    mutable Atomic<bool> m_lazy_dfa_in_use { false };
 };
 
 template<class Parser>
@@ -232,6 +239,8 @@ private:
     void run_optimization_passes();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
+    void select_matching_engine();
+    void extract_required_literals();
 };
 
 // free standing functions for match, search and has_match
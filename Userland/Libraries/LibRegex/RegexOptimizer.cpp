@@ -29,14 +29,17 @@ void Regex<Parser>::run_optimization_passes()
     parser_result.bytecode.flatten();
 
     auto blocks = split_basic_blocks(parser_result.bytecode);
-    if (attempt_rewrite_entire_match_as_substring_search(blocks))
-        return;
+    if (!attempt_rewrite_entire_match_as_substring_search(blocks)) {
+        // Rewrite fork loops as atomic groups
+        // e.g. a*b -> (ATOMIC a*)b
+        attempt_rewrite_loops_as_atomic_groups(blocks);
 
-    // Rewrite fork loops as atomic groups
-    // e.g. a*b -> (ATOMIC a*)b
-    attempt_rewrite_loops_as_atomic_groups(blocks);
+        parser_result.bytecode.flatten();
 
-    parser_result.bytecode.flatten();
+        select_matching_engine();
+    }
+
+    extract_required_literals();
 }
 
 template<typename Parser>
@@ -572,6 +575,313 @@ bool Regex<Parser>::attempt_rewrite_entire_match_as_substring_search(BasicBlockL
     return true;
 }
 
+template<typename Parser>
+void Regex<Parser>::select_matching_engine()
+{
+    // The backtracking VM is the fastest engine for most patterns, but it can take exponential time when a loop
+    // contains a choice, e.g. (a|ab)*c or (\w+\s?)*$, and quadratic time when it contains another loop even if
+    // that one was made atomic, as it's restarted at every position of the input.
+    // Patterns like that are run as an NFA simulation instead, unless they need something only the backtracking VM
+    // can do (backreferences, lookaround, counted repetitions), as their threads would then depend on more than
+    // their instruction and string positions.
+    auto& bytecode = parser_result.bytecode;
+    auto bytecode_size = bytecode.size();
+
+    bool has_ambiguous_loop = false;
+    bool has_capture_groups = false;
+    bool every_compare_consumes_one_character = true;
+
+    struct BackwardJump {
+        size_t source;
+        size_t target;
+    };
+    Vector<BackwardJump> backward_jumps;
+    Vector<size_t> fork_positions;
+
+    auto is_fork = [](OpCodeId id) {
+        return id == OpCodeId::ForkJump || id == OpCodeId::ForkStay || id == OpCodeId::ForkReplaceJump || id == OpCodeId::ForkReplaceStay;
+    };
+
+    MatchState state;
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto instruction_position = state.instruction_position;
+        ssize_t jump_offset = 0;
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::FailForks:
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::Repeat:
+        case OpCodeId::ResetRepeat:
+            return;
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+            has_capture_groups = true;
+            break;
+        case OpCodeId::Compare: {
+            auto& compare = static_cast<OpCode_Compare const&>(opcode);
+            if (compare.arguments_count() == 0)
+                return;
+
+            size_t offset = instruction_position + 3;
+            for (size_t i = 0; i < compare.arguments_count(); ++i) {
+                switch (static_cast<CharacterCompareType>(bytecode.at(offset++))) {
+                case CharacterCompareType::Reference:
+                    return;
+                case CharacterCompareType::String: {
+                    auto length = bytecode.at(offset++);
+                    if (length == 0)
+                        return;
+                    if (length > 1)
+                        every_compare_consumes_one_character = false;
+                    offset += length;
+                    break;
+                }
+                case CharacterCompareType::LookupTable:
+                    offset += bytecode.at(offset) + 1;
+                    break;
+                case CharacterCompareType::Char:
+                case CharacterCompareType::CharClass:
+                case CharacterCompareType::CharRange:
+                case CharacterCompareType::Property:
+                case CharacterCompareType::GeneralCategory:
+                case CharacterCompareType::Script:
+                case CharacterCompareType::ScriptExtension:
+                    ++offset;
+                    break;
+                default:
+                    break;
+                }
+            }
+            break;
+        }
+        case OpCodeId::Jump:
+            jump_offset = static_cast<OpCode_Jump const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            jump_offset = static_cast<OpCode_ForkJump const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            jump_offset = static_cast<OpCode_ForkStay const&>(opcode).offset();
+            break;
+        case OpCodeId::JumpNonEmpty:
+            jump_offset = static_cast<OpCode_JumpNonEmpty const&>(opcode).offset();
+            break;
+        default:
+            break;
+        }
+
+        auto id = opcode.opcode_id();
+        if (id == OpCodeId::JumpNonEmpty)
+            id = static_cast<OpCode_JumpNonEmpty const&>(opcode).form();
+        if (is_fork(id))
+            fork_positions.append(instruction_position);
+
+        auto target = static_cast<ssize_t>(instruction_position + opcode.size()) + jump_offset;
+        if (jump_offset < 0 && target >= 0)
+            backward_jumps.append({ instruction_position, static_cast<size_t>(target) });
+
+        state.instruction_position += opcode.size();
+    }
+
+    // A loop is ambiguous if its body can go more than one way, as every way can then be tried on every iteration.
+    for (auto& jump : backward_jumps) {
+        for (auto fork_position : fork_positions) {
+            if (fork_position > jump.target && fork_position < jump.source) {
+                has_ambiguous_loop = true;
+                break;
+            }
+        }
+        if (has_ambiguous_loop)
+            break;
+    }
+
+    if (!has_ambiguous_loop)
+        return;
+
+    if (!has_capture_groups && every_compare_consumes_one_character)
+        parser_result.optimization_data.engine = MatchingEngine::LazyDFA;
+    else
+        parser_result.optimization_data.engine = MatchingEngine::PikeVM;
+}
+
+template<typename Parser>
+void Regex<Parser>::extract_required_literals()
+{
+    // Finds ASCII text that every match has to start with or contain, so that the matcher can scan for it instead of
+    // running the bytecode at every position. The bytecode only ever branches forwards or loops backwards, so the
+    // instructions that every match goes through are the ones that no forward jump or fork goes past.
+    if (parser_result.options.has_flag_set(AllFlags::Insensitive))
+        return;
+
+    auto& bytecode = parser_result.bytecode;
+    auto bytecode_size = bytecode.size();
+
+    // Counts the forward jumps going past each instruction position.
+    Vector<ssize_t> jumps_past_position;
+    jumps_past_position.resize(bytecode_size + 1);
+
+    MatchState state;
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        ssize_t jump_offset = 0;
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+            // Lookarounds compare text that isn't part of the match.
+            return;
+        case OpCodeId::Jump:
+            jump_offset = static_cast<OpCode_Jump const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            jump_offset = static_cast<OpCode_ForkJump const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            jump_offset = static_cast<OpCode_ForkStay const&>(opcode).offset();
+            break;
+        case OpCodeId::JumpNonEmpty:
+            jump_offset = static_cast<OpCode_JumpNonEmpty const&>(opcode).offset();
+            break;
+        default:
+            break;
+        }
+
+        if (jump_offset > 0) {
+            auto target = min(state.instruction_position + opcode.size() + jump_offset, bytecode_size);
+            ++jumps_past_position[state.instruction_position + 1];
+            --jumps_past_position[target];
+        }
+
+        state.instruction_position += opcode.size();
+    }
+
+    for (size_t i = 1; i < jumps_past_position.size(); ++i)
+        jumps_past_position[i] += jumps_past_position[i - 1];
+
+    auto ascii_character = [](CompareTypeAndValuePair const& compare) -> Optional<u8> {
+        if (compare.type != CharacterCompareType::Char || compare.value > 0x7f)
+            return {};
+        return static_cast<u8>(compare.value);
+    };
+
+    // Returns the characters of a small class of ASCII characters, or nothing if there are too many to scan for.
+    auto ascii_characters_of_class = [](Vector<CompareTypeAndValuePair> const& compares) {
+        static constexpr size_t max_starting_characters = 4;
+        Vector<u8> characters;
+        for (auto& compare : compares) {
+            u32 from = 0;
+            u32 to = 0;
+            if (compare.type == CharacterCompareType::Char) {
+                from = to = compare.value;
+            } else if (compare.type == CharacterCompareType::CharRange) {
+                CharRange range { compare.value };
+                from = range.from;
+                to = range.to;
+            } else {
+                return Vector<u8> {};
+            }
+            if (to > 0x7f || to < from || to - from >= max_starting_characters)
+                return Vector<u8> {};
+            for (auto character = from; character <= to; ++character) {
+                if (!characters.contains_slow(character))
+                    characters.append(character);
+            }
+            if (characters.size() > max_starting_characters)
+                return Vector<u8> {};
+        }
+        return characters;
+    };
+
+    StringBuilder current_literal;
+    bool current_literal_is_prefix = false;
+    bool seen_consuming_instruction = false;
+    Optional<ByteString> required_prefix;
+    Vector<u8> starting_characters;
+    ByteString required_infix;
+
+    auto end_literal = [&] {
+        if (current_literal.is_empty())
+            return;
+        auto literal = current_literal.to_byte_string();
+        if (current_literal_is_prefix)
+            required_prefix = literal;
+        if (literal.length() > required_infix.length())
+            required_infix = move(literal);
+        current_literal.clear();
+    };
+
+    state.instruction_position = 0;
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto is_mandatory = jumps_past_position[state.instruction_position] == 0;
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto& compare_opcode = static_cast<OpCode_Compare const&>(opcode);
+            auto compares = compare_opcode.flat_compares();
+            // A String compare is flattened into its characters, which is what we want here.
+            bool is_literal = is_mandatory && !compares.is_empty();
+            for (auto& compare : compares)
+                is_literal = is_literal && ascii_character(compare).has_value();
+
+            // Anything else that's made of several arguments is a class of characters rather than a sequence of them.
+            if (compare_opcode.arguments_count() > 1 || !is_literal) {
+                if (is_mandatory && !seen_consuming_instruction)
+                    starting_characters = ascii_characters_of_class(compares);
+                is_literal = false;
+            }
+
+            if (is_literal) {
+                if (current_literal.is_empty())
+                    current_literal_is_prefix = !seen_consuming_instruction;
+                for (auto& compare : compares)
+                    current_literal.append(static_cast<char>(*ascii_character(compare)));
+            } else {
+                end_literal();
+            }
+            seen_consuming_instruction = true;
+            break;
+        }
+        case OpCodeId::Checkpoint:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+            // These don't consume anything, so the characters around them are next to each other in a match.
+            break;
+        default:
+            end_literal();
+            seen_consuming_instruction = true;
+            break;
+        }
+
+        state.instruction_position += opcode.size();
+    }
+    end_literal();
+
+    if (required_prefix.has_value())
+        starting_characters.clear();
+
+    parser_result.optimization_data.required_prefix = move(required_prefix);
+    parser_result.optimization_data.starting_characters = move(starting_characters);
+    if (!required_infix.is_empty())
+        parser_result.optimization_data.required_infix = move(required_infix);
+}
+
 template<typename Parser>
 void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const& basic_blocks)
 {
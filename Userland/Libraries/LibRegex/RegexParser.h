@@ -44,6 +44,25 @@ template<>
 struct ParserTraits<ECMA262Parser> : public GenericParserTraits<ECMAScriptOptions> {
 };
 
+enum class MatchingEngine : u8 {
+    Backtracking,
+    PikeVM,
+    LazyDFA,
+};
+
+inline StringView matching_engine_name(MatchingEngine engine)
+{
+    switch (engine) {
+    case MatchingEngine::Backtracking:
+        return "Backtracking"sv;
+    case MatchingEngine::PikeVM:
+        return "PikeVM"sv;
+    case MatchingEngine::LazyDFA:
+        return "LazyDFA"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 class Parser {
 public:
     struct Result {
@@ -58,6 +77,12 @@ public:
 
         struct {
             Optional<ByteString> pure_substring_search;
+            MatchingEngine engine { MatchingEngine::Backtracking };
+            // Case-sensitive ASCII text that every match starts with, or a few ASCII characters one of which it starts with.
+            Optional<ByteString> required_prefix;
+            Vector<u8> starting_characters;
+            // Case-sensitive ASCII text that every match contains.
+            Optional<ByteString> required_infix;
         } optimization_data {};
     };
 
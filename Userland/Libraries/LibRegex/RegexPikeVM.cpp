@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibRegex/RegexPikeVM.h>
+
+namespace regex {
+
+PikeVM::PikeVM(ByteCode const& bytecode, MatchInput const& input, size_t& operations, PikeVMScratch& scratch)
+    : m_bytecode(bytecode)
+    , m_match_index(input.match_index)
+    , m_operations(operations)
+    , m_scratch(scratch)
+{
+    // Every run starts its threads without any capture groups, and the winning thread's groups are moved over to
+    // the caller's match index at the end.
+    m_input.view = input.view;
+    m_input.regex_options = input.regex_options;
+    m_input.start_offset = input.start_offset;
+    m_input.line = input.line;
+    m_input.column = input.column;
+    m_input.global_offset = input.global_offset;
+
+    if (m_scratch.visited.size() < bytecode.size())
+        m_scratch.visited.resize(bytecode.size());
+}
+
+void PikeVM::start_generation()
+{
+    // Once the counter wraps around, old marks could look current again.
+    if (++m_scratch.generation == 0) {
+        for (auto& generation : m_scratch.visited)
+            generation = 0;
+        m_scratch.generation = 1;
+    }
+}
+
+PikeVM::Thread PikeVM::make_thread(size_t position, size_t position_in_code_units, size_t start_position) const
+{
+    Thread thread { m_initial_state, start_position };
+    thread.state.string_position = position;
+    thread.state.string_position_in_code_units = position_in_code_units;
+    return thread;
+}
+
+// Follows the thread through all instructions that don't consume anything at the current position, appending the
+// threads that end up blocked on a Compare to the list in priority order.
+// Returns true if a thread reached the end of the bytecode; all lower priority threads are dropped in that case.
+bool PikeVM::add_closure(Vector<Thread>& list, Thread thread)
+{
+    m_pending.clear_with_capacity();
+    m_pending.append({ move(thread), {} });
+
+    while (!m_pending.is_empty()) {
+        auto pending = m_pending.take_last();
+        if (follow(list, pending))
+            return true;
+    }
+
+    return false;
+}
+
+bool PikeVM::follow(Vector<Thread>& list, PendingThread& pending)
+{
+    auto& state = pending.thread.state;
+
+    // The higher priority branch is followed right away, the other one is picked up once this thread is done.
+    auto fork = [&](size_t high_priority_position, size_t low_priority_position) {
+        m_pending.append(pending);
+        m_pending.last().thread.state.instruction_position = low_priority_position;
+        state.instruction_position = high_priority_position;
+    };
+
+    for (;;) {
+        auto instruction_position = state.instruction_position;
+        if (instruction_position < m_scratch.visited.size()) {
+            if (m_scratch.visited[instruction_position] == m_scratch.generation)
+                return false;
+            m_scratch.visited[instruction_position] = m_scratch.generation;
+        }
+
+        auto& opcode = m_bytecode.get_opcode(state);
+        ++m_operations;
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            list.append(move(pending.thread));
+            return false;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump: {
+            auto target = instruction_position + opcode.size() + static_cast<OpCode_ForkJump const&>(opcode).offset();
+            fork(target, instruction_position + opcode.size());
+            continue;
+        }
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay: {
+            auto target = instruction_position + opcode.size() + static_cast<OpCode_ForkStay const&>(opcode).offset();
+            fork(instruction_position + opcode.size(), target);
+            continue;
+        }
+        case OpCodeId::Checkpoint:
+            pending.fresh_checkpoints.append(static_cast<OpCode_Checkpoint const&>(opcode).id());
+            state.instruction_position += opcode.size();
+            continue;
+        case OpCodeId::JumpNonEmpty: {
+            auto const& jump = static_cast<OpCode_JumpNonEmpty const&>(opcode);
+            auto next = instruction_position + opcode.size();
+
+            // Nothing was consumed since the loop's checkpoint, so don't go around again.
+            if (pending.fresh_checkpoints.contains_slow(jump.checkpoint())) {
+                state.instruction_position = next;
+                continue;
+            }
+
+            auto target = next + jump.offset();
+            switch (jump.form()) {
+            case OpCodeId::Jump:
+                state.instruction_position = target;
+                break;
+            case OpCodeId::ForkJump:
+            case OpCodeId::ForkReplaceJump:
+                fork(target, next);
+                break;
+            case OpCodeId::ForkStay:
+            case OpCodeId::ForkReplaceStay:
+                fork(next, target);
+                break;
+            default:
+                VERIFY_NOT_REACHED();
+            }
+            continue;
+        }
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+            if (!m_track_captures) {
+                state.instruction_position += opcode.size();
+                continue;
+            }
+            [[fallthrough]];
+        default: {
+            auto result = opcode.execute(m_input, state);
+            if (result == ExecutionResult::Succeeded) {
+                m_match = move(pending.thread);
+                return true;
+            }
+            if (result != ExecutionResult::Continue)
+                return false;
+            state.instruction_position += opcode.size();
+            continue;
+        }
+        }
+    }
+}
+
+// Runs the Compare that every thread that has arrived at this position is blocked on, and follows the ones that
+// consumed exactly one character. Threads that are in the middle of a longer Compare keep their place in the list
+// until the input has caught up with them.
+bool PikeVM::step(Vector<Thread>& current, Vector<Thread>& next, size_t position)
+{
+    start_generation();
+
+    for (auto& thread : current) {
+        auto& state = thread.state;
+        if (state.string_position == position) {
+            auto& opcode = m_bytecode.get_opcode(state);
+            ++m_operations;
+
+            if (opcode.execute(m_input, state) != ExecutionResult::Continue || state.string_position <= position)
+                continue;
+            state.instruction_position += opcode.size();
+        }
+
+        if (state.string_position > position + 1) {
+            next.append(move(thread));
+            continue;
+        }
+
+        if (add_closure(next, move(thread)))
+            return true;
+    }
+
+    return false;
+}
+
+Optional<size_t> PikeVM::run(MatchState& state, bool search)
+{
+    auto position = state.string_position;
+    auto view_length = m_input.view.length();
+
+    Vector<Thread> current;
+    Vector<Thread> next;
+
+    start_generation();
+    add_closure(current, make_thread(position, state.string_position_in_code_units, position));
+
+    while (position < view_length) {
+        if (current.is_empty() && (!search || m_match.has_value()))
+            break;
+
+        next.clear_with_capacity();
+        step(current, next, position);
+        ++position;
+
+        // A search starts a new thread with the lowest priority at every position, until something has matched.
+        // Note: Like Matcher::match(), this takes the string position as the code unit position for new threads.
+        if (search && !m_match.has_value())
+            add_closure(next, make_thread(position, position, position));
+
+        swap(current, next);
+    }
+
+    if (!m_match.has_value())
+        return {};
+
+    auto& match_state = m_match->state;
+    state.string_position = match_state.string_position;
+    state.string_position_in_code_units = match_state.string_position_in_code_units;
+    set_capture_groups(state, match_state.capture_group_matches);
+
+    return m_match->start_position;
+}
+
+void PikeVM::set_capture_groups(MatchState& state, COWVector<Vector<Match>> const& capture_group_matches) const
+{
+    if (!capture_group_matches.is_empty()) {
+        while (state.capture_group_matches.size() <= m_match_index)
+            state.capture_group_matches.empend();
+        state.capture_group_matches.mutable_at(m_match_index) = capture_group_matches.at(0);
+    } else if (m_match_index < state.capture_group_matches.size()) {
+        state.capture_group_matches.mutable_at(m_match_index).clear();
+    }
+}
+
+// Turns the threads at the end of a step into a transition. While building one, the threads carry the index of the
+// thread they came from in place of their start position.
+LazyDFA::Transition PikeVM::make_transition(LazyDFA& dfa, Vector<Thread>& threads)
+{
+    LazyDFA::Transition transition;
+    Vector<size_t> instruction_positions;
+    instruction_positions.ensure_capacity(threads.size());
+    transition.sources.ensure_capacity(threads.size());
+
+    for (auto& thread : threads) {
+        // Every Compare consumes exactly one character, so no thread can be ahead of the others.
+        VERIFY(thread.state.string_position == threads.first().state.string_position);
+        instruction_positions.unchecked_append(thread.state.instruction_position);
+        transition.sources.unchecked_append(static_cast<u32>(thread.start_position));
+    }
+
+    if (m_match.has_value())
+        transition.match_source = static_cast<u32>(m_match.release_value().start_position);
+
+    transition.target = dfa.intern(move(instruction_positions));
+    return transition;
+}
+
+Optional<size_t> PikeVM::run(LazyDFA& dfa, MatchState& state, bool search)
+{
+    m_track_captures = false;
+
+    auto position = state.string_position;
+    auto view_length = m_input.view.length();
+
+    Vector<size_t> start_positions;
+    Vector<size_t> next_start_positions;
+    Optional<size_t> match_start;
+    size_t match_end = 0;
+
+    // Moves the start positions of the threads along a transition that ended at the current position.
+    auto follow_transition = [&](LazyDFA::Transition const& transition) {
+        next_start_positions.clear_with_capacity();
+        for (auto source : transition.sources)
+            next_start_positions.append(source == LazyDFA::new_thread ? position : start_positions[source]);
+
+        if (transition.match_source.has_value()) {
+            auto source = *transition.match_source;
+            match_start = source == LazyDFA::new_thread ? position : start_positions[source];
+            match_end = position;
+        }
+
+        swap(start_positions, next_start_positions);
+        ++m_operations;
+        return transition.target;
+    };
+
+    Vector<Thread> current;
+    Vector<Thread> next;
+
+    auto context = dfa.context_at(m_bytecode, m_input, position);
+    auto start_transition = dfa.m_start_transitions.find(context);
+    if (start_transition == dfa.m_start_transitions.end()) {
+        start_generation();
+        add_closure(next, make_thread(position, position, LazyDFA::new_thread));
+        dfa.m_start_transitions.set(context, make_transition(dfa, next));
+        start_transition = dfa.m_start_transitions.find(context);
+    }
+    auto current_state = follow_transition(start_transition->value);
+
+    while (position < view_length) {
+        auto starts_new_thread = search && !match_start.has_value();
+        auto* dfa_state = dfa.m_states[current_state].ptr();
+        if (dfa_state->instruction_positions.is_empty() && !starts_new_thread)
+            break;
+
+        LazyDFA::TransitionKey key {
+            .character = (static_cast<u64>(m_input.view[position]) << 32) | m_input.view.code_unit_at(position),
+            .context = dfa.context_at(m_bytecode, m_input, position + 1),
+        };
+        if (starts_new_thread)
+            key.context |= LazyDFA::context_starts_new_thread;
+
+        auto transition = dfa_state->transitions.find(key);
+        if (transition == dfa_state->transitions.end()) {
+            if (dfa.state_count() >= LazyDFA::max_state_count) {
+                // Rather than letting the cache grow without bounds, start over from the current state.
+                auto instruction_positions = dfa_state->instruction_positions;
+                dfa.clear();
+                current_state = dfa.intern(move(instruction_positions));
+                dfa_state = dfa.m_states[current_state].ptr();
+            }
+
+            current.clear_with_capacity();
+            for (size_t i = 0; i < dfa_state->instruction_positions.size(); ++i) {
+                current.append(make_thread(position, position, i));
+                current.last().state.instruction_position = dfa_state->instruction_positions[i];
+            }
+
+            next.clear_with_capacity();
+            step(current, next, position);
+            if (starts_new_thread && !m_match.has_value())
+                add_closure(next, make_thread(position + 1, position + 1, LazyDFA::new_thread));
+
+            dfa_state->transitions.set(key, make_transition(dfa, next));
+            transition = dfa_state->transitions.find(key);
+        }
+
+        ++position;
+        current_state = follow_transition(transition->value);
+    }
+
+    if (!match_start.has_value())
+        return {};
+
+    state.string_position = match_end;
+    state.string_position_in_code_units = match_end;
+    set_capture_groups(state, {});
+
+    return match_start;
+}
+
+LazyDFA::LazyDFA(ByteCode const& bytecode)
+{
+    // All assertions of a kind give the same result at a given position, so one of each is enough to tell them apart.
+    MatchState state;
+    auto bytecode_size = bytecode.size();
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::CheckBegin:
+            m_check_begin_position = state.instruction_position;
+            break;
+        case OpCodeId::CheckEnd:
+            m_check_end_position = state.instruction_position;
+            break;
+        case OpCodeId::CheckBoundary:
+            m_check_boundary_position = state.instruction_position;
+            break;
+        default:
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+}
+
+u32 LazyDFA::intern(Vector<size_t>&& instruction_positions)
+{
+    if (auto id = m_state_ids.get(instruction_positions.span()); id.has_value())
+        return *id;
+
+    auto id = static_cast<u32>(m_states.size());
+    m_states.append(make<State>(move(instruction_positions)));
+    m_state_ids.set(m_states.last()->instruction_positions.span(), id);
+    return id;
+}
+
+u8 LazyDFA::context_at(ByteCode const& bytecode, MatchInput const& input, size_t position) const
+{
+    u8 context = 0;
+    auto check = [&](Optional<size_t> instruction_position, u8 flag) {
+        if (!instruction_position.has_value())
+            return;
+        m_assertion_state.instruction_position = *instruction_position;
+        m_assertion_state.string_position = position;
+        m_assertion_state.string_position_in_code_units = position;
+        if (bytecode.get_opcode(m_assertion_state).execute(input, m_assertion_state) == ExecutionResult::Continue)
+            context |= flag;
+    };
+
+    check(m_check_begin_position, context_at_begin);
+    check(m_check_end_position, context_at_end);
+    check(m_check_boundary_position, context_at_boundary);
+    return context;
+}
+
+void LazyDFA::clear()
+{
+    m_state_ids.clear();
+    m_states.clear();
+    m_start_transitions.clear();
+}
+
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibRegex/RegexByteCode.h>
+#include <LibRegex/RegexMatch.h>
+
+namespace regex {
+
+// The states of this DFA are the lists of instructions that the Pike VM's threads are blocked on, in priority order.
+// Transitions are keyed on the next character and on the result of the assertions at the position after it, and
+// remember which thread every resulting thread came from, so that the start positions of the threads can be
+// followed along without knowing about them in the DFA itself.
+class LazyDFA {
+public:
+    explicit LazyDFA(ByteCode const&);
+
+    size_t state_count() const { return m_states.size(); }
+
+private:
+    friend class PikeVM;
+
+    static constexpr u32 new_thread = NumericLimits<u32>::max();
+    static constexpr size_t max_state_count = 4096;
+
+    static constexpr u8 context_at_begin = 1 << 0;
+    static constexpr u8 context_at_end = 1 << 1;
+    static constexpr u8 context_at_boundary = 1 << 2;
+    static constexpr u8 context_starts_new_thread = 1 << 3;
+
+    struct TransitionKey {
+        u64 character { 0 };
+        u8 context { 0 };
+
+        bool operator==(TransitionKey const&) const = default;
+    };
+
+    struct TransitionKeyTraits : public DefaultTraits<TransitionKey> {
+        static unsigned hash(TransitionKey const& key) { return pair_int_hash(u64_hash(key.character), key.context); }
+    };
+
+    struct Transition {
+        u32 target { 0 };
+        // For every thread of the target state, the thread of the source state it came from, or new_thread.
+        Vector<u32> sources;
+        Optional<u32> match_source;
+    };
+
+    struct InstructionPositionsTraits : public DefaultTraits<ReadonlySpan<size_t>> {
+        static unsigned hash(ReadonlySpan<size_t> instruction_positions)
+        {
+            unsigned hash = 0;
+            for (auto instruction_position : instruction_positions)
+                hash = pair_int_hash(hash, u64_hash(instruction_position));
+            return hash;
+        }
+    };
+
+    struct State {
+        Vector<size_t> instruction_positions;
+        HashMap<TransitionKey, Transition, TransitionKeyTraits> transitions {};
+    };
+
+    u32 intern(Vector<size_t>&& instruction_positions);
+    u8 context_at(ByteCode const&, MatchInput const&, size_t position) const;
+    void clear();
+
+    Optional<size_t> m_check_begin_position;
+    Optional<size_t> m_check_end_position;
+    Optional<size_t> m_check_boundary_position;
+    mutable MatchState m_assertion_state;
+
+    Vector<NonnullOwnPtr<State>> m_states;
+    HashMap<ReadonlySpan<size_t>, u32, InstructionPositionsTraits> m_state_ids;
+    HashMap<u8, Transition> m_start_transitions;
+};
+
+// Bookkeeping that all PikeVM runs of one match share, so that a match that runs the VM at many start positions
+// allocates it once instead of once per run.
+struct PikeVMScratch {
+    // The generation in which each instruction was last visited. Starting a new generation clears all marks at once.
+    Vector<u32> visited;
+    u32 generation { 0 };
+};
+
+// Runs the bytecode as a Thompson NFA: all threads move over the input in lockstep, and at most one thread per
+// instruction is kept at every position, so the work per input character is bounded by the size of the bytecode.
+// Threads are kept in priority order and everything below a matching thread is cut off, which gives the same
+// leftmost-first results as the backtracking VM.
+// This only works for bytecode whose behaviour depends on nothing but the instruction and string positions,
+// see Regex::select_matching_engine() for the instructions that rule it out.
+class PikeVM {
+public:
+    PikeVM(ByteCode const&, MatchInput const&, size_t& operations, PikeVMScratch&);
+
+    // Looks for a match that starts at the state's string position or, when searching, at any later position.
+    // On success, the state is left at the end of the match with its capture groups, and the start of the match is returned.
+    Optional<size_t> run(MatchState&, bool search);
+
+    // Like run(), but caches the transitions between lists of threads in a DFA that's built as the input is read.
+    // Only usable for bytecode without capture groups in which every Compare consumes exactly one character.
+    Optional<size_t> run(LazyDFA&, MatchState&, bool search);
+
+private:
+    struct Thread {
+        MatchState state;
+        size_t start_position { 0 };
+    };
+
+    struct PendingThread {
+        Thread thread;
+        // Checkpoints that were passed without consuming anything since, a JumpNonEmpty for them leaves its loop.
+        Vector<size_t, 2> fresh_checkpoints;
+    };
+
+    Thread make_thread(size_t position, size_t position_in_code_units, size_t start_position) const;
+    void start_generation();
+
+    bool add_closure(Vector<Thread>&, Thread);
+    bool follow(Vector<Thread>&, PendingThread&);
+    bool step(Vector<Thread>& current, Vector<Thread>& next, size_t position);
+    void set_capture_groups(MatchState&, COWVector<Vector<Match>> const&) const;
+    LazyDFA::Transition make_transition(LazyDFA&, Vector<Thread>&);
+
+    ByteCode const& m_bytecode;
+    MatchInput m_input;
+    size_t m_match_index { 0 };
+    size_t& m_operations;
+    bool m_track_captures { true };
+
+    MatchState m_initial_state;
+    PikeVMScratch& m_scratch;
+    Vector<PendingThread> m_pending;
+    Optional<Thread> m_match;
+};
+
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/SIMD.h>
+#include <LibRegex/RegexPrefilter.h>
+
+namespace regex {
+
+static constexpr size_t max_characters_to_scan_for = 4;
+
+template<typename CodeUnit>
+struct ScanVector;
+
+template<>
+struct ScanVector<u8> {
+    using Type = AK::SIMD::u8x16;
+};
+
+template<>
+struct ScanVector<u16> {
+    using Type = AK::SIMD::u16x8;
+};
+
+template<typename CodeUnit>
+static Optional<size_t> find_any_of(ReadonlySpan<CodeUnit> haystack, ReadonlyBytes characters)
+{
+    using VectorType = typename ScanVector<CodeUnit>::Type;
+    static constexpr size_t lanes = sizeof(VectorType) / sizeof(CodeUnit);
+    static constexpr size_t bits_per_lane = 8 * sizeof(CodeUnit);
+
+    VERIFY(!characters.is_empty() && characters.size() <= max_characters_to_scan_for);
+
+    VectorType needles[max_characters_to_scan_for];
+    for (size_t i = 0; i < characters.size(); ++i) {
+        for (size_t lane = 0; lane < lanes; ++lane)
+            needles[i][lane] = characters[i];
+    }
+
+    size_t offset = 0;
+    for (; offset + lanes <= haystack.size(); offset += lanes) {
+        VectorType block;
+        __builtin_memcpy(&block, haystack.data() + offset, sizeof(block));
+
+        VectorType found {};
+        for (size_t i = 0; i < characters.size(); ++i)
+            found |= static_cast<VectorType>(block == needles[i]);
+
+        // Every lane that holds one of the characters is all ones now, the first one is the lowest set bit.
+        auto halves = bit_cast<AK::SIMD::u64x2>(found);
+        if (halves[0] != 0)
+            return offset + count_trailing_zeroes(halves[0]) / bits_per_lane;
+        if (halves[1] != 0)
+            return offset + lanes / 2 + count_trailing_zeroes(halves[1]) / bits_per_lane;
+    }
+
+    for (; offset < haystack.size(); ++offset) {
+        for (auto character : characters) {
+            if (haystack[offset] == character)
+                return offset;
+        }
+    }
+
+    return {};
+}
+
+template<typename CodeUnit>
+static Optional<size_t> find_literal(ReadonlySpan<CodeUnit> haystack, StringView literal)
+{
+    VERIFY(!literal.is_empty());
+
+    // Scan for the first character of the literal, then compare the rest of it in place.
+    auto first_character = static_cast<u8>(literal[0]);
+    size_t offset = 0;
+    while (offset + literal.length() <= haystack.size()) {
+        auto candidate = find_any_of(haystack.slice(offset, haystack.size() - literal.length() + 1 - offset), { &first_character, 1 });
+        if (!candidate.has_value())
+            return {};
+        offset += *candidate;
+
+        bool matches = true;
+        for (size_t i = 1; i < literal.length(); ++i) {
+            if (haystack[offset + i] != static_cast<u8>(literal[i])) {
+                matches = false;
+                break;
+            }
+        }
+        if (matches)
+            return offset;
+        ++offset;
+    }
+
+    return {};
+}
+
+bool can_scan_for_literals(RegexStringView const& view)
+{
+    // Positions in a StringView are always byte offsets, but in a Utf16View they count code points in Unicode mode.
+    if (view.is_string_view())
+        return true;
+    return view.is_u16_view() && !view.unicode();
+}
+
+template<typename Callback>
+static Optional<size_t> scan(RegexStringView const& view, size_t start, Callback callback)
+{
+    VERIFY(can_scan_for_literals(view));
+
+    if (view.is_string_view()) {
+        auto bytes = view.string_view().bytes();
+        if (start >= bytes.size())
+            return {};
+        auto result = callback(bytes.slice(start));
+        if (!result.has_value())
+            return {};
+        return start + *result;
+    }
+
+    auto const& utf16_view = view.u16_view();
+    ReadonlySpan<u16> code_units { utf16_view.data(), utf16_view.length_in_code_units() };
+    if (start >= code_units.size())
+        return {};
+    auto result = callback(code_units.slice(start));
+    if (!result.has_value())
+        return {};
+    return start + *result;
+}
+
+Optional<size_t> find_literal(RegexStringView const& view, size_t start, StringView literal)
+{
+    return scan(view, start, [&](auto haystack) { return find_literal(haystack, literal); });
+}
+
+Optional<size_t> find_any_of(RegexStringView const& view, size_t start, ReadonlyBytes characters)
+{
+    return scan(view, start, [&](auto haystack) { return find_any_of(haystack, characters); });
+}
+
+}
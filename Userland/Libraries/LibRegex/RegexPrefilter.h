@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/StringView.h>
+#include <LibRegex/RegexMatch.h>
+
+namespace regex {
+
+// Vectorized scans for the ASCII literals that the optimizer found in a pattern, used to find the positions at which
+// a match could start without running the bytecode at every one of them.
+// They only work on views in which string positions are code unit offsets, see can_scan_for_literals().
+
+bool can_scan_for_literals(RegexStringView const&);
+
+// Returns the first position at or after `start` at which `literal` occurs in the view.
+Optional<size_t> find_literal(RegexStringView const&, size_t start, StringView literal);
+
+// Returns the first position at or after `start` that holds one of the characters.
+Optional<size_t> find_any_of(RegexStringView const&, size_t start, ReadonlyBytes characters);
+
+}
@@ -274,6 +274,10 @@ ErrorOr<String> UTF8Decoder::to_utf8(StringView input)
         bomless_input = input.substring_view(3);
     }
 
+    // OPTIMIZATION: Valid input decodes to exactly the same bytes, so it doesn't need to be decoded code point by code point.
+    if (Utf8View(bomless_input).validate())
+        return String::from_utf8_without_validation(bomless_input.bytes());
+
     return Decoder::to_utf8(bomless_input);
 }
 
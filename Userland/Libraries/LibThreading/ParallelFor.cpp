@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/NeverDestroyed.h>
+#include <AK/Vector.h>
+#include <LibCore/System.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/ParallelFor.h>
+#include <LibThreading/Thread.h>
+
+namespace Threading {
+
+// Past this, more threads mostly contend for memory bandwidth.
+static constexpr size_t max_thread_count = 32;
+
+size_t parallel_for_thread_count()
+{
+    static size_t const thread_count = clamp<size_t>(Core::System::hardware_concurrency(), 1, max_thread_count);
+    return thread_count;
+}
+
+// Threads that live as long as the process and run the tasks of one parallel_for() call at a time, so that calls
+// don't pay for starting and joining threads.
+class WorkerPool {
+public:
+    static WorkerPool& the()
+    {
+        static NeverDestroyed<WorkerPool> s_the;
+        return *s_the;
+    }
+
+    // Calls `job(thread_index)` on the calling thread with thread_index 0, and on up to `thread_count - 1` workers
+    // with the thread indices after that, and returns once all of them have returned.
+    // Returns false without calling anything if another call is using the pool.
+    bool run(size_t thread_count, Function<void(size_t thread_index)> const& job)
+    {
+        if (m_busy.exchange(true, AK::MemoryOrder::memory_order_acquire))
+            return false;
+
+        {
+            Threading::MutexLocker locker(m_mutex);
+            // NOTE: The workers are started lazily, so that programs that never run anything in parallel don't pay for them.
+            if (m_workers.is_empty())
+                start_workers();
+
+            m_job = &job;
+            m_job_thread_count = min(thread_count, m_workers.size() + 1);
+            m_unfinished_worker_count = m_job_thread_count - 1;
+            ++m_job_generation;
+            if (m_unfinished_worker_count > 0)
+                m_job_available.broadcast();
+        }
+
+        job(0);
+
+        {
+            Threading::MutexLocker locker(m_mutex);
+            while (m_unfinished_worker_count > 0)
+                m_job_finished.wait();
+            m_job = nullptr;
+        }
+
+        m_busy.store(false, AK::MemoryOrder::memory_order_release);
+        return true;
+    }
+
+private:
+    friend class NeverDestroyed<WorkerPool>;
+
+    WorkerPool() = default;
+
+    void start_workers()
+    {
+        for (size_t thread_index = 1; thread_index < parallel_for_thread_count(); ++thread_index) {
+            auto thread = Thread::try_create([this, thread_index] {
+                run_worker(thread_index);
+                return static_cast<intptr_t>(0);
+            },
+                "parallel_for"sv);
+            // The calls spread their tasks over the workers that did start.
+            if (thread.is_error() || m_workers.try_append(thread.value()).is_error())
+                break;
+            thread.value()->start();
+            thread.value()->detach();
+        }
+    }
+
+    void run_worker(size_t thread_index)
+    {
+        Threading::MutexLocker locker(m_mutex);
+        u64 last_job_generation = 0;
+        for (;;) {
+            while (m_job_generation == last_job_generation)
+                m_job_available.wait();
+            last_job_generation = m_job_generation;
+            if (thread_index >= m_job_thread_count)
+                continue;
+
+            auto const& job = *m_job;
+            locker.unlock();
+            job(thread_index);
+            locker.lock();
+
+            if (--m_unfinished_worker_count == 0)
+                m_job_finished.signal();
+        }
+    }
+
+    Atomic<bool> m_busy { false };
+
+    Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_job_available { m_mutex };
+    Threading::ConditionVariable m_job_finished { m_mutex };
+    Vector<NonnullRefPtr<Thread>> m_workers;
+
+    Function<void(size_t thread_index)> const* m_job { nullptr };
+    size_t m_job_thread_count { 0 };
+    size_t m_unfinished_worker_count { 0 };
+    u64 m_job_generation { 0 };
+};
+
+void parallel_for(size_t count, Function<void(size_t index, size_t thread_index)> const& task)
+{
+    Atomic<size_t> next_index { 0 };
+    Function<void(size_t)> run_tasks = [&](size_t thread_index) {
+        for (;;) {
+            auto index = next_index.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            if (index >= count)
+                return;
+            task(index, thread_index);
+        }
+    };
+
+    auto thread_count = min(count, parallel_for_thread_count());
+    if (thread_count <= 1 || !WorkerPool::the().run(thread_count, run_tasks))
+        run_tasks(0);
+}
+
+}
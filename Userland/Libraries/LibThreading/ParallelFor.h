@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+
+namespace Threading {
+
+// The number of threads, including the calling one, that parallel_for() spreads its tasks over.
+size_t parallel_for_thread_count();
+
+// Calls `task(index, thread_index)` for every index in [0, count), in increasing order of index but spread over up to
+// parallel_for_thread_count() threads, and returns once all of the calls have returned.
+// All calls made on one thread get the same thread_index, which is below parallel_for_thread_count(), so it can be used
+// to pick state that is private to that thread.
+// The threads are kept around for later calls. A call made while another one is running, for example from one of its
+// tasks, runs all of its tasks on the calling thread.
+void parallel_for(size_t count, Function<void(size_t index, size_t thread_index)> const& task);
+
+}
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibThreading/Thread.h>
 #include <pthread.h>
 #include <string.h>
@@ -108,7 +109,7 @@ void Thread::start()
         VERIFY(rc == 0);
     }
 #endif
-    dbgln("Started {}", *this);
+    dbgln_if(THREAD_DEBUG, "Started {}", *this);
 }
 
 void Thread::detach()
@@ -43,7 +43,7 @@ Optional<TableAddress> Store::allocate(TableType const& type)
 Optional<MemoryAddress> Store::allocate(MemoryType const& type)
 {
     MemoryAddress address { m_memories.size() };
-    auto instance = MemoryInstance::create(type);
+    auto instance = MemoryInstance::create(type, m_use_guard_pages_for_memories ? MemoryInstance::UseGuardPages::Yes : MemoryInstance::UseGuardPages::No);
     if (instance.is_error())
         return {};
 
@@ -366,7 +366,7 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
                         }
                         if (instance->size() < data.init.size() + offset)
                             instance->grow(data.init.size() + offset - instance->size());
-                        instance->data().overwrite(offset, data.init.data(), data.init.size());
+                        instance->bytes().overwrite(offset, data.init.data(), data.init.size());
                     }
                 },
                 [&](DataSection::Data::Passive const& passive) {
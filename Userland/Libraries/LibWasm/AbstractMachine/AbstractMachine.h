@@ -13,6 +13,7 @@
 #include <AK/Result.h>
 #include <AK/StackInfo.h>
 #include <AK/UFixedBigInt.h>
+#include <LibWasm/AbstractMachine/GuardedLinearMemory.h>
 #include <LibWasm/Types.h>
 
 // NOTE: Special case for Wasm::Result.
@@ -404,10 +405,21 @@ private:
 
 class MemoryInstance {
 public:
-    static ErrorOr<MemoryInstance> create(MemoryType const& type)
+    enum class UseGuardPages {
+        No,
+        Yes,
+    };
+
+    static ErrorOr<MemoryInstance> create(MemoryType const& type, UseGuardPages use_guard_pages = UseGuardPages::No)
     {
         MemoryInstance instance { type };
 
+        // Memories that can't reserve the address space they need just stay bounds checked.
+        if (use_guard_pages == UseGuardPages::Yes) {
+            if (auto guarded_data = GuardedLinearMemory::create(); !guarded_data.is_error())
+                instance.m_guarded_data = guarded_data.release_value();
+        }
+
         if (!instance.grow(type.limits().min() * Constants::page_size))
             return Error::from_string_literal("Failed to grow to requested size");
 
@@ -416,8 +428,25 @@ public:
 
     auto& type() const { return m_type; }
     auto size() const { return m_size; }
-    auto& data() const { return m_data; }
-    auto& data() { return m_data; }
+
+    Bytes bytes() { return m_guarded_data.has_value() ? Bytes { m_guarded_data->data(), m_size } : m_data.bytes(); }
+    ReadonlyBytes bytes() const { return const_cast<MemoryInstance&>(*this).bytes(); }
+
+    // The buffer that holds the memory, which only exists if the memory doesn't use guard pages.
+    auto& data() const
+    {
+        VERIFY(!m_guarded_data.has_value());
+        return m_data;
+    }
+    auto& data()
+    {
+        VERIFY(!m_guarded_data.has_value());
+        return m_data;
+    }
+
+    // Whether accessing the memory past its end is sure to fault, see GuardedLinearMemory. Accesses to such memories
+    // are not bounds checked, but must happen inside a MemoryTrapScope.
+    bool has_guard_pages() const { return m_guarded_data.has_value() && m_size % Constants::page_size == 0; }
 
     enum class InhibitGrowCallback {
         No,
@@ -428,7 +457,7 @@ public:
     {
         if (size_to_grow == 0)
             return true;
-        u64 new_size = m_data.size() + size_to_grow;
+        u64 new_size = m_size + size_to_grow;
         // Can't grow past 2^16 pages.
         if (new_size >= Constants::page_size * 65536)
             return false;
@@ -437,11 +466,17 @@ public:
                 return false;
         }
         auto previous_size = m_size;
-        if (m_data.try_resize(new_size).is_error())
-            return false;
+        if (m_guarded_data.has_value()) {
+            // Growing a guarded memory never moves it, and the spec's zeroing is done by the kernel.
+            if (m_guarded_data->grow_to(new_size).is_error())
+                return false;
+        } else {
+            if (m_data.try_resize(new_size).is_error())
+                return false;
+            // The spec requires that we zero out everything on grow
+            __builtin_memset(m_data.offset_pointer(previous_size), 0, size_to_grow);
+        }
         m_size = new_size;
-        // The spec requires that we zero out everything on grow
-        __builtin_memset(m_data.offset_pointer(previous_size), 0, size_to_grow);
 
         // NOTE: This exists because wasm-js-api wants to execute code after a successful grow,
         //       See [this issue](https://github.com/WebAssembly/spec/issues/1635) for more details.
@@ -462,6 +497,7 @@ private:
     MemoryType m_type;
     size_t m_size { 0 };
     ByteBuffer m_data;
+    Optional<GuardedLinearMemory> m_guarded_data;
 };
 
 class GlobalInstance {
@@ -530,6 +566,10 @@ public:
     Optional<GlobalAddress> allocate(GlobalType const&, Value);
     Optional<ElementAddress> allocate(ValueType const&, Vector<Reference>);
 
+    // Memories that are allocated from now on use guard pages instead of being bounds checked, see GuardedLinearMemory.
+    // Their data() can't be used, so this is only for embedders that don't need to hand out their buffers.
+    void enable_guard_pages_for_memories() { m_use_guard_pages_for_memories = true; }
+
     FunctionInstance* get(FunctionAddress);
     TableInstance* get(TableAddress);
     MemoryInstance* get(MemoryAddress);
@@ -544,6 +584,7 @@ private:
     Vector<GlobalInstance> m_globals;
     Vector<ElementInstance> m_elements;
     Vector<DataInstance> m_datas;
+    bool m_use_guard_pages_for_memories { false };
 };
 
 class Label {
@@ -564,11 +605,12 @@ private:
 
 class Frame {
 public:
-    explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity)
+    explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity, LoweredFunction const* lowered_function = nullptr)
         : m_module(module)
         , m_locals(move(locals))
         , m_expression(expression)
         , m_arity(arity)
+        , m_lowered_function(lowered_function)
     {
     }
 
@@ -577,12 +619,14 @@ public:
     auto& locals() { return m_locals; }
     auto& expression() const { return m_expression; }
     auto arity() const { return m_arity; }
+    auto lowered_function() const { return m_lowered_function; }
 
 private:
     ModuleInstance const& m_module;
     Vector<Value> m_locals;
     Expression const& m_expression;
     size_t m_arity { 0 };
+    LoweredFunction const* m_lowered_function { nullptr };
 };
 
 class Stack {
@@ -621,6 +665,7 @@ public:
     auto& store() { return m_store; }
 
     void enable_instruction_count_limit() { m_should_limit_instruction_count = true; }
+    void enable_guard_pages_for_memories() { m_store.enable_guard_pages_for_memories(); }
 
 private:
     Optional<InstantiationError> allocate_all_initial_phase(Module const&, ModuleInstance&, Vector<ExternValue>&, Vector<Value>& global_values, Vector<FunctionAddress>& own_functions);
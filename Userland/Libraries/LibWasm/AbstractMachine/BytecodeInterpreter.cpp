@@ -5,17 +5,21 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/ByteReader.h>
+#include <AK/Array.h>
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 #include <AK/MemoryStream.h>
 #include <AK/SIMDExtras.h>
+#include <LibCore/System.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
 #include <LibWasm/AbstractMachine/Operators.h>
+#include <LibWasm/JIT/NativeCode.h>
 #include <LibWasm/Opcode.h>
 #include <LibWasm/Printer/Printer.h>
+#include <sys/mman.h>
 
 using namespace AK::SIMD;
 
@@ -36,9 +40,46 @@ namespace Wasm {
         }                                                                                      \
     } while (false)
 
+// Lowered functions keep their frames here. The frames nest like native stack frames, no matter which interpreter
+// runs them, so all interpreters on a thread share the stack.
+struct LoweredStack {
+    static constexpr size_t slot_count = 1 * MiB;
+
+    ~LoweredStack()
+    {
+        if (slots)
+            (void)Core::System::munmap(slots, slot_count * sizeof(u64));
+    }
+
+    u64* slots { nullptr };
+    size_t used { 0 };
+};
+
+static thread_local LoweredStack s_lowered_stack;
+
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap = Empty {};
+    auto lowered_stack_used = s_lowered_stack.used;
+
+    // Accesses to memories with guard pages aren't bounds checked, out-of-bounds ones fault and end up back here.
+    MemoryTrapScope trap_scope;
+    if (sigsetjmp(trap_scope.jump_buffer(), 0) != 0) {
+        s_lowered_stack.used = lowered_stack_used;
+        m_trap = Trap { "Memory access out of bounds" };
+        return;
+    }
+
+    if (auto const* function = configuration.frame().lowered_function(); function && can_run_lowered_functions()) {
+        interpret_lowered_function(configuration, *function);
+        return;
+    }
+
+    interpret_instructions(configuration);
+}
+
+void BytecodeInterpreter::interpret_instructions(Configuration& configuration)
+{
     auto& instructions = configuration.frame().expression().instructions();
     auto max_ip_value = InstructionPointer { instructions.size() };
     auto& current_ip_value = configuration.ip();
@@ -85,6 +126,16 @@ void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelInd
     configuration.ip() = label->continuation();
 }
 
+template<size_t Size>
+ALWAYS_INLINE static Array<u8, Size> read_from_memory(MemoryInstance const& memory, u64 address)
+{
+    // Nothing that needs to be destroyed may be alive here, as this faults for out-of-bounds reads from memories
+    // with guard pages, see MemoryTrapScope.
+    Array<u8, Size> bytes;
+    __builtin_memcpy(bytes.data(), memory.bytes().data() + address, Size);
+    return bytes;
+}
+
 template<typename ReadType, typename PushType>
 void BytecodeInterpreter::load_and_push(Configuration& configuration, Instruction const& instruction)
 {
@@ -102,16 +153,18 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         return;
     }
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
-    Checked addition { instance_address };
-    addition += sizeof(ReadType);
-    if (addition.has_overflow() || addition.value() > memory->size()) {
-        m_trap = Trap { "Memory access out of bounds" };
-        dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + sizeof(ReadType), memory->size());
-        return;
+    if (!memory->has_guard_pages()) {
+        Checked addition { instance_address };
+        addition += sizeof(ReadType);
+        if (addition.has_overflow() || addition.value() > memory->size()) {
+            m_trap = Trap { "Memory access out of bounds" };
+            dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + sizeof(ReadType), memory->size());
+            return;
+        }
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
-    configuration.stack().peek() = Value(static_cast<PushType>(read_value<ReadType>(slice)));
+    auto bytes = read_from_memory<sizeof(ReadType)>(*memory, instance_address);
+    configuration.stack().peek() = Value(static_cast<PushType>(read_value<ReadType>(bytes)));
 }
 
 template<typename TDst, typename TSrc>
@@ -137,23 +190,20 @@ void BytecodeInterpreter::load_and_push_mxn(Configuration& configuration, Instru
         return;
     }
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
-    Checked addition { instance_address };
-    addition += M * N / 8;
-    if (addition.has_overflow() || addition.value() > memory->size()) {
-        m_trap = Trap { "Memory access out of bounds" };
-        dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + M * N / 8, memory->size());
-        return;
+    if (!memory->has_guard_pages()) {
+        Checked addition { instance_address };
+        addition += M * N / 8;
+        if (addition.has_overflow() || addition.value() > memory->size()) {
+            m_trap = Trap { "Memory access out of bounds" };
+            dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + M * N / 8, memory->size());
+            return;
+        }
     }
     dbgln_if(WASM_TRACE_DEBUG, "vec-load({} : {}) -> stack", instance_address, M * N / 8);
-    auto slice = memory->data().bytes().slice(instance_address, M * N / 8);
     using V64 = NativeVectorType<M, N, SetSign>;
     using V128 = NativeVectorType<M * 2, N, SetSign>;
 
-    V64 bytes { 0 };
-    if (bit_cast<FlatPtr>(slice.data()) % sizeof(V64) == 0)
-        bytes = *bit_cast<V64*>(slice.data());
-    else
-        ByteReader::load(slice.data(), bytes);
+    auto bytes = bit_cast<V64>(read_from_memory<M * N / 8>(*memory, instance_address));
 
     configuration.stack().peek() = Value(bit_cast<u128>(convert_vector<V128>(bytes)));
 }
@@ -175,16 +225,18 @@ void BytecodeInterpreter::load_and_push_m_splat(Configuration& configuration, In
         return;
     }
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
-    Checked addition { instance_address };
-    addition += M / 8;
-    if (addition.has_overflow() || addition.value() > memory->size()) {
-        m_trap = Trap { "Memory access out of bounds" };
-        dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + M / 8, memory->size());
-        return;
+    if (!memory->has_guard_pages()) {
+        Checked addition { instance_address };
+        addition += M / 8;
+        if (addition.has_overflow() || addition.value() > memory->size()) {
+            m_trap = Trap { "Memory access out of bounds" };
+            dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + M / 8, memory->size());
+            return;
+        }
     }
     dbgln_if(WASM_TRACE_DEBUG, "vec-splat({} : {}) -> stack", instance_address, M / 8);
-    auto slice = memory->data().bytes().slice(instance_address, M / 8);
-    auto value = read_value<NativeIntegralType<M>>(slice);
+    auto bytes = read_from_memory<M / 8>(*memory, instance_address);
+    auto value = read_value<NativeIntegralType<M>>(bytes);
     set_top_m_splat<M, NativeIntegralType>(configuration, value);
 }
 
@@ -227,6 +279,82 @@ void BytecodeInterpreter::pop_and_push_m_splat(Wasm::Configuration& configuratio
     set_top_m_splat<M, NativeType>(configuration, value);
 }
 
+template<size_t N>
+void BytecodeInterpreter::load_and_push_lane_n(Configuration& configuration, Instruction const& instruction)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    auto& address = configuration.frame().module().memories()[arg.memory.memory_index.value()];
+    auto memory = configuration.store().get(address);
+    if (!memory) {
+        m_trap = Trap { "Nonexistent memory" };
+        return;
+    }
+    auto vector = configuration.stack().pop().get<Value>().to<u128>();
+    auto base = configuration.stack().peek().get<Value>().to<i32>();
+    if (!vector.has_value() || !base.has_value()) {
+        m_trap = Trap { "Memory access out of bounds" };
+        return;
+    }
+    u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.memory.offset;
+    if (!memory->has_guard_pages()) {
+        Checked addition { instance_address };
+        addition += N / 8;
+        if (addition.has_overflow() || addition.value() > memory->size()) {
+            m_trap = Trap { "Memory access out of bounds" };
+            dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + N / 8, memory->size());
+            return;
+        }
+    }
+    dbgln_if(WASM_TRACE_DEBUG, "vec-load-lane({} : {}) -> stack", instance_address, N / 8);
+    auto lanes = bit_cast<NativeVectorType<N, 128 / N, MakeUnsigned>>(vector.value());
+    lanes[arg.lane] = bit_cast<NativeIntegralType<N>>(read_from_memory<N / 8>(*memory, instance_address));
+    configuration.stack().peek() = Value(bit_cast<u128>(lanes));
+}
+
+template<size_t N>
+void BytecodeInterpreter::load_and_push_zero_n(Configuration& configuration, Instruction const& instruction)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
+    auto memory = configuration.store().get(address);
+    if (!memory) {
+        m_trap = Trap { "Nonexistent memory" };
+        return;
+    }
+    auto base = configuration.stack().peek().get<Value>().to<i32>();
+    if (!base.has_value()) {
+        m_trap = Trap { "Memory access out of bounds" };
+        return;
+    }
+    u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
+    if (!memory->has_guard_pages()) {
+        Checked addition { instance_address };
+        addition += N / 8;
+        if (addition.has_overflow() || addition.value() > memory->size()) {
+            m_trap = Trap { "Memory access out of bounds" };
+            dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + N / 8, memory->size());
+            return;
+        }
+    }
+    dbgln_if(WASM_TRACE_DEBUG, "vec-load-zero({} : {}) -> stack", instance_address, N / 8);
+    NativeVectorType<N, 128 / N, MakeUnsigned> lanes {};
+    lanes[0] = bit_cast<NativeIntegralType<N>>(read_from_memory<N / 8>(*memory, instance_address));
+    configuration.stack().peek() = Value(bit_cast<u128>(lanes));
+}
+
+template<size_t N>
+void BytecodeInterpreter::pop_and_store_lane_n(Configuration& configuration, Instruction const& instruction)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    auto vector = configuration.stack().pop().get<Value>().to<u128>();
+    auto base = configuration.stack().pop().get<Value>().to<i32>();
+    TRAP_IF_NOT(vector.has_value());
+    TRAP_IF_NOT(base.has_value());
+    auto value = bit_cast<NativeVectorType<N, 128 / N, MakeUnsigned>>(vector.value())[arg.lane];
+    dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, N / 8);
+    store_to_memory(configuration, arg.memory, { &value, sizeof(value) }, base.value());
+}
+
 template<typename M, template<typename> typename SetSign, typename VectorType>
 Optional<VectorType> BytecodeInterpreter::pop_vector(Configuration& configuration)
 {
@@ -248,14 +376,6 @@ Optional<VectorType> BytecodeInterpreter::peek_vector(Configuration& configurati
     return vector;
 }
 
-template<typename VectorType>
-static u128 shuffle_vector(VectorType values, VectorType indices)
-{
-    auto vector = bit_cast<VectorType>(values);
-    auto indices_vector = bit_cast<VectorType>(indices);
-    return bit_cast<u128>(shuffle(vector, indices_vector));
-}
-
 void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAddress address)
 {
     TRAP_IF_NOT(m_stack_info.size_free() >= Constants::minimum_stack_space_to_keep_free);
@@ -278,6 +398,8 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
     Result result { Trap { ""sv } };
     {
         CallFrameHandle handle { *this, configuration };
+        // Host functions aren't prepared to be jumped out of, and wasm functions set up their own scope.
+        MemoryTrapScope trap_scope { MemoryTrapScope::CatchFaults::No };
         result = configuration.call(*this, address, move(args));
     }
 
@@ -384,19 +506,26 @@ void BytecodeInterpreter::pop_and_store(Configuration& configuration, Instructio
 
 void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruction const& instruction, ReadonlyBytes data, i32 base)
 {
-    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    store_to_memory(configuration, instruction.arguments().get<Instruction::MemoryArgument>(), data, base);
+}
+
+void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruction::MemoryArgument const& arg, ReadonlyBytes data, i32 base)
+{
     auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
     auto memory = configuration.store().get(address);
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
-    Checked addition { instance_address };
-    addition += data.size();
-    if (addition.has_overflow() || addition.value() > memory->size()) {
-        m_trap = Trap { "Memory access out of bounds" };
-        dbgln("LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", instance_address, instance_address + data.size(), memory->size());
-        return;
+    if (!memory->has_guard_pages()) {
+        Checked addition { instance_address };
+        addition += data.size();
+        if (addition.has_overflow() || addition.value() > memory->size()) {
+            m_trap = Trap { "Memory access out of bounds" };
+            dbgln("LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", instance_address, instance_address + data.size(), memory->size());
+            return;
+        }
     }
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    // For memories with guard pages, this is where out-of-bounds stores fault, see read_from_memory().
+    __builtin_memcpy(memory->bytes().data() + instance_address, data.data(), data.size());
 }
 
 template<typename T>
@@ -776,7 +905,8 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto value = configuration.stack().pop().get<Value>().to<i32>().value();
         auto destination_offset = configuration.stack().pop().get<Value>().to<i32>().value();
 
-        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->data().size());
+        // The whole range is checked up front, so that the stores below never fault on a memory with guard pages.
+        TRAP_IF_NOT(static_cast<u64>(bit_cast<u32>(destination_offset)) + bit_cast<u32>(count) <= instance->size());
 
         if (count == 0)
             return;
@@ -803,8 +933,8 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto source_offset = configuration.stack().pop().get<Value>().to<i32>().value();
         auto destination_offset = configuration.stack().pop().get<Value>().to<i32>().value();
 
-        TRAP_IF_NOT(static_cast<size_t>(source_offset + count) <= source_instance->data().size());
-        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= destination_instance->data().size());
+        TRAP_IF_NOT(static_cast<u64>(bit_cast<u32>(source_offset)) + bit_cast<u32>(count) <= source_instance->size());
+        TRAP_IF_NOT(static_cast<u64>(bit_cast<u32>(destination_offset)) + bit_cast<u32>(count) <= destination_instance->size());
 
         if (count == 0)
             return;
@@ -816,12 +946,12 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
 
         if (destination_offset <= source_offset) {
             for (auto i = 0; i < count; ++i) {
-                auto value = source_instance->data()[source_offset + i];
+                auto value = source_instance->bytes()[source_offset + i];
                 store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset + i);
             }
         } else {
             for (auto i = count - 1; i >= 0; --i) {
-                auto value = source_instance->data()[source_offset + i];
+                auto value = source_instance->bytes()[source_offset + i];
                 store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset + i);
             }
         }
@@ -837,9 +967,13 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto source_offset = *configuration.stack().pop().get<Value>().to<i32>();
         auto destination_offset = *configuration.stack().pop().get<Value>().to<i32>();
 
+        auto& memory_address = configuration.frame().module().memories()[args.memory_index.value()];
+        auto memory_instance = configuration.store().get(memory_address);
+
         TRAP_IF_NOT(count > 0);
         TRAP_IF_NOT(source_offset + count > 0);
         TRAP_IF_NOT(static_cast<size_t>(source_offset + count) <= data.size());
+        TRAP_IF_NOT(static_cast<u64>(bit_cast<u32>(destination_offset)) + bit_cast<u32>(count) <= memory_instance->size());
 
         Instruction synthetic_store_instruction {
             Instructions::i32_store8,
@@ -1207,13 +1341,10 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     case Instructions::f64x2_splat.value():
         return pop_and_push_m_splat<64, NativeFloatingType>(configuration, instruction);
     case Instructions::i8x16_shuffle.value(): {
-        auto indices = pop_vector<u8, MakeSigned>(configuration);
-        TRAP_IF_NOT(indices.has_value());
-        auto vector = peek_vector<u8, MakeSigned>(configuration);
-        TRAP_IF_NOT(vector.has_value());
-        auto result = shuffle_vector(vector.value(), indices.value());
-        configuration.stack().peek() = Value(result);
-        return;
+        auto& arg = instruction.arguments().get<Instruction::ShuffleArgument>();
+        u8x16 lanes;
+        __builtin_memcpy(&lanes, arg.lanes, sizeof(lanes));
+        return binary_numeric_operation<u128, u128, Operators::VectorShuffle>(configuration, lanes);
     }
     case Instructions::v128_store.value():
         return pop_and_store<u128, u128>(configuration, instruction);
@@ -1356,152 +1487,308 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     case Instructions::f64x2_ge.value():
         return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<2, Operators::GreaterThanOrEquals>>(configuration);
     case Instructions::v128_not.value():
+        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<2, Operators::BitNot>>(configuration);
     case Instructions::v128_and.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::BitAnd>>(configuration);
     case Instructions::v128_andnot.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::BitAndNot>>(configuration);
     case Instructions::v128_or.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::BitOr>>(configuration);
     case Instructions::v128_xor.value():
-    case Instructions::v128_bitselect.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::BitXor>>(configuration);
+    case Instructions::v128_bitselect.value(): {
+        auto mask = pop_vector<u64, MakeUnsigned>(configuration);
+        TRAP_IF_NOT(mask.has_value());
+        auto false_vector = pop_vector<u64, MakeUnsigned>(configuration);
+        TRAP_IF_NOT(false_vector.has_value());
+        auto true_vector = peek_vector<u64, MakeUnsigned>(configuration);
+        TRAP_IF_NOT(true_vector.has_value());
+        auto result = (true_vector.value() & mask.value()) | (false_vector.value() & ~mask.value());
+        configuration.stack().peek() = Value(bit_cast<u128>(result));
+        return;
+    }
     case Instructions::v128_any_true.value():
+        return unary_operation<u128, i32, Operators::VectorAnyTrue>(configuration);
     case Instructions::v128_load8_lane.value():
+        return load_and_push_lane_n<8>(configuration, instruction);
     case Instructions::v128_load16_lane.value():
+        return load_and_push_lane_n<16>(configuration, instruction);
     case Instructions::v128_load32_lane.value():
+        return load_and_push_lane_n<32>(configuration, instruction);
     case Instructions::v128_load64_lane.value():
+        return load_and_push_lane_n<64>(configuration, instruction);
     case Instructions::v128_store8_lane.value():
+        return pop_and_store_lane_n<8>(configuration, instruction);
     case Instructions::v128_store16_lane.value():
+        return pop_and_store_lane_n<16>(configuration, instruction);
     case Instructions::v128_store32_lane.value():
+        return pop_and_store_lane_n<32>(configuration, instruction);
     case Instructions::v128_store64_lane.value():
+        return pop_and_store_lane_n<64>(configuration, instruction);
     case Instructions::v128_load32_zero.value():
+        return load_and_push_zero_n<32>(configuration, instruction);
     case Instructions::v128_load64_zero.value():
+        return load_and_push_zero_n<64>(configuration, instruction);
     case Instructions::f32x4_demote_f64x2_zero.value():
+        return unary_operation<u128, u128, Operators::VectorDemote>(configuration);
     case Instructions::f64x2_promote_low_f32x4.value():
+        return unary_operation<u128, u128, Operators::VectorPromote>(configuration);
     case Instructions::i8x16_abs.value():
+        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<16, Operators::VectorAbsolute>>(configuration);
     case Instructions::i8x16_neg.value():
+        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<16, Operators::VectorNegate>>(configuration);
     case Instructions::i8x16_popcnt.value():
+        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<16, Operators::VectorPopCount>>(configuration);
     case Instructions::i8x16_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<16>>(configuration);
     case Instructions::i8x16_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<16>>(configuration);
     case Instructions::i8x16_narrow_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<16, MakeSigned>>(configuration);
     case Instructions::i8x16_narrow_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<16, MakeUnsigned>>(configuration);
     case Instructions::f32x4_ceil.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<4, Operators::VectorCeil>>(configuration);
     case Instructions::f32x4_floor.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<4, Operators::VectorFloor>>(configuration);
     case Instructions::f32x4_trunc.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<4, Operators::VectorTruncate>>(configuration);
     case Instructions::f32x4_nearest.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<4, Operators::VectorNearbyIntegral>>(configuration);
     case Instructions::i8x16_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Add>>(configuration);
     case Instructions::i8x16_add_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingAdd, MakeSigned>>(configuration);
     case Instructions::i8x16_add_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingAdd, MakeUnsigned>>(configuration);
     case Instructions::i8x16_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Subtract>>(configuration);
     case Instructions::i8x16_sub_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingSubtract, MakeSigned>>(configuration);
     case Instructions::i8x16_sub_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingSubtract, MakeUnsigned>>(configuration);
     case Instructions::f64x2_ceil.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<2, Operators::VectorCeil>>(configuration);
     case Instructions::f64x2_floor.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<2, Operators::VectorFloor>>(configuration);
     case Instructions::i8x16_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::VectorMinimum, MakeSigned>>(configuration);
     case Instructions::i8x16_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::VectorMinimum, MakeUnsigned>>(configuration);
     case Instructions::i8x16_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::VectorMaximum, MakeSigned>>(configuration);
     case Instructions::i8x16_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::VectorMaximum, MakeUnsigned>>(configuration);
     case Instructions::f64x2_trunc.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<2, Operators::VectorTruncate>>(configuration);
     case Instructions::i8x16_avgr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::RoundingAverage>>(configuration);
     case Instructions::i16x8_extadd_pairwise_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtendAddPairwise<8, MakeSigned>>(configuration);
     case Instructions::i16x8_extadd_pairwise_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtendAddPairwise<8, MakeUnsigned>>(configuration);
     case Instructions::i32x4_extadd_pairwise_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtendAddPairwise<4, MakeSigned>>(configuration);
     case Instructions::i32x4_extadd_pairwise_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtendAddPairwise<4, MakeUnsigned>>(configuration);
     case Instructions::i16x8_abs.value():
+        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<8, Operators::VectorAbsolute>>(configuration);
     case Instructions::i16x8_neg.value():
+        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<8, Operators::VectorNegate>>(configuration);
     case Instructions::i16x8_q15mulr_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorQ15MultiplyRoundSaturate>(configuration);
     case Instructions::i16x8_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<8>>(configuration);
     case Instructions::i16x8_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<8>>(configuration);
     case Instructions::i16x8_narrow_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<8, MakeSigned>>(configuration);
     case Instructions::i16x8_narrow_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<8, MakeUnsigned>>(configuration);
     case Instructions::i16x8_extend_low_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<8, Operators::VectorHalf::Low, MakeSigned>>(configuration);
     case Instructions::i16x8_extend_high_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<8, Operators::VectorHalf::High, MakeSigned>>(configuration);
     case Instructions::i16x8_extend_low_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<8, Operators::VectorHalf::Low, MakeUnsigned>>(configuration);
     case Instructions::i16x8_extend_high_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<8, Operators::VectorHalf::High, MakeUnsigned>>(configuration);
     case Instructions::i16x8_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Add>>(configuration);
     case Instructions::i16x8_add_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingAdd, MakeSigned>>(configuration);
     case Instructions::i16x8_add_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingAdd, MakeUnsigned>>(configuration);
     case Instructions::i16x8_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Subtract>>(configuration);
     case Instructions::i16x8_sub_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingSubtract, MakeSigned>>(configuration);
     case Instructions::i16x8_sub_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingSubtract, MakeUnsigned>>(configuration);
     case Instructions::f64x2_nearest.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<2, Operators::VectorNearbyIntegral>>(configuration);
     case Instructions::i16x8_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Multiply>>(configuration);
     case Instructions::i16x8_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::VectorMinimum, MakeSigned>>(configuration);
     case Instructions::i16x8_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::VectorMinimum, MakeUnsigned>>(configuration);
     case Instructions::i16x8_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::VectorMaximum, MakeSigned>>(configuration);
     case Instructions::i16x8_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::VectorMaximum, MakeUnsigned>>(configuration);
     case Instructions::i16x8_avgr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::RoundingAverage>>(configuration);
     case Instructions::i16x8_extmul_low_i8x16_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<8, Operators::VectorHalf::Low, MakeSigned>>(configuration);
     case Instructions::i16x8_extmul_high_i8x16_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<8, Operators::VectorHalf::High, MakeSigned>>(configuration);
     case Instructions::i16x8_extmul_low_i8x16_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<8, Operators::VectorHalf::Low, MakeUnsigned>>(configuration);
     case Instructions::i16x8_extmul_high_i8x16_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<8, Operators::VectorHalf::High, MakeUnsigned>>(configuration);
     case Instructions::i32x4_abs.value():
+        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<4, Operators::VectorAbsolute>>(configuration);
     case Instructions::i32x4_neg.value():
+        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<4, Operators::VectorNegate>>(configuration);
     case Instructions::i32x4_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<4>>(configuration);
     case Instructions::i32x4_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<4>>(configuration);
     case Instructions::i32x4_extend_low_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<4, Operators::VectorHalf::Low, MakeSigned>>(configuration);
     case Instructions::i32x4_extend_high_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<4, Operators::VectorHalf::High, MakeSigned>>(configuration);
     case Instructions::i32x4_extend_low_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<4, Operators::VectorHalf::Low, MakeUnsigned>>(configuration);
     case Instructions::i32x4_extend_high_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<4, Operators::VectorHalf::High, MakeUnsigned>>(configuration);
     case Instructions::i32x4_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Add>>(configuration);
     case Instructions::i32x4_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Subtract>>(configuration);
     case Instructions::i32x4_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Multiply>>(configuration);
     case Instructions::i32x4_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::VectorMinimum, MakeSigned>>(configuration);
     case Instructions::i32x4_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::VectorMinimum, MakeUnsigned>>(configuration);
     case Instructions::i32x4_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::VectorMaximum, MakeSigned>>(configuration);
     case Instructions::i32x4_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::VectorMaximum, MakeUnsigned>>(configuration);
     case Instructions::i32x4_dot_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorDot>(configuration);
     case Instructions::i32x4_extmul_low_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<4, Operators::VectorHalf::Low, MakeSigned>>(configuration);
     case Instructions::i32x4_extmul_high_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<4, Operators::VectorHalf::High, MakeSigned>>(configuration);
     case Instructions::i32x4_extmul_low_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<4, Operators::VectorHalf::Low, MakeUnsigned>>(configuration);
     case Instructions::i32x4_extmul_high_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<4, Operators::VectorHalf::High, MakeUnsigned>>(configuration);
     case Instructions::i64x2_abs.value():
+        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<2, Operators::VectorAbsolute>>(configuration);
     case Instructions::i64x2_neg.value():
+        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<2, Operators::VectorNegate>>(configuration);
     case Instructions::i64x2_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<2>>(configuration);
     case Instructions::i64x2_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<2>>(configuration);
     case Instructions::i64x2_extend_low_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<2, Operators::VectorHalf::Low, MakeSigned>>(configuration);
     case Instructions::i64x2_extend_high_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<2, Operators::VectorHalf::High, MakeSigned>>(configuration);
     case Instructions::i64x2_extend_low_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<2, Operators::VectorHalf::Low, MakeUnsigned>>(configuration);
     case Instructions::i64x2_extend_high_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<2, Operators::VectorHalf::High, MakeUnsigned>>(configuration);
     case Instructions::i64x2_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::Add>>(configuration);
     case Instructions::i64x2_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::Subtract>>(configuration);
     case Instructions::i64x2_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::Multiply>>(configuration);
     case Instructions::i64x2_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::Equals>>(configuration);
     case Instructions::i64x2_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::NotEquals>>(configuration);
     case Instructions::i64x2_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::LessThan, MakeSigned>>(configuration);
     case Instructions::i64x2_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::GreaterThan, MakeSigned>>(configuration);
     case Instructions::i64x2_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::LessThanOrEquals, MakeSigned>>(configuration);
     case Instructions::i64x2_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::GreaterThanOrEquals, MakeSigned>>(configuration);
     case Instructions::i64x2_extmul_low_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<2, Operators::VectorHalf::Low, MakeSigned>>(configuration);
     case Instructions::i64x2_extmul_high_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<2, Operators::VectorHalf::High, MakeSigned>>(configuration);
     case Instructions::i64x2_extmul_low_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<2, Operators::VectorHalf::Low, MakeUnsigned>>(configuration);
     case Instructions::i64x2_extmul_high_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<2, Operators::VectorHalf::High, MakeUnsigned>>(configuration);
     case Instructions::f32x4_abs.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<4, Operators::VectorAbsolute>>(configuration);
     case Instructions::f32x4_neg.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<4, Operators::VectorNegate>>(configuration);
     case Instructions::f32x4_sqrt.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<4, Operators::VectorSquareRoot>>(configuration);
     case Instructions::f32x4_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<4, Operators::Add>>(configuration);
     case Instructions::f32x4_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<4, Operators::Subtract>>(configuration);
     case Instructions::f32x4_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<4, Operators::Multiply>>(configuration);
     case Instructions::f32x4_div.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<4, Operators::VectorDivide>>(configuration);
     case Instructions::f32x4_min.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<4, Operators::VectorMinimum>>(configuration);
     case Instructions::f32x4_max.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<4, Operators::VectorMaximum>>(configuration);
     case Instructions::f32x4_pmin.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<4, Operators::PseudoMinimum>>(configuration);
     case Instructions::f32x4_pmax.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<4, Operators::PseudoMaximum>>(configuration);
     case Instructions::f64x2_abs.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<2, Operators::VectorAbsolute>>(configuration);
     case Instructions::f64x2_neg.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<2, Operators::VectorNegate>>(configuration);
     case Instructions::f64x2_sqrt.value():
+        return unary_operation<u128, u128, Operators::VectorFloatUnaryOp<2, Operators::VectorSquareRoot>>(configuration);
     case Instructions::f64x2_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<2, Operators::Add>>(configuration);
     case Instructions::f64x2_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<2, Operators::Subtract>>(configuration);
     case Instructions::f64x2_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<2, Operators::Multiply>>(configuration);
     case Instructions::f64x2_div.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<2, Operators::VectorDivide>>(configuration);
     case Instructions::f64x2_min.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<2, Operators::VectorMinimum>>(configuration);
     case Instructions::f64x2_max.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<2, Operators::VectorMaximum>>(configuration);
     case Instructions::f64x2_pmin.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<2, Operators::PseudoMinimum>>(configuration);
     case Instructions::f64x2_pmax.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<2, Operators::PseudoMaximum>>(configuration);
     case Instructions::i32x4_trunc_sat_f32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorSaturatingTruncate<i32, 4>>(configuration);
     case Instructions::i32x4_trunc_sat_f32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorSaturatingTruncate<u32, 4>>(configuration);
     case Instructions::f32x4_convert_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<4, MakeSigned>>(configuration);
     case Instructions::f32x4_convert_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<4, MakeUnsigned>>(configuration);
     case Instructions::i32x4_trunc_sat_f64x2_s_zero.value():
+        return unary_operation<u128, u128, Operators::VectorSaturatingTruncate<i32, 2>>(configuration);
     case Instructions::i32x4_trunc_sat_f64x2_u_zero.value():
+        return unary_operation<u128, u128, Operators::VectorSaturatingTruncate<u32, 2>>(configuration);
     case Instructions::f64x2_convert_low_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<2, MakeSigned>>(configuration);
     case Instructions::f64x2_convert_low_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<2, MakeUnsigned>>(configuration);
     case Instructions::table_init.value():
     case Instructions::elem_drop.value():
     case Instructions::table_copy.value():
@@ -1516,6 +1803,379 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     }
 }
 
+u64 value_to_slot(Value const& value)
+{
+    return value.value().visit(
+        [](u128) -> u64 { VERIFY_NOT_REACHED(); },
+        [](Reference const&) -> u64 { VERIFY_NOT_REACHED(); },
+        [](auto number) -> u64 { return to_slot(number); });
+}
+
+Value slot_to_value(ValueType const& type, u64 slot)
+{
+    switch (type.kind()) {
+    case ValueType::I32:
+        return Value(read_slot<i32>(slot));
+    case ValueType::I64:
+        return Value(read_slot<i64>(slot));
+    case ValueType::F32:
+        return Value(read_slot<float>(slot));
+    case ValueType::F64:
+        return Value(read_slot<double>(slot));
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void BytecodeInterpreter::interpret_lowered_function(Configuration& configuration, LoweredFunction const& function)
+{
+    auto& stack = s_lowered_stack;
+    if (!stack.slots) {
+        auto slots_or_error = Core::System::mmap(nullptr, LoweredStack::slot_count * sizeof(u64), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0, 0, "Wasm lowered function stack"sv);
+        if (slots_or_error.is_error()) {
+            m_trap = Trap { "Failed to allocate the stack for lowered functions" };
+            return;
+        }
+        stack.slots = static_cast<u64*>(slots_or_error.release_value());
+    }
+    if (stack.used + function.frame_size() > LoweredStack::slot_count) {
+        m_trap = Trap { "Call stack exhausted" };
+        return;
+    }
+
+    // The frame lives on the configuration's stack, which calls out of the function may move, so don't hold on to it.
+    auto& module = configuration.frame().module();
+    auto* slots = stack.slots + stack.used;
+    for (size_t i = 0; i < function.parameter_types().size(); ++i)
+        slots[i] = value_to_slot(configuration.frame().locals()[i]);
+
+    auto succeeded = configuration.should_limit_instruction_count()
+        ? run_lowered_function<true>(configuration, module, function, slots)
+        : run_lowered_function<false>(configuration, module, function, slots);
+    if (!succeeded)
+        return;
+
+    for (size_t i = 0; i < function.result_types().size(); ++i)
+        configuration.stack().push(slot_to_value(function.result_types()[i], slots[i]));
+}
+
+template<bool limit_instruction_count>
+bool BytecodeInterpreter::run_lowered_function(Configuration& configuration, ModuleInstance const& module, LoweredFunction const& function, u64* slots)
+{
+    // Nothing in here may need to be destroyed, as out-of-bounds accesses to memories with guard pages jump right out
+    // of it, see MemoryTrapScope.
+    static void* const handlers[] = {
+#define __ENUMERATE_HANDLER(name, ...) &&handle_##name,
+#define __ENUMERATE_HANDLER_WITH_IMMEDIATE(name, ...) &&handle_##name##_immediate,
+        ENUMERATE_LOWERED_OPCODES(__ENUMERATE_HANDLER, __ENUMERATE_HANDLER_WITH_IMMEDIATE)
+#undef __ENUMERATE_HANDLER
+#undef __ENUMERATE_HANDLER_WITH_IMMEDIATE
+    };
+    static_assert(array_size(handlers) == to_underlying(LoweredInstruction::OpCode::Count));
+
+    auto previous_stack_used = s_lowered_stack.used;
+    s_lowered_stack.used = static_cast<size_t>(slots - s_lowered_stack.slots) + function.frame_size();
+    for (size_t i = function.parameter_types().size(); i < function.local_count(); ++i)
+        slots[i] = 0;
+
+    if (auto const* native_code = function.get_or_create_native_code()) {
+        JIT::NativeContext context;
+        context.interpreter = this;
+        context.configuration = &configuration;
+        context.module = &module;
+        context.instruction_budget = limit_instruction_count ? Constants::max_allowed_executed_instructions_per_call : NumericLimits<u64>::max();
+        context.reload_memory();
+        auto succeeded = native_code->run(slots, context);
+        if (!succeeded && !context.trap_reason.is_empty())
+            m_trap = Trap { context.trap_reason };
+        s_lowered_stack.used = previous_stack_used;
+        return succeeded;
+    }
+
+    auto const* instructions = function.instructions().data();
+    auto const* branch_table = function.branch_table().data();
+    auto const* ip = instructions;
+    u64 executed_instructions = 0;
+    StringView trap_reason;
+
+    // Memory 0, as the lowered code sees it. Calls and memory.grow can move it, so it is reloaded after those.
+    u8* memory_data = nullptr;
+    u64 memory_size = 0;
+    bool memory_needs_bounds_checks = true;
+    auto reload_memory = [&] {
+        if (module.memories().is_empty())
+            return;
+        auto* memory = configuration.store().get(module.memories()[0]);
+        memory_data = memory->bytes().data();
+        memory_size = memory->size();
+        memory_needs_bounds_checks = !memory->has_guard_pages();
+    };
+    reload_memory();
+
+#define DISPATCH()                                                                                                  \
+    do {                                                                                                            \
+        if constexpr (limit_instruction_count) {                                                                    \
+            if (executed_instructions++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] { \
+                trap_reason = "Exceeded maximum allowed number of instructions"sv;                                  \
+                goto trap;                                                                                          \
+            }                                                                                                       \
+        }                                                                                                           \
+        goto* handlers[to_underlying(ip->opcode)];                                                                  \
+    } while (false)
+
+#define DISPATCH_NEXT() \
+    do {                \
+        ++ip;           \
+        DISPATCH();     \
+    } while (false)
+
+#define TRAP(reason)            \
+    do {                        \
+        trap_reason = reason##sv; \
+        goto trap;              \
+    } while (false)
+
+    DISPATCH();
+
+handle_copy:
+    slots[ip->destination] = slots[ip->lhs];
+    DISPATCH_NEXT();
+
+handle_constant:
+    slots[ip->destination] = ip->immediate;
+    DISPATCH_NEXT();
+
+handle_unreachable:
+    TRAP("Unreachable");
+
+handle_branch:
+    ip = instructions + ip->immediate;
+    DISPATCH();
+
+handle_branch_if:
+    if (static_cast<u32>(slots[ip->lhs]) != 0) {
+        ip = instructions + ip->immediate;
+        DISPATCH();
+    }
+    DISPATCH_NEXT();
+
+handle_branch_unless:
+    if (static_cast<u32>(slots[ip->lhs]) == 0) {
+        ip = instructions + ip->immediate;
+        DISPATCH();
+    }
+    DISPATCH_NEXT();
+
+handle_branch_table:
+    ip = instructions + branch_table[ip->immediate + min(static_cast<u32>(slots[ip->lhs]), ip->rhs)];
+    DISPATCH();
+
+handle_return_:
+    s_lowered_stack.used = previous_stack_used;
+    return true;
+
+handle_call:
+    if (!call_from_lowered_function<limit_instruction_count>(configuration, module.functions()[ip->immediate], slots + ip->destination))
+        goto trapped_in_call;
+    reload_memory();
+    DISPATCH_NEXT();
+
+handle_call_indirect: {
+    auto address = resolve_indirect_call(configuration, module, ip->rhs, ip->immediate, static_cast<u32>(slots[ip->lhs]));
+    if (address.is_error()) {
+        trap_reason = address.error();
+        goto trap;
+    }
+    if (!call_from_lowered_function<limit_instruction_count>(configuration, address.value(), slots + ip->destination))
+        goto trapped_in_call;
+    reload_memory();
+    DISPATCH_NEXT();
+}
+
+handle_select:
+    slots[ip->destination] = static_cast<u32>(slots[ip->immediate]) != 0 ? slots[ip->lhs] : slots[ip->rhs];
+    DISPATCH_NEXT();
+
+handle_global_get:
+    slots[ip->destination] = value_to_slot(configuration.store().get(module.globals()[ip->immediate])->value());
+    DISPATCH_NEXT();
+
+handle_global_set: {
+    auto* global = configuration.store().get(module.globals()[ip->immediate]);
+    global->set_value(slot_to_value(global->value().type(), slots[ip->lhs]));
+    DISPATCH_NEXT();
+}
+
+handle_memory_size:
+    slots[ip->destination] = to_slot(static_cast<i32>(memory_size / Constants::page_size));
+    DISPATCH_NEXT();
+
+handle_memory_grow: {
+    auto* memory = configuration.store().get(module.memories()[0]);
+    auto old_pages = static_cast<i32>(memory->size() / Constants::page_size);
+    if (memory->grow(static_cast<u64>(read_slot<u32>(slots[ip->lhs])) * Constants::page_size))
+        slots[ip->destination] = to_slot(old_pages);
+    else
+        slots[ip->destination] = to_slot(-1);
+    reload_memory();
+    DISPATCH_NEXT();
+}
+
+handle_memory_fill: {
+    auto destination = read_slot<u32>(slots[ip->destination]);
+    auto count = read_slot<u32>(slots[ip->rhs]);
+    // The range is checked up front, so that this never faults on a memory with guard pages.
+    if (static_cast<u64>(destination) + count > memory_size)
+        TRAP("Memory access out of bounds");
+    __builtin_memset(memory_data + destination, static_cast<u8>(slots[ip->lhs]), count);
+    DISPATCH_NEXT();
+}
+
+handle_memory_copy: {
+    auto destination = read_slot<u32>(slots[ip->destination]);
+    auto source = read_slot<u32>(slots[ip->lhs]);
+    auto count = read_slot<u32>(slots[ip->rhs]);
+    if (static_cast<u64>(destination) + count > memory_size || static_cast<u64>(source) + count > memory_size)
+        TRAP("Memory access out of bounds");
+    __builtin_memmove(memory_data + destination, memory_data + source, count);
+    DISPATCH_NEXT();
+}
+
+#define __HANDLE_UNARY_OPERATION(name, PopType, PushType, Operator)                                                                            \
+    handle_##name:                                                                                                                             \
+    if (!lowered_unary_operation<PopType, PushType, Operators::Operator>(slots[ip->destination], slots[ip->lhs], trap_reason)) [[unlikely]] \
+        goto trap;                                                                                                                             \
+    DISPATCH_NEXT();
+    ENUMERATE_LOWERED_UNARY_OPERATIONS(__HANDLE_UNARY_OPERATION)
+#undef __HANDLE_UNARY_OPERATION
+
+#define __HANDLE_BINARY_OPERATION(name, PopType, PushType, Operator)                                                                                           \
+    handle_##name:                                                                                                                                             \
+    if (!lowered_binary_operation<PopType, PushType, Operators::Operator>(slots[ip->destination], slots[ip->lhs], slots[ip->rhs], trap_reason)) [[unlikely]]   \
+        goto trap;                                                                                                                                             \
+    DISPATCH_NEXT();                                                                                                                                           \
+    handle_##name##_immediate:                                                                                                                                 \
+    if (!lowered_binary_operation<PopType, PushType, Operators::Operator>(slots[ip->destination], slots[ip->lhs], ip->immediate, trap_reason)) [[unlikely]]    \
+        goto trap;                                                                                                                                             \
+    DISPATCH_NEXT();
+    ENUMERATE_LOWERED_BINARY_OPERATIONS(__HANDLE_BINARY_OPERATION)
+#undef __HANDLE_BINARY_OPERATION
+
+#define __HANDLE_LOAD_OPERATION(name, ReadType, PushType)                                                    \
+    handle_##name : {                                                                                        \
+        auto address = static_cast<u64>(static_cast<u32>(slots[ip->lhs])) + ip->immediate;                  \
+        if (memory_needs_bounds_checks && address + sizeof(ReadType) > memory_size) [[unlikely]]            \
+            TRAP("Memory access out of bounds");                                                             \
+        auto value = read_from_lowered_memory<ReadType>(memory_data + address);                             \
+        slots[ip->destination] = to_slot(static_cast<PushType>(value));                                      \
+        DISPATCH_NEXT();                                                                                     \
+    }
+    ENUMERATE_LOWERED_LOAD_OPERATIONS(__HANDLE_LOAD_OPERATION)
+#undef __HANDLE_LOAD_OPERATION
+
+#define __HANDLE_STORE_OPERATION(name, PopType, StoreType)                                                   \
+    handle_##name : {                                                                                        \
+        auto address = static_cast<u64>(static_cast<u32>(slots[ip->lhs])) + ip->immediate;                  \
+        if (memory_needs_bounds_checks && address + sizeof(StoreType) > memory_size) [[unlikely]]           \
+            TRAP("Memory access out of bounds");                                                             \
+        write_to_lowered_memory(memory_data + address, static_cast<StoreType>(read_slot<PopType>(slots[ip->rhs]))); \
+        DISPATCH_NEXT();                                                                                     \
+    }
+    ENUMERATE_LOWERED_STORE_OPERATIONS(__HANDLE_STORE_OPERATION)
+#undef __HANDLE_STORE_OPERATION
+
+#undef DISPATCH
+#undef DISPATCH_NEXT
+#undef TRAP
+
+trap:
+    m_trap = Trap { trap_reason };
+trapped_in_call:
+    s_lowered_stack.used = previous_stack_used;
+    return false;
+}
+
+template<bool limit_instruction_count>
+bool BytecodeInterpreter::call_from_lowered_function(Configuration& configuration, FunctionAddress address, u64* frame)
+{
+    if (m_stack_info.size_free() < Constants::minimum_stack_space_to_keep_free) {
+        m_trap = Trap { "Call stack exhausted" };
+        return false;
+    }
+
+    // Lowered functions are called right away, with the arguments in place as the start of their frame.
+    auto* instance = configuration.store().get(address);
+    if (auto* function = instance->get_pointer<WasmFunction>(); function && function->code().lowered()) {
+        auto& lowered_function = *function->code().lowered();
+        if (static_cast<size_t>(frame - s_lowered_stack.slots) + lowered_function.frame_size() > LoweredStack::slot_count) {
+            m_trap = Trap { "Call stack exhausted" };
+            return false;
+        }
+        return run_lowered_function<limit_instruction_count>(configuration, function->module(), lowered_function, frame);
+    }
+
+    FunctionType const* type = nullptr;
+    instance->visit([&](auto const& function) { type = &function.type(); });
+    return call_through_configuration(configuration, address, *type, frame);
+}
+
+bool BytecodeInterpreter::call_from_native_code(Configuration& configuration, FunctionAddress address, u64* frame)
+{
+    return configuration.should_limit_instruction_count()
+        ? call_from_lowered_function<true>(configuration, address, frame)
+        : call_from_lowered_function<false>(configuration, address, frame);
+}
+
+ErrorOr<FunctionAddress, StringView> BytecodeInterpreter::resolve_indirect_call(Configuration& configuration, ModuleInstance const& module, u32 table_index, u64 type_index, u32 element_index)
+{
+    auto* table = configuration.store().get(module.tables()[table_index]);
+    if (element_index >= table->elements().size())
+        return "Undefined element in indirect call"sv;
+    auto const& element = table->elements()[element_index];
+    if (!element.has_value() || !element->ref().has<Reference::Func>())
+        return "Uninitialized element in indirect call"sv;
+    auto address = element->ref().get<Reference::Func>().address;
+
+    FunctionType const* type = nullptr;
+    configuration.store().get(address)->visit([&](auto const& function) { type = &function.type(); });
+    auto const& expected_type = module.types()[type_index];
+    if (type->parameters() != expected_type.parameters() || type->results() != expected_type.results())
+        return "Indirect call type mismatch"sv;
+    return address;
+}
+
+bool BytecodeInterpreter::call_through_configuration(Configuration& configuration, FunctionAddress address, FunctionType const& type, u64* frame)
+{
+    Vector<Value> arguments;
+    arguments.ensure_capacity(type.parameters().size());
+    for (size_t i = 0; i < type.parameters().size(); ++i)
+        arguments.unchecked_append(slot_to_value(type.parameters()[i], frame[i]));
+
+    Result result { Trap { ""sv } };
+    {
+        CallFrameHandle handle { *this, configuration };
+        // Host functions aren't prepared to be jumped out of, and wasm functions set up their own scope.
+        MemoryTrapScope trap_scope { MemoryTrapScope::CatchFaults::No };
+        result = configuration.call(*this, address, move(arguments));
+    }
+
+    if (result.is_trap()) {
+        m_trap = move(result.trap());
+        return false;
+    }
+
+    if (result.is_completion()) {
+        m_trap = move(result.completion());
+        return false;
+    }
+
+    // The results come off the callee's stack, so the last one is first.
+    auto& values = result.values();
+    for (size_t i = 0; i < values.size(); ++i)
+        frame[i] = value_to_slot(values[values.size() - i - 1]);
+    return true;
+}
+
 void DebuggerBytecodeInterpreter::interpret(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
 {
     if (pre_interpret_hook) {
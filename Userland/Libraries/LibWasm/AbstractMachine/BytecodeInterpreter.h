@@ -12,6 +12,10 @@
 
 namespace Wasm {
 
+namespace JIT {
+class Compiler;
+}
+
 struct BytecodeInterpreter : public Interpreter {
     explicit BytecodeInterpreter(StackInfo const& stack_info)
         : m_stack_info(stack_info)
@@ -44,6 +48,11 @@ struct BytecodeInterpreter : public Interpreter {
     };
 
 protected:
+    // Functions that the validator lowered run in their own format, unless the interpreter needs to see every
+    // instruction as it runs.
+    virtual bool can_run_lowered_functions() const { return true; }
+
+    void interpret_instructions(Configuration&);
     virtual void interpret(Configuration&, InstructionPointer&, Instruction const&);
     void branch_to_label(Configuration&, LabelIndex);
     template<typename ReadT, typename PushT>
@@ -58,13 +67,29 @@ protected:
     void set_top_m_splat(Configuration&, NativeType<M>);
     template<size_t M, template<size_t> typename NativeType>
     void pop_and_push_m_splat(Configuration&, Instruction const&);
+    template<size_t N>
+    void load_and_push_lane_n(Configuration&, Instruction const&);
+    template<size_t N>
+    void load_and_push_zero_n(Configuration&, Instruction const&);
+    template<size_t N>
+    void pop_and_store_lane_n(Configuration&, Instruction const&);
     template<typename M, template<typename> typename SetSign, typename VectorType = Native128ByteVectorOf<M, SetSign>>
     Optional<VectorType> pop_vector(Configuration&);
     template<typename M, template<typename> typename SetSign, typename VectorType = Native128ByteVectorOf<M, SetSign>>
     Optional<VectorType> peek_vector(Configuration&);
     void store_to_memory(Configuration&, Instruction const&, ReadonlyBytes data, i32 base);
+    void store_to_memory(Configuration&, Instruction::MemoryArgument const&, ReadonlyBytes data, i32 base);
     void call_address(Configuration&, FunctionAddress);
 
+    void interpret_lowered_function(Configuration&, LoweredFunction const&);
+    template<bool limit_instruction_count>
+    bool run_lowered_function(Configuration&, ModuleInstance const&, LoweredFunction const&, u64* frame);
+    template<bool limit_instruction_count>
+    bool call_from_lowered_function(Configuration&, FunctionAddress, u64* frame);
+    bool call_through_configuration(Configuration&, FunctionAddress, FunctionType const&, u64* frame);
+    bool call_from_native_code(Configuration&, FunctionAddress, u64* frame);
+    ErrorOr<FunctionAddress, StringView> resolve_indirect_call(Configuration&, ModuleInstance const&, u32 table_index, u64 type_index, u32 element_index);
+
     template<typename PopTypeLHS, typename PushType, typename Operator, typename PopTypeRHS = PopTypeLHS, typename... Args>
     void binary_numeric_operation(Configuration&, Args&&...);
 
@@ -90,6 +115,8 @@ protected:
 
     Variant<Trap, JS::Completion, Empty> m_trap;
     StackInfo const& m_stack_info;
+
+    friend class JIT::Compiler;
 };
 
 struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
@@ -103,6 +130,7 @@ struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
     Function<bool(Configuration&, InstructionPointer&, Instruction const&, Interpreter const&)> post_interpret_hook;
 
 private:
+    virtual bool can_run_lowered_functions() const override { return !pre_interpret_hook && !post_interpret_hook; }
     virtual void interpret(Configuration&, InstructionPointer&, Instruction const&) override;
 };
 
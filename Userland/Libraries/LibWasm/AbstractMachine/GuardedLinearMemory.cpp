@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/BitCast.h>
+#include <LibCore/System.h>
+#include <LibWasm/AbstractMachine/GuardedLinearMemory.h>
+#include <LibWasm/Constants.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/mman.h>
+
+namespace Wasm {
+
+// Any 32-bit address plus 32-bit offset plus the size of the largest access lands in here.
+static constexpr size_t reservation_size = (2ull << 32) + Constants::page_size;
+static constexpr size_t max_reservation_count = 256;
+
+// The base addresses of all live reservations, so that the fault handler can tell whether a fault hit one of them.
+static Array<Atomic<FlatPtr>, max_reservation_count> s_reservations;
+
+static thread_local MemoryTrapScope* s_current_scope { nullptr };
+
+static struct sigaction s_previous_segv_action;
+static struct sigaction s_previous_bus_action;
+
+static bool is_in_reservation(FlatPtr address)
+{
+    for (auto& reservation : s_reservations) {
+        auto base = reservation.load(AK::MemoryOrder::memory_order_relaxed);
+        if (base != 0 && address - base < reservation_size)
+            return true;
+    }
+    return false;
+}
+
+static void handle_memory_fault(int signal, siginfo_t* info, void* context)
+{
+    if (auto* scope = s_current_scope; scope && is_in_reservation(bit_cast<FlatPtr>(info->si_addr)))
+        siglongjmp(scope->jump_buffer(), 1);
+
+    // This fault isn't ours, so hand it to whoever was handling these before.
+    auto& previous_action = signal == SIGSEGV ? s_previous_segv_action : s_previous_bus_action;
+    if (previous_action.sa_flags & SA_SIGINFO) {
+        previous_action.sa_sigaction(signal, info, context);
+        return;
+    }
+    if (previous_action.sa_handler != SIG_DFL && previous_action.sa_handler != SIG_IGN) {
+        previous_action.sa_handler(signal);
+        return;
+    }
+
+    // Returning runs the faulting instruction again, which now crashes the way it would have without us.
+    struct sigaction default_action {};
+    default_action.sa_handler = SIG_DFL;
+    sigaction(signal, &default_action, nullptr);
+}
+
+static ErrorOr<void> install_memory_fault_handler()
+{
+    static Atomic<bool> s_installed { false };
+    if (s_installed.exchange(true))
+        return {};
+
+    struct sigaction action {};
+    action.sa_sigaction = handle_memory_fault;
+    // The handler jumps out instead of returning, so the signal must not stay blocked while it runs.
+    action.sa_flags = SA_SIGINFO | SA_NODEFER | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    TRY(Core::System::sigaction(SIGSEGV, &action, &s_previous_segv_action));
+    TRY(Core::System::sigaction(SIGBUS, &action, &s_previous_bus_action));
+    return {};
+}
+
+ErrorOr<GuardedLinearMemory> GuardedLinearMemory::create()
+{
+    TRY(install_memory_fault_handler());
+
+    auto* base = TRY(Core::System::mmap(nullptr, reservation_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0, 0, "Wasm linear memory"sv));
+    for (size_t slot = 0; slot < max_reservation_count; ++slot) {
+        FlatPtr expected = 0;
+        if (s_reservations[slot].compare_exchange_strong(expected, bit_cast<FlatPtr>(base)))
+            return GuardedLinearMemory { static_cast<u8*>(base), slot };
+    }
+
+    TRY(Core::System::munmap(base, reservation_size));
+    return Error::from_string_literal("Too many guarded linear memories");
+}
+
+GuardedLinearMemory::GuardedLinearMemory(GuardedLinearMemory&& other)
+    : m_base(exchange(other.m_base, nullptr))
+    , m_size(exchange(other.m_size, 0))
+    , m_slot(other.m_slot)
+{
+}
+
+GuardedLinearMemory& GuardedLinearMemory::operator=(GuardedLinearMemory&& other)
+{
+    swap(m_base, other.m_base);
+    swap(m_size, other.m_size);
+    swap(m_slot, other.m_slot);
+    return *this;
+}
+
+GuardedLinearMemory::~GuardedLinearMemory()
+{
+    if (!m_base)
+        return;
+    MUST(Core::System::munmap(m_base, reservation_size));
+    s_reservations[m_slot].store(0);
+}
+
+ErrorOr<void> GuardedLinearMemory::grow_to(size_t size)
+{
+    VERIFY(size <= reservation_size - Constants::page_size);
+
+    // Memory is made accessible a whole wasm page at a time, which is always a whole number of system pages.
+    auto accessible_size = align_up_to(m_size, Constants::page_size);
+    auto new_accessible_size = align_up_to(size, Constants::page_size);
+    if (new_accessible_size > accessible_size) {
+        if (::mprotect(m_base + accessible_size, new_accessible_size - accessible_size, PROT_READ | PROT_WRITE) < 0)
+            return Error::from_syscall("mprotect"sv, -errno);
+    }
+
+    m_size = max(m_size, size);
+    return {};
+}
+
+MemoryTrapScope::MemoryTrapScope(CatchFaults catch_faults)
+    : m_previous(s_current_scope)
+{
+    s_current_scope = catch_faults == CatchFaults::Yes ? this : nullptr;
+}
+
+MemoryTrapScope::~MemoryTrapScope()
+{
+    s_current_scope = m_previous;
+}
+
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Noncopyable.h>
+#include <AK/Types.h>
+#include <setjmp.h>
+
+namespace Wasm {
+
+// Linear memory in a reservation of address space that no 32-bit address plus 32-bit offset can reach past.
+// Only the first size() bytes of it are accessible, so the memory never moves when it grows, and accesses past
+// its end fault on the rest of the reservation instead of having to be bounds checked. MemoryTrapScope turns
+// those faults into traps.
+class GuardedLinearMemory {
+    AK_MAKE_NONCOPYABLE(GuardedLinearMemory);
+
+public:
+    static ErrorOr<GuardedLinearMemory> create();
+
+    GuardedLinearMemory(GuardedLinearMemory&&);
+    GuardedLinearMemory& operator=(GuardedLinearMemory&&);
+    ~GuardedLinearMemory();
+
+    u8* data() const { return m_base; }
+    size_t size() const { return m_size; }
+
+    // Makes the first `size` bytes of the memory accessible, rounded up to a whole wasm page.
+    // Pages that were not accessible before read as zeroes.
+    ErrorOr<void> grow_to(size_t size);
+
+private:
+    GuardedLinearMemory(u8* base, size_t slot)
+        : m_base(base)
+        , m_slot(slot)
+    {
+    }
+
+    u8* m_base { nullptr };
+    size_t m_size { 0 };
+    size_t m_slot { 0 };
+};
+
+// While a scope lives, faults on a GuardedLinearMemory in the current thread jump back to the sigsetjmp() on its
+// jump_buffer(), which must be in the function that created the scope. Code that runs until the fault must not
+// own anything that needs to be destroyed, as nothing between the fault and the sigsetjmp() is unwound.
+// Scopes nest, and a scope that does not catch faults disables the scopes around it, e.g. for host functions
+// that are called from wasm code.
+class MemoryTrapScope {
+    AK_MAKE_NONCOPYABLE(MemoryTrapScope);
+    AK_MAKE_NONMOVABLE(MemoryTrapScope);
+
+public:
+    enum class CatchFaults {
+        No,
+        Yes,
+    };
+
+    explicit MemoryTrapScope(CatchFaults = CatchFaults::Yes);
+    ~MemoryTrapScope();
+
+    sigjmp_buf& jump_buffer() { return m_jump_buffer; }
+
+private:
+    MemoryTrapScope* m_previous { nullptr };
+    sigjmp_buf m_jump_buffer;
+};
+
+}
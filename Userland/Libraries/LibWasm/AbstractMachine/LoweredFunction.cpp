@@ -0,0 +1,734 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AllOf.h>
+#include <AK/BitCast.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+#include <LibWasm/JIT/Compiler.h>
+#include <LibWasm/JIT/NativeCode.h>
+
+namespace Wasm {
+
+// These live here as Module::Function only has an incomplete LoweredFunction.
+Module::Function::Function(TypeIndex type, Vector<ValueType> local_types, Expression body)
+    : m_type(type)
+    , m_local_types(move(local_types))
+    , m_body(move(body))
+{
+}
+
+Module::Function::Function(Function&&) = default;
+Module::Function& Module::Function::operator=(Function&&) = default;
+Module::Function::~Function() = default;
+
+void Module::Function::set_lowered(OwnPtr<LoweredFunction> lowered, Badge<Validator>)
+{
+    m_lowered = move(lowered);
+}
+
+static bool is_number(ValueType const& type)
+{
+    switch (type.kind()) {
+    case ValueType::I32:
+    case ValueType::I64:
+    case ValueType::F32:
+    case ValueType::F64:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool are_numbers(Vector<ValueType> const& types)
+{
+    return all_of(types, [](auto& type) { return is_number(type); });
+}
+
+static bool has_only_numbers(FunctionType const& type)
+{
+    return are_numbers(type.parameters()) && are_numbers(type.results());
+}
+
+class FunctionLowerer {
+    using OpCode = LoweredInstruction::OpCode;
+
+public:
+    FunctionLowerer(Context const& context, LoweredFunction& function)
+        : m_context(context)
+        , m_function(function)
+    {
+    }
+
+    bool lower(Expression const&, size_t result_count);
+
+private:
+    // A value on the operand stack. Values that local.get and constants push are only written to the slot that they
+    // have on the operand stack once something needs them to be there, until then instructions read them from the
+    // slot of the local, or take them as an immediate.
+    struct Operand {
+        enum class Kind {
+            Slot,
+            Constant,
+        };
+
+        static Operand in_slot(u32 slot) { return { Kind::Slot, slot, 0 }; }
+        static Operand constant(u64 value) { return { Kind::Constant, 0, value }; }
+
+        Kind kind;
+        u32 slot;
+        u64 value;
+    };
+
+    struct BranchFixup {
+        bool is_in_branch_table { false };
+        size_t index { 0 };
+    };
+
+    struct ControlFrame {
+        enum class Kind {
+            Function,
+            Block,
+            Loop,
+            If,
+        };
+
+        Kind kind;
+        size_t base_height { 0 };
+        size_t parameter_count { 0 };
+        size_t result_count { 0 };
+        size_t loop_start { 0 };
+        Vector<BranchFixup> branches_to_end {};
+        Optional<size_t> branch_to_else {};
+
+        size_t label_arity() const { return kind == Kind::Loop ? parameter_count : result_count; }
+    };
+
+    bool lower(Instruction const&);
+    bool lower_block(Instruction const&, ControlFrame::Kind);
+    void lower_else();
+    void lower_end();
+
+    bool block_type(BlockType const&, size_t& parameter_count, size_t& result_count) const;
+
+    u32 home(size_t position) const { return m_function.m_local_count + position; }
+    bool is_at_home(size_t position) const
+    {
+        auto& operand = m_stack[position];
+        return operand.kind == Operand::Kind::Slot && operand.slot == home(position);
+    }
+
+    size_t emit(LoweredInstruction instruction)
+    {
+        m_last_result_producer = {};
+        m_instructions.append(instruction);
+        return m_instructions.size() - 1;
+    }
+    void emit_result(LoweredInstruction instruction)
+    {
+        emit(instruction);
+        m_last_result_producer = m_instructions.size() - 1;
+    }
+    void emit_move(Operand const& operand, u32 destination)
+    {
+        if (operand.kind == Operand::Kind::Constant)
+            emit({ OpCode::constant, destination, 0, 0, operand.value });
+        else if (operand.slot != destination)
+            emit({ OpCode::copy, destination, operand.slot });
+    }
+
+    u32 push()
+    {
+        m_stack.append(Operand::in_slot(home(m_stack.size())));
+        m_max_height = max(m_max_height, m_stack.size());
+        return m_stack.last().slot;
+    }
+    void push(Operand operand)
+    {
+        m_stack.append(operand);
+        m_max_height = max(m_max_height, m_stack.size());
+    }
+    Operand pop() { return m_stack.take_last(); }
+    // Pops a value into a slot that an instruction can read it from.
+    u32 pop_slot()
+    {
+        auto operand = pop();
+        if (operand.kind == Operand::Kind::Slot)
+            return operand.slot;
+        auto slot = home(m_stack.size());
+        emit_move(operand, slot);
+        return slot;
+    }
+
+    void materialize(size_t position)
+    {
+        if (is_at_home(position))
+            return;
+        emit_move(m_stack[position], home(position));
+        m_stack[position] = Operand::in_slot(home(position));
+    }
+    void materialize_all()
+    {
+        for (size_t i = 0; i < m_stack.size(); ++i)
+            materialize(i);
+    }
+    void materialize_reads_of_local(u32 local)
+    {
+        for (size_t i = 0; i < m_stack.size(); ++i) {
+            if (m_stack[i].kind == Operand::Kind::Slot && m_stack[i].slot == local)
+                materialize(i);
+        }
+    }
+    void reset_stack(size_t height)
+    {
+        m_stack.shrink(min(height, m_stack.size()));
+        while (m_stack.size() < height)
+            push();
+    }
+
+    void bind_label() { m_last_result_producer = {}; }
+    void patch(BranchFixup const&, size_t target);
+
+    void lower_local_set(u32 local, bool keep_value);
+    void emit_return();
+    void emit_branch(size_t depth);
+    void emit_branch_if(size_t depth, u32 condition);
+    bool branch_needs_moves(ControlFrame const&) const;
+    void emit_branch_moves(ControlFrame const&);
+    void emit_jump_to(ControlFrame&, OpCode, u32 condition = 0);
+
+    Context const& m_context;
+    LoweredFunction& m_function;
+    Vector<LoweredInstruction>& m_instructions { m_function.m_instructions };
+
+    Vector<Operand, 32> m_stack;
+    Vector<ControlFrame, 16> m_frames;
+    size_t m_max_height { 0 };
+
+    // Instructions after a branch can't be reached until the end of its block, they are skipped instead of lowered.
+    bool m_is_unreachable { false };
+    size_t m_unreachable_block_depth { 0 };
+
+    // The last instruction, if it wrote a result to the top of the operand stack, so that a local.set can make it
+    // write its result to the local instead.
+    Optional<size_t> m_last_result_producer;
+};
+
+bool FunctionLowerer::block_type(BlockType const& type, size_t& parameter_count, size_t& result_count) const
+{
+    switch (type.kind()) {
+    case BlockType::Empty:
+        parameter_count = 0;
+        result_count = 0;
+        return true;
+    case BlockType::Type:
+        parameter_count = 0;
+        result_count = 1;
+        return is_number(type.value_type());
+    case BlockType::Index: {
+        auto& function_type = m_context.types[type.type_index().value()];
+        parameter_count = function_type.parameters().size();
+        result_count = function_type.results().size();
+        return has_only_numbers(function_type);
+    }
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void FunctionLowerer::patch(BranchFixup const& fixup, size_t target)
+{
+    if (fixup.is_in_branch_table)
+        m_function.m_branch_table[fixup.index] = target;
+    else
+        m_instructions[fixup.index].immediate = target;
+}
+
+void FunctionLowerer::lower_local_set(u32 local, bool keep_value)
+{
+    auto value = pop();
+    if (value.kind == Operand::Kind::Slot && value.slot == local) {
+        if (keep_value)
+            push(value);
+        return;
+    }
+
+    auto producer = m_last_result_producer;
+    materialize_reads_of_local(local);
+    if (value.kind == Operand::Kind::Slot && producer.has_value() && producer == m_last_result_producer && m_instructions[*producer].destination == value.slot) {
+        // Nothing else wrote to the slot of the value yet, so the instruction that computed it can write to the local.
+        m_instructions[*producer].destination = local;
+        m_last_result_producer = {};
+    } else {
+        emit_move(value, local);
+    }
+
+    if (keep_value)
+        push(value.kind == Operand::Kind::Constant ? value : Operand::in_slot(local));
+}
+
+void FunctionLowerer::emit_return()
+{
+    auto result_count = m_frames.first().result_count;
+    auto first_result = m_stack.size() - result_count;
+
+    // Results that are still in locals might be overwritten by other results, so they go through their slot first.
+    for (size_t i = 0; i < result_count; ++i) {
+        auto& operand = m_stack[first_result + i];
+        if (operand.kind == Operand::Kind::Slot && operand.slot < m_function.m_local_count && operand.slot != i)
+            emit_move(operand, home(first_result + i));
+    }
+    for (size_t i = 0; i < result_count; ++i) {
+        auto& operand = m_stack[first_result + i];
+        if (operand.kind == Operand::Kind::Constant)
+            emit_move(operand, i);
+        else if (operand.slot >= m_function.m_local_count)
+            emit_move(operand, i);
+        else if (operand.slot != i)
+            emit_move(Operand::in_slot(home(first_result + i)), i);
+    }
+    emit({ OpCode::return_ });
+}
+
+bool FunctionLowerer::branch_needs_moves(ControlFrame const& frame) const
+{
+    auto arity = frame.label_arity();
+    for (size_t i = 0; i < arity; ++i) {
+        auto& operand = m_stack[m_stack.size() - arity + i];
+        if (operand.kind != Operand::Kind::Slot || operand.slot != home(frame.base_height + i))
+            return true;
+    }
+    return false;
+}
+
+void FunctionLowerer::emit_branch_moves(ControlFrame const& frame)
+{
+    // The values are above their destinations on the stack, so moving them from the bottom up never overwrites any.
+    auto arity = frame.label_arity();
+    for (size_t i = 0; i < arity; ++i)
+        emit_move(m_stack[m_stack.size() - arity + i], home(frame.base_height + i));
+}
+
+void FunctionLowerer::emit_jump_to(ControlFrame& frame, OpCode opcode, u32 condition)
+{
+    auto index = emit({ opcode, 0, condition });
+    if (frame.kind == ControlFrame::Kind::Loop)
+        m_instructions[index].immediate = frame.loop_start;
+    else
+        frame.branches_to_end.append({ false, index });
+}
+
+void FunctionLowerer::emit_branch(size_t depth)
+{
+    auto& frame = m_frames[m_frames.size() - 1 - depth];
+    if (frame.kind == ControlFrame::Kind::Function) {
+        emit_return();
+    } else {
+        emit_branch_moves(frame);
+        emit_jump_to(frame, OpCode::branch);
+    }
+    m_is_unreachable = true;
+}
+
+void FunctionLowerer::emit_branch_if(size_t depth, u32 condition)
+{
+    auto& frame = m_frames[m_frames.size() - 1 - depth];
+    if (frame.kind != ControlFrame::Kind::Function && !branch_needs_moves(frame)) {
+        emit_jump_to(frame, OpCode::branch_if, condition);
+        return;
+    }
+
+    // The moves must only happen when the branch is taken, as they may overwrite values that are still needed.
+    auto skip = emit({ OpCode::branch_unless, 0, condition });
+    if (frame.kind == ControlFrame::Kind::Function) {
+        emit_return();
+    } else {
+        emit_branch_moves(frame);
+        emit_jump_to(frame, OpCode::branch);
+    }
+    m_instructions[skip].immediate = m_instructions.size();
+    bind_label();
+}
+
+bool FunctionLowerer::lower_block(Instruction const& instruction, ControlFrame::Kind kind)
+{
+    auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+    size_t parameter_count = 0;
+    size_t result_count = 0;
+    if (!block_type(args.block_type, parameter_count, result_count))
+        return false;
+
+    Optional<size_t> branch_to_else;
+    if (kind == ControlFrame::Kind::If) {
+        auto condition = pop_slot();
+        materialize_all();
+        branch_to_else = emit({ OpCode::branch_unless, 0, condition });
+    } else {
+        materialize_all();
+    }
+
+    if (kind == ControlFrame::Kind::Loop)
+        bind_label();
+
+    m_frames.append({
+        .kind = kind,
+        .base_height = m_stack.size() - parameter_count,
+        .parameter_count = parameter_count,
+        .result_count = result_count,
+        .loop_start = m_instructions.size(),
+        .branches_to_end = {},
+        .branch_to_else = branch_to_else,
+    });
+    return true;
+}
+
+void FunctionLowerer::lower_else()
+{
+    auto& frame = m_frames.last();
+    if (!m_is_unreachable) {
+        materialize_all();
+        emit_jump_to(frame, OpCode::branch);
+    }
+
+    m_instructions[*frame.branch_to_else].immediate = m_instructions.size();
+    frame.branch_to_else = {};
+    bind_label();
+
+    reset_stack(frame.base_height);
+    reset_stack(frame.base_height + frame.parameter_count);
+    m_is_unreachable = false;
+}
+
+void FunctionLowerer::lower_end()
+{
+    auto frame = m_frames.take_last();
+    if (!m_is_unreachable)
+        materialize_all();
+
+    // An if without an else passes its parameters on as its results.
+    if (frame.branch_to_else.has_value())
+        frame.branches_to_end.append({ false, *frame.branch_to_else });
+
+    for (auto& fixup : frame.branches_to_end)
+        patch(fixup, m_instructions.size());
+    bind_label();
+
+    reset_stack(frame.base_height);
+    reset_stack(frame.base_height + frame.result_count);
+    m_is_unreachable = false;
+}
+
+bool FunctionLowerer::lower(Expression const& expression, size_t result_count)
+{
+    m_frames.append({ .kind = ControlFrame::Kind::Function, .result_count = result_count });
+
+    for (auto& instruction : expression.instructions()) {
+        if (m_is_unreachable) {
+            auto opcode = instruction.opcode();
+            if (opcode == Instructions::block || opcode == Instructions::loop || opcode == Instructions::if_) {
+                ++m_unreachable_block_depth;
+                continue;
+            }
+            if (m_unreachable_block_depth > 0) {
+                if (opcode == Instructions::structured_end)
+                    --m_unreachable_block_depth;
+                continue;
+            }
+            if (opcode != Instructions::structured_end && opcode != Instructions::structured_else)
+                continue;
+        }
+
+        if (!lower(instruction))
+            return false;
+    }
+
+    VERIFY(m_frames.size() == 1);
+    for (auto& fixup : m_frames.first().branches_to_end)
+        patch(fixup, m_instructions.size());
+    if (!m_is_unreachable)
+        emit_return();
+
+    m_function.m_frame_size = m_function.m_local_count + m_max_height;
+    return true;
+}
+
+bool FunctionLowerer::lower(Instruction const& instruction)
+{
+    switch (instruction.opcode().value()) {
+    case Instructions::nop.value():
+        return true;
+    case Instructions::unreachable.value():
+        emit({ OpCode::unreachable });
+        m_is_unreachable = true;
+        return true;
+    case Instructions::block.value():
+        return lower_block(instruction, ControlFrame::Kind::Block);
+    case Instructions::loop.value():
+        return lower_block(instruction, ControlFrame::Kind::Loop);
+    case Instructions::if_.value():
+        return lower_block(instruction, ControlFrame::Kind::If);
+    case Instructions::structured_else.value():
+        lower_else();
+        return true;
+    case Instructions::structured_end.value():
+        lower_end();
+        return true;
+    case Instructions::br.value():
+        emit_branch(instruction.arguments().get<LabelIndex>().value());
+        return true;
+    case Instructions::br_if.value(): {
+        auto condition = pop_slot();
+        emit_branch_if(instruction.arguments().get<LabelIndex>().value(), condition);
+        return true;
+    }
+    case Instructions::br_table.value(): {
+        auto& args = instruction.arguments().get<Instruction::TableBranchArgs>();
+        auto index = pop_slot();
+        auto table_start = m_function.m_branch_table.size();
+        m_function.m_branch_table.resize(table_start + args.labels.size() + 1);
+        emit({ OpCode::branch_table, 0, index, static_cast<u32>(args.labels.size()), table_start });
+
+        // Labels that don't need any values moved are jumped to directly, the others through a stub that moves them.
+        auto lower_entry = [&](size_t entry, LabelIndex label) {
+            auto& frame = m_frames[m_frames.size() - 1 - label.value()];
+            if (frame.kind != ControlFrame::Kind::Function && !branch_needs_moves(frame)) {
+                if (frame.kind == ControlFrame::Kind::Loop)
+                    m_function.m_branch_table[entry] = frame.loop_start;
+                else
+                    frame.branches_to_end.append({ true, entry });
+                return;
+            }
+            m_function.m_branch_table[entry] = m_instructions.size();
+            if (frame.kind == ControlFrame::Kind::Function) {
+                emit_return();
+            } else {
+                emit_branch_moves(frame);
+                emit_jump_to(frame, OpCode::branch);
+            }
+        };
+        for (size_t i = 0; i < args.labels.size(); ++i)
+            lower_entry(table_start + i, args.labels[i]);
+        lower_entry(table_start + args.labels.size(), args.default_);
+
+        m_is_unreachable = true;
+        return true;
+    }
+    case Instructions::return_.value():
+        emit_return();
+        m_is_unreachable = true;
+        return true;
+    case Instructions::call.value():
+    case Instructions::call_indirect.value(): {
+        bool is_indirect = instruction.opcode() == Instructions::call_indirect;
+        FunctionType const* type = nullptr;
+        if (is_indirect)
+            type = &m_context.types[instruction.arguments().get<Instruction::IndirectCallArgs>().type.value()];
+        else
+            type = &m_context.functions[instruction.arguments().get<FunctionIndex>().value()];
+        if (!has_only_numbers(*type))
+            return false;
+
+        u32 table_index = is_indirect ? pop_slot() : 0;
+        auto parameter_count = type->parameters().size();
+        // The frame of the callee starts with the arguments, so they must be in their slots.
+        for (size_t i = m_stack.size() - parameter_count; i < m_stack.size(); ++i)
+            materialize(i);
+        auto frame_start = home(m_stack.size() - parameter_count);
+        m_stack.shrink(m_stack.size() - parameter_count);
+
+        if (is_indirect) {
+            auto& args = instruction.arguments().get<Instruction::IndirectCallArgs>();
+            emit({ OpCode::call_indirect, frame_start, table_index, static_cast<u32>(args.table.value()), args.type.value() });
+        } else {
+            emit({ OpCode::call, frame_start, 0, 0, instruction.arguments().get<FunctionIndex>().value() });
+        }
+        for (size_t i = 0; i < type->results().size(); ++i)
+            push();
+        return true;
+    }
+    case Instructions::drop.value():
+        pop();
+        return true;
+    case Instructions::select.value():
+    case Instructions::select_typed.value(): {
+        if (instruction.opcode() == Instructions::select_typed && !are_numbers(instruction.arguments().get<Vector<ValueType>>()))
+            return false;
+        auto condition = pop_slot();
+        auto if_false = pop_slot();
+        auto if_true = pop_slot();
+        emit_result({ OpCode::select, home(m_stack.size()), if_true, if_false, condition });
+        push();
+        return true;
+    }
+    case Instructions::local_get.value():
+        push(Operand::in_slot(instruction.arguments().get<LocalIndex>().value()));
+        return true;
+    case Instructions::local_set.value():
+        lower_local_set(instruction.arguments().get<LocalIndex>().value(), false);
+        return true;
+    case Instructions::local_tee.value():
+        lower_local_set(instruction.arguments().get<LocalIndex>().value(), true);
+        return true;
+    case Instructions::global_get.value(): {
+        auto index = instruction.arguments().get<GlobalIndex>().value();
+        if (!is_number(m_context.globals[index].type()))
+            return false;
+        emit_result({ OpCode::global_get, home(m_stack.size()), 0, 0, index });
+        push();
+        return true;
+    }
+    case Instructions::global_set.value(): {
+        auto index = instruction.arguments().get<GlobalIndex>().value();
+        if (!is_number(m_context.globals[index].type()))
+            return false;
+        emit({ OpCode::global_set, 0, pop_slot(), 0, index });
+        return true;
+    }
+    case Instructions::i32_const.value():
+        push(Operand::constant(to_slot(instruction.arguments().get<i32>())));
+        return true;
+    case Instructions::i64_const.value():
+        push(Operand::constant(to_slot(instruction.arguments().get<i64>())));
+        return true;
+    case Instructions::f32_const.value():
+        push(Operand::constant(to_slot(instruction.arguments().get<float>())));
+        return true;
+    case Instructions::f64_const.value():
+        push(Operand::constant(to_slot(instruction.arguments().get<double>())));
+        return true;
+    case Instructions::memory_size.value(): {
+        if (instruction.arguments().get<Instruction::MemoryIndexArgument>().memory_index.value() != 0)
+            return false;
+        emit_result({ OpCode::memory_size, home(m_stack.size()) });
+        push();
+        return true;
+    }
+    case Instructions::memory_grow.value(): {
+        if (instruction.arguments().get<Instruction::MemoryIndexArgument>().memory_index.value() != 0)
+            return false;
+        auto pages = pop_slot();
+        emit_result({ OpCode::memory_grow, home(m_stack.size()), pages });
+        push();
+        return true;
+    }
+    case Instructions::memory_fill.value(): {
+        if (instruction.arguments().get<Instruction::MemoryIndexArgument>().memory_index.value() != 0)
+            return false;
+        auto count = pop_slot();
+        auto value = pop_slot();
+        auto destination = pop_slot();
+        emit({ OpCode::memory_fill, destination, value, count });
+        return true;
+    }
+    case Instructions::memory_copy.value(): {
+        auto& args = instruction.arguments().get<Instruction::MemoryCopyArgs>();
+        if (args.src_index.value() != 0 || args.dst_index.value() != 0)
+            return false;
+        auto count = pop_slot();
+        auto source = pop_slot();
+        auto destination = pop_slot();
+        emit({ OpCode::memory_copy, destination, source, count });
+        return true;
+    }
+
+#define __LOWER_UNARY_OPERATION(name, ...)                                     \
+    case Instructions::name.value(): {                                         \
+        auto operand = pop_slot();                                             \
+        emit_result({ OpCode::name, home(m_stack.size()), operand });          \
+        push();                                                                \
+        return true;                                                           \
+    }
+        ENUMERATE_LOWERED_UNARY_OPERATIONS(__LOWER_UNARY_OPERATION)
+#undef __LOWER_UNARY_OPERATION
+
+#define __LOWER_BINARY_OPERATION(name, ...)                                                                \
+    case Instructions::name.value(): {                                                                     \
+        auto rhs = pop();                                                                                  \
+        if (rhs.kind == Operand::Kind::Constant) {                                                         \
+            auto lhs = pop_slot();                                                                         \
+            emit_result({ OpCode::name##_immediate, home(m_stack.size()), lhs, 0, rhs.value });            \
+        } else {                                                                                           \
+            auto lhs = pop_slot();                                                                         \
+            emit_result({ OpCode::name, home(m_stack.size()), lhs, rhs.slot });                            \
+        }                                                                                                  \
+        push();                                                                                            \
+        return true;                                                                                       \
+    }
+        ENUMERATE_LOWERED_BINARY_OPERATIONS(__LOWER_BINARY_OPERATION)
+#undef __LOWER_BINARY_OPERATION
+
+#define __LOWER_LOAD_OPERATION(name, ...)                                                       \
+    case Instructions::name.value(): {                                                          \
+        auto& args = instruction.arguments().get<Instruction::MemoryArgument>();                \
+        if (args.memory_index.value() != 0)                                                     \
+            return false;                                                                       \
+        auto address = pop_slot();                                                              \
+        emit_result({ OpCode::name, home(m_stack.size()), address, 0, args.offset });           \
+        push();                                                                                 \
+        return true;                                                                            \
+    }
+        ENUMERATE_LOWERED_LOAD_OPERATIONS(__LOWER_LOAD_OPERATION)
+#undef __LOWER_LOAD_OPERATION
+
+#define __LOWER_STORE_OPERATION(name, ...)                                       \
+    case Instructions::name.value(): {                                           \
+        auto& args = instruction.arguments().get<Instruction::MemoryArgument>(); \
+        if (args.memory_index.value() != 0)                                      \
+            return false;                                                        \
+        auto value = pop_slot();                                                 \
+        auto address = pop_slot();                                               \
+        emit({ OpCode::name, 0, address, value, args.offset });                  \
+        return true;                                                             \
+    }
+        ENUMERATE_LOWERED_STORE_OPERATIONS(__LOWER_STORE_OPERATION)
+#undef __LOWER_STORE_OPERATION
+
+    default:
+        // Vectors, references, tables and the rest of the bulk memory instructions are left to the interpreter.
+        return false;
+    }
+}
+
+OwnPtr<LoweredFunction> LoweredFunction::try_lower(Context const& context, FunctionIndex index, FunctionType const& type, Module::Function const& function)
+{
+    if (!has_only_numbers(type) || !are_numbers(function.locals()))
+        return {};
+
+    auto lowered = adopt_own(*new LoweredFunction(index));
+    lowered->m_parameter_types = type.parameters();
+    lowered->m_result_types = type.results();
+    lowered->m_local_count = type.parameters().size() + function.locals().size();
+
+    FunctionLowerer lowerer { context, *lowered };
+    if (!lowerer.lower(function.body(), type.results().size()))
+        return {};
+    return lowered;
+}
+
+LoweredFunction::LoweredFunction(FunctionIndex index)
+    : m_index(index)
+{
+}
+
+LoweredFunction::~LoweredFunction() = default;
+
+JIT::NativeCode const* LoweredFunction::get_or_create_native_code() const
+{
+    if (m_native_code)
+        return m_native_code;
+
+    if (m_did_try_compiling || !JIT::Compiler::is_enabled())
+        return nullptr;
+
+    // OPTIMIZATION: Only spend time on native code generation for functions that have proven to be hot.
+    if (++m_call_count < JIT::Compiler::hot_function_threshold)
+        return nullptr;
+
+    m_did_try_compiling = true;
+    m_native_code = JIT::Compiler::compile(*this);
+    return m_native_code;
+}
+
+}
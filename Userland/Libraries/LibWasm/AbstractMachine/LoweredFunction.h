@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BitCast.h>
+#include <AK/Endian.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+namespace JIT {
+class NativeCode;
+}
+
+class Value;
+struct Context;
+
+// M(name, PopType, PushType, Operator), matching the way BytecodeInterpreter runs the instruction of the same name.
+#define ENUMERATE_LOWERED_UNARY_OPERATIONS(M)                          \
+    M(i32_eqz, i32, i32, EqualsZero)                                   \
+    M(i64_eqz, i64, i32, EqualsZero)                                   \
+    M(i32_clz, i32, i32, CountLeadingZeros)                            \
+    M(i32_ctz, i32, i32, CountTrailingZeros)                           \
+    M(i32_popcnt, i32, i32, PopCount)                                  \
+    M(i64_clz, i64, i64, CountLeadingZeros)                            \
+    M(i64_ctz, i64, i64, CountTrailingZeros)                           \
+    M(i64_popcnt, i64, i64, PopCount)                                  \
+    M(f32_abs, float, float, Absolute)                                 \
+    M(f32_neg, float, float, Negate)                                   \
+    M(f32_ceil, float, float, Ceil)                                    \
+    M(f32_floor, float, float, Floor)                                  \
+    M(f32_trunc, float, float, Truncate)                               \
+    M(f32_nearest, float, float, NearbyIntegral)                       \
+    M(f32_sqrt, float, float, SquareRoot)                              \
+    M(f64_abs, double, double, Absolute)                               \
+    M(f64_neg, double, double, Negate)                                 \
+    M(f64_ceil, double, double, Ceil)                                  \
+    M(f64_floor, double, double, Floor)                                \
+    M(f64_trunc, double, double, Truncate)                             \
+    M(f64_nearest, double, double, NearbyIntegral)                     \
+    M(f64_sqrt, double, double, SquareRoot)                            \
+    M(i32_wrap_i64, i64, i32, Wrap<i32>)                               \
+    M(i32_trunc_sf32, float, i32, CheckedTruncate<i32>)                \
+    M(i32_trunc_uf32, float, i32, CheckedTruncate<u32>)                \
+    M(i32_trunc_sf64, double, i32, CheckedTruncate<i32>)               \
+    M(i32_trunc_uf64, double, i32, CheckedTruncate<u32>)               \
+    M(i64_trunc_sf32, float, i64, CheckedTruncate<i64>)                \
+    M(i64_trunc_uf32, float, i64, CheckedTruncate<u64>)                \
+    M(i64_trunc_sf64, double, i64, CheckedTruncate<i64>)               \
+    M(i64_trunc_uf64, double, i64, CheckedTruncate<u64>)               \
+    M(i64_extend_si32, i32, i64, Extend<i64>)                          \
+    M(i64_extend_ui32, u32, i64, Extend<i64>)                          \
+    M(f32_convert_si32, i32, float, Convert<float>)                    \
+    M(f32_convert_ui32, u32, float, Convert<float>)                    \
+    M(f32_convert_si64, i64, float, Convert<float>)                    \
+    M(f32_convert_ui64, u64, float, Convert<float>)                    \
+    M(f32_demote_f64, double, float, Demote)                           \
+    M(f64_convert_si32, i32, double, Convert<double>)                  \
+    M(f64_convert_ui32, u32, double, Convert<double>)                  \
+    M(f64_convert_si64, i64, double, Convert<double>)                  \
+    M(f64_convert_ui64, u64, double, Convert<double>)                  \
+    M(f64_promote_f32, float, double, Promote)                         \
+    M(i32_reinterpret_f32, float, i32, Reinterpret<i32>)               \
+    M(i64_reinterpret_f64, double, i64, Reinterpret<i64>)              \
+    M(f32_reinterpret_i32, i32, float, Reinterpret<float>)             \
+    M(f64_reinterpret_i64, i64, double, Reinterpret<double>)           \
+    M(i32_extend8_s, i32, i32, SignExtend<i8>)                         \
+    M(i32_extend16_s, i32, i32, SignExtend<i16>)                       \
+    M(i64_extend8_s, i64, i64, SignExtend<i8>)                         \
+    M(i64_extend16_s, i64, i64, SignExtend<i16>)                       \
+    M(i64_extend32_s, i64, i64, SignExtend<i32>)                       \
+    M(i32_trunc_sat_f32_s, float, i32, SaturatingTruncate<i32>)        \
+    M(i32_trunc_sat_f32_u, float, i32, SaturatingTruncate<u32>)        \
+    M(i32_trunc_sat_f64_s, double, i32, SaturatingTruncate<i32>)       \
+    M(i32_trunc_sat_f64_u, double, i32, SaturatingTruncate<u32>)       \
+    M(i64_trunc_sat_f32_s, float, i64, SaturatingTruncate<i64>)        \
+    M(i64_trunc_sat_f32_u, float, i64, SaturatingTruncate<u64>)        \
+    M(i64_trunc_sat_f64_s, double, i64, SaturatingTruncate<i64>)       \
+    M(i64_trunc_sat_f64_u, double, i64, SaturatingTruncate<u64>)
+
+// M(name, PopType, PushType, Operator)
+#define ENUMERATE_LOWERED_BINARY_OPERATIONS(M)             \
+    M(i32_eq, i32, i32, Equals)                            \
+    M(i32_ne, i32, i32, NotEquals)                         \
+    M(i32_lts, i32, i32, LessThan)                         \
+    M(i32_ltu, u32, i32, LessThan)                         \
+    M(i32_gts, i32, i32, GreaterThan)                      \
+    M(i32_gtu, u32, i32, GreaterThan)                      \
+    M(i32_les, i32, i32, LessThanOrEquals)                 \
+    M(i32_leu, u32, i32, LessThanOrEquals)                 \
+    M(i32_ges, i32, i32, GreaterThanOrEquals)              \
+    M(i32_geu, u32, i32, GreaterThanOrEquals)              \
+    M(i64_eq, i64, i32, Equals)                            \
+    M(i64_ne, i64, i32, NotEquals)                         \
+    M(i64_lts, i64, i32, LessThan)                         \
+    M(i64_ltu, u64, i32, LessThan)                         \
+    M(i64_gts, i64, i32, GreaterThan)                      \
+    M(i64_gtu, u64, i32, GreaterThan)                      \
+    M(i64_les, i64, i32, LessThanOrEquals)                 \
+    M(i64_leu, u64, i32, LessThanOrEquals)                 \
+    M(i64_ges, i64, i32, GreaterThanOrEquals)              \
+    M(i64_geu, u64, i32, GreaterThanOrEquals)              \
+    M(f32_eq, float, i32, Equals)                          \
+    M(f32_ne, float, i32, NotEquals)                       \
+    M(f32_lt, float, i32, LessThan)                        \
+    M(f32_gt, float, i32, GreaterThan)                     \
+    M(f32_le, float, i32, LessThanOrEquals)                \
+    M(f32_ge, float, i32, GreaterThanOrEquals)             \
+    M(f64_eq, double, i32, Equals)                         \
+    M(f64_ne, double, i32, NotEquals)                      \
+    M(f64_lt, double, i32, LessThan)                       \
+    M(f64_gt, double, i32, GreaterThan)                    \
+    M(f64_le, double, i32, LessThanOrEquals)               \
+    M(f64_ge, double, i32, GreaterThanOrEquals)            \
+    M(i32_add, u32, i32, Add)                              \
+    M(i32_sub, u32, i32, Subtract)                         \
+    M(i32_mul, u32, i32, Multiply)                         \
+    M(i32_divs, i32, i32, Divide)                          \
+    M(i32_divu, u32, i32, Divide)                          \
+    M(i32_rems, i32, i32, Modulo)                          \
+    M(i32_remu, u32, i32, Modulo)                          \
+    M(i32_and, i32, i32, BitAnd)                           \
+    M(i32_or, i32, i32, BitOr)                             \
+    M(i32_xor, i32, i32, BitXor)                           \
+    M(i32_shl, u32, i32, BitShiftLeft)                     \
+    M(i32_shrs, i32, i32, BitShiftRight)                   \
+    M(i32_shru, u32, i32, BitShiftRight)                   \
+    M(i32_rotl, u32, i32, BitRotateLeft)                   \
+    M(i32_rotr, u32, i32, BitRotateRight)                  \
+    M(i64_add, u64, i64, Add)                              \
+    M(i64_sub, u64, i64, Subtract)                         \
+    M(i64_mul, u64, i64, Multiply)                         \
+    M(i64_divs, i64, i64, Divide)                          \
+    M(i64_divu, u64, i64, Divide)                          \
+    M(i64_rems, i64, i64, Modulo)                          \
+    M(i64_remu, u64, i64, Modulo)                          \
+    M(i64_and, i64, i64, BitAnd)                           \
+    M(i64_or, i64, i64, BitOr)                             \
+    M(i64_xor, i64, i64, BitXor)                           \
+    M(i64_shl, u64, i64, BitShiftLeft)                     \
+    M(i64_shrs, i64, i64, BitShiftRight)                   \
+    M(i64_shru, u64, i64, BitShiftRight)                   \
+    M(i64_rotl, u64, i64, BitRotateLeft)                   \
+    M(i64_rotr, u64, i64, BitRotateRight)                  \
+    M(f32_add, float, float, Add)                          \
+    M(f32_sub, float, float, Subtract)                     \
+    M(f32_mul, float, float, Multiply)                     \
+    M(f32_div, float, float, Divide)                       \
+    M(f32_min, float, float, Minimum)                      \
+    M(f32_max, float, float, Maximum)                      \
+    M(f32_copysign, float, float, CopySign)                \
+    M(f64_add, double, double, Add)                        \
+    M(f64_sub, double, double, Subtract)                   \
+    M(f64_mul, double, double, Multiply)                   \
+    M(f64_div, double, double, Divide)                     \
+    M(f64_min, double, double, Minimum)                    \
+    M(f64_max, double, double, Maximum)                    \
+    M(f64_copysign, double, double, CopySign)
+
+// M(name, ReadType, PushType)
+#define ENUMERATE_LOWERED_LOAD_OPERATIONS(M) \
+    M(i32_load, i32, i32)                    \
+    M(i64_load, i64, i64)                    \
+    M(f32_load, float, float)                \
+    M(f64_load, double, double)              \
+    M(i32_load8_s, i8, i32)                  \
+    M(i32_load8_u, u8, i32)                  \
+    M(i32_load16_s, i16, i32)                \
+    M(i32_load16_u, u16, i32)                \
+    M(i64_load8_s, i8, i64)                  \
+    M(i64_load8_u, u8, i64)                  \
+    M(i64_load16_s, i16, i64)                \
+    M(i64_load16_u, u16, i64)                \
+    M(i64_load32_s, i32, i64)                \
+    M(i64_load32_u, u32, i64)
+
+// M(name, PopType, StoreType)
+#define ENUMERATE_LOWERED_STORE_OPERATIONS(M) \
+    M(i32_store, i32, i32)                    \
+    M(i64_store, i64, i64)                    \
+    M(f32_store, float, float)                \
+    M(f64_store, double, double)              \
+    M(i32_store8, i32, i8)                    \
+    M(i32_store16, i32, i16)                  \
+    M(i64_store8, i64, i8)                    \
+    M(i64_store16, i64, i16)                  \
+    M(i64_store32, i64, i32)
+
+// M(name)
+#define ENUMERATE_LOWERED_CONTROL_OPERATIONS(M) \
+    M(copy)                                     \
+    M(constant)                                 \
+    M(unreachable)                              \
+    M(branch)                                   \
+    M(branch_if)                                \
+    M(branch_unless)                            \
+    M(branch_table)                             \
+    M(return_)                                  \
+    M(call)                                     \
+    M(call_indirect)                            \
+    M(select)                                   \
+    M(global_get)                               \
+    M(global_set)                               \
+    M(memory_size)                              \
+    M(memory_grow)                              \
+    M(memory_fill)                              \
+    M(memory_copy)
+
+// M(name, ...) for every lowered opcode, in the order of LoweredInstruction::OpCode.
+#define ENUMERATE_LOWERED_OPCODES(M, M_WITH_IMMEDIATE)   \
+    ENUMERATE_LOWERED_CONTROL_OPERATIONS(M)              \
+    ENUMERATE_LOWERED_UNARY_OPERATIONS(M)                \
+    ENUMERATE_LOWERED_BINARY_OPERATIONS(M)               \
+    ENUMERATE_LOWERED_BINARY_OPERATIONS(M_WITH_IMMEDIATE) \
+    ENUMERATE_LOWERED_LOAD_OPERATIONS(M)                 \
+    ENUMERATE_LOWERED_STORE_OPERATIONS(M)
+
+// An instruction of a lowered function. Operands name slots of the function's frame, see LoweredFunction.
+//
+// - copy: slots[destination] = slots[lhs]
+// - constant: slots[destination] = immediate
+// - branch: jumps to the instruction at index `immediate`
+// - branch_if, branch_unless: jump to `immediate` if slots[lhs] is (not) zero
+// - branch_table: jumps to branch_table()[immediate + min(slots[lhs], rhs)], the entry at index `rhs` is the default
+// - return_: returns, with the results already in the first slots of the frame
+// - call: calls function `immediate` with a frame that starts at slot `destination`, where its arguments are
+// - call_indirect: calls the function at index slots[lhs] of table `rhs`, which must have type `immediate`
+// - select: slots[destination] = slots[immediate] ? slots[lhs] : slots[rhs]
+// - global_get, global_set: slots[destination] = global `immediate`, and the other way around from slots[lhs]
+// - memory_*: take their arguments from destination, lhs and rhs, in the order the wasm instruction takes them
+// - unary operations: slots[destination] = op(slots[lhs])
+// - binary operations: slots[destination] = op(slots[lhs], slots[rhs]), or op(slots[lhs], immediate) for *_immediate
+// - loads: slots[destination] = memory[slots[lhs] + immediate]
+// - stores: memory[slots[lhs] + immediate] = slots[rhs]
+struct LoweredInstruction {
+    enum class OpCode : u32 {
+#define __ENUMERATE_OPCODE(name, ...) name,
+#define __ENUMERATE_OPCODE_WITH_IMMEDIATE(name, ...) name##_immediate,
+        ENUMERATE_LOWERED_OPCODES(__ENUMERATE_OPCODE, __ENUMERATE_OPCODE_WITH_IMMEDIATE)
+#undef __ENUMERATE_OPCODE
+#undef __ENUMERATE_OPCODE_WITH_IMMEDIATE
+        Count,
+    };
+
+    OpCode opcode;
+    u32 destination { 0 };
+    u32 lhs { 0 };
+    u32 rhs { 0 };
+    u64 immediate { 0 };
+};
+
+// A function body that was lowered from the stack machine of the wasm spec into a register machine when its module
+// was validated, so that it can run without the tagged entries of Wasm::Stack. Every value lives in a 64-bit slot of
+// the frame of the function, which looks like this:
+//
+//     [ parameters | locals | operand stack ]
+//
+// The validator already proved the height of the operand stack at every instruction, so instructions name the slots
+// they use directly, and all branches go to instruction indices.
+//
+// Only functions that use nothing but numbers, locals, globals, memory 0 and calls are lowered, others are still
+// interpreted from their Expression.
+class LoweredFunction {
+public:
+    static OwnPtr<LoweredFunction> try_lower(Context const&, FunctionIndex, FunctionType const&, Module::Function const&);
+
+    ~LoweredFunction();
+
+    FunctionIndex index() const { return m_index; }
+
+    auto& instructions() const { return m_instructions; }
+    auto& branch_table() const { return m_branch_table; }
+    auto& parameter_types() const { return m_parameter_types; }
+    auto& result_types() const { return m_result_types; }
+
+    // The number of slots that hold parameters and locals.
+    size_t local_count() const { return m_local_count; }
+    // The number of slots that a frame of the function needs.
+    size_t frame_size() const { return m_frame_size; }
+
+    // Compiles the function to native code once it has proven to be hot, if the JIT is enabled, see JIT::Compiler.
+    JIT::NativeCode const* get_or_create_native_code() const;
+
+private:
+    explicit LoweredFunction(FunctionIndex);
+
+    Vector<LoweredInstruction> m_instructions;
+    Vector<u32> m_branch_table;
+    Vector<ValueType> m_parameter_types;
+    Vector<ValueType> m_result_types;
+    size_t m_local_count { 0 };
+    size_t m_frame_size { 0 };
+    FunctionIndex m_index;
+
+    mutable OwnPtr<JIT::NativeCode> m_native_code;
+    mutable u32 m_call_count { 0 };
+    mutable bool m_did_try_compiling { false };
+
+    friend class FunctionLowerer;
+};
+
+// A slot holds 32-bit values zero-extended to 64 bits, and 64-bit values as they are.
+template<typename T>
+ALWAYS_INLINE T read_slot(u64 slot)
+{
+    static_assert(sizeof(T) == sizeof(u32) || sizeof(T) == sizeof(u64));
+    if constexpr (sizeof(T) == sizeof(u64))
+        return bit_cast<T>(slot);
+    else
+        return bit_cast<T>(static_cast<u32>(slot));
+}
+
+template<typename T>
+ALWAYS_INLINE u64 to_slot(T value)
+{
+    static_assert(sizeof(T) == sizeof(u32) || sizeof(T) == sizeof(u64));
+    if constexpr (sizeof(T) == sizeof(u64))
+        return bit_cast<u64>(value);
+    else
+        return bit_cast<u32>(value);
+}
+
+template<typename T>
+using RawMemoryType = Conditional<sizeof(T) == 1, u8, Conditional<sizeof(T) == 2, u16, Conditional<sizeof(T) == 4, u32, u64>>>;
+
+template<typename T>
+ALWAYS_INLINE T read_from_lowered_memory(u8 const* address)
+{
+    RawMemoryType<T> raw;
+    __builtin_memcpy(&raw, address, sizeof(raw));
+    return bit_cast<T>(AK::convert_between_host_and_little_endian(raw));
+}
+
+template<typename T>
+ALWAYS_INLINE void write_to_lowered_memory(u8* address, T value)
+{
+    auto raw = AK::convert_between_host_and_little_endian(bit_cast<RawMemoryType<T>>(value));
+    __builtin_memcpy(address, &raw, sizeof(raw));
+}
+
+template<typename PopType, typename PushType, typename Operator>
+ALWAYS_INLINE bool lowered_unary_operation(u64& destination, u64 operand, StringView& trap_reason)
+{
+    auto result = Operator {}(read_slot<PopType>(operand));
+    if constexpr (IsSpecializationOf<decltype(result), AK::ErrorOr>) {
+        if (result.is_error()) {
+            trap_reason = result.error();
+            return false;
+        }
+        destination = to_slot(static_cast<PushType>(result.release_value()));
+    } else {
+        destination = to_slot(static_cast<PushType>(result));
+    }
+    return true;
+}
+
+template<typename PopType, typename PushType, typename Operator>
+ALWAYS_INLINE bool lowered_binary_operation(u64& destination, u64 lhs, u64 rhs, StringView& trap_reason)
+{
+    auto result = Operator {}(read_slot<PopType>(lhs), read_slot<PopType>(rhs));
+    if constexpr (IsSpecializationOf<decltype(result), AK::ErrorOr>) {
+        if (result.is_error()) {
+            trap_reason = result.error();
+            return false;
+        }
+        destination = to_slot(static_cast<PushType>(result.release_value()));
+    } else {
+        destination = to_slot(static_cast<PushType>(result));
+    }
+    return true;
+}
+
+u64 value_to_slot(Value const&);
+Value slot_to_value(ValueType const&, u64 slot);
+
+}
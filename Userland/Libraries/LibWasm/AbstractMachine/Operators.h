@@ -8,10 +8,14 @@
 
 #include <AK/BitCast.h>
 #include <AK/BuiltinWrappers.h>
+#include <AK/NumericLimits.h>
 #include <AK/Result.h>
 #include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/StdLibExtras.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
+#include <LibWasm/Types.h>
 #include <limits.h>
 #include <math.h>
 
@@ -124,206 +128,6 @@ struct BitRotateRight {
     static StringView name() { return "rotate_right"sv; }
 };
 
-template<size_t VectorSize>
-struct VectorShiftLeft {
-    auto operator()(u128 lhs, i32 rhs) const
-    {
-        auto shift_value = rhs % (sizeof(lhs) * 8 / VectorSize);
-        return bit_cast<u128>(bit_cast<Native128ByteVectorOf<NativeIntegralType<128 / VectorSize>, MakeUnsigned>>(lhs) << shift_value);
-    }
-    static StringView name()
-    {
-        switch (VectorSize) {
-        case 16:
-            return "vec(8x16)<<"sv;
-        case 8:
-            return "vec(16x8)<<"sv;
-        case 4:
-            return "vec(32x4)<<"sv;
-        case 2:
-            return "vec(64x2)<<"sv;
-        default:
-            VERIFY_NOT_REACHED();
-        }
-    }
-};
-
-template<size_t VectorSize, template<typename> typename SetSign>
-struct VectorShiftRight {
-    auto operator()(u128 lhs, i32 rhs) const
-    {
-        auto shift_value = rhs % (sizeof(lhs) * 8 / VectorSize);
-        return bit_cast<u128>(bit_cast<Native128ByteVectorOf<NativeIntegralType<128 / VectorSize>, SetSign>>(lhs) >> shift_value);
-    }
-    static StringView name()
-    {
-        switch (VectorSize) {
-        case 16:
-            return "vec(8x16)>>"sv;
-        case 8:
-            return "vec(16x8)>>"sv;
-        case 4:
-            return "vec(32x4)>>"sv;
-        case 2:
-            return "vec(64x2)>>"sv;
-        default:
-            VERIFY_NOT_REACHED();
-        }
-    }
-};
-
-struct VectorSwizzle {
-    auto operator()(u128 c1, u128 c2) const
-    {
-        // https://webassembly.github.io/spec/core/bikeshed/#-mathsfi8x16hrefsyntax-instr-vecmathsfswizzle%E2%91%A0
-        auto i = bit_cast<Native128ByteVectorOf<i8, MakeSigned>>(c2);
-        auto j = bit_cast<Native128ByteVectorOf<i8, MakeSigned>>(c1);
-        auto result = AK::SIMD::shuffle(i, j);
-        return bit_cast<u128>(result);
-    }
-    static StringView name() { return "vec(8x16).swizzle"sv; }
-};
-
-template<size_t VectorSize, template<typename> typename SetSign>
-struct VectorExtractLane {
-    size_t lane;
-
-    auto operator()(u128 c) const
-    {
-        auto result = bit_cast<Native128ByteVectorOf<NativeIntegralType<128 / VectorSize>, SetSign>>(c);
-        return result[lane];
-    }
-
-    static StringView name()
-    {
-        switch (VectorSize) {
-        case 16:
-            return "vec(8x16).extract_lane"sv;
-        case 8:
-            return "vec(16x8).extract_lane"sv;
-        case 4:
-            return "vec(32x4).extract_lane"sv;
-        case 2:
-            return "vec(64x2).extract_lane"sv;
-        default:
-            VERIFY_NOT_REACHED();
-        }
-    }
-};
-
-template<size_t VectorSize>
-struct VectorExtractLaneFloat {
-    size_t lane;
-
-    auto operator()(u128 c) const
-    {
-        auto result = bit_cast<NativeFloatingVectorType<128 / VectorSize, VectorSize>>(c);
-        return result[lane];
-    }
-
-    static StringView name()
-    {
-        switch (VectorSize) {
-        case 16:
-            return "vec(8x16).extract_lane"sv;
-        case 8:
-            return "vec(16x8).extract_lane"sv;
-        case 4:
-            return "vec(32x4).extract_lane"sv;
-        case 2:
-            return "vec(64x2).extract_lane"sv;
-        default:
-            VERIFY_NOT_REACHED();
-        }
-    }
-};
-
-template<size_t VectorSize, typename TrueValueType = NativeIntegralType<128 / VectorSize>>
-struct VectorReplaceLane {
-    size_t lane;
-    using ValueType = Conditional<IsFloatingPoint<TrueValueType>, NativeFloatingType<128 / VectorSize>, NativeIntegralType<128 / VectorSize>>;
-
-    auto operator()(u128 c, TrueValueType value) const
-    {
-        auto result = bit_cast<Native128ByteVectorOf<ValueType, MakeUnsigned>>(c);
-        result[lane] = static_cast<ValueType>(value);
-        return bit_cast<u128>(result);
-    }
-
-    static StringView name()
-    {
-        switch (VectorSize) {
-        case 16:
-            return "vec(8x16).replace_lane"sv;
-        case 8:
-            return "vec(16x8).replace_lane"sv;
-        case 4:
-            return "vec(32x4).replace_lane"sv;
-        case 2:
-            return "vec(64x2).replace_lane"sv;
-        default:
-            VERIFY_NOT_REACHED();
-        }
-    }
-};
-
-template<size_t VectorSize, typename Op, template<typename> typename SetSign = MakeSigned>
-struct VectorCmpOp {
-    auto operator()(u128 c1, u128 c2) const
-    {
-        using ElementType = NativeIntegralType<128 / VectorSize>;
-        auto result = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c1);
-        auto other = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c2);
-        Op op;
-        for (size_t i = 0; i < VectorSize; ++i)
-            result[i] = op(result[i], other[i]) ? static_cast<MakeUnsigned<ElementType>>(-1) : 0;
-        return bit_cast<u128>(result);
-    }
-
-    static StringView name()
-    {
-        switch (VectorSize) {
-        case 16:
-            return "vec(8x16).cmp"sv;
-        case 8:
-            return "vec(16x8).cmp"sv;
-        case 4:
-            return "vec(32x4).cmp"sv;
-        case 2:
-            return "vec(64x2).cmp"sv;
-        default:
-            VERIFY_NOT_REACHED();
-        }
-    }
-};
-
-template<size_t VectorSize, typename Op>
-struct VectorFloatCmpOp {
-    auto operator()(u128 c1, u128 c2) const
-    {
-        auto first = bit_cast<NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>>(c1);
-        auto other = bit_cast<NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>>(c2);
-        using ElementType = NativeIntegralType<128 / VectorSize>;
-        Native128ByteVectorOf<ElementType, MakeUnsigned> result;
-        Op op;
-        for (size_t i = 0; i < VectorSize; ++i)
-            result[i] = op(first[i], other[i]) ? static_cast<ElementType>(-1) : 0;
-        return bit_cast<u128>(result);
-    }
-
-    static StringView name()
-    {
-        switch (VectorSize) {
-        case 4:
-            return "vecf(32x4).cmp"sv;
-        case 2:
-            return "vecf(64x2).cmp"sv;
-        default:
-            VERIFY_NOT_REACHED();
-        }
-    }
-};
-
 struct Minimum {
     template<typename Lhs, typename Rhs>
     auto operator()(Lhs lhs, Rhs rhs) const
@@ -674,4 +478,717 @@ struct SaturatingTruncate {
     static StringView name() { return "truncate.saturating"sv; }
 };
 
+// v128 operators.
+// These work on whole native vectors, so that the compiler can lower them to the target's vector instructions.
+// Where the baseline instruction set has a better fitting instruction than what the compiler picks on its own, it is
+// used directly.
+
+template<size_t VectorSize, template<typename> typename SetSign = MakeUnsigned>
+using NativeIntegralVector = Native128ByteVectorOf<NativeIntegralType<128 / VectorSize>, SetSign>;
+
+template<size_t VectorSize>
+using NativeFloatingVector = NativeFloatingVectorType<128 / VectorSize, VectorSize>;
+
+template<typename VectorType>
+using VectorElementType = RemoveCVReference<decltype(declval<VectorType>()[0])>;
+
+template<typename VectorType>
+constexpr size_t vector_length = sizeof(VectorType) / sizeof(VectorElementType<VectorType>);
+
+enum class VectorHalf {
+    Low,
+    High,
+};
+
+// Widens the low or high half of the lanes in `value` to lanes of twice the width.
+template<size_t VectorSize, VectorHalf half, template<typename> typename SetSign>
+auto extend_half(u128 value)
+{
+    using HalfVector = NativeVectorType<64 / VectorSize, VectorSize, SetSign>;
+    using ResultVector = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+    auto halves = bit_cast<u64x2>(value);
+    return __builtin_convertvector(bit_cast<HalfVector>(halves[half == VectorHalf::High ? 1 : 0]), ResultVector);
+}
+
+template<size_t VectorSize>
+struct VectorShiftLeft {
+    auto operator()(u128 lhs, i32 rhs) const
+    {
+        auto shift_value = static_cast<u32>(rhs) % (sizeof(lhs) * 8 / VectorSize);
+        return bit_cast<u128>(bit_cast<NativeIntegralVector<VectorSize, MakeUnsigned>>(lhs) << shift_value);
+    }
+    static StringView name()
+    {
+        switch (VectorSize) {
+        case 16:
+            return "vec(8x16)<<"sv;
+        case 8:
+            return "vec(16x8)<<"sv;
+        case 4:
+            return "vec(32x4)<<"sv;
+        case 2:
+            return "vec(64x2)<<"sv;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+};
+
+template<size_t VectorSize, template<typename> typename SetSign>
+struct VectorShiftRight {
+    auto operator()(u128 lhs, i32 rhs) const
+    {
+        auto shift_value = static_cast<u32>(rhs) % (sizeof(lhs) * 8 / VectorSize);
+        return bit_cast<u128>(bit_cast<NativeIntegralVector<VectorSize, SetSign>>(lhs) >> shift_value);
+    }
+    static StringView name()
+    {
+        switch (VectorSize) {
+        case 16:
+            return "vec(8x16)>>"sv;
+        case 8:
+            return "vec(16x8)>>"sv;
+        case 4:
+            return "vec(32x4)>>"sv;
+        case 2:
+            return "vec(64x2)>>"sv;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+};
+
+struct VectorSwizzle {
+    auto operator()(u128 c1, u128 c2) const
+    {
+        // https://webassembly.github.io/spec/core/bikeshed/#-mathsfi8x16hrefsyntax-instr-vecmathsfswizzle%E2%91%A0
+        return bit_cast<u128>(AK::SIMD::shuffle_or_0(bit_cast<u8x16>(c1), bit_cast<u8x16>(c2)));
+    }
+    static StringView name() { return "vec(8x16).swizzle"sv; }
+};
+
+struct VectorShuffle {
+    u8x16 lanes;
+
+    auto operator()(u128 c1, u128 c2) const
+    {
+        // Lanes 0-15 select from c1, lanes 16-31 from c2. Each shuffle zeroes the lanes that select from the other.
+        auto from_first = AK::SIMD::shuffle_or_0(bit_cast<u8x16>(c1), lanes);
+        auto from_second = AK::SIMD::shuffle_or_0(bit_cast<u8x16>(c2), lanes - 16);
+        return bit_cast<u128>(from_first | from_second);
+    }
+    static StringView name() { return "vec(8x16).shuffle"sv; }
+};
+
+template<size_t VectorSize, template<typename> typename SetSign>
+struct VectorExtractLane {
+    size_t lane;
+
+    auto operator()(u128 c) const
+    {
+        auto result = bit_cast<NativeIntegralVector<VectorSize, SetSign>>(c);
+        return result[lane];
+    }
+
+    static StringView name()
+    {
+        switch (VectorSize) {
+        case 16:
+            return "vec(8x16).extract_lane"sv;
+        case 8:
+            return "vec(16x8).extract_lane"sv;
+        case 4:
+            return "vec(32x4).extract_lane"sv;
+        case 2:
+            return "vec(64x2).extract_lane"sv;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+};
+
+template<size_t VectorSize>
+struct VectorExtractLaneFloat {
+    size_t lane;
+
+    auto operator()(u128 c) const
+    {
+        auto result = bit_cast<NativeFloatingVector<VectorSize>>(c);
+        return result[lane];
+    }
+
+    static StringView name()
+    {
+        switch (VectorSize) {
+        case 16:
+            return "vec(8x16).extract_lane"sv;
+        case 8:
+            return "vec(16x8).extract_lane"sv;
+        case 4:
+            return "vec(32x4).extract_lane"sv;
+        case 2:
+            return "vec(64x2).extract_lane"sv;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+};
+
+template<size_t VectorSize, typename TrueValueType = NativeIntegralType<128 / VectorSize>>
+struct VectorReplaceLane {
+    size_t lane;
+    using ValueType = Conditional<IsFloatingPoint<TrueValueType>, NativeFloatingType<128 / VectorSize>, NativeIntegralType<128 / VectorSize>>;
+
+    auto operator()(u128 c, TrueValueType value) const
+    {
+        auto result = bit_cast<Native128ByteVectorOf<ValueType, MakeUnsigned>>(c);
+        result[lane] = static_cast<ValueType>(value);
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name()
+    {
+        switch (VectorSize) {
+        case 16:
+            return "vec(8x16).replace_lane"sv;
+        case 8:
+            return "vec(16x8).replace_lane"sv;
+        case 4:
+            return "vec(32x4).replace_lane"sv;
+        case 2:
+            return "vec(64x2).replace_lane"sv;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+};
+
+// Applies `Op` to vectors of `VectorSize` integer lanes. The sign only matters for comparisons, shifts and min/max,
+// all arithmetic is done on unsigned lanes, which wrap around like wasm wants them to.
+template<size_t VectorSize, typename Op, template<typename> typename SetSign = MakeUnsigned>
+struct VectorIntegerBinaryOp {
+    auto operator()(u128 lhs, u128 rhs) const
+    {
+        using VectorType = NativeIntegralVector<VectorSize, SetSign>;
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(lhs), bit_cast<VectorType>(rhs)));
+    }
+
+    static StringView name() { return Op::name(); }
+};
+
+template<size_t VectorSize, typename Op, template<typename> typename SetSign = MakeUnsigned>
+struct VectorIntegerUnaryOp {
+    auto operator()(u128 value) const
+    {
+        using VectorType = NativeIntegralVector<VectorSize, SetSign>;
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(value)));
+    }
+
+    static StringView name() { return Op::name(); }
+};
+
+template<size_t VectorSize, typename Op>
+struct VectorFloatBinaryOp {
+    auto operator()(u128 lhs, u128 rhs) const
+    {
+        using VectorType = NativeFloatingVector<VectorSize>;
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(lhs), bit_cast<VectorType>(rhs)));
+    }
+
+    static StringView name() { return Op::name(); }
+};
+
+template<size_t VectorSize, typename Op>
+struct VectorFloatUnaryOp {
+    auto operator()(u128 value) const
+    {
+        using VectorType = NativeFloatingVector<VectorSize>;
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(value)));
+    }
+
+    static StringView name() { return Op::name(); }
+};
+
+// Comparisons of native vectors already produce the all-ones or all-zeroes lanes that wasm wants.
+template<size_t VectorSize, typename Op, template<typename> typename SetSign = MakeSigned>
+using VectorCmpOp = VectorIntegerBinaryOp<VectorSize, Op, SetSign>;
+
+template<size_t VectorSize, typename Op>
+using VectorFloatCmpOp = VectorFloatBinaryOp<VectorSize, Op>;
+
+// Applies a scalar operator to each lane, for operations that have no vector counterpart on the target.
+template<typename Op>
+struct Lanewise {
+    template<typename VectorType>
+    VectorType operator()(VectorType value) const
+    {
+        Op op;
+        for (size_t i = 0; i < vector_length<VectorType>; ++i) {
+            auto result = op(value[i]);
+            if constexpr (IsSpecializationOf<decltype(result), AK::ErrorOr>)
+                value[i] = result.release_value();
+            else
+                value[i] = result;
+        }
+        return value;
+    }
+
+    static StringView name() { return Op::name(); }
+};
+
+struct BitNot {
+    template<typename Lhs>
+    auto operator()(Lhs lhs) const { return ~lhs; }
+
+    static StringView name() { return "~"sv; }
+};
+
+struct BitAndNot {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs & ~rhs; }
+
+    static StringView name() { return "&~"sv; }
+};
+
+struct VectorDivide {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const { return lhs / rhs; }
+
+    static StringView name() { return "/"sv; }
+};
+
+struct VectorMinimum {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const
+    {
+        if constexpr (IsFloatingPoint<VectorElementType<VectorType>>) {
+            // NaNs propagate, and -0 is less than +0; OR-ing equal lanes keeps the sign of the negative zero.
+            using MaskType = decltype(lhs < rhs);
+            auto minimum = lhs < rhs ? lhs : rhs;
+            auto either_sign = bit_cast<VectorType>(bit_cast<MaskType>(lhs) | bit_cast<MaskType>(rhs));
+            auto result = lhs == rhs ? either_sign : minimum;
+            return (lhs != lhs) | (rhs != rhs) ? lhs + rhs : result;
+        } else {
+            return lhs < rhs ? lhs : rhs;
+        }
+    }
+
+    static StringView name() { return "minimum"sv; }
+};
+
+struct VectorMaximum {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const
+    {
+        if constexpr (IsFloatingPoint<VectorElementType<VectorType>>) {
+            // NaNs propagate, and +0 is greater than -0; AND-ing equal lanes drops the sign of the negative zero.
+            using MaskType = decltype(lhs < rhs);
+            auto maximum = lhs > rhs ? lhs : rhs;
+            auto both_signs = bit_cast<VectorType>(bit_cast<MaskType>(lhs) & bit_cast<MaskType>(rhs));
+            auto result = lhs == rhs ? both_signs : maximum;
+            return (lhs != lhs) | (rhs != rhs) ? lhs + rhs : result;
+        } else {
+            return lhs > rhs ? lhs : rhs;
+        }
+    }
+
+    static StringView name() { return "maximum"sv; }
+};
+
+struct PseudoMinimum {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const { return rhs < lhs ? rhs : lhs; }
+
+    static StringView name() { return "pmin"sv; }
+};
+
+struct PseudoMaximum {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const { return lhs < rhs ? rhs : lhs; }
+
+    static StringView name() { return "pmax"sv; }
+};
+
+struct SaturatingAdd {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const
+    {
+        using ElementType = VectorElementType<VectorType>;
+#if ARCH(X86_64)
+        if constexpr (IsSame<ElementType, i8>)
+            return bit_cast<VectorType>(__builtin_ia32_paddsb128(bit_cast<c8x16>(lhs), bit_cast<c8x16>(rhs)));
+        else if constexpr (IsSame<ElementType, u8>)
+            return bit_cast<VectorType>(__builtin_ia32_paddusb128(bit_cast<c8x16>(lhs), bit_cast<c8x16>(rhs)));
+        else if constexpr (IsSame<ElementType, i16>)
+            return bit_cast<VectorType>(__builtin_ia32_paddsw128(bit_cast<i16x8>(lhs), bit_cast<i16x8>(rhs)));
+        else if constexpr (IsSame<ElementType, u16>)
+            return bit_cast<VectorType>(__builtin_ia32_paddusw128(bit_cast<i16x8>(lhs), bit_cast<i16x8>(rhs)));
+#endif
+        using UnsignedVector = Native128ByteVectorOf<ElementType, MakeUnsigned>;
+        auto sum = bit_cast<VectorType>(bit_cast<UnsignedVector>(lhs) + bit_cast<UnsignedVector>(rhs));
+        if constexpr (IsSigned<ElementType>) {
+            // Overflow happened if both operands have the same sign, and the sum has a different one.
+            auto overflowed = ((lhs ^ sum) & (rhs ^ sum)) < 0;
+            auto saturated = (lhs >> (sizeof(ElementType) * 8 - 1)) ^ NumericLimits<ElementType>::max();
+            return overflowed ? saturated : sum;
+        } else {
+            return sum | bit_cast<VectorType>(sum < lhs);
+        }
+    }
+
+    static StringView name() { return "+sat"sv; }
+};
+
+struct SaturatingSubtract {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const
+    {
+        using ElementType = VectorElementType<VectorType>;
+#if ARCH(X86_64)
+        if constexpr (IsSame<ElementType, i8>)
+            return bit_cast<VectorType>(__builtin_ia32_psubsb128(bit_cast<c8x16>(lhs), bit_cast<c8x16>(rhs)));
+        else if constexpr (IsSame<ElementType, u8>)
+            return bit_cast<VectorType>(__builtin_ia32_psubusb128(bit_cast<c8x16>(lhs), bit_cast<c8x16>(rhs)));
+        else if constexpr (IsSame<ElementType, i16>)
+            return bit_cast<VectorType>(__builtin_ia32_psubsw128(bit_cast<i16x8>(lhs), bit_cast<i16x8>(rhs)));
+        else if constexpr (IsSame<ElementType, u16>)
+            return bit_cast<VectorType>(__builtin_ia32_psubusw128(bit_cast<i16x8>(lhs), bit_cast<i16x8>(rhs)));
+#endif
+        using UnsignedVector = Native128ByteVectorOf<ElementType, MakeUnsigned>;
+        auto difference = bit_cast<VectorType>(bit_cast<UnsignedVector>(lhs) - bit_cast<UnsignedVector>(rhs));
+        if constexpr (IsSigned<ElementType>) {
+            // Overflow happened if the operands have different signs, and the difference has a different one than lhs.
+            auto overflowed = ((lhs ^ rhs) & (lhs ^ difference)) < 0;
+            auto saturated = (lhs >> (sizeof(ElementType) * 8 - 1)) ^ NumericLimits<ElementType>::max();
+            return overflowed ? saturated : difference;
+        } else {
+            return difference & bit_cast<VectorType>(rhs <= lhs);
+        }
+    }
+
+    static StringView name() { return "-sat"sv; }
+};
+
+struct RoundingAverage {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const
+    {
+        using ElementType = VectorElementType<VectorType>;
+        static_assert(IsUnsigned<ElementType>);
+#if ARCH(X86_64)
+        if constexpr (IsSame<ElementType, u8>)
+            return bit_cast<VectorType>(__builtin_ia32_pavgb128(bit_cast<c8x16>(lhs), bit_cast<c8x16>(rhs)));
+        else if constexpr (IsSame<ElementType, u16>)
+            return bit_cast<VectorType>(__builtin_ia32_pavgw128(bit_cast<i16x8>(lhs), bit_cast<i16x8>(rhs)));
+#endif
+        // (lhs + rhs + 1) / 2, without overflowing the lanes.
+        return (lhs | rhs) - ((lhs ^ rhs) >> 1);
+    }
+
+    static StringView name() { return "avgr"sv; }
+};
+
+struct VectorAbsolute {
+    template<typename VectorType>
+    VectorType operator()(VectorType value) const
+    {
+        using ElementType = VectorElementType<VectorType>;
+        if constexpr (IsFloatingPoint<ElementType>) {
+            using MaskType = decltype(value < value);
+            return bit_cast<VectorType>(bit_cast<MaskType>(value) & NumericLimits<VectorElementType<MaskType>>::max());
+        } else {
+            static_assert(IsUnsigned<ElementType>);
+            auto sign = VectorType {} - (value >> (sizeof(ElementType) * 8 - 1));
+            return (value ^ sign) - sign;
+        }
+    }
+
+    static StringView name() { return "abs"sv; }
+};
+
+struct VectorNegate {
+    template<typename VectorType>
+    VectorType operator()(VectorType value) const
+    {
+        using ElementType = VectorElementType<VectorType>;
+        if constexpr (IsFloatingPoint<ElementType>) {
+            using MaskType = decltype(value < value);
+            return bit_cast<VectorType>(bit_cast<MaskType>(value) ^ NumericLimits<VectorElementType<MaskType>>::min());
+        } else {
+            static_assert(IsUnsigned<ElementType>);
+            return VectorType {} - value;
+        }
+    }
+
+    static StringView name() { return "neg"sv; }
+};
+
+struct VectorPopCount {
+    template<typename VectorType>
+    VectorType operator()(VectorType value) const
+    {
+        static_assert(IsSame<VectorElementType<VectorType>, u8>);
+        value = value - ((value >> 1) & 0x55);
+        value = (value & 0x33) + ((value >> 2) & 0x33);
+        return (value + (value >> 4)) & 0x0f;
+    }
+
+    static StringView name() { return "popcnt"sv; }
+};
+
+struct VectorSquareRoot {
+    template<typename VectorType>
+    VectorType operator()(VectorType value) const
+    {
+#if ARCH(X86_64)
+        if constexpr (IsSame<VectorType, f32x4>)
+            return __builtin_ia32_sqrtps(value);
+        else
+            return __builtin_ia32_sqrtpd(value);
+#else
+        return Lanewise<SquareRoot> {}(value);
+#endif
+    }
+
+    static StringView name() { return "sqrt"sv; }
+};
+
+// SSE4.1 can round whole vectors, baseline x86-64 and other targets round lane by lane.
+template<typename ScalarOp, int sse4_1_rounding_mode>
+struct VectorRound {
+    template<typename VectorType>
+    VectorType operator()(VectorType value) const
+    {
+#if defined(__SSE4_1__)
+        if constexpr (IsSame<VectorType, f32x4>)
+            return __builtin_ia32_roundps(value, sse4_1_rounding_mode);
+        else
+            return __builtin_ia32_roundpd(value, sse4_1_rounding_mode);
+#else
+        return Lanewise<ScalarOp> {}(value);
+#endif
+    }
+
+    static StringView name() { return ScalarOp::name(); }
+};
+
+// These are _MM_FROUND_NO_EXC combined with the rounding direction.
+using VectorNearbyIntegral = VectorRound<NearbyIntegral, 0x08>;
+using VectorFloor = VectorRound<Floor, 0x09>;
+using VectorCeil = VectorRound<Ceil, 0x0a>;
+using VectorTruncate = VectorRound<Truncate, 0x0b>;
+
+struct VectorAnyTrue {
+    i32 operator()(u128 value) const { return value != 0; }
+
+    static StringView name() { return "any_true"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorAllTrue {
+    i32 operator()(u128 value) const
+    {
+        auto zero_lanes = bit_cast<NativeIntegralVector<VectorSize>>(value) == 0;
+        return bit_cast<u128>(zero_lanes) == 0;
+    }
+
+    static StringView name() { return "all_true"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorBitmask {
+    i32 operator()(u128 value) const
+    {
+#if ARCH(X86_64)
+        if constexpr (VectorSize == 16)
+            return __builtin_ia32_pmovmskb128(bit_cast<c8x16>(value));
+        else if constexpr (VectorSize == 8)
+            return __builtin_ia32_pmovmskb128(__builtin_ia32_packsswb128(bit_cast<i16x8>(value), i16x8 {})) & 0xff;
+        else if constexpr (VectorSize == 4)
+            return __builtin_ia32_movmskps(bit_cast<f32x4>(value));
+        else
+            return __builtin_ia32_movmskpd(bit_cast<f64x2>(value));
+#else
+        auto negative_lanes = bit_cast<NativeIntegralVector<VectorSize, MakeSigned>>(value) < 0;
+        i32 result = 0;
+        for (size_t i = 0; i < VectorSize; ++i)
+            result |= (negative_lanes[i] & 1) << i;
+        return result;
+#endif
+    }
+
+    static StringView name() { return "bitmask"sv; }
+};
+
+// Narrows the signed lanes of both operands to lanes of half the width, saturating them to the range of SetSign.
+template<size_t VectorSize, template<typename> typename SetSign>
+struct VectorNarrow {
+    auto operator()(u128 lhs, u128 rhs) const
+    {
+        using SourceVector = NativeVectorType<256 / VectorSize, VectorSize / 2, MakeSigned>;
+        using HalfVector = NativeVectorType<128 / VectorSize, VectorSize / 2, SetSign>;
+        using ResultElement = SetSign<NativeIntegralType<128 / VectorSize>>;
+#if ARCH(X86_64)
+        if constexpr (VectorSize == 16 && IsSigned<ResultElement>)
+            return bit_cast<u128>(__builtin_ia32_packsswb128(bit_cast<SourceVector>(lhs), bit_cast<SourceVector>(rhs)));
+        else if constexpr (VectorSize == 16)
+            return bit_cast<u128>(__builtin_ia32_packuswb128(bit_cast<SourceVector>(lhs), bit_cast<SourceVector>(rhs)));
+        else if constexpr (VectorSize == 8 && IsSigned<ResultElement>)
+            return bit_cast<u128>(__builtin_ia32_packssdw128(bit_cast<SourceVector>(lhs), bit_cast<SourceVector>(rhs)));
+#endif
+        auto narrow = [](SourceVector value) {
+            auto minimum = SourceVector {} + NumericLimits<ResultElement>::min();
+            auto maximum = SourceVector {} + NumericLimits<ResultElement>::max();
+            value = value < minimum ? minimum : value;
+            value = value > maximum ? maximum : value;
+            return bit_cast<u64>(__builtin_convertvector(value, HalfVector));
+        };
+        return bit_cast<u128>(u64x2 { narrow(bit_cast<SourceVector>(lhs)), narrow(bit_cast<SourceVector>(rhs)) });
+    }
+
+    static StringView name() { return "narrow"sv; }
+};
+
+template<size_t VectorSize, VectorHalf half, template<typename> typename SetSign>
+struct VectorExtend {
+    auto operator()(u128 value) const
+    {
+        return bit_cast<u128>(extend_half<VectorSize, half, SetSign>(value));
+    }
+
+    static StringView name() { return "extend"sv; }
+};
+
+template<size_t VectorSize, VectorHalf half, template<typename> typename SetSign>
+struct VectorExtendMultiply {
+    auto operator()(u128 lhs, u128 rhs) const
+    {
+        // The products of the widened lanes can't overflow.
+        return bit_cast<u128>(extend_half<VectorSize, half, SetSign>(lhs) * extend_half<VectorSize, half, SetSign>(rhs));
+    }
+
+    static StringView name() { return "extmul"sv; }
+};
+
+template<size_t VectorSize, template<typename> typename SetSign>
+struct VectorExtendAddPairwise {
+    auto operator()(u128 value) const
+    {
+        // Every wide lane holds one even and one odd narrow lane, split them with shifts instead of shuffling.
+        using WideVector = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+        constexpr auto narrow_bits = 64 / VectorSize;
+        auto wide = bit_cast<WideVector>(value);
+        auto even = (wide << narrow_bits) >> narrow_bits;
+        auto odd = wide >> narrow_bits;
+        return bit_cast<u128>(even + odd);
+    }
+
+    static StringView name() { return "extadd_pairwise"sv; }
+};
+
+struct VectorDot {
+    auto operator()(u128 lhs, u128 rhs) const
+    {
+#if ARCH(X86_64)
+        return bit_cast<u128>(__builtin_ia32_pmaddwd128(bit_cast<i16x8>(lhs), bit_cast<i16x8>(rhs)));
+#else
+        auto wide_lhs = bit_cast<i32x4>(lhs);
+        auto wide_rhs = bit_cast<i32x4>(rhs);
+        auto even = ((wide_lhs << 16) >> 16) * ((wide_rhs << 16) >> 16);
+        auto odd = (wide_lhs >> 16) * (wide_rhs >> 16);
+        // Only -32768 * -32768 twice overflows, which wraps around.
+        return bit_cast<u128>(bit_cast<u32x4>(even) + bit_cast<u32x4>(odd));
+#endif
+    }
+
+    static StringView name() { return "dot"sv; }
+};
+
+struct VectorQ15MultiplyRoundSaturate {
+    auto operator()(u128 lhs, u128 rhs) const
+    {
+#if defined(__SSSE3__)
+        // pmulhrsw wraps -32768 * -32768 around to -32768 instead of saturating it.
+        auto result = __builtin_ia32_pmulhrsw128(bit_cast<i16x8>(lhs), bit_cast<i16x8>(rhs));
+        return bit_cast<u128>(result ^ (result == NumericLimits<i16>::min()));
+#else
+        auto multiply = [&]<VectorHalf half>() {
+            auto product = (extend_half<4, half, MakeSigned>(lhs) * extend_half<4, half, MakeSigned>(rhs) + 0x4000) >> 15;
+            auto maximum = i32x4 {} + NumericLimits<i16>::max();
+            return bit_cast<u64>(__builtin_convertvector(product > maximum ? maximum : product, i16x4));
+        };
+        return bit_cast<u128>(u64x2 { multiply.operator()<VectorHalf::Low>(), multiply.operator()<VectorHalf::High>() });
+#endif
+    }
+
+    static StringView name() { return "q15mulr_sat"sv; }
+};
+
+// Truncates the float lanes to integers, saturating them to the range of ResultType.
+// If there are fewer result lanes than fit into a vector, the remaining ones are zeroed.
+template<typename ResultType, size_t VectorSize>
+struct VectorSaturatingTruncate {
+    auto operator()(u128 value) const
+    {
+        using SourceVector = NativeFloatingVector<VectorSize>;
+        using ElementType = NativeFloatingType<128 / VectorSize>;
+        using ResultVector = NativeVectorType<sizeof(ResultType) * 8, VectorSize, MakeSigned, ResultType>;
+        using ResultMask = NativeVectorType<sizeof(ResultType) * 8, VectorSize, MakeSigned>;
+
+        // Values between the minimum and the one below it truncate to the minimum, so the comparisons can be strict.
+        constexpr auto minimum = static_cast<ElementType>(NumericLimits<ResultType>::min());
+        constexpr auto limit = static_cast<ElementType>(NumericLimits<ResultType>::max()) + 1;
+
+        auto source = bit_cast<SourceVector>(value);
+        auto too_small = source < minimum;
+        auto too_large = source >= limit;
+        auto in_range = ~(too_small | too_large | (source != source));
+        auto result = __builtin_convertvector(in_range ? source : SourceVector {}, ResultVector);
+        result = __builtin_convertvector(too_small, ResultMask) ? ResultVector {} + NumericLimits<ResultType>::min() : result;
+        result = __builtin_convertvector(too_large, ResultMask) ? ResultVector {} + NumericLimits<ResultType>::max() : result;
+
+        if constexpr (sizeof(ResultVector) == sizeof(u128))
+            return bit_cast<u128>(result);
+        else
+            return bit_cast<u128>(u64x2 { bit_cast<u64>(result), 0 });
+    }
+
+    static StringView name() { return "trunc_sat"sv; }
+};
+
+template<size_t VectorSize, template<typename> typename SetSign>
+struct VectorConvert {
+    auto operator()(u128 value) const
+    {
+        using SourceVector = NativeVectorType<32, 4, SetSign>;
+        if constexpr (VectorSize == 4) {
+            return bit_cast<u128>(__builtin_convertvector(bit_cast<SourceVector>(value), f32x4));
+        } else {
+            using HalfVector = NativeVectorType<32, 2, SetSign>;
+            return bit_cast<u128>(__builtin_convertvector(bit_cast<HalfVector>(bit_cast<u64x2>(value)[0]), f64x2));
+        }
+    }
+
+    static StringView name() { return "convert"sv; }
+};
+
+struct VectorDemote {
+    auto operator()(u128 value) const
+    {
+        auto result = __builtin_convertvector(bit_cast<f64x2>(value), f32x2);
+        return bit_cast<u128>(u64x2 { bit_cast<u64>(result), 0 });
+    }
+
+    static StringView name() { return "demote"sv; }
+};
+
+struct VectorPromote {
+    auto operator()(u128 value) const
+    {
+        return bit_cast<u128>(__builtin_convertvector(bit_cast<f32x2>(bit_cast<u64x2>(value)[0]), f64x2));
+    }
+
+    static StringView name() { return "promote"sv; }
+};
+
 }
@@ -4,17 +4,68 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/HashTable.h>
 #include <AK/Result.h>
 #include <AK/SourceLocation.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
+#include <LibThreading/ParallelFor.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 
 namespace Wasm {
 
+// Below this much code, starting threads costs more than validating on one thread.
+static constexpr size_t parallel_validation_threshold = 256 * KiB;
+
 ErrorOr<void, ValidationError> Validator::validate(Module& module)
+{
+    return validate(module, FunctionBodies::Unvalidated);
+}
+
+ErrorOr<void, ValidationError> Validator::validate(Module& module, Badge<StreamingParser>)
+{
+    return validate(module, FunctionBodies::Validated);
+}
+
+ErrorOr<void, ValidationError> Validator::validate(Module& module, FunctionBodies function_bodies)
+{
+    if (auto result = populate_context(module); result.is_error()) {
+        module.set_validation_status(Module::ValidationStatus::Invalid, {});
+        return result;
+    }
+
+    for (auto& section : module.sections()) {
+        auto result = section.visit(
+            [&](CodeSection const& section) { return validate_and_lower_functions(section, module, function_bodies); },
+            [this](auto& section) { return validate(section); });
+        if (result.is_error()) {
+            module.set_validation_status(Module::ValidationStatus::Invalid, {});
+            return result;
+        }
+    }
+
+    module.set_validation_status(Module::ValidationStatus::Valid, {});
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::begin_validating_function_bodies(Module const& sections_before_code)
+{
+    TRY(populate_context(sections_before_code));
+
+    // The data section comes after the code section, so until then only the data count section says how many segments there are.
+    // NOTE: Nothing has checked the count yet, so an unreasonable one is ignored, which makes bodies that refer to data fail early validation.
+    static constexpr u32 max_data_count = 1 * MiB;
+    sections_before_code.for_each_section_of_type<DataCountSection>([this](DataCountSection const& section) {
+        if (section.count().has_value() && *section.count() <= max_data_count)
+            m_context.datas.resize(*section.count());
+    });
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::populate_context(Module const& module)
 {
     ErrorOr<void, ValidationError> result {};
 
@@ -30,12 +81,11 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
             return;
         }
     });
-    if (result.is_error()) {
-        module.set_validation_status(Module::ValidationStatus::Invalid, {});
+    if (result.is_error())
         return result;
-    }
 
     m_context = {};
+    m_globals_without_internal_globals = {};
 
     module.for_each_section_of_type<TypeSection>([this](TypeSection const& section) {
         m_context.types.extend(section.types());
@@ -64,10 +114,8 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
         }
     });
 
-    if (result.is_error()) {
-        module.set_validation_status(Module::ValidationStatus::Invalid, {});
+    if (result.is_error())
         return result;
-    }
 
     module.for_each_section_of_type<FunctionSection>([this, &result](FunctionSection const& section) {
         if (result.is_error())
@@ -82,10 +130,8 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
             }
         }
     });
-    if (result.is_error()) {
-        module.set_validation_status(Module::ValidationStatus::Invalid, {});
+    if (result.is_error())
         return result;
-    }
 
     module.for_each_section_of_type<TableSection>([this](TableSection const& section) {
         m_context.tables.ensure_capacity(m_context.tables.size() + section.tables().size());
@@ -138,17 +184,6 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
             scan_expression_for_function_indices(segment.expression());
     });
 
-    for (auto& section : module.sections()) {
-        section.visit([this, &result](auto& section) {
-            result = validate(section);
-        });
-        if (result.is_error()) {
-            module.set_validation_status(Module::ValidationStatus::Invalid, {});
-            return result;
-        }
-    }
-
-    module.set_validation_status(Module::ValidationStatus::Valid, {});
     return {};
 }
 
@@ -256,27 +291,108 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
 
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
-    size_t index = m_context.imported_function_count;
-    for (auto& entry : section.functions()) {
-        auto function_index = index++;
-        TRY(validate(FunctionIndex { function_index }));
-        auto& function_type = m_context.functions[function_index];
-        auto& function = entry.func();
-
-        auto function_validator = fork();
-        function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
-        for (auto& local : function.locals()) {
-            for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
-        }
+    for (size_t i = 0; i < section.functions().size(); ++i)
+        TRY(validate_function_body(i, section.functions()[i]));
+    return {};
+}
 
-        function_validator.m_context.labels = { ResultType { function_type.results() } };
-        function_validator.m_context.return_ = ResultType { function_type.results() };
+ErrorOr<void, ValidationError> Validator::validate_function_body(size_t index_in_code_section, CodeSection::Code const& entry)
+{
+    auto function_index = m_context.imported_function_count + index_in_code_section;
+    TRY(validate(FunctionIndex { function_index }));
+    auto& function_type = m_context.functions[function_index];
+    auto& function = entry.func();
 
-        TRY(function_validator.validate(function.body(), function_type.results()));
+    auto function_validator = fork();
+    function_validator.m_context.locals = {};
+    function_validator.m_context.locals.extend(function_type.parameters());
+    for (auto& local : function.locals()) {
+        for (size_t i = 0; i < local.n(); ++i)
+            function_validator.m_context.locals.append(local.type());
     }
 
+    function_validator.m_context.labels = { ResultType { function_type.results() } };
+    function_validator.m_context.return_ = ResultType { function_type.results() };
+
+    TRY(function_validator.validate(function.body(), function_type.results()));
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::validate_and_lower_function(size_t index_in_code_section, CodeSection::Code const& entry, Module& module, FunctionBodies function_bodies)
+{
+    if (function_bodies == FunctionBodies::Unvalidated)
+        TRY(validate_function_body(index_in_code_section, entry));
+
+    // Now that the function body is known to be valid, it can be lowered for BytecodeInterpreter.
+    if (index_in_code_section >= module.functions().size())
+        return {};
+    auto& function = module.functions()[index_in_code_section];
+    FunctionIndex index { m_context.imported_function_count + index_in_code_section };
+    function.set_lowered(LoweredFunction::try_lower(m_context, index, m_context.functions[index.value()], function), {});
+    dbgln_if(WASM_VALIDATOR_DEBUG, "Function {} {} lowered", index_in_code_section, function.lowered() ? "was" : "was not");
+    return {};
+}
+
+// The COWVectors in a context share their storage between copies, with a reference count that isn't atomic.
+// So every thread needs a context of its own, which this makes by only reading from the original.
+static Context copy_for_another_thread(Context const& context)
+{
+    Context copy;
+    copy.types.extend(context.types);
+    copy.functions.extend(context.functions);
+    copy.tables.extend(context.tables);
+    copy.memories.extend(context.memories);
+    copy.globals.extend(context.globals);
+    copy.elements.extend(context.elements);
+    copy.datas.extend(context.datas);
+    copy.locals.extend(context.locals);
+    copy.labels.extend(context.labels);
+    copy.return_ = context.return_;
+    copy.references = context.references;
+    copy.imported_function_count = context.imported_function_count;
+    return copy;
+}
+
+ErrorOr<void, ValidationError> Validator::validate_and_lower_functions(CodeSection const& section, Module& module, FunctionBodies function_bodies)
+{
+    auto& entries = section.functions();
+
+    size_t code_size = 0;
+    for (auto& entry : entries)
+        code_size += entry.size();
+
+    if (code_size < parallel_validation_threshold || Threading::parallel_for_thread_count() == 1) {
+        for (size_t i = 0; i < entries.size(); ++i)
+            TRY(validate_and_lower_function(i, entries[i], module, function_bodies));
+        return {};
+    }
+
+    // Function bodies are independent of each other, so they can be validated and lowered in any order.
+    // To report the same error as validating them in order would, a failure only cancels the functions after it.
+    Vector<OwnPtr<Validator>> thread_validators;
+    thread_validators.resize(Threading::parallel_for_thread_count());
+    Vector<Optional<ValidationError>> errors;
+    errors.resize(entries.size());
+    Atomic<size_t> first_failed_index { NumericLimits<size_t>::max() };
+
+    Threading::parallel_for(entries.size(), [&](size_t index, size_t thread_index) {
+        if (index > first_failed_index.load(AK::MemoryOrder::memory_order_relaxed))
+            return;
+
+        auto& validator = thread_validators[thread_index];
+        if (!validator)
+            validator = adopt_own(*new Validator(copy_for_another_thread(m_context)));
+
+        auto result = validator->validate_and_lower_function(index, entries[index], module, function_bodies);
+        if (!result.is_error())
+            return;
+        errors[index] = result.release_error();
+        auto failed_index = first_failed_index.load(AK::MemoryOrder::memory_order_relaxed);
+        while (index < failed_index && !first_failed_index.compare_exchange_strong(failed_index, index, AK::MemoryOrder::memory_order_relaxed)) { }
+    });
+
+    if (auto failed_index = first_failed_index.load(); failed_index < entries.size())
+        return errors[failed_index].release_value();
     return {};
 }
 
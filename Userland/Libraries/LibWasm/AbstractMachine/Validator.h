@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/COWVector.h>
 #include <AK/Debug.h>
 #include <AK/HashTable.h>
@@ -56,6 +57,14 @@ public:
 
     // Module
     ErrorOr<void, ValidationError> validate(Module&);
+    // Validates a module whose function bodies have already been validated by StreamingParser, through the functions below.
+    ErrorOr<void, ValidationError> validate(Module&, Badge<StreamingParser>);
+
+    // Function bodies only depend on the sections that come before the code section,
+    // so they can be validated while the rest of the module is still being parsed.
+    ErrorOr<void, ValidationError> begin_validating_function_bodies(Module const& sections_before_code);
+    ErrorOr<void, ValidationError> validate_function_body(size_t index_in_code_section, CodeSection::Code const&);
+
     ErrorOr<void, ValidationError> validate(ImportSection const&);
     ErrorOr<void, ValidationError> validate(ExportSection const&);
     ErrorOr<void, ValidationError> validate(StartSection const&);
@@ -267,6 +276,15 @@ private:
     {
     }
 
+    enum class FunctionBodies {
+        Unvalidated,
+        Validated,
+    };
+    ErrorOr<void, ValidationError> validate(Module&, FunctionBodies);
+    ErrorOr<void, ValidationError> populate_context(Module const&);
+    ErrorOr<void, ValidationError> validate_and_lower_functions(CodeSection const&, Module&, FunctionBodies);
+    ErrorOr<void, ValidationError> validate_and_lower_function(size_t index_in_code_section, CodeSection::Code const&, Module&, FunctionBodies);
+
     struct Errors {
         static ValidationError invalid(StringView name) { return ByteString::formatted("Invalid {}", name); }
 
@@ -9,6 +9,8 @@
 namespace Wasm {
 
 class AbstractMachine;
+class LoweredFunction;
+class StreamingParser;
 class Validator;
 struct ValidationError;
 struct Interpreter;
@@ -0,0 +1,665 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteString.h>
+#include <AK/Debug.h>
+#include <AK/StdLibExtras.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/AbstractMachine/Operators.h>
+#include <LibWasm/JIT/Compiler.h>
+#include <stdlib.h>
+
+namespace Wasm::JIT {
+
+bool Compiler::is_enabled()
+{
+    static bool const enabled = getenv("LIBWASM_JIT") != nullptr;
+    return enabled;
+}
+
+#ifdef JIT_ARCH_SUPPORTED
+
+void Compiler::load_slot(Assembler::Reg dst, u32 slot)
+{
+    m_assembler.mov(
+        Assembler::Operand::Register(dst),
+        Assembler::Operand::Mem64BaseAndOffset(SLOTS, slot * sizeof(u64)));
+}
+
+void Compiler::load_slot32(Assembler::Reg dst, u32 slot, Assembler::Extension extension)
+{
+    m_assembler.mov32(
+        Assembler::Operand::Register(dst),
+        Assembler::Operand::Mem64BaseAndOffset(SLOTS, slot * sizeof(u64)),
+        extension);
+}
+
+void Compiler::store_slot(u32 slot, Assembler::Reg src)
+{
+    m_assembler.mov(
+        Assembler::Operand::Mem64BaseAndOffset(SLOTS, slot * sizeof(u64)),
+        Assembler::Operand::Register(src));
+}
+
+void Compiler::load_memory_registers()
+{
+    m_assembler.mov(
+        Assembler::Operand::Register(MEMORY_BASE),
+        Assembler::Operand::Mem64BaseAndOffset(CONTEXT, offsetof(NativeContext, memory_data)));
+    m_assembler.mov(
+        Assembler::Operand::Register(MEMORY_BOUNDS),
+        Assembler::Operand::Mem64BaseAndOffset(CONTEXT, offsetof(NativeContext, memory_bounds)));
+}
+
+void Compiler::charge_for_back_edge(size_t target)
+{
+    if (target > m_current_index)
+        return;
+
+    // if ((budget -= instructions in the loop) underflows) trap;
+    m_assembler.sub(
+        Assembler::Operand::Register(INSTRUCTION_BUDGET),
+        Assembler::Operand::Imm(m_current_index - target + 1));
+    m_assembler.jump_if(Assembler::Condition::Below, m_out_of_budget_label);
+}
+
+void Compiler::compile_branch(size_t target)
+{
+    charge_for_back_edge(target);
+    m_assembler.jump(m_instruction_labels[target]);
+}
+
+void Compiler::compile_branch_if(Assembler::Condition condition, size_t target)
+{
+    if (target > m_current_index) {
+        m_assembler.jump_if(condition, m_instruction_labels[target]);
+        return;
+    }
+
+    // Back edges have to be charged for before they are taken, so jump around the branch if it isn't.
+    Assembler::Label not_taken {};
+    auto inverted_condition = condition == Assembler::Condition::NotEqualTo ? Assembler::Condition::EqualTo : Assembler::Condition::NotEqualTo;
+    m_assembler.jump_if(inverted_condition, not_taken);
+    compile_branch(target);
+    not_taken.link(m_assembler);
+}
+
+void Compiler::compile_branch_table(LoweredInstruction const& instruction)
+{
+    auto const& table = m_function.branch_table();
+    size_t first_target = m_current_index;
+    for (size_t i = 0; i <= instruction.rhs; ++i)
+        first_target = min(first_target, static_cast<size_t>(table[instruction.immediate + i]));
+    charge_for_back_edge(first_target);
+
+    // switch (slots[lhs]) { case 0: ...; default: goto table[rhs]; }
+    load_slot32(GPR0, instruction.lhs);
+    for (u32 i = 0; i < instruction.rhs; ++i) {
+        m_assembler.jump_if(
+            Assembler::Operand::Register(GPR0),
+            Assembler::Condition::EqualTo,
+            Assembler::Operand::Imm(i),
+            m_instruction_labels[table[instruction.immediate + i]]);
+    }
+    m_assembler.jump(m_instruction_labels[table[instruction.immediate + instruction.rhs]]);
+}
+
+void Compiler::compile_select(LoweredInstruction const& instruction)
+{
+    // slots[destination] = slots[immediate] ? slots[lhs] : slots[rhs];
+    load_slot(GPR0, instruction.lhs);
+    load_slot(GPR1, instruction.rhs);
+    load_slot32(GPR2, instruction.immediate);
+    m_assembler.test(Assembler::Operand::Register(GPR2), Assembler::Operand::Register(GPR2));
+    m_assembler.mov_if(Assembler::Condition::EqualTo, Assembler::Operand::Register(GPR0), Assembler::Operand::Register(GPR1));
+    store_slot(instruction.destination, GPR0);
+}
+
+void Compiler::compile_effective_address(LoweredInstruction const& instruction, size_t size)
+{
+    // GPR0 = (u64)(u32)slots[lhs] + immediate;
+    load_slot32(GPR0, instruction.lhs);
+    if (instruction.immediate != 0) {
+        m_assembler.mov(Assembler::Operand::Register(GPR1), Assembler::Operand::Imm(instruction.immediate));
+        m_assembler.add(Assembler::Operand::Register(GPR0), Assembler::Operand::Register(GPR1));
+    }
+
+    // if (GPR0 + size > bounds) trap;
+    m_assembler.mov(Assembler::Operand::Register(GPR1), Assembler::Operand::Register(GPR0));
+    m_assembler.add(Assembler::Operand::Register(GPR1), Assembler::Operand::Imm(size));
+    m_assembler.jump_if(
+        Assembler::Operand::Register(GPR1),
+        Assembler::Condition::Above,
+        Assembler::Operand::Register(MEMORY_BOUNDS),
+        m_out_of_bounds_label);
+
+    m_assembler.add(Assembler::Operand::Register(GPR0), Assembler::Operand::Register(MEMORY_BASE));
+}
+
+void Compiler::compile_load(LoweredInstruction const& instruction, size_t size, Assembler::Extension extension, bool extend_to_64_bits)
+{
+    compile_effective_address(instruction, size);
+
+    auto dst = Assembler::Operand::Register(GPR0);
+    auto src = Assembler::Operand::Mem64BaseAndOffset(GPR0, 0);
+    switch (size) {
+    case 1:
+        m_assembler.mov8(dst, src, extension);
+        break;
+    case 2:
+        m_assembler.mov16(dst, src, extension);
+        break;
+    case 4:
+        m_assembler.mov32(dst, src, extend_to_64_bits ? extension : Assembler::Extension::ZeroExtend);
+        break;
+    case 8:
+        m_assembler.mov(dst, src);
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+    // Narrow loads sign-extend to 32 bits, which is all an i32 slot holds.
+    if (size < 4 && extend_to_64_bits && extension == Assembler::Extension::SignExtend)
+        m_assembler.sign_extend_32_to_64_bits(GPR0);
+
+    store_slot(instruction.destination, GPR0);
+}
+
+void Compiler::compile_store(LoweredInstruction const& instruction, size_t size)
+{
+    compile_effective_address(instruction, size);
+    load_slot(GPR1, instruction.rhs);
+
+    auto dst = Assembler::Operand::Mem64BaseAndOffset(GPR0, 0);
+    auto src = Assembler::Operand::Register(GPR1);
+    switch (size) {
+    case 1:
+        m_assembler.mov8(dst, src);
+        break;
+    case 2:
+        m_assembler.mov16(dst, src);
+        break;
+    case 4:
+        m_assembler.mov32(dst, src);
+        break;
+    case 8:
+        m_assembler.mov(dst, src);
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+bool Compiler::compile_integer_operation(LoweredInstruction const& instruction)
+{
+    enum class Kind {
+        I32,
+        I32Signed,
+        I64,
+    };
+
+    auto load_operands = [&](Kind kind, bool has_immediate) {
+        if (kind == Kind::I32Signed) {
+            load_slot32(GPR0, instruction.lhs, Assembler::Extension::SignExtend);
+            if (has_immediate)
+                m_assembler.mov(Assembler::Operand::Register(GPR1), Assembler::Operand::Imm(static_cast<i64>(static_cast<i32>(instruction.immediate))));
+            else
+                load_slot32(GPR1, instruction.rhs, Assembler::Extension::SignExtend);
+            return;
+        }
+        load_slot(GPR0, instruction.lhs);
+        if (has_immediate)
+            m_assembler.mov(Assembler::Operand::Register(GPR1), Assembler::Operand::Imm(instruction.immediate));
+        else
+            load_slot(GPR1, instruction.rhs);
+    };
+
+    // slots[destination] = lhs <condition> rhs;
+    auto compile_comparison = [&](Kind kind, bool has_immediate, Assembler::Condition condition) {
+        load_operands(kind, has_immediate);
+        m_assembler.mov(Assembler::Operand::Register(GPR2), Assembler::Operand::Imm(0));
+        m_assembler.cmp(Assembler::Operand::Register(GPR0), Assembler::Operand::Register(GPR1));
+        m_assembler.set_if(condition, Assembler::Operand::Register(GPR2));
+        store_slot(instruction.destination, GPR2);
+    };
+
+    // slots[destination] = lhs <op> rhs;
+    // NOTE: 32-bit operations clear the upper half of their result, and bitwise ones keep it clear, so i32 results
+    //       end up zero-extended in their slot the way they have to be.
+    auto compile_arithmetic = [&](Kind kind, bool has_immediate, auto emit) {
+        load_operands(kind, has_immediate);
+        emit(Assembler::Operand::Register(GPR0), Assembler::Operand::Register(GPR1));
+        store_slot(instruction.destination, GPR0);
+    };
+
+    // Shifts take their count in CL, which is masked the same way wasm masks it.
+    auto compile_shift = [&](bool has_immediate, auto emit) {
+        load_operands(Kind::I64, has_immediate);
+        emit(Assembler::Operand::Register(GPR0), Optional<Assembler::Operand> {});
+        store_slot(instruction.destination, GPR0);
+    };
+
+    auto add32 = [&](auto dst, auto src) { m_assembler.add32(dst, src, {}); };
+    auto sub32 = [&](auto dst, auto src) { m_assembler.sub32(dst, src, {}); };
+    auto mul32 = [&](auto dst, auto src) { m_assembler.mul32(dst, src, {}); };
+    auto add = [&](auto dst, auto src) { m_assembler.add(dst, src); };
+    auto sub = [&](auto dst, auto src) { m_assembler.sub(dst, src); };
+    auto bitwise_and = [&](auto dst, auto src) { m_assembler.bitwise_and(dst, src); };
+    auto bitwise_or = [&](auto dst, auto src) { m_assembler.bitwise_or(dst, src); };
+    auto bitwise_xor32 = [&](auto dst, auto src) { m_assembler.bitwise_xor32(dst, src); };
+    auto shift_left32 = [&](auto dst, auto count) { m_assembler.shift_left32(dst, count); };
+    auto shift_right32 = [&](auto dst, auto count) { m_assembler.shift_right32(dst, count); };
+    auto arithmetic_right_shift32 = [&](auto dst, auto count) { m_assembler.arithmetic_right_shift32(dst, count); };
+    auto shift_left = [&](auto dst, auto count) { m_assembler.shift_left(dst, count); };
+    auto arithmetic_right_shift = [&](auto dst, auto count) { m_assembler.arithmetic_right_shift(dst, count); };
+
+#    define __CASE(name, ...)          \
+        case OpCode::name:             \
+            __VA_ARGS__(false);        \
+            return true;               \
+        case OpCode::name##_immediate: \
+            __VA_ARGS__(true);         \
+            return true;
+
+#    define COMPARISON(kind, condition) [&](bool has_immediate) { compile_comparison(Kind::kind, has_immediate, Assembler::Condition::condition); }
+#    define ARITHMETIC(kind, emit) [&](bool has_immediate) { compile_arithmetic(Kind::kind, has_immediate, emit); }
+#    define SHIFT(emit) [&](bool has_immediate) { compile_shift(has_immediate, emit); }
+
+    switch (instruction.opcode) {
+        __CASE(i32_eq, COMPARISON(I32, EqualTo))
+        __CASE(i32_ne, COMPARISON(I32, NotEqualTo))
+        __CASE(i32_lts, COMPARISON(I32Signed, SignedLessThan))
+        __CASE(i32_ltu, COMPARISON(I32, UnsignedLessThan))
+        __CASE(i32_gts, COMPARISON(I32Signed, SignedGreaterThan))
+        __CASE(i32_gtu, COMPARISON(I32, UnsignedGreaterThan))
+        __CASE(i32_les, COMPARISON(I32Signed, SignedLessThanOrEqualTo))
+        __CASE(i32_leu, COMPARISON(I32, UnsignedLessThanOrEqualTo))
+        __CASE(i32_ges, COMPARISON(I32Signed, SignedGreaterThanOrEqualTo))
+        __CASE(i32_geu, COMPARISON(I32, UnsignedGreaterThanOrEqualTo))
+        __CASE(i64_eq, COMPARISON(I64, EqualTo))
+        __CASE(i64_ne, COMPARISON(I64, NotEqualTo))
+        __CASE(i64_lts, COMPARISON(I64, SignedLessThan))
+        __CASE(i64_ltu, COMPARISON(I64, UnsignedLessThan))
+        __CASE(i64_gts, COMPARISON(I64, SignedGreaterThan))
+        __CASE(i64_gtu, COMPARISON(I64, UnsignedGreaterThan))
+        __CASE(i64_les, COMPARISON(I64, SignedLessThanOrEqualTo))
+        __CASE(i64_leu, COMPARISON(I64, UnsignedLessThanOrEqualTo))
+        __CASE(i64_ges, COMPARISON(I64, SignedGreaterThanOrEqualTo))
+        __CASE(i64_geu, COMPARISON(I64, UnsignedGreaterThanOrEqualTo))
+        __CASE(i32_add, ARITHMETIC(I32, add32))
+        __CASE(i32_sub, ARITHMETIC(I32, sub32))
+        __CASE(i32_mul, ARITHMETIC(I32, mul32))
+        __CASE(i32_and, ARITHMETIC(I32, bitwise_and))
+        __CASE(i32_or, ARITHMETIC(I32, bitwise_or))
+        __CASE(i32_xor, ARITHMETIC(I32, bitwise_xor32))
+        __CASE(i32_shl, SHIFT(shift_left32))
+        __CASE(i32_shrs, SHIFT(arithmetic_right_shift32))
+        __CASE(i32_shru, SHIFT(shift_right32))
+        __CASE(i64_add, ARITHMETIC(I64, add))
+        __CASE(i64_sub, ARITHMETIC(I64, sub))
+        __CASE(i64_and, ARITHMETIC(I64, bitwise_and))
+        __CASE(i64_or, ARITHMETIC(I64, bitwise_or))
+        __CASE(i64_shl, SHIFT(shift_left))
+        __CASE(i64_shrs, SHIFT(arithmetic_right_shift))
+    default:
+        return false;
+    }
+
+#    undef __CASE
+#    undef COMPARISON
+#    undef ARITHMETIC
+#    undef SHIFT
+}
+
+void Compiler::compile_glue_call(LoweredInstruction const& instruction, Glue glue)
+{
+    m_assembler.mov(Assembler::Operand::Register(ARG0), Assembler::Operand::Register(CONTEXT));
+    m_assembler.mov(Assembler::Operand::Register(ARG1), Assembler::Operand::Register(SLOTS));
+    m_assembler.mov(Assembler::Operand::Register(ARG2), Assembler::Operand::Imm(bit_cast<FlatPtr>(&instruction)));
+    m_assembler.native_call(bit_cast<u64>(glue));
+
+    // if (RET == 0) goto failure;
+    m_assembler.test(Assembler::Operand::Register(RET), Assembler::Operand::Register(RET));
+    m_assembler.jump_if(Assembler::Condition::EqualTo, m_failure_label);
+
+    // Calls and memory.grow can move memory 0.
+    switch (instruction.opcode) {
+    case OpCode::call:
+    case OpCode::call_indirect:
+    case OpCode::memory_grow:
+        load_memory_registers();
+        break;
+    default:
+        break;
+    }
+}
+
+void Compiler::compile_instruction(LoweredInstruction const& instruction)
+{
+    switch (instruction.opcode) {
+    case OpCode::copy:
+        load_slot(GPR0, instruction.lhs);
+        store_slot(instruction.destination, GPR0);
+        return;
+    case OpCode::constant:
+        m_assembler.mov(Assembler::Operand::Register(GPR0), Assembler::Operand::Imm(instruction.immediate));
+        store_slot(instruction.destination, GPR0);
+        return;
+    case OpCode::unreachable:
+        m_assembler.jump(m_unreachable_label);
+        return;
+    case OpCode::branch:
+        compile_branch(instruction.immediate);
+        return;
+    case OpCode::branch_if:
+    case OpCode::branch_unless:
+        load_slot32(GPR0, instruction.lhs);
+        m_assembler.test(Assembler::Operand::Register(GPR0), Assembler::Operand::Register(GPR0));
+        compile_branch_if(instruction.opcode == OpCode::branch_if ? Assembler::Condition::NotEqualTo : Assembler::Condition::EqualTo, instruction.immediate);
+        return;
+    case OpCode::branch_table:
+        compile_branch_table(instruction);
+        return;
+    case OpCode::return_:
+        m_assembler.jump(m_success_label);
+        return;
+    case OpCode::select:
+        compile_select(instruction);
+        return;
+    case OpCode::i32_eqz:
+    case OpCode::i64_eqz:
+        load_slot(GPR0, instruction.lhs);
+        m_assembler.mov(Assembler::Operand::Register(GPR2), Assembler::Operand::Imm(0));
+        m_assembler.test(Assembler::Operand::Register(GPR0), Assembler::Operand::Register(GPR0));
+        m_assembler.set_if(Assembler::Condition::EqualTo, Assembler::Operand::Register(GPR2));
+        store_slot(instruction.destination, GPR2);
+        return;
+
+    case OpCode::i32_load:
+    case OpCode::f32_load:
+        compile_load(instruction, 4, Assembler::Extension::ZeroExtend, false);
+        return;
+    case OpCode::i64_load:
+    case OpCode::f64_load:
+        compile_load(instruction, 8, Assembler::Extension::ZeroExtend, false);
+        return;
+    case OpCode::i32_load8_s:
+        compile_load(instruction, 1, Assembler::Extension::SignExtend, false);
+        return;
+    case OpCode::i32_load8_u:
+    case OpCode::i64_load8_u:
+        compile_load(instruction, 1, Assembler::Extension::ZeroExtend, false);
+        return;
+    case OpCode::i32_load16_s:
+        compile_load(instruction, 2, Assembler::Extension::SignExtend, false);
+        return;
+    case OpCode::i32_load16_u:
+    case OpCode::i64_load16_u:
+        compile_load(instruction, 2, Assembler::Extension::ZeroExtend, false);
+        return;
+    case OpCode::i64_load8_s:
+        compile_load(instruction, 1, Assembler::Extension::SignExtend, true);
+        return;
+    case OpCode::i64_load16_s:
+        compile_load(instruction, 2, Assembler::Extension::SignExtend, true);
+        return;
+    case OpCode::i64_load32_s:
+        compile_load(instruction, 4, Assembler::Extension::SignExtend, true);
+        return;
+    case OpCode::i64_load32_u:
+        compile_load(instruction, 4, Assembler::Extension::ZeroExtend, false);
+        return;
+
+    case OpCode::i32_store:
+    case OpCode::f32_store:
+    case OpCode::i64_store32:
+        compile_store(instruction, 4);
+        return;
+    case OpCode::i64_store:
+    case OpCode::f64_store:
+        compile_store(instruction, 8);
+        return;
+    case OpCode::i32_store8:
+    case OpCode::i64_store8:
+        compile_store(instruction, 1);
+        return;
+    case OpCode::i32_store16:
+    case OpCode::i64_store16:
+        compile_store(instruction, 2);
+        return;
+
+    default:
+        break;
+    }
+
+    if (compile_integer_operation(instruction))
+        return;
+
+    compile_glue_call(instruction, glue_for(instruction.opcode));
+}
+
+void Compiler::compile_trap_stub(Assembler::Label& label, TrapReason reason)
+{
+    if (label.jump_slot_offsets_in_instruction_stream.is_empty())
+        return;
+
+    label.link(m_assembler);
+    m_assembler.mov(Assembler::Operand::Register(ARG0), Assembler::Operand::Register(CONTEXT));
+    m_assembler.mov(Assembler::Operand::Register(ARG1), Assembler::Operand::Imm(to_underlying(reason)));
+    m_assembler.native_call(bit_cast<u64>(&trap));
+    m_assembler.jump(m_failure_label);
+}
+
+template<typename PopType, typename PushType, typename Operator>
+static u64 unary_operation(NativeContext& context, u64* slots, LoweredInstruction const& instruction)
+{
+    return lowered_unary_operation<PopType, PushType, Operator>(slots[instruction.destination], slots[instruction.lhs], context.trap_reason);
+}
+
+template<typename PopType, typename PushType, typename Operator>
+static u64 binary_operation(NativeContext& context, u64* slots, LoweredInstruction const& instruction)
+{
+    return lowered_binary_operation<PopType, PushType, Operator>(slots[instruction.destination], slots[instruction.lhs], slots[instruction.rhs], context.trap_reason);
+}
+
+template<typename PopType, typename PushType, typename Operator>
+static u64 binary_operation_with_immediate(NativeContext& context, u64* slots, LoweredInstruction const& instruction)
+{
+    return lowered_binary_operation<PopType, PushType, Operator>(slots[instruction.destination], slots[instruction.lhs], instruction.immediate, context.trap_reason);
+}
+
+Compiler::Glue Compiler::glue_for(OpCode opcode)
+{
+    switch (opcode) {
+    case OpCode::call:
+        return &call;
+    case OpCode::call_indirect:
+        return &call_indirect;
+    case OpCode::global_get:
+        return &global_get;
+    case OpCode::global_set:
+        return &global_set;
+    case OpCode::memory_size:
+        return &memory_size;
+    case OpCode::memory_grow:
+        return &memory_grow;
+    case OpCode::memory_fill:
+        return &memory_fill;
+    case OpCode::memory_copy:
+        return &memory_copy;
+
+#    define __ENUMERATE_UNARY_GLUE(name, PopType, PushType, Operator) \
+    case OpCode::name:                                               \
+        return &unary_operation<PopType, PushType, Operators::Operator>;
+        ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_UNARY_GLUE)
+#    undef __ENUMERATE_UNARY_GLUE
+
+#    define __ENUMERATE_BINARY_GLUE(name, PopType, PushType, Operator)         \
+    case OpCode::name:                                                        \
+        return &binary_operation<PopType, PushType, Operators::Operator>;     \
+    case OpCode::name##_immediate:                                            \
+        return &binary_operation_with_immediate<PopType, PushType, Operators::Operator>;
+        ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_BINARY_GLUE)
+#    undef __ENUMERATE_BINARY_GLUE
+
+    default:
+        // Everything else is always compiled inline.
+        VERIFY_NOT_REACHED();
+    }
+}
+
+u64 Compiler::call(NativeContext& context, u64* slots, LoweredInstruction const& instruction)
+{
+    auto succeeded = context.interpreter->call_from_native_code(*context.configuration, context.module->functions()[instruction.immediate], slots + instruction.destination);
+    context.reload_memory();
+    return succeeded;
+}
+
+u64 Compiler::call_indirect(NativeContext& context, u64* slots, LoweredInstruction const& instruction)
+{
+    auto address = context.interpreter->resolve_indirect_call(*context.configuration, *context.module, instruction.rhs, instruction.immediate, static_cast<u32>(slots[instruction.lhs]));
+    if (address.is_error()) {
+        context.trap_reason = address.error();
+        return false;
+    }
+    auto succeeded = context.interpreter->call_from_native_code(*context.configuration, address.value(), slots + instruction.destination);
+    context.reload_memory();
+    return succeeded;
+}
+
+u64 Compiler::global_get(NativeContext& context, u64* slots, LoweredInstruction const& instruction)
+{
+    slots[instruction.destination] = value_to_slot(context.configuration->store().get(context.module->globals()[instruction.immediate])->value());
+    return true;
+}
+
+u64 Compiler::global_set(NativeContext& context, u64* slots, LoweredInstruction const& instruction)
+{
+    auto* global = context.configuration->store().get(context.module->globals()[instruction.immediate]);
+    global->set_value(slot_to_value(global->value().type(), slots[instruction.lhs]));
+    return true;
+}
+
+u64 Compiler::memory_size(NativeContext& context, u64* slots, LoweredInstruction const& instruction)
+{
+    auto* memory = context.configuration->store().get(context.module->memories()[0]);
+    slots[instruction.destination] = to_slot(static_cast<i32>(memory->size() / Constants::page_size));
+    return true;
+}
+
+u64 Compiler::memory_grow(NativeContext& context, u64* slots, LoweredInstruction const& instruction)
+{
+    auto* memory = context.configuration->store().get(context.module->memories()[0]);
+    auto old_pages = static_cast<i32>(memory->size() / Constants::page_size);
+    if (memory->grow(static_cast<u64>(read_slot<u32>(slots[instruction.lhs])) * Constants::page_size))
+        slots[instruction.destination] = to_slot(old_pages);
+    else
+        slots[instruction.destination] = to_slot(-1);
+    context.reload_memory();
+    return true;
+}
+
+u64 Compiler::memory_fill(NativeContext& context, u64* slots, LoweredInstruction const& instruction)
+{
+    auto memory = context.configuration->store().get(context.module->memories()[0])->bytes();
+    auto destination = read_slot<u32>(slots[instruction.destination]);
+    auto count = read_slot<u32>(slots[instruction.rhs]);
+    if (static_cast<u64>(destination) + count > memory.size()) {
+        context.trap_reason = "Memory access out of bounds"sv;
+        return false;
+    }
+    __builtin_memset(memory.data() + destination, static_cast<u8>(slots[instruction.lhs]), count);
+    return true;
+}
+
+u64 Compiler::memory_copy(NativeContext& context, u64* slots, LoweredInstruction const& instruction)
+{
+    auto memory = context.configuration->store().get(context.module->memories()[0])->bytes();
+    auto destination = read_slot<u32>(slots[instruction.destination]);
+    auto source = read_slot<u32>(slots[instruction.lhs]);
+    auto count = read_slot<u32>(slots[instruction.rhs]);
+    if (static_cast<u64>(destination) + count > memory.size() || static_cast<u64>(source) + count > memory.size()) {
+        context.trap_reason = "Memory access out of bounds"sv;
+        return false;
+    }
+    __builtin_memmove(memory.data() + destination, memory.data() + source, count);
+    return true;
+}
+
+void Compiler::trap(NativeContext& context, TrapReason reason)
+{
+    switch (reason) {
+    case TrapReason::MemoryAccessOutOfBounds:
+        context.trap_reason = "Memory access out of bounds"sv;
+        return;
+    case TrapReason::Unreachable:
+        context.trap_reason = "Unreachable"sv;
+        return;
+    case TrapReason::ExceededInstructionBudget:
+        context.trap_reason = "Exceeded maximum allowed number of instructions"sv;
+        return;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+OwnPtr<NativeCode> Compiler::compile(LoweredFunction const& function)
+{
+    Compiler compiler { function };
+    auto& assembler = compiler.m_assembler;
+    auto const& instructions = function.instructions();
+
+    // Branches may target the end of the function, so that gets a label too.
+    compiler.m_instruction_labels.resize(instructions.size() + 1);
+
+    // u64 code(u64* slots, NativeContext* context)
+    assembler.enter();
+    assembler.mov(Assembler::Operand::Register(SLOTS), Assembler::Operand::Register(ARG0));
+    assembler.mov(Assembler::Operand::Register(CONTEXT), Assembler::Operand::Register(ARG1));
+    assembler.mov(
+        Assembler::Operand::Register(INSTRUCTION_BUDGET),
+        Assembler::Operand::Mem64BaseAndOffset(CONTEXT, offsetof(NativeContext, instruction_budget)));
+    compiler.load_memory_registers();
+
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        compiler.m_current_index = i;
+        compiler.m_instruction_labels[i].link(assembler);
+        compiler.compile_instruction(instructions[i]);
+    }
+
+    // Lowered functions always end in a return, so we should never fall off the end.
+    compiler.m_instruction_labels[instructions.size()].link(assembler);
+    assembler.verify_not_reached();
+
+    compiler.compile_trap_stub(compiler.m_out_of_bounds_label, TrapReason::MemoryAccessOutOfBounds);
+    compiler.compile_trap_stub(compiler.m_unreachable_label, TrapReason::Unreachable);
+    compiler.compile_trap_stub(compiler.m_out_of_budget_label, TrapReason::ExceededInstructionBudget);
+
+    compiler.m_success_label.link(assembler);
+    assembler.mov(Assembler::Operand::Register(RET), Assembler::Operand::Imm(1));
+    assembler.exit();
+
+    compiler.m_failure_label.link(assembler);
+    assembler.mov(Assembler::Operand::Register(RET), Assembler::Operand::Imm(0));
+    assembler.exit();
+
+    auto native_code = NativeCode::create(compiler.m_output.span(), ByteString::formatted("wasm-function[{}]", function.index().value()));
+    dbgln_if(WASM_JIT_DEBUG, "Wasm JIT: Compiled {} instructions into {} bytes of machine code for function {}", instructions.size(), compiler.m_output.size(), function.index().value());
+    return native_code;
+}
+
+#else
+
+OwnPtr<NativeCode> Compiler::compile(LoweredFunction const&)
+{
+    return nullptr;
+}
+
+#endif
+
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJIT/Assembler.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
+#include <LibWasm/JIT/NativeCode.h>
+
+namespace Wasm::JIT {
+
+// A single-pass baseline compiler that turns a LoweredFunction into native code.
+// Moves, branches, integer arithmetic and comparisons, and memory accesses are emitted inline, with the slots of the
+// frame staying in memory. Everything else becomes a call into the same C++ code the interpreter uses.
+// Enabled by setting the LIBWASM_JIT environment variable.
+class Compiler {
+public:
+    static bool is_enabled();
+
+    // The number of times a function has to be called before we compile it.
+    static constexpr u32 hot_function_threshold = 4;
+
+    // Returns nullptr if the function can't be compiled, in which case it keeps running in the interpreter.
+    static OwnPtr<NativeCode> compile(LoweredFunction const&);
+
+#ifdef JIT_ARCH_SUPPORTED
+private:
+    using Assembler = ::JIT::Assembler;
+    using OpCode = LoweredInstruction::OpCode;
+
+    static constexpr auto GPR0 = Assembler::Reg::RAX;
+    static constexpr auto GPR1 = Assembler::Reg::RCX;
+    static constexpr auto GPR2 = Assembler::Reg::RDX;
+    static constexpr auto ARG0 = Assembler::Reg::RDI;
+    static constexpr auto ARG1 = Assembler::Reg::RSI;
+    static constexpr auto ARG2 = Assembler::Reg::RDX;
+    static constexpr auto RET = Assembler::Reg::RAX;
+
+    // These are callee-saved, so they survive calls into C++.
+    // NOTE: R12 and R13 are never used as memory bases, since they need special ModRM encodings.
+    static constexpr auto SLOTS = Assembler::Reg::RBX;
+    static constexpr auto MEMORY_BASE = Assembler::Reg::R12;
+    static constexpr auto MEMORY_BOUNDS = Assembler::Reg::R13;
+    static constexpr auto CONTEXT = Assembler::Reg::R14;
+    static constexpr auto INSTRUCTION_BUDGET = Assembler::Reg::R15;
+
+    enum class TrapReason {
+        MemoryAccessOutOfBounds,
+        Unreachable,
+        ExceededInstructionBudget,
+    };
+
+    explicit Compiler(LoweredFunction const& function)
+        : m_function(function)
+    {
+    }
+
+    void compile_instruction(LoweredInstruction const&);
+    bool compile_integer_operation(LoweredInstruction const&);
+    void compile_branch(size_t target);
+    void compile_branch_if(Assembler::Condition, size_t target);
+    void compile_branch_table(LoweredInstruction const&);
+    void compile_select(LoweredInstruction const&);
+    void compile_load(LoweredInstruction const&, size_t size, Assembler::Extension, bool extend_to_64_bits);
+    void compile_store(LoweredInstruction const&, size_t size);
+    void compile_effective_address(LoweredInstruction const&, size_t size);
+
+    // Emits a call to `glue(context, slots, instruction)`, which returns zero if the instruction trapped.
+    using Glue = u64 (*)(NativeContext&, u64* slots, LoweredInstruction const&);
+    void compile_glue_call(LoweredInstruction const&, Glue);
+
+    // Charges the instructions that a branch from the current instruction back to `target` runs again.
+    void charge_for_back_edge(size_t target);
+
+    void load_slot(Assembler::Reg dst, u32 slot);
+    void load_slot32(Assembler::Reg dst, u32 slot, Assembler::Extension = Assembler::Extension::ZeroExtend);
+    void store_slot(u32 slot, Assembler::Reg src);
+    void load_memory_registers();
+    void compile_trap_stub(Assembler::Label&, TrapReason);
+
+    // Runtime glue called from generated code.
+    static Glue glue_for(OpCode);
+    static u64 call(NativeContext&, u64* slots, LoweredInstruction const&);
+    static u64 call_indirect(NativeContext&, u64* slots, LoweredInstruction const&);
+    static u64 global_get(NativeContext&, u64* slots, LoweredInstruction const&);
+    static u64 global_set(NativeContext&, u64* slots, LoweredInstruction const&);
+    static u64 memory_size(NativeContext&, u64* slots, LoweredInstruction const&);
+    static u64 memory_grow(NativeContext&, u64* slots, LoweredInstruction const&);
+    static u64 memory_fill(NativeContext&, u64* slots, LoweredInstruction const&);
+    static u64 memory_copy(NativeContext&, u64* slots, LoweredInstruction const&);
+    static void trap(NativeContext&, TrapReason);
+
+    Vector<u8> m_output;
+    Assembler m_assembler { m_output };
+    Assembler::Label m_success_label;
+    Assembler::Label m_failure_label;
+    Assembler::Label m_out_of_bounds_label;
+    Assembler::Label m_unreachable_label;
+    Assembler::Label m_out_of_budget_label;
+    Vector<Assembler::Label> m_instruction_labels;
+    size_t m_current_index { 0 };
+    LoweredFunction const& m_function;
+#endif
+};
+
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJIT/GDB.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/JIT/NativeCode.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+
+namespace Wasm::JIT {
+
+void NativeContext::reload_memory()
+{
+    if (module->memories().is_empty())
+        return;
+    auto* memory = configuration->store().get(module->memories()[0]);
+    memory_data = memory->bytes().data();
+    memory_bounds = memory->has_guard_pages() ? NumericLimits<u64>::max() : memory->size();
+}
+
+OwnPtr<NativeCode> NativeCode::create(ReadonlyBytes machine_code, StringView name)
+{
+    auto* code = mmap(nullptr, machine_code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED) {
+        dbgln("Wasm JIT: mmap: {}", strerror(errno));
+        return nullptr;
+    }
+    memcpy(code, machine_code.data(), machine_code.size());
+    if (mprotect(code, machine_code.size(), PROT_READ | PROT_EXEC) < 0) {
+        dbgln("Wasm JIT: mprotect: {}", strerror(errno));
+        munmap(code, machine_code.size());
+        return nullptr;
+    }
+
+    auto native_code = adopt_own(*new NativeCode(code, machine_code.size()));
+
+    native_code->m_gdb_object = ::JIT::GDB::build_gdb_image(native_code->code_bytes(), "LibWasm JIT"sv, name);
+    if (native_code->m_gdb_object.has_value())
+        ::JIT::GDB::register_into_gdb(native_code->m_gdb_object->span());
+
+    return native_code;
+}
+
+NativeCode::NativeCode(void* code, size_t size)
+    : m_code(code)
+    , m_size(size)
+{
+}
+
+NativeCode::~NativeCode()
+{
+    if (m_gdb_object.has_value())
+        ::JIT::GDB::unregister_from_gdb(m_gdb_object->span());
+    munmap(m_code, m_size);
+}
+
+bool NativeCode::run(u64* slots, NativeContext& context) const
+{
+    using JITCode = u64 (*)(u64* slots, NativeContext* context);
+    return bit_cast<JITCode>(m_code)(slots, &context) != 0;
+}
+
+}
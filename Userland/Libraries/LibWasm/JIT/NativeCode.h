@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FixedArray.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+#include <LibWasm/Forward.h>
+
+namespace Wasm {
+
+struct BytecodeInterpreter;
+class Configuration;
+class ModuleInstance;
+
+}
+
+namespace Wasm::JIT {
+
+// The state that generated code shares with the C++ code it calls into, for one call of a function.
+struct NativeContext {
+    BytecodeInterpreter* interpreter { nullptr };
+    Configuration* configuration { nullptr };
+    ModuleInstance const* module { nullptr };
+
+    // Memory 0 of the module, which calls and memory.grow can move. Accesses that end past the bounds trap, which
+    // for memories with guard pages is never the case, as out-of-bounds accesses fault on those instead.
+    u8* memory_data { nullptr };
+    u64 memory_bounds { 0 };
+
+    // The number of instructions the function may still run, generated code traps once it runs out.
+    u64 instruction_budget { 0 };
+
+    // Set when the function traps, unless it was a function it called that trapped.
+    StringView trap_reason;
+
+    void reload_memory();
+};
+
+class NativeCode {
+    AK_MAKE_NONCOPYABLE(NativeCode);
+    AK_MAKE_NONMOVABLE(NativeCode);
+
+public:
+    // Copies `machine_code` into executable memory.
+    static OwnPtr<NativeCode> create(ReadonlyBytes machine_code, StringView name);
+
+    ~NativeCode();
+
+    // Runs the function on the frame at `slots`, see LoweredFunction. Returns false if it trapped.
+    bool run(u64* slots, NativeContext&) const;
+
+    ReadonlyBytes code_bytes() const { return { m_code, m_size }; }
+
+private:
+    NativeCode(void* code, size_t size);
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    Optional<FixedArray<u8>> m_gdb_object;
+};
+
+}
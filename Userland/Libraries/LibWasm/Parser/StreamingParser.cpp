@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/LEB128.h>
+#include <AK/MemoryStream.h>
+#include <LibWasm/Parser/StreamingParser.h>
+
+namespace Wasm {
+
+// Returns the number of bytes taken by the LEB128 value at the start of `bytes`, or nothing if they end before it does.
+static Optional<size_t> leb128_size(ReadonlyBytes bytes)
+{
+    // A value that goes on for longer than any valid one will fail to parse, so there's no point in waiting for its end.
+    static constexpr size_t max_leb128_size = 10;
+    for (size_t i = 0; i < min(bytes.size(), max_leb128_size); ++i) {
+        if ((bytes[i] & 0x80) == 0)
+            return i + 1;
+    }
+    if (bytes.size() >= max_leb128_size)
+        return max_leb128_size;
+    return {};
+}
+
+template<typename T>
+static ParseResult<T> parse_leb128(ReadonlyBytes bytes, ParseError error)
+{
+    FixedMemoryStream stream { bytes };
+    auto value_or_error = stream.read_value<LEB128<T>>();
+    if (value_or_error.is_error())
+        return error;
+    return value_or_error.release_value();
+}
+
+// The position of a section in the order that sections have to appear in, or nothing for custom sections, which can go anywhere.
+static Optional<u8> section_order(u8 section_id)
+{
+    switch (section_id) {
+    case TypeSection::section_id:
+        return 1;
+    case ImportSection::section_id:
+        return 2;
+    case FunctionSection::section_id:
+        return 3;
+    case TableSection::section_id:
+        return 4;
+    case MemorySection::section_id:
+        return 5;
+    case GlobalSection::section_id:
+        return 6;
+    case ExportSection::section_id:
+        return 7;
+    case StartSection::section_id:
+        return 8;
+    case ElementSection::section_id:
+        return 9;
+    case DataCountSection::section_id:
+        return 10;
+    case CodeSection::section_id:
+        return 11;
+    case DataSection::section_id:
+        return 12;
+    default:
+        return {};
+    }
+}
+
+ParseResult<void> StreamingParser::append(ReadonlyBytes bytes)
+{
+    if (m_buffer.try_append(bytes).is_error())
+        return ParseError::OutOfMemory;
+
+    while (TRY(parse_next())) { }
+
+    // Only hold on to the bytes that haven't been parsed yet.
+    if (m_offset > 0) {
+        auto remaining_size = m_buffer.size() - m_offset;
+        memmove(m_buffer.data(), m_buffer.data() + m_offset, remaining_size);
+        m_buffer.resize(remaining_size);
+        m_offset = 0;
+    }
+    return {};
+}
+
+ParseResult<bool> StreamingParser::parse_next()
+{
+    switch (m_state) {
+    case State::Header:
+        return parse_header();
+    case State::SectionHeader:
+        return parse_section_header();
+    case State::Section:
+        return parse_section();
+    case State::FunctionCount:
+        return parse_function_count();
+    case State::FunctionBody:
+        return parse_function_body();
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ParseResult<bool> StreamingParser::parse_header()
+{
+    auto bytes = available_bytes();
+    if (bytes.size() < Module::wasm_magic.size())
+        return false;
+    if (bytes.trim(Module::wasm_magic.size()) != Module::wasm_magic.span())
+        return ParseError::InvalidModuleMagic;
+    if (bytes.size() < Module::wasm_magic.size() + Module::wasm_version.size())
+        return false;
+    if (bytes.slice(Module::wasm_magic.size(), Module::wasm_version.size()) != Module::wasm_version.span())
+        return ParseError::InvalidModuleVersion;
+
+    m_offset += Module::wasm_magic.size() + Module::wasm_version.size();
+    m_state = State::SectionHeader;
+    return true;
+}
+
+ParseResult<bool> StreamingParser::parse_section_header()
+{
+    auto bytes = available_bytes();
+    if (bytes.is_empty())
+        return false;
+    auto size_size = leb128_size(bytes.slice(1));
+    if (!size_size.has_value())
+        return false;
+
+    m_section_id = bytes[0];
+    m_section_size = TRY(parse_leb128<size_t>(bytes.slice(1, *size_size), ParseError::ExpectedSize));
+    m_offset += 1 + *size_size;
+
+    if (auto order = section_order(m_section_id); order.has_value()) {
+        if (*order <= m_last_section_order)
+            m_sections_are_in_order = false;
+        m_last_section_order = *order;
+    }
+
+    // Function bodies can only be validated early if nothing that they depend on can come after them.
+    if (m_section_id == CodeSection::section_id && m_sections_are_in_order)
+        m_state = State::FunctionCount;
+    else
+        m_state = State::Section;
+    return true;
+}
+
+ParseResult<bool> StreamingParser::parse_section()
+{
+    auto bytes = available_bytes();
+    if (bytes.size() < m_section_size)
+        return false;
+
+    FixedMemoryStream stream { bytes.trim(m_section_size) };
+    m_sections.append(TRY(Module::parse_section(m_section_id, stream)));
+    if (!stream.is_eof())
+        return ParseError::InvalidSize;
+
+    m_offset += m_section_size;
+    m_state = State::SectionHeader;
+    return true;
+}
+
+ParseResult<bool> StreamingParser::parse_function_count()
+{
+    auto bytes = available_bytes();
+    auto count_size = leb128_size(bytes);
+    if (!count_size.has_value())
+        return false;
+    if (*count_size > m_section_size)
+        return ParseError::InvalidSize;
+
+    m_function_count = TRY(parse_leb128<u32>(bytes.trim(*count_size), ParseError::ExpectedSize));
+    m_offset += *count_size;
+    m_section_size -= *count_size;
+
+    // Everything that the function bodies depend on is known by now.
+    Module sections_before_code { m_sections };
+    m_function_bodies_are_validated = !m_validator.begin_validating_function_bodies(sections_before_code).is_error();
+
+    m_state = State::FunctionBody;
+    return true;
+}
+
+ParseResult<bool> StreamingParser::parse_function_body()
+{
+    if (m_functions.size() == m_function_count) {
+        if (m_section_size != 0)
+            return ParseError::InvalidSize;
+        m_sections.append(CodeSection { move(m_functions) });
+        m_state = State::SectionHeader;
+        return true;
+    }
+
+    auto bytes = available_bytes();
+    auto size_size = leb128_size(bytes);
+    if (!size_size.has_value())
+        return false;
+    auto size = TRY(parse_leb128<u32>(bytes.trim(*size_size), ParseError::InvalidSize));
+    auto total_size = *size_size + size;
+    if (total_size > m_section_size)
+        return ParseError::InvalidSize;
+    if (bytes.size() < total_size)
+        return false;
+
+    FixedMemoryStream stream { bytes.trim(total_size) };
+    auto function = TRY(CodeSection::Code::parse(stream));
+    if (!stream.is_eof())
+        return ParseError::InvalidSize;
+
+    // If this fails, finish() validates the whole module again, which takes care of reporting the error.
+    if (m_function_bodies_are_validated)
+        m_function_bodies_are_validated = !m_validator.validate_function_body(m_functions.size(), function).is_error();
+
+    m_functions.append(move(function));
+    m_offset += total_size;
+    m_section_size -= total_size;
+    return true;
+}
+
+bool StreamingParser::function_bodies_were_validated_early() const
+{
+    if (!m_sections_are_in_order || !m_function_bodies_are_validated)
+        return false;
+
+    // The bodies were validated against the data count, so it has to match the data section.
+    Optional<u32> data_count;
+    size_t data_segment_count = 0;
+    for (auto& section : m_sections) {
+        if (auto* data_count_section = section.get_pointer<DataCountSection>())
+            data_count = data_count_section->count();
+        else if (auto* data_section = section.get_pointer<DataSection>())
+            data_segment_count = data_section->data().size();
+    }
+    return !data_count.has_value() || *data_count == data_segment_count;
+}
+
+ParseResult<Module> StreamingParser::finish()
+{
+    if (m_state != State::SectionHeader || m_offset != m_buffer.size())
+        return ParseError::UnexpectedEof;
+
+    auto function_bodies_are_validated = function_bodies_were_validated_early();
+    Module module { move(m_sections) };
+    if (module.validation_status() != Module::ValidationStatus::Unchecked)
+        return module;
+
+    auto result = function_bodies_are_validated ? m_validator.validate(module, Badge<StreamingParser> {}) : m_validator.validate(module);
+    if (result.is_error())
+        module.set_validation_error(result.release_error().error_string);
+    return module;
+}
+
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Vector.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+// Parses a module whose bytes arrive a few at a time, e.g. over the network.
+// Every section is parsed as soon as all of its bytes are in, and the bodies in the code section are parsed and
+// validated one by one as they arrive, so that little work is left once the last byte is.
+// The result is the same as that of Module::parse() followed by validating the module.
+class StreamingParser {
+public:
+    ParseResult<void> append(ReadonlyBytes);
+
+    // Returns the module, which has been validated already; see Module::validation_status().
+    ParseResult<Module> finish();
+
+private:
+    enum class State {
+        Header,
+        SectionHeader,
+        Section,
+        FunctionCount,
+        FunctionBody,
+    };
+
+    // Returns false if it needs more bytes to make progress.
+    ParseResult<bool> parse_next();
+    ParseResult<bool> parse_header();
+    ParseResult<bool> parse_section_header();
+    ParseResult<bool> parse_section();
+    ParseResult<bool> parse_function_count();
+    ParseResult<bool> parse_function_body();
+
+    ReadonlyBytes available_bytes() const { return m_buffer.bytes().slice(m_offset); }
+    bool function_bodies_were_validated_early() const;
+
+    ByteBuffer m_buffer;
+    size_t m_offset { 0 };
+    State m_state { State::Header };
+
+    u8 m_section_id { 0 };
+    size_t m_section_size { 0 };
+    u8 m_last_section_order { 0 };
+    bool m_sections_are_in_order { true };
+    Vector<Module::AnySection> m_sections;
+
+    size_t m_function_count { 0 };
+    Vector<CodeSection::Code> m_functions;
+
+    Validator m_validator;
+    bool m_function_bodies_are_validated { false };
+};
+
+}
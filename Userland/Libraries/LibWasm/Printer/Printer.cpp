@@ -18,7 +18,11 @@ struct Names {
 
 ByteString instruction_name(OpCode const& opcode)
 {
-    return Names::instruction_names.get(opcode).value_or("<unknown>");
+    // NOTE: The validator calls this from several threads at once, so this must not share the names' (non-atomic) reference counts.
+    auto it = Names::instruction_names.find(opcode);
+    if (it == Names::instruction_names.end())
+        return "<unknown>";
+    return ByteString { it->value.view() };
 }
 
 Optional<OpCode> instruction_from_name(StringView name)
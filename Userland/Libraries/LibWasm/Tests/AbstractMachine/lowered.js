@@ -0,0 +1,174 @@
+// A module whose functions are lowered by the validator, with these exports:
+//   fib(n) -> i32, recursively; sumOfSquares(n) -> i64 and factorial(n: i64) -> i64, in loops;
+//   switchConstant(n) and switchLocal(n), which br_table out of nested blocks with a value;
+//   select(a, b, condition); counter(), which increments a global; storeAndLoad(address, value: i64) -> i64;
+//   divide(a, b); unreachable(); callIndirect(index, x), through a table of [fib, double, sumOfSquares];
+//   fallback(x), which can't be lowered as it uses references, and viaFallback(x), which calls it;
+//   loopWithParameter(n) -> n * (n - 1) / 2; hypot(a: f64, b: f64); truncate(x: f64) -> i32;
+//   growAndStore(pages), which writes to the end of the grown memory; subtractSwapped(a, b) and
+//   subtractSwappedFallback(a, b), which call functions with two results; recurseForever(x);
+//   deadCode(x), with instructions after branches; teeChain(x) and swapLocals(a, b), which shuffle locals.
+// prettier-ignore
+const binary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x3c, 0x0b, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x60, 0x01, 0x7f, 0x01, 0x7e, 0x60, 0x03, 0x7f, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x00, 0x01, 0x7f,
+    0x60, 0x02, 0x7f, 0x7e, 0x01, 0x7e, 0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x00, 0x00, 0x60,
+    0x02, 0x7c, 0x7c, 0x01, 0x7c, 0x60, 0x01, 0x7c, 0x01, 0x7f, 0x60, 0x01, 0x7e, 0x01, 0x7e, 0x60,
+    0x02, 0x7f, 0x7f, 0x02, 0x7f, 0x7f, 0x03, 0x1b, 0x1a, 0x00, 0x01, 0x00, 0x00, 0x02, 0x03, 0x04,
+    0x05, 0x06, 0x00, 0x05, 0x00, 0x00, 0x00, 0x07, 0x08, 0x09, 0x00, 0x0a, 0x05, 0x0a, 0x05, 0x00,
+    0x00, 0x00, 0x05, 0x04, 0x04, 0x01, 0x70, 0x00, 0x03, 0x05, 0x04, 0x01, 0x01, 0x01, 0x04, 0x06,
+    0x06, 0x01, 0x7f, 0x01, 0x41, 0x00, 0x0b, 0x07, 0xc1, 0x02, 0x18, 0x03, 0x66, 0x69, 0x62, 0x00,
+    0x00, 0x0c, 0x73, 0x75, 0x6d, 0x4f, 0x66, 0x53, 0x71, 0x75, 0x61, 0x72, 0x65, 0x73, 0x00, 0x01,
+    0x0e, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x00,
+    0x02, 0x0b, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x4c, 0x6f, 0x63, 0x61, 0x6c, 0x00, 0x03, 0x06,
+    0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x00, 0x04, 0x07, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72,
+    0x00, 0x05, 0x0c, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x41, 0x6e, 0x64, 0x4c, 0x6f, 0x61, 0x64, 0x00,
+    0x06, 0x06, 0x64, 0x69, 0x76, 0x69, 0x64, 0x65, 0x00, 0x07, 0x0b, 0x75, 0x6e, 0x72, 0x65, 0x61,
+    0x63, 0x68, 0x61, 0x62, 0x6c, 0x65, 0x00, 0x08, 0x06, 0x64, 0x6f, 0x75, 0x62, 0x6c, 0x65, 0x00,
+    0x09, 0x0c, 0x63, 0x61, 0x6c, 0x6c, 0x49, 0x6e, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x00, 0x0a,
+    0x08, 0x66, 0x61, 0x6c, 0x6c, 0x62, 0x61, 0x63, 0x6b, 0x00, 0x0b, 0x0b, 0x76, 0x69, 0x61, 0x46,
+    0x61, 0x6c, 0x6c, 0x62, 0x61, 0x63, 0x6b, 0x00, 0x0c, 0x11, 0x6c, 0x6f, 0x6f, 0x70, 0x57, 0x69,
+    0x74, 0x68, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x00, 0x0d, 0x05, 0x68, 0x79,
+    0x70, 0x6f, 0x74, 0x00, 0x0e, 0x08, 0x74, 0x72, 0x75, 0x6e, 0x63, 0x61, 0x74, 0x65, 0x00, 0x0f,
+    0x09, 0x66, 0x61, 0x63, 0x74, 0x6f, 0x72, 0x69, 0x61, 0x6c, 0x00, 0x10, 0x0c, 0x67, 0x72, 0x6f,
+    0x77, 0x41, 0x6e, 0x64, 0x53, 0x74, 0x6f, 0x72, 0x65, 0x00, 0x11, 0x0f, 0x73, 0x75, 0x62, 0x74,
+    0x72, 0x61, 0x63, 0x74, 0x53, 0x77, 0x61, 0x70, 0x70, 0x65, 0x64, 0x00, 0x13, 0x17, 0x73, 0x75,
+    0x62, 0x74, 0x72, 0x61, 0x63, 0x74, 0x53, 0x77, 0x61, 0x70, 0x70, 0x65, 0x64, 0x46, 0x61, 0x6c,
+    0x6c, 0x62, 0x61, 0x63, 0x6b, 0x00, 0x15, 0x0e, 0x72, 0x65, 0x63, 0x75, 0x72, 0x73, 0x65, 0x46,
+    0x6f, 0x72, 0x65, 0x76, 0x65, 0x72, 0x00, 0x16, 0x08, 0x64, 0x65, 0x61, 0x64, 0x43, 0x6f, 0x64,
+    0x65, 0x00, 0x17, 0x08, 0x74, 0x65, 0x65, 0x43, 0x68, 0x61, 0x69, 0x6e, 0x00, 0x18, 0x0a, 0x73,
+    0x77, 0x61, 0x70, 0x4c, 0x6f, 0x63, 0x61, 0x6c, 0x73, 0x00, 0x19, 0x09, 0x09, 0x01, 0x00, 0x41,
+    0x00, 0x0b, 0x03, 0x00, 0x09, 0x01, 0x0a, 0xdb, 0x03, 0x1a, 0x1c, 0x00, 0x20, 0x00, 0x41, 0x02,
+    0x48, 0x04, 0x7f, 0x20, 0x00, 0x05, 0x20, 0x00, 0x41, 0x01, 0x6b, 0x10, 0x00, 0x20, 0x00, 0x41,
+    0x02, 0x6b, 0x10, 0x00, 0x6a, 0x0b, 0x0b, 0x2a, 0x02, 0x01, 0x7e, 0x01, 0x7f, 0x02, 0x40, 0x03,
+    0x40, 0x20, 0x02, 0x20, 0x00, 0x4e, 0x0d, 0x01, 0x20, 0x01, 0x20, 0x02, 0xac, 0x20, 0x02, 0xac,
+    0x7e, 0x7c, 0x21, 0x01, 0x20, 0x02, 0x41, 0x01, 0x6a, 0x21, 0x02, 0x0c, 0x00, 0x0b, 0x0b, 0x20,
+    0x01, 0x0b, 0x1a, 0x00, 0x02, 0x7f, 0x02, 0x7f, 0x02, 0x7f, 0x41, 0x0a, 0x20, 0x00, 0x0e, 0x02,
+    0x00, 0x01, 0x02, 0x0b, 0x41, 0x01, 0x6a, 0x0b, 0x41, 0x02, 0x6c, 0x0b, 0x0b, 0x1a, 0x00, 0x02,
+    0x7f, 0x02, 0x7f, 0x02, 0x7f, 0x20, 0x00, 0x20, 0x00, 0x0e, 0x02, 0x00, 0x01, 0x02, 0x0b, 0x41,
+    0x01, 0x6a, 0x0b, 0x41, 0x02, 0x6c, 0x0b, 0x0b, 0x09, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02,
+    0x1b, 0x0b, 0x0b, 0x00, 0x23, 0x00, 0x41, 0x01, 0x6a, 0x24, 0x00, 0x23, 0x00, 0x0b, 0x15, 0x00,
+    0x20, 0x00, 0x20, 0x01, 0x37, 0x03, 0x00, 0x20, 0x00, 0x29, 0x03, 0x00, 0x20, 0x00, 0x2c, 0x00,
+    0x00, 0xac, 0x7c, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x6d, 0x0b, 0x03, 0x00, 0x00, 0x0b,
+    0x07, 0x00, 0x20, 0x00, 0x41, 0x02, 0x6c, 0x0b, 0x09, 0x00, 0x20, 0x01, 0x20, 0x00, 0x11, 0x00,
+    0x00, 0x0b, 0x0a, 0x00, 0xd0, 0x70, 0xd1, 0x1a, 0x20, 0x00, 0x10, 0x00, 0x0b, 0x09, 0x00, 0x20,
+    0x00, 0x10, 0x0b, 0x41, 0x01, 0x6a, 0x0b, 0x21, 0x02, 0x01, 0x7f, 0x01, 0x7f, 0x20, 0x00, 0x03,
+    0x00, 0x41, 0x01, 0x6b, 0x22, 0x01, 0x20, 0x02, 0x20, 0x01, 0x6a, 0x21, 0x02, 0x20, 0x01, 0x41,
+    0x00, 0x4a, 0x0d, 0x00, 0x0b, 0x20, 0x02, 0x6a, 0x0b, 0x0e, 0x00, 0x20, 0x00, 0x20, 0x00, 0xa2,
+    0x20, 0x01, 0x20, 0x01, 0xa2, 0xa0, 0x9f, 0x0b, 0x05, 0x00, 0x20, 0x00, 0xaa, 0x0b, 0x27, 0x01,
+    0x01, 0x7e, 0x42, 0x01, 0x21, 0x01, 0x02, 0x40, 0x03, 0x40, 0x20, 0x00, 0x42, 0x01, 0x57, 0x0d,
+    0x01, 0x20, 0x01, 0x20, 0x00, 0x7e, 0x21, 0x01, 0x20, 0x00, 0x42, 0x01, 0x7d, 0x21, 0x00, 0x0c,
+    0x00, 0x0b, 0x0b, 0x20, 0x01, 0x0b, 0x2a, 0x01, 0x01, 0x7f, 0x20, 0x00, 0x40, 0x00, 0x21, 0x01,
+    0x3f, 0x00, 0x41, 0x80, 0x80, 0x04, 0x6c, 0x41, 0x04, 0x6b, 0x41, 0xcd, 0x00, 0x36, 0x02, 0x00,
+    0x3f, 0x00, 0x41, 0x80, 0x80, 0x04, 0x6c, 0x41, 0x04, 0x6b, 0x28, 0x02, 0x00, 0x20, 0x01, 0x6a,
+    0x0b, 0x06, 0x00, 0x20, 0x01, 0x20, 0x00, 0x0b, 0x09, 0x00, 0x20, 0x00, 0x20, 0x01, 0x10, 0x12,
+    0x6b, 0x0b, 0x09, 0x00, 0xd0, 0x70, 0x1a, 0x20, 0x01, 0x20, 0x00, 0x0b, 0x09, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x10, 0x14, 0x6b, 0x0b, 0x06, 0x00, 0x20, 0x00, 0x10, 0x16, 0x0b, 0x1b, 0x00, 0x02,
+    0x40, 0x0c, 0x00, 0x41, 0x01, 0x1a, 0x02, 0x40, 0x00, 0x0b, 0x0b, 0x20, 0x00, 0x04, 0x40, 0x41,
+    0x01, 0x0f, 0x41, 0x05, 0x1a, 0x0b, 0x41, 0x02, 0x0b, 0x17, 0x02, 0x01, 0x7f, 0x01, 0x7f, 0x20,
+    0x00, 0x41, 0x01, 0x6a, 0x22, 0x01, 0x21, 0x02, 0x20, 0x01, 0x20, 0x02, 0x6c, 0x20, 0x00, 0x6a,
+    0x0b, 0x12, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x00, 0x21, 0x01, 0x20, 0x00, 0x41, 0x0a, 0x6c,
+    0x20, 0x01, 0x6a, 0x0b,
+
+]);
+
+const instantiate = () => parseWebAssemblyModule(binary);
+
+const call = (module, name, ...args) => module.invoke(module.getExport(name), ...args);
+
+const trap = reason => `Execution trapped: ${reason}`;
+
+test("calls and loops", () => {
+    const module = instantiate();
+    expect(call(module, "fib", 10)).toBe(55);
+    expect(call(module, "fib", 20)).toBe(6765);
+    expect(call(module, "sumOfSquares", 100)).toBe(328350n);
+    expect(call(module, "factorial", 20n)).toBe(2432902008176640000n);
+    expect(call(module, "loopWithParameter", 10)).toBe(45);
+});
+
+test("branch tables carry values out of blocks", () => {
+    const module = instantiate();
+    expect(call(module, "switchConstant", 0)).toBe(22);
+    expect(call(module, "switchConstant", 1)).toBe(20);
+    expect(call(module, "switchConstant", 2)).toBe(10);
+    expect(call(module, "switchConstant", 3)).toBe(10);
+    expect(call(module, "switchConstant", -1)).toBe(10);
+    expect(call(module, "switchLocal", 0)).toBe(2);
+    expect(call(module, "switchLocal", 1)).toBe(2);
+    expect(call(module, "switchLocal", 2)).toBe(2);
+    expect(call(module, "switchLocal", 3)).toBe(3);
+    expect(call(module, "switchLocal", -1)).toBe(-1);
+});
+
+test("locals, globals and memory", () => {
+    const module = instantiate();
+    expect(call(module, "select", 1, 2, 1)).toBe(1);
+    expect(call(module, "select", 1, 2, 0)).toBe(2);
+    expect(call(module, "counter")).toBe(1);
+    expect(call(module, "counter")).toBe(2);
+    expect(call(module, "storeAndLoad", 8, -2n)).toBe(-4n);
+    expect(call(module, "growAndStore", 1)).toBe(78);
+    expect(call(module, "growAndStore", 5)).toBe(76);
+    expect(call(module, "teeChain", 4)).toBe(29);
+    expect(call(module, "swapLocals", 1, 2)).toBe(21);
+    expect(call(module, "deadCode", 0)).toBe(2);
+    expect(call(module, "deadCode", 1)).toBe(1);
+    expect(call(module, "hypot", 3, 4)).toBe(5);
+    expect(call(module, "truncate", -3.7)).toBe(-3);
+});
+
+test("calls to other functions", () => {
+    const module = instantiate();
+    expect(call(module, "callIndirect", 0, 10)).toBe(55);
+    expect(call(module, "callIndirect", 1, 21)).toBe(42);
+    expect(call(module, "fallback", 10)).toBe(55);
+    expect(call(module, "viaFallback", 10)).toBe(56);
+    expect(call(module, "subtractSwapped", 3, 10)).toBe(7);
+    expect(call(module, "subtractSwappedFallback", 3, 10)).toBe(7);
+});
+
+test("traps", () => {
+    const module = instantiate();
+    expect(() => call(module, "storeAndLoad", 65530, 1n)).toThrowWithMessage(TypeError, trap("Memory access out of bounds"));
+    expect(() => call(module, "divide", 7, 0)).toThrow(TypeError);
+    expect(() => call(module, "divide", -2147483648, -1)).toThrow(TypeError);
+    expect(() => call(module, "truncate", NaN)).toThrow(TypeError);
+    expect(() => call(module, "unreachable")).toThrowWithMessage(TypeError, trap("Unreachable"));
+    expect(() => call(module, "callIndirect", 2, 1)).toThrowWithMessage(TypeError, trap("Indirect call type mismatch"));
+    expect(() => call(module, "callIndirect", 3, 1)).toThrowWithMessage(TypeError, trap("Undefined element in indirect call"));
+    expect(() => call(module, "recurseForever", 1)).toThrowWithMessage(TypeError, trap("Call stack exhausted"));
+
+    // A trap must not leave anything behind that affects later calls.
+    expect(call(module, "fib", 10)).toBe(55);
+    expect(call(module, "subtractSwappedFallback", 3, 10)).toBe(7);
+});
+
+test("hot functions behave the same", () => {
+    // Functions that have been called often enough run as native code when the JIT is enabled.
+    const module = instantiate();
+    for (let i = 0; i < 8; ++i) {
+        expect(call(module, "fib", 15)).toBe(610);
+        expect(call(module, "sumOfSquares", 100)).toBe(328350n);
+        expect(call(module, "factorial", 20n)).toBe(2432902008176640000n);
+        expect(call(module, "loopWithParameter", 10)).toBe(45);
+        expect(call(module, "switchConstant", i - 1)).toBe([10, 22, 20, 10, 10, 10, 10, 10][i]);
+        expect(call(module, "switchLocal", i - 1)).toBe([-1, 2, 2, 2, 3, 4, 5, 6][i]);
+        expect(call(module, "select", 1, 2, i % 2)).toBe(2 - (i % 2));
+        expect(call(module, "counter")).toBe(i + 1);
+        expect(call(module, "storeAndLoad", 8 * i, -2n)).toBe(-4n);
+        expect(call(module, "teeChain", 4)).toBe(29);
+        expect(call(module, "swapLocals", 1, 2)).toBe(21);
+        expect(call(module, "deadCode", i % 2)).toBe(2 - (i % 2));
+        expect(call(module, "hypot", 3, 4)).toBe(5);
+        expect(call(module, "truncate", -3.7)).toBe(-3);
+        expect(call(module, "callIndirect", 1, 21)).toBe(42);
+        expect(call(module, "viaFallback", 10)).toBe(56);
+        expect(call(module, "subtractSwapped", 3, 10)).toBe(7);
+        expect(() => call(module, "storeAndLoad", 65530, 1n)).toThrowWithMessage(TypeError, trap("Memory access out of bounds"));
+        expect(() => call(module, "divide", 7, 0)).toThrow(TypeError);
+        expect(() => call(module, "unreachable")).toThrowWithMessage(TypeError, trap("Unreachable"));
+        expect(() => call(module, "callIndirect", 2, 1)).toThrowWithMessage(TypeError, trap("Indirect call type mismatch"));
+    }
+    expect(call(module, "growAndStore", 1)).toBe(78);
+});
@@ -0,0 +1,84 @@
+// A module with one memory of 1 page that can grow to 4 pages, and these exports:
+//   load(address) -> i32, store(address, value), loadFar(address) -> i32 with an offset of 0xfffffff0,
+//   grow(pages) -> i32, size() -> i32, fill(address, value, count), loadVector(address) -> v128,
+//   loadViaCall(address) -> i32 which calls load().
+// prettier-ignore
+const binary = new Uint8Array([
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x1a, 0x05, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+        0x60, 0x02, 0x7f, 0x7f, 0x00, 0x60, 0x00, 0x01, 0x7f, 0x60, 0x03, 0x7f, 0x7f, 0x7f, 0x00, 0x60,
+        0x01, 0x7f, 0x01, 0x7b, 0x03, 0x09, 0x08, 0x00, 0x01, 0x00, 0x00, 0x02, 0x03, 0x04, 0x00, 0x05,
+        0x04, 0x01, 0x01, 0x01, 0x04, 0x07, 0x4a, 0x08, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x00, 0x05,
+        0x73, 0x74, 0x6f, 0x72, 0x65, 0x00, 0x01, 0x07, 0x6c, 0x6f, 0x61, 0x64, 0x46, 0x61, 0x72, 0x00,
+        0x02, 0x04, 0x67, 0x72, 0x6f, 0x77, 0x00, 0x03, 0x04, 0x73, 0x69, 0x7a, 0x65, 0x00, 0x04, 0x04,
+        0x66, 0x69, 0x6c, 0x6c, 0x00, 0x05, 0x0a, 0x6c, 0x6f, 0x61, 0x64, 0x56, 0x65, 0x63, 0x74, 0x6f,
+        0x72, 0x00, 0x06, 0x0b, 0x6c, 0x6f, 0x61, 0x64, 0x56, 0x69, 0x61, 0x43, 0x61, 0x6c, 0x6c, 0x00,
+        0x07, 0x0a, 0x47, 0x08, 0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x00, 0x0b, 0x09, 0x00, 0x20, 0x00,
+        0x20, 0x01, 0x36, 0x02, 0x00, 0x0b, 0x0b, 0x00, 0x20, 0x00, 0x28, 0x02, 0xf0, 0xff, 0xff, 0xff,
+        0x0f, 0x0b, 0x06, 0x00, 0x20, 0x00, 0x40, 0x00, 0x0b, 0x04, 0x00, 0x3f, 0x00, 0x0b, 0x0b, 0x00,
+        0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0xfc, 0x0b, 0x00, 0x0b, 0x08, 0x00, 0x20, 0x00, 0xfd, 0x00,
+        0x04, 0x00, 0x0b, 0x06, 0x00, 0x20, 0x00, 0x10, 0x00, 0x0b,
+]);
+
+const pageSize = 65536;
+
+const instantiate = () => parseWebAssemblyModule(binary);
+
+const call = (module, name, ...args) => module.invoke(module.getExport(name), ...args);
+
+const outOfBounds = "Execution trapped: Memory access out of bounds";
+
+test("loads and stores inside the memory", () => {
+    const module = instantiate();
+    call(module, "store", 0, 42);
+    call(module, "store", pageSize - 4, 1234);
+    expect(call(module, "load", 0)).toBe(42);
+    expect(call(module, "load", pageSize - 4)).toBe(1234);
+    expect(call(module, "load", 4)).toBe(0);
+    expect(call(module, "loadViaCall", pageSize - 4)).toBe(1234);
+});
+
+test("accesses past the end of the memory trap", () => {
+    const module = instantiate();
+    expect(() => call(module, "load", pageSize - 3)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => call(module, "load", pageSize)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => call(module, "load", -4)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => call(module, "store", pageSize - 2, 1)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => call(module, "loadFar", 0)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => call(module, "loadFar", -1)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => call(module, "loadVector", pageSize - 15)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => call(module, "loadViaCall", pageSize)).toThrowWithMessage(TypeError, outOfBounds);
+
+    // A trap must not leave anything behind that affects later calls.
+    expect(call(module, "loadVector", pageSize - 16)).toBe(0n);
+    expect(call(module, "load", pageSize - 4)).toBe(0);
+});
+
+test("growing makes more of the memory accessible", () => {
+    const module = instantiate();
+    call(module, "store", 8, 7);
+    expect(call(module, "grow", 1)).toBe(1);
+    expect(call(module, "size")).toBe(2);
+
+    expect(call(module, "load", 8)).toBe(7);
+    expect(call(module, "load", pageSize)).toBe(0);
+    call(module, "store", 2 * pageSize - 4, 99);
+    expect(call(module, "load", 2 * pageSize - 4)).toBe(99);
+    expect(() => call(module, "load", 2 * pageSize)).toThrowWithMessage(TypeError, outOfBounds);
+
+    expect(call(module, "grow", 3)).toBe(-1);
+    expect(call(module, "size")).toBe(2);
+    expect(() => call(module, "load", 2 * pageSize)).toThrowWithMessage(TypeError, outOfBounds);
+
+    expect(call(module, "grow", 2)).toBe(2);
+    expect(call(module, "load", 4 * pageSize - 4)).toBe(0);
+});
+
+test("bulk memory operations check the whole range before writing", () => {
+    const module = instantiate();
+    expect(() => call(module, "fill", pageSize - 4, 0xff, 8)).toThrow(TypeError);
+    expect(() => call(module, "fill", -1, 0xff, 1)).toThrow(TypeError);
+    expect(call(module, "load", pageSize - 4)).toBe(0);
+
+    call(module, "fill", pageSize - 4, 0x11, 4);
+    expect(call(module, "load", pageSize - 4) & 0xff).toBe(0x11);
+});
@@ -0,0 +1,289 @@
+const uleb128 = value => {
+    const bytes = [];
+    do {
+        let byte = value & 0x7f;
+        value >>>= 7;
+        if (value !== 0) byte |= 0x80;
+        bytes.push(byte);
+    } while (value !== 0);
+    return bytes;
+};
+
+const section = (id, contents) => [id, ...uleb128(contents.length), ...contents];
+
+// A module exporting "f", a function without parameters that runs `body` and returns a value of `resultType`.
+// If `memory` is given, the module has a memory of one page that starts with these bytes.
+const buildModule = (body, resultType, memory) => {
+    const bytes = [0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00];
+    bytes.push(...section(1, [0x01, 0x60, 0x00, 0x01, resultType]));
+    bytes.push(...section(3, [0x01, 0x00]));
+    if (memory) bytes.push(...section(5, [0x01, 0x00, 0x01]));
+    bytes.push(...section(7, [0x01, 0x01, 0x66, 0x00, 0x00]));
+    const code = [0x00, ...body, 0x0b];
+    bytes.push(...section(10, [0x01, ...uleb128(code.length), ...code]));
+    if (memory) bytes.push(...section(11, [0x01, 0x00, 0x41, 0x00, 0x0b, ...uleb128(memory.length), ...memory]));
+    return new Uint8Array(bytes);
+};
+
+const v128 = 0x7b;
+const i32 = 0x7f;
+
+const run = (body, resultType = v128, memory = null) => {
+    const module = parseWebAssemblyModule(buildModule(body, resultType, memory));
+    return module.invoke(module.getExport("f"));
+};
+
+const simd = opcode => [0xfd, ...uleb128(opcode)];
+const i32Const = value => [0x41, value];
+const vectorConst = (Type, lanes) => [0xfd, 0x0c, ...new Uint8Array(new Type(lanes).buffer)];
+
+// test-wasm hands out v128 values as BigInts whose most significant byte is the first byte of the vector.
+const lanesOf = (Type, value) => {
+    const hex = value.toString(16).padStart(32, "0");
+    const bytes = Uint8Array.from({ length: 16 }, (_, i) => parseInt(hex.slice(2 * i, 2 * i + 2), 16));
+    return Array.from(new Type(bytes.buffer));
+};
+
+const unary = (opcode, Type, a, ResultType = Type) => lanesOf(ResultType, run([...vectorConst(Type, a), ...simd(opcode)]));
+
+const binary = (opcode, Type, a, b, ResultType = Type) =>
+    lanesOf(ResultType, run([...vectorConst(Type, a), ...vectorConst(Type, b), ...simd(opcode)]));
+
+const zip = (a, b, f) => a.map((x, i) => f(x, b[i]));
+const clamp = (value, min, max) => Math.min(Math.max(value, min), max);
+
+// Tells -0 and NaN apart from their lookalikes in toEqual().
+const showZeroSigns = lanes => lanes.map(x => (Object.is(x, -0) ? "-0" : String(x)));
+
+const a8 = [-128, -127, -1, 0, 1, 2, 100, 127, -100, 50, 60, -60, 5, -5, 127, -128];
+const b8 = [-1, -128, -1, 0, 127, -2, 100, 1, -100, 100, -70, 70, 3, -7, 127, -128];
+const u8 = lanes => Array.from(new Uint8Array(lanes));
+const a16 = [-32768, 32767, -1, 0, 1000, -1000, 20000, -20000];
+const b16 = [-1, 1, 32767, -32768, 30000, -30000, 20000, -20000];
+const u16 = lanes => Array.from(new Uint16Array(lanes));
+
+test("8-bit integer arithmetic", () => {
+    expect(binary(110, Int8Array, a8, b8)).toEqual(Array.from(new Int8Array(zip(a8, b8, (a, b) => a + b))));
+    expect(binary(113, Int8Array, a8, b8)).toEqual(Array.from(new Int8Array(zip(a8, b8, (a, b) => a - b))));
+    expect(binary(111, Int8Array, a8, b8)).toEqual(zip(a8, b8, (a, b) => clamp(a + b, -128, 127)));
+    expect(binary(114, Int8Array, a8, b8)).toEqual(zip(a8, b8, (a, b) => clamp(a - b, -128, 127)));
+    expect(binary(112, Uint8Array, a8, b8)).toEqual(zip(u8(a8), u8(b8), (a, b) => clamp(a + b, 0, 255)));
+    expect(binary(115, Uint8Array, a8, b8)).toEqual(zip(u8(a8), u8(b8), (a, b) => clamp(a - b, 0, 255)));
+    expect(binary(118, Int8Array, a8, b8)).toEqual(zip(a8, b8, Math.min));
+    expect(binary(119, Uint8Array, a8, b8)).toEqual(zip(u8(a8), u8(b8), Math.min));
+    expect(binary(120, Int8Array, a8, b8)).toEqual(zip(a8, b8, Math.max));
+    expect(binary(121, Uint8Array, a8, b8)).toEqual(zip(u8(a8), u8(b8), Math.max));
+    expect(binary(123, Uint8Array, a8, b8)).toEqual(zip(u8(a8), u8(b8), (a, b) => (a + b + 1) >> 1));
+});
+
+test("16-bit integer arithmetic", () => {
+    expect(binary(143, Int16Array, a16, b16)).toEqual(zip(a16, b16, (a, b) => clamp(a + b, -32768, 32767)));
+    expect(binary(146, Int16Array, a16, b16)).toEqual(zip(a16, b16, (a, b) => clamp(a - b, -32768, 32767)));
+    expect(binary(144, Uint16Array, a16, b16)).toEqual(zip(u16(a16), u16(b16), (a, b) => clamp(a + b, 0, 65535)));
+    expect(binary(147, Uint16Array, a16, b16)).toEqual(zip(u16(a16), u16(b16), (a, b) => clamp(a - b, 0, 65535)));
+    expect(binary(149, Int16Array, a16, b16)).toEqual(Array.from(new Int16Array(zip(a16, b16, Math.imul))));
+    expect(binary(150, Int16Array, a16, b16)).toEqual(zip(a16, b16, Math.min));
+    expect(binary(153, Uint16Array, a16, b16)).toEqual(zip(u16(a16), u16(b16), Math.max));
+    expect(binary(155, Uint16Array, a16, b16)).toEqual(zip(u16(a16), u16(b16), (a, b) => (a + b + 1) >> 1));
+    const q15 = (a, b) => clamp(Math.floor((a * b + 0x4000) / 0x8000), -32768, 32767);
+    expect(binary(130, Int16Array, a16, b16)).toEqual(zip(a16, b16, q15));
+    expect(binary(130, Int16Array, new Array(8).fill(-32768), new Array(8).fill(-32768))[0]).toBe(32767);
+});
+
+test("32-bit and 64-bit integer arithmetic", () => {
+    const a32 = [-2147483648, 2147483647, 65536, -7];
+    const b32 = [2, 2, 65536, 3];
+    expect(binary(174, Int32Array, a32, b32)).toEqual(Array.from(new Int32Array(zip(a32, b32, (a, b) => a + b))));
+    expect(binary(181, Int32Array, a32, b32)).toEqual(zip(a32, b32, Math.imul));
+    expect(binary(182, Int32Array, a32, b32)).toEqual(zip(a32, b32, Math.min));
+    expect(binary(185, Uint32Array, a32, b32)).toEqual(zip(Array.from(new Uint32Array(a32)), b32, Math.max));
+
+    const a64 = [-9223372036854775808n, 0x123456789n];
+    const b64 = [-1n, 0x987654321n];
+    expect(binary(206, BigInt64Array, a64, b64)).toEqual(zip(a64, b64, (a, b) => BigInt.asIntN(64, a + b)));
+    expect(binary(209, BigInt64Array, a64, b64)).toEqual(zip(a64, b64, (a, b) => BigInt.asIntN(64, a - b)));
+    expect(binary(213, BigInt64Array, a64, b64)).toEqual(zip(a64, b64, (a, b) => BigInt.asIntN(64, a * b)));
+    expect(binary(216, BigInt64Array, a64, b64)).toEqual(zip(a64, b64, (a, b) => (a < b ? -1n : 0n)));
+    expect(binary(219, BigInt64Array, b64, a64)).toEqual(zip(b64, a64, (a, b) => (a >= b ? -1n : 0n)));
+});
+
+test("signed comparisons, shifts and lanes", () => {
+    expect(binary(37, Int8Array, a8, b8)).toEqual(zip(a8, b8, (a, b) => (a < b ? -1 : 0)));
+    expect(binary(38, Uint8Array, a8, b8, Int8Array)).toEqual(zip(u8(a8), u8(b8), (a, b) => (a < b ? -1 : 0)));
+    expect(binary(47, Int16Array, a16, b16)).toEqual(zip(a16, b16, (a, b) => (a < b ? -1 : 0)));
+
+    const shift = (opcode, Type, lanes, count) => lanesOf(Type, run([...vectorConst(Type, lanes), ...i32Const(count), ...simd(opcode)]));
+    expect(shift(108, Int8Array, a8, 3)).toEqual(a8.map(a => a >> 3));
+    expect(shift(109, Uint8Array, a8, 11)).toEqual(u8(a8).map(a => a >> 3));
+    expect(shift(140, Int16Array, a16, 17)).toEqual(a16.map(a => a >> 1));
+    expect(shift(107, Int8Array, a8, 1)).toEqual(Array.from(new Int8Array(a8.map(a => a << 1))));
+
+    expect(run([...vectorConst(Int8Array, a8), ...simd(21), 1], i32)).toBe(-127);
+    expect(run([...vectorConst(Int8Array, a8), ...simd(22), 1], i32)).toBe(129);
+    expect(run([...vectorConst(Int16Array, a16), ...simd(24), 5], i32)).toBe(-1000);
+});
+
+test("abs, neg and popcnt", () => {
+    expect(unary(96, Int8Array, a8)).toEqual(Array.from(new Int8Array(a8.map(Math.abs))));
+    expect(unary(97, Int8Array, a8)).toEqual(Array.from(new Int8Array(a8.map(a => -a))));
+    expect(unary(128, Int16Array, a16)).toEqual(Array.from(new Int16Array(a16.map(Math.abs))));
+    expect(unary(160, Int32Array, [-2147483648, -5, 5, 0])).toEqual([-2147483648, 5, 5, 0]);
+    expect(unary(193, BigInt64Array, [-9223372036854775808n, 7n])).toEqual([-9223372036854775808n, -7n]);
+    const popcount = value => value.toString(2).replaceAll("0", "").length;
+    expect(unary(98, Uint8Array, a8)).toEqual(u8(a8).map(popcount));
+});
+
+test("reductions", () => {
+    const reduce = (opcode, Type, lanes) => run([...vectorConst(Type, lanes), ...simd(opcode)], i32);
+    expect(reduce(83, Int8Array, new Array(16).fill(0))).toBe(0);
+    expect(reduce(83, Int8Array, [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1])).toBe(1);
+    expect(reduce(99, Int8Array, a8)).toBe(0);
+    expect(reduce(99, Int8Array, new Array(16).fill(3))).toBe(1);
+    expect(reduce(131, Int16Array, [1, 2, 3, 4, 5, 6, 7, 256])).toBe(1);
+    expect(reduce(163, Int32Array, [1, 0, 3, 4])).toBe(0);
+    expect(reduce(195, BigInt64Array, [1n << 40n, -1n])).toBe(1);
+
+    const bitmask = lanes => lanes.reduce((mask, lane, i) => mask | ((lane < 0 ? 1 : 0) << i), 0);
+    expect(reduce(100, Int8Array, a8)).toBe(bitmask(a8));
+    expect(reduce(132, Int16Array, a16)).toBe(bitmask(a16));
+    expect(reduce(164, Int32Array, [-1, 1, -2147483648, 0])).toBe(0b0101);
+    expect(reduce(196, BigInt64Array, [1n, -1n])).toBe(0b10);
+});
+
+test("widening and narrowing", () => {
+    const aWide = [-30000, -129, -128, 127, 128, 255, 256, 30000];
+    expect(binary(101, Int16Array, a16, aWide, Int8Array)).toEqual([...a16, ...aWide].map(a => clamp(a, -128, 127)));
+    expect(binary(102, Int16Array, a16, aWide, Uint8Array)).toEqual([...a16, ...aWide].map(a => clamp(a, 0, 255)));
+    const a32 = [-100000, -1, 40000, 70000];
+    expect(binary(134, Int32Array, a32, [0, 65535, 65536, -65536], Uint16Array)).toEqual(
+        [...a32, 0, 65535, 65536, -65536].map(a => clamp(a, 0, 65535))
+    );
+    expect(binary(133, Int32Array, a32, a32, Int16Array)).toEqual([...a32, ...a32].map(a => clamp(a, -32768, 32767)));
+
+    expect(unary(136, Int8Array, a8, Int16Array)).toEqual(a8.slice(8));
+    expect(unary(137, Int8Array, a8, Uint16Array)).toEqual(u8(a8).slice(0, 8));
+    expect(unary(168, Int16Array, a16, Int32Array)).toEqual(a16.slice(4));
+    expect(unary(202, Int32Array, [1, 2, -1, -2], BigInt64Array)).toEqual([4294967295n, 4294967294n]);
+    expect(binary(156, Int8Array, a8, b8, Int16Array)).toEqual(zip(a8, b8, (a, b) => a * b).slice(0, 8));
+    expect(binary(159, Uint8Array, a8, b8, Uint16Array)).toEqual(zip(u8(a8), u8(b8), (a, b) => a * b).slice(8));
+    expect(binary(189, Int16Array, a16, b16, Int32Array)).toEqual(zip(a16, b16, (a, b) => a * b).slice(4));
+    expect(binary(221, Int32Array, [0, 0, -2147483648, 3], [0, 0, -2147483648, -3], BigInt64Array)).toEqual([
+        4611686018427387904n,
+        -9n,
+    ]);
+
+    const pairwise = lanes => lanes.filter((_, i) => i % 2 === 0).map((lane, i) => lane + lanes[2 * i + 1]);
+    expect(unary(124, Int8Array, a8, Int16Array)).toEqual(pairwise(a8));
+    expect(unary(125, Uint8Array, a8, Uint16Array)).toEqual(pairwise(u8(a8)));
+    expect(unary(126, Int16Array, a16, Int32Array)).toEqual(pairwise(a16));
+    expect(unary(127, Uint16Array, a16, Uint32Array)).toEqual(pairwise(u16(a16)));
+    expect(binary(186, Int16Array, a16, b16, Int32Array)).toEqual(
+        Array.from(new Int32Array(pairwise(zip(a16, b16, (a, b) => a * b))))
+    );
+});
+
+test("float arithmetic", () => {
+    const a = [1.5, -2.25, 1e30, 3];
+    const b = [0.25, 4, 1e30, -0.5];
+    const f32 = lanes => lanes.map(Math.fround);
+    expect(binary(228, Float32Array, a, b)).toEqual(f32(zip(a, b, (a, b) => a + b)));
+    expect(binary(230, Float32Array, a, b)).toEqual(f32(zip(f32(a), f32(b), (a, b) => a * b)));
+    expect(binary(231, Float32Array, a, b)).toEqual(f32(zip(f32(a), f32(b), (a, b) => a / b)));
+    expect(unary(227, Float32Array, [4, 2, 0, -0])).toEqual(f32([2, Math.SQRT2, 0, -0]));
+    expect(binary(241, Float64Array, [0.1, 1e300], [0.2, -1e300])).toEqual([0.1 - 0.2, 2e300]);
+    expect(unary(239, Float64Array, [2, 9])).toEqual([Math.SQRT2, 3]);
+
+    expect(showZeroSigns(unary(224, Float32Array, [-0, -1.5, NaN, -Infinity]))).toEqual(["0", "1.5", "NaN", "Infinity"]);
+    expect(showZeroSigns(unary(225, Float32Array, [0, -1.5, 2, -Infinity]))).toEqual(["-0", "1.5", "-2", "Infinity"]);
+    expect(showZeroSigns(unary(237, Float64Array, [0, -1.5]))).toEqual(["-0", "1.5"]);
+
+    const minA = [-0, 0, NaN, 1];
+    const minB = [0, -0, 1, NaN];
+    expect(showZeroSigns(binary(232, Float32Array, minA, minB))).toEqual(["-0", "-0", "NaN", "NaN"]);
+    expect(showZeroSigns(binary(233, Float32Array, minA, minB))).toEqual(["0", "0", "NaN", "NaN"]);
+    expect(showZeroSigns(binary(244, Float64Array, [-0, 2], [0, -Infinity]))).toEqual(["-0", "-Infinity"]);
+    expect(showZeroSigns(binary(245, Float64Array, [-0, 2], [0, NaN]))).toEqual(["0", "NaN"]);
+    expect(showZeroSigns(binary(234, Float32Array, minA, minB))).toEqual(["-0", "0", "NaN", "1"]);
+    expect(showZeroSigns(binary(235, Float32Array, minA, minB))).toEqual(["-0", "0", "NaN", "1"]);
+
+    const values = [-1.5, -0.5, 0.5, 2.5];
+    expect(showZeroSigns(unary(103, Float32Array, values))).toEqual(["-1", "-0", "1", "3"]);
+    expect(showZeroSigns(unary(104, Float32Array, values))).toEqual(["-2", "-1", "0", "2"]);
+    expect(showZeroSigns(unary(105, Float32Array, values))).toEqual(["-1", "-0", "0", "2"]);
+    expect(showZeroSigns(unary(106, Float32Array, values))).toEqual(["-2", "-0", "0", "2"]);
+    expect(showZeroSigns(unary(116, Float64Array, [-0.5, 2.5]))).toEqual(["-0", "3"]);
+    expect(showZeroSigns(unary(117, Float64Array, [-0.5, 2.5]))).toEqual(["-1", "2"]);
+    expect(showZeroSigns(unary(122, Float64Array, [-0.5, 2.5]))).toEqual(["-0", "2"]);
+    expect(showZeroSigns(unary(148, Float64Array, [-0.5, 2.5]))).toEqual(["-0", "2"]);
+});
+
+test("conversions", () => {
+    expect(unary(248, Float32Array, [NaN, -3e9, 3e9, -1.9], Int32Array)).toEqual([0, -2147483648, 2147483647, -1]);
+    expect(unary(249, Float32Array, [NaN, -1.9, 5e9, 3.9e9], Uint32Array)).toEqual([
+        0,
+        0,
+        4294967295,
+        Math.trunc(Math.fround(3.9e9)),
+    ]);
+    expect(unary(252, Float64Array, [1e10, -2.5], Int32Array)).toEqual([2147483647, -2, 0, 0]);
+    expect(unary(253, Float64Array, [-1, 4294967295.5], Uint32Array)).toEqual([0, 4294967295, 0, 0]);
+
+    const integers = [-1, 2147483647, 16777217, -16777217];
+    expect(unary(250, Int32Array, integers, Float32Array)).toEqual(integers.map(Math.fround));
+    expect(unary(251, Int32Array, integers, Float32Array)).toEqual(
+        Array.from(new Uint32Array(integers)).map(Math.fround)
+    );
+    expect(unary(254, Int32Array, integers, Float64Array)).toEqual([-1, 2147483647]);
+    expect(unary(255, Int32Array, integers, Float64Array)).toEqual([4294967295, 2147483647]);
+
+    expect(unary(94, Float64Array, [1e300, 0.1], Float32Array)).toEqual([Infinity, Math.fround(0.1), 0, 0]);
+    expect(unary(95, Float32Array, [0.1, -2, 5, 6], Float64Array)).toEqual([Math.fround(0.1), -2]);
+});
+
+test("swizzles, shuffles and bitwise operations", () => {
+    const a = Array.from({ length: 16 }, (_, i) => 10 * i);
+    const b = Array.from({ length: 16 }, (_, i) => 200 + i);
+    const indices = [0, 15, 16, 255, 3, 3, 128, 1, 2, 4, 17, 31, 14, 13, 12, 11];
+    expect(binary(14, Uint8Array, a, indices)).toEqual(indices.map(i => (i < 16 ? a[i] : 0)));
+
+    const lanes = [0, 31, 16, 1, 17, 2, 18, 3, 30, 15, 29, 14, 7, 7, 23, 23];
+    const shuffled = lanesOf(Uint8Array, run([...vectorConst(Uint8Array, a), ...vectorConst(Uint8Array, b), ...simd(13), ...lanes]));
+    expect(shuffled).toEqual(lanes.map(i => (i < 16 ? a[i] : b[i - 16])));
+
+    const mask = [0x0f, 0xff, 0x00, 0xf0, 0x0f, 0xff, 0x00, 0xf0, 0x0f, 0xff, 0x00, 0xf0, 0x0f, 0xff, 0x00, 0xf0];
+    const selected = lanesOf(
+        Uint8Array,
+        run([...vectorConst(Uint8Array, a), ...vectorConst(Uint8Array, b), ...vectorConst(Uint8Array, mask), ...simd(82)])
+    );
+    expect(selected).toEqual(a.map((x, i) => (x & mask[i]) | (b[i] & ~mask[i] & 0xff)));
+    expect(binary(79, Uint8Array, a, mask)).toEqual(a.map((x, i) => x & ~mask[i] & 0xff));
+    expect(unary(77, Uint8Array, a)).toEqual(a.map(x => ~x & 0xff));
+});
+
+test("lane loads and stores", () => {
+    const memory = Array.from({ length: 32 }, (_, i) => i + 1);
+    const zeros = vectorConst(Uint8Array, new Array(16).fill(0));
+    const bytes = value => lanesOf(Uint8Array, value);
+
+    // v128.load32_lane at address 4 into lane 1.
+    expect(bytes(run([...i32Const(4), ...zeros, ...simd(86), 0x02, 0x00, 0x01], v128, memory))).toEqual([
+        0, 0, 0, 0, 5, 6, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0,
+    ]);
+    // v128.load8_lane at address 2, with an offset of 1, into lane 15.
+    expect(bytes(run([...i32Const(2), ...zeros, ...simd(84), 0x00, 0x01, 0x0f], v128, memory))[15]).toBe(4);
+    // v128.load64_zero at address 8.
+    expect(bytes(run([...i32Const(8), ...simd(93), 0x03, 0x00], v128, memory))).toEqual([
+        9, 10, 11, 12, 13, 14, 15, 16, 0, 0, 0, 0, 0, 0, 0, 0,
+    ]);
+
+    // v128.store16_lane of lane 7 at address 1, then v128.load at address 0.
+    const source = vectorConst(Uint8Array, Array.from({ length: 16 }, (_, i) => 100 + i));
+    const body = [...i32Const(1), ...source, ...simd(89), 0x01, 0x00, 0x07, ...i32Const(0), ...simd(0), 0x04, 0x00];
+    expect(bytes(run(body, v128, memory))).toEqual([1, 114, 115, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16]);
+
+    // Lane accesses past the end of the memory trap.
+    expect(() => run([...i32Const(0), ...simd(93), 0x03, 0xf9, 0xff, 0x03], v128, memory)).toThrowWithMessage(
+        TypeError,
+        "Execution trapped: Memory access out of bounds"
+    );
+});
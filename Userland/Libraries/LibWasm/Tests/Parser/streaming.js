@@ -0,0 +1,89 @@
+const uleb128 = value => {
+    const bytes = [];
+    do {
+        let byte = value & 0x7f;
+        value >>>= 7;
+        if (value !== 0) byte |= 0x80;
+        bytes.push(byte);
+    } while (value !== 0);
+    return bytes;
+};
+
+const section = (id, contents) => [id, ...uleb128(contents.length), ...contents];
+
+// A module with functionCount functions of type (i32) -> i32, where function i adds 100 * (i % 64) to its argument
+// one step at a time, and exports the first and last ones. `breakFunction` can replace the i32.add in some functions.
+const buildModule = (functionCount, breakFunction = () => null) => {
+    const bytes = [0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00];
+    bytes.push(...section(1, [0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f]));
+    bytes.push(...section(3, [...uleb128(functionCount), ...new Array(functionCount).fill(0x00)]));
+    const exportName = name => [name.length, ...Array.from(name, c => c.charCodeAt(0))];
+    // prettier-ignore
+    bytes.push(...section(7, [
+        0x02,
+        ...exportName("first"), 0x00, 0x00,
+        ...exportName("last"), 0x00, ...uleb128(functionCount - 1),
+    ]));
+
+    const code = [...uleb128(functionCount)];
+    for (let i = 0; i < functionCount; ++i) {
+        const add = breakFunction(i) ?? 0x6a;
+        const body = [0x00, 0x20, 0x00];
+        for (let j = 0; j < 100; ++j) body.push(0x41, i % 64, add);
+        body.push(0x0b);
+        code.push(...uleb128(body.length), ...body);
+    }
+    bytes.push(...section(10, code));
+    return new Uint8Array(bytes);
+};
+
+// Large enough to be validated on several threads.
+const largeModule = buildModule(1024);
+
+const callExports = module => [
+    module.invoke(module.getExport("first"), 5),
+    module.invoke(module.getExport("last"), 5),
+];
+
+test("large module", () => {
+    expect(callExports(parseWebAssemblyModule(largeModule))).toEqual([5, 6305]);
+});
+
+test("streaming parsing gives the same module for any chunk size", () => {
+    for (const chunkSize of [1, 7, 4096, largeModule.length]) {
+        const module = parseWebAssemblyModuleInChunks(largeModule, chunkSize);
+        expect(callExports(module)).toEqual([5, 6305]);
+    }
+    const smallModule = buildModule(3);
+    expect(callExports(parseWebAssemblyModuleInChunks(smallModule, 5))).toEqual([5, 205]);
+});
+
+test("the first invalid function is reported", () => {
+    // i64.add and f32.add in functions 300 and 900.
+    const invalidModule = buildModule(1024, i => (i === 300 ? 0x7c : i === 900 ? 0x92 : null));
+    const errorMessage = parse => {
+        try {
+            parse();
+        } catch (e) {
+            return e.message;
+        }
+        return null;
+    };
+
+    const message = errorMessage(() => parseWebAssemblyModule(invalidModule));
+    expect(message).toBe("Validation failed: Invalid stack state, expected i64 but got i32");
+    for (const chunkSize of [1, 4096])
+        expect(errorMessage(() => parseWebAssemblyModuleInChunks(invalidModule, chunkSize))).toBe(message);
+});
+
+test("streaming parsing fails on truncated modules", () => {
+    const truncatedModule = largeModule.slice(0, largeModule.length - 10);
+    expect(() => parseWebAssemblyModuleInChunks(truncatedModule, 4096)).toThrowWithMessage(
+        SyntaxError,
+        "Unexpected end-of-file"
+    );
+    expect(() => parseWebAssemblyModuleInChunks(new Uint8Array([0, 0x32, 0x73, 0x6d]), 1)).toThrowWithMessage(
+        SyntaxError,
+        "Incorrect module magic (did not match \\0asm)"
+    );
+});
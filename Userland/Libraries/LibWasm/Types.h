@@ -10,6 +10,7 @@
 #include <AK/ByteString.h>
 #include <AK/DistinctNumeric.h>
 #include <AK/LEB128.h>
+#include <AK/OwnPtr.h>
 #include <AK/Result.h>
 #include <AK/String.h>
 #include <AK/UFixedBigInt.h>
@@ -33,7 +34,7 @@ template<size_t M, size_t N, typename ElementType = NativeFloatingType<M>>
 using NativeFloatingVectorType __attribute__((vector_size(N * sizeof(ElementType)))) = ElementType;
 
 template<typename T, template<typename> typename SetSign>
-using Native128ByteVectorOf = NativeVectorType<sizeof(T) * 8, 16 / sizeof(T), SetSign, T>;
+using Native128ByteVectorOf = NativeVectorType<sizeof(T) * 8, 16 / sizeof(T), SetSign, Conditional<IsFloatingPoint<T>, T, SetSign<T>>>;
 
 enum class ParseError {
     UnexpectedEof,
@@ -1001,21 +1002,24 @@ public:
 
     class Function {
     public:
-        explicit Function(TypeIndex type, Vector<ValueType> local_types, Expression body)
-            : m_type(type)
-            , m_local_types(move(local_types))
-            , m_body(move(body))
-        {
-        }
+        explicit Function(TypeIndex type, Vector<ValueType> local_types, Expression body);
+        Function(Function&&);
+        Function& operator=(Function&&);
+        ~Function();
 
         auto& type() const { return m_type; }
         auto& locals() const { return m_local_types; }
         auto& body() const { return m_body; }
 
+        // The body lowered into the format that BytecodeInterpreter runs fastest, if the validator could lower it.
+        LoweredFunction const* lowered() const { return m_lowered.ptr(); }
+        void set_lowered(OwnPtr<LoweredFunction>, Badge<Validator>);
+
     private:
         TypeIndex m_type;
         Vector<ValueType> m_local_types;
         Expression m_body;
+        OwnPtr<LoweredFunction> m_lowered;
     };
 
     using AnySection = Variant<
@@ -1047,6 +1051,7 @@ public:
 
     auto& sections() const { return m_sections; }
     auto& functions() const { return m_functions; }
+    auto& functions() { return m_functions; }
     auto& type(TypeIndex index) const
     {
         FunctionType const* type = nullptr;
@@ -1081,6 +1086,8 @@ public:
     void set_validation_error(ByteString error) { m_validation_error = move(error); }
 
     static ParseResult<Module> parse(Stream& stream);
+    // Parses the contents of a section, which come after its id and size.
+    static ParseResult<AnySection> parse_section(u8 section_id, Stream& stream);
 
 private:
     bool populate_sections();
@@ -240,7 +240,7 @@ ErrorOr<Vector<T>> copy_typed_array(Configuration& configuration, Pointer<T> sou
     }
 
     for (Size i = 0; i < count; i += 1) {
-        values.unchecked_append(T::read_from(Array { ReadonlyBytes { memory->data().bytes().slice(address, size) } }));
+        values.unchecked_append(T::read_from(Array { ReadonlyBytes { memory->bytes().slice(address, size) } }));
         address += size;
     }
 
@@ -260,7 +260,7 @@ ErrorOr<void> copy_typed_value_to(Configuration& configuration, T const& value,
         return Error::from_errno(ENOBUFS);
     }
 
-    ABI::serialize(value, Array { Bytes { memory->data().bytes().slice(address, size) } });
+    ABI::serialize(value, Array { Bytes { memory->bytes().slice(address, size) } });
     return {};
 }
 
@@ -276,7 +276,7 @@ ErrorOr<Span<T>> slice_typed_memory(Configuration& configuration, Pointer<T> sou
     if (memory->size() < address || memory->size() <= address + (size * count))
         return Error::from_errno(ENOBUFS);
 
-    auto untyped_slice = memory->data().bytes().slice(address, size * count);
+    auto untyped_slice = memory->bytes().slice(address, size * count);
     return Span<T>(untyped_slice.data(), count);
 }
 
@@ -292,7 +292,7 @@ ErrorOr<Span<T const>> slice_typed_memory(Configuration& configuration, ConstPoi
     if (memory->size() < address || memory->size() <= address + (size * count))
         return Error::from_errno(ENOBUFS);
 
-    auto untyped_slice = memory->data().bytes().slice(address, size * count);
+    auto untyped_slice = memory->bytes().slice(address, size * count);
     return Span<T const>(untyped_slice.data(), count);
 }
 
@@ -821,7 +821,7 @@ template<size_t N>
 static Array<Bytes, N> address_spans(Span<Value> values, Configuration& configuration)
 {
     Array<Bytes, N> result;
-    auto memory = configuration.store().get(MemoryAddress { 0 })->data().span();
+    auto memory = configuration.store().get(MemoryAddress { 0 })->bytes();
     for (size_t i = 0; i < N; ++i)
         result[i] = memory.slice(*values[i].to<i32>());
     return result;
@@ -364,10 +364,7 @@ Document::Document(JS::Realm& realm, const URL::URL& url)
     HTML::main_thread_event_loop().register_document({}, *this);
 }
 
-Document::~Document()
-{
-    HTML::main_thread_event_loop().unregister_document({}, *this);
-}
+Document::~Document() = default;
 
 void Document::initialize(JS::Realm& realm)
 {
@@ -408,6 +405,7 @@ WebIDL::ExceptionOr<void> Document::populate_with_html_head_and_body()
 void Document::finalize()
 {
     Base::finalize();
+    HTML::main_thread_event_loop().unregister_document({}, *this);
     page().client().page_did_destroy_document(*this);
 }
 
@@ -33,8 +33,11 @@ MutationObserver::MutationObserver(JS::Realm& realm, JS::GCPtr<WebIDL::CallbackT
     agent_custom_data->mutation_observers.append(*this);
 }
 
-MutationObserver::~MutationObserver()
+MutationObserver::~MutationObserver() = default;
+
+void MutationObserver::finalize()
 {
+    Base::finalize();
     auto* agent_custom_data = verify_cast<Bindings::WebEngineCustomData>(vm().custom_data());
     agent_custom_data->mutation_observers.remove_all_matching([this](auto& observer) {
         return observer.ptr() == this;
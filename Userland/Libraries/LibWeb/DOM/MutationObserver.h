@@ -54,6 +54,7 @@ private:
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
 
     // https://dom.spec.whatwg.org/#concept-mo-callback
     JS::GCPtr<WebIDL::CallbackType> m_callback;
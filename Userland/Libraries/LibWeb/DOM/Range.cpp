@@ -72,8 +72,11 @@ Range::Range(Node& start_container, WebIDL::UnsignedLong start_offset, Node& end
     live_ranges().set(this);
 }
 
-Range::~Range()
+Range::~Range() = default;
+
+void Range::finalize()
 {
+    Base::finalize();
     live_ranges().remove(this);
 }
 
@@ -26,8 +26,11 @@ BrowsingContextGroup::BrowsingContextGroup(JS::NonnullGCPtr<Web::Page> page)
     user_agent_browsing_context_group_set().set(*this);
 }
 
-BrowsingContextGroup::~BrowsingContextGroup()
+BrowsingContextGroup::~BrowsingContextGroup() = default;
+
+void BrowsingContextGroup::finalize()
 {
+    Base::finalize();
     user_agent_browsing_context_group_set().remove(*this);
 }
 
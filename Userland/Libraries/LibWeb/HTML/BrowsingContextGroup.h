@@ -39,6 +39,7 @@ private:
     explicit BrowsingContextGroup(JS::NonnullGCPtr<Web::Page>);
 
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
 
     // https://html.spec.whatwg.org/multipage/browsers.html#browsing-context-group-set
     OrderedHashTable<JS::NonnullGCPtr<BrowsingContext>> m_browsing_context_set;
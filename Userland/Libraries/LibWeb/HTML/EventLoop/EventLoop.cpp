@@ -348,6 +348,14 @@ void EventLoop::process()
         //    perform the start an idle period algorithm for win with computeDeadline. [REQUESTIDLECALLBACK]
         for (auto& win : same_loop_windows())
             win->start_an_idle_period();
+
+        // NOTE: If no idle callbacks were queued above, let the garbage collector use the rest of the idle period
+        //       to make progress on its next full collection.
+        if (!task_queue.has_runnable_tasks()) {
+            auto remaining_idle_time = compute_deadline() - HighResolutionTime::unsafe_shared_current_time();
+            if (remaining_idle_time > 0)
+                heap().perform_incremental_garbage_collection_work(AK::Duration::from_microseconds(static_cast<i64>(remaining_idle_time * 1000)));
+        }
     }
 
     // FIXME: 14. If this is a worker event loop, then:
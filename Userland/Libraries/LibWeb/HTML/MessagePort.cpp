@@ -38,8 +38,11 @@ MessagePort::MessagePort(JS::Realm& realm)
 {
 }
 
-MessagePort::~MessagePort()
+MessagePort::~MessagePort() = default;
+
+void MessagePort::finalize()
 {
+    Base::finalize();
     disentangle();
 }
 
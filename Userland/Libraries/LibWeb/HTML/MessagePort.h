@@ -68,6 +68,7 @@ private:
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
 
     bool is_entangled() const { return static_cast<bool>(m_socket); }
     void disentangle();
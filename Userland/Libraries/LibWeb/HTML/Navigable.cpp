@@ -125,8 +125,11 @@ Navigable::Navigable(JS::NonnullGCPtr<Page> page)
     });
 }
 
-Navigable::~Navigable()
+Navigable::~Navigable() = default;
+
+void Navigable::finalize()
 {
+    Base::finalize();
     all_navigables().remove(this);
 }
 
@@ -57,6 +57,7 @@ protected:
     NavigableContainer(DOM::Document&, DOM::QualifiedName);
 
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
 
     // https://html.spec.whatwg.org/multipage/iframe-embed-object.html#shared-attribute-processing-steps-for-iframe-and-frame-elements
     Optional<URL::URL> shared_attribute_processing_steps_for_iframe_and_frame(bool initial_insertion);
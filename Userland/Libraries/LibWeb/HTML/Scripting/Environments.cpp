@@ -36,8 +36,11 @@ EnvironmentSettingsObject::EnvironmentSettingsObject(NonnullOwnPtr<JS::Execution
     responsible_event_loop().register_environment_settings_object({}, *this);
 }
 
-EnvironmentSettingsObject::~EnvironmentSettingsObject()
+EnvironmentSettingsObject::~EnvironmentSettingsObject() = default;
+
+void EnvironmentSettingsObject::finalize()
 {
+    Base::finalize();
     responsible_event_loop().unregister_environment_settings_object({}, *this);
 }
 
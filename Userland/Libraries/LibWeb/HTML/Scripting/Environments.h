@@ -122,6 +122,7 @@ protected:
     explicit EnvironmentSettingsObject(NonnullOwnPtr<JS::ExecutionContext>);
 
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
 
 private:
     NonnullOwnPtr<JS::ExecutionContext> m_realm_execution_context;
@@ -4,6 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonObject.h>
+#include <LibJS/Runtime/JSONObject.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/InternalsPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
@@ -45,6 +48,12 @@ void Internals::gc()
     vm().heap().collect_garbage();
 }
 
+JS::Object* Internals::get_shape_statistics()
+{
+    auto statistics = JS::Shape::gather_statistics(realm());
+    return &JS::JSONObject::parse_json_value(vm(), statistics.to_json()).as_object();
+}
+
 JS::Object* Internals::hit_test(double x, double y)
 {
     auto* active_document = global_object().browsing_context()->top_level_browsing_context()->active_document();
@@ -21,6 +21,7 @@ public:
     void signal_text_test_is_done();
 
     void gc();
+    JS::Object* get_shape_statistics();
     JS::Object* hit_test(double x, double y);
 
     void send_text(HTML::HTMLElement&, String const&);
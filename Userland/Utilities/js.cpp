@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ArgsParser.h>
@@ -23,6 +24,7 @@
 #include <LibJS/Runtime/DeclarativeEnvironment.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/JSONObject.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/StringPrototype.h>
 #include <LibJS/Runtime/ValueInlines.h>
 #include <LibJS/SourceTextModule.h>
@@ -54,6 +56,7 @@ private:
     JS_DECLARE_NATIVE_FUNCTION(load_json);
     JS_DECLARE_NATIVE_FUNCTION(last_value_getter);
     JS_DECLARE_NATIVE_FUNCTION(print);
+    JS_DECLARE_NATIVE_FUNCTION(shape_statistics);
 };
 
 class ScriptObject final : public JS::GlobalObject {
@@ -71,6 +74,7 @@ private:
     JS_DECLARE_NATIVE_FUNCTION(load_ini);
     JS_DECLARE_NATIVE_FUNCTION(load_json);
     JS_DECLARE_NATIVE_FUNCTION(print);
+    JS_DECLARE_NATIVE_FUNCTION(shape_statistics);
 };
 
 static bool s_dump_ast = false;
@@ -312,6 +316,12 @@ static JS::ThrowCompletionOr<JS::Value> load_json_impl(JS::VM& vm)
     return JS::JSONObject::parse_json_value(vm, json.value());
 }
 
+static JS::ThrowCompletionOr<JS::Value> shape_statistics_impl(JS::VM& vm)
+{
+    auto statistics = JS::Shape::gather_statistics(*vm.current_realm());
+    return JS::JSONObject::parse_json_value(vm, statistics.to_json());
+}
+
 void ReplObject::initialize(JS::Realm& realm)
 {
     Base::initialize(realm);
@@ -324,6 +334,7 @@ void ReplObject::initialize(JS::Realm& realm)
     define_native_function(realm, "loadINI", load_ini, 1, attr);
     define_native_function(realm, "loadJSON", load_json, 1, attr);
     define_native_function(realm, "print", print, 1, attr);
+    define_native_function(realm, "shapeStatistics", shape_statistics, 0, attr);
 
     define_native_accessor(
         realm,
@@ -375,9 +386,15 @@ JS_DEFINE_NATIVE_FUNCTION(ReplObject::repl_help)
     warnln("    loadJSON(file): load the given file as JSON.");
     warnln("    print(value): pretty-print the given JS value.");
     warnln("    save(file): write REPL input history to the given file. For example: save(\"foo.txt\")");
+    warnln("    shapeStatistics(): return the number of shapes in this realm and the memory used by their tables.");
     return JS::js_undefined();
 }
 
+JS_DEFINE_NATIVE_FUNCTION(ReplObject::shape_statistics)
+{
+    return shape_statistics_impl(vm);
+}
+
 JS_DEFINE_NATIVE_FUNCTION(ReplObject::load_ini)
 {
     return load_ini_impl(vm);
@@ -408,6 +425,12 @@ void ScriptObject::initialize(JS::Realm& realm)
     define_native_function(realm, "loadINI", load_ini, 1, attr);
     define_native_function(realm, "loadJSON", load_json, 1, attr);
     define_native_function(realm, "print", print, 1, attr);
+    define_native_function(realm, "shapeStatistics", shape_statistics, 0, attr);
+}
+
+JS_DEFINE_NATIVE_FUNCTION(ScriptObject::shape_statistics)
+{
+    return shape_statistics_impl(vm);
 }
 
 JS_DEFINE_NATIVE_FUNCTION(ScriptObject::load_ini)
@@ -531,6 +554,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
+    Optional<u32> dictionary_transition_threshold;
     StringView evaluate_script;
     Vector<StringView> script_paths;
 
@@ -538,6 +562,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::Bytecode::g_dump_property_lookup_cache_statistics, "Dump property lookup cache statistics on exit (hit counts need JS_PROPERTY_LOOKUP_CACHE_DEBUG)", "dump-property-lookup-caches", {});
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
@@ -547,12 +572,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
     args_parser.add_option(use_test262_global, "Use test262 global ($262)", "use-test262-global", {});
+    args_parser.add_option(dictionary_transition_threshold, "Number of properties after which objects switch to a dictionary shape", "dictionary-transition-threshold", {}, "count");
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
     bool syntax_highlight = !disable_syntax_highlight;
 
     AK::set_debug_enabled(!disable_debug_printing);
+    if (dictionary_transition_threshold.has_value())
+        JS::Shape::set_dictionary_transition_threshold(*dictionary_transition_threshold);
     s_history_path = TRY(String::formatted("{}/.js-history", Core::StandardPaths::home_directory()));
 
     g_vm = TRY(JS::VM::create());
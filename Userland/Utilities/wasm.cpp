@@ -322,7 +322,7 @@ static bool pre_interpret_hook(Wasm::Configuration& config, Wasm::InstructionPoi
                     warnln("invalid memory index {} (not found)", args[2]);
                     continue;
                 }
-                warnln("{:>32hex-dump}", mem->data().bytes());
+                warnln("{:>32hex-dump}", mem->bytes());
                 continue;
             }
             if (what.is_one_of("i", "instr", "instruction")) {
@@ -584,6 +584,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if (attempt_instantiate) {
         Wasm::AbstractMachine machine;
+        machine.enable_guard_pages_for_memories();
         Optional<Wasm::Wasi::Implementation> wasi_impl;
 
         if (wasi) {
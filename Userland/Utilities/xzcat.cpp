@@ -12,16 +12,26 @@
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("rpath stdio"));
+    TRY(Core::System::pledge("rpath stdio thread"));
 
     StringView filename;
+    bool parallel { false };
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("Decompress and print an XZ archive");
+    args_parser.add_option(parallel, "Decompress the blocks of the archive on multiple threads, holding all of the output in memory", "parallel", 'P');
     args_parser.add_positional_argument(filename, "File to decompress", "file");
     args_parser.parse(arguments);
 
     auto file = TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read));
+
+    if (parallel) {
+        auto input = TRY(file->read_until_eof());
+        auto output = TRY(Compress::XzDecompressor::decompress_all(input));
+        out("{:s}", output.bytes());
+        return 0;
+    }
+
     auto buffered_file = TRY(Core::InputBufferedFile::create(move(file)));
     auto stream = TRY(Compress::XzDecompressor::create(move(buffered_file)));
 